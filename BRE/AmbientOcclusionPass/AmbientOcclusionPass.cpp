@@ -7,7 +7,6 @@
 #include <DescriptorManager\RenderTargetDescriptorManager.h>
 #include <DXUtils\D3DFactory.h>
 #include <ResourceManager\ResourceManager.h>
-#include <ResourceStateManager\ResourceStateManager.h>
 #include <Utils\DebugUtils.h>
 
 namespace BRE {
@@ -146,35 +145,15 @@ AmbientOcclusionPass::RecordAndPushPrePassCommandLists() noexcept
 
     ID3D12GraphicsCommandList& commandList = mPrePassCommandListPerFrame.ResetCommandListWithNextCommandAllocator(nullptr);
 
-    D3D12_RESOURCE_BARRIER barriers[4U];
-    std::uint32_t barrierCount = 0UL;
-    if (ResourceStateManager::GetResourceState(*mAmbientAccessibilityBuffer) != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mAmbientAccessibilityBuffer,
-                                                                                        D3D12_RESOURCE_STATE_RENDER_TARGET);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mBlurBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mBlurBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mNormalRoughnessBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mNormalRoughnessBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mDepthBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mDepthBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (barrierCount > 0UL) {
-        commandList.ResourceBarrier(barrierCount, barriers);
-    }
+    mPrePassResourceStateTracker.Reset();
+    mPrePassResourceStateTracker.ChangeResourceState(*mAmbientAccessibilityBuffer,
+                                                     D3D12_RESOURCE_STATE_RENDER_TARGET);
+    mPrePassResourceStateTracker.ChangeResourceState(*mBlurBuffer,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    mPrePassResourceStateTracker.ChangeResourceState(*mNormalRoughnessBuffer,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    mPrePassResourceStateTracker.ChangeResourceState(*mDepthBuffer,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
     float clearColor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
     commandList.ClearRenderTargetView(mAmbientAccessibilityBufferRenderTargetView,
@@ -183,7 +162,7 @@ AmbientOcclusionPass::RecordAndPushPrePassCommandLists() noexcept
                                       nullptr);
 
     BRE_CHECK_HR(commandList.Close());
-    CommandListExecutor::Get().PushCommandList(commandList);
+    CommandListExecutor::Get().PushCommandList(commandList, mPrePassResourceStateTracker);
 
     return 1U;
 }
@@ -196,23 +175,11 @@ AmbientOcclusionPass::RecordAndPushMiddlePassCommandLists() noexcept
 
     ID3D12GraphicsCommandList& commandList = mMiddlePassCommandListPerFrame.ResetCommandListWithNextCommandAllocator(nullptr);
 
-    D3D12_RESOURCE_BARRIER barriers[2U];
-    std::uint32_t barrierCount = 0UL;
-    if (ResourceStateManager::GetResourceState(*mAmbientAccessibilityBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mAmbientAccessibilityBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mBlurBuffer) != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mBlurBuffer,
-                                                                                        D3D12_RESOURCE_STATE_RENDER_TARGET);
-        ++barrierCount;
-    }
-
-    if (barrierCount > 0UL) {
-        commandList.ResourceBarrier(barrierCount, barriers);
-    }
+    mMiddlePassResourceStateTracker.Reset();
+    mMiddlePassResourceStateTracker.ChangeResourceState(*mAmbientAccessibilityBuffer,
+                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    mMiddlePassResourceStateTracker.ChangeResourceState(*mBlurBuffer,
+                                                        D3D12_RESOURCE_STATE_RENDER_TARGET);
 
     float clearColor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
     commandList.ClearRenderTargetView(mBlurBufferRenderTargetView,
@@ -221,7 +188,7 @@ AmbientOcclusionPass::RecordAndPushMiddlePassCommandLists() noexcept
                                       nullptr);
 
     BRE_CHECK_HR(commandList.Close());
-    CommandListExecutor::Get().PushCommandList(commandList);
+    CommandListExecutor::Get().PushCommandList(commandList, mMiddlePassResourceStateTracker);
 
     return 1U;
 }
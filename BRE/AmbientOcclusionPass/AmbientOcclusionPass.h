@@ -3,6 +3,7 @@
 #include <CommandManager\CommandListPerFrame.h>
 #include <AmbientOcclusionPass\AmbientOcclusionCommandListRecorder.h>
 #include <AmbientOcclusionPass\BlurCommandListRecorder.h>
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
 
 namespace BRE {
 ///
@@ -84,6 +85,8 @@ private:
 
     CommandListPerFrame mPrePassCommandListPerFrame;
     CommandListPerFrame mMiddlePassCommandListPerFrame;
+    CommandListResourceStateTracker mPrePassResourceStateTracker;
+    CommandListResourceStateTracker mMiddlePassResourceStateTracker;
 
     ID3D12Resource* mAmbientAccessibilityBuffer{ nullptr };
     D3D12_GPU_DESCRIPTOR_HANDLE mAmbientAccessibilityBufferShaderResourceView{ 0UL };
@@ -36,5 +36,18 @@ D3D12_RECT ApplicationSettings::sScissorRect{
     static_cast<LONG>(ApplicationSettings::sWindowWidth),
     static_cast<LONG>(ApplicationSettings::sWindowHeight) };
 
+bool ApplicationSettings::sIsTextureStreamingEnabled{ true };
+std::uint64_t ApplicationSettings::sTextureStreamingBytesPerFrame{ 4UL * 1024UL * 1024UL };
+bool ApplicationSettings::sIsTextureCookingEnabled{ true };
+bool ApplicationSettings::sIsBC7TextureCookingEnabled{ false };
+bool ApplicationSettings::sIsKaiserMipFilterEnabled{ false };
+bool ApplicationSettings::sIsSceneHotReloadEnabled{ true };
+bool ApplicationSettings::sIsWorldPartitionEnabled{ false };
+float ApplicationSettings::sWorldPartitionCellSize{ 32.0f };
+float ApplicationSettings::sWorldPartitionLoadRadius{ 96.0f };
+float ApplicationSettings::sWorldPartitionUnloadRadius{ 128.0f };
+std::uint64_t ApplicationSettings::sWorldPartitionMemoryBudgetInBytes{ 64UL * 1024UL * 1024UL };
+std::uint32_t ApplicationSettings::sWorldPartitionCellLoadsPerUpdate{ 2U };
+
 const float ApplicationSettings::sSecondsPerFrame{ 1.0f / 60.0f };
 }
\ No newline at end of file
@@ -55,6 +55,35 @@ public:
     static D3D12_VIEWPORT sScreenViewport;
     static D3D12_RECT sScissorRect;
 
+    // Texture streaming uploads the most detailed mip levels in the background.
+    // If it is disabled, textures are loaded with all their mip levels.
+    static bool sIsTextureStreamingEnabled;
+    static std::uint64_t sTextureStreamingBytesPerFrame;
+
+    // Texture cooking compresses uncompressed textures to BC formats, and caches them.
+    // Color textures are compressed to BC7 if it is enabled, otherwise BC1 or BC3.
+    static bool sIsTextureCookingEnabled;
+    static bool sIsBC7TextureCookingEnabled;
+
+    // Textures without mip levels get them generated, and cached.
+    // They are filtered with a Kaiser filter if it is enabled, otherwise with a box filter.
+    static bool sIsKaiserMipFilterEnabled;
+
+    // Scene hot reload watches the scene files, and applies their modifications
+    // to the loaded scene without restarting.
+    static bool sIsSceneHotReloadEnabled;
+
+    // World partition splits the drawable objects of the scene in square cells of the XZ plane.
+    // Only the cells around the camera are loaded, up to the memory budget. Loaded cells are
+    // unloaded once they are farther than the unload radius, that must be greater than the load radius.
+    // Cells are loaded by TBB tasks, and at most "cell loads per update" cells are loading at the same time.
+    static bool sIsWorldPartitionEnabled;
+    static float sWorldPartitionCellSize;
+    static float sWorldPartitionLoadRadius;
+    static float sWorldPartitionUnloadRadius;
+    static std::uint64_t sWorldPartitionMemoryBudgetInBytes;
+    static std::uint32_t sWorldPartitionCellLoadsPerUpdate;
+
     // Used to update physics. If you
     // want a fixed update time step, for example,
     // 60 FPS, then you should store 1.0f / 60.0f here
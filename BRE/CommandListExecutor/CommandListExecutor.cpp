@@ -2,10 +2,34 @@
 
 #include <memory>
 
+#include <CommandManager\CommandAllocatorManager.h>
+#include <CommandManager\CommandListManager.h>
 #include <CommandManager\CommandQueueManager.h>
 #include <CommandManager\FenceManager.h>
+#include <DXUtils\D3DFactory.h>
+#include <ResourceStateManager\ResourceStateManager.h>
 
 namespace BRE {
+namespace {
+///
+/// @brief Waits until a fence reaches a value
+/// @param fence Fence
+/// @param value Value to wait for
+///
+void
+WaitForFenceValue(ID3D12Fence& fence,
+                  const std::uint64_t value) noexcept
+{
+    if (fence.GetCompletedValue() < value) {
+        const HANDLE eventHandle{ CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS) };
+        BRE_ASSERT(eventHandle);
+        BRE_CHECK_HR(fence.SetEventOnCompletion(value, eventHandle));
+        WaitForSingleObject(eventHandle, INFINITE);
+        CloseHandle(eventHandle);
+    }
+}
+}
+
 CommandListExecutor* CommandListExecutor::sExecutor{ nullptr };
 
 void
@@ -42,6 +66,18 @@ CommandListExecutor::CommandListExecutor(const std::uint32_t maxNumberOfCommandL
 
     mFence = &FenceManager::CreateFence(0U, D3D12_FENCE_FLAG_NONE);
 
+    // In each execution, there can be at most a fix-up command list before each command list,
+    // plus one for trailing transitions. Twice that number guarantees we do not wait for the
+    // fix-up command lists of the same execution.
+    mFixUpFence = &FenceManager::CreateFence(0U, D3D12_FENCE_FLAG_NONE);
+    mFixUpCommandLists.resize((maxNumberOfCommandListsToExecute + 1U) * 2U);
+    for (FixUpCommandList& fixUpCommandList : mFixUpCommandLists) {
+        fixUpCommandList.mCommandAllocator = &CommandAllocatorManager::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
+        fixUpCommandList.mCommandList = &CommandListManager::CreateCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT,
+                                                                               *fixUpCommandList.mCommandAllocator);
+        BRE_CHECK_HR(fixUpCommandList.mCommandList->Close());
+    }
+
     parent()->spawn(*this);
 }
 
@@ -50,19 +86,60 @@ CommandListExecutor::execute()
 {
     BRE_ASSERT(mMaxNumberOfCommandListsToExecute > 0);
 
-    ID3D12CommandList* *pendingCommandLists{ new ID3D12CommandList*[mMaxNumberOfCommandListsToExecute] };
+    // Each command list can be preceded by a fix-up command list, and there can be
+    // a trailing fix-up command list.
+    const std::uint32_t maxPendingCommandListCount = mMaxNumberOfCommandListsToExecute * 2U + 1U;
+    ID3D12CommandList* *pendingCommandLists{ new ID3D12CommandList*[maxPendingCommandListCount] };
+    PendingCommandList pendingCommandList;
     while (mTerminate == false) {
         // Pop at most mMaxNumberOfCommandListsToExecute from command list queue
-        while (mPendingCommandListCount < mMaxNumberOfCommandListsToExecute &&
-               mCommandListsToExecute.try_pop(pendingCommandLists[mPendingCommandListCount])) {
-            ++mPendingCommandListCount;
+        std::uint32_t poppedCommandListCount = 0U;
+        bool hasFixUpCommandLists = false;
+        while (poppedCommandListCount < mMaxNumberOfCommandListsToExecute &&
+               mCommandListsToExecute.try_pop(pendingCommandList)) {
+            ++poppedCommandListCount;
+
+            if (pendingCommandList.mResourceStateTracker != nullptr) {
+                mResourceStateTransitions.clear();
+                ResourceStateManager::ResolveResourceStates(*pendingCommandList.mResourceStateTracker,
+                                                            mResourceStateTransitions);
+                for (const ResourceStateResolver::ResourceStateTransition& transition : mResourceStateTransitions) {
+                    mFixUpBarriers.push_back(D3DFactory::GetTransitionResourceBarrier(*transition.mResource,
+                                                                                      transition.mStateBefore,
+                                                                                      transition.mStateAfter,
+                                                                                      transition.mSubresourceIndex));
+                }
+            }
+
+            if (pendingCommandList.mCommandList != nullptr) {
+                if (mFixUpBarriers.empty() == false) {
+                    pendingCommandLists[mPendingCommandListCount++] = &RecordFixUpCommandList();
+                    hasFixUpCommandLists = true;
+                }
+
+                pendingCommandLists[mPendingCommandListCount++] = pendingCommandList.mCommandList;
+            }
+        }
+
+        // Transitions that are not followed by a command list
+        if (mFixUpBarriers.empty() == false) {
+            pendingCommandLists[mPendingCommandListCount++] = &RecordFixUpCommandList();
+            hasFixUpCommandLists = true;
         }
 
         // Execute pending command lists (if any)
         if (mPendingCommandListCount != 0U) {
             mCommandQueue->ExecuteCommandLists(mPendingCommandListCount, pendingCommandLists);
-            mExecutedCommandListCount += mPendingCommandListCount;
             mPendingCommandListCount = 0U;
+
+            if (hasFixUpCommandLists) {
+                ++mFixUpFenceValue;
+                BRE_CHECK_HR(mCommandQueue->Signal(mFixUpFence, mFixUpFenceValue));
+            }
+        }
+
+        if (poppedCommandListCount != 0U) {
+            mExecutedCommandListCount += poppedCommandListCount;
         } else {
             Sleep(0U);
         }
@@ -73,6 +150,29 @@ CommandListExecutor::execute()
     return nullptr;
 }
 
+ID3D12CommandList&
+CommandListExecutor::RecordFixUpCommandList() noexcept
+{
+    BRE_ASSERT(mFixUpBarriers.empty() == false);
+
+    FixUpCommandList& fixUpCommandList = mFixUpCommandLists[mNextFixUpCommandListIndex];
+    mNextFixUpCommandListIndex = (mNextFixUpCommandListIndex + 1U) % static_cast<std::uint32_t>(mFixUpCommandLists.size());
+
+    WaitForFenceValue(*mFixUpFence, fixUpCommandList.mFenceValue);
+
+    // The fence is signaled with this value after the current execution
+    fixUpCommandList.mFenceValue = mFixUpFenceValue + 1UL;
+
+    BRE_CHECK_HR(fixUpCommandList.mCommandAllocator->Reset());
+    BRE_CHECK_HR(fixUpCommandList.mCommandList->Reset(fixUpCommandList.mCommandAllocator, nullptr));
+    fixUpCommandList.mCommandList->ResourceBarrier(static_cast<std::uint32_t>(mFixUpBarriers.size()),
+                                                   mFixUpBarriers.data());
+    BRE_CHECK_HR(fixUpCommandList.mCommandList->Close());
+    mFixUpBarriers.clear();
+
+    return *fixUpCommandList.mCommandList;
+}
+
 void
 CommandListExecutor::SignalFenceAndWaitForCompletion(ID3D12Fence& fence,
                                                      const std::uint64_t valueToSignal,
@@ -4,7 +4,10 @@
 #include <d3d12.h>
 #include <tbb/concurrent_queue.h>
 #include <tbb/task.h>
+#include <vector>
 
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
+#include <ResourceStateManager\ResourceStateResolver.h>
 #include <Utils\DebugUtils.h>
 
 namespace BRE {
@@ -18,6 +21,11 @@ namespace BRE {
 /// - When you spawn it, execute() method is automatically called. You should fill the queue with
 ///   command lists. You can use CommandListExecutor::GetCommandListQueue() to get it.
 /// - When you want to terminate this task, you should call CommandListExecutor::Terminate() 
+///
+/// Command lists can be pushed with a CommandListResourceStateTracker. In that case, their resource
+/// states are resolved in submission order, and the needed transitions are recorded in fix-up command lists
+/// that are executed before them. Consecutive transitions are batched in a single fix-up command list.
+///
 class CommandListExecutor : public tbb::task {
 public:
     ///
@@ -62,6 +70,8 @@ public:
     ///
     /// @brief Get the number of executed command lists.
     ///
+    /// Resource state transitions pushed with PushResourceStateTransitions() count as a command list.
+    ///
     /// @return The number of executed command lists
     ///
     __forceinline std::uint32_t GetExecutedCommandListCount() const noexcept
@@ -76,7 +86,35 @@ public:
     ///
     __forceinline void PushCommandList(ID3D12CommandList& commandList) noexcept
     {
-        mCommandListsToExecute.push(&commandList);
+        mCommandListsToExecute.push(PendingCommandList{ &commandList, nullptr });
+    }
+
+    ///
+    /// @brief Push a command list to be executed, with its resource states
+    ///
+    /// @param commandList The command list to add
+    /// @param resourceStateTracker Resource states of the command list. It must not be
+    /// modified until the command list is executed.
+    ///
+    __forceinline void PushCommandList(ID3D12CommandList& commandList,
+                                       const CommandListResourceStateTracker& resourceStateTracker) noexcept
+    {
+        mCommandListsToExecute.push(PendingCommandList{ &commandList, &resourceStateTracker });
+    }
+
+    ///
+    /// @brief Push resource state transitions without a command list.
+    ///
+    /// The first-use states of @p resourceStateTracker are resolved, so next command lists
+    /// find resources in those states. It must not have pending barriers.
+    ///
+    /// @param resourceStateTracker Resource states. It must not be
+    /// modified until GetExecutedCommandListCount() includes it.
+    ///
+    __forceinline void PushResourceStateTransitions(const CommandListResourceStateTracker& resourceStateTracker) noexcept
+    {
+        BRE_ASSERT(resourceStateTracker.GetPendingBarriers().empty());
+        mCommandListsToExecute.push(PendingCommandList{ nullptr, &resourceStateTracker });
     }
 
     ///
@@ -123,6 +161,34 @@ private:
     // Called when tbb::task is spawned
     tbb::task* execute() final override;
 
+    ///
+    /// @brief Command list waiting to be executed
+    ///
+    struct PendingCommandList {
+        // nullptr if there are only resource state transitions
+        ID3D12CommandList* mCommandList{ nullptr };
+        const CommandListResourceStateTracker* mResourceStateTracker{ nullptr };
+    };
+
+    ///
+    /// @brief Command list to record resource state transitions before command lists
+    ///
+    struct FixUpCommandList {
+        ID3D12CommandAllocator* mCommandAllocator{ nullptr };
+        ID3D12GraphicsCommandList* mCommandList{ nullptr };
+        // Fix-up fence value that signals the command list was executed
+        std::uint64_t mFenceValue{ 0UL };
+    };
+
+    ///
+    /// @brief Records pending fix-up barriers in the next fix-up command list.
+    ///
+    /// It waits if the GPU did not finish executing that fix-up command list yet.
+    ///
+    /// @return The fix-up command list
+    ///
+    ID3D12CommandList& RecordFixUpCommandList() noexcept;
+
     static CommandListExecutor* sExecutor;
 
     bool mTerminate{ false };
@@ -132,7 +198,14 @@ private:
     std::uint32_t mMaxNumberOfCommandListsToExecute{ 1U };
 
     ID3D12CommandQueue* mCommandQueue{ nullptr };
-    tbb::concurrent_queue<ID3D12CommandList*> mCommandListsToExecute;
+    tbb::concurrent_queue<PendingCommandList> mCommandListsToExecute;
     ID3D12Fence* mFence{ nullptr };
+
+    std::vector<FixUpCommandList> mFixUpCommandLists;
+    std::uint32_t mNextFixUpCommandListIndex{ 0U };
+    ID3D12Fence* mFixUpFence{ nullptr };
+    std::uint64_t mFixUpFenceValue{ 0UL };
+    std::vector<ResourceStateResolver::ResourceStateTransition> mResourceStateTransitions;
+    std::vector<D3D12_RESOURCE_BARRIER> mFixUpBarriers;
 };
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "CommandListPerFrame.h"
 
 #include <d3d12.h>
+#include <utility>
 
 #include <CommandManager/CommandAllocatorManager.h>
 #include <CommandManager/CommandListManager.h>
@@ -34,9 +35,66 @@ BuildCommandObjects(ID3D12GraphicsCommandList* &commandList,
 }
 }
 
+std::vector<CommandListPerFrame::CommandObjects> CommandListPerFrame::mFreeCommandObjects;
+std::mutex CommandListPerFrame::mFreeCommandObjectsMutex;
+
 CommandListPerFrame::CommandListPerFrame()
 {
-    BuildCommandObjects(mCommandList, mCommandAllocators);
+    mFreeCommandObjectsMutex.lock();
+    if (mFreeCommandObjects.empty() == false) {
+        const CommandObjects& commandObjects = mFreeCommandObjects.back();
+        for (std::uint32_t i = 0U; i < ApplicationSettings::sQueuedFrameCount; ++i) {
+            mCommandAllocators[i] = commandObjects.mCommandAllocators[i];
+        }
+        // It was closed after its last recording, so it can be reset
+        mCommandList = commandObjects.mCommandList;
+        mFreeCommandObjects.pop_back();
+    }
+    mFreeCommandObjectsMutex.unlock();
+
+    if (mCommandList == nullptr) {
+        BuildCommandObjects(mCommandList, mCommandAllocators);
+    }
+}
+
+CommandListPerFrame::~CommandListPerFrame()
+{
+    if (mCommandList == nullptr) {
+        return;
+    }
+
+    CommandObjects commandObjects;
+    for (std::uint32_t i = 0U; i < ApplicationSettings::sQueuedFrameCount; ++i) {
+        commandObjects.mCommandAllocators[i] = mCommandAllocators[i];
+    }
+    commandObjects.mCommandList = mCommandList;
+
+    mFreeCommandObjectsMutex.lock();
+    mFreeCommandObjects.push_back(commandObjects);
+    mFreeCommandObjectsMutex.unlock();
+}
+
+CommandListPerFrame::CommandListPerFrame(CommandListPerFrame&& other) noexcept
+    : mCommandList(other.mCommandList)
+    , mCurrentFrameIndex(other.mCurrentFrameIndex)
+{
+    for (std::uint32_t i = 0U; i < ApplicationSettings::sQueuedFrameCount; ++i) {
+        mCommandAllocators[i] = other.mCommandAllocators[i];
+        other.mCommandAllocators[i] = nullptr;
+    }
+    other.mCommandList = nullptr;
+}
+
+CommandListPerFrame&
+CommandListPerFrame::operator=(CommandListPerFrame&& other) noexcept
+{
+    for (std::uint32_t i = 0U; i < ApplicationSettings::sQueuedFrameCount; ++i) {
+        std::swap(mCommandAllocators[i], other.mCommandAllocators[i]);
+    }
+    std::swap(mCommandList, other.mCommandList);
+    std::swap(mCurrentFrameIndex, other.mCurrentFrameIndex);
+
+    return *this;
 }
 
 ID3D12GraphicsCommandList&
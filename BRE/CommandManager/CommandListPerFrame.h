@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <mutex>
+#include <vector>
 
 #include <ApplicationSettings\ApplicationSettings.h>
 #include <Utils\DebugUtils.h>
@@ -13,14 +15,18 @@ namespace BRE {
 /// This class provides a command list that can be reset with 
 /// a different command allocator per queued frame.
 ///
+/// Command managers never release the command list and allocators, so they are
+/// reused by the next created instance once this one is destroyed. The GPU must not
+/// use them anymore when it is destroyed.
+///
 class CommandListPerFrame {
 public:
     CommandListPerFrame();
-    ~CommandListPerFrame() = default;
+    ~CommandListPerFrame();
     CommandListPerFrame(const CommandListPerFrame&) = delete;
     const CommandListPerFrame& operator=(const CommandListPerFrame&) = delete;
-    CommandListPerFrame(CommandListPerFrame&&) = default;
-    CommandListPerFrame& operator=(CommandListPerFrame&&) = default;
+    CommandListPerFrame(CommandListPerFrame&& other) noexcept;
+    CommandListPerFrame& operator=(CommandListPerFrame&& other) noexcept;
 
     ///
     /// @brief Reset command list with the command allocator for the next frame
@@ -40,9 +46,18 @@ public:
     }
 
 private:
+    struct CommandObjects {
+        ID3D12CommandAllocator* mCommandAllocators[ApplicationSettings::sQueuedFrameCount]{ nullptr };
+        ID3D12GraphicsCommandList* mCommandList{ nullptr };
+    };
+
     ID3D12CommandAllocator* mCommandAllocators[ApplicationSettings::sQueuedFrameCount]{ nullptr };
     ID3D12GraphicsCommandList* mCommandList{ nullptr };
     std::uint32_t mCurrentFrameIndex{ 0U };
+
+    // Command objects of the destroyed instances
+    static std::vector<CommandObjects> mFreeCommandObjects;
+    static std::mutex mFreeCommandObjectsMutex;
 };
 }
 
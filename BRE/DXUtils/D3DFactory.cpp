@@ -165,6 +165,20 @@ GetPositionNormalTangentTexCoordInputLayout() noexcept
     return inputElementDesc;
 }
 
+std::vector<D3D12_INPUT_ELEMENT_DESC>
+GetCompressedPositionNormalTangentTexCoordInputLayout() noexcept
+{
+    std::vector<D3D12_INPUT_ELEMENT_DESC> inputElementDesc
+    {
+        { "POSITION", 0U, DXGI_FORMAT_R32G32B32_FLOAT, 0U, 0U, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA , 0U },
+        { "NORMAL", 0U, DXGI_FORMAT_R16G16_SNORM, 0U, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA , 0U },
+        { "TANGENT", 0U, DXGI_FORMAT_R16G16_SNORM, 0U, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA , 0U },
+        { "TEXCOORD", 0U, DXGI_FORMAT_R16G16_FLOAT, 0U, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA , 0U }
+    };
+
+    return inputElementDesc;
+}
+
 std::vector<D3D12_INPUT_ELEMENT_DESC>
 GetPositionTexCoordInputLayout() noexcept
 {
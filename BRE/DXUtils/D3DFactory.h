@@ -74,6 +74,13 @@ std::vector<D3D12_INPUT_ELEMENT_DESC> GetPositionInputLayout() noexcept;
 ///
 std::vector<D3D12_INPUT_ELEMENT_DESC> GetPositionNormalTangentTexCoordInputLayout() noexcept;
 
+///
+/// @brief Get an input layout of position, and compressed normal, tangent and texture coordinates.
+/// It is the layout of VertexCompressor::CompressedVertex, which mesh vertex buffers use.
+/// @return A list of input element descriptor
+///
+std::vector<D3D12_INPUT_ELEMENT_DESC> GetCompressedPositionNormalTangentTexCoordInputLayout() noexcept;
+
 ///
 /// @brief Get an input layout of position and texture coordinates.
 /// @return A list of input element descriptor
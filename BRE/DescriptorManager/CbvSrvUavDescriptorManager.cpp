@@ -1,14 +1,20 @@
 #include "CbvSrvUavDescriptorManager.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <DirectXManager\DirectXManager.h>
 #include <DXUtils/d3dx12.h>
+#include <MemoryTracker\MemoryTracker.h>
+#include <ResourceManager\ResourceManager.h>
 
 namespace BRE {
 Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> CbvSrvUavDescriptorManager::mCbvSrvUavDescriptorHeap;
-D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::mCurrentCbvSrvUavGpuDescriptorHandle{ 0UL };
-D3D12_CPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::mCurrentCbvSrvUavCpuDescriptorHandle{ 0UL };
+Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> CbvSrvUavDescriptorManager::mCpuDescriptorHeap;
+std::uint32_t CbvSrvUavDescriptorManager::mDescriptorHeapSize{ 0U };
+std::uint32_t CbvSrvUavDescriptorManager::mNextDescriptorIndex{ 0U };
+std::vector<CbvSrvUavDescriptorManager::DescriptorRange> CbvSrvUavDescriptorManager::mFreeDescriptorRanges;
+std::map<std::uint32_t, CbvSrvUavDescriptorManager::StreamedDescriptorRange> CbvSrvUavDescriptorManager::mStreamedDescriptorRanges;
 std::mutex CbvSrvUavDescriptorManager::mMutex;
 
 void
@@ -20,30 +26,35 @@ CbvSrvUavDescriptorManager::Init(const std::uint32_t numDescriptorsInCbvSrvUavDe
     cbvSrvUavDescriptorHeapDescriptor.NumDescriptors = numDescriptorsInCbvSrvUavDescriptorHeap;
     cbvSrvUavDescriptorHeapDescriptor.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
 
+    D3D12_DESCRIPTOR_HEAP_DESC cpuDescriptorHeapDescriptor = cbvSrvUavDescriptorHeapDescriptor;
+    cpuDescriptorHeapDescriptor.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
     mMutex.lock();
     BRE_CHECK_HR(DirectXManager::GetDevice().CreateDescriptorHeap(&cbvSrvUavDescriptorHeapDescriptor,
                                                                   IID_PPV_ARGS(mCbvSrvUavDescriptorHeap.GetAddressOf())));
+    BRE_CHECK_HR(DirectXManager::GetDevice().CreateDescriptorHeap(&cpuDescriptorHeapDescriptor,
+                                                                  IID_PPV_ARGS(mCpuDescriptorHeap.GetAddressOf())));
+    mDescriptorHeapSize = numDescriptorsInCbvSrvUavDescriptorHeap;
+    mNextDescriptorIndex = 0U;
+    mFreeDescriptorRanges.clear();
+    mStreamedDescriptorRanges.clear();
     mMutex.unlock();
 
-    mCurrentCbvSrvUavGpuDescriptorHandle = mCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
-    mCurrentCbvSrvUavCpuDescriptorHandle = mCbvSrvUavDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+    MemoryTracker::RegisterAllocation(MemoryTracker::Category::DESCRIPTOR_HEAPS,
+                                      2U * cbvSrvUavDescriptorHeapDescriptor.NumDescriptors *
+                                      DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE
 CbvSrvUavDescriptorManager::CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC& descriptor) noexcept
 {
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle{};
     D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
 
     mMutex.lock();
-    gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
-
-    DirectXManager::GetDevice().CreateConstantBufferView(&descriptor, mCurrentCbvSrvUavCpuDescriptorHandle);
-
-    mCurrentCbvSrvUavGpuDescriptorHandle.ptr +=
-        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    AllocateDescriptors(1U, cpuDescriptorHandle, gpuDescriptorHandle);
 
-    mCurrentCbvSrvUavCpuDescriptorHandle.ptr +=
-        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    DirectXManager::GetDevice().CreateConstantBufferView(&descriptor, cpuDescriptorHandle);
 
     mMutex.unlock();
 
@@ -57,20 +68,18 @@ CbvSrvUavDescriptorManager::CreateConstantBufferViews(const D3D12_CONSTANT_BUFFE
     BRE_ASSERT(descriptors != nullptr);
     BRE_ASSERT(descriptorCount > 0U);
 
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle{};
     D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
 
     mMutex.lock();
-    gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
+    AllocateDescriptors(descriptorCount, cpuDescriptorHandle, gpuDescriptorHandle);
 
     for (std::uint32_t i = 0U; i < descriptorCount; ++i) {
-        DirectXManager::GetDevice().CreateConstantBufferView(&descriptors[i], mCurrentCbvSrvUavCpuDescriptorHandle);
-        mCurrentCbvSrvUavCpuDescriptorHandle.ptr +=
+        DirectXManager::GetDevice().CreateConstantBufferView(&descriptors[i], cpuDescriptorHandle);
+        cpuDescriptorHandle.ptr +=
             DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
     }
 
-    mCurrentCbvSrvUavGpuDescriptorHandle.ptr +=
-        descriptorCount * DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
     mMutex.unlock();
 
     return gpuDescriptorHandle;
@@ -80,20 +89,32 @@ D3D12_GPU_DESCRIPTOR_HANDLE
 CbvSrvUavDescriptorManager::CreateShaderResourceView(ID3D12Resource& resource,
                                                      const D3D12_SHADER_RESOURCE_VIEW_DESC& descriptor) noexcept
 {
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle{};
     D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
 
     mMutex.lock();
-    gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
+    const std::uint32_t descriptorIndex = AllocateDescriptors(1U, cpuDescriptorHandle, gpuDescriptorHandle);
 
+    // Views are written to the not shader visible heap, so they can be copied when they are moved.
+    // Streamed textures views are clamped to their resident mip levels.
+    const D3D12_CPU_DESCRIPTOR_HANDLE cpuHeapDescriptorHandle = GetCpuDescriptorHandle(*mCpuDescriptorHeap.Get(),
+                                                                                       descriptorIndex);
     DirectXManager::GetDevice().CreateShaderResourceView(&resource,
                                                          &descriptor,
-                                                         mCurrentCbvSrvUavCpuDescriptorHandle);
-
-    mCurrentCbvSrvUavGpuDescriptorHandle.ptr +=
-        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                                                         cpuHeapDescriptorHandle);
+    if (TextureStreamer::RegisterShaderResourceView(resource,
+                                                    descriptor,
+                                                    cpuHeapDescriptorHandle)) {
+        StreamedDescriptorRange range;
+        range.mFirstDescriptorIndex = descriptorIndex;
+        range.mDescriptorCount = 1U;
+        mStreamedDescriptorRanges[descriptorIndex] = range;
+    }
 
-    mCurrentCbvSrvUavCpuDescriptorHandle.ptr +=
-        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    DirectXManager::GetDevice().CopyDescriptorsSimple(1U,
+                                                      cpuDescriptorHandle,
+                                                      cpuHeapDescriptorHandle,
+                                                      D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
     mMutex.unlock();
 
@@ -109,22 +130,43 @@ CbvSrvUavDescriptorManager::CreateShaderResourceViews(ID3D12Resource* *resources
     BRE_ASSERT(descriptors != nullptr);
     BRE_ASSERT(descriptorCount > 0U);
 
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle{};
     D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
 
     mMutex.lock();
-    gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
-
+    const std::uint32_t firstDescriptorIndex = AllocateDescriptors(descriptorCount, cpuDescriptorHandle, gpuDescriptorHandle);
+
+    // Views are written to the not shader visible heap, so they can be copied when they are moved.
+    // Streamed textures views are clamped to their resident mip levels.
+    const D3D12_CPU_DESCRIPTOR_HANDLE firstCpuHeapDescriptorHandle = GetCpuDescriptorHandle(*mCpuDescriptorHeap.Get(),
+                                                                                            firstDescriptorIndex);
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuHeapDescriptorHandle = firstCpuHeapDescriptorHandle;
+    bool hasStreamedTextures = false;
     for (std::uint32_t i = 0U; i < descriptorCount; ++i) {
         BRE_ASSERT(resources[i] != nullptr);
         DirectXManager::GetDevice().CreateShaderResourceView(resources[i],
                                                              &descriptors[i],
-                                                             mCurrentCbvSrvUavCpuDescriptorHandle);
-        mCurrentCbvSrvUavCpuDescriptorHandle.ptr +=
+                                                             cpuHeapDescriptorHandle);
+        if (TextureStreamer::RegisterShaderResourceView(*resources[i],
+                                                        descriptors[i],
+                                                        cpuHeapDescriptorHandle)) {
+            hasStreamedTextures = true;
+        }
+        cpuHeapDescriptorHandle.ptr +=
             DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
     }
 
-    mCurrentCbvSrvUavGpuDescriptorHandle.ptr +=
-        descriptorCount * DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    if (hasStreamedTextures) {
+        StreamedDescriptorRange range;
+        range.mFirstDescriptorIndex = firstDescriptorIndex;
+        range.mDescriptorCount = descriptorCount;
+        mStreamedDescriptorRanges[firstDescriptorIndex] = range;
+    }
+
+    DirectXManager::GetDevice().CopyDescriptorsSimple(descriptorCount,
+                                                      cpuDescriptorHandle,
+                                                      firstCpuHeapDescriptorHandle,
+                                                      D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
     mMutex.unlock();
 
@@ -135,21 +177,16 @@ D3D12_GPU_DESCRIPTOR_HANDLE
 CbvSrvUavDescriptorManager::CreateUnorderedAccessView(ID3D12Resource& resource,
                                                       const D3D12_UNORDERED_ACCESS_VIEW_DESC& descriptor) noexcept
 {
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle{};
     D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
 
     mMutex.lock();
-    gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
+    AllocateDescriptors(1U, cpuDescriptorHandle, gpuDescriptorHandle);
 
     DirectXManager::GetDevice().CreateUnorderedAccessView(&resource,
                                                           nullptr,
                                                           &descriptor,
-                                                          mCurrentCbvSrvUavCpuDescriptorHandle);
-
-    mCurrentCbvSrvUavGpuDescriptorHandle.ptr +=
-        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-    mCurrentCbvSrvUavCpuDescriptorHandle.ptr +=
-        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                                                          cpuDescriptorHandle);
 
     mMutex.unlock();
 
@@ -165,26 +202,279 @@ CbvSrvUavDescriptorManager::CreateUnorderedAccessViews(ID3D12Resource* *resource
     BRE_ASSERT(descriptors != nullptr);
     BRE_ASSERT(descriptorCount > 0U);
 
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle{};
     D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
 
     mMutex.lock();
-    gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
+    AllocateDescriptors(descriptorCount, cpuDescriptorHandle, gpuDescriptorHandle);
 
     for (std::uint32_t i = 0U; i < descriptorCount; ++i) {
         BRE_ASSERT(resources[i] != nullptr);
         DirectXManager::GetDevice().CreateUnorderedAccessView(resources[i],
                                                               nullptr,
                                                               &descriptors[i],
-                                                              mCurrentCbvSrvUavCpuDescriptorHandle);
-        mCurrentCbvSrvUavCpuDescriptorHandle.ptr +=
+                                                              cpuDescriptorHandle);
+        cpuDescriptorHandle.ptr +=
             DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
     }
 
-    mCurrentCbvSrvUavGpuDescriptorHandle.ptr +=
-        descriptorCount * DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
     mMutex.unlock();
 
     return gpuDescriptorHandle;
 }
+
+D3D12_GPU_DESCRIPTOR_HANDLE
+CbvSrvUavDescriptorManager::GetCurrentDescriptors(const D3D12_GPU_DESCRIPTOR_HANDLE firstDescriptor) noexcept
+{
+    const std::size_t descriptorSize =
+        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    const D3D12_GPU_DESCRIPTOR_HANDLE heapStart = mCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+    BRE_ASSERT(firstDescriptor.ptr >= heapStart.ptr);
+    const std::uint32_t createdDescriptorIndex =
+        static_cast<std::uint32_t>((firstDescriptor.ptr - heapStart.ptr) / descriptorSize);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const std::map<std::uint32_t, StreamedDescriptorRange>::const_iterator findIt =
+        mStreamedDescriptorRanges.find(createdDescriptorIndex);
+    if (findIt == mStreamedDescriptorRanges.end()) {
+        return firstDescriptor;
+    }
+
+    D3D12_GPU_DESCRIPTOR_HANDLE currentDescriptor = heapStart;
+    currentDescriptor.ptr += findIt->second.mFirstDescriptorIndex * descriptorSize;
+
+    return currentDescriptor;
+}
+
+void
+CbvSrvUavDescriptorManager::UpdateStreamedShaderResourceViews() noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Views are got under the lock, so their descriptors cannot be released meanwhile.
+    std::vector<TextureStreamer::ShaderResourceView> views;
+    TextureStreamer::GetUpdatedShaderResourceViews(views);
+    if (views.empty()) {
+        return;
+    }
+
+    // Views are sorted by descriptor, so each group of contiguous descriptors is moved once.
+    std::sort(views.begin(),
+              views.end(),
+              [](const TextureStreamer::ShaderResourceView& a, const TextureStreamer::ShaderResourceView& b) {
+        return a.mCpuDescriptorHandle.ptr < b.mCpuDescriptorHandle.ptr;
+    });
+
+    const std::size_t descriptorSize =
+        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    const std::size_t cpuHeapStartPtr = mCpuDescriptorHeap->GetCPUDescriptorHandleForHeapStart().ptr;
+
+    std::size_t firstViewIndex = 0UL;
+    while (firstViewIndex < views.size()) {
+        const std::uint32_t descriptorIndex =
+            static_cast<std::uint32_t>((views[firstViewIndex].mCpuDescriptorHandle.ptr - cpuHeapStartPtr) / descriptorSize);
+
+        // Group whose first created descriptor is the greatest one that is not greater than the view descriptor
+        std::map<std::uint32_t, StreamedDescriptorRange>::iterator rangeIt =
+            mStreamedDescriptorRanges.upper_bound(descriptorIndex);
+        BRE_ASSERT(rangeIt != mStreamedDescriptorRanges.begin());
+        --rangeIt;
+        const std::uint32_t createdDescriptorIndex = rangeIt->first;
+        StreamedDescriptorRange& range = rangeIt->second;
+        BRE_ASSERT(descriptorIndex < createdDescriptorIndex + range.mDescriptorCount);
+
+        std::size_t lastViewIndex = firstViewIndex + 1UL;
+        while (lastViewIndex < views.size() &&
+               views[lastViewIndex].mCpuDescriptorHandle.ptr <
+               cpuHeapStartPtr + (createdDescriptorIndex + range.mDescriptorCount) * descriptorSize) {
+            ++lastViewIndex;
+        }
+
+        MoveStreamedDescriptorRange(createdDescriptorIndex,
+                                    range,
+                                    views.data() + firstViewIndex,
+                                    lastViewIndex - firstViewIndex);
+        firstViewIndex = lastViewIndex;
+    }
+}
+
+void
+CbvSrvUavDescriptorManager::ReleaseDescriptors(const D3D12_GPU_DESCRIPTOR_HANDLE firstDescriptor,
+                                               const std::uint32_t descriptorCount) noexcept
+{
+    BRE_ASSERT(descriptorCount > 0U);
+
+    const std::size_t descriptorSize =
+        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    mMutex.lock();
+    BRE_ASSERT(firstDescriptor.ptr >= mCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart().ptr);
+    const std::uint32_t firstDescriptorIndex = static_cast<std::uint32_t>(
+        (firstDescriptor.ptr - mCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart().ptr) / descriptorSize);
+
+    // Moved groups keep their first created descriptor, and the rest of their current descriptors
+    const std::map<std::uint32_t, StreamedDescriptorRange>::iterator findIt =
+        mStreamedDescriptorRanges.find(firstDescriptorIndex);
+    if (findIt != mStreamedDescriptorRanges.end() && findIt->second.mFirstDescriptorIndex != firstDescriptorIndex) {
+        BRE_ASSERT(findIt->second.mDescriptorCount == descriptorCount);
+        FreeDescriptors(findIt->second.mFirstDescriptorIndex, descriptorCount);
+        FreeDescriptors(firstDescriptorIndex, 1U);
+    } else {
+        FreeDescriptors(firstDescriptorIndex, descriptorCount);
+    }
+
+    if (findIt != mStreamedDescriptorRanges.end()) {
+        mStreamedDescriptorRanges.erase(findIt);
+    }
+
+    // Streamed textures must not write their views to the released descriptors.
+    // It is done under the lock, so they are not reused before.
+    TextureStreamer::RemoveShaderResourceViews(GetCpuDescriptorHandle(*mCpuDescriptorHeap.Get(), firstDescriptorIndex),
+                                               descriptorCount);
+    mMutex.unlock();
+}
+
+std::uint32_t
+CbvSrvUavDescriptorManager::AllocateDescriptors(const std::uint32_t descriptorCount,
+                                                D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescriptorHandle,
+                                                D3D12_GPU_DESCRIPTOR_HANDLE& gpuDescriptorHandle) noexcept
+{
+    BRE_ASSERT(descriptorCount > 0U);
+
+    // First fit in the released ranges. Otherwise, after the created descriptors.
+    std::uint32_t firstDescriptorIndex = mNextDescriptorIndex;
+    std::vector<DescriptorRange>::iterator it = mFreeDescriptorRanges.begin();
+    while (it != mFreeDescriptorRanges.end() && it->mDescriptorCount < descriptorCount) {
+        ++it;
+    }
+
+    if (it != mFreeDescriptorRanges.end()) {
+        firstDescriptorIndex = it->mFirstDescriptorIndex;
+        it->mFirstDescriptorIndex += descriptorCount;
+        it->mDescriptorCount -= descriptorCount;
+        if (it->mDescriptorCount == 0U) {
+            mFreeDescriptorRanges.erase(it);
+        }
+    } else {
+        BRE_CHECK_MSG(mNextDescriptorIndex + descriptorCount <= mDescriptorHeapSize,
+                      L"CBV/SRV/UAV descriptor heap is full");
+        mNextDescriptorIndex += descriptorCount;
+    }
+
+    const std::size_t descriptorSize =
+        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    cpuDescriptorHandle = GetCpuDescriptorHandle(*mCbvSrvUavDescriptorHeap.Get(), firstDescriptorIndex);
+
+    gpuDescriptorHandle = mCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+    gpuDescriptorHandle.ptr += firstDescriptorIndex * descriptorSize;
+
+    return firstDescriptorIndex;
+}
+
+void
+CbvSrvUavDescriptorManager::FreeDescriptors(const std::uint32_t firstDescriptorIndex,
+                                            const std::uint32_t descriptorCount) noexcept
+{
+    BRE_ASSERT(descriptorCount > 0U);
+    BRE_ASSERT(firstDescriptorIndex + descriptorCount <= mNextDescriptorIndex);
+
+    DescriptorRange releasedRange;
+    releasedRange.mFirstDescriptorIndex = firstDescriptorIndex;
+    releasedRange.mDescriptorCount = descriptorCount;
+
+    std::vector<DescriptorRange>::iterator it = mFreeDescriptorRanges.begin();
+    while (it != mFreeDescriptorRanges.end() && it->mFirstDescriptorIndex < releasedRange.mFirstDescriptorIndex) {
+        ++it;
+    }
+    BRE_ASSERT(it == mFreeDescriptorRanges.end() ||
+               releasedRange.mFirstDescriptorIndex + descriptorCount <= it->mFirstDescriptorIndex);
+    it = mFreeDescriptorRanges.insert(it, releasedRange);
+
+    // Merge with the next and the previous ranges
+    if (it + 1 != mFreeDescriptorRanges.end() &&
+        it->mFirstDescriptorIndex + it->mDescriptorCount == (it + 1)->mFirstDescriptorIndex) {
+        it->mDescriptorCount += (it + 1)->mDescriptorCount;
+        mFreeDescriptorRanges.erase(it + 1);
+    }
+    if (it != mFreeDescriptorRanges.begin() &&
+        (it - 1)->mFirstDescriptorIndex + (it - 1)->mDescriptorCount == it->mFirstDescriptorIndex) {
+        (it - 1)->mDescriptorCount += it->mDescriptorCount;
+        mFreeDescriptorRanges.erase(it);
+    }
+}
+
+void
+CbvSrvUavDescriptorManager::MoveStreamedDescriptorRange(const std::uint32_t createdDescriptorIndex,
+                                                        StreamedDescriptorRange& range,
+                                                        const TextureStreamer::ShaderResourceView* views,
+                                                        const std::size_t viewCount) noexcept
+{
+    BRE_ASSERT(views != nullptr);
+
+    const std::size_t descriptorSize =
+        DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    const std::size_t cpuHeapStartPtr = mCpuDescriptorHeap->GetCPUDescriptorHandleForHeapStart().ptr;
+
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle{};
+    D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
+    const std::uint32_t previousDescriptorIndex = range.mFirstDescriptorIndex;
+    const std::uint32_t descriptorIndex = AllocateDescriptors(range.mDescriptorCount, cpuDescriptorHandle, gpuDescriptorHandle);
+
+    // Unchanged views are copied, and changed views are written over them
+    const D3D12_CPU_DESCRIPTOR_HANDLE cpuHeapDescriptorHandle = GetCpuDescriptorHandle(*mCpuDescriptorHeap.Get(),
+                                                                                       descriptorIndex);
+    DirectXManager::GetDevice().CopyDescriptorsSimple(range.mDescriptorCount,
+                                                      cpuHeapDescriptorHandle,
+                                                      GetCpuDescriptorHandle(*mCpuDescriptorHeap.Get(), previousDescriptorIndex),
+                                                      D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    for (std::size_t i = 0UL; i < viewCount; ++i) {
+        const TextureStreamer::ShaderResourceView& view = views[i];
+        BRE_ASSERT(view.mResource != nullptr);
+        const std::size_t viewOffset =
+            (view.mCpuDescriptorHandle.ptr - cpuHeapStartPtr) / descriptorSize - createdDescriptorIndex;
+        BRE_ASSERT(viewOffset < range.mDescriptorCount);
+
+        D3D12_CPU_DESCRIPTOR_HANDLE viewCpuHeapDescriptorHandle = cpuHeapDescriptorHandle;
+        viewCpuHeapDescriptorHandle.ptr += viewOffset * descriptorSize;
+        DirectXManager::GetDevice().CreateShaderResourceView(view.mResource,
+                                                             &view.mDescriptor,
+                                                             viewCpuHeapDescriptorHandle);
+    }
+
+    DirectXManager::GetDevice().CopyDescriptorsSimple(range.mDescriptorCount,
+                                                      cpuDescriptorHandle,
+                                                      cpuHeapDescriptorHandle,
+                                                      D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    range.mFirstDescriptorIndex = descriptorIndex;
+
+    // Queued frames could read the previous descriptors. The first created descriptor
+    // identifies the group, so it is kept until the group is released.
+    std::uint32_t releasedDescriptorIndex = previousDescriptorIndex;
+    std::uint32_t releasedDescriptorCount = range.mDescriptorCount;
+    if (previousDescriptorIndex == createdDescriptorIndex) {
+        ++releasedDescriptorIndex;
+        --releasedDescriptorCount;
+    }
+
+    if (releasedDescriptorCount > 0U) {
+        ResourceManager::GetDeferredReleaseQueue().Enqueue([releasedDescriptorIndex, releasedDescriptorCount]() {
+            mMutex.lock();
+            FreeDescriptors(releasedDescriptorIndex, releasedDescriptorCount);
+            mMutex.unlock();
+        });
+    }
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE
+CbvSrvUavDescriptorManager::GetCpuDescriptorHandle(ID3D12DescriptorHeap& descriptorHeap,
+                                                   const std::uint32_t descriptorIndex) noexcept
+{
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle = descriptorHeap.GetCPUDescriptorHandleForHeapStart();
+    cpuDescriptorHandle.ptr +=
+        descriptorIndex * DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    return cpuDescriptorHandle;
+}
 }
\ No newline at end of file
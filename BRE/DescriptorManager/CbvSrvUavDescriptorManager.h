@@ -1,9 +1,12 @@
 #pragma once
 
 #include <d3d12.h>
+#include <map>
 #include <mutex>
+#include <vector>
 #include <wrl.h>
 
+#include <ResourceManager\TextureStreamer.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
@@ -11,6 +14,12 @@ namespace BRE {
 /// @brief Responsible to create constant buffers, shader resource views,
 /// and unordered access views.
 ///
+/// Shader resource views of streamed textures are clamped to their resident mip levels
+/// (see TextureStreamer). Queued frames could be reading them, so when they change, their
+/// descriptors are written to new contiguous descriptors, and the previous ones are released
+/// once the GPU finished those frames. Command lists must get the current descriptors
+/// of their shader resource views every time they are recorded (see GetCurrentDescriptors()).
+///
 class CbvSrvUavDescriptorManager {
 public:
     CbvSrvUavDescriptorManager() = delete;
@@ -87,6 +96,42 @@ public:
                                                                   const D3D12_UNORDERED_ACCESS_VIEW_DESC* descriptors,
                                                                   const std::uint32_t descriptorCount) noexcept;
 
+    ///
+    /// @brief Get the current location of descriptors returned by a create method
+    ///
+    /// It only changes for shader resource views of streamed textures. The returned descriptors
+    /// can be used by the command lists that are recorded until the next
+    /// UpdateStreamedShaderResourceViews() call.
+    ///
+    /// @param firstDescriptor GPU descriptor handle of the first descriptor, returned by a create method
+    /// @return GPU descriptor handle of the current first descriptor
+    ///
+    static D3D12_GPU_DESCRIPTOR_HANDLE GetCurrentDescriptors(const D3D12_GPU_DESCRIPTOR_HANDLE firstDescriptor) noexcept;
+
+    ///
+    /// @brief Writes the shader resource views of streamed textures whose resident mip levels changed
+    /// (see TextureStreamer::GetUpdatedShaderResourceViews()).
+    ///
+    /// Each changed group of contiguous descriptors is written to new descriptors, and its previous
+    /// descriptors are released through the deferred release queue (see ResourceManager).
+    /// It must be called once per frame, after TextureStreamer::Update(), and before
+    /// command lists are recorded.
+    ///
+    static void UpdateStreamedShaderResourceViews() noexcept;
+
+    ///
+    /// @brief Releases contiguous descriptors, so next created descriptors can reuse their heap space.
+    ///
+    /// The GPU must not use them anymore, and they must not be used after this call.
+    /// Their shader resource views are unregistered from TextureStreamer.
+    ///
+    /// @param firstDescriptor GPU descriptor handle of the first descriptor, returned by a create method.
+    /// It is not the current location (see GetCurrentDescriptors()).
+    /// @param descriptorCount Number of descriptors. It must be greater than zero.
+    ///
+    static void ReleaseDescriptors(const D3D12_GPU_DESCRIPTOR_HANDLE firstDescriptor,
+                                   const std::uint32_t descriptorCount) noexcept;
+
     ///
     /// @brief Get descriptor heap
     /// @return The descriptor heap
@@ -98,10 +143,84 @@ public:
     }
 
 private:
+    struct DescriptorRange {
+        std::uint32_t mFirstDescriptorIndex{ 0U };
+        std::uint32_t mDescriptorCount{ 0U };
+    };
+
+    ///
+    /// @brief Contiguous shader resource views that include views of streamed textures
+    ///
+    struct StreamedDescriptorRange {
+        // Current location. The first created descriptor identifies the range, so it is
+        // not reused until the range is released, even if the range was moved.
+        std::uint32_t mFirstDescriptorIndex{ 0U };
+        std::uint32_t mDescriptorCount{ 0U };
+    };
+
+    ///
+    /// @brief Allocates contiguous descriptors. Released descriptors are reused first.
+    ///
+    /// The mutex must be locked.
+    ///
+    /// @param descriptorCount Number of descriptors. It must be greater than zero.
+    /// @param cpuDescriptorHandle Output CPU descriptor handle of the first descriptor
+    /// @param gpuDescriptorHandle Output GPU descriptor handle of the first descriptor
+    /// @return Index of the first descriptor
+    ///
+    static std::uint32_t AllocateDescriptors(const std::uint32_t descriptorCount,
+                                             D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescriptorHandle,
+                                             D3D12_GPU_DESCRIPTOR_HANDLE& gpuDescriptorHandle) noexcept;
+
+    ///
+    /// @brief Adds contiguous descriptors to the released ranges
+    ///
+    /// The mutex must be locked.
+    ///
+    /// @param firstDescriptorIndex Index of the first descriptor
+    /// @param descriptorCount Number of descriptors. It must be greater than zero.
+    ///
+    static void FreeDescriptors(const std::uint32_t firstDescriptorIndex,
+                                const std::uint32_t descriptorCount) noexcept;
+
+    ///
+    /// @brief Writes a group of streamed shader resource views to new descriptors
+    ///
+    /// The mutex must be locked.
+    ///
+    /// @param createdDescriptorIndex Index of the first created descriptor of the group
+    /// @param range Group of contiguous descriptors
+    /// @param views Changed views of the group. Must not be nullptr.
+    /// @param viewCount Number of changed views
+    ///
+    static void MoveStreamedDescriptorRange(const std::uint32_t createdDescriptorIndex,
+                                            StreamedDescriptorRange& range,
+                                            const TextureStreamer::ShaderResourceView* views,
+                                            const std::size_t viewCount) noexcept;
+
+    ///
+    /// @brief Get the CPU descriptor handle of a descriptor
+    /// @param descriptorHeap Descriptor heap
+    /// @param descriptorIndex Descriptor index
+    /// @return CPU descriptor handle
+    ///
+    static D3D12_CPU_DESCRIPTOR_HANDLE GetCpuDescriptorHandle(ID3D12DescriptorHeap& descriptorHeap,
+                                                              const std::uint32_t descriptorIndex) noexcept;
+
     static Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mCbvSrvUavDescriptorHeap;
 
-    static D3D12_GPU_DESCRIPTOR_HANDLE mCurrentCbvSrvUavGpuDescriptorHandle;
-    static D3D12_CPU_DESCRIPTOR_HANDLE mCurrentCbvSrvUavCpuDescriptorHandle;
+    // Not shader visible copy of the shader resource views, to copy them when they are moved.
+    // Shader visible heaps must not be read by the CPU.
+    static Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mCpuDescriptorHeap;
+
+    static std::uint32_t mDescriptorHeapSize;
+    static std::uint32_t mNextDescriptorIndex;
+
+    // Released ranges, sorted by first descriptor index. Adjacent ranges are merged.
+    static std::vector<DescriptorRange> mFreeDescriptorRanges;
+
+    // By the index of their first created descriptor
+    static std::map<std::uint32_t, StreamedDescriptorRange> mStreamedDescriptorRanges;
 
     static std::mutex mMutex;
 };
@@ -4,6 +4,7 @@
 
 #include <DirectXManager\DirectXManager.h>
 #include <DXUtils/d3dx12.h>
+#include <MemoryTracker\MemoryTracker.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
@@ -26,6 +27,10 @@ DepthStencilDescriptorManager::Init() noexcept
                                                                   IID_PPV_ARGS(mDepthStencilViewDescriptorHeap.GetAddressOf())));
     mMutex.unlock();
 
+    MemoryTracker::RegisterAllocation(MemoryTracker::Category::DESCRIPTOR_HEAPS,
+                                      depthStencilViewDescriptorHeapDescriptor.NumDescriptors *
+                                      DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV));
+
     mCurrentDepthStencilViewGpuDescriptorHandle = mDepthStencilViewDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
     mCurrentDepthStencilCpuDescriptorHandle = mDepthStencilViewDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
 }
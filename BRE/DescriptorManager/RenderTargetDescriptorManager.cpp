@@ -4,6 +4,7 @@
 
 #include <DirectXManager\DirectXManager.h>
 #include <DXUtils/d3dx12.h>
+#include <MemoryTracker\MemoryTracker.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
@@ -26,6 +27,10 @@ RenderTargetDescriptorManager::Init(const std::uint32_t numDescriptorsInRenderTa
                                                                   IID_PPV_ARGS(mRenderTargetViewDescriptorHeap.GetAddressOf())));
     mMutex.unlock();
 
+    MemoryTracker::RegisterAllocation(MemoryTracker::Category::DESCRIPTOR_HEAPS,
+                                      renderTargetViewDescriptorHeapDescriptor.NumDescriptors *
+                                      DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
+
     mCurrentRenderTargetViewDescriptorHandle = mRenderTargetViewDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
     mCurrentRenderTargetViewCpuDescriptorHandle = mRenderTargetViewDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
 }
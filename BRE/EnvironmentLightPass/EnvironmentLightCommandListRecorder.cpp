@@ -98,7 +98,7 @@ EnvironmentLightCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffe
     commandList.SetGraphicsRootConstantBufferView(0U, frameCBufferGpuVAddress);
     commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
     commandList.SetGraphicsRootDescriptorTable(2U, mGeometryBufferShaderResourceViewsBegin);
-    commandList.SetGraphicsRootDescriptorTable(3U, mDiffuseAndSpecularIrradianceTextureShaderResourceViews);
+    commandList.SetGraphicsRootDescriptorTable(3U, CbvSrvUavDescriptorManager::GetCurrentDescriptors(mDiffuseAndSpecularIrradianceTextureShaderResourceViews));
     commandList.SetGraphicsRootDescriptorTable(4U, mAmbientAccessibilityBufferShaderResourceView);
     commandList.SetGraphicsRootDescriptorTable(5U, mDepthBufferShaderResourceView);
 
@@ -111,6 +111,18 @@ EnvironmentLightCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffe
     return 1U;
 }
 
+void
+EnvironmentLightCommandListRecorder::ReplaceEnvironmentCubeMaps(ID3D12Resource& diffuseIrradianceCubeMap,
+                                                                ID3D12Resource& specularPreConvolvedCubeMap) noexcept
+{
+    BRE_ASSERT(IsDataValid());
+
+    // The new views reuse the descriptors of the previous ones
+    CbvSrvUavDescriptorManager::ReleaseDescriptors(mDiffuseAndSpecularIrradianceTextureShaderResourceViews, 2U);
+    InitShaderResourceViews(diffuseIrradianceCubeMap,
+                            specularPreConvolvedCubeMap);
+}
+
 bool
 EnvironmentLightCommandListRecorder::IsDataValid() const noexcept
 {
@@ -55,6 +55,17 @@ public:
     ///
     std::uint32_t RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept;
 
+    ///
+    /// @brief Replaces the environment cube maps
+    ///
+    /// Init() must be called first. The GPU must not be using the previous cube maps.
+    ///
+    /// @param diffuseIrradianceCubeMap Diffuse irradiance environment cube map
+    /// @param specularPreConvolvedCubeMap Specular pre convolved environment cube map
+    ///
+    void ReplaceEnvironmentCubeMaps(ID3D12Resource& diffuseIrradianceCubeMap,
+                                    ID3D12Resource& specularPreConvolvedCubeMap) noexcept;
+
     ///
     /// @brief Checks if internal data is valid. Typically, used for assertions
     /// @return True if valid. Otherwise, false
@@ -7,7 +7,6 @@
 #include <DescriptorManager\RenderTargetDescriptorManager.h>
 #include <DXUtils\D3DFactory.h>
 #include <ResourceManager\ResourceManager.h>
-#include <ResourceStateManager\ResourceStateManager.h>
 #include <Utils\DebugUtils.h>
 
 namespace BRE {
@@ -56,6 +55,16 @@ EnvironmentLightPass::Execute(const FrameCBuffer& frameCBuffer) noexcept
     return commandListCount;
 }
 
+void
+EnvironmentLightPass::ReplaceEnvironmentCubeMaps(ID3D12Resource& diffuseIrradianceCubeMap,
+                                                 ID3D12Resource& specularPreConvolvedCubeMap) noexcept
+{
+    BRE_ASSERT(IsDataValid());
+
+    mEnvironmentLightRecorder.ReplaceEnvironmentCubeMaps(diffuseIrradianceCubeMap,
+                                                         specularPreConvolvedCubeMap);
+}
+
 bool
 EnvironmentLightPass::IsDataValid() const noexcept
 {
@@ -73,47 +82,18 @@ EnvironmentLightPass::RecordAndPushPrePassCommandLists() noexcept
 {
     BRE_ASSERT(IsDataValid());
 
-    D3D12_RESOURCE_BARRIER barriers[5U];
-    std::uint32_t barrierCount = 0UL;
-    if (ResourceStateManager::GetResourceState(*mAmbientAccessibilityBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mAmbientAccessibilityBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mBaseColorMetalnessBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mBaseColorMetalnessBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mNormalRoughnessBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mNormalRoughnessBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mDepthBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mDepthBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mAmbientAccessibilityBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mAmbientAccessibilityBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (barrierCount > 0UL) {
-        ID3D12GraphicsCommandList& commandList = mPostPassCommandListPerFrame.ResetCommandListWithNextCommandAllocator(nullptr);
-        commandList.ResourceBarrier(barrierCount, barriers);
-        BRE_CHECK_HR(commandList.Close());
-        CommandListExecutor::Get().PushCommandList(commandList);
-
-        return 1U;
-    }
-
-    return 0U;
+    mPrePassResourceStateTracker.Reset();
+    mPrePassResourceStateTracker.ChangeResourceState(*mAmbientAccessibilityBuffer,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    mPrePassResourceStateTracker.ChangeResourceState(*mBaseColorMetalnessBuffer,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    mPrePassResourceStateTracker.ChangeResourceState(*mNormalRoughnessBuffer,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    mPrePassResourceStateTracker.ChangeResourceState(*mDepthBuffer,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+    CommandListExecutor::Get().PushResourceStateTransitions(mPrePassResourceStateTracker);
+
+    return 1U;
 }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <CommandManager\CommandListPerFrame.h>
 #include <EnvironmentLightPass\EnvironmentLightCommandListRecorder.h>
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
 
 namespace BRE {
 ///
@@ -52,6 +53,17 @@ public:
     ///
     std::uint32_t Execute(const FrameCBuffer& frameCBuffer) noexcept;
 
+    ///
+    /// @brief Replaces the environment cube maps (for example, when the scene is switched)
+    ///
+    /// Init() must be called first. The GPU must not be using the previous cube maps.
+    ///
+    /// @param diffuseIrradianceCubeMap Diffuse irradiance environment cube map
+    /// @param specularPreConvolvedCubeMap Specular pre convolved environment cube map
+    ///
+    void ReplaceEnvironmentCubeMaps(ID3D12Resource& diffuseIrradianceCubeMap,
+                                    ID3D12Resource& specularPreConvolvedCubeMap) noexcept;
+
 private:
     ///
     /// @brief Checks if internal data is valid. Typically, used for assertions
@@ -60,15 +72,15 @@ private:
     bool IsDataValid() const noexcept;
 
     ///
-    /// @brief Records pre pass command lists and pushes them to 
+    /// @brief Pushes pre pass resource state transitions to
     /// the CommandListExecutor.
-    /// @return The number of recorded command lists
+    /// @return The number of pushed command lists
     ///
     std::uint32_t RecordAndPushPrePassCommandLists() noexcept;
 
     CommandListPerFrame mPrePassCommandListPerFrame;
     CommandListPerFrame mMiddlePassCommandListPerFrame;
-    CommandListPerFrame mPostPassCommandListPerFrame;
+    CommandListResourceStateTracker mPrePassResourceStateTracker;
 
     EnvironmentLightCommandListRecorder mEnvironmentLightRecorder;
 
@@ -1,8 +1,29 @@
 #include "GeometryCommandListRecorder.h"
 
+#include <DescriptorManager\CbvSrvUavDescriptorManager.h>
+#include <ResourceManager\ResourceManager.h>
+#include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
 
+using namespace DirectX;
+
 namespace BRE {
+GeometryCommandListRecorder::~GeometryCommandListRecorder()
+{
+    // Command lists of the queued frames could use the command objects and the descriptors
+    const std::shared_ptr<CommandListPerFrame> commandListPerFrame =
+        std::make_shared<CommandListPerFrame>(std::move(mCommandListPerFrame));
+    const std::vector<std::pair<D3D12_GPU_DESCRIPTOR_HANDLE, std::uint32_t>> descriptorRanges =
+        std::move(mDescriptorRanges);
+
+    ResourceManager::GetDeferredReleaseQueue().Enqueue([commandListPerFrame, descriptorRanges]() mutable {
+        commandListPerFrame.reset();
+        for (const std::pair<D3D12_GPU_DESCRIPTOR_HANDLE, std::uint32_t>& descriptorRange : descriptorRanges) {
+            CbvSrvUavDescriptorManager::ReleaseDescriptors(descriptorRange.first, descriptorRange.second);
+        }
+    });
+}
+
 bool
 GeometryCommandListRecorder::IsDataValid() const noexcept
 {
@@ -33,4 +54,63 @@ GeometryCommandListRecorder::Init(const D3D12_CPU_DESCRIPTOR_HANDLE* geometryBuf
     mGeometryBufferRenderTargetViewCount = geometryBufferRenderTargetViewCount;
     mDepthBufferView = depthBufferView;
 }
+
+void
+GeometryCommandListRecorder::SetCullingView(const FrameCBuffer& frameCBuffer) noexcept
+{
+    // Frame constant buffer matrices are transposed
+    const XMMATRIX viewMatrix = MathUtils::GetTransposeMatrix(frameCBuffer.mViewMatrix);
+    const XMMATRIX projectionMatrix = MathUtils::GetTransposeMatrix(frameCBuffer.mProjectionMatrix);
+    XMStoreFloat4x4(&mViewProjectionMatrix, XMMatrixMultiply(viewMatrix, projectionMatrix));
+
+    mEyeWorldPosition = XMFLOAT3(frameCBuffer.mEyeWorldPosition.x,
+                                 frameCBuffer.mEyeWorldPosition.y,
+                                 frameCBuffer.mEyeWorldPosition.z);
+}
+
+void
+GeometryCommandListRecorder::RecordDrawCalls(ID3D12GraphicsCommandList& commandList,
+                                             const GeometryData& geometryData,
+                                             const std::size_t worldMatrixIndex) noexcept
+{
+    BRE_ASSERT(worldMatrixIndex < geometryData.mWorldMatrices.size());
+
+    if (geometryData.mMeshlets == nullptr || geometryData.mMeshlets->empty()) {
+        commandList.DrawIndexedInstanced(geometryData.mIndexBufferData.mElementCount, 1U, 0U, 0U, 0U);
+        return;
+    }
+
+    MeshletCuller::CullMeshlets(*geometryData.mMeshlets,
+                                geometryData.mWorldMatrices[worldMatrixIndex],
+                                mViewProjectionMatrix,
+                                mEyeWorldPosition,
+                                mVisibleIndexRanges);
+
+    for (const MeshletCuller::IndexRange& indexRange : mVisibleIndexRanges) {
+        commandList.DrawIndexedInstanced(indexRange.mIndexCount, 1U, indexRange.mFirstIndex, 0U, 0U);
+    }
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE
+GeometryCommandListRecorder::CreateConstantBufferViews(const D3D12_CONSTANT_BUFFER_VIEW_DESC* descriptors,
+                                                       const std::uint32_t descriptorCount) noexcept
+{
+    const D3D12_GPU_DESCRIPTOR_HANDLE firstDescriptor =
+        CbvSrvUavDescriptorManager::CreateConstantBufferViews(descriptors, descriptorCount);
+    mDescriptorRanges.push_back(std::make_pair(firstDescriptor, descriptorCount));
+
+    return firstDescriptor;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE
+GeometryCommandListRecorder::CreateShaderResourceViews(ID3D12Resource* *resources,
+                                                       const D3D12_SHADER_RESOURCE_VIEW_DESC* descriptors,
+                                                       const std::uint32_t descriptorCount) noexcept
+{
+    const D3D12_GPU_DESCRIPTOR_HANDLE firstDescriptor =
+        CbvSrvUavDescriptorManager::CreateShaderResourceViews(resources, descriptors, descriptorCount);
+    mDescriptorRanges.push_back(std::make_pair(firstDescriptor, descriptorCount));
+
+    return firstDescriptor;
+}
 }
\ No newline at end of file
@@ -3,10 +3,17 @@
 #include <d3d12.h>
 #include <DirectXMath.h>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <CommandManager\CommandListPerFrame.h>
+#include <MathUtils\MathUtils.h>
+#include <ModelManager\MeshletBuilder.h>
+#include <ModelManager\MeshletCuller.h>
+#include <ModelManager\ModelManager.h>
 #include <ResourceManager\FrameUploadCBufferPerFrame.h>
+#include <ResourceManager\ResourceManager.h>
+#include <ResourceManager\UploadBufferManager.h>
 #include <ResourceManager/VertexAndIndexBufferCreator.h>
 
 namespace BRE {
@@ -24,16 +31,31 @@ public:
     struct GeometryData {
         GeometryData() = default;
 
+        // Model of the mesh. It keeps the vertex and index buffers and the meshlets while the recorder exists.
+        ModelManager::SharedModel mModel;
+
         VertexAndIndexBufferCreator::VertexBufferData mVertexBufferData;
         VertexAndIndexBufferCreator::IndexBufferData mIndexBufferData;
         std::vector<DirectX::XMFLOAT4X4> mWorldMatrices;
         std::vector<DirectX::XMFLOAT4X4> mInverseTransposeWorldMatrices;
         std::vector<float> mTextureScales;
+
+        // Meshlets of the mesh, to cull each instance. If it is nullptr or empty, then instances are not culled.
+        // They are owned by the mesh, so they are not copied for every recorder.
+        const std::vector<MeshletBuilder::Meshlet>* mMeshlets{ nullptr };
+
+        // Only used by the techniques without base color, metalness and roughness textures
+        std::vector<DirectX::XMFLOAT4> mBaseColorsAndMetalnesses;
+        std::vector<float> mRoughnesses;
     };
 
     GeometryCommandListRecorder() = default;
-    virtual ~GeometryCommandListRecorder()
-    {}
+
+    ///
+    /// @brief Destructor. The command list and the descriptors are released
+    /// once the GPU finished the frames that could use them.
+    ///
+    virtual ~GeometryCommandListRecorder();
 
     GeometryCommandListRecorder(const GeometryCommandListRecorder&) = delete;
     const GeometryCommandListRecorder& operator=(const GeometryCommandListRecorder&) = delete;
@@ -66,7 +88,59 @@ public:
     ///
     virtual bool IsDataValid() const noexcept;
 
+    ///
+    /// @brief Sets the textures sampled by the recorder, so they are kept while the recorder exists
+    /// @param textures Textures. They are moved.
+    ///
+    void SetSampledTextures(std::vector<ResourceManager::SharedResource>&& textures) noexcept
+    {
+        mSampledTextures = std::move(textures);
+    }
+
 protected:
+    ///
+    /// @brief Sets the view used to cull meshlets by RecordDrawCalls()
+    /// @param frameCBuffer Constant buffer per frame, for current frame
+    ///
+    void SetCullingView(const FrameCBuffer& frameCBuffer) noexcept;
+
+    ///
+    /// @brief Records the draw calls of an instance of a geometry.
+    ///
+    /// Its meshlets are culled against the view set by SetCullingView(), and
+    /// a draw call is recorded per range of visible meshlets.
+    /// Vertex and index buffers must be already set.
+    ///
+    /// @param commandList Command list
+    /// @param geometryData Geometry data
+    /// @param worldMatrixIndex Index of the instance world matrix
+    ///
+    void RecordDrawCalls(ID3D12GraphicsCommandList& commandList,
+                         const GeometryData& geometryData,
+                         const std::size_t worldMatrixIndex) noexcept;
+
+    ///
+    /// @brief Creates constant buffer views that are released with the recorder
+    /// (see CbvSrvUavDescriptorManager::CreateConstantBufferViews())
+    /// @param descriptors Constant buffer views descriptors. It must not be nullptr.
+    /// @param descriptorCount Number of constant buffer views descriptors. It must be greater than zero.
+    /// @return The GPU descriptor handle to the first view
+    ///
+    D3D12_GPU_DESCRIPTOR_HANDLE CreateConstantBufferViews(const D3D12_CONSTANT_BUFFER_VIEW_DESC* descriptors,
+                                                          const std::uint32_t descriptorCount) noexcept;
+
+    ///
+    /// @brief Creates shader resource views that are released with the recorder
+    /// (see CbvSrvUavDescriptorManager::CreateShaderResourceViews())
+    /// @param resources The list of resources to create views. It must not be nullptr.
+    /// @param descriptors Shader resource views descriptors. It must not be nullptr.
+    /// @param descriptorCount Number of shader resource views descriptors. It must be greater than zero.
+    /// @return The GPU descriptor handle to the first view
+    ///
+    D3D12_GPU_DESCRIPTOR_HANDLE CreateShaderResourceViews(ID3D12Resource* *resources,
+                                                          const D3D12_SHADER_RESOURCE_VIEW_DESC* descriptors,
+                                                          const std::uint32_t descriptorCount) noexcept;
+
     CommandListPerFrame mCommandListPerFrame;
 
     // Base command data. Once you inherits from this class, you should add
@@ -76,14 +150,26 @@ protected:
 
     FrameUploadCBufferPerFrame mFrameUploadCBufferPerFrame;
 
-    UploadBuffer* mObjectUploadCBuffers{ nullptr };
+    // Released with the recorder, once the GPU finished the frames that could use it
+    UploadBufferManager::SharedUploadBuffer mObjectUploadCBuffers;
     D3D12_GPU_DESCRIPTOR_HANDLE mObjectCBufferViewsBegin{ 0U };
 
     const D3D12_CPU_DESCRIPTOR_HANDLE* mGeometryBufferRenderTargetViews{ nullptr };
     std::uint32_t mGeometryBufferRenderTargetViewCount{ 0U };
 
     D3D12_CPU_DESCRIPTOR_HANDLE mDepthBufferView{ 0UL };
+
+    DirectX::XMFLOAT4X4 mViewProjectionMatrix{ MathUtils::GetIdentity4x4Matrix() };
+    DirectX::XMFLOAT3 mEyeWorldPosition{ 0.0f, 0.0f, 0.0f };
+    std::vector<MeshletCuller::IndexRange> mVisibleIndexRanges;
+
+    // Descriptors created by the recorder: first descriptor and descriptor count
+    std::vector<std::pair<D3D12_GPU_DESCRIPTOR_HANDLE, std::uint32_t>> mDescriptorRanges;
+
+    // Released after the descriptors of their views are enqueued to be released
+    std::vector<ResourceManager::SharedResource> mSampledTextures;
 };
 
-using GeometryCommandListRecorders = std::vector<std::unique_ptr<GeometryCommandListRecorder>>;
+// Recorders are shared, so the recorders of a reloaded scene can reuse the unchanged ones.
+using GeometryCommandListRecorders = std::vector<std::shared_ptr<GeometryCommandListRecorder>>;
 }
\ No newline at end of file
@@ -9,11 +9,13 @@
 #include <DescriptorManager\RenderTargetDescriptorManager.h>
 #include <DirectXManager\DirectXManager.h>
 #include <DXUtils/D3DFactory.h>
+#include <GeometryPass\Recorders\ColorHeightMappingCommandListRecorder.h>
+#include <GeometryPass\Recorders\ColorMappingCommandListRecorder.h>
+#include <GeometryPass\Recorders\ColorNormalMappingCommandListRecorder.h>
 #include <GeometryPass\Recorders\HeightMappingCommandListRecorder.h>
 #include <GeometryPass\Recorders\NormalMappingCommandListRecorder.h>
 #include <GeometryPass\Recorders\TextureMappingCommandListRecorder.h>
 #include <ResourceManager\ResourceManager.h>
-#include <ResourceStateManager\ResourceStateManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
 
@@ -90,7 +92,7 @@ CreateGeometryBuffersAndRenderTargetViews(ID3D12Resource* buffers[GeometryPass::
 }
 }
 
-GeometryPass::GeometryPass(GeometryCommandListRecorders& geometryPassCommandListRecorders)
+GeometryPass::GeometryPass(const GeometryCommandListRecorders& geometryPassCommandListRecorders)
     : mGeometryCommandListRecorders(geometryPassCommandListRecorders)
 {}
 
@@ -102,7 +104,11 @@ GeometryPass::Init(const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView) noexcept
     BRE_ASSERT(mGeometryCommandListRecorders.empty() == false);
 
     CreateGeometryBuffersAndRenderTargetViews(mGeometryBuffers, mGeometryBufferRenderTargetViews);
+    mDepthBufferView = depthBufferView;
 
+    ColorHeightMappingCommandListRecorder::InitSharedPSOAndRootSignature(sGeometryBufferFormats, BUFFERS_COUNT);
+    ColorMappingCommandListRecorder::InitSharedPSOAndRootSignature(sGeometryBufferFormats, BUFFERS_COUNT);
+    ColorNormalMappingCommandListRecorder::InitSharedPSOAndRootSignature(sGeometryBufferFormats, BUFFERS_COUNT);
     HeightMappingCommandListRecorder::InitSharedPSOAndRootSignature(sGeometryBufferFormats, BUFFERS_COUNT);
     NormalMappingCommandListRecorder::InitSharedPSOAndRootSignature(sGeometryBufferFormats, BUFFERS_COUNT);
     TextureMappingCommandListRecorder::InitSharedPSOAndRootSignature(sGeometryBufferFormats, BUFFERS_COUNT);
@@ -142,6 +148,25 @@ GeometryPass::Execute(const FrameCBuffer& frameCBuffer) noexcept
     return commandListCount;
 }
 
+void
+GeometryPass::ReplaceCommandListRecorders(GeometryCommandListRecorders& commandListRecorders) noexcept
+{
+    BRE_ASSERT(IsDataValid());
+    BRE_ASSERT(commandListRecorders.empty() == false);
+
+    // Unchanged recorders are initialized again, with the same views
+    for (GeometryCommandListRecorders::value_type& recorder : commandListRecorders) {
+        BRE_ASSERT(recorder.get() != nullptr);
+        recorder->Init(mGeometryBufferRenderTargetViews,
+                       BUFFERS_COUNT,
+                       mDepthBufferView);
+    }
+
+    mGeometryCommandListRecorders.swap(commandListRecorders);
+
+    BRE_ASSERT(IsDataValid());
+}
+
 bool
 GeometryPass::IsDataValid() const noexcept
 {
@@ -167,18 +192,10 @@ GeometryPass::RecordAndPushPrePassCommandLists() noexcept
 
     ID3D12GraphicsCommandList& commandList = mPrePassCommandListPerFrame.ResetCommandListWithNextCommandAllocator(nullptr);
 
-    D3D12_RESOURCE_BARRIER barriers[BUFFERS_COUNT];
-    std::uint32_t barrierCount = 0UL;
+    mPrePassResourceStateTracker.Reset();
     for (std::uint32_t i = 0U; i < BUFFERS_COUNT; ++i) {
-        if (ResourceStateManager::GetResourceState(*mGeometryBuffers[i]) != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-            barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mGeometryBuffers[i],
-                                                                                            D3D12_RESOURCE_STATE_RENDER_TARGET);
-            ++barrierCount;
-        }
-    }
-
-    if (barrierCount > 0UL) {
-        commandList.ResourceBarrier(barrierCount, barriers);
+        mPrePassResourceStateTracker.ChangeResourceState(*mGeometryBuffers[i],
+                                                         D3D12_RESOURCE_STATE_RENDER_TARGET);
     }
 
     commandList.RSSetViewports(1U, &ApplicationSettings::sScreenViewport);
@@ -189,7 +206,7 @@ GeometryPass::RecordAndPushPrePassCommandLists() noexcept
     commandList.ClearRenderTargetView(mGeometryBufferRenderTargetViews[BASECOLOR_METALNESS], zero, 0U, nullptr);
 
     BRE_CHECK_HR(commandList.Close());
-    CommandListExecutor::Get().PushCommandList(commandList);
+    CommandListExecutor::Get().PushCommandList(commandList, mPrePassResourceStateTracker);
 
     return 1U;
 }
@@ -5,6 +5,7 @@
 
 #include <CommandManager\CommandListPerFrame.h>
 #include <GeometryPass\GeometryCommandListRecorder.h>
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
 
 namespace BRE {
 struct FrameCBuffer;
@@ -21,7 +22,12 @@ public:
         BUFFERS_COUNT
     };
 
-    GeometryPass(GeometryCommandListRecorders& geometryPassCommandListRecorders);
+    ///
+    /// @brief GeometryPass constructor
+    /// @param geometryPassCommandListRecorders Geometry command list recorders. They are copied,
+    /// so the scene they belong to can be deleted (for example, when another scene replaces it).
+    ///
+    GeometryPass(const GeometryCommandListRecorders& geometryPassCommandListRecorders);
     ~GeometryPass() = default;
     GeometryPass(const GeometryPass&) = delete;
     const GeometryPass& operator=(const GeometryPass&) = delete;
@@ -75,6 +81,18 @@ public:
     ///
     std::uint32_t Execute(const FrameCBuffer& frameCBuffer) noexcept;
 
+    ///
+    /// @brief Replaces the geometry command list recorders
+    ///
+    /// Init() must be called first. Queued frames could use the current recorders, so
+    /// they must be kept until the GPU finished them.
+    /// New recorders are initialized with the geometry buffers and depth buffer views.
+    ///
+    /// @param commandListRecorders Geometry command list recorders. It must not be empty.
+    /// Once replaced, it has the previous recorders.
+    ///
+    void ReplaceCommandListRecorders(GeometryCommandListRecorders& commandListRecorders) noexcept;
+
 private:
     ///
     /// @brief Checks if internal data is valid. Typically, used for assertions
@@ -95,12 +113,15 @@ private:
     void InitShaderResourceViews() noexcept;
 
     CommandListPerFrame mPrePassCommandListPerFrame;
+    CommandListResourceStateTracker mPrePassResourceStateTracker;
 
     // Geometry buffers data
     ID3D12Resource* mGeometryBuffers[BUFFERS_COUNT]{ nullptr };
     D3D12_GPU_DESCRIPTOR_HANDLE mGeometryBufferShaderResourceViews[BUFFERS_COUNT]{ 0UL };
     D3D12_CPU_DESCRIPTOR_HANDLE mGeometryBufferRenderTargetViews[BUFFERS_COUNT]{ 0UL };
 
-    GeometryCommandListRecorders& mGeometryCommandListRecorders;
+    D3D12_CPU_DESCRIPTOR_HANDLE mDepthBufferView{ 0UL };
+
+    GeometryCommandListRecorders mGeometryCommandListRecorders;
 };
 }
\ No newline at end of file
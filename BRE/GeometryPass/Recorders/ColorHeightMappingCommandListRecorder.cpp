@@ -0,0 +1,299 @@
+#include "ColorHeightMappingCommandListRecorder.h"
+
+#include <DirectXMath.h>
+
+#include <CommandListExecutor\CommandListExecutor.h>
+#include <DescriptorManager\CbvSrvUavDescriptorManager.h>
+#include <DirectXManager\DirectXManager.h>
+#include <GeometryPass\GeometrySettings.h>
+#include <GeometryPass\Shaders\HeightMappingCBuffer.h>
+#include <MathUtils\MathUtils.h>
+#include <PSOManager\PSOManager.h>
+#include <ResourceManager\UploadBufferManager.h>
+#include <RootSignatureManager\RootSignatureManager.h>
+#include <ShaderManager\ShaderManager.h>
+#include <ShaderUtils\CBuffers.h>
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+// Root signature:
+// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Object CBuffers
+// "CBV(b1, visibility = SHADER_VISIBILITY_VERTEX), " \ 1 -> Frame CBuffer
+// "CBV(b2, visibility = SHADER_VISIBILITY_VERTEX), " \ 2 -> Height Mapping CBuffer
+// "CBV(b0, visibility = SHADER_VISIBILITY_DOMAIN), " \ 3 -> Frame CBuffer
+// "CBV(b1, visibility = SHADER_VISIBILITY_DOMAIN), " \ 4 -> Height Mapping CBuffer
+// "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_DOMAIN), " \ 5 -> Metalness Roughness Height Texture
+// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_PIXEL), " \ 6 -> Object CBuffers
+// "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_PIXEL), " \ 7 -> Normal Texture
+
+namespace {
+ID3D12PipelineState* sPSO{ nullptr };
+ID3D12RootSignature* sRootSignature{ nullptr };
+}
+
+void
+ColorHeightMappingCommandListRecorder::InitSharedPSOAndRootSignature(const DXGI_FORMAT* geometryBufferFormats,
+                                                                     const std::uint32_t geometryBufferCount) noexcept
+{
+    BRE_ASSERT(geometryBufferFormats != nullptr);
+    BRE_ASSERT(geometryBufferCount > 0U);
+    BRE_ASSERT(sPSO == nullptr);
+    BRE_ASSERT(sRootSignature == nullptr);
+
+    // Build pso and root signature
+    PSOManager::PSOCreationData psoData{};
+    psoData.mInputLayoutDescriptors = D3DFactory::GetCompressedPositionNormalTangentTexCoordInputLayout();
+
+    psoData.mDomainShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/ColorHeightMapping/DS.cso");
+    psoData.mHullShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/ColorHeightMapping/HS.cso");
+    psoData.mPixelShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/ColorHeightMapping/PS.cso");
+    psoData.mVertexShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/ColorHeightMapping/VS.cso");
+
+    ID3DBlob* rootSignatureBlob = &ShaderManager::LoadShaderFileAndGetBlob("GeometryPass/Shaders/ColorHeightMapping/RS.cso");
+    psoData.mRootSignature = &RootSignatureManager::CreateRootSignatureFromBlob(*rootSignatureBlob);
+    sRootSignature = psoData.mRootSignature;
+
+    psoData.mPrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_PATCH;
+    psoData.mNumRenderTargets = geometryBufferCount;
+    memcpy(psoData.mRenderTargetFormats, geometryBufferFormats, sizeof(DXGI_FORMAT) * psoData.mNumRenderTargets);
+    sPSO = &PSOManager::CreateGraphicsPSO(psoData);
+
+    BRE_ASSERT(sPSO != nullptr);
+    BRE_ASSERT(sRootSignature != nullptr);
+}
+
+void
+ColorHeightMappingCommandListRecorder::Init(const std::vector<GeometryData>& geometryDataVector,
+                                            const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
+                                            const std::vector<ID3D12Resource*>& normalTextures) noexcept
+{
+    BRE_ASSERT(IsDataValid() == false);
+    BRE_ASSERT(geometryDataVector.empty() == false);
+    BRE_ASSERT(metalnessRoughnessHeightTextures.empty() == false);
+    BRE_ASSERT(metalnessRoughnessHeightTextures.size() == normalTextures.size());
+
+    const std::size_t numResources = normalTextures.size();
+    const std::size_t geometryDataCount = geometryDataVector.size();
+
+    // Check that the total number of matrices (geometry to be drawn) will be equal to available materials
+#ifdef _DEBUG
+    std::size_t totalNumMatrices{ 0UL };
+    for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
+        const std::size_t numMatrices{ geometryDataVector[i].mWorldMatrices.size() };
+        totalNumMatrices += numMatrices;
+        BRE_ASSERT(numMatrices != 0UL);
+        BRE_ASSERT(geometryDataVector[i].mBaseColorsAndMetalnesses.size() == numMatrices);
+        BRE_ASSERT(geometryDataVector[i].mRoughnesses.size() == numMatrices);
+    }
+    BRE_ASSERT(totalNumMatrices == numResources);
+#endif
+    mGeometryDataVec.reserve(geometryDataCount);
+    for (std::uint32_t i = 0U; i < geometryDataCount; ++i) {
+        mGeometryDataVec.push_back(geometryDataVector[i]);
+    }
+
+    InitCBuffersAndViews(metalnessRoughnessHeightTextures,
+                         normalTextures);
+
+    BRE_ASSERT(IsDataValid());
+}
+
+std::uint32_t
+ColorHeightMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept
+{
+    BRE_ASSERT(IsDataValid());
+    BRE_ASSERT(sPSO != nullptr);
+    BRE_ASSERT(sRootSignature != nullptr);
+    BRE_ASSERT(mGeometryBufferRenderTargetViews != nullptr);
+    BRE_ASSERT(mGeometryBufferRenderTargetViewCount != 0U);
+    BRE_ASSERT(mDepthBufferView.ptr != 0U);
+
+    // Update frame constants
+    UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
+    uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
+    SetCullingView(frameCBuffer);
+
+    ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetCommandListWithNextCommandAllocator(sPSO);
+
+    commandList.RSSetViewports(1U, &ApplicationSettings::sScreenViewport);
+    commandList.RSSetScissorRects(1U, &ApplicationSettings::sScissorRect);
+    commandList.OMSetRenderTargets(mGeometryBufferRenderTargetViewCount,
+                                   mGeometryBufferRenderTargetViews,
+                                   false,
+                                   &mDepthBufferView);
+
+    ID3D12DescriptorHeap* heaps[] = { &CbvSrvUavDescriptorManager::GetDescriptorHeap() };
+    commandList.SetDescriptorHeaps(_countof(heaps), heaps);
+    commandList.SetGraphicsRootSignature(sRootSignature);
+
+    const std::size_t descHandleIncSize{ DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
+    D3D12_GPU_DESCRIPTOR_HANDLE objectCBufferView(mObjectCBufferViewsBegin);
+    // Streamed textures views are moved when their resident mip levels change
+    D3D12_GPU_DESCRIPTOR_HANDLE metalnessRoughnessHeightTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mMetalnessRoughnessHeightTextureRenderTargetViewsBegin);
+    D3D12_GPU_DESCRIPTOR_HANDLE normalTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mNormalTextureRenderTargetViewsBegin);
+
+    commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_3_CONTROL_POINT_PATCHLIST);
+
+    // Set frame constants root parameters
+    D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(
+        uploadFrameCBuffer.GetResource().GetGPUVirtualAddress());
+    const D3D12_GPU_VIRTUAL_ADDRESS heightMappingCBufferGpuVAddress(
+        mHeightMappingUploadCBuffer->GetResource().GetGPUVirtualAddress());
+    commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+    commandList.SetGraphicsRootConstantBufferView(2U, heightMappingCBufferGpuVAddress);
+    commandList.SetGraphicsRootConstantBufferView(3U, frameCBufferGpuVAddress);
+    commandList.SetGraphicsRootConstantBufferView(4U, heightMappingCBufferGpuVAddress);
+
+    // Draw objects
+    const std::size_t geomCount{ mGeometryDataVec.size() };
+    for (std::size_t i = 0UL; i < geomCount; ++i) {
+        GeometryData& geomData{ mGeometryDataVec[i] };
+        commandList.IASetVertexBuffers(0U, 1U, &geomData.mVertexBufferData.mBufferView);
+        commandList.IASetIndexBuffer(&geomData.mIndexBufferData.mBufferView);
+        const std::size_t worldMatsCount{ geomData.mWorldMatrices.size() };
+        for (std::size_t j = 0UL; j < worldMatsCount; ++j) {
+            // Vertex shader reads matrices, and pixel shader reads material constants, of the same buffer.
+            commandList.SetGraphicsRootDescriptorTable(0U, objectCBufferView);
+            commandList.SetGraphicsRootDescriptorTable(6U, objectCBufferView);
+            objectCBufferView.ptr += descHandleIncSize;
+
+            commandList.SetGraphicsRootDescriptorTable(5U, metalnessRoughnessHeightTextureRenderTargetView);
+            metalnessRoughnessHeightTextureRenderTargetView.ptr += descHandleIncSize;
+
+            commandList.SetGraphicsRootDescriptorTable(7U, normalTextureRenderTargetView);
+            normalTextureRenderTargetView.ptr += descHandleIncSize;
+
+            RecordDrawCalls(commandList, geomData, j);
+        }
+    }
+
+    commandList.Close();
+    CommandListExecutor::Get().PushCommandList(commandList);
+
+    return 1U;
+}
+
+bool
+ColorHeightMappingCommandListRecorder::IsDataValid() const noexcept
+{
+    const bool result =
+        GeometryCommandListRecorder::IsDataValid() &&
+        mMetalnessRoughnessHeightTextureRenderTargetViewsBegin.ptr != 0UL &&
+        mNormalTextureRenderTargetViewsBegin.ptr != 0UL &&
+        mHeightMappingUploadCBuffer != nullptr;
+
+    return result;
+}
+
+void
+ColorHeightMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
+                                                            const std::vector<ID3D12Resource*>& normalTextures) noexcept
+{
+    BRE_ASSERT(metalnessRoughnessHeightTextures.empty() == false);
+    BRE_ASSERT(metalnessRoughnessHeightTextures.size() == normalTextures.size());
+    BRE_ASSERT(mObjectUploadCBuffers == nullptr);
+
+    const std::uint32_t numResources = static_cast<std::uint32_t>(metalnessRoughnessHeightTextures.size());
+
+    // Create object cbuffer and fill it
+    const std::size_t objCBufferElemSize{ UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(ObjectCBuffer)) };
+    mObjectUploadCBuffers = UploadBufferManager::CreateSharedUploadBuffer(objCBufferElemSize, numResources);
+    std::uint32_t k = 0U;
+    const std::size_t geometryDataCount{ mGeometryDataVec.size() };
+    ObjectCBuffer objCBuffer;
+    for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
+        GeometryData& geomData{ mGeometryDataVec[i] };
+        const std::uint32_t worldMatsCount{ static_cast<std::uint32_t>(geomData.mWorldMatrices.size()) };
+        for (std::uint32_t j = 0UL; j < worldMatsCount; ++j) {
+            MathUtils::StoreTransposeMatrix(geomData.mWorldMatrices[j],
+                                            objCBuffer.mWorldMatrix);
+            MathUtils::StoreTransposeMatrix(geomData.mInverseTransposeWorldMatrices[j],
+                                            objCBuffer.mInverseTransposeWorldMatrix);
+            objCBuffer.mBaseColor_Metalness = geomData.mBaseColorsAndMetalnesses[j];
+            objCBuffer.mRoughness = geomData.mRoughnesses[j];
+            objCBuffer.mTextureScale = geomData.mTextureScales[j];
+            mObjectUploadCBuffers->CopyData(k + j,
+                                            &objCBuffer,
+                                            sizeof(objCBuffer));
+        }
+
+        k += worldMatsCount;
+    }
+
+    D3D12_GPU_VIRTUAL_ADDRESS objCBufferGpuAddress{ mObjectUploadCBuffers->GetResource().GetGPUVirtualAddress() };
+
+    // Create object cbuffer descriptors
+    // Create textures SRV descriptors
+    std::vector<D3D12_CONSTANT_BUFFER_VIEW_DESC> objectCbufferViewDescVec;
+    objectCbufferViewDescVec.reserve(numResources);
+
+    std::vector<ID3D12Resource*> metalnessRoughnessHeightResVec;
+    metalnessRoughnessHeightResVec.reserve(numResources);
+    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> metalnessRoughnessHeightSrvDescVec;
+    metalnessRoughnessHeightSrvDescVec.reserve(numResources);
+
+    std::vector<ID3D12Resource*> normalResVec;
+    normalResVec.reserve(numResources);
+    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> normalSrvDescVec;
+    normalSrvDescVec.reserve(numResources);
+    for (std::size_t i = 0UL; i < numResources; ++i) {
+        // Object cbuffer desc
+        D3D12_CONSTANT_BUFFER_VIEW_DESC cBufferDesc{};
+        cBufferDesc.BufferLocation = objCBufferGpuAddress + i * objCBufferElemSize;
+        cBufferDesc.SizeInBytes = static_cast<std::uint32_t>(objCBufferElemSize);
+        objectCbufferViewDescVec.push_back(cBufferDesc);
+
+        // Metalness, roughness and height descriptor
+        metalnessRoughnessHeightResVec.push_back(metalnessRoughnessHeightTextures[i]);
+
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Texture2D.MostDetailedMip = 0;
+        srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
+        srvDesc.Format = metalnessRoughnessHeightResVec.back()->GetDesc().Format;
+        srvDesc.Texture2D.MipLevels = metalnessRoughnessHeightResVec.back()->GetDesc().MipLevels;
+        metalnessRoughnessHeightSrvDescVec.push_back(srvDesc);
+
+        // Normal descriptor
+        normalResVec.push_back(normalTextures[i]);
+
+        srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Texture2D.MostDetailedMip = 0;
+        srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
+        srvDesc.Format = normalResVec.back()->GetDesc().Format;
+        srvDesc.Texture2D.MipLevels = normalResVec.back()->GetDesc().MipLevels;
+        normalSrvDescVec.push_back(srvDesc);
+    }
+
+    mObjectCBufferViewsBegin =
+        CreateConstantBufferViews(objectCbufferViewDescVec.data(),
+                                  static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
+
+    mMetalnessRoughnessHeightTextureRenderTargetViewsBegin =
+        CreateShaderResourceViews(metalnessRoughnessHeightResVec.data(),
+                                  metalnessRoughnessHeightSrvDescVec.data(),
+                                  static_cast<std::uint32_t>(metalnessRoughnessHeightSrvDescVec.size()));
+
+    mNormalTextureRenderTargetViewsBegin =
+        CreateShaderResourceViews(normalResVec.data(),
+                                  normalSrvDescVec.data(),
+                                  static_cast<std::uint32_t>(normalSrvDescVec.size()));
+
+    // Height mapping constant buffer
+    const std::size_t heightMappingUploadCBufferElemSize =
+        UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(HeightMappingCBuffer));
+
+    mHeightMappingUploadCBuffer = UploadBufferManager::CreateSharedUploadBuffer(heightMappingUploadCBufferElemSize,
+                                                                                1U);
+    HeightMappingCBuffer heightMappingCBuffer(GeometrySettings::sMinTessellationDistance,
+                                              GeometrySettings::sMaxTessellationDistance,
+                                              GeometrySettings::sMinTessellationFactor,
+                                              GeometrySettings::sMaxTessellationFactor,
+                                              GeometrySettings::sHeightScale);
+
+    mHeightMappingUploadCBuffer->CopyData(0U, &heightMappingCBuffer, sizeof(HeightMappingCBuffer));
+}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <GeometryPass\GeometryCommandListRecorder.h>
+#include <ResourceManager\UploadBuffer.h>
+#include <ResourceManager\UploadBufferManager.h>
+
+namespace BRE {
+///
+/// @brief Responsible to record command lists that implement color height mapping
+///
+/// Base color, metalness and roughness are constants of the object constant buffer,
+/// so only the height (blue channel of the metalness, roughness and height texture)
+/// and normal textures are sampled.
+///
+class ColorHeightMappingCommandListRecorder : public GeometryCommandListRecorder {
+public:
+    ColorHeightMappingCommandListRecorder() = default;
+    ~ColorHeightMappingCommandListRecorder() = default;
+    ColorHeightMappingCommandListRecorder(const ColorHeightMappingCommandListRecorder&) = delete;
+    const ColorHeightMappingCommandListRecorder& operator=(const ColorHeightMappingCommandListRecorder&) = delete;
+    ColorHeightMappingCommandListRecorder(ColorHeightMappingCommandListRecorder&&) = default;
+    ColorHeightMappingCommandListRecorder& operator=(ColorHeightMappingCommandListRecorder&&) = default;
+
+    ///
+    /// @brief Initializes pipeline state object and root signature
+    /// @param geometryBufferFormats List of geometry buffers formats. It must be not nullptr
+    /// @param geometryBufferCount Number of geometry buffers formats in @p geometryBufferFormats
+    ///
+    static void InitSharedPSOAndRootSignature(const DXGI_FORMAT* geometryBufferFormats,
+                                              const std::uint32_t geometryBufferCount) noexcept;
+
+    ///
+    /// @brief Initializes the recorder
+    ///
+    /// InitSharedPSOAndRootSignature() must be called first
+    ///
+    /// @param geometryDataVector List of geometry data. Must not be empty.
+    /// Base colors, metalnesses and roughnesses must be set.
+    /// @param metalnessRoughnessHeightTextures List of metalness, roughness and height textures. Must not be empty.
+    /// @param normalTextures List of normal textures. Must not be empty.
+    ///
+    void Init(const std::vector<GeometryData>& geometryDataVector,
+              const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
+              const std::vector<ID3D12Resource*>& normalTextures) noexcept;
+
+    ///
+    /// @brief Records and push command lists to CommandListExecutor
+    ///
+    /// Init() must be called first
+    ///
+    /// @param frameCBuffer Constant buffer per frame, for current frame
+    /// @return The number of pushed command lists
+    ///
+    std::uint32_t RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept final override;
+
+    ///
+    /// @brief Checks if internal data is valid. Typically, used for assertions
+    /// @return True if valid. Otherwise, false
+    ///
+    bool IsDataValid() const noexcept final override;
+
+private:
+    ///
+    /// @brief Initializes the constant buffers and views
+    /// @param metalnessRoughnessHeightTextures List of metalness, roughness and height textures. Must not be empty.
+    /// @param normalTextures List of normal textures. Must not be empty.
+    ///
+    void InitCBuffersAndViews(const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
+                              const std::vector<ID3D12Resource*>& normalTextures) noexcept;
+
+    // First descriptor in the list. All the others are contiguous
+    D3D12_GPU_DESCRIPTOR_HANDLE mMetalnessRoughnessHeightTextureRenderTargetViewsBegin{ 0U };
+
+    // First descriptor in the list. All the others are contiguous
+    D3D12_GPU_DESCRIPTOR_HANDLE mNormalTextureRenderTargetViewsBegin{ 0U };
+
+    UploadBufferManager::SharedUploadBuffer mHeightMappingUploadCBuffer;
+};
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "ColorMappingCommandListRecorder.h"
+
+#include <DirectXMath.h>
+
+#include <CommandListExecutor\CommandListExecutor.h>
+#include <DescriptorManager\CbvSrvUavDescriptorManager.h>
+#include <DirectXManager\DirectXManager.h>
+#include <MathUtils\MathUtils.h>
+#include <PSOManager\PSOManager.h>
+#include <ResourceManager\UploadBufferManager.h>
+#include <RootSignatureManager\RootSignatureManager.h>
+#include <ShaderManager\ShaderManager.h>
+#include <ShaderUtils\CBuffers.h>
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+// Root Signature:
+// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Object CBuffers
+// "CBV(b1, visibility = SHADER_VISIBILITY_VERTEX), " \ 1 -> Frame CBuffer
+// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_PIXEL)" \ 2 -> Object CBuffers
+
+namespace {
+ID3D12PipelineState* sPSO{ nullptr };
+ID3D12RootSignature* sRootSignature{ nullptr };
+}
+
+void
+ColorMappingCommandListRecorder::InitSharedPSOAndRootSignature(const DXGI_FORMAT* geometryBufferFormats,
+                                                               const std::uint32_t geometryBufferCount) noexcept
+{
+    BRE_ASSERT(geometryBufferFormats != nullptr);
+    BRE_ASSERT(geometryBufferCount > 0U);
+    BRE_ASSERT(sPSO == nullptr);
+    BRE_ASSERT(sRootSignature == nullptr);
+
+    // Build pso and root signature
+    PSOManager::PSOCreationData psoData{};
+    psoData.mInputLayoutDescriptors = D3DFactory::GetCompressedPositionNormalTangentTexCoordInputLayout();
+
+    psoData.mPixelShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/ColorMapping/PS.cso");
+    psoData.mVertexShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/ColorMapping/VS.cso");
+
+    ID3DBlob* rootSignatureBlob = &ShaderManager::LoadShaderFileAndGetBlob("GeometryPass/Shaders/ColorMapping/RS.cso");
+    psoData.mRootSignature = &RootSignatureManager::CreateRootSignatureFromBlob(*rootSignatureBlob);
+    sRootSignature = psoData.mRootSignature;
+
+    psoData.mNumRenderTargets = geometryBufferCount;
+    memcpy(psoData.mRenderTargetFormats, geometryBufferFormats, sizeof(DXGI_FORMAT) * psoData.mNumRenderTargets);
+    sPSO = &PSOManager::CreateGraphicsPSO(psoData);
+
+    BRE_ASSERT(sPSO != nullptr);
+    BRE_ASSERT(sRootSignature != nullptr);
+}
+
+void
+ColorMappingCommandListRecorder::Init(const std::vector<GeometryData>& geometryDataVector) noexcept
+{
+    BRE_ASSERT(IsDataValid() == false);
+    BRE_ASSERT(geometryDataVector.empty() == false);
+
+    const std::size_t geometryDataCount = geometryDataVector.size();
+
+    // Each object has its own material constants
+    std::uint32_t objectCount{ 0U };
+    for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
+        const std::size_t numMatrices{ geometryDataVector[i].mWorldMatrices.size() };
+        BRE_ASSERT(numMatrices != 0UL);
+        BRE_ASSERT(geometryDataVector[i].mBaseColorsAndMetalnesses.size() == numMatrices);
+        BRE_ASSERT(geometryDataVector[i].mRoughnesses.size() == numMatrices);
+        objectCount += static_cast<std::uint32_t>(numMatrices);
+    }
+
+    mGeometryDataVec.reserve(geometryDataCount);
+    for (std::uint32_t i = 0U; i < geometryDataCount; ++i) {
+        mGeometryDataVec.push_back(geometryDataVector[i]);
+    }
+
+    InitCBuffersAndViews(objectCount);
+
+    BRE_ASSERT(IsDataValid());
+}
+
+std::uint32_t
+ColorMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept
+{
+    BRE_ASSERT(IsDataValid());
+    BRE_ASSERT(sPSO != nullptr);
+    BRE_ASSERT(sRootSignature != nullptr);
+    BRE_ASSERT(mGeometryBufferRenderTargetViews != nullptr);
+    BRE_ASSERT(mGeometryBufferRenderTargetViewCount != 0U);
+    BRE_ASSERT(mDepthBufferView.ptr != 0U);
+
+    // Update frame constants
+    UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
+    uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
+    SetCullingView(frameCBuffer);
+
+    ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetCommandListWithNextCommandAllocator(sPSO);
+
+    commandList.RSSetViewports(1U, &ApplicationSettings::sScreenViewport);
+    commandList.RSSetScissorRects(1U, &ApplicationSettings::sScissorRect);
+    commandList.OMSetRenderTargets(mGeometryBufferRenderTargetViewCount,
+                                   mGeometryBufferRenderTargetViews,
+                                   false,
+                                   &mDepthBufferView);
+
+    ID3D12DescriptorHeap* heaps[] = { &CbvSrvUavDescriptorManager::GetDescriptorHeap() };
+    commandList.SetDescriptorHeaps(_countof(heaps), heaps);
+    commandList.SetGraphicsRootSignature(sRootSignature);
+
+    const std::size_t descHandleIncSize{ DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
+    D3D12_GPU_DESCRIPTOR_HANDLE objectCBufferView(mObjectCBufferViewsBegin);
+
+    commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    // Set frame constants root parameters
+    D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.GetResource().GetGPUVirtualAddress());
+    commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+
+    // Draw objects
+    const std::size_t geomCount{ mGeometryDataVec.size() };
+    for (std::size_t i = 0UL; i < geomCount; ++i) {
+        GeometryData& geomData{ mGeometryDataVec[i] };
+        commandList.IASetVertexBuffers(0U, 1U, &geomData.mVertexBufferData.mBufferView);
+        commandList.IASetIndexBuffer(&geomData.mIndexBufferData.mBufferView);
+        const std::size_t worldMatsCount{ geomData.mWorldMatrices.size() };
+        for (std::size_t j = 0UL; j < worldMatsCount; ++j) {
+            // Vertex shader reads matrices, and pixel shader reads material constants, of the same buffer.
+            commandList.SetGraphicsRootDescriptorTable(0U, objectCBufferView);
+            commandList.SetGraphicsRootDescriptorTable(2U, objectCBufferView);
+            objectCBufferView.ptr += descHandleIncSize;
+
+            RecordDrawCalls(commandList, geomData, j);
+        }
+    }
+
+    commandList.Close();
+    CommandListExecutor::Get().PushCommandList(commandList);
+
+    return 1U;
+}
+
+bool
+ColorMappingCommandListRecorder::IsDataValid() const noexcept
+{
+    return GeometryCommandListRecorder::IsDataValid();
+}
+
+void
+ColorMappingCommandListRecorder::InitCBuffersAndViews(const std::uint32_t objectCount) noexcept
+{
+    BRE_ASSERT(objectCount != 0U);
+    BRE_ASSERT(mObjectUploadCBuffers == nullptr);
+
+    // Create object cbuffer and fill it
+    const std::size_t objCBufferElemSize{ UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(ObjectCBuffer)) };
+    mObjectUploadCBuffers = UploadBufferManager::CreateSharedUploadBuffer(objCBufferElemSize, objectCount);
+    std::uint32_t k = 0U;
+    const std::size_t geometryDataCount{ mGeometryDataVec.size() };
+    ObjectCBuffer objCBuffer;
+    for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
+        GeometryData& geomData{ mGeometryDataVec[i] };
+        const std::uint32_t worldMatsCount{ static_cast<std::uint32_t>(geomData.mWorldMatrices.size()) };
+        for (std::uint32_t j = 0UL; j < worldMatsCount; ++j) {
+            MathUtils::StoreTransposeMatrix(geomData.mWorldMatrices[j],
+                                            objCBuffer.mWorldMatrix);
+            MathUtils::StoreTransposeMatrix(geomData.mInverseTransposeWorldMatrices[j],
+                                            objCBuffer.mInverseTransposeWorldMatrix);
+            objCBuffer.mBaseColor_Metalness = geomData.mBaseColorsAndMetalnesses[j];
+            objCBuffer.mRoughness = geomData.mRoughnesses[j];
+            objCBuffer.mTextureScale = geomData.mTextureScales[j];
+            mObjectUploadCBuffers->CopyData(k + j,
+                                            &objCBuffer,
+                                            sizeof(objCBuffer));
+        }
+
+        k += worldMatsCount;
+    }
+
+    D3D12_GPU_VIRTUAL_ADDRESS objCBufferGpuAddress{ mObjectUploadCBuffers->GetResource().GetGPUVirtualAddress() };
+
+    // Create object cbuffer descriptors
+    std::vector<D3D12_CONSTANT_BUFFER_VIEW_DESC> objectCbufferViewDescVec;
+    objectCbufferViewDescVec.reserve(objectCount);
+    for (std::size_t i = 0UL; i < objectCount; ++i) {
+        D3D12_CONSTANT_BUFFER_VIEW_DESC cBufferDesc{};
+        cBufferDesc.BufferLocation = objCBufferGpuAddress + i * objCBufferElemSize;
+        cBufferDesc.SizeInBytes = static_cast<std::uint32_t>(objCBufferElemSize);
+        objectCbufferViewDescVec.push_back(cBufferDesc);
+    }
+
+    mObjectCBufferViewsBegin =
+        CreateConstantBufferViews(objectCbufferViewDescVec.data(),
+                                  static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
+}
+}
\ No newline at end of file
@@ -22,12 +22,11 @@ namespace BRE {
 // "CBV(b2, visibility = SHADER_VISIBILITY_VERTEX), " \ 2 -> Height Mapping CBuffer
 // "CBV(b0, visibility = SHADER_VISIBILITY_DOMAIN), " \ 3 -> Frame CBuffer
 // "CBV(b1, visibility = SHADER_VISIBILITY_DOMAIN), " \ 4 -> Height Mapping CBuffer
-// "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_DOMAIN), " \ 5 -> Height Texture
+// "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_DOMAIN), " \ 5 -> Metalness Roughness Height Texture
 // "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \ 6 -> Frame CBuffer
 // "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_PIXEL), " \ 7 -> Base Color Texture
-// "DescriptorTable(SRV(t1), visibility = SHADER_VISIBILITY_PIXEL), " \ 8 -> Metalness Texture
-// "DescriptorTable(SRV(t2), visibility = SHADER_VISIBILITY_PIXEL), " \ 9 -> Roughness Texture
-// "DescriptorTable(SRV(t3), visibility = SHADER_VISIBILITY_PIXEL), " \ 10 -> Normal Texture
+// "DescriptorTable(SRV(t1), visibility = SHADER_VISIBILITY_PIXEL), " \ 8 -> Metalness Roughness Height Texture
+// "DescriptorTable(SRV(t2), visibility = SHADER_VISIBILITY_PIXEL), " \ 9 -> Normal Texture
 
 namespace {
 ID3D12PipelineState* sPSO{ nullptr };
@@ -45,7 +44,7 @@ HeightMappingCommandListRecorder::InitSharedPSOAndRootSignature(const DXGI_FORMA
 
     // Build pso and root signature
     PSOManager::PSOCreationData psoData{};
-    psoData.mInputLayoutDescriptors = D3DFactory::GetPositionNormalTangentTexCoordInputLayout();
+    psoData.mInputLayoutDescriptors = D3DFactory::GetCompressedPositionNormalTangentTexCoordInputLayout();
 
     psoData.mDomainShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/HeightMapping/DS.cso");
     psoData.mHullShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/HeightMapping/HS.cso");
@@ -68,18 +67,14 @@ HeightMappingCommandListRecorder::InitSharedPSOAndRootSignature(const DXGI_FORMA
 void
 HeightMappingCommandListRecorder::Init(const std::vector<GeometryData>& geometryDataVector,
                                        const std::vector<ID3D12Resource*>& baseColorTextures,
-                                       const std::vector<ID3D12Resource*>& metalnessTextures,
-                                       const std::vector<ID3D12Resource*>& roughnessTextures,
-                                       const std::vector<ID3D12Resource*>& normalTextures,
-                                       const std::vector<ID3D12Resource*>& heightTextures) noexcept
+                                       const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
+                                       const std::vector<ID3D12Resource*>& normalTextures) noexcept
 {
     BRE_ASSERT(IsDataValid() == false);
     BRE_ASSERT(geometryDataVector.empty() == false);
     BRE_ASSERT(baseColorTextures.empty() == false);
-    BRE_ASSERT(baseColorTextures.size() == metalnessTextures.size());
-    BRE_ASSERT(metalnessTextures.size() == roughnessTextures.size());
-    BRE_ASSERT(roughnessTextures.size() == normalTextures.size());
-    BRE_ASSERT(normalTextures.size() == heightTextures.size());
+    BRE_ASSERT(baseColorTextures.size() == metalnessRoughnessHeightTextures.size());
+    BRE_ASSERT(metalnessRoughnessHeightTextures.size() == normalTextures.size());
 
     const std::size_t numResources = baseColorTextures.size();
     const std::size_t geometryDataCount = geometryDataVector.size();
@@ -100,10 +95,8 @@ HeightMappingCommandListRecorder::Init(const std::vector<GeometryData>& geometry
     }
 
     InitCBuffersAndViews(baseColorTextures,
-                         metalnessTextures,
-                         roughnessTextures,
-                         normalTextures,
-                         heightTextures);
+                         metalnessRoughnessHeightTextures,
+                         normalTextures);
 
     BRE_ASSERT(IsDataValid());
 }
@@ -121,6 +114,7 @@ HeightMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
     // Update frame constants
     UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
     uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
+    SetCullingView(frameCBuffer);
 
     ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetCommandListWithNextCommandAllocator(sPSO);
 
@@ -137,11 +131,10 @@ HeightMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
 
     const std::size_t descHandleIncSize{ DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
     D3D12_GPU_DESCRIPTOR_HANDLE objectCBufferView(mObjectCBufferViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE baseColorTextureRenderTargetView(mBaseColorTextureRenderTargetViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE metalnessTextureRenderTargetView(mMetalnessTextureRenderTargetViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE roughnessTextureRenderTargetView(mRoughnessTextureRenderTargetViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE normalTextureRenderTargetView(mNormalTextureRenderTargetViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE heightTextureRenderTargetView(mHeightTextureRenderTargetViewsBegin);
+    // Streamed textures views are moved when their resident mip levels change
+    D3D12_GPU_DESCRIPTOR_HANDLE baseColorTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mBaseColorTextureRenderTargetViewsBegin);
+    D3D12_GPU_DESCRIPTOR_HANDLE metalnessRoughnessHeightTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mMetalnessRoughnessHeightTextureRenderTargetViewsBegin);
+    D3D12_GPU_DESCRIPTOR_HANDLE normalTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mNormalTextureRenderTargetViewsBegin);
 
     commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_3_CONTROL_POINT_PATCHLIST);
 
@@ -167,22 +160,18 @@ HeightMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
             commandList.SetGraphicsRootDescriptorTable(0U, objectCBufferView);
             objectCBufferView.ptr += descHandleIncSize;
 
-            commandList.SetGraphicsRootDescriptorTable(5U, heightTextureRenderTargetView);
-            heightTextureRenderTargetView.ptr += descHandleIncSize;
+            // Domain shader samples height, and pixel shader samples metalness and roughness, of the same texture.
+            commandList.SetGraphicsRootDescriptorTable(5U, metalnessRoughnessHeightTextureRenderTargetView);
+            commandList.SetGraphicsRootDescriptorTable(8U, metalnessRoughnessHeightTextureRenderTargetView);
+            metalnessRoughnessHeightTextureRenderTargetView.ptr += descHandleIncSize;
 
             commandList.SetGraphicsRootDescriptorTable(7U, baseColorTextureRenderTargetView);
             baseColorTextureRenderTargetView.ptr += descHandleIncSize;
 
-            commandList.SetGraphicsRootDescriptorTable(8U, metalnessTextureRenderTargetView);
-            metalnessTextureRenderTargetView.ptr += descHandleIncSize;
-
-            commandList.SetGraphicsRootDescriptorTable(9U, roughnessTextureRenderTargetView);
-            roughnessTextureRenderTargetView.ptr += descHandleIncSize;
-
-            commandList.SetGraphicsRootDescriptorTable(10U, normalTextureRenderTargetView);
+            commandList.SetGraphicsRootDescriptorTable(9U, normalTextureRenderTargetView);
             normalTextureRenderTargetView.ptr += descHandleIncSize;
 
-            commandList.DrawIndexedInstanced(geomData.mIndexBufferData.mElementCount, 1U, 0U, 0U, 0U);
+            RecordDrawCalls(commandList, geomData, j);
         }
     }
 
@@ -198,10 +187,8 @@ HeightMappingCommandListRecorder::IsDataValid() const noexcept
     const bool result =
         GeometryCommandListRecorder::IsDataValid() &&
         mBaseColorTextureRenderTargetViewsBegin.ptr != 0UL &&
-        mMetalnessTextureRenderTargetViewsBegin.ptr != 0UL &&
-        mRoughnessTextureRenderTargetViewsBegin.ptr != 0UL &&
+        mMetalnessRoughnessHeightTextureRenderTargetViewsBegin.ptr != 0UL &&
         mNormalTextureRenderTargetViewsBegin.ptr != 0UL &&
-        mHeightTextureRenderTargetViewsBegin.ptr != 0UL &&
         mHeightMappingUploadCBuffer != nullptr;
 
     return result;
@@ -209,23 +196,19 @@ HeightMappingCommandListRecorder::IsDataValid() const noexcept
 
 void
 HeightMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12Resource*>& baseColorTextures,
-                                                       const std::vector<ID3D12Resource*>& metalnessTextures,
-                                                       const std::vector<ID3D12Resource*>& roughnessTextures,
-                                                       const std::vector<ID3D12Resource*>& normalTextures,
-                                                       const std::vector<ID3D12Resource*>& heightTextures) noexcept
+                                                       const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
+                                                       const std::vector<ID3D12Resource*>& normalTextures) noexcept
 {
     BRE_ASSERT(baseColorTextures.empty() == false);
-    BRE_ASSERT(baseColorTextures.size() == metalnessTextures.size());
-    BRE_ASSERT(metalnessTextures.size() == roughnessTextures.size());
-    BRE_ASSERT(roughnessTextures.size() == normalTextures.size());
-    BRE_ASSERT(normalTextures.size() == heightTextures.size());
+    BRE_ASSERT(baseColorTextures.size() == metalnessRoughnessHeightTextures.size());
+    BRE_ASSERT(metalnessRoughnessHeightTextures.size() == normalTextures.size());
     BRE_ASSERT(mObjectUploadCBuffers == nullptr);
 
     const std::uint32_t numResources = static_cast<std::uint32_t>(baseColorTextures.size());
 
     // Create object cbuffer and fill it
     const std::size_t objCBufferElemSize{ UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(ObjectCBuffer)) };
-    mObjectUploadCBuffers = &UploadBufferManager::CreateUploadBuffer(objCBufferElemSize, numResources);
+    mObjectUploadCBuffers = UploadBufferManager::CreateSharedUploadBuffer(objCBufferElemSize, numResources);
     std::uint32_t k = 0U;
     const std::size_t geometryDataCount{ mGeometryDataVec.size() };
     ObjectCBuffer objCBuffer;
@@ -259,25 +242,15 @@ HeightMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12R
     std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> textureSrvDescVec;
     textureSrvDescVec.reserve(numResources);
 
-    std::vector<ID3D12Resource*> metalnessResVec;
-    metalnessResVec.reserve(numResources);
-    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> metalnessSrvDescVec;
-    metalnessSrvDescVec.reserve(numResources);
-
-    std::vector<ID3D12Resource*> roughnessResVec;
-    roughnessResVec.reserve(numResources);
-    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> roughnessSrvDescVec;
-    roughnessSrvDescVec.reserve(numResources);
+    std::vector<ID3D12Resource*> metalnessRoughnessHeightResVec;
+    metalnessRoughnessHeightResVec.reserve(numResources);
+    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> metalnessRoughnessHeightSrvDescVec;
+    metalnessRoughnessHeightSrvDescVec.reserve(numResources);
 
     std::vector<ID3D12Resource*> normalResVec;
     normalResVec.reserve(numResources);
     std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> normalSrvDescVec;
     normalSrvDescVec.reserve(numResources);
-
-    std::vector<ID3D12Resource*> heightResVec;
-    heightResVec.reserve(numResources);
-    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> heightSrvDescVec;
-    heightSrvDescVec.reserve(numResources);
     for (std::size_t i = 0UL; i < numResources; ++i) {
         // Object cbuffer desc
         D3D12_CONSTANT_BUFFER_VIEW_DESC cBufferDesc{};
@@ -296,29 +269,17 @@ HeightMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12R
         srvDesc.Texture2D.MipLevels = textureResVec.back()->GetDesc().MipLevels;
         textureSrvDescVec.push_back(srvDesc);
 
-        // Metalness descriptor
-        metalnessResVec.push_back(metalnessTextures[i]);
+        // Metalness, roughness and height descriptor
+        metalnessRoughnessHeightResVec.push_back(metalnessRoughnessHeightTextures[i]);
 
         srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
         srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
         srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
         srvDesc.Texture2D.MostDetailedMip = 0;
         srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-        srvDesc.Format = metalnessResVec.back()->GetDesc().Format;
-        srvDesc.Texture2D.MipLevels = metalnessResVec.back()->GetDesc().MipLevels;
-        metalnessSrvDescVec.push_back(srvDesc);
-
-        // Roughness descriptor
-        roughnessResVec.push_back(roughnessTextures[i]);
-
-        srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
-        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Texture2D.MostDetailedMip = 0;
-        srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-        srvDesc.Format = roughnessResVec.back()->GetDesc().Format;
-        srvDesc.Texture2D.MipLevels = roughnessResVec.back()->GetDesc().MipLevels;
-        roughnessSrvDescVec.push_back(srvDesc);
+        srvDesc.Format = metalnessRoughnessHeightResVec.back()->GetDesc().Format;
+        srvDesc.Texture2D.MipLevels = metalnessRoughnessHeightResVec.back()->GetDesc().MipLevels;
+        metalnessRoughnessHeightSrvDescVec.push_back(srvDesc);
 
         // Normal descriptor
         normalResVec.push_back(normalTextures[i]);
@@ -330,54 +291,33 @@ HeightMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12R
         srvDesc.Format = normalResVec.back()->GetDesc().Format;
         srvDesc.Texture2D.MipLevels = normalResVec.back()->GetDesc().MipLevels;
         normalSrvDescVec.push_back(srvDesc);
-
-        // Height descriptor
-        heightResVec.push_back(heightTextures[i]);
-        srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
-        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Texture2D.MostDetailedMip = 0;
-        srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-        srvDesc.Format = heightResVec.back()->GetDesc().Format;
-        srvDesc.Texture2D.MipLevels = heightResVec.back()->GetDesc().MipLevels;
-        heightSrvDescVec.push_back(srvDesc);
     }
 
     mObjectCBufferViewsBegin =
-        CbvSrvUavDescriptorManager::CreateConstantBufferViews(objectCbufferViewDescVec.data(),
-                                                              static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
+        CreateConstantBufferViews(objectCbufferViewDescVec.data(),
+                                  static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
 
     mBaseColorTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(textureResVec.data(),
-                                                              textureSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(textureSrvDescVec.size()));
+        CreateShaderResourceViews(textureResVec.data(),
+                                  textureSrvDescVec.data(),
+                                  static_cast<std::uint32_t>(textureSrvDescVec.size()));
 
-    mMetalnessTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(metalnessResVec.data(),
-                                                              metalnessSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(metalnessSrvDescVec.size()));
-
-    mRoughnessTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(roughnessResVec.data(),
-                                                              roughnessSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(roughnessSrvDescVec.size()));
+    mMetalnessRoughnessHeightTextureRenderTargetViewsBegin =
+        CreateShaderResourceViews(metalnessRoughnessHeightResVec.data(),
+                                  metalnessRoughnessHeightSrvDescVec.data(),
+                                  static_cast<std::uint32_t>(metalnessRoughnessHeightSrvDescVec.size()));
 
     mNormalTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(normalResVec.data(),
-                                                              normalSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(normalSrvDescVec.size()));
-
-    mHeightTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(heightResVec.data(),
-                                                              heightSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(heightSrvDescVec.size()));
+        CreateShaderResourceViews(normalResVec.data(),
+                                  normalSrvDescVec.data(),
+                                  static_cast<std::uint32_t>(normalSrvDescVec.size()));
 
     // Height mapping constant buffer
     const std::size_t heightMappingUploadCBufferElemSize =
         UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(HeightMappingCBuffer));
 
-    mHeightMappingUploadCBuffer = &UploadBufferManager::CreateUploadBuffer(heightMappingUploadCBufferElemSize,
-                                                                           1U);
+    mHeightMappingUploadCBuffer = UploadBufferManager::CreateSharedUploadBuffer(heightMappingUploadCBufferElemSize,
+                                                                                1U);
     HeightMappingCBuffer heightMappingCBuffer(GeometrySettings::sMinTessellationDistance,
                                               GeometrySettings::sMaxTessellationDistance,
                                               GeometrySettings::sMinTessellationFactor,
@@ -2,6 +2,7 @@
 
 #include <GeometryPass/GeometryCommandListRecorder.h>
 #include <ResourceManager\UploadBuffer.h>
+#include <ResourceManager\UploadBufferManager.h>
 
 namespace BRE {
 ///
@@ -31,17 +32,13 @@ public:
     ///
     /// @param geometryDataVector List of geometry data. Must not be empty
     /// @param baseColorTextures List of base color textures. Must not be empty.
-    /// @param metalnessTextures List of metalness textures. Must not be empty.
-    /// @param roughnessTextures List of rougness textures. Must not be empty.
+    /// @param metalnessRoughnessHeightTextures List of metalness, roughness and height textures. Must not be empty.
     /// @param normalTextures List of normal textures. Must not be empty.
-    /// @param heightTextures List of height textures. Must not be empty.
     ///
     void Init(const std::vector<GeometryData>& geometryDataVector,
               const std::vector<ID3D12Resource*>& baseColorTextures,
-              const std::vector<ID3D12Resource*>& metalnessTextures,
-              const std::vector<ID3D12Resource*>& roughnessTextures,
-              const std::vector<ID3D12Resource*>& normalTextures,
-              const std::vector<ID3D12Resource*>& heightTextures) noexcept;
+              const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
+              const std::vector<ID3D12Resource*>& normalTextures) noexcept;
 
     ///
     /// @brief Records and push command lists to CommandListExecutor
@@ -63,32 +60,22 @@ private:
     ///
     /// @brief Initializes the constant buffers and views
     /// @param baseColorTextures List of base color textures. Must not be empty.
-    /// @param metalnessTextures List of metalness textures. Must not be empty.
-    /// @param roughnessTextures List of rougness textures. Must not be empty.
+    /// @param metalnessRoughnessHeightTextures List of metalness, roughness and height textures. Must not be empty.
     /// @param normalTextures List of normal textures. Must not be empty.
-    /// @param heightTextures List of height textures. Must not be empty.
     ///
     void InitCBuffersAndViews(const std::vector<ID3D12Resource*>& baseColorTextures,
-                              const std::vector<ID3D12Resource*>& metalnessTextures,
-                              const std::vector<ID3D12Resource*>& roughnessTextures,
-                              const std::vector<ID3D12Resource*>& normalTextures,
-                              const std::vector<ID3D12Resource*>& heightTextures) noexcept;
+                              const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
+                              const std::vector<ID3D12Resource*>& normalTextures) noexcept;
 
     // First descriptor in the list. All the others are contiguous
     D3D12_GPU_DESCRIPTOR_HANDLE mBaseColorTextureRenderTargetViewsBegin{ 0U };
 
     // First descriptor in the list. All the others are contiguous
-    D3D12_GPU_DESCRIPTOR_HANDLE mMetalnessTextureRenderTargetViewsBegin{ 0U };
-
-    // First descriptor in the list. All the others are contiguous
-    D3D12_GPU_DESCRIPTOR_HANDLE mRoughnessTextureRenderTargetViewsBegin{ 0U };
+    D3D12_GPU_DESCRIPTOR_HANDLE mMetalnessRoughnessHeightTextureRenderTargetViewsBegin{ 0U };
 
     // First descriptor in the list. All the others are contiguous
     D3D12_GPU_DESCRIPTOR_HANDLE mNormalTextureRenderTargetViewsBegin{ 0U };
 
-    // First descriptor in the list. All the others are contiguous
-    D3D12_GPU_DESCRIPTOR_HANDLE mHeightTextureRenderTargetViewsBegin{ 0U };
-
-    UploadBuffer* mHeightMappingUploadCBuffer{ nullptr };
+    UploadBufferManager::SharedUploadBuffer mHeightMappingUploadCBuffer;
 };
 }
\ No newline at end of file
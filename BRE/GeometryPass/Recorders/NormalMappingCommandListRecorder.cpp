@@ -19,9 +19,8 @@ namespace BRE {
 // "CBV(b1, visibility = SHADER_VISIBILITY_VERTEX), " \ 1 -> Frame CBuffers
 // "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \ 2 -> Frame CBuffer
 // "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_PIXEL), " \ 3 -> Base Color Texture
-// "DescriptorTable(SRV(t1), visibility = SHADER_VISIBILITY_PIXEL), " \ 4 -> Metalness Texture
-// "DescriptorTable(SRV(t2), visibility = SHADER_VISIBILITY_PIXEL), " \ 5 -> Roughness Texture
-// "DescriptorTable(SRV(t3), visibility = SHADER_VISIBILITY_PIXEL), " \ 6 -> Normal Texture
+// "DescriptorTable(SRV(t1), visibility = SHADER_VISIBILITY_PIXEL), " \ 4 -> Metalness Roughness Height Texture
+// "DescriptorTable(SRV(t2), visibility = SHADER_VISIBILITY_PIXEL), " \ 5 -> Normal Texture
 
 namespace {
 ID3D12PipelineState* sPSO{ nullptr };
@@ -39,7 +38,7 @@ NormalMappingCommandListRecorder::InitSharedPSOAndRootSignature(const DXGI_FORMA
 
     // Build pso and root signature
     PSOManager::PSOCreationData psoData{};
-    psoData.mInputLayoutDescriptors = D3DFactory::GetPositionNormalTangentTexCoordInputLayout();
+    psoData.mInputLayoutDescriptors = D3DFactory::GetCompressedPositionNormalTangentTexCoordInputLayout();
     psoData.mPixelShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/NormalMapping/PS.cso");
     psoData.mVertexShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/NormalMapping/VS.cso");
 
@@ -58,16 +57,14 @@ NormalMappingCommandListRecorder::InitSharedPSOAndRootSignature(const DXGI_FORMA
 void
 NormalMappingCommandListRecorder::Init(const std::vector<GeometryData>& geometryDataVector,
                                        const std::vector<ID3D12Resource*>& baseColorTextures,
-                                       const std::vector<ID3D12Resource*>& metalnessTextures,
-                                       const std::vector<ID3D12Resource*>& roughnessTextures,
+                                       const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
                                        const std::vector<ID3D12Resource*>& normalTextures) noexcept
 {
     BRE_ASSERT(IsDataValid() == false);
     BRE_ASSERT(geometryDataVector.empty() == false);
     BRE_ASSERT(baseColorTextures.empty() == false);
-    BRE_ASSERT(baseColorTextures.size() == metalnessTextures.size());
-    BRE_ASSERT(metalnessTextures.size() == roughnessTextures.size());
-    BRE_ASSERT(roughnessTextures.size() == normalTextures.size());
+    BRE_ASSERT(baseColorTextures.size() == metalnessRoughnessHeightTextures.size());
+    BRE_ASSERT(metalnessRoughnessHeightTextures.size() == normalTextures.size());
 
     const std::size_t numResources = baseColorTextures.size();
     const std::size_t geometryDataCount = geometryDataVector.size();
@@ -88,8 +85,7 @@ NormalMappingCommandListRecorder::Init(const std::vector<GeometryData>& geometry
     }
 
     InitCBuffersAndViews(baseColorTextures,
-                         metalnessTextures,
-                         roughnessTextures,
+                         metalnessRoughnessHeightTextures,
                          normalTextures);
 
     BRE_ASSERT(IsDataValid());
@@ -108,6 +104,7 @@ NormalMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
     // Update frame constants
     UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
     uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
+    SetCullingView(frameCBuffer);
 
     ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetCommandListWithNextCommandAllocator(sPSO);
 
@@ -124,10 +121,10 @@ NormalMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
 
     const std::size_t descHandleIncSize{ DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
     D3D12_GPU_DESCRIPTOR_HANDLE objectCBufferView(mObjectCBufferViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE baseColorTextureRenderTargetView(mBaseColorTextureRenderTargetViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE metalnessTextureRenderTargetView(mMetalnessTextureRenderTargetViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE roughnessTextureRenderTargetView(mRoughnessTextureRenderTargetViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE normalTextureRenderTargetView(mNormalTextureRenderTargetViewsBegin);
+    // Streamed textures views are moved when their resident mip levels change
+    D3D12_GPU_DESCRIPTOR_HANDLE baseColorTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mBaseColorTextureRenderTargetViewsBegin);
+    D3D12_GPU_DESCRIPTOR_HANDLE metalnessRoughnessHeightTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mMetalnessRoughnessHeightTextureRenderTargetViewsBegin);
+    D3D12_GPU_DESCRIPTOR_HANDLE normalTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mNormalTextureRenderTargetViewsBegin);
 
     commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
@@ -150,16 +147,13 @@ NormalMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
             commandList.SetGraphicsRootDescriptorTable(3U, baseColorTextureRenderTargetView);
             baseColorTextureRenderTargetView.ptr += descHandleIncSize;
 
-            commandList.SetGraphicsRootDescriptorTable(4U, metalnessTextureRenderTargetView);
-            metalnessTextureRenderTargetView.ptr += descHandleIncSize;
+            commandList.SetGraphicsRootDescriptorTable(4U, metalnessRoughnessHeightTextureRenderTargetView);
+            metalnessRoughnessHeightTextureRenderTargetView.ptr += descHandleIncSize;
 
-            commandList.SetGraphicsRootDescriptorTable(5U, roughnessTextureRenderTargetView);
-            roughnessTextureRenderTargetView.ptr += descHandleIncSize;
-
-            commandList.SetGraphicsRootDescriptorTable(6U, normalTextureRenderTargetView);
+            commandList.SetGraphicsRootDescriptorTable(5U, normalTextureRenderTargetView);
             normalTextureRenderTargetView.ptr += descHandleIncSize;
 
-            commandList.DrawIndexedInstanced(geomData.mIndexBufferData.mElementCount, 1U, 0U, 0U, 0U);
+            RecordDrawCalls(commandList, geomData, j);
         }
     }
 
@@ -175,8 +169,7 @@ NormalMappingCommandListRecorder::IsDataValid() const noexcept
     const bool result =
         GeometryCommandListRecorder::IsDataValid() &&
         mBaseColorTextureRenderTargetViewsBegin.ptr != 0UL &&
-        mMetalnessTextureRenderTargetViewsBegin.ptr != 0UL &&
-        mRoughnessTextureRenderTargetViewsBegin.ptr != 0UL &&
+        mMetalnessRoughnessHeightTextureRenderTargetViewsBegin.ptr != 0UL &&
         mNormalTextureRenderTargetViewsBegin.ptr != 0UL;
 
     return result;
@@ -184,21 +177,19 @@ NormalMappingCommandListRecorder::IsDataValid() const noexcept
 
 void
 NormalMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12Resource*>& baseColorTextures,
-                                                       const std::vector<ID3D12Resource*>& metalnessTextures,
-                                                       const std::vector<ID3D12Resource*>& roughnessTextures,
+                                                       const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures,
                                                        const std::vector<ID3D12Resource*>& normalTextures) noexcept
 {
     BRE_ASSERT(baseColorTextures.empty() == false);
-    BRE_ASSERT(baseColorTextures.size() == metalnessTextures.size());
-    BRE_ASSERT(metalnessTextures.size() == roughnessTextures.size());
-    BRE_ASSERT(roughnessTextures.size() == normalTextures.size());
+    BRE_ASSERT(baseColorTextures.size() == metalnessRoughnessHeightTextures.size());
+    BRE_ASSERT(metalnessRoughnessHeightTextures.size() == normalTextures.size());
     BRE_ASSERT(mObjectUploadCBuffers == nullptr);
 
     const std::uint32_t numResources = static_cast<std::uint32_t>(baseColorTextures.size());
 
     // Create object cbuffer and fill it
     const std::size_t objCBufferElemSize{ UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(ObjectCBuffer)) };
-    mObjectUploadCBuffers = &UploadBufferManager::CreateUploadBuffer(objCBufferElemSize, numResources);
+    mObjectUploadCBuffers = UploadBufferManager::CreateSharedUploadBuffer(objCBufferElemSize, numResources);
     std::uint32_t k = 0U;
     const std::size_t geometryDataCount{ mGeometryDataVec.size() };
     ObjectCBuffer objCBuffer;
@@ -232,15 +223,10 @@ NormalMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12R
     std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> textureSrvDescVec;
     textureSrvDescVec.reserve(numResources);
 
-    std::vector<ID3D12Resource*> metalnessResVec;
-    metalnessResVec.reserve(numResources);
-    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> metalnessSrvDescVec;
-    metalnessSrvDescVec.reserve(numResources);
-
-    std::vector<ID3D12Resource*> roughnessResVec;
-    roughnessResVec.reserve(numResources);
-    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> roughnessSrvDescVec;
-    roughnessSrvDescVec.reserve(numResources);
+    std::vector<ID3D12Resource*> metalnessRoughnessHeightResVec;
+    metalnessRoughnessHeightResVec.reserve(numResources);
+    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> metalnessRoughnessHeightSrvDescVec;
+    metalnessRoughnessHeightSrvDescVec.reserve(numResources);
 
     std::vector<ID3D12Resource*> normalResVec;
     normalResVec.reserve(numResources);
@@ -265,29 +251,17 @@ NormalMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12R
         srvDesc.Texture2D.MipLevels = textureResVec.back()->GetDesc().MipLevels;
         textureSrvDescVec.push_back(srvDesc);
 
-        // Metalness descriptor
-        metalnessResVec.push_back(metalnessTextures[i]);
-
-        srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
-        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Texture2D.MostDetailedMip = 0;
-        srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-        srvDesc.Format = metalnessResVec.back()->GetDesc().Format;
-        srvDesc.Texture2D.MipLevels = metalnessResVec.back()->GetDesc().MipLevels;
-        metalnessSrvDescVec.push_back(srvDesc);
-
-        // Roughness descriptor
-        roughnessResVec.push_back(roughnessTextures[i]);
+        // Metalness, roughness and height descriptor
+        metalnessRoughnessHeightResVec.push_back(metalnessRoughnessHeightTextures[i]);
 
         srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
         srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
         srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
         srvDesc.Texture2D.MostDetailedMip = 0;
         srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-        srvDesc.Format = roughnessResVec.back()->GetDesc().Format;
-        srvDesc.Texture2D.MipLevels = roughnessResVec.back()->GetDesc().MipLevels;
-        roughnessSrvDescVec.push_back(srvDesc);
+        srvDesc.Format = metalnessRoughnessHeightResVec.back()->GetDesc().Format;
+        srvDesc.Texture2D.MipLevels = metalnessRoughnessHeightResVec.back()->GetDesc().MipLevels;
+        metalnessRoughnessHeightSrvDescVec.push_back(srvDesc);
 
         // Normal descriptor
         normalResVec.push_back(normalTextures[i]);
@@ -303,27 +277,22 @@ NormalMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12R
     }
 
     mObjectCBufferViewsBegin =
-        CbvSrvUavDescriptorManager::CreateConstantBufferViews(objectCbufferViewDescVec.data(),
-                                                              static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
+        CreateConstantBufferViews(objectCbufferViewDescVec.data(),
+                                  static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
 
     mBaseColorTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(textureResVec.data(),
-                                                              textureSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(textureSrvDescVec.size()));
-
-    mMetalnessTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(metalnessResVec.data(),
-                                                              metalnessSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(metalnessSrvDescVec.size()));
+        CreateShaderResourceViews(textureResVec.data(),
+                                  textureSrvDescVec.data(),
+                                  static_cast<std::uint32_t>(textureSrvDescVec.size()));
 
-    mRoughnessTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(roughnessResVec.data(),
-                                                              roughnessSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(roughnessSrvDescVec.size()));
+    mMetalnessRoughnessHeightTextureRenderTargetViewsBegin =
+        CreateShaderResourceViews(metalnessRoughnessHeightResVec.data(),
+                                  metalnessRoughnessHeightSrvDescVec.data(),
+                                  static_cast<std::uint32_t>(metalnessRoughnessHeightSrvDescVec.size()));
 
     mNormalTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(normalResVec.data(),
-                                                              normalSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(normalSrvDescVec.size()));
+        CreateShaderResourceViews(normalResVec.data(),
+                                  normalSrvDescVec.data(),
+                                  static_cast<std::uint32_t>(normalSrvDescVec.size()));
 }
 }
\ No newline at end of file
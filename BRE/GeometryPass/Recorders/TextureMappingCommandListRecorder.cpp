@@ -19,8 +19,7 @@ namespace BRE {
 // "CBV(b0, visibility = SHADER_VISIBILITY_VERTEX), " \ 1 -> Frame CBuffer
 // "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \ 2 -> Frame CBuffer
 // "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_PIXEL), " \ 3 -> Base Color Texture
-// "DescriptorTable(SRV(t1), visibility = SHADER_VISIBILITY_PIXEL), " \ 4 -> Metalness Texture
-// "DescriptorTable(SRV(t2), visibility = SHADER_VISIBILITY_PIXEL), " \ 5 -> Roughness Texture
+// "DescriptorTable(SRV(t1), visibility = SHADER_VISIBILITY_PIXEL), " \ 4 -> Metalness Roughness Height Texture
 
 namespace {
 ID3D12PipelineState* sPSO{ nullptr };
@@ -38,7 +37,7 @@ TextureMappingCommandListRecorder::InitSharedPSOAndRootSignature(const DXGI_FORM
 
     // Build pso and root signature
     PSOManager::PSOCreationData psoData{};
-    psoData.mInputLayoutDescriptors = D3DFactory::GetPositionNormalTangentTexCoordInputLayout();
+    psoData.mInputLayoutDescriptors = D3DFactory::GetCompressedPositionNormalTangentTexCoordInputLayout();
 
     psoData.mPixelShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/TextureMapping/PS.cso");
     psoData.mVertexShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/TextureMapping/VS.cso");
@@ -58,13 +57,11 @@ TextureMappingCommandListRecorder::InitSharedPSOAndRootSignature(const DXGI_FORM
 void
 TextureMappingCommandListRecorder::Init(const std::vector<GeometryData>& geometryDataVector,
                                         const std::vector<ID3D12Resource*>& baseColorTextures,
-                                        const std::vector<ID3D12Resource*>& metalnessTextures,
-                                        const std::vector<ID3D12Resource*>& roughnessTextures) noexcept
+                                        const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures) noexcept
 {
     BRE_ASSERT(geometryDataVector.empty() == false);
     BRE_ASSERT(baseColorTextures.empty() == false);
-    BRE_ASSERT(baseColorTextures.size() == metalnessTextures.size());
-    BRE_ASSERT(metalnessTextures.size() == roughnessTextures.size());
+    BRE_ASSERT(baseColorTextures.size() == metalnessRoughnessHeightTextures.size());
     BRE_ASSERT(IsDataValid() == false);
 
     const std::size_t numResources = baseColorTextures.size();
@@ -86,8 +83,7 @@ TextureMappingCommandListRecorder::Init(const std::vector<GeometryData>& geometr
     }
 
     InitCBuffersAndViews(baseColorTextures,
-                         metalnessTextures,
-                         roughnessTextures);
+                         metalnessRoughnessHeightTextures);
 
     BRE_ASSERT(IsDataValid());
 }
@@ -105,6 +101,7 @@ TextureMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
     // Update frame constants
     UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
     uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
+    SetCullingView(frameCBuffer);
 
     ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetCommandListWithNextCommandAllocator(sPSO);
 
@@ -121,9 +118,9 @@ TextureMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
 
     const std::size_t descHandleIncSize{ DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
     D3D12_GPU_DESCRIPTOR_HANDLE objectCBufferView(mObjectCBufferViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE baseColorTextureRenderTargetView(mBaseColorTextureRenderTargetViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE metalnessTextureRenderTargetView(mMetalnessTextureRenderTargetViewsBegin);
-    D3D12_GPU_DESCRIPTOR_HANDLE roughnessTextureRenderTargetView(mRoughnessTextureRenderTargetViewsBegin);
+    // Streamed textures views are moved when their resident mip levels change
+    D3D12_GPU_DESCRIPTOR_HANDLE baseColorTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mBaseColorTextureRenderTargetViewsBegin);
+    D3D12_GPU_DESCRIPTOR_HANDLE metalnessRoughnessHeightTextureRenderTargetView = CbvSrvUavDescriptorManager::GetCurrentDescriptors(mMetalnessRoughnessHeightTextureRenderTargetViewsBegin);
 
     commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
@@ -146,13 +143,10 @@ TextureMappingCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
             commandList.SetGraphicsRootDescriptorTable(3U, baseColorTextureRenderTargetView);
             baseColorTextureRenderTargetView.ptr += descHandleIncSize;
 
-            commandList.SetGraphicsRootDescriptorTable(4U, metalnessTextureRenderTargetView);
-            metalnessTextureRenderTargetView.ptr += descHandleIncSize;
+            commandList.SetGraphicsRootDescriptorTable(4U, metalnessRoughnessHeightTextureRenderTargetView);
+            metalnessRoughnessHeightTextureRenderTargetView.ptr += descHandleIncSize;
 
-            commandList.SetGraphicsRootDescriptorTable(5U, roughnessTextureRenderTargetView);
-            roughnessTextureRenderTargetView.ptr += descHandleIncSize;
-
-            commandList.DrawIndexedInstanced(geomData.mIndexBufferData.mElementCount, 1U, 0U, 0U, 0U);
+            RecordDrawCalls(commandList, geomData, j);
         }
     }
 
@@ -176,27 +170,24 @@ TextureMappingCommandListRecorder::IsDataValid() const noexcept
     const bool result =
         GeometryCommandListRecorder::IsDataValid() &&
         mBaseColorTextureRenderTargetViewsBegin.ptr != 0UL &&
-        mMetalnessTextureRenderTargetViewsBegin.ptr != 0UL &&
-        mRoughnessTextureRenderTargetViewsBegin.ptr != 0UL;
+        mMetalnessRoughnessHeightTextureRenderTargetViewsBegin.ptr != 0UL;
 
     return result;
 }
 
 void
 TextureMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12Resource*>& baseColorTextures,
-                                                        const std::vector<ID3D12Resource*>& metalnessTextures,
-                                                        const std::vector<ID3D12Resource*>& roughnessTextures) noexcept
+                                                        const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures) noexcept
 {
     BRE_ASSERT(baseColorTextures.empty() == false);
-    BRE_ASSERT(baseColorTextures.size() == metalnessTextures.size());
-    BRE_ASSERT(metalnessTextures.size() == roughnessTextures.size());
+    BRE_ASSERT(baseColorTextures.size() == metalnessRoughnessHeightTextures.size());
     BRE_ASSERT(mObjectUploadCBuffers == nullptr);
 
     const std::uint32_t numResources = static_cast<std::uint32_t>(baseColorTextures.size());
 
     // Create object cbuffer and fill it
     const std::size_t objCBufferElemSize{ UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(ObjectCBuffer)) };
-    mObjectUploadCBuffers = &UploadBufferManager::CreateUploadBuffer(objCBufferElemSize, numResources);
+    mObjectUploadCBuffers = UploadBufferManager::CreateSharedUploadBuffer(objCBufferElemSize, numResources);
     std::uint32_t k = 0U;
     const std::size_t geometryDataCount{ mGeometryDataVec.size() };
     ObjectCBuffer objCBuffer;
@@ -229,15 +220,10 @@ TextureMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12
     std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> srvDescVec;
     srvDescVec.reserve(numResources);
 
-    std::vector<ID3D12Resource*> metalnessResVec;
-    metalnessResVec.reserve(numResources);
-    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> metalnessSrvDescVec;
-    metalnessSrvDescVec.reserve(numResources);
-
-    std::vector<ID3D12Resource*> roughnessResVec;
-    roughnessResVec.reserve(numResources);
-    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> roughnessSrvDescVec;
-    roughnessSrvDescVec.reserve(numResources);
+    std::vector<ID3D12Resource*> metalnessRoughnessHeightResVec;
+    metalnessRoughnessHeightResVec.reserve(numResources);
+    std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> metalnessRoughnessHeightSrvDescVec;
+    metalnessRoughnessHeightSrvDescVec.reserve(numResources);
     for (std::size_t i = 0UL; i < numResources; ++i) {
         // Object cbuffer desc
         D3D12_CONSTANT_BUFFER_VIEW_DESC cBufferDesc{};
@@ -257,49 +243,32 @@ TextureMappingCommandListRecorder::InitCBuffersAndViews(const std::vector<ID3D12
         srvDesc.Texture2D.MipLevels = resVec.back()->GetDesc().MipLevels;
         srvDescVec.push_back(srvDesc);
 
-        // Metalness descriptor
-        metalnessResVec.push_back(metalnessTextures[i]);
-
-        srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
-        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Texture2D.MostDetailedMip = 0;
-        srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-        srvDesc.Format = metalnessResVec.back()->GetDesc().Format;
-        srvDesc.Texture2D.MipLevels = metalnessResVec.back()->GetDesc().MipLevels;
-        metalnessSrvDescVec.push_back(srvDesc);
-
-        // Roughness descriptor
-        roughnessResVec.push_back(roughnessTextures[i]);
+        // Metalness, roughness and height descriptor
+        metalnessRoughnessHeightResVec.push_back(metalnessRoughnessHeightTextures[i]);
 
         srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
         srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
         srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
         srvDesc.Texture2D.MostDetailedMip = 0;
         srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-        srvDesc.Format = roughnessResVec.back()->GetDesc().Format;
-        srvDesc.Texture2D.MipLevels = roughnessResVec.back()->GetDesc().MipLevels;
-        roughnessSrvDescVec.push_back(srvDesc);
+        srvDesc.Format = metalnessRoughnessHeightResVec.back()->GetDesc().Format;
+        srvDesc.Texture2D.MipLevels = metalnessRoughnessHeightResVec.back()->GetDesc().MipLevels;
+        metalnessRoughnessHeightSrvDescVec.push_back(srvDesc);
     }
 
     mObjectCBufferViewsBegin =
-        CbvSrvUavDescriptorManager::CreateConstantBufferViews(objectCbufferViewDescVec.data(),
-                                                              static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
+        CreateConstantBufferViews(objectCbufferViewDescVec.data(),
+                                  static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
 
     mBaseColorTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(resVec.data(),
-                                                              srvDescVec.data(),
-                                                              static_cast<std::uint32_t>(srvDescVec.size()));
-
-    mMetalnessTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(metalnessResVec.data(),
-                                                              metalnessSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(metalnessSrvDescVec.size()));
-
-    mRoughnessTextureRenderTargetViewsBegin =
-        CbvSrvUavDescriptorManager::CreateShaderResourceViews(roughnessResVec.data(),
-                                                              roughnessSrvDescVec.data(),
-                                                              static_cast<std::uint32_t>(roughnessSrvDescVec.size()));
+        CreateShaderResourceViews(resVec.data(),
+                                  srvDescVec.data(),
+                                  static_cast<std::uint32_t>(srvDescVec.size()));
+
+    mMetalnessRoughnessHeightTextureRenderTargetViewsBegin =
+        CreateShaderResourceViews(metalnessRoughnessHeightResVec.data(),
+                                  metalnessRoughnessHeightSrvDescVec.data(),
+                                  static_cast<std::uint32_t>(metalnessRoughnessHeightSrvDescVec.size()));
 
 }
 }
\ No newline at end of file
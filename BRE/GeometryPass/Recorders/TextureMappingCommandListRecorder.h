@@ -30,13 +30,11 @@ public:
     ///
     /// @param geometryDataVector List of geometry data. Must not be empty
     /// @param baseColorTextures List of base color textures. Must not be empty.
-    /// @param metalnessTextures List of metalness textures. Must not be empty.
-    /// @param roughnessTextures List of rougness textures. Must not be empty.
+    /// @param metalnessRoughnessHeightTextures List of metalness, roughness and height textures. Must not be empty.
     ///
     void Init(const std::vector<GeometryData>& geometryDataVector,
               const std::vector<ID3D12Resource*>& baseColorTextures,
-              const std::vector<ID3D12Resource*>& metalnessTextures,
-              const std::vector<ID3D12Resource*>& roughnessTextures) noexcept;
+              const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures) noexcept;
 
     ///
     /// @brief Records and push command lists to CommandListExecutor
@@ -58,20 +56,15 @@ private:
     ///
     /// @brief Initializes the constant buffers and views
     /// @param baseColorTextures List of base color textures. Must not be empty.
-    /// @param metalnessTextures List of metalness textures. Must not be empty.
-    /// @param roughnessTextures List of rougness textures. Must not be empty.
+    /// @param metalnessRoughnessHeightTextures List of metalness, roughness and height textures. Must not be empty.
     ///
     void InitCBuffersAndViews(const std::vector<ID3D12Resource*>& baseColorTextures,
-                              const std::vector<ID3D12Resource*>& metalnessTextures,
-                              const std::vector<ID3D12Resource*>& roughnessTextures) noexcept;
+                              const std::vector<ID3D12Resource*>& metalnessRoughnessHeightTextures) noexcept;
 
     // First descriptor in the list. All the others are contiguous
     D3D12_GPU_DESCRIPTOR_HANDLE mBaseColorTextureRenderTargetViewsBegin{ 0U };
 
     // First descriptor in the list. All the others are contiguous
-    D3D12_GPU_DESCRIPTOR_HANDLE mMetalnessTextureRenderTargetViewsBegin{ 0U };
-
-    // First descriptor in the list. All the others are contiguous
-    D3D12_GPU_DESCRIPTOR_HANDLE mRoughnessTextureRenderTargetViewsBegin{ 0U };
+    D3D12_GPU_DESCRIPTOR_HANDLE mMetalnessRoughnessHeightTextureRenderTargetViewsBegin{ 0U };
 };
 }
\ No newline at end of file
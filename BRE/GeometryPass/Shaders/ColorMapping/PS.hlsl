@@ -0,0 +1,32 @@
+#include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
+
+#include "RS.hlsl"
+
+struct Input {
+    float4 mPositionClipSpace : SV_POSITION;
+    float3 mNormalViewSpace : NORMAL_VIEW;
+};
+
+ConstantBuffer<ObjectCBuffer> gObjCBuffer : register(b0);
+
+struct Output {
+    float4 mNormal_Roughness : SV_Target0;
+    float4 mBaseColor_Metalness : SV_Target1;
+};
+
+[RootSignature(RS)]
+Output main(const in Input input)
+{
+    Output output = (Output)0;
+
+    // Normal (encoded in view space)
+    const float3 normalViewSpace = normalize(input.mNormalViewSpace);
+    output.mNormal_Roughness.xy = Encode(normalViewSpace);
+
+    // Base color, metalness and roughness are constants, so nothing is sampled.
+    output.mBaseColor_Metalness = gObjCBuffer.mBaseColor_Metalness;
+    output.mNormal_Roughness.z = gObjCBuffer.mRoughness;
+
+    return output;
+}
\ No newline at end of file
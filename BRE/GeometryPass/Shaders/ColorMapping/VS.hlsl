@@ -0,0 +1,39 @@
+#include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
+
+#include "RS.hlsl"
+
+struct Input {
+    float3 mPositionObjectSpace : POSITION;
+    float2 mEncodedNormalObjectSpace : NORMAL;
+    float2 mEncodedTangentObjectSpace : TANGENT;
+    float2 mUV : TEXCOORD;
+};
+
+ConstantBuffer<ObjectCBuffer> gObjCBuffer : register(b0);
+ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
+
+struct Output {
+    float4 mPositionClipSpace : SV_POSITION;
+    float3 mNormalViewSpace : NORMAL_VIEW;
+};
+
+[RootSignature(RS)]
+Output main(in const Input input)
+{
+    Output output;
+    const float3 positionWorldSpace = mul(float4(input.mPositionObjectSpace, 1.0f),
+                                          gObjCBuffer.mWorldMatrix).xyz;
+    const float3 positionViewSpace = mul(float4(positionWorldSpace, 1.0f),
+                                         gFrameCBuffer.mViewMatrix).xyz;
+
+    const float3 normalWorldSpace = mul(float4(DecodeSignedOctahedron(input.mEncodedNormalObjectSpace), 0.0f),
+                                        gObjCBuffer.mInverseTransposeWorldMatrix).xyz;
+    output.mNormalViewSpace = mul(float4(normalWorldSpace, 0.0f),
+                                  gFrameCBuffer.mViewMatrix).xyz;
+
+    output.mPositionClipSpace = mul(float4(positionViewSpace, 1.0f),
+                                    gFrameCBuffer.mProjectionMatrix);
+
+    return output;
+}
\ No newline at end of file
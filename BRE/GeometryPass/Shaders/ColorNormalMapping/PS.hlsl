@@ -0,0 +1,49 @@
+#include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
+
+#include "RS.hlsl"
+
+struct Input {
+    float4 mPositionClipSpace : SV_POSITION;
+    float3 mPositionWorldSpace : POS_WORLD;
+    float3 mPositionViewSpace : POS_VIEW;
+    float3 mNormalWorldSpace : NORMAL_WORLD;
+    float3 mNormalViewSpace : NORMAL_VIEW;
+    float3 mTangentWorldSpace : TANGENT_WORLD;
+    float3 mTangentViewSpace : TANGENT_VIEW;
+    float3 mBinormalWorldSpace : BINORMAL_WORLD;
+    float3 mBinormalViewSpace : BINORMAL_VIEW;
+    float2 mUV : TEXCOORD;
+};
+
+ConstantBuffer<ObjectCBuffer> gObjCBuffer : register(b0);
+
+SamplerState TextureSampler : register (s0);
+Texture2D NormalTexture : register (t0);
+
+struct Output {
+    float4 mNormal_Roughness : SV_Target0;
+    float4 mBaseColor_Metalness : SV_Target1;
+};
+
+[RootSignature(RS)]
+Output main(const in Input input)
+{
+    Output output = (Output)0;
+
+    // Normal (encoded in view space)
+    const float3 normalObjectSpace = normalize(SampleNormalTexture(NormalTexture,
+                                                                   TextureSampler,
+                                                                   input.mUV));
+    const float3x3 tbnViewSpace = float3x3(normalize(input.mTangentViewSpace),
+                                           normalize(input.mBinormalViewSpace),
+                                           normalize(input.mNormalViewSpace));
+    output.mNormal_Roughness.xy = Encode(normalize(mul(normalObjectSpace,
+                                                       tbnViewSpace)));
+
+    // Base color, metalness and roughness are constants
+    output.mBaseColor_Metalness = gObjCBuffer.mBaseColor_Metalness;
+    output.mNormal_Roughness.z = gObjCBuffer.mRoughness;
+
+    return output;
+}
\ No newline at end of file
@@ -1,12 +1,13 @@
 #include <GeometryPass/Shaders/HeightMappingCBuffer.hlsli>
 #include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
 
 #include "RS.hlsl"
 
 struct Input {
     float3 mPositionObjectSpace : POSITION;
-    float3 mNormalObjectSpace : NORMAL;
-    float3 mTangentObjectSpace : TANGENT;
+    float2 mEncodedNormalObjectSpace : NORMAL;
+    float2 mEncodedTangentObjectSpace : TANGENT;
     float2 mUV : TEXCOORD;
 };
 
@@ -30,10 +31,10 @@ Output main(in const Input input)
     output.mPositionWorldSpace = mul(float4(input.mPositionObjectSpace, 1.0f),
                                      gObjCBuffer.mWorldMatrix).xyz;
 
-    output.mNormalWorldSpace = mul(float4(input.mNormalObjectSpace, 0.0f),
+    output.mNormalWorldSpace = mul(float4(DecodeSignedOctahedron(input.mEncodedNormalObjectSpace), 0.0f),
                                    gObjCBuffer.mInverseTransposeWorldMatrix).xyz;
 
-    output.mTangentWorldSpace = mul(float4(input.mTangentObjectSpace, 0.0f),
+    output.mTangentWorldSpace = mul(float4(DecodeSignedOctahedron(input.mEncodedTangentObjectSpace), 0.0f),
                                     gObjCBuffer.mWorldMatrix).xyz;
 
     output.mUV = gObjCBuffer.mTextureScale * input.mUV;
@@ -20,9 +20,8 @@ ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b0);
 
 SamplerState TextureSampler : register (s0);
 Texture2D BaseColorTexture : register (t0);
-Texture2D MetalnessTexture : register (t1);
-Texture2D RoughnessTexture : register (t2);
-Texture2D NormalTexture : register (t3);
+Texture2D MetalnessRoughnessHeightTexture : register (t1);
+Texture2D NormalTexture : register (t2);
 
 struct Output {
     float4 mNormal_Roughness : SV_Target0;
@@ -35,8 +34,9 @@ Output main(const in Input input)
     Output output = (Output)0;
 
     // Normal (encoded in view space)
-    const float3 normalObjectSpace = normalize(NormalTexture.Sample(TextureSampler,
-                                                                    input.mUV).xyz * 2.0f - 1.0f);
+    const float3 normalObjectSpace = normalize(SampleNormalTexture(NormalTexture,
+                                                                   TextureSampler,
+                                                                   input.mUV));
     const float3x3 tbnWorldSpace = float3x3(normalize(input.mTangentWorldSpace),
                                             normalize(input.mBinormalWorldSpace),
                                             normalize(input.mNormalWorldSpace));
@@ -50,14 +50,14 @@ Output main(const in Input input)
     // Base color and metalness
     const float3 baseColor = BaseColorTexture.Sample(TextureSampler,
                                                      input.mUV).rgb;
-    const float metalness = MetalnessTexture.Sample(TextureSampler,
-                                                    input.mUV).r;
+    // Metalness is in red channel and roughness in green channel
+    const float2 metalnessRoughness = MetalnessRoughnessHeightTexture.Sample(TextureSampler,
+                                                                             input.mUV).rg;
     output.mBaseColor_Metalness = float4(baseColor,
-                                         metalness);
+                                         metalnessRoughness.x);
 
     // Roughness
-    output.mNormal_Roughness.z = RoughnessTexture.Sample(TextureSampler,
-                                                         input.mUV).r;
+    output.mNormal_Roughness.z = metalnessRoughness.y;
 
     return output;
 }
\ No newline at end of file
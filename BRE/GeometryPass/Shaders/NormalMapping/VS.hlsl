@@ -1,11 +1,12 @@
 #include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
 
 #include "RS.hlsl"
 
 struct Input {
     float3 mPositionObjectSpace : POSITION;
-    float3 mNormalObjectSpace : NORMAL;
-    float3 mTangentObjectSpace : TANGENT;
+    float2 mEncodedNormalObjectSpace : NORMAL;
+    float2 mEncodedTangentObjectSpace : TANGENT;
     float2 mUV : TEXCOORD;
 };
 
@@ -38,12 +39,12 @@ Output main(in const Input input)
 
     output.mUV = gObjCBuffer.mTextureScale * input.mUV;
 
-    output.mNormalWorldSpace = mul(float4(input.mNormalObjectSpace, 0.0f),
+    output.mNormalWorldSpace = mul(float4(DecodeSignedOctahedron(input.mEncodedNormalObjectSpace), 0.0f),
                                    gObjCBuffer.mWorldMatrix).xyz;
     output.mNormalViewSpace = mul(float4(output.mNormalWorldSpace, 0.0f),
                                   gFrameCBuffer.mViewMatrix).xyz;
 
-    output.mTangentWorldSpace = mul(float4(input.mTangentObjectSpace, 0.0f),
+    output.mTangentWorldSpace = mul(float4(DecodeSignedOctahedron(input.mEncodedTangentObjectSpace), 0.0f),
                                     gObjCBuffer.mWorldMatrix).xyz;
     output.mTangentViewSpace = mul(float4(output.mTangentWorldSpace, 0.0f),
                                    gFrameCBuffer.mViewMatrix).xyz;
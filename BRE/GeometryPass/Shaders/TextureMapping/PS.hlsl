@@ -16,8 +16,7 @@ ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b0);
 
 SamplerState TextureSampler : register (s0);
 Texture2D BaseColorTexture : register (t0);
-Texture2D MetalnessTexture : register (t1);
-Texture2D RoughnessTexture : register (t2);
+Texture2D MetalnessRoughnessHeightTexture : register (t1);
 
 struct Output {
     float4 mNormal_Roughness : SV_Target0;
@@ -37,14 +36,14 @@ Output main(const in Input input)
     const float3 baseColor = BaseColorTexture.Sample(TextureSampler,
                                                      input.mUV).rgb;
 
-    const float metalness = MetalnessTexture.Sample(TextureSampler,
-                                                    input.mUV).r;
+    // Metalness is in red channel and roughness in green channel
+    const float2 metalnessRoughness = MetalnessRoughnessHeightTexture.Sample(TextureSampler,
+                                                                             input.mUV).rg;
     output.mBaseColor_Metalness = float4(baseColor,
-                                         metalness);
+                                         metalnessRoughness.x);
 
     // Roughness
-    output.mNormal_Roughness.z = RoughnessTexture.Sample(TextureSampler,
-                                                         input.mUV).r;
+    output.mNormal_Roughness.z = metalnessRoughness.y;
 
     return output;
 }
\ No newline at end of file
@@ -8,5 +8,4 @@
 "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \
 "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_PIXEL), " \
 "DescriptorTable(SRV(t1), visibility = SHADER_VISIBILITY_PIXEL), " \
-"DescriptorTable(SRV(t2), visibility = SHADER_VISIBILITY_PIXEL), " \
 "StaticSampler(s0, filter=FILTER_ANISOTROPIC)"
@@ -1,11 +1,12 @@
 #include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
 
 #include "RS.hlsl"
 
 struct Input {
     float3 mPositionObjectSpace : POSITION;
-    float3 mNormalObjectSpace : NORMAL;
-    float3 mTangentObjectSpace : TANGENT;
+    float2 mEncodedNormalObjectSpace : NORMAL;
+    float2 mEncodedTangentObjectSpace : TANGENT;
     float2 mUV : TEXCOORD;
 };
 
@@ -30,7 +31,7 @@ Output main(in const Input input)
     output.mPositionViewSpace = mul(float4(output.mPositionWorldSpace, 1.0f),
                                     gFrameCBuffer.mViewMatrix).xyz;
 
-    output.mNormalWorldSpace = mul(float4(input.mNormalObjectSpace, 0.0f),
+    output.mNormalWorldSpace = mul(float4(DecodeSignedOctahedron(input.mEncodedNormalObjectSpace), 0.0f),
                                    gObjCBuffer.mInverseTransposeWorldMatrix).xyz;
     output.mNormalViewSpace = mul(float4(output.mNormalWorldSpace, 0.0f),
                                   gFrameCBuffer.mViewMatrix).xyz;
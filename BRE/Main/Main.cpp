@@ -1,4 +1,6 @@
+#include <string>
 #include <tbb/task_scheduler_init.h>
+#include <vector>
 #include <windows.h>
 
 #pragma warning( push )
@@ -16,11 +18,16 @@
 #include <DirectXManager\DirectXManager.h>
 #include <Input/Keyboard.h>
 #include <Input/Mouse.h>
+#include <MemoryTracker\MemoryTracker.h>
 #include <PSOManager\PSOManager.h>
 #include <ResourceManager\ResourceManager.h>
+#include <ResourceManager\StagingRingBuffer.h>
+#include <ResourceManager\TextureStreamer.h>
 #include <ResourceManager\UploadBufferManager.h>
 #include <RootSignatureManager\RootSignatureManager.h>
 #include <SceneExecutor/SceneExecutor.h>
+#include <SceneLoader\CompiledScene.h>
+#include <SceneLoader\SceneCooker.h>
 #include <SceneLoader\SceneLoader.h>
 #include <SceneLoader\SettingsLoader.h>
 #include <ShaderManager\ShaderManager.h>
@@ -36,6 +43,8 @@ namespace BRE {
 namespace {
 const std::uint32_t RENDER_TARGET_DESCRIPTOR_HEAP_SIZE = 30U;
 const std::uint32_t CBV_SRV_UAV_DESCRIPTOR_HEAP_SIZE = 3000U;
+const std::size_t STAGING_RING_BUFFER_SIZE = 32UL * 1024UL * 1024UL;
+const char* MEMORY_REPORT_FILE_PATH = "memory_report.json";
 
 ///
 /// @brief Initializes all the systems
@@ -46,10 +55,14 @@ void InitSystems(const HINSTANCE moduleInstanceHandle,
 {
     BRE_ASSERT(sceneFilePath != nullptr);
 
-    // Load settings
-    const YAML::Node rootNode = YAML::LoadFile(sceneFilePath);
-    const std::wstring errorMsg = 
-        L"Failed to open yaml file: " + StringUtils::AnsiToWideString(sceneFilePath);
+    // Load settings from the compiled scene assets document, so the drawable objects
+    // of the scene file are not parsed.
+    const std::string compiledSceneFilePath = SceneCooker::CookSceneFile(sceneFilePath);
+    CompiledScene compiledScene;
+    const std::wstring errorMsg =
+        L"Failed to open compiled scene file: " + StringUtils::AnsiToWideString(compiledSceneFilePath);
+    BRE_CHECK_MSG(compiledScene.Open(compiledSceneFilePath.c_str()), errorMsg.c_str());
+    const YAML::Node rootNode = YAML::Load(compiledScene.GetAssetsDocument());
     BRE_CHECK_MSG(rootNode.IsDefined(), errorMsg.c_str());
     SettingsLoader settingsLoader;
     settingsLoader.LoadSettings(rootNode);
@@ -70,14 +83,34 @@ void InitSystems(const HINSTANCE moduleInstanceHandle,
     DepthStencilDescriptorManager::Init();
     RenderTargetDescriptorManager::Init(RENDER_TARGET_DESCRIPTOR_HEAP_SIZE);
 
+    StagingRingBuffer::Init(STAGING_RING_BUFFER_SIZE);
+    TextureStreamer::Init();
+
     //ShowCursor(false);
 }
 
 ///
 /// @brief Finalize all the systems
+/// @param sceneFilePath Scene file path. It is used to identify the memory report.
 ///
-void FinalizeSystems() noexcept
+void FinalizeSystems(const char* sceneFilePath) noexcept
 {
+    BRE_ASSERT(sceneFilePath != nullptr);
+
+    StagingRingBuffer::Clear();
+
+    // Memory report must be written before managers release their memory.
+    if (MemoryTracker::WriteJsonReport(MEMORY_REPORT_FILE_PATH, sceneFilePath) == false) {
+        BRE_LOG_MSG(L"Failed to write memory report\n");
+    }
+
+    // Models and textures whose last user was released are released now,
+    // and streamed textures are released by TextureStreamer.
+    ResourceManager::GetDeferredReleaseQueue().ReleaseAll();
+
+    // Streamed textures are not owned by ResourceManager
+    TextureStreamer::Clear();
+
     CommandAllocatorManager::Clear();
     CommandListManager::Clear();
     CommandQueueManager::Clear();
@@ -97,7 +130,15 @@ WINAPI WinMain(_In_ HINSTANCE moduleInstanceHandle,
                _In_ LPSTR /*commandLine*/,
                _In_ int /*showCommand*/)
 {
-    const char* sceneFilePath = "resources/scenes/height_mapping.yml";
+    // The first scene is loaded, and Tab key switches to the next one.
+    // Settings are loaded from the first scene.
+    const std::vector<std::string> sceneFilePaths{
+        "resources/scenes/height_mapping.yml",
+        "resources/scenes/brick.yml",
+        "resources/scenes/wood.yml",
+        "resources/scenes/metal.yml",
+    };
+    const char* sceneFilePath = sceneFilePaths[0].c_str();
 
     tbb::task_scheduler_init taskSchedulerInit;
 
@@ -105,12 +146,12 @@ WINAPI WinMain(_In_ HINSTANCE moduleInstanceHandle,
                      sceneFilePath);
 
     {
-        BRE::SceneExecutor sceneExecutor(sceneFilePath);
+        BRE::SceneExecutor sceneExecutor(sceneFilePaths);
         sceneExecutor.Execute();
     }
 
     taskSchedulerInit.terminate();
-    BRE::FinalizeSystems();
+    BRE::FinalizeSystems(sceneFilePath);
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "MemoryTracker.h"
+
+#include <fstream>
+#include <sstream>
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+MemoryTracker::CategoryCounters MemoryTracker::mCategoryCounters[static_cast<std::uint32_t>(Category::NUM_CATEGORIES)];
+std::atomic<std::uint64_t> MemoryTracker::mTotalSizeInBytes{ 0UL };
+std::atomic<std::uint64_t> MemoryTracker::mTotalPeakSizeInBytes{ 0UL };
+
+namespace {
+const char* sCategoryNames[]{
+    "render targets",
+    "textures",
+    "vertex and index buffers",
+    "upload heaps",
+    "descriptor heaps",
+    "shader blobs",
+};
+static_assert(sizeof(sCategoryNames) / sizeof(sCategoryNames[0]) ==
+              static_cast<std::size_t>(MemoryTracker::Category::NUM_CATEGORIES),
+              "Category names do not match the categories");
+
+///
+/// @brief Updates a high-water mark
+/// @param peak High-water mark to update
+/// @param value New value
+///
+void
+UpdatePeak(std::atomic<std::uint64_t>& peak,
+           const std::uint64_t value) noexcept
+{
+    std::uint64_t currentPeak = peak.load();
+    while (currentPeak < value && peak.compare_exchange_weak(currentPeak, value) == false) {
+    }
+}
+
+///
+/// @brief Get category index
+/// @param category Category. It must not be NUM_CATEGORIES.
+/// @return Index
+///
+std::uint32_t
+GetCategoryIndex(const MemoryTracker::Category category) noexcept
+{
+    BRE_ASSERT(category < MemoryTracker::Category::NUM_CATEGORIES);
+    return static_cast<std::uint32_t>(category);
+}
+}
+
+void
+MemoryTracker::Reset() noexcept
+{
+    for (CategoryCounters& counters : mCategoryCounters) {
+        counters.mCurrentSizeInBytes = 0UL;
+        counters.mPeakSizeInBytes = 0UL;
+        counters.mBudgetInBytes = 0UL;
+        counters.mAllocationCount = 0U;
+        counters.mBudgetExceededCount = 0U;
+    }
+
+    mTotalSizeInBytes = 0UL;
+    mTotalPeakSizeInBytes = 0UL;
+}
+
+void
+MemoryTracker::RegisterAllocation(const Category category,
+                                  const std::uint64_t sizeInBytes) noexcept
+{
+    CategoryCounters& counters = mCategoryCounters[GetCategoryIndex(category)];
+
+    const std::uint64_t previousSize = counters.mCurrentSizeInBytes.fetch_add(sizeInBytes);
+    const std::uint64_t newSize = previousSize + sizeInBytes;
+    ++counters.mAllocationCount;
+    UpdatePeak(counters.mPeakSizeInBytes, newSize);
+    UpdatePeak(mTotalPeakSizeInBytes, mTotalSizeInBytes.fetch_add(sizeInBytes) + sizeInBytes);
+
+    // Warn only when the budget is crossed, not on every allocation over it.
+    const std::uint64_t budget = counters.mBudgetInBytes;
+    if (budget != 0UL && previousSize <= budget && newSize > budget) {
+        ++counters.mBudgetExceededCount;
+        const std::wstring warningMsg =
+            L"Memory budget exceeded for " + StringUtils::AnsiToWideString(GetCategoryName(category)) +
+            L": " + std::to_wstring(newSize) + L" of " + std::to_wstring(budget) + L" bytes\n";
+        BRE_LOG_MSG(warningMsg.c_str());
+    }
+}
+
+void
+MemoryTracker::RegisterDeallocation(const Category category,
+                                    const std::uint64_t sizeInBytes) noexcept
+{
+    CategoryCounters& counters = mCategoryCounters[GetCategoryIndex(category)];
+
+    BRE_ASSERT(counters.mCurrentSizeInBytes >= sizeInBytes);
+    BRE_ASSERT(counters.mAllocationCount > 0U);
+    counters.mCurrentSizeInBytes -= sizeInBytes;
+    --counters.mAllocationCount;
+    mTotalSizeInBytes -= sizeInBytes;
+}
+
+void
+MemoryTracker::SetBudget(const Category category,
+                         const std::uint64_t budgetInBytes) noexcept
+{
+    mCategoryCounters[GetCategoryIndex(category)].mBudgetInBytes = budgetInBytes;
+}
+
+MemoryTracker::CategoryStats
+MemoryTracker::GetCategoryStats(const Category category) noexcept
+{
+    const CategoryCounters& counters = mCategoryCounters[GetCategoryIndex(category)];
+
+    CategoryStats stats;
+    stats.mCurrentSizeInBytes = counters.mCurrentSizeInBytes;
+    stats.mPeakSizeInBytes = counters.mPeakSizeInBytes;
+    stats.mBudgetInBytes = counters.mBudgetInBytes;
+    stats.mAllocationCount = counters.mAllocationCount;
+    stats.mBudgetExceededCount = counters.mBudgetExceededCount;
+
+    return stats;
+}
+
+bool
+MemoryTracker::IsOverBudget(const Category category) noexcept
+{
+    const CategoryCounters& counters = mCategoryCounters[GetCategoryIndex(category)];
+    const std::uint64_t budget = counters.mBudgetInBytes;
+
+    return budget != 0UL && counters.mCurrentSizeInBytes > budget;
+}
+
+std::uint64_t
+MemoryTracker::GetTotalSizeInBytes() noexcept
+{
+    return mTotalSizeInBytes;
+}
+
+std::uint64_t
+MemoryTracker::GetTotalPeakSizeInBytes() noexcept
+{
+    return mTotalPeakSizeInBytes;
+}
+
+const char*
+MemoryTracker::GetCategoryName(const Category category) noexcept
+{
+    return sCategoryNames[GetCategoryIndex(category)];
+}
+
+bool
+MemoryTracker::GetCategoryByName(const std::string& categoryName,
+                                 Category& category) noexcept
+{
+    for (std::uint32_t i = 0U; i < static_cast<std::uint32_t>(Category::NUM_CATEGORIES); ++i) {
+        if (categoryName == sCategoryNames[i]) {
+            category = static_cast<Category>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::string
+MemoryTracker::GetJsonReport(const char* reportName) noexcept
+{
+    BRE_ASSERT(reportName != nullptr);
+
+    // Report name is a file path, so backslashes must be escaped.
+    std::string escapedReportName;
+    for (const char* character = reportName; *character != '\0'; ++character) {
+        if (*character == '\\' || *character == '"') {
+            escapedReportName += '\\';
+        }
+        escapedReportName += *character;
+    }
+
+    std::ostringstream stream;
+    stream << "{\n";
+    stream << "  \"name\": \"" << escapedReportName << "\",\n";
+    stream << "  \"total_bytes\": " << GetTotalSizeInBytes() << ",\n";
+    stream << "  \"total_peak_bytes\": " << GetTotalPeakSizeInBytes() << ",\n";
+    stream << "  \"categories\": [\n";
+    for (std::uint32_t i = 0U; i < static_cast<std::uint32_t>(Category::NUM_CATEGORIES); ++i) {
+        const Category category = static_cast<Category>(i);
+        const CategoryStats stats = GetCategoryStats(category);
+        stream << "    {\n";
+        stream << "      \"name\": \"" << GetCategoryName(category) << "\",\n";
+        stream << "      \"bytes\": " << stats.mCurrentSizeInBytes << ",\n";
+        stream << "      \"peak_bytes\": " << stats.mPeakSizeInBytes << ",\n";
+        stream << "      \"budget_bytes\": " << stats.mBudgetInBytes << ",\n";
+        stream << "      \"allocations\": " << stats.mAllocationCount << ",\n";
+        stream << "      \"budget_exceeded\": " << stats.mBudgetExceededCount << "\n";
+        stream << "    }" << (i + 1U < static_cast<std::uint32_t>(Category::NUM_CATEGORIES) ? "," : "") << "\n";
+    }
+    stream << "  ]\n";
+    stream << "}\n";
+
+    return stream.str();
+}
+
+bool
+MemoryTracker::WriteJsonReport(const char* filePath,
+                               const char* reportName) noexcept
+{
+    BRE_ASSERT(filePath != nullptr);
+
+    std::ofstream fileStream{ filePath, std::ios::out | std::ios::trunc };
+    if (fileStream.is_open() == false) {
+        return false;
+    }
+
+    fileStream << GetJsonReport(reportName);
+
+    return fileStream.good();
+}
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace BRE {
+///
+/// @brief Responsible to account memory per category.
+///
+/// Managers register their allocations and deallocations. For each category
+/// it keeps the current size, the high-water mark, the number of live allocations
+/// and an optional budget. A warning is logged every time a category goes over its budget.
+///
+class MemoryTracker {
+public:
+    ///
+    /// @brief Memory categories
+    ///
+    enum class Category : std::uint32_t {
+        RENDER_TARGETS = 0U, // Render targets, depth stencil and unordered access textures
+        TEXTURES,
+        VERTEX_AND_INDEX_BUFFERS,
+        UPLOAD_HEAPS,
+        DESCRIPTOR_HEAPS,
+        SHADER_BLOBS,
+        NUM_CATEGORIES
+    };
+
+    ///
+    /// @brief Snapshot of a category counters
+    ///
+    struct CategoryStats {
+        std::uint64_t mCurrentSizeInBytes{ 0UL };
+        std::uint64_t mPeakSizeInBytes{ 0UL };
+        // Zero means there is no budget
+        std::uint64_t mBudgetInBytes{ 0UL };
+        std::uint32_t mAllocationCount{ 0U };
+        std::uint32_t mBudgetExceededCount{ 0U };
+    };
+
+    MemoryTracker() = delete;
+    ~MemoryTracker() = delete;
+    MemoryTracker(const MemoryTracker&) = delete;
+    const MemoryTracker& operator=(const MemoryTracker&) = delete;
+    MemoryTracker(MemoryTracker&&) = delete;
+    MemoryTracker& operator=(MemoryTracker&&) = delete;
+
+    ///
+    /// @brief Resets all the counters and budgets
+    ///
+    static void Reset() noexcept;
+
+    ///
+    /// @brief Registers an allocation
+    /// @param category Allocation category. It must not be NUM_CATEGORIES.
+    /// @param sizeInBytes Allocation size in bytes
+    ///
+    static void RegisterAllocation(const Category category,
+                                   const std::uint64_t sizeInBytes) noexcept;
+
+    ///
+    /// @brief Registers a deallocation
+    /// @param category Allocation category. It must not be NUM_CATEGORIES.
+    /// @param sizeInBytes Allocation size in bytes. It must be the same size
+    /// used in RegisterAllocation()
+    ///
+    static void RegisterDeallocation(const Category category,
+                                     const std::uint64_t sizeInBytes) noexcept;
+
+    ///
+    /// @brief Sets category budget
+    /// @param category Category. It must not be NUM_CATEGORIES.
+    /// @param budgetInBytes Budget in bytes. Zero disables the budget.
+    ///
+    static void SetBudget(const Category category,
+                          const std::uint64_t budgetInBytes) noexcept;
+
+    ///
+    /// @brief Get category stats
+    /// @param category Category. It must not be NUM_CATEGORIES.
+    /// @return Category stats
+    ///
+    static CategoryStats GetCategoryStats(const Category category) noexcept;
+
+    ///
+    /// @brief Checks if a category is over its budget
+    /// @param category Category. It must not be NUM_CATEGORIES.
+    /// @return True if the category has a budget and its current size is greater than it.
+    /// Otherwise, false.
+    ///
+    static bool IsOverBudget(const Category category) noexcept;
+
+    ///
+    /// @brief Get the current size of all the categories
+    /// @return Size in bytes
+    ///
+    static std::uint64_t GetTotalSizeInBytes() noexcept;
+
+    ///
+    /// @brief Get the high-water mark of the size of all the categories
+    /// @return Size in bytes
+    ///
+    static std::uint64_t GetTotalPeakSizeInBytes() noexcept;
+
+    ///
+    /// @brief Get category name
+    /// @param category Category. It must not be NUM_CATEGORIES.
+    /// @return Category name (for example, "textures")
+    ///
+    static const char* GetCategoryName(const Category category) noexcept;
+
+    ///
+    /// @brief Get category from its name
+    /// @param categoryName Category name, as returned by GetCategoryName()
+    /// @param category Output category
+    /// @return True if the category was found. Otherwise, false.
+    ///
+    static bool GetCategoryByName(const std::string& categoryName,
+                                  Category& category) noexcept;
+
+    ///
+    /// @brief Get a JSON report with the stats of all the categories
+    /// @param reportName Name to identify the report (for example, the scene file path).
+    /// Must not be nullptr.
+    /// @return JSON report
+    ///
+    static std::string GetJsonReport(const char* reportName) noexcept;
+
+    ///
+    /// @brief Writes the JSON report to a file
+    /// @param filePath File path. Must not be nullptr.
+    /// @param reportName Name to identify the report. Must not be nullptr.
+    /// @return True if the file was written. Otherwise, false.
+    ///
+    static bool WriteJsonReport(const char* filePath,
+                                const char* reportName) noexcept;
+
+private:
+    ///
+    /// @brief Counters of a category
+    ///
+    struct CategoryCounters {
+        std::atomic<std::uint64_t> mCurrentSizeInBytes{ 0UL };
+        std::atomic<std::uint64_t> mPeakSizeInBytes{ 0UL };
+        std::atomic<std::uint64_t> mBudgetInBytes{ 0UL };
+        std::atomic<std::uint32_t> mAllocationCount{ 0U };
+        std::atomic<std::uint32_t> mBudgetExceededCount{ 0U };
+    };
+
+    static CategoryCounters mCategoryCounters[static_cast<std::uint32_t>(Category::NUM_CATEGORIES)];
+    static std::atomic<std::uint64_t> mTotalSizeInBytes;
+    static std::atomic<std::uint64_t> mTotalPeakSizeInBytes;
+};
+}
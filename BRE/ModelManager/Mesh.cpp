@@ -1,7 +1,8 @@
 #include "Mesh.h"
 
-#include <assimp/scene.h>
+#include <vector>
 
+#include <ModelManager\VertexCompressor.h>
 #include <Utils/DebugUtils.h>
 
 using namespace DirectX;
@@ -12,123 +13,96 @@ namespace {
 /// @brief Creates vertex and index buffer data
 /// @param vertexBufferData Vertex buffer data
 /// @param indexBufferData Index buffer data
-/// @param meshData Mesh data to get vertices and indices
-/// @param commandList Command list used to upload buffers content to GPU.
-/// It must be executed after this function call to upload buffers content to GPU.
-/// @param uploadVertexBuffer Upload buffer to create the buffer.
-/// It has to be kept alive after the function call because
-/// the command list has not been executed yet that performs the actual copy.
-/// The caller can Release the uploadBuffer after it knows the copy has been executed.
-/// @param uploadIndexBuffer Upload buffer to create the buffer.
-/// It has to be kept alive after the function call because
-/// the command list has not been executed yet that performs the actual copy.
-/// The caller can Release the uploadBuffer after it knows the copy has been executed.
+/// @param vertices Compressed vertices. Must not be nullptr.
+/// @param vertexCount Number of vertices. Must be greater than zero.
+/// @param indices Indices. Must not be nullptr.
+/// @param indexCount Number of indices. Must be greater than zero.
+/// @param indexSize Size of each index in bytes (2 or 4)
 ///
 void CreateVertexAndIndexBufferData(VertexAndIndexBufferCreator::VertexBufferData& vertexBufferData,
                                     VertexAndIndexBufferCreator::IndexBufferData& indexBufferData,
-                                    const GeometryGenerator::MeshData& meshData,
-                                    ID3D12GraphicsCommandList& commandList,
-                                    ID3D12Resource* &uploadVertexBuffer,
-                                    ID3D12Resource* &uploadIndexBuffer) noexcept
+                                    const VertexCompressor::CompressedVertex* vertices,
+                                    const std::uint32_t vertexCount,
+                                    const void* indices,
+                                    const std::uint32_t indexCount,
+                                    const std::uint32_t indexSize) noexcept
 {
     BRE_ASSERT(vertexBufferData.IsDataValid() == false);
     BRE_ASSERT(indexBufferData.IsDataValid() == false);
 
     // Create vertex buffer
-    VertexAndIndexBufferCreator::BufferCreationData vertexBufferParams(meshData.mVertices.data(),
-                                                                       static_cast<std::uint32_t>(meshData.mVertices.size()),
-                                                                       sizeof(GeometryGenerator::Vertex));
+    VertexAndIndexBufferCreator::BufferCreationData vertexBufferParams(vertices,
+                                                                       vertexCount,
+                                                                       sizeof(VertexCompressor::CompressedVertex));
 
     VertexAndIndexBufferCreator::CreateVertexBuffer(vertexBufferParams,
-                                                    vertexBufferData,
-                                                    commandList,
-                                                    uploadVertexBuffer);
+                                                    vertexBufferData);
 
     // Create index buffer
-    VertexAndIndexBufferCreator::BufferCreationData indexBufferParams(meshData.mIndices32.data(),
-                                                                      static_cast<std::uint32_t>(meshData.mIndices32.size()),
-                                                                      sizeof(std::uint32_t));
+    VertexAndIndexBufferCreator::BufferCreationData indexBufferParams(indices,
+                                                                      indexCount,
+                                                                      indexSize);
 
     VertexAndIndexBufferCreator::CreateIndexBuffer(indexBufferParams,
-                                                   indexBufferData,
-                                                   commandList,
-                                                   uploadIndexBuffer);
+                                                   indexBufferData);
 
     BRE_ASSERT(vertexBufferData.IsDataValid());
     BRE_ASSERT(indexBufferData.IsDataValid());
 }
 }
 
-Mesh::Mesh(const aiMesh& mesh,
-           ID3D12GraphicsCommandList& commandList,
-           ID3D12Resource* &uploadVertexBuffer,
-           ID3D12Resource* &uploadIndexBuffer)
+Mesh::Mesh(const MeshCache::MeshView& meshView)
 {
-    GeometryGenerator::MeshData meshData;
-
-    // Positions and Normals
-    const std::size_t numVertices{ mesh.mNumVertices };
-    BRE_ASSERT(numVertices > 0U);
-    BRE_ASSERT(mesh.HasNormals());
-    meshData.mVertices.resize(numVertices);
-    for (std::uint32_t i = 0U; i < numVertices; ++i) {
-        meshData.mVertices[i].mPosition = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mVertices[i]));
-        meshData.mVertices[i].mNormal = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mNormals[i]));
-    }
-
-    // Texture Coordinates (if any)
-    if (mesh.HasTextureCoords(0U)) {
-        BRE_ASSERT(mesh.GetNumUVChannels() == 1U);
-        const aiVector3D* aiTextureCoordinates{ mesh.mTextureCoords[0U] };
-        BRE_ASSERT(aiTextureCoordinates != nullptr);
-        for (std::uint32_t i = 0U; i < numVertices; i++) {
-            meshData.mVertices[i].mUV = XMFLOAT2(reinterpret_cast<const float*>(&aiTextureCoordinates[i]));
-        }
-    }
-
-    // Indices
-    BRE_ASSERT(mesh.HasFaces());
-    const std::uint32_t numFaces{ mesh.mNumFaces };
-    for (std::uint32_t i = 0U; i < numFaces; ++i) {
-        const aiFace* face = &mesh.mFaces[i];
-        BRE_ASSERT(face != nullptr);
-        // We only allow triangles
-        BRE_ASSERT(face->mNumIndices == 3U);
-
-        meshData.mIndices32.push_back(face->mIndices[0U]);
-        meshData.mIndices32.push_back(face->mIndices[1U]);
-        meshData.mIndices32.push_back(face->mIndices[2U]);
-    }
-
-    // Tangents
-    if (mesh.HasTangentsAndBitangents()) {
-        for (std::uint32_t i = 0U; i < numVertices; ++i) {
-            meshData.mVertices[i].mTangent = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mTangents[i]));
-        }
-    }
-
+    // Cache file data is copied straight to upload memory
     CreateVertexAndIndexBufferData(mVertexBufferData,
                                    mIndexBufferData,
-                                   meshData,
-                                   commandList,
-                                   uploadVertexBuffer,
-                                   uploadIndexBuffer);
+                                   meshView.mVertices,
+                                   meshView.mVertexCount,
+                                   meshView.mIndices,
+                                   meshView.mIndexCount,
+                                   meshView.mIndexSize);
+
+    BoundingBox::CreateFromPoints(mBoundingBox,
+                                  XMLoadFloat3(&meshView.mBoundsMin),
+                                  XMLoadFloat3(&meshView.mBoundsMax));
+
+    mMeshlets.assign(meshView.mMeshlets, meshView.mMeshlets + meshView.mMeshletCount);
 
     BRE_ASSERT(mVertexBufferData.IsDataValid());
     BRE_ASSERT(mIndexBufferData.IsDataValid());
 }
 
-Mesh::Mesh(const GeometryGenerator::MeshData& meshData,
-           ID3D12GraphicsCommandList& commandList,
-           ID3D12Resource* &uploadVertexBuffer,
-           ID3D12Resource* &uploadIndexBuffer)
+Mesh::Mesh(const GeometryGenerator::MeshData& meshData)
 {
+    std::vector<VertexCompressor::CompressedVertex> compressedVertices(meshData.mVertices.size());
+    VertexCompressor::CompressVertices(meshData.mVertices.data(), meshData.mVertices.size(), compressedVertices.data());
+
+    // Meshlets reorder triangles
+    std::vector<std::uint32_t> indices32(meshData.mIndices32);
+    MeshletBuilder::BuildMeshlets(meshData.mVertices, indices32, mMeshlets);
+
+    // Use 16 bits indices if they can address every vertex
+    const std::uint32_t indexSize = MeshCache::GetIndexSize(meshData.mVertices.size());
+    std::vector<std::uint16_t> indices16;
+    if (indexSize == sizeof(std::uint16_t)) {
+        indices16.resize(indices32.size());
+        for (std::size_t i = 0U; i < indices32.size(); ++i) {
+            indices16[i] = static_cast<std::uint16_t>(indices32[i]);
+        }
+    }
+
     CreateVertexAndIndexBufferData(mVertexBufferData,
                                    mIndexBufferData,
-                                   meshData,
-                                   commandList,
-                                   uploadVertexBuffer,
-                                   uploadIndexBuffer);
+                                   compressedVertices.data(),
+                                   static_cast<std::uint32_t>(compressedVertices.size()),
+                                   indices16.empty() ? static_cast<const void*>(indices32.data()) : indices16.data(),
+                                   static_cast<std::uint32_t>(indices32.size()),
+                                   indexSize);
+
+    BoundingBox::CreateFromPoints(mBoundingBox,
+                                  meshData.mVertices.size(),
+                                  &meshData.mVertices[0U].mPosition,
+                                  sizeof(GeometryGenerator::Vertex));
 
     BRE_ASSERT(mVertexBufferData.IsDataValid());
     BRE_ASSERT(mIndexBufferData.IsDataValid());
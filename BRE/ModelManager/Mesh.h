@@ -1,19 +1,23 @@
 #pragma once
 
 #include <cstdint>
+#include <DirectXCollision.h>
+#include <vector>
 
 #include <GeometryGenerator/GeometryGenerator.h>
+#include <ModelManager\MeshCache.h>
+#include <ModelManager\MeshletBuilder.h>
 #include <ResourceManager\VertexAndIndexBufferCreator.h>
 #include <Utils/DebugUtils.h>
 
-struct aiMesh;
-
 namespace BRE {
 class Model;
 
 ///
 /// @brief Stores model's mesh vertex and index data.
 ///
+/// Buffers are uploaded through StagingRingBuffer.
+///
 class Mesh {
     friend class Model;
 
@@ -50,48 +54,41 @@ public:
         return mIndexBufferData;
     }
 
+    ///
+    /// @brief Get bounding box
+    /// @return Axis aligned bounding box in model space
+    ///
+    __forceinline const DirectX::BoundingBox& GetBoundingBox() const noexcept
+    {
+        return mBoundingBox;
+    }
+
+    ///
+    /// @brief Get meshlets
+    /// @return Meshlets. They cover the whole index buffer.
+    ///
+    __forceinline const std::vector<MeshletBuilder::Meshlet>& GetMeshlets() const noexcept
+    {
+        return mMeshlets;
+    }
+
 private:
     ///
     /// @brief Mesh constructor
-    /// @param mesh Assimp mesh
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
-    ///
-    explicit Mesh(const aiMesh& mesh,
-                  ID3D12GraphicsCommandList& commandList,
-                  ID3D12Resource* &uploadVertexBuffer,
-                  ID3D12Resource* &uploadIndexBuffer);
+    /// @param meshView Mesh view of a mesh cache file. Its data is copied
+    /// to upload memory, so it can be released after this call.
+    ///
+    explicit Mesh(const MeshCache::MeshView& meshView);
 
     ///
     /// @brief Mesh constructor
     /// @param meshData Mesh data where we extract vertex and indices
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
-    ///
-    explicit Mesh(const GeometryGenerator::MeshData& meshData,
-                  ID3D12GraphicsCommandList& commandList,
-                  ID3D12Resource* &uploadVertexBuffer,
-                  ID3D12Resource* &uploadIndexBuffer);
+    ///
+    explicit Mesh(const GeometryGenerator::MeshData& meshData);
 
     VertexAndIndexBufferCreator::VertexBufferData mVertexBufferData;
     VertexAndIndexBufferCreator::IndexBufferData mIndexBufferData;
+    DirectX::BoundingBox mBoundingBox;
+    std::vector<MeshletBuilder::Meshlet> mMeshlets;
 };
 }
\ No newline at end of file
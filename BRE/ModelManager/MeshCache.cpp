@@ -0,0 +1,248 @@
+#include "MeshCache.h"
+
+#include <cfloat>
+#include <cstring>
+#include <fstream>
+
+#include <Utils\DebugUtils.h>
+#include <Utils\HashUtils.h>
+
+using namespace DirectX;
+
+namespace BRE {
+namespace {
+const char* sCacheDirectory{ "mesh_cache" };
+const char* sCacheFileExtension{ ".bremesh" };
+
+///
+/// @brief Aligns an offset
+/// @param offset Offset to align
+/// @param alignment Alignment. Must be a power of two.
+/// @return Aligned offset
+///
+std::uint64_t
+AlignOffset(const std::uint64_t offset,
+            const std::uint64_t alignment) noexcept
+{
+    return (offset + alignment - 1UL) & ~(alignment - 1UL);
+}
+
+///
+/// @brief Computes mesh bounds
+/// @param meshData Mesh data
+/// @param boundsMin Output minimum bounds
+/// @param boundsMax Output maximum bounds
+///
+void
+ComputeBounds(const GeometryGenerator::MeshData& meshData,
+              XMFLOAT3& boundsMin,
+              XMFLOAT3& boundsMax) noexcept
+{
+    boundsMin = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+    boundsMax = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+        boundsMin.x = vertex.mPosition.x < boundsMin.x ? vertex.mPosition.x : boundsMin.x;
+        boundsMin.y = vertex.mPosition.y < boundsMin.y ? vertex.mPosition.y : boundsMin.y;
+        boundsMin.z = vertex.mPosition.z < boundsMin.z ? vertex.mPosition.z : boundsMin.z;
+        boundsMax.x = vertex.mPosition.x > boundsMax.x ? vertex.mPosition.x : boundsMax.x;
+        boundsMax.y = vertex.mPosition.y > boundsMax.y ? vertex.mPosition.y : boundsMax.y;
+        boundsMax.z = vertex.mPosition.z > boundsMax.z ? vertex.mPosition.z : boundsMax.z;
+    }
+}
+
+///
+/// @brief Checks if a blob is inside the file
+/// @param offset Blob offset
+/// @param size Blob size in bytes
+/// @param fileSize File size in bytes
+/// @return True if it is inside. Otherwise, false.
+///
+bool
+IsBlobInsideFile(const std::uint64_t offset,
+                 const std::uint64_t size,
+                 const std::uint64_t fileSize) noexcept
+{
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+///
+/// @brief Checks if meshlets are valid
+/// @param meshlets Meshlets
+/// @param meshletCount Number of meshlets
+/// @param indexCount Number of indices of the mesh
+/// @return True if meshlets are triangle ranges inside the indices, sorted by first index. Otherwise, false.
+///
+bool
+AreMeshletsValid(const MeshletBuilder::Meshlet* meshlets,
+                 const std::uint32_t meshletCount,
+                 const std::uint32_t indexCount) noexcept
+{
+    std::uint64_t firstIndex{ 0UL };
+    for (std::uint32_t i = 0U; i < meshletCount; ++i) {
+        const MeshletBuilder::Meshlet& meshlet = meshlets[i];
+        if (meshlet.mFirstIndex < firstIndex ||
+            meshlet.mIndexCount % 3U != 0U ||
+            static_cast<std::uint64_t>(meshlet.mFirstIndex) + meshlet.mIndexCount > indexCount) {
+            return false;
+        }
+
+        firstIndex = static_cast<std::uint64_t>(meshlet.mFirstIndex) + meshlet.mIndexCount;
+    }
+
+    return true;
+}
+}
+
+std::string
+MeshCache::GetCacheFilePath(const std::uint64_t sourceContentHash) noexcept
+{
+    return HashUtils::GetCachedFilePath(sCacheDirectory, sourceContentHash, sCacheFileExtension);
+}
+
+bool
+MeshCache::WriteCacheFile(const char* filePath,
+                          const std::uint64_t sourceContentHash,
+                          const std::vector<GeometryGenerator::MeshData>& meshDataList) noexcept
+{
+    BRE_ASSERT(filePath != nullptr);
+    BRE_ASSERT(meshDataList.empty() == false);
+
+    const std::uint32_t meshCount = static_cast<std::uint32_t>(meshDataList.size());
+
+    // Compute headers and blob offsets
+    std::vector<MeshHeader> meshHeaders(meshCount);
+    std::vector<std::vector<std::uint32_t>> indicesList(meshCount);
+    std::vector<std::vector<MeshletBuilder::Meshlet>> meshletsList(meshCount);
+    std::uint64_t offset = sizeof(FileHeader) + sizeof(MeshHeader) * meshCount;
+    for (std::uint32_t i = 0U; i < meshCount; ++i) {
+        const GeometryGenerator::MeshData& meshData = meshDataList[i];
+        BRE_ASSERT(meshData.mVertices.empty() == false);
+        BRE_ASSERT(meshData.mIndices32.empty() == false);
+
+        MeshHeader& meshHeader = meshHeaders[i];
+        meshHeader.mVertexCount = static_cast<std::uint32_t>(meshData.mVertices.size());
+        meshHeader.mIndexCount = static_cast<std::uint32_t>(meshData.mIndices32.size());
+        meshHeader.mIndexSize = GetIndexSize(meshData.mVertices.size());
+        ComputeBounds(meshData, meshHeader.mBoundsMin, meshHeader.mBoundsMax);
+        // Meshlets reorder triangles
+        indicesList[i] = meshData.mIndices32;
+        MeshletBuilder::BuildMeshlets(meshData.mVertices, indicesList[i], meshletsList[i]);
+        meshHeader.mMeshletCount = static_cast<std::uint32_t>(meshletsList[i].size());
+
+        meshHeader.mVertexDataOffset = AlignOffset(offset, sBlobAlignment);
+        offset = meshHeader.mVertexDataOffset + sizeof(VertexCompressor::CompressedVertex) * meshHeader.mVertexCount;
+        meshHeader.mIndexDataOffset = AlignOffset(offset, sBlobAlignment);
+        offset = meshHeader.mIndexDataOffset + static_cast<std::uint64_t>(meshHeader.mIndexSize) * meshHeader.mIndexCount;
+        meshHeader.mMeshletDataOffset = AlignOffset(offset, sBlobAlignment);
+        offset = meshHeader.mMeshletDataOffset + sizeof(MeshletBuilder::Meshlet) * meshHeader.mMeshletCount;
+    }
+
+    FileHeader fileHeader;
+    fileHeader.mMagic = sMagic;
+    fileHeader.mVersion = sVersion;
+    fileHeader.mSourceContentHash = sourceContentHash;
+    fileHeader.mFileSize = offset;
+    fileHeader.mMeshCount = meshCount;
+    fileHeader.mVertexStride = sizeof(VertexCompressor::CompressedVertex);
+
+    // Fill the whole file in memory, so it is written with a single call.
+    std::vector<std::uint8_t> fileData(static_cast<std::size_t>(fileHeader.mFileSize), 0U);
+    std::memcpy(fileData.data(), &fileHeader, sizeof(FileHeader));
+    std::memcpy(fileData.data() + sizeof(FileHeader), meshHeaders.data(), sizeof(MeshHeader) * meshCount);
+    for (std::uint32_t i = 0U; i < meshCount; ++i) {
+        const GeometryGenerator::MeshData& meshData = meshDataList[i];
+        const MeshHeader& meshHeader = meshHeaders[i];
+        VertexCompressor::CompressVertices(meshData.mVertices.data(),
+                                           meshHeader.mVertexCount,
+                                           reinterpret_cast<VertexCompressor::CompressedVertex*>(fileData.data() + meshHeader.mVertexDataOffset));
+        if (meshHeader.mIndexSize == sizeof(std::uint32_t)) {
+            std::memcpy(fileData.data() + meshHeader.mIndexDataOffset,
+                        indicesList[i].data(),
+                        sizeof(std::uint32_t) * meshHeader.mIndexCount);
+        } else {
+            std::uint16_t* indices16 = reinterpret_cast<std::uint16_t*>(fileData.data() + meshHeader.mIndexDataOffset);
+            for (std::uint32_t j = 0U; j < meshHeader.mIndexCount; ++j) {
+                indices16[j] = static_cast<std::uint16_t>(indicesList[i][j]);
+            }
+        }
+        std::memcpy(fileData.data() + meshHeader.mMeshletDataOffset,
+                    meshletsList[i].data(),
+                    sizeof(MeshletBuilder::Meshlet) * meshHeader.mMeshletCount);
+    }
+
+    std::ofstream fileStream{ filePath, std::ios::out | std::ios::binary | std::ios::trunc };
+    if (fileStream.is_open() == false) {
+        return false;
+    }
+
+    fileStream.write(reinterpret_cast<const char*>(fileData.data()), fileData.size());
+
+    return fileStream.good();
+}
+
+bool
+MeshCache::ReadCacheFile(const void* fileData,
+                         const std::size_t fileSize,
+                         const std::uint64_t sourceContentHash,
+                         std::vector<MeshView>& meshViews) noexcept
+{
+    BRE_ASSERT(fileData != nullptr);
+
+    meshViews.clear();
+
+    if (fileSize < sizeof(FileHeader)) {
+        return false;
+    }
+
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(fileData);
+    const FileHeader& fileHeader = *reinterpret_cast<const FileHeader*>(bytes);
+    if (fileHeader.mMagic != sMagic ||
+        fileHeader.mVersion != sVersion ||
+        fileHeader.mSourceContentHash != sourceContentHash ||
+        fileHeader.mFileSize != fileSize ||
+        fileHeader.mVertexStride != sizeof(VertexCompressor::CompressedVertex) ||
+        fileHeader.mMeshCount == 0U) {
+        return false;
+    }
+
+    if (IsBlobInsideFile(sizeof(FileHeader),
+                         sizeof(MeshHeader) * static_cast<std::uint64_t>(fileHeader.mMeshCount),
+                         fileSize) == false) {
+        return false;
+    }
+
+    const MeshHeader* meshHeaders = reinterpret_cast<const MeshHeader*>(bytes + sizeof(FileHeader));
+    meshViews.resize(fileHeader.mMeshCount);
+    for (std::uint32_t i = 0U; i < fileHeader.mMeshCount; ++i) {
+        const MeshHeader& meshHeader = meshHeaders[i];
+        const std::uint64_t vertexDataSize = sizeof(VertexCompressor::CompressedVertex) * static_cast<std::uint64_t>(meshHeader.mVertexCount);
+        const std::uint64_t indexDataSize = meshHeader.mIndexSize * static_cast<std::uint64_t>(meshHeader.mIndexCount);
+        const std::uint64_t meshletDataSize = sizeof(MeshletBuilder::Meshlet) * static_cast<std::uint64_t>(meshHeader.mMeshletCount);
+        if (meshHeader.mVertexCount == 0U ||
+            meshHeader.mIndexCount == 0U ||
+            meshHeader.mIndexSize != GetIndexSize(meshHeader.mVertexCount) ||
+            IsBlobInsideFile(meshHeader.mVertexDataOffset, vertexDataSize, fileSize) == false ||
+            IsBlobInsideFile(meshHeader.mIndexDataOffset, indexDataSize, fileSize) == false ||
+            IsBlobInsideFile(meshHeader.mMeshletDataOffset, meshletDataSize, fileSize) == false ||
+            AreMeshletsValid(reinterpret_cast<const MeshletBuilder::Meshlet*>(bytes + meshHeader.mMeshletDataOffset),
+                             meshHeader.mMeshletCount,
+                             meshHeader.mIndexCount) == false) {
+            meshViews.clear();
+            return false;
+        }
+
+        MeshView& meshView = meshViews[i];
+        meshView.mVertices = reinterpret_cast<const VertexCompressor::CompressedVertex*>(bytes + meshHeader.mVertexDataOffset);
+        meshView.mVertexCount = meshHeader.mVertexCount;
+        meshView.mIndices = bytes + meshHeader.mIndexDataOffset;
+        meshView.mIndexCount = meshHeader.mIndexCount;
+        meshView.mIndexSize = meshHeader.mIndexSize;
+        meshView.mMeshlets = reinterpret_cast<const MeshletBuilder::Meshlet*>(bytes + meshHeader.mMeshletDataOffset);
+        meshView.mMeshletCount = meshHeader.mMeshletCount;
+        meshView.mBoundsMin = meshHeader.mBoundsMin;
+        meshView.mBoundsMax = meshHeader.mBoundsMax;
+    }
+
+    return true;
+}
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+
+#include <GeometryGenerator\GeometryGenerator.h>
+#include <ModelManager\MeshletBuilder.h>
+#include <ModelManager\VertexCompressor.h>
+
+namespace BRE {
+///
+/// @brief Responsible to write and read preprocessed mesh cache files.
+///
+/// Cache files are generated the first time a source model is loaded, and they are
+/// named after the content hash of the source model, so a modified model gets a new cache file.
+///
+/// File layout:
+/// - FileHeader
+/// - MeshHeader per mesh
+/// - Vertex, index and meshlet blobs of each mesh, aligned to sBlobAlignment.
+///
+/// Blobs are stored in the same layout that vertex and index buffers use
+/// (VertexCompressor::CompressedVertex, and 16 bits indices if the vertex count allows them, or 32 bits indices),
+/// so they can be copied straight from a memory mapped file to upload memory.
+/// Meshes are optimized with MeshOptimizer before they are written, and meshlets
+/// are built from the optimized meshes (see MeshletBuilder).
+///
+class MeshCache {
+public:
+    MeshCache() = delete;
+    ~MeshCache() = delete;
+    MeshCache(const MeshCache&) = delete;
+    const MeshCache& operator=(const MeshCache&) = delete;
+    MeshCache(MeshCache&&) = delete;
+    MeshCache& operator=(MeshCache&&) = delete;
+
+    static const std::uint32_t sMagic{ 0x434D5242U }; // "BRMC"
+    static const std::uint32_t sVersion{ 4U };
+    static const std::uint32_t sBlobAlignment{ 64U };
+
+    ///
+    /// @brief Cache file header
+    ///
+    struct FileHeader {
+        std::uint32_t mMagic{ 0U };
+        std::uint32_t mVersion{ 0U };
+        std::uint64_t mSourceContentHash{ 0UL };
+        std::uint64_t mFileSize{ 0UL };
+        std::uint32_t mMeshCount{ 0U };
+        std::uint32_t mVertexStride{ 0U };
+    };
+
+    ///
+    /// @brief Mesh header. Offsets are relative to the beginning of the file.
+    ///
+    struct MeshHeader {
+        std::uint64_t mVertexDataOffset{ 0UL };
+        std::uint64_t mIndexDataOffset{ 0UL };
+        std::uint64_t mMeshletDataOffset{ 0UL };
+        std::uint32_t mVertexCount{ 0U };
+        std::uint32_t mIndexCount{ 0U };
+        DirectX::XMFLOAT3 mBoundsMin{ 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 mBoundsMax{ 0.0f, 0.0f, 0.0f };
+        std::uint32_t mIndexSize{ 0U };
+        std::uint32_t mMeshletCount{ 0U };
+    };
+
+    ///
+    /// @brief Mesh data that points to cache file memory
+    ///
+    struct MeshView {
+        const VertexCompressor::CompressedVertex* mVertices{ nullptr };
+        std::uint32_t mVertexCount{ 0U };
+        const void* mIndices{ nullptr };
+        std::uint32_t mIndexCount{ 0U };
+        std::uint32_t mIndexSize{ 0U }; // Size of each index in bytes (2 or 4)
+        const MeshletBuilder::Meshlet* mMeshlets{ nullptr };
+        std::uint32_t mMeshletCount{ 0U };
+        DirectX::XMFLOAT3 mBoundsMin{ 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 mBoundsMax{ 0.0f, 0.0f, 0.0f };
+    };
+
+    ///
+    /// @brief Get the index size of a mesh
+    /// @param vertexCount Number of vertices
+    /// @return Size of each index in bytes. It is 2 if 16 bits indices can address every vertex. Otherwise, 4.
+    ///
+    __forceinline static std::uint32_t GetIndexSize(const std::size_t vertexCount) noexcept
+    {
+        return static_cast<std::uint32_t>(vertexCount <= 65536U ? sizeof(std::uint16_t) : sizeof(std::uint32_t));
+    }
+
+    ///
+    /// @brief Get cache file path. It creates the cache directory if it does not exist.
+    /// @param sourceContentHash Content hash of the source model
+    /// @return Cache file path
+    ///
+    static std::string GetCacheFilePath(const std::uint64_t sourceContentHash) noexcept;
+
+    ///
+    /// @brief Writes a cache file
+    /// @param filePath File path. Must not be nullptr.
+    /// @param sourceContentHash Content hash of the source model
+    /// @param meshDataList Meshes to write. It must not be empty.
+    /// @return True if the file was written. Otherwise, false.
+    ///
+    static bool WriteCacheFile(const char* filePath,
+                               const std::uint64_t sourceContentHash,
+                               const std::vector<GeometryGenerator::MeshData>& meshDataList) noexcept;
+
+    ///
+    /// @brief Reads cache file meshes.
+    ///
+    /// No data is copied, so mesh views are valid while the file data is.
+    ///
+    /// @param fileData Cache file data. Must not be nullptr.
+    /// @param fileSize Cache file size in bytes
+    /// @param sourceContentHash Expected content hash of the source model
+    /// @param meshViews Output mesh views
+    /// @return True if the file is valid and it matches the version and content hash.
+    /// Otherwise, false, and the cache file must be generated again.
+    ///
+    static bool ReadCacheFile(const void* fileData,
+                              const std::size_t fileSize,
+                              const std::uint64_t sourceContentHash,
+                              std::vector<MeshView>& meshViews) noexcept;
+};
+}
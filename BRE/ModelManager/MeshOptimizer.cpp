@@ -0,0 +1,414 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+namespace {
+const std::uint32_t sInvalidVertex{ std::numeric_limits<std::uint32_t>::max() };
+
+///
+/// @brief Accesses a vertex in a simulated FIFO vertex cache.
+///
+/// A vertex is in the cache if less than cacheSize vertices were inserted after it.
+/// Cache time starts at cacheSize + 1, so vertices with a zero time stamp are not in the cache,
+/// and adding cacheSize + 1 to it flushes the cache.
+///
+/// @param vertex Vertex index
+/// @param cacheSize Cache size in vertices
+/// @param cacheTimeStamps Cache time stamp of each vertex
+/// @param cacheTime Cache time. It is incremented when a vertex is inserted.
+/// @return True if the vertex was not in the cache. Otherwise, false.
+///
+bool
+AccessVertexCache(const std::uint32_t vertex,
+                  const std::uint32_t cacheSize,
+                  std::vector<std::uint32_t>& cacheTimeStamps,
+                  std::uint32_t& cacheTime) noexcept
+{
+    if (cacheTime - cacheTimeStamps[vertex] > cacheSize) {
+        cacheTimeStamps[vertex] = cacheTime++;
+        return true;
+    }
+
+    return false;
+}
+
+///
+/// @brief Accesses the vertices of a triangle in a simulated FIFO vertex cache
+/// @param indices Triangle list indices
+/// @param triangle Triangle index
+/// @param cacheSize Cache size in vertices
+/// @param cacheTimeStamps Cache time stamp of each vertex
+/// @param cacheTime Cache time
+/// @return Number of vertices that were not in the cache
+///
+std::uint32_t
+AccessVertexCache(const std::vector<std::uint32_t>& indices,
+                  const std::size_t triangle,
+                  const std::uint32_t cacheSize,
+                  std::vector<std::uint32_t>& cacheTimeStamps,
+                  std::uint32_t& cacheTime) noexcept
+{
+    std::uint32_t missCount{ 0U };
+    for (std::size_t i = triangle * 3U; i < triangle * 3U + 3U; ++i) {
+        missCount += AccessVertexCache(indices[i], cacheSize, cacheTimeStamps, cacheTime) ? 1U : 0U;
+    }
+
+    return missCount;
+}
+
+///
+/// @brief Get the next fanning vertex of Tipsify
+///
+/// It is the candidate vertex with live triangles that stays longer in the cache
+/// after its live triangles are emitted. If there is no candidate, then it is the most
+/// recently used vertex with live triangles, or the next vertex with live triangles.
+///
+/// @param candidates Vertices of the triangles emitted in the last fan
+/// @param liveTriangleCounts Number of not emitted triangles of each vertex
+/// @param cacheTimeStamps Cache time stamp of each vertex
+/// @param cacheTime Cache time
+/// @param cacheSize Cache size in vertices
+/// @param deadEndStack Vertices of emitted triangles. Vertices are popped while they have no live triangles.
+/// @param cursor Cursor to the next vertex to check if there is no other vertex
+/// @return Next fanning vertex, or sInvalidVertex if all triangles were emitted
+///
+std::uint32_t
+GetNextFanningVertex(const std::vector<std::uint32_t>& candidates,
+                     const std::vector<std::uint32_t>& liveTriangleCounts,
+                     const std::vector<std::uint32_t>& cacheTimeStamps,
+                     const std::uint32_t cacheTime,
+                     const std::uint32_t cacheSize,
+                     std::vector<std::uint32_t>& deadEndStack,
+                     std::uint32_t& cursor) noexcept
+{
+    std::uint32_t nextVertex{ sInvalidVertex };
+    std::int64_t nextVertexPriority{ -1 };
+    for (const std::uint32_t candidate : candidates) {
+        if (liveTriangleCounts[candidate] == 0U) {
+            continue;
+        }
+
+        // Vertices that would be evicted while their live triangles are emitted have the lowest priority.
+        std::int64_t priority{ 0 };
+        const std::int64_t cacheAge = static_cast<std::int64_t>(cacheTime - cacheTimeStamps[candidate]);
+        if (cacheAge + 2 * static_cast<std::int64_t>(liveTriangleCounts[candidate]) <= static_cast<std::int64_t>(cacheSize)) {
+            priority = cacheAge;
+        }
+
+        if (priority > nextVertexPriority) {
+            nextVertex = candidate;
+            nextVertexPriority = priority;
+        }
+    }
+
+    if (nextVertex != sInvalidVertex) {
+        return nextVertex;
+    }
+
+    while (deadEndStack.empty() == false) {
+        const std::uint32_t vertex = deadEndStack.back();
+        deadEndStack.pop_back();
+        if (liveTriangleCounts[vertex] > 0U) {
+            return vertex;
+        }
+    }
+
+    const std::uint32_t vertexCount = static_cast<std::uint32_t>(liveTriangleCounts.size());
+    while (cursor < vertexCount) {
+        if (liveTriangleCounts[cursor] > 0U) {
+            return cursor;
+        }
+        ++cursor;
+    }
+
+    return sInvalidVertex;
+}
+
+///
+/// @brief Splits vertex cache optimized triangles in clusters
+/// @param indices Triangle list indices
+/// @param vertexCount Number of vertices
+/// @param threshold Maximum ACMR increase allowed
+/// @param clusterStarts Output first triangle of each cluster
+///
+void
+SplitInClusters(const std::vector<std::uint32_t>& indices,
+                const std::uint32_t vertexCount,
+                const float threshold,
+                std::vector<std::uint32_t>& clusterStarts) noexcept
+{
+    const std::uint32_t cacheSize{ MeshOptimizer::sVertexCacheSize };
+    const std::uint32_t triangleCount = static_cast<std::uint32_t>(indices.size() / 3U);
+    std::vector<std::uint32_t> cacheTimeStamps(vertexCount, 0U);
+    std::uint32_t cacheTime{ cacheSize + 1U };
+
+    // Hard boundaries: Triangles whose vertices are not in the cache start a disjoint patch of the mesh.
+    std::vector<std::uint32_t> hardClusterStarts;
+    for (std::uint32_t i = 0U; i < triangleCount; ++i) {
+        if (AccessVertexCache(indices, i, cacheSize, cacheTimeStamps, cacheTime) == 3U || i == 0U) {
+            hardClusterStarts.push_back(i);
+        }
+    }
+    hardClusterStarts.push_back(triangleCount);
+
+    // Soft boundaries: Hard clusters are split when the ACMR of their first triangles,
+    // with a flushed cache, is not worse than threshold times the ACMR of the hard cluster.
+    clusterStarts.clear();
+    for (std::size_t i = 0U; i + 1U < hardClusterStarts.size(); ++i) {
+        const std::uint32_t hardClusterStart = hardClusterStarts[i];
+        const std::uint32_t hardClusterEnd = hardClusterStarts[i + 1U];
+
+        cacheTime += cacheSize + 1U;
+        std::uint32_t missCount{ 0U };
+        for (std::uint32_t j = hardClusterStart; j < hardClusterEnd; ++j) {
+            missCount += AccessVertexCache(indices, j, cacheSize, cacheTimeStamps, cacheTime);
+        }
+        const float maxACMR = threshold * static_cast<float>(missCount) / static_cast<float>(hardClusterEnd - hardClusterStart);
+
+        cacheTime += cacheSize + 1U;
+        std::uint32_t clusterStart{ hardClusterStart };
+        std::uint32_t clusterMissCount{ 0U };
+        clusterStarts.push_back(clusterStart);
+        for (std::uint32_t j = hardClusterStart; j < hardClusterEnd; ++j) {
+            clusterMissCount += AccessVertexCache(indices, j, cacheSize, cacheTimeStamps, cacheTime);
+            const float clusterACMR = static_cast<float>(clusterMissCount) / static_cast<float>(j + 1U - clusterStart);
+            if (j + 1U < hardClusterEnd && clusterACMR <= maxACMR) {
+                clusterStart = j + 1U;
+                clusterMissCount = 0U;
+                clusterStarts.push_back(clusterStart);
+                cacheTime += cacheSize + 1U;
+            }
+        }
+    }
+    clusterStarts.push_back(triangleCount);
+}
+}
+
+void
+MeshOptimizer::OptimizeMesh(GeometryGenerator::MeshData& meshData) noexcept
+{
+    const std::uint32_t vertexCount = static_cast<std::uint32_t>(meshData.mVertices.size());
+    OptimizeVertexCache(meshData.mIndices32, vertexCount);
+    OptimizeOverdraw(meshData.mVertices, meshData.mIndices32);
+    OptimizeVertexFetch(meshData);
+}
+
+void
+MeshOptimizer::OptimizeVertexCache(std::vector<std::uint32_t>& indices,
+                                   const std::uint32_t vertexCount,
+                                   const std::uint32_t cacheSize) noexcept
+{
+    BRE_ASSERT(indices.size() % 3U == 0U);
+    BRE_ASSERT(cacheSize > 0U);
+
+    // Triangles adjacent to each vertex. A triangle is adjacent once per vertex reference,
+    // so degenerate triangles are consistent with live triangle counts.
+    std::vector<std::uint32_t> adjacencyOffsets(vertexCount + 1U, 0U);
+    for (const std::uint32_t index : indices) {
+        BRE_ASSERT(index < vertexCount);
+        ++adjacencyOffsets[index + 1U];
+    }
+
+    std::vector<std::uint32_t> liveTriangleCounts(vertexCount);
+    for (std::uint32_t i = 0U; i < vertexCount; ++i) {
+        liveTriangleCounts[i] = adjacencyOffsets[i + 1U];
+        adjacencyOffsets[i + 1U] += adjacencyOffsets[i];
+    }
+
+    std::vector<std::uint32_t> adjacentTriangles(indices.size());
+    {
+        std::vector<std::uint32_t> adjacencyCursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1U);
+        for (std::size_t i = 0U; i < indices.size(); ++i) {
+            adjacentTriangles[adjacencyCursors[indices[i]]++] = static_cast<std::uint32_t>(i / 3U);
+        }
+    }
+
+    // Tipsify: Triangles are emitted in fans around vertices, and the next fanning vertex
+    // is chosen among the vertices of the last fan.
+    std::vector<std::uint32_t> optimizedIndices;
+    optimizedIndices.reserve(indices.size());
+    std::vector<bool> isTriangleEmitted(indices.size() / 3U, false);
+    std::vector<std::uint32_t> cacheTimeStamps(vertexCount, 0U);
+    std::uint32_t cacheTime{ cacheSize + 1U };
+    std::vector<std::uint32_t> deadEndStack;
+    std::vector<std::uint32_t> candidates;
+    std::uint32_t cursor{ 0U };
+    std::uint32_t fanningVertex = indices.empty() ? sInvalidVertex : indices[0U];
+    while (fanningVertex != sInvalidVertex) {
+        candidates.clear();
+        for (std::uint32_t i = adjacencyOffsets[fanningVertex]; i < adjacencyOffsets[fanningVertex + 1U]; ++i) {
+            const std::uint32_t triangle = adjacentTriangles[i];
+            if (isTriangleEmitted[triangle]) {
+                continue;
+            }
+
+            for (std::uint32_t j = triangle * 3U; j < triangle * 3U + 3U; ++j) {
+                const std::uint32_t vertex = indices[j];
+                optimizedIndices.push_back(vertex);
+                deadEndStack.push_back(vertex);
+                candidates.push_back(vertex);
+                --liveTriangleCounts[vertex];
+                AccessVertexCache(vertex, cacheSize, cacheTimeStamps, cacheTime);
+            }
+            isTriangleEmitted[triangle] = true;
+        }
+
+        fanningVertex = GetNextFanningVertex(candidates,
+                                             liveTriangleCounts,
+                                             cacheTimeStamps,
+                                             cacheTime,
+                                             cacheSize,
+                                             deadEndStack,
+                                             cursor);
+    }
+
+    BRE_ASSERT(optimizedIndices.size() == indices.size());
+    indices.swap(optimizedIndices);
+}
+
+void
+MeshOptimizer::OptimizeOverdraw(const std::vector<GeometryGenerator::Vertex>& vertices,
+                                std::vector<std::uint32_t>& indices,
+                                const float threshold) noexcept
+{
+    BRE_ASSERT(indices.size() % 3U == 0U);
+    BRE_ASSERT(threshold >= 1.0f);
+
+    if (indices.empty()) {
+        return;
+    }
+
+    std::vector<std::uint32_t> clusterStarts;
+    SplitInClusters(indices, static_cast<std::uint32_t>(vertices.size()), threshold, clusterStarts);
+    const std::size_t clusterCount = clusterStarts.size() - 1U;
+
+    // Cluster centroids and normals are weighted by triangle area
+    struct Cluster {
+        float mCentroid[3U]{ 0.0f, 0.0f, 0.0f };
+        float mNormal[3U]{ 0.0f, 0.0f, 0.0f };
+        float mArea{ 0.0f };
+        float mSortKey{ 0.0f };
+    };
+    std::vector<Cluster> clusters(clusterCount);
+    float meshCentroid[3U]{ 0.0f, 0.0f, 0.0f };
+    float meshArea{ 0.0f };
+    for (std::size_t i = 0U; i < clusterCount; ++i) {
+        Cluster& cluster = clusters[i];
+        for (std::uint32_t j = clusterStarts[i]; j < clusterStarts[i + 1U]; ++j) {
+            const DirectX::XMFLOAT3& p0 = vertices[indices[j * 3U]].mPosition;
+            const DirectX::XMFLOAT3& p1 = vertices[indices[j * 3U + 1U]].mPosition;
+            const DirectX::XMFLOAT3& p2 = vertices[indices[j * 3U + 2U]].mPosition;
+            const float e1[3U]{ p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+            const float e2[3U]{ p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+            const float normal[3U]{
+                e1[1U] * e2[2U] - e1[2U] * e2[1U],
+                e1[2U] * e2[0U] - e1[0U] * e2[2U],
+                e1[0U] * e2[1U] - e1[1U] * e2[0U]
+            };
+            const float area = std::sqrt(normal[0U] * normal[0U] + normal[1U] * normal[1U] + normal[2U] * normal[2U]);
+            const float centroid[3U]{
+                (p0.x + p1.x + p2.x) / 3.0f,
+                (p0.y + p1.y + p2.y) / 3.0f,
+                (p0.z + p1.z + p2.z) / 3.0f
+            };
+
+            for (std::uint32_t k = 0U; k < 3U; ++k) {
+                cluster.mCentroid[k] += centroid[k] * area;
+                cluster.mNormal[k] += normal[k];
+            }
+            cluster.mArea += area;
+        }
+
+        for (std::uint32_t k = 0U; k < 3U; ++k) {
+            meshCentroid[k] += cluster.mCentroid[k];
+        }
+        meshArea += cluster.mArea;
+    }
+
+    // Clusters that face away from the mesh centroid are more likely to occlude other clusters,
+    // so they are rendered first.
+    for (std::uint32_t k = 0U; k < 3U; ++k) {
+        meshCentroid[k] = meshArea > 0.0f ? meshCentroid[k] / meshArea : 0.0f;
+    }
+
+    for (Cluster& cluster : clusters) {
+        const float normalLength = std::sqrt(cluster.mNormal[0U] * cluster.mNormal[0U] +
+                                             cluster.mNormal[1U] * cluster.mNormal[1U] +
+                                             cluster.mNormal[2U] * cluster.mNormal[2U]);
+        if (cluster.mArea <= 0.0f || normalLength <= 0.0f) {
+            continue;
+        }
+
+        for (std::uint32_t k = 0U; k < 3U; ++k) {
+            cluster.mSortKey += (cluster.mCentroid[k] / cluster.mArea - meshCentroid[k]) * cluster.mNormal[k] / normalLength;
+        }
+    }
+
+    std::vector<std::uint32_t> clusterOrder(clusterCount);
+    for (std::uint32_t i = 0U; i < clusterCount; ++i) {
+        clusterOrder[i] = i;
+    }
+    std::stable_sort(clusterOrder.begin(),
+                     clusterOrder.end(),
+                     [&clusters](const std::uint32_t a, const std::uint32_t b) {
+        return clusters[a].mSortKey > clusters[b].mSortKey;
+    });
+
+    std::vector<std::uint32_t> optimizedIndices;
+    optimizedIndices.reserve(indices.size());
+    for (const std::uint32_t cluster : clusterOrder) {
+        optimizedIndices.insert(optimizedIndices.end(),
+                                indices.begin() + clusterStarts[cluster] * 3U,
+                                indices.begin() + clusterStarts[cluster + 1U] * 3U);
+    }
+
+    indices.swap(optimizedIndices);
+}
+
+void
+MeshOptimizer::OptimizeVertexFetch(GeometryGenerator::MeshData& meshData) noexcept
+{
+    std::vector<std::uint32_t> vertexRemap(meshData.mVertices.size(), sInvalidVertex);
+    std::vector<GeometryGenerator::Vertex> optimizedVertices;
+    optimizedVertices.reserve(meshData.mVertices.size());
+    for (std::uint32_t& index : meshData.mIndices32) {
+        BRE_ASSERT(index < meshData.mVertices.size());
+        if (vertexRemap[index] == sInvalidVertex) {
+            vertexRemap[index] = static_cast<std::uint32_t>(optimizedVertices.size());
+            optimizedVertices.push_back(meshData.mVertices[index]);
+        }
+        index = vertexRemap[index];
+    }
+
+    meshData.mVertices.swap(optimizedVertices);
+}
+
+MeshOptimizer::Statistics
+MeshOptimizer::AnalyzeVertexCache(const std::vector<std::uint32_t>& indices,
+                                  const std::uint32_t vertexCount,
+                                  const std::uint32_t cacheSize) noexcept
+{
+    BRE_ASSERT(indices.size() % 3U == 0U);
+    BRE_ASSERT(vertexCount > 0U);
+    BRE_ASSERT(cacheSize > 0U);
+
+    std::vector<std::uint32_t> cacheTimeStamps(vertexCount, 0U);
+    std::uint32_t cacheTime{ cacheSize + 1U };
+    Statistics statistics;
+    for (const std::uint32_t index : indices) {
+        BRE_ASSERT(index < vertexCount);
+        statistics.mTransformedVertexCount += AccessVertexCache(index, cacheSize, cacheTimeStamps, cacheTime) ? 1U : 0U;
+    }
+
+    const std::size_t triangleCount = indices.size() / 3U;
+    statistics.mACMR = triangleCount == 0U ? 0.0f : static_cast<float>(statistics.mTransformedVertexCount) / static_cast<float>(triangleCount);
+    statistics.mATVR = static_cast<float>(statistics.mTransformedVertexCount) / static_cast<float>(vertexCount);
+
+    return statistics;
+}
+}
\ No newline at end of file
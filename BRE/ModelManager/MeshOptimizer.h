@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <GeometryGenerator\GeometryGenerator.h>
+
+namespace BRE {
+///
+/// @brief Responsible to reorder mesh triangles and vertices to render them faster.
+///
+/// Meshes are optimized once, when they are imported, and the result is stored in their cache file:
+/// - Triangles are reordered for the post transform vertex cache (Tipsify).
+/// - Triangle clusters are reordered to reduce overdraw, without losing most of the vertex cache efficiency.
+/// - Vertices are reordered in the order triangles use them, for vertex fetch locality.
+///
+/// Vertex cache efficiency is measured with a FIFO cache simulation:
+/// - ACMR (average cache miss ratio): Transformed vertices per triangle. It is between 0.5 and 3.0.
+/// - ATVR (average transform to vertex ratio): Transformed vertices per vertex. It is 1.0 at best.
+///
+class MeshOptimizer {
+public:
+    MeshOptimizer() = delete;
+    ~MeshOptimizer() = delete;
+    MeshOptimizer(const MeshOptimizer&) = delete;
+    const MeshOptimizer& operator=(const MeshOptimizer&) = delete;
+    MeshOptimizer(MeshOptimizer&&) = delete;
+    MeshOptimizer& operator=(MeshOptimizer&&) = delete;
+
+    // Size of the simulated post transform vertex cache, in vertices.
+    static const std::uint32_t sVertexCacheSize{ 16U };
+
+    ///
+    /// @brief Vertex cache statistics
+    ///
+    struct Statistics {
+        std::uint32_t mTransformedVertexCount{ 0U };
+        float mACMR{ 0.0f };
+        float mATVR{ 0.0f };
+    };
+
+    ///
+    /// @brief Optimizes a mesh for vertex cache, overdraw and vertex fetch, in that order.
+    /// @param meshData Mesh data. Its indices must be a triangle list.
+    ///
+    static void OptimizeMesh(GeometryGenerator::MeshData& meshData) noexcept;
+
+    ///
+    /// @brief Reorders triangles for the post transform vertex cache (Tipsify)
+    /// @param indices Triangle list indices
+    /// @param vertexCount Number of vertices
+    /// @param cacheSize Cache size in vertices. Must be greater than zero.
+    ///
+    static void OptimizeVertexCache(std::vector<std::uint32_t>& indices,
+                                    const std::uint32_t vertexCount,
+                                    const std::uint32_t cacheSize = sVertexCacheSize) noexcept;
+
+    ///
+    /// @brief Reorders triangle clusters to reduce overdraw.
+    ///
+    /// Indices must be optimized for the vertex cache first. They are split in clusters where
+    /// the vertex cache restarts, and where the ACMR of a cluster is under threshold times
+    /// the ACMR of its hard cluster. Clusters that face outwards are rendered first, so they occlude the rest.
+    ///
+    /// @param vertices Vertices
+    /// @param indices Triangle list indices
+    /// @param threshold Maximum ACMR increase allowed. It must be greater or equal than 1.0.
+    /// 1.0 keeps the vertex cache efficiency, and greater values get more and smaller clusters.
+    ///
+    static void OptimizeOverdraw(const std::vector<GeometryGenerator::Vertex>& vertices,
+                                 std::vector<std::uint32_t>& indices,
+                                 const float threshold = 1.05f) noexcept;
+
+    ///
+    /// @brief Reorders vertices in the order that indices use them.
+    ///
+    /// Vertices that no index uses are removed.
+    ///
+    /// @param meshData Mesh data
+    ///
+    static void OptimizeVertexFetch(GeometryGenerator::MeshData& meshData) noexcept;
+
+    ///
+    /// @brief Computes vertex cache statistics with a FIFO cache simulation
+    /// @param indices Triangle list indices
+    /// @param vertexCount Number of vertices. Must be greater than zero.
+    /// @param cacheSize Cache size in vertices. Must be greater than zero.
+    /// @return Statistics
+    ///
+    static Statistics AnalyzeVertexCache(const std::vector<std::uint32_t>& indices,
+                                         const std::uint32_t vertexCount,
+                                         const std::uint32_t cacheSize = sVertexCacheSize) noexcept;
+};
+}
\ No newline at end of file
@@ -0,0 +1,366 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Utils\DebugUtils.h>
+
+using namespace DirectX;
+
+namespace BRE {
+namespace {
+///
+/// @brief Computes the bounding sphere of meshlet vertices.
+///
+/// Its center is the center of the bounding box of the vertices.
+///
+/// @param vertices Vertices
+/// @param meshletVertices Meshlet vertex indices. It must not be empty.
+/// @param meshlet Output meshlet
+///
+void
+ComputeBoundingSphere(const std::vector<GeometryGenerator::Vertex>& vertices,
+                      const std::vector<std::uint32_t>& meshletVertices,
+                      MeshletBuilder::Meshlet& meshlet) noexcept
+{
+    BRE_ASSERT(meshletVertices.empty() == false);
+
+    XMFLOAT3 boundsMin = vertices[meshletVertices[0U]].mPosition;
+    XMFLOAT3 boundsMax = boundsMin;
+    for (const std::uint32_t vertex : meshletVertices) {
+        const XMFLOAT3& position = vertices[vertex].mPosition;
+        boundsMin.x = std::min(boundsMin.x, position.x);
+        boundsMin.y = std::min(boundsMin.y, position.y);
+        boundsMin.z = std::min(boundsMin.z, position.z);
+        boundsMax.x = std::max(boundsMax.x, position.x);
+        boundsMax.y = std::max(boundsMax.y, position.y);
+        boundsMax.z = std::max(boundsMax.z, position.z);
+    }
+
+    meshlet.mCenter = XMFLOAT3((boundsMin.x + boundsMax.x) * 0.5f,
+                               (boundsMin.y + boundsMax.y) * 0.5f,
+                               (boundsMin.z + boundsMax.z) * 0.5f);
+
+    float squaredRadius{ 0.0f };
+    for (const std::uint32_t vertex : meshletVertices) {
+        const XMFLOAT3& position = vertices[vertex].mPosition;
+        const float x = position.x - meshlet.mCenter.x;
+        const float y = position.y - meshlet.mCenter.y;
+        const float z = position.z - meshlet.mCenter.z;
+        squaredRadius = std::max(squaredRadius, x * x + y * y + z * z);
+    }
+
+    meshlet.mRadius = std::sqrt(squaredRadius);
+}
+
+///
+/// @brief Computes the normal cone of meshlet triangles.
+///
+/// Triangle normals are computed from positions, with clockwise front faces.
+/// The cone axis is the normalized average of triangle normals, and the cutoff is
+/// computed from the triangle normal that is farther from the axis. If some triangle normal
+/// is not in the hemisphere of the axis, then the cutoff is 1, and the meshlet is never backface culled.
+///
+/// @param vertices Vertices
+/// @param indices Triangle list indices
+/// @param meshlet Meshlet. Its index range is used, and its cone is computed.
+///
+void
+ComputeNormalCone(const std::vector<GeometryGenerator::Vertex>& vertices,
+                  const std::vector<std::uint32_t>& indices,
+                  MeshletBuilder::Meshlet& meshlet) noexcept
+{
+    std::vector<XMFLOAT3> normals;
+    normals.reserve(meshlet.mIndexCount / 3U);
+
+    XMFLOAT3 axis(0.0f, 0.0f, 0.0f);
+    for (std::uint32_t i = meshlet.mFirstIndex; i < meshlet.mFirstIndex + meshlet.mIndexCount; i += 3U) {
+        const XMFLOAT3& position0 = vertices[indices[i]].mPosition;
+        const XMFLOAT3& position1 = vertices[indices[i + 1U]].mPosition;
+        const XMFLOAT3& position2 = vertices[indices[i + 2U]].mPosition;
+        const XMFLOAT3 edge1(position1.x - position0.x, position1.y - position0.y, position1.z - position0.z);
+        const XMFLOAT3 edge2(position2.x - position0.x, position2.y - position0.y, position2.z - position0.z);
+        const XMFLOAT3 normal(edge1.y * edge2.z - edge1.z * edge2.y,
+                              edge1.z * edge2.x - edge1.x * edge2.z,
+                              edge1.x * edge2.y - edge1.y * edge2.x);
+
+        // Degenerate triangles are not rasterized
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        if (length <= 0.0f) {
+            continue;
+        }
+
+        normals.push_back(XMFLOAT3(normal.x / length, normal.y / length, normal.z / length));
+        axis.x += normals.back().x;
+        axis.y += normals.back().y;
+        axis.z += normals.back().z;
+    }
+
+    const float axisLength = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    if (axisLength <= 0.0f) {
+        return;
+    }
+
+    meshlet.mConeAxis = XMFLOAT3(axis.x / axisLength, axis.y / axisLength, axis.z / axisLength);
+
+    float minDot{ 1.0f };
+    for (const XMFLOAT3& normal : normals) {
+        minDot = std::min(minDot,
+                          normal.x * meshlet.mConeAxis.x + normal.y * meshlet.mConeAxis.y + normal.z * meshlet.mConeAxis.z);
+    }
+
+    // The cutoff is the sine of the largest angle between the axis and a triangle normal
+    meshlet.mConeCutoff = minDot <= 0.0f ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+}
+
+///
+/// @brief Computes the centroid and the unit normal of each triangle
+/// @param vertices Vertices
+/// @param indices Triangle list indices
+/// @param centroids Output centroids
+/// @param normals Output normals, with clockwise front faces. They are zero for degenerate triangles.
+///
+void
+ComputeTriangleCentroidsAndNormals(const std::vector<GeometryGenerator::Vertex>& vertices,
+                                   const std::vector<std::uint32_t>& indices,
+                                   std::vector<XMFLOAT3>& centroids,
+                                   std::vector<XMFLOAT3>& normals) noexcept
+{
+    const std::size_t triangleCount = indices.size() / 3U;
+    centroids.resize(triangleCount);
+    normals.resize(triangleCount);
+    for (std::size_t i = 0U; i < triangleCount; ++i) {
+        const XMFLOAT3& position0 = vertices[indices[i * 3U]].mPosition;
+        const XMFLOAT3& position1 = vertices[indices[i * 3U + 1U]].mPosition;
+        const XMFLOAT3& position2 = vertices[indices[i * 3U + 2U]].mPosition;
+        centroids[i] = XMFLOAT3((position0.x + position1.x + position2.x) / 3.0f,
+                                (position0.y + position1.y + position2.y) / 3.0f,
+                                (position0.z + position1.z + position2.z) / 3.0f);
+
+        const XMFLOAT3 edge1(position1.x - position0.x, position1.y - position0.y, position1.z - position0.z);
+        const XMFLOAT3 edge2(position2.x - position0.x, position2.y - position0.y, position2.z - position0.z);
+        const XMFLOAT3 normal(edge1.y * edge2.z - edge1.z * edge2.y,
+                              edge1.z * edge2.x - edge1.x * edge2.z,
+                              edge1.x * edge2.y - edge1.y * edge2.x);
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        normals[i] = length > 0.0f ?
+            XMFLOAT3(normal.x / length, normal.y / length, normal.z / length) :
+            XMFLOAT3(0.0f, 0.0f, 0.0f);
+    }
+}
+
+///
+/// @brief Checks if a triangle does not share vertices with other triangles
+/// @param indices Triangle list indices
+/// @param triangle Triangle
+/// @param adjacencyOffsets Offset of the adjacent triangles of each vertex (see BuildVertexAdjacency)
+/// @return True if the triangle does not share vertices. Otherwise, false.
+///
+bool
+IsTriangleIsolated(const std::vector<std::uint32_t>& indices,
+                   const std::uint32_t triangle,
+                   const std::vector<std::uint32_t>& adjacencyOffsets) noexcept
+{
+    for (std::uint32_t i = triangle * 3U; i < triangle * 3U + 3U; ++i) {
+        const std::uint32_t vertex = indices[i];
+        // Degenerate triangles are adjacent to their vertices more than once
+        for (std::uint32_t j = i + 1U; j < triangle * 3U + 3U; ++j) {
+            if (indices[j] == vertex) {
+                return false;
+            }
+        }
+
+        if (adjacencyOffsets[vertex + 1U] - adjacencyOffsets[vertex] != 1U) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief Builds the triangles adjacent to each vertex
+/// @param vertexCount Number of vertices
+/// @param indices Triangle list indices
+/// @param adjacencyOffsets Output offset of the adjacent triangles of each vertex. There is an extra offset at the end.
+/// @param adjacentTriangles Output adjacent triangles
+///
+void
+BuildVertexAdjacency(const std::size_t vertexCount,
+                     const std::vector<std::uint32_t>& indices,
+                     std::vector<std::uint32_t>& adjacencyOffsets,
+                     std::vector<std::uint32_t>& adjacentTriangles) noexcept
+{
+    adjacencyOffsets.assign(vertexCount + 1U, 0U);
+    for (const std::uint32_t index : indices) {
+        ++adjacencyOffsets[index + 1U];
+    }
+
+    for (std::size_t i = 0U; i < vertexCount; ++i) {
+        adjacencyOffsets[i + 1U] += adjacencyOffsets[i];
+    }
+
+    std::vector<std::uint32_t> nextOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1U);
+    adjacentTriangles.resize(indices.size());
+    for (std::size_t i = 0U; i < indices.size(); ++i) {
+        adjacentTriangles[nextOffsets[indices[i]]++] = static_cast<std::uint32_t>(i / 3U);
+    }
+}
+}
+
+void
+MeshletBuilder::BuildMeshlets(const std::vector<GeometryGenerator::Vertex>& vertices,
+                              std::vector<std::uint32_t>& indices,
+                              std::vector<Meshlet>& meshlets) noexcept
+{
+    BRE_ASSERT(indices.size() % 3U == 0U);
+
+    meshlets.clear();
+    if (indices.empty()) {
+        return;
+    }
+
+    const std::uint32_t triangleCount = static_cast<std::uint32_t>(indices.size() / 3U);
+    std::vector<XMFLOAT3> triangleCentroids;
+    std::vector<XMFLOAT3> triangleNormals;
+    ComputeTriangleCentroidsAndNormals(vertices, indices, triangleCentroids, triangleNormals);
+
+    std::vector<std::uint32_t> adjacencyOffsets;
+    std::vector<std::uint32_t> adjacentTriangles;
+    BuildVertexAdjacency(vertices.size(), indices, adjacencyOffsets, adjacentTriangles);
+
+    // A vertex is in the current meshlet, and a triangle is a candidate of the current meshlet,
+    // if their stamp is the meshlet count + 1.
+    std::vector<std::uint32_t> vertexStamps(vertices.size(), 0U);
+    std::vector<std::uint32_t> candidateStamps(triangleCount, 0U);
+    std::vector<bool> isTriangleEmitted(triangleCount, false);
+    std::vector<std::uint32_t> meshletVertices;
+    meshletVertices.reserve(sMaxVertexCount);
+    std::vector<std::uint32_t> candidates;
+
+    std::vector<std::uint32_t> meshletIndices;
+    meshletIndices.reserve(indices.size());
+
+    std::uint32_t seedTriangle{ 0U };
+    while (meshletIndices.size() < indices.size()) {
+        // Meshlets are seeded in the optimized triangle order
+        while (isTriangleEmitted[seedTriangle]) {
+            ++seedTriangle;
+        }
+
+        const std::uint32_t stamp = static_cast<std::uint32_t>(meshlets.size()) + 1U;
+        Meshlet meshlet;
+        meshlet.mFirstIndex = static_cast<std::uint32_t>(meshletIndices.size());
+        meshletVertices.clear();
+        candidates.clear();
+        XMFLOAT3 positionSum(0.0f, 0.0f, 0.0f);
+        XMFLOAT3 normalSum(0.0f, 0.0f, 0.0f);
+
+        std::uint32_t triangle = seedTriangle;
+        for (;;) {
+            // Emit the triangle, and add its adjacent triangles to the candidates.
+            isTriangleEmitted[triangle] = true;
+            for (std::uint32_t i = triangle * 3U; i < triangle * 3U + 3U; ++i) {
+                const std::uint32_t vertex = indices[i];
+                meshletIndices.push_back(vertex);
+                if (vertexStamps[vertex] == stamp) {
+                    continue;
+                }
+
+                vertexStamps[vertex] = stamp;
+                meshletVertices.push_back(vertex);
+                positionSum.x += vertices[vertex].mPosition.x;
+                positionSum.y += vertices[vertex].mPosition.y;
+                positionSum.z += vertices[vertex].mPosition.z;
+                for (std::uint32_t j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex + 1U]; ++j) {
+                    const std::uint32_t adjacentTriangle = adjacentTriangles[j];
+                    if (isTriangleEmitted[adjacentTriangle] == false && candidateStamps[adjacentTriangle] != stamp) {
+                        candidateStamps[adjacentTriangle] = stamp;
+                        candidates.push_back(adjacentTriangle);
+                    }
+                }
+            }
+            normalSum.x += triangleNormals[triangle].x;
+            normalSum.y += triangleNormals[triangle].y;
+            normalSum.z += triangleNormals[triangle].z;
+            meshlet.mIndexCount += 3U;
+
+            if (meshlet.mIndexCount / 3U == sMaxTriangleCount) {
+                break;
+            }
+
+            // The next triangle is the candidate that adds less vertices. Ties are broken by
+            // the distance to the meshlet center, scaled by the deviation from the meshlet normal.
+            const float inverseVertexCount = 1.0f / meshletVertices.size();
+            const XMFLOAT3 center(positionSum.x * inverseVertexCount,
+                                  positionSum.y * inverseVertexCount,
+                                  positionSum.z * inverseVertexCount);
+            const float normalSumLength = std::sqrt(normalSum.x * normalSum.x + normalSum.y * normalSum.y + normalSum.z * normalSum.z);
+            const float inverseNormalSumLength = normalSumLength > 0.0f ? 1.0f / normalSumLength : 0.0f;
+
+            std::uint32_t bestTriangle = triangleCount;
+            std::uint32_t bestNewVertexCount{ 4U };
+            float bestScore{ 0.0f };
+            std::size_t candidateCount{ 0U };
+            for (const std::uint32_t candidate : candidates) {
+                if (isTriangleEmitted[candidate]) {
+                    continue;
+                }
+                candidates[candidateCount++] = candidate;
+
+                std::uint32_t newVertexCount{ 0U };
+                for (std::uint32_t i = candidate * 3U; i < candidate * 3U + 3U; ++i) {
+                    newVertexCount += vertexStamps[indices[i]] == stamp ? 0U : 1U;
+                }
+
+                // The new vertex count is an upper bound, because degenerate triangles can repeat a vertex.
+                if (meshletVertices.size() + newVertexCount > sMaxVertexCount ||
+                    newVertexCount > bestNewVertexCount) {
+                    continue;
+                }
+
+                const XMFLOAT3& centroid = triangleCentroids[candidate];
+                const XMFLOAT3& normal = triangleNormals[candidate];
+                const float x = centroid.x - center.x;
+                const float y = centroid.y - center.y;
+                const float z = centroid.z - center.z;
+                const float normalDot = (normal.x * normalSum.x + normal.y * normalSum.y + normal.z * normalSum.z) * inverseNormalSumLength;
+                const float score = (x * x + y * y + z * z) * (2.0f - normalDot);
+                if (newVertexCount < bestNewVertexCount || score < bestScore) {
+                    bestTriangle = candidate;
+                    bestNewVertexCount = newVertexCount;
+                    bestScore = score;
+                }
+            }
+            candidates.resize(candidateCount);
+
+            // If there are no adjacent triangles, and the next triangle in the optimized order
+            // does not share vertices, then the meshlet continues with it, so triangle soups
+            // do not get a meshlet per triangle.
+            if (candidates.empty()) {
+                while (seedTriangle < triangleCount && isTriangleEmitted[seedTriangle]) {
+                    ++seedTriangle;
+                }
+
+                if (seedTriangle < triangleCount &&
+                    meshletVertices.size() + 3U <= sMaxVertexCount &&
+                    IsTriangleIsolated(indices, seedTriangle, adjacencyOffsets)) {
+                    bestTriangle = seedTriangle;
+                }
+            }
+
+            if (bestTriangle == triangleCount) {
+                break;
+            }
+
+            triangle = bestTriangle;
+        }
+
+        ComputeBoundingSphere(vertices, meshletVertices, meshlet);
+        ComputeNormalCone(vertices, meshletIndices, meshlet);
+        meshlets.push_back(meshlet);
+    }
+
+    indices.swap(meshletIndices);
+}
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <DirectXMath.h>
+#include <vector>
+
+#include <GeometryGenerator\GeometryGenerator.h>
+
+namespace BRE {
+///
+/// @brief Responsible to split meshes in meshlets (clusters of triangles) that can be culled separately.
+///
+/// Meshlets are contiguous ranges of the mesh index buffer, so they are drawn with the same
+/// index buffer, and adjacent visible meshlets are drawn together (see MeshletCuller).
+/// Meshlets grow from a seed triangle through adjacent triangles, preferring triangles that
+/// add less vertices and that are near the meshlet and aligned with its normal, so meshlets are
+/// compact and their normal cones are narrow. Seeds follow the optimized triangle order (see MeshOptimizer).
+///
+class MeshletBuilder {
+public:
+    MeshletBuilder() = delete;
+    ~MeshletBuilder() = delete;
+    MeshletBuilder(const MeshletBuilder&) = delete;
+    const MeshletBuilder& operator=(const MeshletBuilder&) = delete;
+    MeshletBuilder(MeshletBuilder&&) = delete;
+    MeshletBuilder& operator=(MeshletBuilder&&) = delete;
+
+    static const std::uint32_t sMaxVertexCount{ 64U };
+    static const std::uint32_t sMaxTriangleCount{ 124U };
+
+    ///
+    /// @brief Meshlet. Bounds are in model space.
+    ///
+    struct Meshlet {
+        std::uint32_t mFirstIndex{ 0U };
+        std::uint32_t mIndexCount{ 0U };
+
+        // Bounding sphere
+        DirectX::XMFLOAT3 mCenter{ 0.0f, 0.0f, 0.0f };
+        float mRadius{ 0.0f };
+
+        // Normal cone of the triangles (front faces). The cutoff is the sine
+        // of the cone half angle, and it is 1 if the cone cannot be backface culled.
+        DirectX::XMFLOAT3 mConeAxis{ 0.0f, 0.0f, 1.0f };
+        float mConeCutoff{ 1.0f };
+    };
+
+    ///
+    /// @brief Builds meshlets.
+    ///
+    /// Triangles are reordered, so each meshlet is a contiguous range of indices.
+    ///
+    /// @param vertices Vertices
+    /// @param indices Triangle list indices. They are reordered in meshlet order.
+    /// @param meshlets Output meshlets. They cover all the indices in order.
+    ///
+    static void BuildMeshlets(const std::vector<GeometryGenerator::Vertex>& vertices,
+                              std::vector<std::uint32_t>& indices,
+                              std::vector<Meshlet>& meshlets) noexcept;
+};
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "MeshletCuller.h"
+
+#include <cmath>
+
+using namespace DirectX;
+
+namespace BRE {
+namespace {
+///
+/// @brief Plane. A point is inside if dot(normal, point) + distance >= 0.
+///
+struct Plane {
+    XMFLOAT3 mNormal{ 0.0f, 0.0f, 0.0f };
+    float mDistance{ 0.0f };
+    float mNormalLength{ 0.0f };
+};
+
+///
+/// @brief Multiplies two matrices
+/// @param a First matrix
+/// @param b Second matrix
+/// @return a * b
+///
+XMFLOAT4X4
+Multiply(const XMFLOAT4X4& a,
+         const XMFLOAT4X4& b) noexcept
+{
+    XMFLOAT4X4 result;
+    for (std::uint32_t i = 0U; i < 4U; ++i) {
+        for (std::uint32_t j = 0U; j < 4U; ++j) {
+            result.m[i][j] = a.m[i][0U] * b.m[0U][j] +
+                a.m[i][1U] * b.m[1U][j] +
+                a.m[i][2U] * b.m[2U][j] +
+                a.m[i][3U] * b.m[3U][j];
+        }
+    }
+
+    return result;
+}
+
+///
+/// @brief Extracts the frustum planes of a world view projection matrix (Gribb/Hartmann).
+///
+/// Planes are in model space, and they are not normalized.
+///
+/// @param worldViewProjectionMatrix World view projection matrix (not transposed)
+/// @param planes Output planes: left, right, bottom, top, near and far.
+///
+void
+ExtractFrustumPlanes(const XMFLOAT4X4& worldViewProjectionMatrix,
+                     Plane planes[6U]) noexcept
+{
+    const XMFLOAT4X4& m = worldViewProjectionMatrix;
+
+    // Clip space coordinates are inside if -w <= x <= w, -w <= y <= w and 0 <= z <= w.
+    const float signs[6U]{ 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };
+    const std::uint32_t columns[6U]{ 0U, 0U, 1U, 1U, 2U, 2U };
+    for (std::uint32_t i = 0U; i < 6U; ++i) {
+        const std::uint32_t column = columns[i];
+        const float sign = signs[i];
+
+        // The near plane is z >= 0, so w is not added.
+        const float w = i == 4U ? 0.0f : 1.0f;
+
+        Plane& plane = planes[i];
+        plane.mNormal = XMFLOAT3(m.m[0U][3U] * w + m.m[0U][column] * sign,
+                                 m.m[1U][3U] * w + m.m[1U][column] * sign,
+                                 m.m[2U][3U] * w + m.m[2U][column] * sign);
+        plane.mDistance = m.m[3U][3U] * w + m.m[3U][column] * sign;
+        plane.mNormalLength = std::sqrt(plane.mNormal.x * plane.mNormal.x +
+                                        plane.mNormal.y * plane.mNormal.y +
+                                        plane.mNormal.z * plane.mNormal.z);
+    }
+}
+
+///
+/// @brief Transforms a world space point to the model space of an affine world matrix
+/// @param worldMatrix World matrix (not transposed)
+/// @param point World space point
+/// @param modelSpacePoint Output model space point
+/// @return True if the world matrix keeps triangles winding (its determinant is positive). Otherwise, false.
+///
+bool
+TransformToModelSpace(const XMFLOAT4X4& worldMatrix,
+                      const XMFLOAT3& point,
+                      XMFLOAT3& modelSpacePoint) noexcept
+{
+    const XMFLOAT4X4& m = worldMatrix;
+
+    // Cofactors of the upper 3x3 matrix
+    const float c00 = m._22 * m._33 - m._23 * m._32;
+    const float c01 = m._23 * m._31 - m._21 * m._33;
+    const float c02 = m._21 * m._32 - m._22 * m._31;
+    const float determinant = m._11 * c00 + m._12 * c01 + m._13 * c02;
+    if (determinant <= 0.0f) {
+        return false;
+    }
+
+    const float c10 = m._13 * m._32 - m._12 * m._33;
+    const float c11 = m._11 * m._33 - m._13 * m._31;
+    const float c12 = m._12 * m._31 - m._11 * m._32;
+    const float c20 = m._12 * m._23 - m._13 * m._22;
+    const float c21 = m._13 * m._21 - m._11 * m._23;
+    const float c22 = m._11 * m._22 - m._12 * m._21;
+
+    // Row vectors: point = modelSpacePoint * upper 3x3 matrix + translation
+    const float x = point.x - m._41;
+    const float y = point.y - m._42;
+    const float z = point.z - m._43;
+    const float inverseDeterminant = 1.0f / determinant;
+    modelSpacePoint = XMFLOAT3((x * c00 + y * c01 + z * c02) * inverseDeterminant,
+                               (x * c10 + y * c11 + z * c12) * inverseDeterminant,
+                               (x * c20 + y * c21 + z * c22) * inverseDeterminant);
+
+    return true;
+}
+
+///
+/// @brief Checks if a meshlet is visible
+/// @param meshlet Meshlet
+/// @param planes Model space frustum planes
+/// @param isConeCullingEnabled True if back faces can be culled. Otherwise, false.
+/// @param eyeModelPosition Eye position in model space
+/// @return True if the meshlet is visible. Otherwise, false.
+///
+bool
+IsVisible(const MeshletBuilder::Meshlet& meshlet,
+          const Plane planes[6U],
+          const bool isConeCullingEnabled,
+          const XMFLOAT3& eyeModelPosition) noexcept
+{
+    const XMFLOAT3& center = meshlet.mCenter;
+    for (std::uint32_t i = 0U; i < 6U; ++i) {
+        const Plane& plane = planes[i];
+        const float distance = plane.mNormal.x * center.x +
+            plane.mNormal.y * center.y +
+            plane.mNormal.z * center.z +
+            plane.mDistance;
+        if (distance < -meshlet.mRadius * plane.mNormalLength) {
+            return false;
+        }
+    }
+
+    if (isConeCullingEnabled == false) {
+        return true;
+    }
+
+    // All triangles are back faces if the eye is in the back cone of the bounding sphere.
+    const XMFLOAT3 eyeToCenter(center.x - eyeModelPosition.x,
+                               center.y - eyeModelPosition.y,
+                               center.z - eyeModelPosition.z);
+    const float eyeToCenterLength = std::sqrt(eyeToCenter.x * eyeToCenter.x +
+                                              eyeToCenter.y * eyeToCenter.y +
+                                              eyeToCenter.z * eyeToCenter.z);
+    const float dot = eyeToCenter.x * meshlet.mConeAxis.x +
+        eyeToCenter.y * meshlet.mConeAxis.y +
+        eyeToCenter.z * meshlet.mConeAxis.z;
+
+    return dot < meshlet.mConeCutoff * eyeToCenterLength + meshlet.mRadius;
+}
+}
+
+void
+MeshletCuller::CullMeshlets(const std::vector<MeshletBuilder::Meshlet>& meshlets,
+                            const XMFLOAT4X4& worldMatrix,
+                            const XMFLOAT4X4& viewProjectionMatrix,
+                            const XMFLOAT3& eyeWorldPosition,
+                            std::vector<IndexRange>& visibleIndexRanges) noexcept
+{
+    visibleIndexRanges.clear();
+
+    Plane planes[6U];
+    ExtractFrustumPlanes(Multiply(worldMatrix, viewProjectionMatrix), planes);
+
+    XMFLOAT3 eyeModelPosition;
+    const bool isConeCullingEnabled = TransformToModelSpace(worldMatrix, eyeWorldPosition, eyeModelPosition);
+
+    for (const MeshletBuilder::Meshlet& meshlet : meshlets) {
+        if (IsVisible(meshlet, planes, isConeCullingEnabled, eyeModelPosition) == false) {
+            continue;
+        }
+
+        if (visibleIndexRanges.empty() == false &&
+            visibleIndexRanges.back().mFirstIndex + visibleIndexRanges.back().mIndexCount == meshlet.mFirstIndex)
+        {
+            visibleIndexRanges.back().mIndexCount += meshlet.mIndexCount;
+        } else {
+            IndexRange indexRange;
+            indexRange.mFirstIndex = meshlet.mFirstIndex;
+            indexRange.mIndexCount = meshlet.mIndexCount;
+            visibleIndexRanges.push_back(indexRange);
+        }
+    }
+}
+}
\ No newline at end of file
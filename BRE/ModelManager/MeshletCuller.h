@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <DirectXMath.h>
+#include <vector>
+
+#include <ModelManager\MeshletBuilder.h>
+
+namespace BRE {
+///
+/// @brief Responsible to cull meshlets in the CPU.
+///
+/// Meshlets are culled if their bounding sphere is outside the view frustum, or if
+/// their normal cone proves all their triangles are back faces.
+/// Visible meshlets are compacted into index ranges, and adjacent ranges are merged,
+/// so each range is drawn with a single DrawIndexedInstanced call.
+///
+class MeshletCuller {
+public:
+    MeshletCuller() = delete;
+    ~MeshletCuller() = delete;
+    MeshletCuller(const MeshletCuller&) = delete;
+    const MeshletCuller& operator=(const MeshletCuller&) = delete;
+    MeshletCuller(MeshletCuller&&) = delete;
+    MeshletCuller& operator=(MeshletCuller&&) = delete;
+
+    ///
+    /// @brief Range of indices to draw
+    ///
+    struct IndexRange {
+        std::uint32_t mFirstIndex{ 0U };
+        std::uint32_t mIndexCount{ 0U };
+    };
+
+    ///
+    /// @brief Culls meshlets.
+    ///
+    /// Culling is done in model space, so bounds are not transformed.
+    /// Back faces are not culled if the world matrix mirrors the mesh, because it changes triangles winding.
+    ///
+    /// @param meshlets Meshlets to cull. They must be sorted by first index.
+    /// @param worldMatrix World matrix (not transposed). It must be affine.
+    /// @param viewProjectionMatrix View projection matrix (not transposed). Projection must be perspective.
+    /// @param eyeWorldPosition Eye position in world space
+    /// @param visibleIndexRanges Output index ranges of visible meshlets
+    ///
+    static void CullMeshlets(const std::vector<MeshletBuilder::Meshlet>& meshlets,
+                             const DirectX::XMFLOAT4X4& worldMatrix,
+                             const DirectX::XMFLOAT4X4& viewProjectionMatrix,
+                             const DirectX::XMFLOAT3& eyeWorldPosition,
+                             std::vector<IndexRange>& visibleIndexRanges) noexcept;
+};
+}
\ No newline at end of file
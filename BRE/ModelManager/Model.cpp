@@ -1,45 +1,121 @@
 #include "Model.h"
 
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
-#include <assimp/scene.h>
+#include <string>
 
+#include <ModelManager\MeshCache.h>
+#include <ModelManager\MeshOptimizer.h>
+#include <ModelManager\ModelImporter.h>
 #include <Utils/DebugUtils.h>
+#include <Utils\HashUtils.h>
+#include <Utils\MemoryMappedFile.h>
 
 namespace BRE {
-Model::Model(const char* modelFilename,
-             ID3D12GraphicsCommandList& commandList,
-             ID3D12Resource* &uploadVertexBuffer,
-             ID3D12Resource* &uploadIndexBuffer)
+Model::Model(const char* modelFilename)
 {
     BRE_ASSERT(modelFilename != nullptr);
-    const std::string filePath(modelFilename);
 
-    Assimp::Importer importer;
-    const std::uint32_t flags{ aiProcessPreset_TargetRealtime_Fast | aiProcess_ConvertToLeftHanded };
-    const aiScene* scene{ importer.ReadFile(filePath.c_str(), flags) };
-    BRE_CHECK_MSG(scene != nullptr, StringUtils::AnsiToWideString(importer.GetErrorString()).c_str());
+    std::uint64_t sourceContentHash{ 0UL };
+    {
+        MemoryMappedFile sourceFile;
+        const std::wstring errorMsg =
+            L"Model file could not be opened: " + StringUtils::AnsiToWideString(modelFilename);
+        BRE_CHECK_MSG(sourceFile.Open(modelFilename), errorMsg.c_str());
+        sourceContentHash = HashUtils::ComputeHash(sourceFile.GetData(), sourceFile.GetSize());
+    }
+
+    const std::string cacheFilePath = MeshCache::GetCacheFilePath(sourceContentHash);
+    if (LoadMeshCacheFile(cacheFilePath.c_str(), sourceContentHash)) {
+        return;
+    }
+
+    // First time we see this model, so we import it, optimize it and generate its cache file.
+    std::vector<GeometryGenerator::MeshData> meshDataList;
+    ModelImporter::ImportModel(modelFilename, meshDataList);
+    OptimizeMeshes(modelFilename, meshDataList);
+
+    mMeshes.reserve(meshDataList.size());
+    for (const GeometryGenerator::MeshData& meshData : meshDataList) {
+        mMeshes.push_back(Mesh(meshData));
+    }
+
+    if (MeshCache::WriteCacheFile(cacheFilePath.c_str(), sourceContentHash, meshDataList) == false) {
+        const std::wstring warningMsg =
+            L"Mesh cache file could not be written: " + StringUtils::AnsiToWideString(cacheFilePath) + L"\n";
+        BRE_LOG_MSG(warningMsg.c_str());
+    }
+}
+
+Model::Model(const GeometryGenerator::MeshData& meshData)
+{
+    mMeshes.push_back(Mesh(meshData));
+}
+
+void
+Model::OptimizeMeshes(const char* modelFilename,
+                      std::vector<GeometryGenerator::MeshData>& meshDataList) noexcept
+{
+    BRE_ASSERT(modelFilename != nullptr);
 
-    BRE_ASSERT(scene->HasMeshes());
+    // Vertex cache statistics of all the meshes, before and after optimization.
+    std::uint64_t triangleCount{ 0UL };
+    std::uint64_t vertexCount{ 0UL };
+    std::uint64_t optimizedVertexCount{ 0UL };
+    std::uint64_t transformedVertexCount{ 0UL };
+    std::uint64_t optimizedTransformedVertexCount{ 0UL };
+    for (GeometryGenerator::MeshData& meshData : meshDataList) {
+        triangleCount += meshData.mIndices32.size() / 3U;
+        vertexCount += meshData.mVertices.size();
+        transformedVertexCount +=
+            MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32,
+                                              static_cast<std::uint32_t>(meshData.mVertices.size())).mTransformedVertexCount;
 
-    for (std::uint32_t i = 0U; i < scene->mNumMeshes; ++i) {
-        aiMesh* mesh{ scene->mMeshes[i] };
-        BRE_ASSERT(mesh != nullptr);
-        mMeshes.push_back(Mesh(*mesh,
-                               commandList,
-                               uploadVertexBuffer,
-                               uploadIndexBuffer));
+        MeshOptimizer::OptimizeMesh(meshData);
+
+        optimizedVertexCount += meshData.mVertices.size();
+        optimizedTransformedVertexCount +=
+            MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32,
+                                              static_cast<std::uint32_t>(meshData.mVertices.size())).mTransformedVertexCount;
     }
+
+    if (triangleCount == 0UL || optimizedVertexCount == 0UL) {
+        return;
+    }
+
+    const std::wstring statisticsMsg =
+        L"Mesh optimization: " + StringUtils::AnsiToWideString(modelFilename) +
+        L": ACMR " + std::to_wstring(static_cast<double>(transformedVertexCount) / triangleCount) +
+        L" -> " + std::to_wstring(static_cast<double>(optimizedTransformedVertexCount) / triangleCount) +
+        L", ATVR " + std::to_wstring(static_cast<double>(transformedVertexCount) / vertexCount) +
+        L" -> " + std::to_wstring(static_cast<double>(optimizedTransformedVertexCount) / optimizedVertexCount) + L"\n";
+    BRE_LOG_MSG(statisticsMsg.c_str());
 }
 
-Model::Model(const GeometryGenerator::MeshData& meshData,
-             ID3D12GraphicsCommandList& commandList,
-             ID3D12Resource* &uploadVertexBuffer,
-             ID3D12Resource* &uploadIndexBuffer)
+bool
+Model::LoadMeshCacheFile(const char* cacheFilePath,
+                         const std::uint64_t sourceContentHash) noexcept
 {
-    mMeshes.push_back(Mesh(meshData,
-                           commandList,
-                           uploadVertexBuffer,
-                           uploadIndexBuffer));
+    BRE_ASSERT(cacheFilePath != nullptr);
+
+    MemoryMappedFile cacheFile;
+    if (cacheFile.Open(cacheFilePath) == false) {
+        return false;
+    }
+
+    std::vector<MeshCache::MeshView> meshViews;
+    if (MeshCache::ReadCacheFile(cacheFile.GetData(),
+                                 cacheFile.GetSize(),
+                                 sourceContentHash,
+                                 meshViews) == false) {
+        return false;
+    }
+
+    // Mesh data is copied to upload memory when meshes are created,
+    // so the cache file can be unmapped after this.
+    mMeshes.reserve(meshViews.size());
+    for (const MeshCache::MeshView& meshView : meshViews) {
+        mMeshes.push_back(Mesh(meshView));
+    }
+
+    return true;
 }
 }
\ No newline at end of file
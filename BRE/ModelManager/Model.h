@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include <GeometryGenerator/GeometryGenerator.h>
@@ -9,6 +10,9 @@ namespace BRE {
 ///
 /// @brief Represents a model that can be loaded from a file
 ///
+/// Meshes buffers are uploaded through StagingRingBuffer.
+/// Model files are imported and optimized once, and then they are loaded from a mesh cache file (see MeshCache).
+///
 class Model {
 public:
     ~Model() = default;
@@ -20,42 +24,14 @@ public:
     ///
     /// @brief Model constructor
     /// @param modelFilename Model filename. Must not be nullptr.
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
     ///
-    explicit Model(const char* modelFilename,
-                   ID3D12GraphicsCommandList& commandList,
-                   ID3D12Resource* &ploadVertexBuffer,
-                   ID3D12Resource* &uploadIndexBuffer);
+    explicit Model(const char* modelFilename);
 
     ///
     /// @brief Model constructor
     /// @param meshData Mesh data.
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
     ///
-    explicit Model(const GeometryGenerator::MeshData& meshData,
-                   ID3D12GraphicsCommandList& commandList,
-                   ID3D12Resource* &uploadVertexBuffer,
-                   ID3D12Resource* &uploadIndexBuffer);
+    explicit Model(const GeometryGenerator::MeshData& meshData);
 
     ///
     /// @brief Checks if there are meshes or not
@@ -76,6 +52,25 @@ public:
     }
 
 private:
+    ///
+    /// @brief Loads meshes from a mesh cache file
+    /// @param cacheFilePath Cache file path
+    /// @param sourceContentHash Content hash of the source model file
+    /// @return True if the meshes were loaded. Otherwise, false
+    /// (the cache file does not exist or it is outdated).
+    ///
+    bool LoadMeshCacheFile(const char* cacheFilePath,
+                           const std::uint64_t sourceContentHash) noexcept;
+
+    ///
+    /// @brief Optimizes imported meshes (see MeshOptimizer), and logs their
+    /// vertex cache statistics (ACMR and ATVR) before and after optimization.
+    /// @param modelFilename Model filename. Must not be nullptr.
+    /// @param meshDataList Mesh data of each mesh in the model
+    ///
+    static void OptimizeMeshes(const char* modelFilename,
+                               std::vector<GeometryGenerator::MeshData>& meshDataList) noexcept;
+
     std::vector<Mesh> mMeshes;
 };
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "ModelImporter.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <Utils\DebugUtils.h>
+
+using namespace DirectX;
+
+namespace BRE {
+namespace {
+///
+/// @brief Converts an Assimp mesh to mesh data
+/// @param mesh Assimp mesh
+/// @param meshData Output mesh data
+///
+void
+CreateMeshData(const aiMesh& mesh,
+               GeometryGenerator::MeshData& meshData) noexcept
+{
+    // Positions and Normals
+    const std::size_t numVertices{ mesh.mNumVertices };
+    BRE_ASSERT(numVertices > 0U);
+    BRE_ASSERT(mesh.HasNormals());
+    meshData.mVertices.resize(numVertices);
+    for (std::uint32_t i = 0U; i < numVertices; ++i) {
+        meshData.mVertices[i].mPosition = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mVertices[i]));
+        meshData.mVertices[i].mNormal = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mNormals[i]));
+    }
+
+    // Texture Coordinates (if any)
+    if (mesh.HasTextureCoords(0U)) {
+        BRE_ASSERT(mesh.GetNumUVChannels() == 1U);
+        const aiVector3D* aiTextureCoordinates{ mesh.mTextureCoords[0U] };
+        BRE_ASSERT(aiTextureCoordinates != nullptr);
+        for (std::uint32_t i = 0U; i < numVertices; i++) {
+            meshData.mVertices[i].mUV = XMFLOAT2(reinterpret_cast<const float*>(&aiTextureCoordinates[i]));
+        }
+    }
+
+    // Indices
+    BRE_ASSERT(mesh.HasFaces());
+    const std::uint32_t numFaces{ mesh.mNumFaces };
+    meshData.mIndices32.reserve(numFaces * 3U);
+    for (std::uint32_t i = 0U; i < numFaces; ++i) {
+        const aiFace* face = &mesh.mFaces[i];
+        BRE_ASSERT(face != nullptr);
+        // We only allow triangles
+        BRE_ASSERT(face->mNumIndices == 3U);
+
+        meshData.mIndices32.push_back(face->mIndices[0U]);
+        meshData.mIndices32.push_back(face->mIndices[1U]);
+        meshData.mIndices32.push_back(face->mIndices[2U]);
+    }
+
+    // Tangents
+    if (mesh.HasTangentsAndBitangents()) {
+        for (std::uint32_t i = 0U; i < numVertices; ++i) {
+            meshData.mVertices[i].mTangent = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mTangents[i]));
+        }
+    }
+}
+}
+
+void
+ModelImporter::ImportModel(const char* modelFilename,
+                           std::vector<GeometryGenerator::MeshData>& meshDataList) noexcept
+{
+    BRE_ASSERT(modelFilename != nullptr);
+
+    Assimp::Importer importer;
+    const std::uint32_t flags{ aiProcessPreset_TargetRealtime_Fast | aiProcess_ConvertToLeftHanded };
+    const aiScene* scene{ importer.ReadFile(modelFilename, flags) };
+    BRE_CHECK_MSG(scene != nullptr, StringUtils::AnsiToWideString(importer.GetErrorString()).c_str());
+
+    BRE_ASSERT(scene->HasMeshes());
+
+    meshDataList.resize(scene->mNumMeshes);
+    for (std::uint32_t i = 0U; i < scene->mNumMeshes; ++i) {
+        const aiMesh* mesh{ scene->mMeshes[i] };
+        BRE_ASSERT(mesh != nullptr);
+        CreateMeshData(*mesh, meshDataList[i]);
+    }
+}
+}
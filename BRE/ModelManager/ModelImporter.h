@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+#include <GeometryGenerator\GeometryGenerator.h>
+
+namespace BRE {
+///
+/// @brief Responsible to import source model files (.obj, etc) with Assimp
+///
+class ModelImporter {
+public:
+    ModelImporter() = delete;
+    ~ModelImporter() = delete;
+    ModelImporter(const ModelImporter&) = delete;
+    const ModelImporter& operator=(const ModelImporter&) = delete;
+    ModelImporter(ModelImporter&&) = delete;
+    ModelImporter& operator=(ModelImporter&&) = delete;
+
+    ///
+    /// @brief Imports a model file
+    /// @param modelFilename Model filename. Must not be nullptr.
+    /// @param meshDataList Output mesh data of each mesh in the model
+    ///
+    static void ImportModel(const char* modelFilename,
+                            std::vector<GeometryGenerator::MeshData>& meshDataList) noexcept;
+};
+}
@@ -1,10 +1,11 @@
 #include "ModelManager.h"
 
 #include <GeometryGenerator\GeometryGenerator.h>
+#include <ResourceManager\ResourceManager.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
-tbb::concurrent_unordered_set<Model*> ModelManager::mModels;
+SlotMap<Model*> ModelManager::mModels;
 std::mutex ModelManager::mMutex;
 
 void
@@ -15,28 +16,49 @@ ModelManager::Clear() noexcept
         delete model;
     }
 
-    mModels.clear();
+    mModels.Clear();
+}
+
+void
+ModelManager::ReleaseModel(const ModelHandle modelHandle) noexcept
+{
+    Model* model{ nullptr };
+    BRE_CHECK_MSG(mModels.Erase(modelHandle, &model), L"Model handle is stale");
+    BRE_ASSERT(model != nullptr);
+
+    for (const Mesh& mesh : model->GetMeshes()) {
+        ResourceManager::ReleaseResource(mesh.GetVertexBufferData().mBufferHandle);
+        ResourceManager::ReleaseResource(mesh.GetIndexBufferData().mBufferHandle);
+    }
+
+    delete model;
+}
+
+ModelManager::SharedModel
+ModelManager::ShareModel(Model& model,
+                         const ModelHandle modelHandle) noexcept
+{
+    BRE_ASSERT(modelHandle.IsNull() == false);
+
+    return ResourceManager::GetDeferredReleaseQueue().MakeShared(model,
+                                                                 [modelHandle]() {
+        ReleaseModel(modelHandle);
+    });
 }
 
 Model&
 ModelManager::LoadModel(const char* modelFilename,
-                        ID3D12GraphicsCommandList& commandList,
-                        ID3D12Resource* &uploadVertexBuffer,
-                        ID3D12Resource* &uploadIndexBuffer) noexcept
+                        ModelHandle* modelHandle) noexcept
 {
     BRE_ASSERT(modelFilename != nullptr);
 
-    Model* model{ nullptr };
-
-    mMutex.lock();
-    model = new Model(modelFilename,
-                      commandList,
-                      uploadVertexBuffer,
-                      uploadIndexBuffer);
-    mMutex.unlock();
+    // Import and cache file reading do not share state between models, and buffer creation
+    // and upload are serialized by ResourceManager and StagingRingBuffer,
+    // so several models can be loaded in parallel.
+    Model* model = new Model(modelFilename);
 
     BRE_ASSERT(model != nullptr);
-    mModels.insert(model);
+    RegisterModel(*model, modelHandle);
 
     return *model;
 }
@@ -46,9 +68,7 @@ ModelManager::CreateBox(const float width,
                         const float height,
                         const float depth,
                         const std::uint32_t numSubdivisions,
-                        ID3D12GraphicsCommandList& commandList,
-                        ID3D12Resource* &uploadVertexBuffer,
-                        ID3D12Resource* &uploadIndexBuffer) noexcept
+                        ModelHandle* modelHandle) noexcept
 {
     Model* model{ nullptr };
 
@@ -59,14 +79,11 @@ ModelManager::CreateBox(const float width,
                                  numSubdivisions, meshData);
 
     mMutex.lock();
-    model = new Model(meshData,
-                      commandList,
-                      uploadVertexBuffer,
-                      uploadIndexBuffer);
+    model = new Model(meshData);
     mMutex.unlock();
 
     BRE_ASSERT(model != nullptr);
-    mModels.insert(model);
+    RegisterModel(*model, modelHandle);
 
     return *model;
 }
@@ -75,9 +92,7 @@ Model&
 ModelManager::CreateSphere(const float radius,
                            const std::uint32_t sliceCount,
                            const std::uint32_t stackCount,
-                           ID3D12GraphicsCommandList& commandList,
-                           ID3D12Resource* &uploadVertexBuffer,
-                           ID3D12Resource* &uploadIndexBuffer) noexcept
+                           ModelHandle* modelHandle) noexcept
 {
     Model* model{ nullptr };
 
@@ -88,14 +103,11 @@ ModelManager::CreateSphere(const float radius,
                                     meshData);
 
     mMutex.lock();
-    model = new Model(meshData,
-                      commandList,
-                      uploadVertexBuffer,
-                      uploadIndexBuffer);
+    model = new Model(meshData);
     mMutex.unlock();
 
     BRE_ASSERT(model != nullptr);
-    mModels.insert(model);
+    RegisterModel(*model, modelHandle);
 
     return *model;
 }
@@ -103,9 +115,7 @@ ModelManager::CreateSphere(const float radius,
 Model&
 ModelManager::CreateGeosphere(const float radius,
                               const std::uint32_t numSubdivisions,
-                              ID3D12GraphicsCommandList& commandList,
-                              ID3D12Resource* &uploadVertexBuffer,
-                              ID3D12Resource* &uploadIndexBuffer) noexcept
+                              ModelHandle* modelHandle) noexcept
 {
     Model* model{ nullptr };
 
@@ -115,14 +125,11 @@ ModelManager::CreateGeosphere(const float radius,
                                        meshData);
 
     mMutex.lock();
-    model = new Model(meshData,
-                      commandList,
-                      uploadVertexBuffer,
-                      uploadIndexBuffer);
+    model = new Model(meshData);
     mMutex.unlock();
 
     BRE_ASSERT(model != nullptr);
-    mModels.insert(model);
+    RegisterModel(*model, modelHandle);
 
     return *model;
 }
@@ -133,9 +140,7 @@ ModelManager::CreateCylinder(const float bottomRadius,
                              const float height,
                              const std::uint32_t sliceCount,
                              const std::uint32_t stackCount,
-                             ID3D12GraphicsCommandList& commandList,
-                             ID3D12Resource* &uploadVertexBuffer,
-                             ID3D12Resource* &uploadIndexBuffer) noexcept
+                             ModelHandle* modelHandle) noexcept
 {
     Model* model{ nullptr };
 
@@ -148,14 +153,11 @@ ModelManager::CreateCylinder(const float bottomRadius,
                                       meshData);
 
     mMutex.lock();
-    model = new Model(meshData,
-                      commandList,
-                      uploadVertexBuffer,
-                      uploadIndexBuffer);
+    model = new Model(meshData);
     mMutex.unlock();
 
     BRE_ASSERT(model != nullptr);
-    mModels.insert(model);
+    RegisterModel(*model, modelHandle);
 
     return *model;
 }
@@ -165,9 +167,7 @@ ModelManager::CreateGrid(const float width,
                          const float depth,
                          const std::uint32_t rows,
                          const std::uint32_t columns,
-                         ID3D12GraphicsCommandList& commandList,
-                         ID3D12Resource* &uploadVertexBuffer,
-                         ID3D12Resource* &uploadIndexBuffer) noexcept
+                         ModelHandle* modelHandle) noexcept
 {
     Model* model{ nullptr };
 
@@ -179,15 +179,22 @@ ModelManager::CreateGrid(const float width,
                                   meshData);
 
     mMutex.lock();
-    model = new Model(meshData,
-                      commandList,
-                      uploadVertexBuffer,
-                      uploadIndexBuffer);
+    model = new Model(meshData);
     mMutex.unlock();
 
     BRE_ASSERT(model != nullptr);
-    mModels.insert(model);
+    RegisterModel(*model, modelHandle);
 
     return *model;
 }
+
+void
+ModelManager::RegisterModel(Model& model,
+                            ModelHandle* modelHandle) noexcept
+{
+    const ModelHandle handle = mModels.Insert(&model);
+    if (modelHandle != nullptr) {
+        *modelHandle = handle;
+    }
+}
 }
\ No newline at end of file
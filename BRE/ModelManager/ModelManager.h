@@ -1,17 +1,27 @@
 #pragma once
 
-#include <d3d12.h>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <tbb\concurrent_unordered_set.h>
 
 #include <ModelManager/Model.h>
+#include <Utils\SlotMap.h>
 
 namespace BRE {
 ///
 /// @brief Responsible to create models or built-in geometry (box, sphere, etc)
 ///
+/// Models buffers are uploaded through StagingRingBuffer, so StagingRingBuffer::Flush()
+/// must be called before the models are used.
+///
 class ModelManager {
 public:
+    using ModelHandle = SlotMap<Model*>::Handle;
+
+    // Reference counted model. When its last copy is destroyed, the model
+    // is released once the GPU finished the frames that could use it.
+    using SharedModel = std::shared_ptr<Model>;
+
     ModelManager() = delete;
     ~ModelManager() = delete;
     ModelManager(const ModelManager&) = delete;
@@ -24,26 +34,42 @@ public:
     ///
     static void Clear() noexcept;
 
+    ///
+    /// @brief Releases a model and its buffers
+    ///
+    /// The GPU must not use the model buffers anymore.
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param modelHandle Model handle. It must not be stale.
+    ///
+    static void ReleaseModel(const ModelHandle modelHandle) noexcept;
+
+    ///
+    /// @brief Creates a reference counted handle of a model
+    ///
+    /// When its last copy is destroyed, the model is released (see ReleaseModel()) once the GPU
+    /// finished the frame that is being recorded (see ResourceManager::GetDeferredReleaseQueue()).
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param model Model
+    /// @param modelHandle Model handle. It must not be stale, and the model
+    /// must not be released through it anymore.
+    /// @return Reference counted model
+    ///
+    static SharedModel ShareModel(Model& model,
+                                  const ModelHandle modelHandle) noexcept;
+
     ///
     /// @brief Load model
+    ///
+    /// It can be called from several threads at the same time.
+    ///
     /// @param modelFilename Model filename. Must be not nullptr
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
+    /// @param modelHandle Output model handle, to release the model. It can be nullptr.
     /// @return Model
     ///
     static Model& LoadModel(const char* modelFilename,
-                            ID3D12GraphicsCommandList& commandList,
-                            ID3D12Resource* &uploadVertexBuffer,
-                            ID3D12Resource* &uploadIndexBuffer) noexcept;
+                            ModelHandle* modelHandle = nullptr) noexcept;
 
     ///
     /// @brief Create a box centered at the origin
@@ -51,74 +77,38 @@ public:
     /// @param height Height
     /// @param depth Depth
     /// @param numSubdivisions Number of subdivisions. This controls tessellation.
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
+    /// @param modelHandle Output model handle, to release the model. It can be nullptr.
     /// @return Model
     ///
     static Model& CreateBox(const float width,
                             const float height,
                             const float depth,
                             const std::uint32_t numSubdivisions,
-                            ID3D12GraphicsCommandList& commandList,
-                            ID3D12Resource* &uploadVertexBuffer,
-                            ID3D12Resource* &uploadIndexBuffer) noexcept;
+                            ModelHandle* modelHandle = nullptr) noexcept;
 
     ///
     /// @brief Create a sphere centered at the origin
     /// @param radius Radius
     /// @param sliceCount Slice count. This controls tessellation.
     /// @param stackCount Stack count. This controls tessellation.
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
+    /// @param modelHandle Output model handle, to release the model. It can be nullptr.
     /// @return Model
     ///
     static Model& CreateSphere(const float radius,
                                const std::uint32_t sliceCount,
                                const std::uint32_t stackCount,
-                               ID3D12GraphicsCommandList& commandList,
-                               ID3D12Resource* &uploadVertexBuffer,
-                               ID3D12Resource* &uploadIndexBuffer) noexcept;
+                               ModelHandle* modelHandle = nullptr) noexcept;
 
     ///
     /// @brief Create a geosphere centered at the origin
     /// @param radius Radius
     /// @param numSubdivisions Number of subdivisions. This controls tessellation.
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
+    /// @param modelHandle Output model handle, to release the model. It can be nullptr.
     /// @return Model
     ///
     static Model& CreateGeosphere(const float radius,
                                   const std::uint32_t numSubdivisions,
-                                  ID3D12GraphicsCommandList& commandList,
-                                  ID3D12Resource* &uploadVertexBuffer,
-                                  ID3D12Resource* &uploadIndexBuffer) noexcept;
+                                  ModelHandle* modelHandle = nullptr) noexcept;
 
     ///
     /// @brief Create a cylinder centered at the origin
@@ -127,17 +117,7 @@ public:
     /// @param height Height
     /// @param sliceCount Slice count. This controls tessellation.
     /// @param stackCount Stack count. This controls tessellation.
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
+    /// @param modelHandle Output model handle, to release the model. It can be nullptr.
     /// @return Model
     /// 
     static Model& CreateCylinder(const float bottomRadius,
@@ -145,9 +125,7 @@ public:
                                  const float height,
                                  const std::uint32_t sliceCount,
                                  const std::uint32_t stackCount,
-                                 ID3D12GraphicsCommandList& commandList,
-                                 ID3D12Resource* &uploadVertexBuffer,
-                                 ID3D12Resource* &uploadIndexBuffer) noexcept;
+                                 ModelHandle* modelHandle = nullptr) noexcept;
 
     ///
     /// @brief Create a rows X columns grid in the xz-plane centered at the origin
@@ -155,29 +133,25 @@ public:
     /// @param depth Depth
     /// @param rows Grid rows
     /// @param columns Grid columns
-    /// @param commandList Command list used to upload buffers content to GPU.
-    /// It must be executed after this function call to upload buffers content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadVertexBuffer Upload buffer to upload the vertex buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffer Upload buffer to upload the index buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffer after it knows the copy has been executed.
+    /// @param modelHandle Output model handle, to release the model. It can be nullptr.
     /// @return Model
     ///
     static Model& CreateGrid(const float width,
                              const float depth,
                              const std::uint32_t rows,
                              const std::uint32_t columns,
-                             ID3D12GraphicsCommandList& commandList,
-                             ID3D12Resource* &uploadVertexBuffer,
-                             ID3D12Resource* &uploadIndexBuffer) noexcept;
+                             ModelHandle* modelHandle = nullptr) noexcept;
 
 private:
-    static tbb::concurrent_unordered_set<Model*> mModels;
+    ///
+    /// @brief Registers a created model
+    /// @param model Model
+    /// @param modelHandle Output model handle. It can be nullptr.
+    ///
+    static void RegisterModel(Model& model,
+                              ModelHandle* modelHandle) noexcept;
+
+    static SlotMap<Model*> mModels;
 
     static std::mutex mMutex;
 };
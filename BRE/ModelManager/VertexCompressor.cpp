@@ -0,0 +1,233 @@
+#include "VertexCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+
+#include <Utils\DebugUtils.h>
+
+using namespace DirectX;
+
+namespace BRE {
+namespace {
+///
+/// @brief Selects floats by a mask
+/// @param mask Mask. All bits of each lane are set or cleared.
+/// @param a Floats selected where the mask is set
+/// @param b Floats selected where the mask is cleared
+/// @return Selected floats
+///
+__forceinline __m128
+Select(const __m128 mask,
+       const __m128 a,
+       const __m128 b) noexcept
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+///
+/// @brief Octahedral encodes 4 unit vectors, with 16 bits signed normalized components.
+///
+/// It matches DecodeSignedOctahedron in ShaderUtils/Utils.hlsli.
+///
+/// @param x X component of each vector
+/// @param y Y component of each vector
+/// @param z Z component of each vector
+/// @return Encoded vectors. X is in the low 16 bits, and Y in the high 16 bits.
+///
+__m128i
+EncodeUnitVectors(__m128 x,
+                  __m128 y,
+                  __m128 z) noexcept
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    // Project to the octahedron. Zero vectors are encoded as +Z.
+    const __m128 l1Norm = _mm_add_ps(_mm_add_ps(_mm_and_ps(x, absMask), _mm_and_ps(y, absMask)),
+                                     _mm_and_ps(z, absMask));
+    const __m128 inverseL1Norm = _mm_div_ps(one, _mm_max_ps(l1Norm, _mm_set1_ps(1.0e-20f)));
+    x = _mm_mul_ps(x, inverseL1Norm);
+    y = _mm_mul_ps(y, inverseL1Norm);
+    z = _mm_mul_ps(z, inverseL1Norm);
+
+    // Fold the lower hemisphere over the upper one
+    const __m128 xSign = Select(_mm_cmpge_ps(x, zero), one, _mm_set1_ps(-1.0f));
+    const __m128 ySign = Select(_mm_cmpge_ps(y, zero), one, _mm_set1_ps(-1.0f));
+    const __m128 foldedX = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(y, absMask)), xSign);
+    const __m128 foldedY = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(x, absMask)), ySign);
+    const __m128 isLowerHemisphere = _mm_cmplt_ps(z, zero);
+    x = Select(isLowerHemisphere, foldedX, x);
+    y = Select(isLowerHemisphere, foldedY, y);
+
+    // Quantize with round to nearest, and interleave X and Y.
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    const __m128i quantizedX = _mm_cvtps_epi32(_mm_mul_ps(x, scale));
+    const __m128i quantizedY = _mm_cvtps_epi32(_mm_mul_ps(y, scale));
+
+    return _mm_unpacklo_epi16(_mm_packs_epi32(quantizedX, quantizedX),
+                              _mm_packs_epi32(quantizedY, quantizedY));
+}
+
+///
+/// @brief Converts 4 floats to half floats, with round to nearest even.
+/// Values out of the half float range are converted to infinity.
+/// @param value Floats
+/// @return Half floats, sign extended to 32 bits, so they can be packed with signed saturation.
+///
+__m128i
+FloatsToHalfFloats(const __m128 value) noexcept
+{
+    const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000U));
+    const __m128i halfFloatMax = _mm_set1_epi32((127 + 16) << 23); // Smallest float rounded to infinity
+    const __m128i halfFloatMinNormal = _mm_set1_epi32((127 - 14) << 23); // Smallest float rounded to a normal
+    const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+    const __m128i sign = _mm_and_si128(_mm_castps_si128(value), signMask);
+    const __m128 absValue = _mm_castsi128_ps(_mm_xor_si128(_mm_castps_si128(value), sign));
+    const __m128i absValueBits = _mm_castps_si128(absValue);
+
+    // Infinity and NaN
+    const __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absValue, absValue));
+    const __m128i infinityOrNaN = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+    const __m128i isFinite = _mm_cmpgt_epi32(halfFloatMax, absValueBits);
+
+    // Subnormals are rounded by the float addition
+    const __m128i isSubnormal = _mm_cmpgt_epi32(halfFloatMinNormal, absValueBits);
+    const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absValue, _mm_castsi128_ps(subnormalMagic))),
+                                            subnormalMagic);
+
+    // Normals are rebiased and rounded, and ties are rounded to even.
+    const __m128i isMantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absValueBits, 31 - 13), 31);
+    const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absValueBits, normalBias), isMantissaOdd), 13);
+
+    const __m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+    const __m128i halfFloat = _mm_or_si128(_mm_and_si128(isFinite, finite), _mm_andnot_si128(isFinite, infinityOrNaN));
+
+    return _mm_or_si128(halfFloat, _mm_srai_epi32(sign, 16));
+}
+
+///
+/// @brief Converts a half float to a float
+/// @param halfFloat Half float
+/// @return Float
+///
+float
+HalfFloatToFloat(const std::uint16_t halfFloat) noexcept
+{
+    const std::uint32_t sign = static_cast<std::uint32_t>(halfFloat & 0x8000U) << 16U;
+    const std::uint32_t exponent = (halfFloat >> 10U) & 0x1FU;
+    const std::uint32_t mantissa = halfFloat & 0x3FFU;
+
+    if (exponent == 0U) {
+        const float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0U ? -value : value;
+    }
+
+    const std::uint32_t bits = exponent == 0x1FU ?
+        sign | 0x7F800000U | (mantissa << 13U) :
+        sign | ((exponent + 112U) << 23U) | (mantissa << 13U);
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(float));
+
+    return value;
+}
+
+///
+/// @brief Converts a 16 bits signed normalized value to a float
+/// @param value Value
+/// @return Float in [-1, 1]
+///
+float
+SignedNormalizedToFloat(const std::uint16_t value) noexcept
+{
+    return std::max(static_cast<float>(static_cast<std::int16_t>(value)) / 32767.0f, -1.0f);
+}
+}
+
+void
+VertexCompressor::CompressVertices(const GeometryGenerator::Vertex* vertices,
+                                   const std::size_t vertexCount,
+                                   CompressedVertex* compressedVertices) noexcept
+{
+    BRE_ASSERT(vertexCount == 0U || vertices != nullptr);
+    BRE_ASSERT(vertexCount == 0U || compressedVertices != nullptr);
+
+    for (std::size_t i = 0U; i < vertexCount; i += 4U) {
+        // The last group is padded with its last vertex
+        const std::size_t groupVertexCount = std::min(vertexCount - i, static_cast<std::size_t>(4U));
+        const GeometryGenerator::Vertex* groupVertices[4U];
+        for (std::size_t j = 0U; j < 4U; ++j) {
+            groupVertices[j] = &vertices[i + std::min(j, groupVertexCount - 1U)];
+        }
+
+        // Transpose normals and tangents. The fourth row is the next member, and it is not used.
+        __m128 normalX = _mm_loadu_ps(&groupVertices[0U]->mNormal.x);
+        __m128 normalY = _mm_loadu_ps(&groupVertices[1U]->mNormal.x);
+        __m128 normalZ = _mm_loadu_ps(&groupVertices[2U]->mNormal.x);
+        __m128 normalW = _mm_loadu_ps(&groupVertices[3U]->mNormal.x);
+        _MM_TRANSPOSE4_PS(normalX, normalY, normalZ, normalW);
+
+        __m128 tangentX = _mm_loadu_ps(&groupVertices[0U]->mTangent.x);
+        __m128 tangentY = _mm_loadu_ps(&groupVertices[1U]->mTangent.x);
+        __m128 tangentZ = _mm_loadu_ps(&groupVertices[2U]->mTangent.x);
+        __m128 tangentW = _mm_loadu_ps(&groupVertices[3U]->mTangent.x);
+        _MM_TRANSPOSE4_PS(tangentX, tangentY, tangentZ, tangentW);
+
+        // UVs are the last member, so they are loaded with 8 bytes loads.
+        const __m128 uv01 = _mm_unpacklo_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&groupVertices[0U]->mUV))),
+                                            _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&groupVertices[1U]->mUV))));
+        const __m128 uv23 = _mm_unpacklo_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&groupVertices[2U]->mUV))),
+                                            _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&groupVertices[3U]->mUV))));
+        const __m128 u = _mm_movelh_ps(uv01, uv23);
+        const __m128 v = _mm_movehl_ps(uv23, uv01);
+
+        std::uint32_t encodedNormals[4U];
+        std::uint32_t encodedTangents[4U];
+        std::uint32_t encodedUVs[4U];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(encodedNormals), EncodeUnitVectors(normalX, normalY, normalZ));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(encodedTangents), EncodeUnitVectors(tangentX, tangentY, tangentZ));
+        const __m128i halfU = FloatsToHalfFloats(u);
+        const __m128i halfV = FloatsToHalfFloats(v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(encodedUVs),
+                         _mm_unpacklo_epi16(_mm_packs_epi32(halfU, halfU), _mm_packs_epi32(halfV, halfV)));
+
+        for (std::size_t j = 0U; j < groupVertexCount; ++j) {
+            CompressedVertex& compressedVertex = compressedVertices[i + j];
+            compressedVertex.mPosition = groupVertices[j]->mPosition;
+            compressedVertex.mNormal = encodedNormals[j];
+            compressedVertex.mTangent = encodedTangents[j];
+            compressedVertex.mUV = encodedUVs[j];
+        }
+    }
+}
+
+XMFLOAT3
+VertexCompressor::DecodeUnitVector(const std::uint32_t encodedVector) noexcept
+{
+    float x = SignedNormalizedToFloat(static_cast<std::uint16_t>(encodedVector & 0xFFFFU));
+    float y = SignedNormalizedToFloat(static_cast<std::uint16_t>(encodedVector >> 16U));
+    const float z = 1.0f - std::abs(x) - std::abs(y);
+    if (z < 0.0f) {
+        const float unfoldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float unfoldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = unfoldedX;
+        y = unfoldedY;
+    }
+
+    const float inverseLength = 1.0f / std::sqrt(x * x + y * y + z * z);
+
+    return XMFLOAT3(x * inverseLength, y * inverseLength, z * inverseLength);
+}
+
+XMFLOAT2
+VertexCompressor::DecodeUV(const std::uint32_t encodedUV) noexcept
+{
+    return XMFLOAT2(HalfFloatToFloat(static_cast<std::uint16_t>(encodedUV & 0xFFFFU)),
+                    HalfFloatToFloat(static_cast<std::uint16_t>(encodedUV >> 16U)));
+}
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <DirectXMath.h>
+
+#include <GeometryGenerator\GeometryGenerator.h>
+
+namespace BRE {
+///
+/// @brief Responsible to compress vertices to the layout that vertex buffers use.
+///
+/// GeometryGenerator::Vertex is 44 bytes, and a compressed vertex is 24 bytes:
+/// - Position: 3 floats. It is not quantized, so world matrices keep working for positions, normals and tangents.
+/// - Normal and tangent: Octahedral encoding, 16 bits signed normalized per component (DXGI_FORMAT_R16G16_SNORM).
+/// - UV: Half floats (DXGI_FORMAT_R16G16_FLOAT), so UVs out of [0, 1] are valid.
+///
+/// Shaders decode normals and tangents with DecodeSignedOctahedron (ShaderUtils/Utils.hlsli).
+///
+class VertexCompressor {
+public:
+    VertexCompressor() = delete;
+    ~VertexCompressor() = delete;
+    VertexCompressor(const VertexCompressor&) = delete;
+    const VertexCompressor& operator=(const VertexCompressor&) = delete;
+    VertexCompressor(VertexCompressor&&) = delete;
+    VertexCompressor& operator=(VertexCompressor&&) = delete;
+
+    ///
+    /// @brief Compressed vertex (see D3DFactory::GetCompressedPositionNormalTangentTexCoordInputLayout)
+    ///
+    struct CompressedVertex {
+        DirectX::XMFLOAT3 mPosition{ 0.0f, 0.0f, 0.0f };
+        std::uint32_t mNormal{ 0U };
+        std::uint32_t mTangent{ 0U };
+        std::uint32_t mUV{ 0U };
+    };
+
+    ///
+    /// @brief Compresses vertices. They are compressed in groups of 4 with SSE2.
+    /// @param vertices Vertices. Must not be nullptr if vertex count is greater than zero.
+    /// @param vertexCount Number of vertices
+    /// @param compressedVertices Output compressed vertices. There must be space for vertex count vertices.
+    ///
+    static void CompressVertices(const GeometryGenerator::Vertex* vertices,
+                                 const std::size_t vertexCount,
+                                 CompressedVertex* compressedVertices) noexcept;
+
+    ///
+    /// @brief Decodes an octahedral encoded unit vector (normal or tangent)
+    /// @param encodedVector Encoded vector
+    /// @return Unit vector
+    ///
+    static DirectX::XMFLOAT3 DecodeUnitVector(const std::uint32_t encodedVector) noexcept;
+
+    ///
+    /// @brief Decodes half float texture coordinates
+    /// @param encodedUV Encoded texture coordinates
+    /// @return Texture coordinates
+    ///
+    static DirectX::XMFLOAT2 DecodeUV(const std::uint32_t encodedUV) noexcept;
+};
+}
\ No newline at end of file
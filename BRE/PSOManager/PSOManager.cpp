@@ -5,7 +5,7 @@
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
-tbb::concurrent_unordered_set<ID3D12PipelineState*> PSOManager::mPSOs;
+SlotMap<ID3D12PipelineState*> PSOManager::mPSOs;
 std::mutex PSOManager::mMutex;
 
 void
@@ -16,7 +16,17 @@ PSOManager::Clear() noexcept
         pso->Release();
     }
 
-    mPSOs.clear();
+    mPSOs.Clear();
+}
+
+void
+PSOManager::ReleasePSO(const PSOHandle psoHandle) noexcept
+{
+    ID3D12PipelineState* pso{ nullptr };
+    BRE_CHECK_MSG(mPSOs.Erase(psoHandle, &pso), L"Pipeline state object handle is stale");
+    BRE_ASSERT(pso != nullptr);
+
+    pso->Release();
 }
 
 bool
@@ -38,7 +48,8 @@ PSOManager::PSOCreationData::IsDataValid() const noexcept
 }
 
 ID3D12PipelineState&
-PSOManager::CreateGraphicsPSO(const PSOManager::PSOCreationData& psoData) noexcept
+PSOManager::CreateGraphicsPSO(const PSOManager::PSOCreationData& psoData,
+                              PSOHandle* psoHandle) noexcept
 {
     BRE_ASSERT(psoData.IsDataValid());
 
@@ -65,11 +76,12 @@ PSOManager::CreateGraphicsPSO(const PSOManager::PSOCreationData& psoData) noexce
     psoDescriptor.SampleMask = psoData.mSampleMask;
     psoDescriptor.VS = psoData.mVertexShaderBytecode;
 
-    return CreateGraphicsPSOByDescriptor(psoDescriptor);
+    return CreateGraphicsPSOByDescriptor(psoDescriptor, psoHandle);
 }
 
 ID3D12PipelineState&
-PSOManager::CreateGraphicsPSOByDescriptor(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDescriptor) noexcept
+PSOManager::CreateGraphicsPSOByDescriptor(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDescriptor,
+                                          PSOHandle* psoHandle) noexcept
 {
     ID3D12PipelineState* pso{ nullptr };
 
@@ -78,7 +90,10 @@ PSOManager::CreateGraphicsPSOByDescriptor(const D3D12_GRAPHICS_PIPELINE_STATE_DE
     mMutex.unlock();
 
     BRE_ASSERT(pso != nullptr);
-    mPSOs.insert(pso);
+    const PSOHandle handle = mPSOs.Insert(pso);
+    if (psoHandle != nullptr) {
+        *psoHandle = handle;
+    }
 
     return *pso;
 }
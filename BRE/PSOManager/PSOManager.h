@@ -2,9 +2,9 @@
 
 #include <d3d12.h>
 #include <mutex>
-#include <tbb/concurrent_unordered_set.h>
 
 #include <DXUtils/D3DFactory.h>
+#include <Utils\SlotMap.h>
 
 namespace BRE {
 ///
@@ -12,6 +12,8 @@ namespace BRE {
 ///
 class PSOManager {
 public:
+    using PSOHandle = SlotMap<ID3D12PipelineState*>::Handle;
+
     PSOManager() = delete;
     ~PSOManager() = delete;
     PSOManager(const PSOManager&) = delete;
@@ -24,6 +26,16 @@ public:
     ///
     static void Clear() noexcept;
 
+    ///
+    /// @brief Releases a pipeline state object
+    ///
+    /// The GPU must not use the pipeline state object anymore.
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param psoHandle Pipeline state object handle. It must not be stale.
+    ///
+    static void ReleasePSO(const PSOHandle psoHandle) noexcept;
+
     struct PSOCreationData {
         PSOCreationData() = default;
         ~PSOCreationData() = default;
@@ -62,19 +74,23 @@ public:
     ///
     /// @brief Create graphics pipeline state object
     /// @param psoCreationData Pipeline state object creation data. It must be valid
+    /// @param psoHandle Output pipeline state object handle, to release it. It can be nullptr.
     /// @return Pipeline state object
     ///
-    static ID3D12PipelineState& CreateGraphicsPSO(const PSOManager::PSOCreationData& psoCreationData) noexcept;
+    static ID3D12PipelineState& CreateGraphicsPSO(const PSOManager::PSOCreationData& psoCreationData,
+                                                  PSOHandle* psoHandle = nullptr) noexcept;
 
 private:
     ///
     /// @brief Create graphics pipeline state object by descriptor
     /// @param psoDescriptor Graphics pipeline state object descriptor
+    /// @param psoHandle Output pipeline state object handle. It can be nullptr.
     /// @return Pipeline state object
     ///
-    static ID3D12PipelineState& CreateGraphicsPSOByDescriptor(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDescriptor) noexcept;
+    static ID3D12PipelineState& CreateGraphicsPSOByDescriptor(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDescriptor,
+                                                              PSOHandle* psoHandle) noexcept;
 
-    static tbb::concurrent_unordered_set<ID3D12PipelineState*> mPSOs;
+    static SlotMap<ID3D12PipelineState*> mPSOs;
 
     static std::mutex mMutex;
 };
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <CommandManager\CommandListPerFrame.h>
 #include <PostProcessPass\PostProcessCommandListRecorder.h>
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
 
 namespace BRE {
 ///
@@ -45,14 +45,14 @@ private:
     bool IsDataValid() const noexcept;
 
     ///
-    /// @brief Records pre pass command lists and pushes them to 
+    /// @brief Pushes pre pass resource state transitions to
     /// the CommandListExecutor.
     /// @param frameBuffer Frame buffer
-    /// @return The number of recorded command lists
+    /// @return The number of pushed command lists
     ///
     std::uint32_t RecordAndPushPrePassCommandLists(ID3D12Resource& frameBuffer) noexcept;
 
-    CommandListPerFrame mPrePassCommandListPerFrame;
+    CommandListResourceStateTracker mPrePassResourceStateTracker;
 
     ID3D12Resource* mInputColorBuffer{ nullptr };
 
@@ -7,7 +7,6 @@
 #include <DescriptorManager\RenderTargetDescriptorManager.h>
 #include <DXUtils\D3DFactory.h>
 #include <ResourceManager\ResourceManager.h>
-#include <ResourceStateManager\ResourceStateManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
 
@@ -222,34 +221,18 @@ ReflectionPass::RecordAndPushPrePassCommandLists() noexcept
 
     const std::uint32_t numMipLevels = _countof(mHierZBufferMipLevelRenderTargetViews);
 
-    // Barriers size = numMipLevels for hier-z buffer + numMipLevels for visibility buffer + depth buffer
-    D3D12_RESOURCE_BARRIER barriers[numMipLevels * 2 + 1U];
-    std::uint32_t barrierCount = 0UL;
+    mPrePassResourceStateTracker.Reset();
     for (std::uint32_t i = 0U; i < numMipLevels; ++i) {
-        if (ResourceStateManager::GetSubresourceState(*mHierZBuffer, i) != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-            barriers[barrierCount] = ResourceStateManager::ChangeSubresourceStateAndGetBarrier(*mHierZBuffer,
-                                                                                               i,
-                                                                                               D3D12_RESOURCE_STATE_RENDER_TARGET);
-            ++barrierCount;
-        }
-
-        if (ResourceStateManager::GetSubresourceState(*mVisibilityBuffer, i) != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-            barriers[barrierCount] = ResourceStateManager::ChangeSubresourceStateAndGetBarrier(*mVisibilityBuffer,
-                                                                                               i,
-                                                                                               D3D12_RESOURCE_STATE_RENDER_TARGET);
-            ++barrierCount;
-        }
+        mPrePassResourceStateTracker.ChangeSubresourceState(*mHierZBuffer,
+                                                            i,
+                                                            D3D12_RESOURCE_STATE_RENDER_TARGET);
+        mPrePassResourceStateTracker.ChangeSubresourceState(*mVisibilityBuffer,
+                                                            i,
+                                                            D3D12_RESOURCE_STATE_RENDER_TARGET);
     }
 
-    if (ResourceStateManager::GetResourceState(*mDepthBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mDepthBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (barrierCount > 0UL) {
-        commandList.ResourceBarrier(barrierCount, barriers);
-    }
+    mPrePassResourceStateTracker.ChangeResourceState(*mDepthBuffer,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
     // Clear all the mip levels of the hier z buffer
     float hierZBufferClearColor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
@@ -270,7 +253,7 @@ ReflectionPass::RecordAndPushPrePassCommandLists() noexcept
     }
 
     BRE_CHECK_HR(commandList.Close());
-    CommandListExecutor::Get().PushCommandList(commandList);
+    CommandListExecutor::Get().PushCommandList(commandList, mPrePassResourceStateTracker);
 
     return 1U;
 }
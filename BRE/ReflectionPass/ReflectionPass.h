@@ -4,6 +4,7 @@
 #include <ReflectionPass\CopyResourcesCommandListRecorder.h>
 #include <ReflectionPass\HiZBufferCommandListRecorder.h>
 #include <ReflectionPass\VisibilityBufferCommandListRecorder.h>
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
 
 namespace BRE {
 struct FrameCBuffer;
@@ -75,6 +76,7 @@ private:
     std::uint32_t RecordAndPushVisibilityBufferCommandLists(const FrameCBuffer& frameCBuffer) noexcept;
 
     CommandListPerFrame mPrePassCommandListPerFrame;
+    CommandListResourceStateTracker mPrePassResourceStateTracker;
 
     ID3D12Resource* mHierZBuffer{ nullptr };
     D3D12_CPU_DESCRIPTOR_HANDLE mHierZBufferMipLevelRenderTargetViews[10U]{ 0UL };
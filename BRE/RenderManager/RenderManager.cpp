@@ -14,6 +14,7 @@
 #include <Input/Keyboard.h>
 #include <Input/Mouse.h>
 #include <ResourceManager\ResourceManager.h>
+#include <ResourceManager\TextureStreamer.h>
 #include <ResourceStateManager\ResourceStateManager.h>
 #include <Scene/Scene.h>
 
@@ -187,6 +188,7 @@ RenderManager::RenderManager(Scene& scene)
                        ApplicationSettings::GetAspectRatio(),
                        ApplicationSettings::sNearPlaneZ,
                        ApplicationSettings::sFarPlaneZ);
+    UpdateCameraPosition();
 
     // Shader resource view to the depth buffer
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDescriptor{};
@@ -264,14 +266,84 @@ RenderManager::Terminate() noexcept
     parent()->wait_for_all();
 }
 
+void
+RenderManager::ReplaceGeometryCommandListRecorders(const GeometryCommandListRecorders& commandListRecorders) noexcept
+{
+    BRE_ASSERT(commandListRecorders.empty() == false);
+
+    std::lock_guard<std::mutex> lock(mPendingGeometryCommandListRecordersMutex);
+    mPendingGeometryCommandListRecorders = commandListRecorders;
+}
+
+void
+RenderManager::Suspend() noexcept
+{
+    BRE_ASSERT(mIsSuspendRequested == false);
+
+    mIsSuspendRequested = true;
+    while (mIsSuspended == false) {
+        Sleep(0U);
+    }
+}
+
+void
+RenderManager::Resume(Scene& scene) noexcept
+{
+    BRE_ASSERT(mIsSuspended);
+
+    ID3D12Resource* skyBoxCubeMap = scene.GetSkyBoxCubeMap();
+    ID3D12Resource* diffuseIrradianceCubeMap = scene.GetDiffuseIrradianceCubeMap();
+    ID3D12Resource* specularPreConvolvedCubeMap = scene.GetSpecularPreConvolvedCubeMap();
+    BRE_ASSERT(skyBoxCubeMap != nullptr);
+    BRE_ASSERT(diffuseIrradianceCubeMap != nullptr);
+    BRE_ASSERT(specularPreConvolvedCubeMap != nullptr);
+
+    // The master render task is suspended, so scene data can be replaced from this thread.
+    GeometryCommandListRecorders commandListRecorders(scene.GetGeometryCommandListRecorders());
+    mGeometryPass.ReplaceCommandListRecorders(commandListRecorders);
+    mEnvironmentLightPass.ReplaceEnvironmentCubeMaps(*diffuseIrradianceCubeMap,
+                                                     *specularPreConvolvedCubeMap);
+    mSkyBoxPass.ReplaceSkyBoxCubeMap(*skyBoxCubeMap);
+
+    mCamera = scene.GetCamera();
+    mCamera.SetFrustum(ApplicationSettings::sVerticalFieldOfView,
+                       ApplicationSettings::GetAspectRatio(),
+                       ApplicationSettings::sNearPlaneZ,
+                       ApplicationSettings::sFarPlaneZ);
+    UpdateCameraPosition();
+
+    mPendingGeometryCommandListRecordersMutex.lock();
+    mPendingGeometryCommandListRecorders.clear();
+    mPendingGeometryCommandListRecordersMutex.unlock();
+
+    mIsSuspendRequested = false;
+    mIsSuspended = false;
+}
+
 tbb::task*
 RenderManager::execute()
 {
     while (!mTerminate) {
+        if (mIsSuspendRequested) {
+            WaitWhileSuspended();
+            continue;
+        }
+
+        ReplacePendingGeometryCommandListRecorders();
+
         mTimer.Tick();
         UpdateCameraAndFrameCBuffer(mTimer.GetDeltaTimeInSeconds(),
                                     mCamera,
                                     mFrameCBuffer);
+        UpdateCameraPosition();
+
+        // Upload more detailed texture mip levels for the new camera
+        TextureStreamer::Update(mCamera.GetViewMatrix(),
+                                mCamera.GetProjectionMatrix());
+
+        // Views of the uploaded mip levels are written to new descriptors,
+        // because queued frames could read the current ones.
+        CbvSrvUavDescriptorManager::UpdateStreamedShaderResourceViews();
 
         std::uint32_t commandListCount = 0U;
         CommandListExecutor::Get().ResetExecutedCommandListCount();
@@ -310,35 +382,15 @@ RenderManager::RecordAndPushPrePassCommandLists() noexcept
 {
     ID3D12GraphicsCommandList& commandList = mPrePassCommandListPerFrame.ResetCommandListWithNextCommandAllocator(nullptr);
 
-    D3D12_RESOURCE_BARRIER barriers[4U];
-    std::uint32_t barrierCount = 0UL;
-    if (ResourceStateManager::GetResourceState(*GetCurrentFrameBuffer()) != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*GetCurrentFrameBuffer(),
-                                                                                        D3D12_RESOURCE_STATE_RENDER_TARGET);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mIntermediateColorBuffer1) != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mIntermediateColorBuffer1,
-                                                                                        D3D12_RESOURCE_STATE_RENDER_TARGET);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mIntermediateColorBuffer2) != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mIntermediateColorBuffer2,
-                                                                                        D3D12_RESOURCE_STATE_RENDER_TARGET);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mDepthBuffer) != D3D12_RESOURCE_STATE_DEPTH_WRITE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mDepthBuffer,
-                                                                                        D3D12_RESOURCE_STATE_DEPTH_WRITE);
-        ++barrierCount;
-    }
-
-    if (barrierCount > 0UL) {
-        commandList.ResourceBarrier(barrierCount, barriers);
-    }
+    mPrePassResourceStateTracker.Reset();
+    mPrePassResourceStateTracker.ChangeResourceState(*GetCurrentFrameBuffer(),
+                                                     D3D12_RESOURCE_STATE_RENDER_TARGET);
+    mPrePassResourceStateTracker.ChangeResourceState(*mIntermediateColorBuffer1,
+                                                     D3D12_RESOURCE_STATE_RENDER_TARGET);
+    mPrePassResourceStateTracker.ChangeResourceState(*mIntermediateColorBuffer2,
+                                                     D3D12_RESOURCE_STATE_RENDER_TARGET);
+    mPrePassResourceStateTracker.ChangeResourceState(*mDepthBuffer,
+                                                     D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
     commandList.ClearRenderTargetView(GetCurrentFrameBufferRenderTargetView(),
                                       Colors::Black,
@@ -363,7 +415,7 @@ RenderManager::RecordAndPushPrePassCommandLists() noexcept
                                       nullptr);
 
     BRE_CHECK_HR(commandList.Close());
-    CommandListExecutor::Get().PushCommandList(commandList);
+    CommandListExecutor::Get().PushCommandList(commandList, mPrePassResourceStateTracker);
 
     return 1U;
 }
@@ -371,24 +423,13 @@ RenderManager::RecordAndPushPrePassCommandLists() noexcept
 std::uint32_t
 RenderManager::RecordAndPushPostPassCommandLists() noexcept
 {
-    D3D12_RESOURCE_BARRIER barriers[4U];
-    std::uint32_t barrierCount = 0UL;
-    if (ResourceStateManager::GetResourceState(*GetCurrentFrameBuffer()) != D3D12_RESOURCE_STATE_PRESENT) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*GetCurrentFrameBuffer(),
-                                                                                        D3D12_RESOURCE_STATE_PRESENT);
-        ++barrierCount;
-    }
+    mPostPassResourceStateTracker.Reset();
+    mPostPassResourceStateTracker.ChangeResourceState(*GetCurrentFrameBuffer(),
+                                                      D3D12_RESOURCE_STATE_PRESENT);
 
-    if (barrierCount > 0UL) {
-        ID3D12GraphicsCommandList& commandList = mPostPassCommandListPerFrame.ResetCommandListWithNextCommandAllocator(nullptr);
-        commandList.ResourceBarrier(barrierCount, barriers);
-        BRE_CHECK_HR(commandList.Close());
-        CommandListExecutor::Get().PushCommandList(commandList);
+    CommandListExecutor::Get().PushResourceStateTransitions(mPostPassResourceStateTracker);
 
-        return 1U;
-    }
-
-    return 0U;
+    return 1U;
 }
 
 void
@@ -503,6 +544,61 @@ RenderManager::FlushCommandQueue() noexcept
     CommandListExecutor::Get().SignalFenceAndWaitForCompletion(*mFence,
                                                                mCurrentFenceValue,
                                                                mCurrentFenceValue);
+
+    // The GPU finished all the frames, so all the deferred releases can run.
+    DeferredReleaseQueue& deferredReleaseQueue = ResourceManager::GetDeferredReleaseQueue();
+    deferredReleaseQueue.SetFrameFenceValue(mCurrentFenceValue + 1UL);
+    deferredReleaseQueue.ReleaseCompleted(mCurrentFenceValue);
+}
+
+void
+RenderManager::ReplacePendingGeometryCommandListRecorders() noexcept
+{
+    std::lock_guard<std::mutex> lock(mPendingGeometryCommandListRecordersMutex);
+    if (mPendingGeometryCommandListRecorders.empty()) {
+        return;
+    }
+
+    mGeometryPass.ReplaceCommandListRecorders(mPendingGeometryCommandListRecorders);
+
+    // Command lists of the queued frames could use the replaced recorders,
+    // so they are destroyed once the GPU finished them.
+    GeometryCommandListRecorders replacedRecorders;
+    replacedRecorders.swap(mPendingGeometryCommandListRecorders);
+    ResourceManager::GetDeferredReleaseQueue().Enqueue([replacedRecorders]() mutable {
+        replacedRecorders.clear();
+    });
+}
+
+DirectX::XMFLOAT3
+RenderManager::GetCameraPosition() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mCameraPositionMutex);
+    return mCameraPosition;
+}
+
+void
+RenderManager::UpdateCameraPosition() noexcept
+{
+    const XMFLOAT4 cameraPosition = mCamera.GetPosition4f();
+
+    std::lock_guard<std::mutex> lock(mCameraPositionMutex);
+    mCameraPosition = XMFLOAT3(cameraPosition.x, cameraPosition.y, cameraPosition.z);
+}
+
+void
+RenderManager::WaitWhileSuspended() noexcept
+{
+    // Scene data is replaced while suspended, so the GPU must finish the queued frames first.
+    FlushCommandQueue();
+
+    mIsSuspended = true;
+    while (mIsSuspended && mTerminate == false) {
+        Sleep(0U);
+    }
+
+    // Suspended time is not elapsed frame time
+    mTimer.Reset();
 }
 
 void
@@ -530,5 +626,11 @@ RenderManager::PresentCurrentFrameAndBeginNextFrame() noexcept
     CommandListExecutor::Get().SignalFenceAndWaitForCompletion(*mFence,
                                                                mCurrentFenceValue,
                                                                oldestFence);
+
+    // Objects released while the next frame is recorded could be used by it,
+    // and objects released in finished frames are not used by the GPU anymore.
+    DeferredReleaseQueue& deferredReleaseQueue = ResourceManager::GetDeferredReleaseQueue();
+    deferredReleaseQueue.SetFrameFenceValue(mCurrentFenceValue + 1UL);
+    deferredReleaseQueue.ReleaseCompleted(mFence->GetCompletedValue());
 }
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <d3d12.h>
 #include <dxgi1_4.h>
+#include <mutex>
 #include <tbb/task.h>
 #include <wrl.h>
 
@@ -13,6 +15,7 @@
 #include <GeometryPass\GeometryPass.h>
 #include <PostProcesspass\PostProcesspass.h>
 #include <ReflectionPass\ReflectionPass.h>
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
 #include <SkyBoxPass\SkyBoxPass.h>
 #include <ShaderUtils\CBuffers.h>
 #include <ToneMappingPass\ToneMappingPass.h>
@@ -52,6 +55,44 @@ public:
     ///
     void Terminate() noexcept;
 
+    ///
+    /// @brief Replaces the geometry pass command list recorders, like the ones of a reloaded scene
+    ///
+    /// They are replaced by the master render task before its next frame, so it can be called
+    /// from any thread. Replaced recorders are destroyed once the GPU finished the frames that could use them.
+    ///
+    /// @param commandListRecorders Geometry pass command list recorders. It must not be empty.
+    ///
+    void ReplaceGeometryCommandListRecorders(const GeometryCommandListRecorders& commandListRecorders) noexcept;
+
+    ///
+    /// @brief Suspends rendering, like before the scene is switched
+    ///
+    /// It waits until the master render task finished its queued frames, so the GPU
+    /// is not using the scene anymore. Rendering stays suspended until Resume() is called.
+    ///
+    void Suspend() noexcept;
+
+    ///
+    /// @brief Resumes rendering with another scene
+    ///
+    /// Suspend() must be called first. Passes keep their buffers, pipeline states and
+    /// descriptors, and only the scene data (geometry pass recorders, environment cube maps
+    /// and camera) is replaced. Pending geometry pass recorders of the previous scene are discarded.
+    ///
+    /// @param scene Scene to render
+    ///
+    void Resume(Scene& scene) noexcept;
+
+    ///
+    /// @brief Get the camera position, updated by the master render task each frame.
+    ///
+    /// It can be called from any thread, like to stream the scene around the camera.
+    ///
+    /// @return Camera position
+    ///
+    DirectX::XMFLOAT3 GetCameraPosition() const noexcept;
+
 private:
     explicit RenderManager(Scene& scene);
 
@@ -121,9 +162,9 @@ private:
     std::uint32_t RecordAndPushPrePassCommandLists() noexcept;
 
     ///
-    /// @brief Records post pass command lists and pushes them to 
+    /// @brief Pushes post pass resource state transitions to
     /// the CommandListExecutor.
-    /// @return The number of recorded command lists
+    /// @return The number of pushed command lists
     ///
     std::uint32_t RecordAndPushPostPassCommandLists() noexcept;
 
@@ -132,6 +173,21 @@ private:
     ///
     void FlushCommandQueue() noexcept;
 
+    ///
+    /// @brief Replaces the geometry pass command list recorders by the pending ones, if any.
+    ///
+    void ReplacePendingGeometryCommandListRecorders() noexcept;
+
+    ///
+    /// @brief Flushes the command queue and waits until Resume() is called
+    ///
+    void WaitWhileSuspended() noexcept;
+
+    ///
+    /// @brief Copies the camera position for GetCameraPosition()
+    ///
+    void UpdateCameraPosition() noexcept;
+
     ///
     /// @brief Presents current frame and continue with the next frame.
     ///
@@ -155,7 +211,8 @@ private:
     PostProcessPass mPostProcessPass;
 
     CommandListPerFrame mPrePassCommandListPerFrame;
-    CommandListPerFrame mPostPassCommandListPerFrame;
+    CommandListResourceStateTracker mPrePassResourceStateTracker;
+    CommandListResourceStateTracker mPostPassResourceStateTracker;
 
     ID3D12Resource* mFrameBuffers[ApplicationSettings::sSwapChainBufferCount]{ nullptr };
     D3D12_CPU_DESCRIPTOR_HANDLE mFrameBufferRenderTargetViews[ApplicationSettings::sSwapChainBufferCount]{ 0UL };
@@ -179,6 +236,18 @@ private:
     Camera mCamera;
     Timer mTimer;
 
+    // Copy of the camera position, for other threads
+    DirectX::XMFLOAT3 mCameraPosition{ 0.0f, 0.0f, 0.0f };
+    mutable std::mutex mCameraPositionMutex;
+
+    // Geometry pass recorders that replace the current ones before the next frame
+    GeometryCommandListRecorders mPendingGeometryCommandListRecorders;
+    std::mutex mPendingGeometryCommandListRecordersMutex;
+
+    // Suspension requested by Suspend(), and acknowledged by the master render task
+    std::atomic<bool> mIsSuspendRequested{ false };
+    std::atomic<bool> mIsSuspended{ false };
+
     // When it is true, master render thread is destroyed.
     bool mTerminate{ false };
 };
@@ -0,0 +1,835 @@
+#include "BlockCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+#include <limits>
+#include <tbb/parallel_for.h>
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+namespace BlockCompressor {
+namespace {
+// BC7 interpolation weights of 4 bits indices
+const std::uint32_t sBC7Weights[16U]{ 0U, 4U, 9U, 13U, 17U, 21U, 26U, 30U, 34U, 38U, 43U, 47U, 51U, 55U, 60U, 64U };
+
+///
+/// @brief Writes bits from the least significant bit of a block
+///
+struct BitWriter {
+    explicit BitWriter(std::uint8_t* data)
+        : mData(data)
+    {}
+
+    void Write(const std::uint32_t value,
+               const std::uint32_t bitCount) noexcept
+    {
+        for (std::uint32_t i = 0U; i < bitCount; ++i, ++mBitOffset) {
+            if ((value >> i) & 1U) {
+                mData[mBitOffset >> 3U] |= static_cast<std::uint8_t>(1U << (mBitOffset & 7U));
+            }
+        }
+    }
+
+    std::uint8_t* mData{ nullptr };
+    std::uint32_t mBitOffset{ 0U };
+};
+
+///
+/// @brief Reads bits from the least significant bit of a block
+///
+struct BitReader {
+    explicit BitReader(const std::uint8_t* data)
+        : mData(data)
+    {}
+
+    std::uint32_t Read(const std::uint32_t bitCount) noexcept
+    {
+        std::uint32_t value{ 0U };
+        for (std::uint32_t i = 0U; i < bitCount; ++i, ++mBitOffset) {
+            value |= ((mData[mBitOffset >> 3U] >> (mBitOffset & 7U)) & 1U) << i;
+        }
+
+        return value;
+    }
+
+    const std::uint8_t* mData{ nullptr };
+    std::uint32_t mBitOffset{ 0U };
+};
+
+///
+/// @brief Get the minimum and maximum value of each channel of a block
+/// @param texels 16 RGBA8 texels
+/// @param minTexel Output minimum RGBA8 texel
+/// @param maxTexel Output maximum RGBA8 texel
+///
+void
+GetMinMaxTexels(const std::uint8_t* texels,
+                std::uint8_t minTexel[4U],
+                std::uint8_t maxTexel[4U]) noexcept
+{
+    const __m128i* rows = reinterpret_cast<const __m128i*>(texels);
+    const __m128i row0 = _mm_loadu_si128(rows);
+    const __m128i row1 = _mm_loadu_si128(rows + 1);
+    const __m128i row2 = _mm_loadu_si128(rows + 2);
+    const __m128i row3 = _mm_loadu_si128(rows + 3);
+
+    __m128i minValues = _mm_min_epu8(_mm_min_epu8(row0, row1), _mm_min_epu8(row2, row3));
+    __m128i maxValues = _mm_max_epu8(_mm_max_epu8(row0, row1), _mm_max_epu8(row2, row3));
+
+    // Reduce the 4 texels of each register to 1
+    minValues = _mm_min_epu8(minValues, _mm_shuffle_epi32(minValues, _MM_SHUFFLE(1, 0, 3, 2)));
+    minValues = _mm_min_epu8(minValues, _mm_shuffle_epi32(minValues, _MM_SHUFFLE(2, 3, 0, 1)));
+    maxValues = _mm_max_epu8(maxValues, _mm_shuffle_epi32(maxValues, _MM_SHUFFLE(1, 0, 3, 2)));
+    maxValues = _mm_max_epu8(maxValues, _mm_shuffle_epi32(maxValues, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    const std::int32_t minTexelValue = _mm_cvtsi128_si32(minValues);
+    const std::int32_t maxTexelValue = _mm_cvtsi128_si32(maxValues);
+    std::memcpy(minTexel, &minTexelValue, 4U);
+    std::memcpy(maxTexel, &maxTexelValue, 4U);
+}
+
+///
+/// @brief Swaps the minimum and maximum values of the channels that decrease when the
+/// channel with the greatest range increases, so the endpoints are the diagonal
+/// of the bounding box that follows the block colors.
+/// @param texels 16 RGBA8 texels
+/// @param channelCount Number of channels to check, in RGBA order
+/// @param minTexel First endpoint. Its input is the minimum RGBA8 texel.
+/// @param maxTexel Second endpoint. Its input is the maximum RGBA8 texel.
+///
+void
+SelectBoundingBoxDiagonal(const std::uint8_t* texels,
+                          const std::uint32_t channelCount,
+                          std::uint8_t minTexel[4U],
+                          std::uint8_t maxTexel[4U]) noexcept
+{
+    std::uint32_t referenceChannel{ 0U };
+    std::int32_t channelSums[4U]{};
+    for (std::uint32_t i = 0U; i < channelCount; ++i) {
+        if (maxTexel[i] - minTexel[i] > maxTexel[referenceChannel] - minTexel[referenceChannel]) {
+            referenceChannel = i;
+        }
+
+        for (std::uint32_t j = 0U; j < sBlockTexelCount; ++j) {
+            channelSums[i] += texels[j * 4U + i];
+        }
+    }
+
+    // Covariances are scaled by the texel count, so they are computed with integers.
+    for (std::uint32_t i = 0U; i < channelCount; ++i) {
+        std::int32_t covariance{ 0 };
+        for (std::uint32_t j = 0U; j < sBlockTexelCount; ++j) {
+            covariance += (texels[j * 4U + referenceChannel] * static_cast<std::int32_t>(sBlockTexelCount) - channelSums[referenceChannel]) *
+                          (texels[j * 4U + i] * static_cast<std::int32_t>(sBlockTexelCount) - channelSums[i]) / static_cast<std::int32_t>(sBlockTexelCount);
+        }
+
+        if (covariance < 0) {
+            std::swap(minTexel[i], maxTexel[i]);
+        }
+    }
+}
+
+std::uint32_t
+GetSquaredDistance(const std::uint8_t* a,
+                   const std::uint8_t* b,
+                   const std::uint32_t channelCount) noexcept
+{
+    std::uint32_t distance{ 0U };
+    for (std::uint32_t i = 0U; i < channelCount; ++i) {
+        const std::int32_t difference = static_cast<std::int32_t>(a[i]) - static_cast<std::int32_t>(b[i]);
+        distance += static_cast<std::uint32_t>(difference * difference);
+    }
+
+    return distance;
+}
+
+std::uint16_t
+ToRgb565(const std::uint8_t* color) noexcept
+{
+    const std::uint32_t r = (color[0U] * 31U + 127U) / 255U;
+    const std::uint32_t g = (color[1U] * 63U + 127U) / 255U;
+    const std::uint32_t b = (color[2U] * 31U + 127U) / 255U;
+
+    return static_cast<std::uint16_t>((r << 11U) | (g << 5U) | b);
+}
+
+void
+FromRgb565(const std::uint16_t value,
+           std::uint8_t* color) noexcept
+{
+    const std::uint32_t r = (value >> 11U) & 31U;
+    const std::uint32_t g = (value >> 5U) & 63U;
+    const std::uint32_t b = value & 31U;
+    color[0U] = static_cast<std::uint8_t>((r << 3U) | (r >> 2U));
+    color[1U] = static_cast<std::uint8_t>((g << 2U) | (g >> 4U));
+    color[2U] = static_cast<std::uint8_t>((b << 3U) | (b >> 2U));
+    color[3U] = 255U;
+}
+
+///
+/// @brief Get the palette of a BC1 color block
+/// @param color0 First endpoint
+/// @param color1 Second endpoint
+/// @param isOpaqueOnly True if the block is always decoded with 4 colors (BC2 and BC3)
+/// @param palette Output RGBA8 palette
+///
+void
+GetColorPalette(const std::uint16_t color0,
+                const std::uint16_t color1,
+                const bool isOpaqueOnly,
+                std::uint8_t palette[4U][4U]) noexcept
+{
+    FromRgb565(color0, palette[0U]);
+    FromRgb565(color1, palette[1U]);
+
+    if (color0 > color1 || isOpaqueOnly) {
+        for (std::uint32_t i = 0U; i < 3U; ++i) {
+            palette[2U][i] = static_cast<std::uint8_t>((2U * palette[0U][i] + palette[1U][i]) / 3U);
+            palette[3U][i] = static_cast<std::uint8_t>((palette[0U][i] + 2U * palette[1U][i]) / 3U);
+        }
+        palette[2U][3U] = 255U;
+        palette[3U][3U] = 255U;
+    } else {
+        for (std::uint32_t i = 0U; i < 3U; ++i) {
+            palette[2U][i] = static_cast<std::uint8_t>((palette[0U][i] + palette[1U][i]) / 2U);
+            palette[3U][i] = 0U;
+        }
+        palette[2U][3U] = 255U;
+        palette[3U][3U] = 0U;
+    }
+}
+
+///
+/// @brief Get the palette of a BC4 block
+/// @param value0 First endpoint
+/// @param value1 Second endpoint
+/// @param palette Output palette
+///
+void
+GetSingleChannelPalette(const std::uint8_t value0,
+                        const std::uint8_t value1,
+                        std::uint8_t palette[8U]) noexcept
+{
+    palette[0U] = value0;
+    palette[1U] = value1;
+
+    if (value0 > value1) {
+        for (std::uint32_t i = 2U; i < 8U; ++i) {
+            palette[i] = static_cast<std::uint8_t>(((8U - i) * value0 + (i - 1U) * value1 + 3U) / 7U);
+        }
+    } else {
+        for (std::uint32_t i = 2U; i < 6U; ++i) {
+            palette[i] = static_cast<std::uint8_t>(((6U - i) * value0 + (i - 1U) * value1 + 2U) / 5U);
+        }
+        palette[6U] = 0U;
+        palette[7U] = 255U;
+    }
+}
+
+///
+/// @brief Compresses the RGB channels of a block to a BC1 color block
+///
+/// Endpoints are the diagonal of the bounding box of the block colors, inset by 1/16
+/// of its size, and the block is always encoded with 4 colors.
+///
+/// @param texels 16 RGBA8 texels
+/// @param block Output 8 bytes block
+///
+void
+CompressColorBlock(const std::uint8_t* texels,
+                   std::uint8_t* block) noexcept
+{
+    std::uint8_t minTexel[4U];
+    std::uint8_t maxTexel[4U];
+    GetMinMaxTexels(texels, minTexel, maxTexel);
+
+    for (std::uint32_t i = 0U; i < 3U; ++i) {
+        const std::uint8_t inset = static_cast<std::uint8_t>((maxTexel[i] - minTexel[i]) >> 4U);
+        minTexel[i] = static_cast<std::uint8_t>(minTexel[i] + inset);
+        maxTexel[i] = static_cast<std::uint8_t>(maxTexel[i] - inset);
+    }
+    SelectBoundingBoxDiagonal(texels, 3U, minTexel, maxTexel);
+
+    std::uint16_t color0 = ToRgb565(maxTexel);
+    std::uint16_t color1 = ToRgb565(minTexel);
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    std::memset(block, 0, 8U);
+    block[0U] = static_cast<std::uint8_t>(color0 & 0xFFU);
+    block[1U] = static_cast<std::uint8_t>(color0 >> 8U);
+    block[2U] = static_cast<std::uint8_t>(color1 & 0xFFU);
+    block[3U] = static_cast<std::uint8_t>(color1 >> 8U);
+
+    // Equal endpoints would be decoded with 3 colors, so all indices refer to the first one.
+    if (color0 == color1) {
+        return;
+    }
+
+    std::uint8_t palette[4U][4U];
+    GetColorPalette(color0, color1, false, palette);
+
+    std::uint32_t indices{ 0U };
+    for (std::uint32_t i = 0U; i < sBlockTexelCount; ++i) {
+        std::uint32_t bestIndex{ 0U };
+        std::uint32_t bestDistance{ std::numeric_limits<std::uint32_t>::max() };
+        for (std::uint32_t j = 0U; j < 4U; ++j) {
+            const std::uint32_t distance = GetSquaredDistance(texels + i * 4U, palette[j], 3U);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                bestIndex = j;
+            }
+        }
+
+        indices |= bestIndex << (i * 2U);
+    }
+
+    std::memcpy(block + 4U, &indices, 4U);
+}
+
+void
+DecompressColorBlock(const std::uint8_t* block,
+                     const bool isOpaqueOnly,
+                     std::uint8_t* texels) noexcept
+{
+    const std::uint16_t color0 = static_cast<std::uint16_t>(block[0U] | (block[1U] << 8U));
+    const std::uint16_t color1 = static_cast<std::uint16_t>(block[2U] | (block[3U] << 8U));
+
+    std::uint8_t palette[4U][4U];
+    GetColorPalette(color0, color1, isOpaqueOnly, palette);
+
+    std::uint32_t indices;
+    std::memcpy(&indices, block + 4U, 4U);
+    for (std::uint32_t i = 0U; i < sBlockTexelCount; ++i) {
+        std::memcpy(texels + i * 4U, palette[(indices >> (i * 2U)) & 3U], 4U);
+    }
+}
+
+///
+/// @brief Compresses a channel of a block to a BC4 block
+///
+/// Endpoints are the minimum and maximum values, and the block
+/// is always encoded with 8 values.
+///
+/// @param texels 16 RGBA8 texels
+/// @param channel Channel to compress
+/// @param minValue Minimum value of the channel
+/// @param maxValue Maximum value of the channel
+/// @param block Output 8 bytes block
+///
+void
+CompressSingleChannelBlock(const std::uint8_t* texels,
+                           const std::uint32_t channel,
+                           const std::uint8_t minValue,
+                           const std::uint8_t maxValue,
+                           std::uint8_t* block) noexcept
+{
+    std::memset(block, 0, 8U);
+    block[0U] = maxValue;
+    block[1U] = minValue;
+
+    // Equal endpoints would be decoded with 6 values, so all indices refer to the first one.
+    if (maxValue == minValue) {
+        return;
+    }
+
+    // Palette values are sorted from the minimum value (index 1),
+    // through indices 7 to 2, to the maximum value (index 0).
+    const std::uint32_t range = maxValue - minValue;
+    std::uint64_t indices{ 0UL };
+    for (std::uint32_t i = 0U; i < sBlockTexelCount; ++i) {
+        const std::uint32_t value = texels[i * 4U + channel];
+        const std::uint32_t step = ((value - minValue) * 7U + range / 2U) / range;
+        const std::uint64_t index = step == 7U ? 0U : (step == 0U ? 1U : 8U - step);
+        indices |= index << (i * 3U);
+    }
+
+    for (std::uint32_t i = 0U; i < 6U; ++i) {
+        block[2U + i] = static_cast<std::uint8_t>(indices >> (i * 8U));
+    }
+}
+
+void
+DecompressSingleChannelBlock(const std::uint8_t* block,
+                             const std::uint32_t channel,
+                             std::uint8_t* texels) noexcept
+{
+    std::uint8_t palette[8U];
+    GetSingleChannelPalette(block[0U], block[1U], palette);
+
+    std::uint64_t indices{ 0UL };
+    for (std::uint32_t i = 0U; i < 6U; ++i) {
+        indices |= static_cast<std::uint64_t>(block[2U + i]) << (i * 8U);
+    }
+
+    for (std::uint32_t i = 0U; i < sBlockTexelCount; ++i) {
+        texels[i * 4U + channel] = palette[(indices >> (i * 3U)) & 7U];
+    }
+}
+
+///
+/// @brief Quantizes a BC7 mode 6 endpoint to 7 bits per channel and a p-bit
+/// @param color RGBA8 color
+/// @param quantizedColor Output 7 bits channels
+/// @return P-bit with the lowest error
+///
+std::uint32_t
+QuantizeBC7Endpoint(const std::uint8_t* color,
+                    std::uint32_t quantizedColor[4U]) noexcept
+{
+    std::uint32_t bestPBit{ 0U };
+    std::uint32_t bestError{ std::numeric_limits<std::uint32_t>::max() };
+    for (std::uint32_t pBit = 0U; pBit < 2U; ++pBit) {
+        std::uint32_t error{ 0U };
+        std::uint32_t channels[4U];
+        for (std::uint32_t i = 0U; i < 4U; ++i) {
+            const std::int32_t value = (static_cast<std::int32_t>(color[i]) - static_cast<std::int32_t>(pBit) + 1) >> 1;
+            channels[i] = static_cast<std::uint32_t>(std::min(std::max(value, 0), 127));
+            const std::int32_t difference = static_cast<std::int32_t>((channels[i] << 1U) | pBit) - color[i];
+            error += static_cast<std::uint32_t>(difference * difference);
+        }
+
+        if (error < bestError) {
+            bestError = error;
+            bestPBit = pBit;
+            std::memcpy(quantizedColor, channels, sizeof(channels));
+        }
+    }
+
+    return bestPBit;
+}
+
+void
+GetBC7Palette(const std::uint32_t endpoints[2U][4U],
+              const std::uint32_t pBits[2U],
+              std::uint8_t palette[16U][4U]) noexcept
+{
+    std::uint32_t colors[2U][4U];
+    for (std::uint32_t i = 0U; i < 2U; ++i) {
+        for (std::uint32_t j = 0U; j < 4U; ++j) {
+            colors[i][j] = (endpoints[i][j] << 1U) | pBits[i];
+        }
+    }
+
+    for (std::uint32_t i = 0U; i < 16U; ++i) {
+        for (std::uint32_t j = 0U; j < 4U; ++j) {
+            palette[i][j] = static_cast<std::uint8_t>(((64U - sBC7Weights[i]) * colors[0U][j] + sBC7Weights[i] * colors[1U][j] + 32U) >> 6U);
+        }
+    }
+}
+
+///
+/// @brief Get the BC7 mode 6 indices of a block
+/// @param texels 16 RGBA8 texels
+/// @param endpoints Quantized endpoints
+/// @param pBits P-bits of the endpoints
+/// @param indices Output indices
+/// @return Squared error of the block
+///
+std::uint32_t
+GetBC7Indices(const std::uint8_t* texels,
+              const std::uint32_t endpoints[2U][4U],
+              const std::uint32_t pBits[2U],
+              std::uint32_t indices[sBlockTexelCount]) noexcept
+{
+    std::uint8_t palette[16U][4U];
+    GetBC7Palette(endpoints, pBits, palette);
+
+    std::int32_t axis[4U];
+    std::int32_t axisLengthSquared{ 0 };
+    for (std::uint32_t i = 0U; i < 4U; ++i) {
+        axis[i] = static_cast<std::int32_t>(palette[15U][i]) - static_cast<std::int32_t>(palette[0U][i]);
+        axisLengthSquared += axis[i] * axis[i];
+    }
+
+    std::uint32_t error{ 0U };
+    for (std::uint32_t i = 0U; i < sBlockTexelCount; ++i) {
+        const std::uint8_t* texel = texels + i * 4U;
+        std::uint32_t index{ 0U };
+        if (axisLengthSquared > 0) {
+            std::int32_t projection{ 0 };
+            for (std::uint32_t j = 0U; j < 4U; ++j) {
+                projection += (static_cast<std::int32_t>(texel[j]) - static_cast<std::int32_t>(palette[0U][j])) * axis[j];
+            }
+
+            index = static_cast<std::uint32_t>(std::min(std::max((projection * 15 + axisLengthSquared / 2) / axisLengthSquared, 0), 15));
+        }
+
+        // Weights are not uniform, so neighbour indices are checked too.
+        std::uint32_t bestIndex = index;
+        std::uint32_t bestDistance = GetSquaredDistance(texel, palette[index], 4U);
+        if (index > 0U) {
+            const std::uint32_t distance = GetSquaredDistance(texel, palette[index - 1U], 4U);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                bestIndex = index - 1U;
+            }
+        }
+        if (index < 15U) {
+            const std::uint32_t distance = GetSquaredDistance(texel, palette[index + 1U], 4U);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                bestIndex = index + 1U;
+            }
+        }
+
+        indices[i] = bestIndex;
+        error += bestDistance;
+    }
+
+    return error;
+}
+
+///
+/// @brief Fits the endpoints to the indices of a block with least squares
+/// @param texels 16 RGBA8 texels
+/// @param indices Indices
+/// @param minTexel Output first endpoint
+/// @param maxTexel Output second endpoint
+/// @return True if the endpoints were fitted. Otherwise (all the indices are equal), false.
+///
+bool
+FitBC7Endpoints(const std::uint8_t* texels,
+                const std::uint32_t indices[sBlockTexelCount],
+                std::uint8_t minTexel[4U],
+                std::uint8_t maxTexel[4U]) noexcept
+{
+    float a{ 0.0f };
+    float b{ 0.0f };
+    float c{ 0.0f };
+    float rhs0[4U]{};
+    float rhs1[4U]{};
+    for (std::uint32_t i = 0U; i < sBlockTexelCount; ++i) {
+        const float weight = sBC7Weights[indices[i]] / 64.0f;
+        a += (1.0f - weight) * (1.0f - weight);
+        b += (1.0f - weight) * weight;
+        c += weight * weight;
+        for (std::uint32_t j = 0U; j < 4U; ++j) {
+            rhs0[j] += (1.0f - weight) * texels[i * 4U + j];
+            rhs1[j] += weight * texels[i * 4U + j];
+        }
+    }
+
+    const float determinant = a * c - b * b;
+    if (std::fabs(determinant) < 1e-6f) {
+        return false;
+    }
+
+    for (std::uint32_t i = 0U; i < 4U; ++i) {
+        const float value0 = (c * rhs0[i] - b * rhs1[i]) / determinant;
+        const float value1 = (a * rhs1[i] - b * rhs0[i]) / determinant;
+        minTexel[i] = static_cast<std::uint8_t>(std::min(std::max(value0 + 0.5f, 0.0f), 255.0f));
+        maxTexel[i] = static_cast<std::uint8_t>(std::min(std::max(value1 + 0.5f, 0.0f), 255.0f));
+    }
+
+    return true;
+}
+
+///
+/// @brief Compresses a block to a BC7 mode 6 block
+///
+/// Endpoints are the diagonal of the bounding box of the block, and they are
+/// refined once with least squares. Indices are the projection on the endpoints axis,
+/// refined against the palette.
+///
+/// @param texels 16 RGBA8 texels
+/// @param block Output 16 bytes block
+///
+void
+CompressBC7Block(const std::uint8_t* texels,
+                 std::uint8_t* block) noexcept
+{
+    std::uint8_t minTexel[4U];
+    std::uint8_t maxTexel[4U];
+    GetMinMaxTexels(texels, minTexel, maxTexel);
+    SelectBoundingBoxDiagonal(texels, 4U, minTexel, maxTexel);
+
+    std::uint32_t endpoints[2U][4U];
+    std::uint32_t pBits[2U];
+    pBits[0U] = QuantizeBC7Endpoint(minTexel, endpoints[0U]);
+    pBits[1U] = QuantizeBC7Endpoint(maxTexel, endpoints[1U]);
+
+    std::uint32_t indices[sBlockTexelCount];
+    const std::uint32_t error = GetBC7Indices(texels, endpoints, pBits, indices);
+
+    if (error > 0U && FitBC7Endpoints(texels, indices, minTexel, maxTexel)) {
+        std::uint32_t fittedEndpoints[2U][4U];
+        std::uint32_t fittedPBits[2U];
+        fittedPBits[0U] = QuantizeBC7Endpoint(minTexel, fittedEndpoints[0U]);
+        fittedPBits[1U] = QuantizeBC7Endpoint(maxTexel, fittedEndpoints[1U]);
+
+        std::uint32_t fittedIndices[sBlockTexelCount];
+        if (GetBC7Indices(texels, fittedEndpoints, fittedPBits, fittedIndices) < error) {
+            std::memcpy(endpoints, fittedEndpoints, sizeof(endpoints));
+            std::memcpy(pBits, fittedPBits, sizeof(pBits));
+            std::memcpy(indices, fittedIndices, sizeof(indices));
+        }
+    }
+
+    // The most significant bit of the anchor index (texel 0) is implicitly 0,
+    // so endpoints are swapped if needed. Weights are symmetric.
+    if (indices[0U] >= 8U) {
+        std::swap(endpoints[0U], endpoints[1U]);
+        std::swap(pBits[0U], pBits[1U]);
+        for (std::uint32_t i = 0U; i < sBlockTexelCount; ++i) {
+            indices[i] = 15U - indices[i];
+        }
+    }
+
+    std::memset(block, 0, 16U);
+    BitWriter bitWriter(block);
+    bitWriter.Write(1U << 6U, 7U); // Mode 6
+    for (std::uint32_t i = 0U; i < 4U; ++i) {
+        bitWriter.Write(endpoints[0U][i], 7U);
+        bitWriter.Write(endpoints[1U][i], 7U);
+    }
+    bitWriter.Write(pBits[0U], 1U);
+    bitWriter.Write(pBits[1U], 1U);
+    bitWriter.Write(indices[0U], 3U);
+    for (std::uint32_t i = 1U; i < sBlockTexelCount; ++i) {
+        bitWriter.Write(indices[i], 4U);
+    }
+    BRE_ASSERT(bitWriter.mBitOffset == 128U);
+}
+
+void
+DecompressBC7Block(const std::uint8_t* block,
+                   std::uint8_t* texels) noexcept
+{
+    BitReader bitReader(block);
+
+    // Other modes are not supported, and they are decoded as transparent black
+    if (bitReader.Read(7U) != (1U << 6U)) {
+        std::memset(texels, 0, sBlockTexelCount * 4U);
+        return;
+    }
+
+    std::uint32_t endpoints[2U][4U];
+    std::uint32_t pBits[2U];
+    for (std::uint32_t i = 0U; i < 4U; ++i) {
+        endpoints[0U][i] = bitReader.Read(7U);
+        endpoints[1U][i] = bitReader.Read(7U);
+    }
+    pBits[0U] = bitReader.Read(1U);
+    pBits[1U] = bitReader.Read(1U);
+
+    std::uint8_t palette[16U][4U];
+    GetBC7Palette(endpoints, pBits, palette);
+
+    for (std::uint32_t i = 0U; i < sBlockTexelCount; ++i) {
+        const std::uint32_t index = bitReader.Read(i == 0U ? 3U : 4U);
+        std::memcpy(texels + i * 4U, palette[index], 4U);
+    }
+}
+}
+
+std::uint32_t
+GetBlockSizeInBytes(const Format format) noexcept
+{
+    return format == Format::BC1 || format == Format::BC4 ? 8U : 16U;
+}
+
+std::uint32_t
+GetChannelCount(const Format format) noexcept
+{
+    switch (format) {
+    case Format::BC1:
+        return 3U;
+    case Format::BC4:
+        return 1U;
+    case Format::BC5:
+        return 2U;
+    default:
+        return 4U;
+    }
+}
+
+std::size_t
+GetCompressedSizeInBytes(const Format format,
+                         const std::uint32_t width,
+                         const std::uint32_t height) noexcept
+{
+    const std::size_t blocksWide = (width + sBlockDimension - 1U) / sBlockDimension;
+    const std::size_t blocksHigh = (height + sBlockDimension - 1U) / sBlockDimension;
+
+    return blocksWide * blocksHigh * GetBlockSizeInBytes(format);
+}
+
+void
+CompressBlock(const Format format,
+              const std::uint8_t* texels,
+              std::uint8_t* block) noexcept
+{
+    BRE_ASSERT(texels != nullptr);
+    BRE_ASSERT(block != nullptr);
+
+    switch (format) {
+    case Format::BC1:
+        CompressColorBlock(texels, block);
+        break;
+    case Format::BC3:
+    {
+        std::uint8_t minTexel[4U];
+        std::uint8_t maxTexel[4U];
+        GetMinMaxTexels(texels, minTexel, maxTexel);
+        CompressSingleChannelBlock(texels, 3U, minTexel[3U], maxTexel[3U], block);
+        CompressColorBlock(texels, block + 8U);
+        break;
+    }
+    case Format::BC4:
+    case Format::BC5:
+    {
+        std::uint8_t minTexel[4U];
+        std::uint8_t maxTexel[4U];
+        GetMinMaxTexels(texels, minTexel, maxTexel);
+        CompressSingleChannelBlock(texels, 0U, minTexel[0U], maxTexel[0U], block);
+        if (format == Format::BC5) {
+            CompressSingleChannelBlock(texels, 1U, minTexel[1U], maxTexel[1U], block + 8U);
+        }
+        break;
+    }
+    case Format::BC7:
+        CompressBC7Block(texels, block);
+        break;
+    default:
+        BRE_ASSERT(false);
+        break;
+    }
+}
+
+void
+DecompressBlock(const Format format,
+                const std::uint8_t* block,
+                std::uint8_t* texels) noexcept
+{
+    BRE_ASSERT(block != nullptr);
+    BRE_ASSERT(texels != nullptr);
+
+    switch (format) {
+    case Format::BC1:
+        DecompressColorBlock(block, false, texels);
+        break;
+    case Format::BC3:
+        DecompressColorBlock(block + 8U, true, texels);
+        DecompressSingleChannelBlock(block, 3U, texels);
+        break;
+    case Format::BC4:
+    case Format::BC5:
+        for (std::uint32_t i = 0U; i < sBlockTexelCount; ++i) {
+            texels[i * 4U + 1U] = 0U;
+            texels[i * 4U + 2U] = 0U;
+            texels[i * 4U + 3U] = 255U;
+        }
+        DecompressSingleChannelBlock(block, 0U, texels);
+        if (format == Format::BC5) {
+            DecompressSingleChannelBlock(block + 8U, 1U, texels);
+        }
+        break;
+    case Format::BC7:
+        DecompressBC7Block(block, texels);
+        break;
+    default:
+        BRE_ASSERT(false);
+        break;
+    }
+}
+
+void
+CompressImage(const Format format,
+              const std::uint8_t* texels,
+              const std::uint32_t width,
+              const std::uint32_t height,
+              const std::size_t rowPitch,
+              std::uint8_t* blocks) noexcept
+{
+    BRE_ASSERT(texels != nullptr);
+    BRE_ASSERT(blocks != nullptr);
+    BRE_ASSERT(width > 0U && height > 0U);
+
+    const std::uint32_t blocksWide = (width + sBlockDimension - 1U) / sBlockDimension;
+    const std::uint32_t blocksHigh = (height + sBlockDimension - 1U) / sBlockDimension;
+    const std::uint32_t blockSize = GetBlockSizeInBytes(format);
+
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, blocksHigh, 1U),
+                      [&](const tbb::blocked_range<size_t>& r) {
+        std::uint8_t blockTexels[sBlockTexelCount * 4U];
+        for (size_t blockY = r.begin(); blockY != r.end(); ++blockY) {
+            for (std::uint32_t blockX = 0U; blockX < blocksWide; ++blockX) {
+                for (std::uint32_t i = 0U; i < sBlockDimension; ++i) {
+                    const std::size_t y = std::min(static_cast<std::uint32_t>(blockY) * sBlockDimension + i, height - 1U);
+                    for (std::uint32_t j = 0U; j < sBlockDimension; ++j) {
+                        const std::size_t x = std::min(blockX * sBlockDimension + j, width - 1U);
+                        std::memcpy(blockTexels + (i * sBlockDimension + j) * 4U, texels + y * rowPitch + x * 4U, 4U);
+                    }
+                }
+
+                CompressBlock(format, blockTexels, blocks + (blockY * blocksWide + blockX) * blockSize);
+            }
+        }
+    });
+}
+
+void
+DecompressImage(const Format format,
+                const std::uint8_t* blocks,
+                const std::uint32_t width,
+                const std::uint32_t height,
+                std::uint8_t* texels) noexcept
+{
+    BRE_ASSERT(blocks != nullptr);
+    BRE_ASSERT(texels != nullptr);
+
+    const std::uint32_t blocksWide = (width + sBlockDimension - 1U) / sBlockDimension;
+    const std::uint32_t blocksHigh = (height + sBlockDimension - 1U) / sBlockDimension;
+    const std::uint32_t blockSize = GetBlockSizeInBytes(format);
+
+    std::uint8_t blockTexels[sBlockTexelCount * 4U];
+    for (std::uint32_t blockY = 0U; blockY < blocksHigh; ++blockY) {
+        for (std::uint32_t blockX = 0U; blockX < blocksWide; ++blockX) {
+            DecompressBlock(format, blocks + (blockY * blocksWide + blockX) * blockSize, blockTexels);
+
+            for (std::uint32_t i = 0U; i < sBlockDimension; ++i) {
+                const std::uint32_t y = blockY * sBlockDimension + i;
+                for (std::uint32_t j = 0U; j < sBlockDimension; ++j) {
+                    const std::uint32_t x = blockX * sBlockDimension + j;
+                    if (x < width && y < height) {
+                        std::memcpy(texels + (static_cast<std::size_t>(y) * width + x) * 4U,
+                                    blockTexels + (i * sBlockDimension + j) * 4U,
+                                    4U);
+                    }
+                }
+            }
+        }
+    }
+}
+
+double
+ComputePsnr(const std::uint8_t* texelsA,
+            const std::uint8_t* texelsB,
+            const std::size_t texelCount,
+            const std::uint32_t channelCount) noexcept
+{
+    BRE_ASSERT(texelsA != nullptr);
+    BRE_ASSERT(texelsB != nullptr);
+    BRE_ASSERT(texelCount > 0U);
+    BRE_ASSERT(channelCount > 0U && channelCount <= 4U);
+
+    double squaredErrorSum{ 0.0 };
+    for (std::size_t i = 0U; i < texelCount; ++i) {
+        squaredErrorSum += GetSquaredDistance(texelsA + i * 4U, texelsB + i * 4U, channelCount);
+    }
+
+    if (squaredErrorSum == 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    const double meanSquaredError = squaredErrorSum / (static_cast<double>(texelCount) * channelCount);
+
+    return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+}
+}
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace BRE {
+///
+/// @brief Block compression (BC) encoders and decoders.
+///
+/// Texels are RGBA8. Blocks are 4x4 texels.
+/// Encoders fit the endpoints to the bounding box of the block (SSE2),
+/// and images are compressed in parallel, one task per block row.
+///
+namespace BlockCompressor {
+///
+/// @brief Block compressed formats
+///
+enum class Format {
+    BC1 = 0, // RGB
+    BC3, // RGBA
+    BC4, // R
+    BC5, // RG
+    BC7, // RGBA. Only mode 6 is encoded and decoded (fast mode).
+};
+
+const std::uint32_t sBlockDimension{ 4U };
+const std::uint32_t sBlockTexelCount{ sBlockDimension * sBlockDimension };
+
+///
+/// @brief Get block size
+/// @param format Block compressed format
+/// @return Block size in bytes
+///
+std::uint32_t GetBlockSizeInBytes(const Format format) noexcept;
+
+///
+/// @brief Get the number of channels the format stores
+/// @param format Block compressed format
+/// @return Channel count. Channels are taken in RGBA order.
+///
+std::uint32_t GetChannelCount(const Format format) noexcept;
+
+///
+/// @brief Get compressed size of an image
+/// @param format Block compressed format
+/// @param width Image width
+/// @param height Image height
+/// @return Compressed size in bytes
+///
+std::size_t GetCompressedSizeInBytes(const Format format,
+                                     const std::uint32_t width,
+                                     const std::uint32_t height) noexcept;
+
+///
+/// @brief Compresses a block
+/// @param format Block compressed format
+/// @param texels 16 RGBA8 texels in row order. Must not be nullptr.
+/// @param block Output block. Its size must be GetBlockSizeInBytes(format).
+///
+void CompressBlock(const Format format,
+                   const std::uint8_t* texels,
+                   std::uint8_t* block) noexcept;
+
+///
+/// @brief Decompresses a block
+///
+/// Channels the format does not store are 0, except alpha, that is 255.
+///
+/// @param format Block compressed format
+/// @param block Block. Must not be nullptr.
+/// @param texels Output 16 RGBA8 texels in row order
+///
+void DecompressBlock(const Format format,
+                     const std::uint8_t* block,
+                     std::uint8_t* texels) noexcept;
+
+///
+/// @brief Compresses an image. Block rows are compressed in parallel.
+///
+/// Texels outside the image (if the size is not a multiple of 4) repeat the edge texels.
+///
+/// @param format Block compressed format
+/// @param texels RGBA8 texels. Must not be nullptr.
+/// @param width Image width
+/// @param height Image height
+/// @param rowPitch Texels row pitch in bytes
+/// @param blocks Output blocks. Its size must be GetCompressedSizeInBytes(format, width, height).
+///
+void CompressImage(const Format format,
+                   const std::uint8_t* texels,
+                   const std::uint32_t width,
+                   const std::uint32_t height,
+                   const std::size_t rowPitch,
+                   std::uint8_t* blocks) noexcept;
+
+///
+/// @brief Decompresses an image
+/// @param format Block compressed format
+/// @param blocks Blocks. Must not be nullptr.
+/// @param width Image width
+/// @param height Image height
+/// @param texels Output RGBA8 texels, tightly packed (width * 4 bytes per row)
+///
+void DecompressImage(const Format format,
+                     const std::uint8_t* blocks,
+                     const std::uint32_t width,
+                     const std::uint32_t height,
+                     std::uint8_t* texels) noexcept;
+
+///
+/// @brief Computes the peak signal to noise ratio between two RGBA8 images
+/// @param texelsA Texels of the first image. Must not be nullptr.
+/// @param texelsB Texels of the second image. Must not be nullptr.
+/// @param texelCount Number of texels of each image
+/// @param channelCount Number of channels to compare, in RGBA order
+/// @return PSNR in decibels. It is infinity if both images are equal.
+///
+double ComputePsnr(const std::uint8_t* texelsA,
+                   const std::uint8_t* texelsB,
+                   const std::size_t texelCount,
+                   const std::uint32_t channelCount) noexcept;
+}
+}
@@ -0,0 +1,364 @@
+#include "ChannelPacker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <emmintrin.h>
+#include <fstream>
+#include <Windows.h>
+
+#include <ResourceManager\BlockCompressor.h>
+#include <ResourceManager\DDSTextureLoader.h>
+#include <Utils\DebugUtils.h>
+#include <Utils\HashUtils.h>
+#include <Utils\MemoryMappedFile.h>
+#include <Utils\StringUtils.h>
+
+namespace BRE {
+namespace {
+const char* sCacheDirectory{ "texture_cache" };
+const char* sCacheFileExtension{ ".dds" };
+
+// DDS header fields, as 32 bits words after the magic number
+const std::uint32_t sDDSMagic{ 0x20534444U }; // "DDS "
+const std::uint32_t sDDSHeaderWordCount{ 32U }; // Magic number and DDS_HEADER
+const std::uint32_t sDDSDX10HeaderWordCount{ 5U };
+const std::uint32_t sDDSFourCCDX10{ 0x30315844U }; // "DX10"
+
+///
+/// @brief Writes the DDS headers of a RGBA8 2D texture
+/// @param width Texture width
+/// @param height Texture height
+/// @param mipLevelCount Texture mip level count
+/// @param ddsData Output DDS data
+///
+void
+WriteDDSHeaders(const std::uint32_t width,
+                const std::uint32_t height,
+                const std::uint32_t mipLevelCount,
+                std::vector<std::uint8_t>& ddsData) noexcept
+{
+    std::uint32_t header[sDDSHeaderWordCount + sDDSDX10HeaderWordCount]{};
+    header[0U] = sDDSMagic;
+    header[1U] = 124U; // DDS_HEADER size
+    header[2U] = 0x1007U | 0x8U | (mipLevelCount > 1U ? 0x20000U : 0U); // DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_PITCH | DDS_HEADER_FLAGS_MIPMAP
+    header[3U] = height;
+    header[4U] = width;
+    header[5U] = width * 4U;
+    header[7U] = mipLevelCount;
+    header[19U] = 32U; // DDS_PIXELFORMAT size
+    header[20U] = 0x4U; // DDS_FOURCC
+    header[21U] = sDDSFourCCDX10;
+    header[27U] = 0x1000U | (mipLevelCount > 1U ? 0x400008U : 0U);
+
+    // DDS_HEADER_DXT10
+    header[32U] = static_cast<std::uint32_t>(DXGI_FORMAT_R8G8B8A8_UNORM);
+    header[33U] = static_cast<std::uint32_t>(D3D12_RESOURCE_DIMENSION_TEXTURE2D);
+    header[35U] = 1U;
+
+    ddsData.assign(reinterpret_cast<const std::uint8_t*>(header),
+                   reinterpret_cast<const std::uint8_t*>(header) + sizeof(header));
+}
+
+///
+/// @brief Get the block compressed format of a DXGI format
+/// @param format DXGI format
+/// @param blockCompressorFormat Output block compressed format
+/// @return True if the DXGI format is a supported block compressed format. Otherwise, false.
+///
+bool
+GetBlockCompressorFormat(const DXGI_FORMAT format,
+                         BlockCompressor::Format& blockCompressorFormat) noexcept
+{
+    switch (format) {
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+        blockCompressorFormat = BlockCompressor::Format::BC1;
+        return true;
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+        blockCompressorFormat = BlockCompressor::Format::BC3;
+        return true;
+    case DXGI_FORMAT_BC4_UNORM:
+        blockCompressorFormat = BlockCompressor::Format::BC4;
+        return true;
+    default:
+        return false;
+    }
+}
+}
+
+std::string
+ChannelPacker::PackTextureFiles(const char* const sourceFilenames[sChannelCount],
+                                const std::uint64_t sourceContentHashes[sChannelCount],
+                                const std::uint8_t channelValues[sChannelCount],
+                                std::uint64_t& contentHash) noexcept
+{
+    BRE_ASSERT(sourceContentHashes != nullptr);
+    BRE_ASSERT(channelValues != nullptr);
+
+    MemoryMappedFile sourceFiles[sChannelCount];
+    const std::uint8_t* sourceData[sChannelCount]{};
+    std::size_t sourceDataSizes[sChannelCount]{};
+
+    // Packing settings are part of the hash, so changing them packs the textures again.
+    // Constant channels are hashed by their value, and textures by their content hash.
+    const std::uint32_t packSettings[]{ sVersion };
+    contentHash = HashUtils::ComputeHash(packSettings, sizeof(packSettings));
+    for (std::uint32_t i = 0U; i < sChannelCount; ++i) {
+        if (sourceFilenames[i] == nullptr) {
+            const std::uint32_t channelSettings[]{ 0U, channelValues[i] };
+            contentHash = HashUtils::ComputeHash(channelSettings, sizeof(channelSettings), contentHash);
+            continue;
+        }
+
+        const std::wstring errorMsg =
+            L"Texture to pack could not be opened: " + StringUtils::AnsiToWideString(sourceFilenames[i]);
+        BRE_CHECK_MSG(sourceFiles[i].Open(sourceFilenames[i]), errorMsg.c_str());
+
+        sourceData[i] = sourceFiles[i].GetData();
+        sourceDataSizes[i] = sourceFiles[i].GetSize();
+
+        const std::uint32_t channelSettings[]{ 1U };
+        contentHash = HashUtils::ComputeHash(channelSettings, sizeof(channelSettings), contentHash);
+        contentHash = HashUtils::ComputeHash(&sourceContentHashes[i], sizeof(sourceContentHashes[i]), contentHash);
+    }
+
+    const std::string packedFilename = HashUtils::GetCachedFilePath(sCacheDirectory, contentHash, sCacheFileExtension);
+    if (GetFileAttributesA(packedFilename.c_str()) != INVALID_FILE_ATTRIBUTES) {
+        return packedFilename;
+    }
+
+    std::vector<std::uint8_t> packedData;
+    std::wstring errorMsg = L"Textures could not be packed:";
+    for (std::uint32_t i = 0U; i < sChannelCount; ++i) {
+        if (sourceFilenames[i] != nullptr) {
+            errorMsg += L" " + StringUtils::AnsiToWideString(sourceFilenames[i]);
+        }
+    }
+    BRE_CHECK_MSG(PackTextures(sourceData, sourceDataSizes, channelValues, packedData), errorMsg.c_str());
+
+    for (std::uint32_t i = 0U; i < sChannelCount; ++i) {
+        sourceFiles[i].Close();
+    }
+
+    std::ofstream fileStream{ packedFilename, std::ios::out | std::ios::binary | std::ios::trunc };
+    BRE_CHECK_MSG(fileStream.is_open(), L"Packed texture file could not be created");
+    fileStream.write(reinterpret_cast<const char*>(packedData.data()), packedData.size());
+    if (fileStream.good() == false) {
+        fileStream.close();
+        DeleteFileA(packedFilename.c_str());
+        BRE_CHECK_MSG(false, L"Packed texture file could not be written");
+    }
+
+    return packedFilename;
+}
+
+bool
+ChannelPacker::PackTextures(const std::uint8_t* const sourceData[sChannelCount],
+                            const std::size_t sourceDataSizes[sChannelCount],
+                            const std::uint8_t channelValues[sChannelCount],
+                            std::vector<std::uint8_t>& packedData) noexcept
+{
+    BRE_ASSERT(channelValues != nullptr);
+
+    D3D12_RESOURCE_DESC textureDescriptors[sChannelCount]{};
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources[sChannelCount];
+
+    std::uint32_t width{ 0U };
+    std::uint32_t height{ 0U };
+    std::uint32_t mipLevelCount{ UINT32_MAX };
+    for (std::uint32_t i = 0U; i < sChannelCount; ++i) {
+        if (sourceData[i] == nullptr) {
+            continue;
+        }
+
+        if (FAILED(DirectX::LoadDDSTextureDataFromMemory12(sourceData[i],
+                                                           sourceDataSizes[i],
+                                                           textureDescriptors[i],
+                                                           subresources[i]))) {
+            return false;
+        }
+
+        // Only the first array slice is packed, so arrays and cube maps are not supported.
+        const D3D12_RESOURCE_DESC& textureDescriptor = textureDescriptors[i];
+        if (textureDescriptor.Dimension != D3D12_RESOURCE_DIMENSION_TEXTURE2D ||
+            textureDescriptor.DepthOrArraySize != 1U) {
+            return false;
+        }
+
+        width = std::max(width, static_cast<std::uint32_t>(textureDescriptor.Width));
+        height = std::max(height, textureDescriptor.Height);
+        mipLevelCount = std::min(mipLevelCount, static_cast<std::uint32_t>(textureDescriptor.MipLevels));
+    }
+
+    // Every channel is constant
+    if (mipLevelCount == UINT32_MAX) {
+        width = 1U;
+        height = 1U;
+        mipLevelCount = 1U;
+    }
+
+    const std::size_t headersSize = (sDDSHeaderWordCount + sDDSDX10HeaderWordCount) * sizeof(std::uint32_t);
+    WriteDDSHeaders(width, height, mipLevelCount, packedData);
+
+    std::size_t dataSize{ 0U };
+    for (std::uint32_t mipLevel = 0U; mipLevel < mipLevelCount; ++mipLevel) {
+        dataSize += static_cast<std::size_t>(std::max(width >> mipLevel, 1U)) * std::max(height >> mipLevel, 1U) * 4U;
+    }
+    packedData.resize(headersSize + dataSize);
+
+    std::size_t offset = headersSize;
+    std::vector<std::uint8_t> channels[sChannelCount];
+    for (std::uint32_t mipLevel = 0U; mipLevel < mipLevelCount; ++mipLevel) {
+        const std::uint32_t mipLevelWidth = std::max(width >> mipLevel, 1U);
+        const std::uint32_t mipLevelHeight = std::max(height >> mipLevel, 1U);
+
+        for (std::uint32_t i = 0U; i < sChannelCount; ++i) {
+            if (sourceData[i] == nullptr) {
+                continue;
+            }
+
+            const D3D12_RESOURCE_DESC& textureDescriptor = textureDescriptors[i];
+            if (ExtractChannel(subresources[i][mipLevel],
+                               textureDescriptor.Format,
+                               std::max(static_cast<std::uint32_t>(textureDescriptor.Width) >> mipLevel, 1U),
+                               std::max(textureDescriptor.Height >> mipLevel, 1U),
+                               mipLevelWidth,
+                               mipLevelHeight,
+                               channels[i]) == false) {
+                return false;
+            }
+        }
+
+        const std::size_t texelCount = static_cast<std::size_t>(mipLevelWidth) * mipLevelHeight;
+        PackChannels(sourceData[0U] != nullptr ? channels[0U].data() : nullptr,
+                     sourceData[1U] != nullptr ? channels[1U].data() : nullptr,
+                     sourceData[2U] != nullptr ? channels[2U].data() : nullptr,
+                     channelValues,
+                     texelCount,
+                     packedData.data() + offset);
+        offset += texelCount * 4U;
+    }
+
+    return true;
+}
+
+void
+ChannelPacker::PackChannels(const std::uint8_t* redChannel,
+                            const std::uint8_t* greenChannel,
+                            const std::uint8_t* blueChannel,
+                            const std::uint8_t channelValues[sChannelCount],
+                            const std::size_t texelCount,
+                            std::uint8_t* texels) noexcept
+{
+    BRE_ASSERT(channelValues != nullptr);
+    BRE_ASSERT(texels != nullptr);
+
+    // 16 texels per iteration: interleave red with green and blue with alpha
+    // to 16 bits pairs, and then both pairs to 32 bits texels.
+    const __m128i redValue = _mm_set1_epi8(static_cast<char>(channelValues[0U]));
+    const __m128i greenValue = _mm_set1_epi8(static_cast<char>(channelValues[1U]));
+    const __m128i blueValue = _mm_set1_epi8(static_cast<char>(channelValues[2U]));
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+    std::size_t i = 0UL;
+    for (; i + 16UL <= texelCount; i += 16UL) {
+        const __m128i red = redChannel != nullptr ?
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(redChannel + i)) :
+            redValue;
+        const __m128i green = greenChannel != nullptr ?
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(greenChannel + i)) :
+            greenValue;
+        const __m128i blue = blueChannel != nullptr ?
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(blueChannel + i)) :
+            blueValue;
+
+        const __m128i redGreenLow = _mm_unpacklo_epi8(red, green);
+        const __m128i redGreenHigh = _mm_unpackhi_epi8(red, green);
+        const __m128i blueAlphaLow = _mm_unpacklo_epi8(blue, alpha);
+        const __m128i blueAlphaHigh = _mm_unpackhi_epi8(blue, alpha);
+
+        __m128i* destination = reinterpret_cast<__m128i*>(texels + i * 4UL);
+        _mm_storeu_si128(destination, _mm_unpacklo_epi16(redGreenLow, blueAlphaLow));
+        _mm_storeu_si128(destination + 1, _mm_unpackhi_epi16(redGreenLow, blueAlphaLow));
+        _mm_storeu_si128(destination + 2, _mm_unpacklo_epi16(redGreenHigh, blueAlphaHigh));
+        _mm_storeu_si128(destination + 3, _mm_unpackhi_epi16(redGreenHigh, blueAlphaHigh));
+    }
+
+    for (; i < texelCount; ++i) {
+        texels[i * 4UL] = redChannel != nullptr ? redChannel[i] : channelValues[0U];
+        texels[i * 4UL + 1UL] = greenChannel != nullptr ? greenChannel[i] : channelValues[1U];
+        texels[i * 4UL + 2UL] = blueChannel != nullptr ? blueChannel[i] : channelValues[2U];
+        texels[i * 4UL + 3UL] = 255U;
+    }
+}
+
+std::uint8_t
+ChannelPacker::GetChannelValue(const float value) noexcept
+{
+    const float clampedValue = std::min(std::max(value, 0.0f), 1.0f);
+    return static_cast<std::uint8_t>(clampedValue * 255.0f + 0.5f);
+}
+
+bool
+ChannelPacker::ExtractChannel(const D3D12_SUBRESOURCE_DATA& subresource,
+                              const DXGI_FORMAT format,
+                              const std::uint32_t width,
+                              const std::uint32_t height,
+                              const std::uint32_t channelWidth,
+                              const std::uint32_t channelHeight,
+                              std::vector<std::uint8_t>& channel) noexcept
+{
+    const std::uint8_t* sourceTexels = static_cast<const std::uint8_t*>(subresource.pData);
+    std::size_t sourceRowPitch = static_cast<std::size_t>(subresource.RowPitch);
+    std::size_t sourceTexelSize{ 0U };
+
+    // Block compressed subresources are decompressed to RGBA8 first.
+    std::vector<std::uint8_t> decompressedTexels;
+    BlockCompressor::Format blockCompressorFormat{ BlockCompressor::Format::BC1 };
+    if (GetBlockCompressorFormat(format, blockCompressorFormat)) {
+        decompressedTexels.resize(static_cast<std::size_t>(width) * height * 4U);
+        BlockCompressor::DecompressImage(blockCompressorFormat,
+                                         sourceTexels,
+                                         width,
+                                         height,
+                                         decompressedTexels.data());
+        sourceTexels = decompressedTexels.data();
+        sourceRowPitch = static_cast<std::size_t>(width) * 4U;
+        sourceTexelSize = 4U;
+    } else {
+        switch (format) {
+        case DXGI_FORMAT_R8_UNORM:
+            sourceTexelSize = 1U;
+            break;
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+            sourceTexelSize = 4U;
+            break;
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8X8_UNORM:
+        case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+            // Red is the third byte.
+            sourceTexels += 2U;
+            sourceTexelSize = 4U;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    // Nearest texel resampling, if the channel size is different.
+    channel.resize(static_cast<std::size_t>(channelWidth) * channelHeight);
+    for (std::uint32_t y = 0U; y < channelHeight; ++y) {
+        const std::size_t sourceY = static_cast<std::size_t>(y) * height / channelHeight;
+        const std::uint8_t* sourceRow = sourceTexels + sourceY * sourceRowPitch;
+        std::uint8_t* destinationRow = channel.data() + static_cast<std::size_t>(y) * channelWidth;
+        for (std::uint32_t x = 0U; x < channelWidth; ++x) {
+            const std::size_t sourceX = static_cast<std::size_t>(x) * width / channelWidth;
+            destinationRow[x] = sourceRow[sourceX * sourceTexelSize];
+        }
+    }
+
+    return true;
+}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <string>
+#include <vector>
+
+namespace BRE {
+///
+/// @brief Responsible to pack the first channel of several DDS textures into the
+/// red, green and blue channels of one RGBA8 DDS texture.
+///
+/// A channel without source texture is filled with a constant value, so material
+/// parameters given as scalars do not need a texture file.
+///
+/// Packed textures are written to a cache directory, named after the content hash of
+/// the source textures, so they are only packed once, and modified source textures get
+/// a new packed texture.
+///
+/// The packed texture has the greatest width and height of the source textures, and the
+/// lowest mip level count. Source mip levels are resampled with the nearest texel if their sizes differ.
+/// If every channel is constant, then the packed texture is 1x1 with a single mip level.
+/// Supported source formats: R8, RGBA8, BGRA8, BGRX8, BC1, BC3 and BC4.
+///
+class ChannelPacker {
+public:
+    ChannelPacker() = delete;
+    ~ChannelPacker() = delete;
+    ChannelPacker(const ChannelPacker&) = delete;
+    const ChannelPacker& operator=(const ChannelPacker&) = delete;
+    ChannelPacker(ChannelPacker&&) = delete;
+    ChannelPacker& operator=(ChannelPacker&&) = delete;
+
+    static const std::uint32_t sVersion{ 2U };
+    static const std::uint32_t sChannelCount{ 3U };
+
+    ///
+    /// @brief Packs texture files, if they were not packed before
+    ///
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param sourceFilenames Source DDS texture filenames of the red, green and blue channels.
+    /// If a filename is nullptr, then its channel is constant.
+    /// @param sourceContentHashes Content hashes of the source textures (see AssetRegistry::GetContentHash()),
+    /// so they are not read again to identify the packed file. Hashes of constant channels are ignored.
+    /// @param channelValues Values of the constant channels
+    /// @param contentHash Output content hash of the packed texture, to identify the files generated from it
+    /// @return Packed texture filename
+    ///
+    static std::string PackTextureFiles(const char* const sourceFilenames[sChannelCount],
+                                        const std::uint64_t sourceContentHashes[sChannelCount],
+                                        const std::uint8_t channelValues[sChannelCount],
+                                        std::uint64_t& contentHash) noexcept;
+
+    ///
+    /// @brief Packs DDS texture data
+    /// @param sourceData Source DDS texture data of the red, green and blue channels.
+    /// If a source data is nullptr, then its channel is constant.
+    /// @param sourceDataSizes Source DDS texture data sizes in bytes
+    /// @param channelValues Values of the constant channels
+    /// @param packedData Output RGBA8 DDS texture data
+    /// @return True if the textures were packed. Otherwise (a source format is not supported), false.
+    ///
+    static bool PackTextures(const std::uint8_t* const sourceData[sChannelCount],
+                             const std::size_t sourceDataSizes[sChannelCount],
+                             const std::uint8_t channelValues[sChannelCount],
+                             std::vector<std::uint8_t>& packedData) noexcept;
+
+    ///
+    /// @brief Interleaves channels to RGBA8 texels. Alpha is 255.
+    /// @param redChannel Red channel. If it is nullptr, then it is constant.
+    /// @param greenChannel Green channel. If it is nullptr, then it is constant.
+    /// @param blueChannel Blue channel. If it is nullptr, then it is constant.
+    /// @param channelValues Values of the constant channels
+    /// @param texelCount Number of texels
+    /// @param texels Output RGBA8 texels
+    ///
+    static void PackChannels(const std::uint8_t* redChannel,
+                             const std::uint8_t* greenChannel,
+                             const std::uint8_t* blueChannel,
+                             const std::uint8_t channelValues[sChannelCount],
+                             const std::size_t texelCount,
+                             std::uint8_t* texels) noexcept;
+
+    ///
+    /// @brief Get the value of a constant channel
+    /// @param value Value in [0.0, 1.0]. It is clamped.
+    /// @return Channel value
+    ///
+    static std::uint8_t GetChannelValue(const float value) noexcept;
+
+private:
+    ///
+    /// @brief Extracts the first channel of a subresource
+    /// @param subresource Subresource
+    /// @param format Subresource format
+    /// @param width Subresource width
+    /// @param height Subresource height
+    /// @param channelWidth Width of the extracted channel
+    /// @param channelHeight Height of the extracted channel
+    /// @param channel Output channel
+    /// @return True if the format is supported. Otherwise, false.
+    ///
+    static bool ExtractChannel(const D3D12_SUBRESOURCE_DATA& subresource,
+                               const DXGI_FORMAT format,
+                               const std::uint32_t width,
+                               const std::uint32_t height,
+                               const std::uint32_t channelWidth,
+                               const std::uint32_t channelHeight,
+                               std::vector<std::uint8_t>& channel) noexcept;
+};
+}
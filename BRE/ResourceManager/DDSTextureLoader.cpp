@@ -21,6 +21,7 @@
 #include <assert.h>
 #include <algorithm>
 #include <memory>
+#include <vector>
 #include <wrl.h>
 
 #include "DDSTextureLoader.h" 
@@ -1117,6 +1118,30 @@ static HRESULT CreateD3DResources(_In_ ID3D11Device* d3dDevice,
     return hr;
 }
 
+//--------------------------------------------------------------------------------------
+static void GetTextureDescriptor12(
+    _In_ std::size_t width,
+    _In_ std::size_t height,
+    _In_ std::size_t depth,
+    _In_ std::size_t mipCount,
+    _In_ std::size_t arraySize,
+    _In_ DXGI_FORMAT format,
+    _Out_ D3D12_RESOURCE_DESC& texDesc) noexcept
+{
+    ZeroMemory(&texDesc, sizeof(D3D12_RESOURCE_DESC));
+    texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    texDesc.Alignment = 0;
+    texDesc.Width = width;
+    texDesc.Height = static_cast<std::uint32_t>(height);
+    texDesc.DepthOrArraySize = (depth > 1) ? static_cast<std::uint16_t>(depth) : static_cast<std::uint16_t>(arraySize);
+    texDesc.MipLevels = static_cast<std::uint16_t>(mipCount);
+    texDesc.Format = format;
+    texDesc.SampleDesc.Count = 1;
+    texDesc.SampleDesc.Quality = 0;
+    texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+    texDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+}
+
 static HRESULT CreateD3DResources12(
     ID3D12Device* device,
     ID3D12GraphicsCommandList* commandList,
@@ -1147,25 +1172,16 @@ static HRESULT CreateD3DResources12(
     case D3D12_RESOURCE_DIMENSION_TEXTURE2D:
     {
         D3D12_RESOURCE_DESC texDesc;
-        ZeroMemory(&texDesc, sizeof(D3D12_RESOURCE_DESC));
-        texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-        texDesc.Alignment = 0;
-        texDesc.Width = width;
-        texDesc.Height = static_cast<std::uint32_t>(height);
-        texDesc.DepthOrArraySize = (depth > 1) ? static_cast<std::uint16_t>(depth) : static_cast<std::uint16_t>(arraySize);
-        texDesc.MipLevels = static_cast<std::uint16_t>(mipCount);
-        texDesc.Format = format;
-        texDesc.SampleDesc.Count = 1;
-        texDesc.SampleDesc.Quality = 0;
-        texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-        texDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+        GetTextureDescriptor12(width, height, depth, mipCount, arraySize, format, texDesc);
 
+        // When there is no command list, the caller is responsible of the upload,
+        // so the texture is created ready to be a copy destination.
         CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
         hr = device->CreateCommittedResource(
             &heapProps,
             D3D12_HEAP_FLAG_NONE,
             &texDesc,
-            D3D12_RESOURCE_STATE_COMMON,
+            commandList == nullptr ? D3D12_RESOURCE_STATE_COPY_DEST : D3D12_RESOURCE_STATE_COMMON,
             nullptr,
             IID_PPV_ARGS(&texture)
         );
@@ -1173,7 +1189,7 @@ static HRESULT CreateD3DResources12(
         if (FAILED(hr)) {
             texture = nullptr;
             return hr;
-        } else {
+        } else if (commandList != nullptr) {
             const UINT num2DSubresources = texDesc.DepthOrArraySize * texDesc.MipLevels;
             const UINT64 uploadBufferSize = GetRequiredIntermediateSize(texture.Get(), 0, num2DSubresources);
 
@@ -1519,7 +1535,9 @@ static HRESULT CreateTextureFromDDS12(
     _In_ std::size_t maxsize,
     _In_ bool /*forceSRGB*/,
     ComPtr<ID3D12Resource>& texture,
-    ComPtr<ID3D12Resource>& textureUploadHeap) noexcept
+    ComPtr<ID3D12Resource>& textureUploadHeap,
+    std::vector<D3D12_SUBRESOURCE_DATA>* subresources = nullptr,
+    D3D12_RESOURCE_DESC* textureDescriptor = nullptr) noexcept
 {
     HRESULT hr;
 
@@ -1679,7 +1697,13 @@ static HRESULT CreateTextureFromDDS12(
         twidth, theight, tdepth, skipMip, initData.get()
     );
 
-    if (SUCCEEDED(hr)) {
+    if (SUCCEEDED(hr) && device == nullptr) {
+        // No device: only the texture descriptor is needed, and the caller creates the texture.
+        if (textureDescriptor == nullptr || resDim != D3D12_RESOURCE_DIMENSION_TEXTURE2D) {
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+        GetTextureDescriptor12(twidth, theight, tdepth, mipCount - skipMip, arraySize, format, *textureDescriptor);
+    } else if (SUCCEEDED(hr)) {
         hr = CreateD3DResources12(
             device, commandList,
             resDim, twidth, theight, tdepth,
@@ -1693,6 +1717,10 @@ static HRESULT CreateTextureFromDDS12(
             textureUploadHeap);
     }
 
+    if (SUCCEEDED(hr) && subresources != nullptr) {
+        subresources->assign(initData.get(), initData.get() + (mipCount - skipMip) * arraySize);
+    }
+
     return hr;
 }
 
@@ -1923,6 +1951,75 @@ HRESULT DirectX::CreateDDSTextureFromMemoryEx(ID3D11Device* d3dDevice,
 }
 
 //--------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::LoadDDSTextureDataFromMemory12(_In_reads_bytes_(ddsDataSize) const uint8_t* ddsData,
+                                                _In_ std::size_t ddsDataSize,
+                                                _Out_ D3D12_RESOURCE_DESC& textureDescriptor,
+                                                _Out_ std::vector<D3D12_SUBRESOURCE_DATA>& subresources,
+                                                _In_ std::size_t maxsize,
+                                                _Out_opt_ DDS_ALPHA_MODE* alphaMode) noexcept
+{
+    subresources.clear();
+    if (alphaMode) {
+        *alphaMode = DDS_ALPHA_MODE::DDS_ALPHA_MODE_UNKNOWN;
+    }
+
+    if (!ddsData) {
+        return E_INVALIDARG;
+    }
+
+    // Need at least enough data to fill the header and magic number to be a valid DDS
+    if (ddsDataSize < (sizeof(DDS_HEADER) + sizeof(std::uint32_t))) {
+        return E_FAIL;
+    }
+
+    std::uint32_t dwMagicNumber = *reinterpret_cast<const std::uint32_t*>(ddsData);
+    if (dwMagicNumber != DDS_MAGIC) {
+        return E_FAIL;
+    }
+
+    auto header = reinterpret_cast<const DDS_HEADER*>(ddsData + sizeof(std::uint32_t));
+
+    // Verify header to validate DDS file
+    if (header->size != sizeof(DDS_HEADER) ||
+        header->ddspf.size != sizeof(DDS_PIXELFORMAT)) {
+        return E_FAIL;
+    }
+
+    // Check for DX10 extension
+    bool bDXT10Header = false;
+    if ((header->ddspf.flags & DDS_FOURCC) &&
+        (MAKEFOURCC('D', 'X', '1', '0') == header->ddspf.fourCC)) {
+        // Must be long enough for both headers and magic value
+        if (ddsDataSize < (sizeof(DDS_HEADER) + sizeof(std::uint32_t) + sizeof(DDS_HEADER_DXT10))) {
+            return E_FAIL;
+        }
+
+        bDXT10Header = true;
+    }
+
+    ptrdiff_t offset = sizeof(std::uint32_t)
+        + sizeof(DDS_HEADER)
+        + (bDXT10Header ? sizeof(DDS_HEADER_DXT10) : 0);
+
+    // No device and no command list: the texture is neither created nor uploaded here
+    ComPtr<ID3D12Resource> texture;
+    ComPtr<ID3D12Resource> textureUploadHeap;
+    HRESULT hr = CreateTextureFromDDS12(nullptr, nullptr, header,
+                                        ddsData + offset, ddsDataSize - offset, maxsize, false,
+                                        texture, textureUploadHeap, &subresources, &textureDescriptor);
+
+    if (SUCCEEDED(hr)) {
+        if (alphaMode)
+            *alphaMode = GetAlphaMode(header);
+    } else {
+        subresources.clear();
+    }
+
+    return hr;
+}
+
 _Use_decl_annotations_
 HRESULT DirectX::CreateDDSTextureFromFile(ID3D11Device* d3dDevice,
                                           const wchar_t* fileName,
@@ -2020,6 +2117,51 @@ HRESULT DirectX::CreateDDSTextureFromFile12(_In_ ID3D12Device* device,
     return hr;
 }
 
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::LoadDDSTextureDataFromFile12(_In_z_ const wchar_t* szFileName,
+                                              _Out_ std::unique_ptr<uint8_t[]>& ddsData,
+                                              _Out_ D3D12_RESOURCE_DESC& textureDescriptor,
+                                              _Out_ std::vector<D3D12_SUBRESOURCE_DATA>& subresources,
+                                              _In_ std::size_t maxsize,
+                                              _Out_opt_ DDS_ALPHA_MODE* alphaMode) noexcept
+{
+    ddsData.reset();
+    subresources.clear();
+    if (alphaMode) {
+        *alphaMode = DDS_ALPHA_MODE::DDS_ALPHA_MODE_UNKNOWN;
+    }
+
+    if (!szFileName) {
+        return E_INVALIDARG;
+    }
+
+    DDS_HEADER* header = nullptr;
+    uint8_t* bitData = nullptr;
+    std::size_t bitSize = 0;
+
+    HRESULT hr = LoadTextureDataFromFile(szFileName, ddsData, &header, &bitData, &bitSize);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    // No device and no command list: the texture is neither created nor uploaded here
+    ComPtr<ID3D12Resource> texture;
+    ComPtr<ID3D12Resource> textureUploadHeap;
+    hr = CreateTextureFromDDS12(nullptr, nullptr, header,
+                                bitData, bitSize, maxsize, false, texture, textureUploadHeap, &subresources, &textureDescriptor);
+
+    if (SUCCEEDED(hr)) {
+        if (alphaMode)
+            *alphaMode = GetAlphaMode(header);
+    } else {
+        ddsData.reset();
+        subresources.clear();
+    }
+
+    return hr;
+}
+
 _Use_decl_annotations_
 HRESULT DirectX::CreateDDSTextureFromFile(ID3D11Device* d3dDevice,
                                           ID3D11DeviceContext* d3dContext,
@@ -25,6 +25,8 @@
 #include <DXUtils/d3dx12.h>
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #if defined(_MSC_VER) && (_MSC_VER<1610) && !defined(_In_reads_)
 #define _In_reads_(exp)
@@ -84,6 +86,27 @@ HRESULT CreateDDSTextureFromFile12(_In_ ID3D12Device* device,
                                    _Out_opt_ DDS_ALPHA_MODE* alphaMode = nullptr
 ) noexcept;
 
+// Reads and parses the file without creating the texture, so it can be called from several threads.
+// The texture must be created from textureDescriptor in D3D12_RESOURCE_STATE_COPY_DEST by the caller.
+// subresources point into ddsData, so ddsData must outlive them.
+HRESULT LoadDDSTextureDataFromFile12(_In_z_ const wchar_t* szFileName,
+                                     _Out_ std::unique_ptr<uint8_t[]>& ddsData,
+                                     _Out_ D3D12_RESOURCE_DESC& textureDescriptor,
+                                     _Out_ std::vector<D3D12_SUBRESOURCE_DATA>& subresources,
+                                     _In_ std::size_t maxsize = 0,
+                                     _Out_opt_ DDS_ALPHA_MODE* alphaMode = nullptr
+) noexcept;
+
+// Parses DDS data in place (for example, a memory mapped file) without copying it.
+// subresources point into ddsData, so ddsData must outlive them.
+HRESULT LoadDDSTextureDataFromMemory12(_In_reads_bytes_(ddsDataSize) const uint8_t* ddsData,
+                                       _In_ std::size_t ddsDataSize,
+                                       _Out_ D3D12_RESOURCE_DESC& textureDescriptor,
+                                       _Out_ std::vector<D3D12_SUBRESOURCE_DATA>& subresources,
+                                       _In_ std::size_t maxsize = 0,
+                                       _Out_opt_ DDS_ALPHA_MODE* alphaMode = nullptr
+) noexcept;
+
 // Standard version with optional auto-gen mipmap support
 HRESULT CreateDDSTextureFromMemory(_In_ ID3D11Device* d3dDevice,
                                    _In_opt_ ID3D11DeviceContext* d3dContext,
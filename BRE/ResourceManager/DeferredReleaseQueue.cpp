@@ -0,0 +1,99 @@
+#include "DeferredReleaseQueue.h"
+
+#include <limits>
+#include <utility>
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+void
+DeferredReleaseQueue::SetFrameFenceValue(const std::uint64_t frameFenceValue) noexcept
+{
+    mMutex.lock();
+    mFrameFenceValue = frameFenceValue;
+    mMutex.unlock();
+}
+
+std::uint64_t
+DeferredReleaseQueue::GetFrameFenceValue() const noexcept
+{
+    mMutex.lock();
+    const std::uint64_t frameFenceValue = mFrameFenceValue;
+    mMutex.unlock();
+
+    return frameFenceValue;
+}
+
+void
+DeferredReleaseQueue::Enqueue(ReleaseFunction releaseFunction) noexcept
+{
+    Enqueue(GetFrameFenceValue(), std::move(releaseFunction));
+}
+
+void
+DeferredReleaseQueue::Enqueue(const std::uint64_t fenceValue,
+                              ReleaseFunction releaseFunction) noexcept
+{
+    BRE_ASSERT(releaseFunction);
+
+    mMutex.lock();
+    PendingRelease pendingRelease;
+    pendingRelease.mFenceValue = fenceValue;
+    if (mPendingReleases.empty() == false && mPendingReleases.back().mFenceValue > fenceValue) {
+        pendingRelease.mFenceValue = mPendingReleases.back().mFenceValue;
+    }
+    pendingRelease.mReleaseFunction = std::move(releaseFunction);
+    mPendingReleases.push_back(std::move(pendingRelease));
+    mMutex.unlock();
+}
+
+std::uint32_t
+DeferredReleaseQueue::ReleaseCompleted(const std::uint64_t completedFenceValue) noexcept
+{
+    // Releases are run outside the lock, so they can enqueue other releases.
+    std::vector<PendingRelease> releases;
+    PopCompleted(completedFenceValue, releases);
+    for (PendingRelease& release : releases) {
+        release.mReleaseFunction();
+    }
+
+    return static_cast<std::uint32_t>(releases.size());
+}
+
+std::uint32_t
+DeferredReleaseQueue::ReleaseAll() noexcept
+{
+    std::uint32_t releaseCount = 0U;
+    std::uint32_t lastReleaseCount = 0U;
+    do {
+        lastReleaseCount = ReleaseCompleted(std::numeric_limits<std::uint64_t>::max());
+        releaseCount += lastReleaseCount;
+    } while (lastReleaseCount > 0U);
+
+    return releaseCount;
+}
+
+std::uint32_t
+DeferredReleaseQueue::GetSize() const noexcept
+{
+    mMutex.lock();
+    const std::uint32_t size = static_cast<std::uint32_t>(mPendingReleases.size());
+    mMutex.unlock();
+
+    return size;
+}
+
+void
+DeferredReleaseQueue::PopCompleted(const std::uint64_t completedFenceValue,
+                                   std::vector<PendingRelease>& releases) noexcept
+{
+    releases.clear();
+
+    mMutex.lock();
+    while (mPendingReleases.empty() == false && mPendingReleases.front().mFenceValue <= completedFenceValue) {
+        releases.push_back(std::move(mPendingReleases.front()));
+        mPendingReleases.pop_front();
+    }
+    mMutex.unlock();
+}
+}
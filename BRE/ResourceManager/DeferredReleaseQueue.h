@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace BRE {
+///
+/// @brief Queue of releases that are deferred until the GPU finished the frames that could use
+/// the released objects (resources, models, upload buffers, etc).
+///
+/// Each release is keyed by a fence value. A release is run once the completed fence value
+/// is greater or equal than its fence value (see ReleaseCompleted()). By default, the fence value
+/// is the frame fence value: the value signaled after the command lists of the frame that is
+/// being recorded, which is the last frame that could use the released object.
+///
+/// Objects are usually released through reference counted handles (see MakeShared()):
+/// when the last handle is destroyed, the release is enqueued.
+///
+/// Methods can be called from several threads at the same time.
+///
+class DeferredReleaseQueue {
+public:
+    using ReleaseFunction = std::function<void()>;
+
+    DeferredReleaseQueue() = default;
+    ~DeferredReleaseQueue() = default;
+    DeferredReleaseQueue(const DeferredReleaseQueue&) = delete;
+    const DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+    DeferredReleaseQueue(DeferredReleaseQueue&&) = delete;
+    DeferredReleaseQueue& operator=(DeferredReleaseQueue&&) = delete;
+
+    ///
+    /// @brief Sets the frame fence value
+    ///
+    /// It must be called after the fence of a frame is signaled, with the
+    /// value that will be signaled after the command lists of the next frame.
+    ///
+    /// @param frameFenceValue Frame fence value
+    ///
+    void SetFrameFenceValue(const std::uint64_t frameFenceValue) noexcept;
+
+    ///
+    /// @brief Get the frame fence value
+    /// @return Frame fence value
+    ///
+    std::uint64_t GetFrameFenceValue() const noexcept;
+
+    ///
+    /// @brief Enqueues a release keyed by the frame fence value
+    /// @param releaseFunction Release function. It must not be empty.
+    ///
+    void Enqueue(ReleaseFunction releaseFunction) noexcept;
+
+    ///
+    /// @brief Enqueues a release keyed by a fence value
+    ///
+    /// Releases are run in enqueue order, so if the fence value is lower than the fence value
+    /// of a previous release, then it is replaced by it (the release is never run earlier).
+    ///
+    /// @param fenceValue Fence value of the last frame that could use the released object
+    /// @param releaseFunction Release function. It must not be empty.
+    ///
+    void Enqueue(const std::uint64_t fenceValue,
+                 ReleaseFunction releaseFunction) noexcept;
+
+    ///
+    /// @brief Runs the releases whose fence value was completed
+    ///
+    /// Release functions can enqueue other releases (for example, when they
+    /// destroy the last handle of another object).
+    ///
+    /// @param completedFenceValue Completed fence value. For example, ID3D12Fence::GetCompletedValue()
+    /// @return Number of run releases
+    ///
+    std::uint32_t ReleaseCompleted(const std::uint64_t completedFenceValue) noexcept;
+
+    ///
+    /// @brief Runs all the releases, including the ones enqueued by the run releases.
+    ///
+    /// The GPU must be idle (for example, after the command queue was flushed)
+    ///
+    /// @return Number of run releases
+    ///
+    std::uint32_t ReleaseAll() noexcept;
+
+    ///
+    /// @brief Get the number of pending releases
+    /// @return Number of pending releases
+    ///
+    std::uint32_t GetSize() const noexcept;
+
+    ///
+    /// @brief Creates a reference counted handle of an object
+    ///
+    /// When the last copy of the handle is destroyed, the release function
+    /// is enqueued with the frame fence value. The queue must outlive the handles.
+    ///
+    /// @param object Object
+    /// @param releaseFunction Release function. It must not be empty.
+    /// @return Reference counted handle
+    ///
+    template<typename T>
+    std::shared_ptr<T> MakeShared(T& object,
+                                  ReleaseFunction releaseFunction) noexcept
+    {
+        return std::shared_ptr<T>(&object,
+                                  [this, releaseFunction](T*) {
+            Enqueue(releaseFunction);
+        });
+    }
+
+private:
+    struct PendingRelease {
+        std::uint64_t mFenceValue{ 0UL };
+        ReleaseFunction mReleaseFunction;
+    };
+
+    ///
+    /// @brief Moves the pending releases whose fence value was completed
+    /// @param completedFenceValue Completed fence value
+    /// @param releases Output releases
+    ///
+    void PopCompleted(const std::uint64_t completedFenceValue,
+                      std::vector<PendingRelease>& releases) noexcept;
+
+    // Fence values are in non decreasing order
+    std::deque<PendingRelease> mPendingReleases;
+
+    // Fence 0 is the initial value, so releases of the first frame wait until it is signaled
+    std::uint64_t mFrameFenceValue{ 1UL };
+
+    mutable std::mutex mMutex;
+};
+}
@@ -9,14 +9,14 @@ FrameUploadCBufferPerFrame::FrameUploadCBufferPerFrame()
 {
     const std::size_t frameCBufferElemSize{ UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(FrameCBuffer)) };
     for (std::uint32_t i = 0U; i < _countof(mFrameCBuffers); ++i) {
-        mFrameCBuffers[i] = &UploadBufferManager::CreateUploadBuffer(frameCBufferElemSize, 1U);
+        mFrameCBuffers[i] = UploadBufferManager::CreateSharedUploadBuffer(frameCBufferElemSize, 1U);
     }
 }
 
 UploadBuffer&
 FrameUploadCBufferPerFrame::GetNextFrameCBuffer() noexcept
 {
-    UploadBuffer* frameCBuffer{ mFrameCBuffers[mCurrentFrameIndex] };
+    UploadBuffer* frameCBuffer{ mFrameCBuffers[mCurrentFrameIndex].get() };
     BRE_ASSERT(frameCBuffer != nullptr);
 
     mCurrentFrameIndex = (mCurrentFrameIndex + 1) % ApplicationSettings::sQueuedFrameCount;
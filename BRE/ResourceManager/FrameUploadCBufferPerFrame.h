@@ -3,6 +3,7 @@
 #include <cstdint>
 
 #include <ResourceManager\UploadBuffer.h>
+#include <ResourceManager\UploadBufferManager.h>
 #include <ApplicationSettings\ApplicationSettings.h>
 
 namespace BRE {
@@ -27,7 +28,8 @@ public:
     UploadBuffer& GetNextFrameCBuffer() noexcept;
 
 private:
-    UploadBuffer* mFrameCBuffers[ApplicationSettings::sQueuedFrameCount];
+    // Released with this object, once the GPU finished the frames that could use them
+    UploadBufferManager::SharedUploadBuffer mFrameCBuffers[ApplicationSettings::sQueuedFrameCount];
     std::uint32_t mCurrentFrameIndex{ 0U };
 };
 
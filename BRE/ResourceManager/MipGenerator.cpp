@@ -0,0 +1,668 @@
+#include "MipGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <d3d12.h>
+#include <emmintrin.h>
+#include <fstream>
+#include <tbb/parallel_for.h>
+#include <Windows.h>
+
+#include <ApplicationSettings\ApplicationSettings.h>
+#include <ResourceManager\DDSTextureLoader.h>
+#include <Utils\DebugUtils.h>
+#include <Utils\HashUtils.h>
+#include <Utils\MemoryMappedFile.h>
+#include <Utils\StringUtils.h>
+
+namespace BRE {
+namespace {
+const char* sCacheDirectory{ "texture_cache" };
+const char* sCacheFileExtension{ ".dds" };
+
+// DDS header fields, as 32 bits words after the magic number
+const std::uint32_t sDDSMagic{ 0x20534444U }; // "DDS "
+const std::uint32_t sDDSHeaderWordCount{ 32U }; // Magic number and DDS_HEADER
+const std::uint32_t sDDSDX10HeaderWordCount{ 5U };
+const std::uint32_t sDDSFourCCWord{ 21U };
+const std::uint32_t sDDSCaps2Word{ 28U };
+const std::uint32_t sDDSDX10MiscFlagWord{ 34U };
+const std::uint32_t sDDSFourCCDX10{ 0x30315844U }; // "DX10"
+const std::uint32_t sDDSCaps2CubeMap{ 0x200U };
+const std::uint32_t sDDSResourceMiscTextureCube{ 0x4U };
+
+// Kaiser filter radius is in destination texels.
+const float sKaiserRadius{ 3.0f };
+const float sKaiserAlpha{ 4.0f };
+
+// Linear values are encoded to sRGB with a table indexed by the value in 16 bits,
+// so the error is below the 8 bits rounding, even for dark values.
+const std::uint32_t sLinearToSRGBTableSize{ 1U << 16U };
+
+///
+/// @brief Filter tap of a destination texel
+///
+struct FilterTap {
+    std::uint32_t mSourceIndex;
+    float mWeight;
+};
+
+///
+/// @brief Checks if the DDS data is a cube map
+/// @param ddsData DDS data. It must be already validated by the DDS loader.
+/// @return True if it is a cube map. Otherwise, false.
+///
+bool
+IsCubeMap(const std::uint8_t* ddsData) noexcept
+{
+    const std::uint32_t* words = reinterpret_cast<const std::uint32_t*>(ddsData);
+    if (words[sDDSFourCCWord] == sDDSFourCCDX10) {
+        return (words[sDDSDX10MiscFlagWord] & sDDSResourceMiscTextureCube) != 0U;
+    }
+
+    return (words[sDDSCaps2Word] & sDDSCaps2CubeMap) != 0U;
+}
+
+///
+/// @brief Get the texel size of a supported format
+/// @param format DXGI format
+/// @param isSRGB Output true if the format is sRGB
+/// @return Texel size in bytes, or 0 if the format is not supported.
+///
+std::uint32_t
+GetTexelSize(const DXGI_FORMAT format,
+             bool& isSRGB) noexcept
+{
+    isSRGB = false;
+    switch (format) {
+    case DXGI_FORMAT_R8_UNORM:
+        return 1U;
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        isSRGB = true;
+        return 4U;
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+        // Filtering is the same for all the channel orders,
+        // because alpha (or X) is always the fourth byte.
+        return 4U;
+    default:
+        return 0U;
+    }
+}
+
+///
+/// @brief Writes the DDS headers of an uncompressed 2D texture
+/// @param textureDescriptor Source texture descriptor
+/// @param isCubeMap True if the texture is a cube map
+/// @param texelSize Texel size in bytes
+/// @param mipLevelCount Mip level count
+/// @param ddsData Output DDS data
+///
+void
+WriteDDSHeaders(const D3D12_RESOURCE_DESC& textureDescriptor,
+                const bool isCubeMap,
+                const std::uint32_t texelSize,
+                const std::uint32_t mipLevelCount,
+                std::vector<std::uint8_t>& ddsData) noexcept
+{
+    std::uint32_t header[sDDSHeaderWordCount + sDDSDX10HeaderWordCount]{};
+    header[0U] = sDDSMagic;
+    header[1U] = 124U; // DDS_HEADER size
+    header[2U] = 0x1007U | 0x8U | 0x20000U; // DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_PITCH | DDS_HEADER_FLAGS_MIPMAP
+    header[3U] = textureDescriptor.Height;
+    header[4U] = static_cast<std::uint32_t>(textureDescriptor.Width);
+    header[5U] = static_cast<std::uint32_t>(textureDescriptor.Width) * texelSize;
+    header[7U] = mipLevelCount;
+    header[19U] = 32U; // DDS_PIXELFORMAT size
+    header[20U] = 0x4U; // DDS_FOURCC
+    header[sDDSFourCCWord] = sDDSFourCCDX10;
+    header[27U] = 0x1000U | 0x400008U | (isCubeMap ? 0x8U : 0U);
+    header[sDDSCaps2Word] = isCubeMap ? 0xFE00U : 0U; // DDS_CUBEMAP_ALLFACES
+
+    // DDS_HEADER_DXT10
+    header[32U] = static_cast<std::uint32_t>(textureDescriptor.Format);
+    header[33U] = static_cast<std::uint32_t>(D3D12_RESOURCE_DIMENSION_TEXTURE2D);
+    header[sDDSDX10MiscFlagWord] = isCubeMap ? sDDSResourceMiscTextureCube : 0U;
+    header[35U] = isCubeMap ? textureDescriptor.DepthOrArraySize / 6U : textureDescriptor.DepthOrArraySize;
+
+    ddsData.assign(reinterpret_cast<const std::uint8_t*>(header),
+                   reinterpret_cast<const std::uint8_t*>(header) + sizeof(header));
+}
+
+///
+/// @brief Converts a sRGB value to linear space
+/// @param value sRGB value in [0.0, 1.0]
+/// @return Linear value
+///
+float
+SRGBToLinear(const float value) noexcept
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+///
+/// @brief Converts a linear value to sRGB space
+/// @param value Linear value in [0.0, 1.0]
+/// @return sRGB value
+///
+float
+LinearToSRGB(const float value) noexcept
+{
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+///
+/// @brief Get the table that converts sRGB 8 bits values to linear values
+/// @return Table of 256 values
+///
+const float*
+GetSRGBToLinearTable() noexcept
+{
+    static const std::vector<float> sTable = [] {
+        std::vector<float> table(256U);
+        for (std::uint32_t i = 0U; i < 256U; ++i) {
+            table[i] = SRGBToLinear(i / 255.0f);
+        }
+        return table;
+    }();
+
+    return sTable.data();
+}
+
+///
+/// @brief Get the table that converts linear 16 bits values to sRGB 8 bits values
+/// @return Table of sLinearToSRGBTableSize values
+///
+const std::uint8_t*
+GetLinearToSRGBTable() noexcept
+{
+    static const std::vector<std::uint8_t> sTable = [] {
+        std::vector<std::uint8_t> table(sLinearToSRGBTableSize);
+        for (std::uint32_t i = 0U; i < sLinearToSRGBTableSize; ++i) {
+            const float value = LinearToSRGB(i / static_cast<float>(sLinearToSRGBTableSize - 1U));
+            table[i] = static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+        }
+        return table;
+    }();
+
+    return sTable.data();
+}
+
+///
+/// @brief Computes the modified Bessel function of the first kind and order 0
+/// @param x Value
+/// @return Function value
+///
+double
+BesselI0(const double x) noexcept
+{
+    const double halfXSquare = x * x * 0.25;
+    double sum{ 1.0 };
+    double term{ 1.0 };
+    for (std::uint32_t k = 1U; term > sum * 1.0e-12; ++k) {
+        term *= halfXSquare / (k * k);
+        sum += term;
+    }
+
+    return sum;
+}
+
+///
+/// @brief Computes the Kaiser windowed sinc filter
+/// @param x Distance to the filter center, in destination texels
+/// @return Filter weight
+///
+double
+KaiserFilter(const double x) noexcept
+{
+    const double absX = std::abs(x);
+    if (absX >= sKaiserRadius) {
+        return 0.0;
+    }
+
+    const double pi = 3.14159265358979323846;
+    const double sinc = absX < 1.0e-6 ? 1.0 : std::sin(pi * x) / (pi * x);
+    const double windowX = x / sKaiserRadius;
+    const double window = BesselI0(sKaiserAlpha * std::sqrt(1.0 - windowX * windowX)) / BesselI0(sKaiserAlpha);
+
+    return sinc * window;
+}
+
+///
+/// @brief Computes the filter taps of a dimension
+/// @param settings Downsampling settings
+/// @param sourceSize Source size
+/// @param destinationSize Destination size
+/// @param taps Output taps. There are tapCount taps per destination texel.
+/// Unused taps have weight 0.
+/// @param tapCount Output number of taps per destination texel
+///
+void
+ComputeFilterTaps(const MipGenerator::Settings& settings,
+                  const std::uint32_t sourceSize,
+                  const std::uint32_t destinationSize,
+                  std::vector<FilterTap>& taps,
+                  std::uint32_t& tapCount) noexcept
+{
+    BRE_ASSERT(destinationSize > 0U);
+    BRE_ASSERT(sourceSize >= destinationSize);
+
+    // Dimensions of size 1 are kept.
+    if (sourceSize == destinationSize) {
+        tapCount = 1U;
+        taps.resize(destinationSize);
+        for (std::uint32_t i = 0U; i < destinationSize; ++i) {
+            taps[i] = FilterTap{ i, 1.0f };
+        }
+        return;
+    }
+
+    // Scale is not 2 for odd source sizes.
+    const double scale = static_cast<double>(sourceSize) / destinationSize;
+    const double radius = settings.mFilter == MipGenerator::Filter::BOX ? scale * 0.5 : sKaiserRadius * scale;
+    tapCount = static_cast<std::uint32_t>(std::ceil(radius * 2.0)) + 1U;
+    taps.assign(static_cast<std::size_t>(destinationSize) * tapCount, FilterTap{ 0U, 0.0f });
+
+    std::vector<double> weights(tapCount);
+    for (std::uint32_t i = 0U; i < destinationSize; ++i) {
+        const double center = (i + 0.5) * scale;
+        const std::int64_t firstSourceIndex = static_cast<std::int64_t>(std::floor(center - radius));
+
+        double weightSum{ 0.0 };
+        for (std::uint32_t j = 0U; j < tapCount; ++j) {
+            const double sourceIndex = static_cast<double>(firstSourceIndex + j);
+            if (settings.mFilter == MipGenerator::Filter::BOX) {
+                // Coverage of the source texel by the destination texel
+                const double coverageBegin = std::max(sourceIndex, center - radius);
+                const double coverageEnd = std::min(sourceIndex + 1.0, center + radius);
+                weights[j] = std::max(coverageEnd - coverageBegin, 0.0);
+            } else {
+                weights[j] = KaiserFilter((sourceIndex + 0.5 - center) / scale);
+            }
+            weightSum += weights[j];
+        }
+        BRE_ASSERT(weightSum > 0.0);
+
+        for (std::uint32_t j = 0U; j < tapCount; ++j) {
+            const std::int64_t signedSourceSize = static_cast<std::int64_t>(sourceSize);
+            std::int64_t sourceIndex = firstSourceIndex + j;
+            if (settings.mIsWrapped) {
+                sourceIndex = ((sourceIndex % signedSourceSize) + signedSourceSize) % signedSourceSize;
+            } else {
+                sourceIndex = std::min(std::max(sourceIndex, std::int64_t(0)), signedSourceSize - 1);
+            }
+
+            FilterTap& tap = taps[static_cast<std::size_t>(i) * tapCount + j];
+            tap.mSourceIndex = static_cast<std::uint32_t>(sourceIndex);
+            tap.mWeight = static_cast<float>(weights[j] / weightSum);
+        }
+    }
+}
+
+///
+/// @brief Decodes a RGBA8 texel to the filtering space
+/// @param settings Downsampling settings
+/// @param srgbToLinearTable sRGB to linear table
+/// @param texel RGBA8 texel
+/// @return Decoded texel
+///
+__m128
+DecodeTexel(const MipGenerator::Settings& settings,
+            const float* srgbToLinearTable,
+            const std::uint8_t* texel) noexcept
+{
+    const float alpha = texel[3U] / 255.0f;
+    if (settings.mIsNormalMap) {
+        return _mm_setr_ps(texel[0U] * (2.0f / 255.0f) - 1.0f,
+                           texel[1U] * (2.0f / 255.0f) - 1.0f,
+                           texel[2U] * (2.0f / 255.0f) - 1.0f,
+                           alpha);
+    }
+
+    if (settings.mIsSRGB) {
+        return _mm_setr_ps(srgbToLinearTable[texel[0U]],
+                           srgbToLinearTable[texel[1U]],
+                           srgbToLinearTable[texel[2U]],
+                           alpha);
+    }
+
+    return _mm_mul_ps(_mm_setr_ps(texel[0U], texel[1U], texel[2U], texel[3U]),
+                      _mm_set1_ps(1.0f / 255.0f));
+}
+
+///
+/// @brief Stores a texel in [0.0, 1.0] as RGBA8
+/// @param values Texel in [0.0, 1.0]
+/// @param texel Output RGBA8 texel
+///
+void
+StoreTexel(const __m128 values,
+           std::uint8_t* texel) noexcept
+{
+    const __m128i integers = _mm_cvtps_epi32(_mm_mul_ps(values, _mm_set1_ps(255.0f)));
+    const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(integers, integers), integers);
+    const std::int32_t packedTexel = _mm_cvtsi128_si32(bytes);
+    std::memcpy(texel, &packedTexel, sizeof(packedTexel));
+}
+
+///
+/// @brief Encodes a filtered texel to RGBA8
+/// @param settings Downsampling settings
+/// @param linearToSRGBTable Linear to sRGB table
+/// @param filteredTexel Filtered texel
+/// @param texel Output RGBA8 texel
+/// @return Filtered texel after clamping or renormalization,
+/// to filter the next mip level.
+///
+__m128
+EncodeTexel(const MipGenerator::Settings& settings,
+            const std::uint8_t* linearToSRGBTable,
+            __m128 filteredTexel,
+            std::uint8_t* texel) noexcept
+{
+    // Filters with negative weights ring, so values are clamped.
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    if (settings.mIsNormalMap) {
+        float values[4U];
+        _mm_storeu_ps(values, filteredTexel);
+        const float length = std::sqrt(values[0U] * values[0U] + values[1U] * values[1U] + values[2U] * values[2U]);
+        const float alpha = std::min(std::max(values[3U], 0.0f), 1.0f);
+        filteredTexel = length > 1.0e-6f ?
+            _mm_setr_ps(values[0U] / length, values[1U] / length, values[2U] / length, alpha) :
+            _mm_setr_ps(0.0f, 0.0f, 1.0f, alpha);
+
+        // [-1.0, 1.0] to [0.0, 1.0], except alpha
+        const __m128 unsignedTexel = _mm_add_ps(_mm_mul_ps(filteredTexel, _mm_setr_ps(0.5f, 0.5f, 0.5f, 1.0f)),
+                                                _mm_setr_ps(0.5f, 0.5f, 0.5f, 0.0f));
+        StoreTexel(_mm_min_ps(_mm_max_ps(unsignedTexel, zero), one), texel);
+
+        return filteredTexel;
+    }
+
+    filteredTexel = _mm_min_ps(_mm_max_ps(filteredTexel, zero), one);
+    StoreTexel(filteredTexel, texel);
+
+    if (settings.mIsSRGB) {
+        const __m128i tableIndices =
+            _mm_cvtps_epi32(_mm_mul_ps(filteredTexel, _mm_set1_ps(static_cast<float>(sLinearToSRGBTableSize - 1U))));
+        std::int32_t indices[4U];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices), tableIndices);
+        texel[0U] = linearToSRGBTable[indices[0U]];
+        texel[1U] = linearToSRGBTable[indices[1U]];
+        texel[2U] = linearToSRGBTable[indices[2U]];
+    }
+
+    return filteredTexel;
+}
+}
+
+std::string
+MipGenerator::GenerateMipLevelsFile(const char* sourceFilename,
+                                    std::uint64_t& contentHash,
+                                    const bool isNormalMap) noexcept
+{
+    BRE_ASSERT(sourceFilename != nullptr);
+
+    // If it cannot be opened, the texture loader reports it.
+    MemoryMappedFile sourceFile;
+    if (sourceFile.Open(sourceFilename) == false) {
+        return sourceFilename;
+    }
+
+    // Textures that already have mip levels are returned as they are.
+    D3D12_RESOURCE_DESC textureDescriptor{};
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+    bool isSRGB{ false };
+    if (FAILED(DirectX::LoadDDSTextureDataFromMemory12(sourceFile.GetData(),
+                                                       sourceFile.GetSize(),
+                                                       textureDescriptor,
+                                                       subresources)) ||
+        textureDescriptor.Dimension != D3D12_RESOURCE_DIMENSION_TEXTURE2D ||
+        textureDescriptor.MipLevels != 1U ||
+        GetMipLevelCount(static_cast<std::uint32_t>(textureDescriptor.Width), textureDescriptor.Height) == 1U ||
+        GetTexelSize(textureDescriptor.Format, isSRGB) == 0U) {
+        return sourceFilename;
+    }
+
+    // Generation settings are part of the hash, so changing them generates the mip levels again.
+    const Filter filter = ApplicationSettings::sIsKaiserMipFilterEnabled ? Filter::KAISER : Filter::BOX;
+    const std::uint32_t generationSettings[]{
+        sVersion,
+        static_cast<std::uint32_t>(filter),
+        isNormalMap ? 1U : 0U
+    };
+    const std::uint64_t generatedContentHash =
+        HashUtils::ComputeHash(generationSettings, sizeof(generationSettings), contentHash);
+    const std::string generatedFilename =
+        HashUtils::GetCachedFilePath(sCacheDirectory, generatedContentHash, sCacheFileExtension);
+    if (GetFileAttributesA(generatedFilename.c_str()) != INVALID_FILE_ATTRIBUTES) {
+        contentHash = generatedContentHash;
+        return generatedFilename;
+    }
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::uint8_t> ddsData;
+    if (GenerateMipLevels(sourceFile.GetData(), sourceFile.GetSize(), filter, isNormalMap, ddsData) == false) {
+        return sourceFilename;
+    }
+    sourceFile.Close();
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+
+    std::ofstream fileStream{ generatedFilename, std::ios::out | std::ios::binary | std::ios::trunc };
+    if (fileStream.is_open() == false) {
+        return sourceFilename;
+    }
+    fileStream.write(reinterpret_cast<const char*>(ddsData.data()), ddsData.size());
+    if (fileStream.good() == false) {
+        fileStream.close();
+        DeleteFileA(generatedFilename.c_str());
+        return sourceFilename;
+    }
+
+    const double timeInSeconds = std::chrono::duration<double>(endTime - startTime).count();
+    const double megapixels =
+        static_cast<double>(textureDescriptor.Width) * textureDescriptor.Height * textureDescriptor.DepthOrArraySize / 1000000.0;
+    const std::wstring generationMsg =
+        L"Mip levels generated " + StringUtils::AnsiToWideString(sourceFilename) + L": " +
+        std::to_wstring(GetMipLevelCount(static_cast<std::uint32_t>(textureDescriptor.Width), textureDescriptor.Height)) +
+        L" mip levels, " + std::to_wstring(timeInSeconds > 0.0 ? megapixels / timeInSeconds : 0.0) + L" MPix/s\n";
+    BRE_LOG_MSG(generationMsg.c_str());
+
+    contentHash = generatedContentHash;
+    return generatedFilename;
+}
+
+bool
+MipGenerator::GenerateMipLevels(const std::uint8_t* sourceData,
+                                const std::size_t sourceDataSize,
+                                const Filter filter,
+                                const bool isNormalMap,
+                                std::vector<std::uint8_t>& ddsData) noexcept
+{
+    BRE_ASSERT(sourceData != nullptr);
+
+    D3D12_RESOURCE_DESC textureDescriptor{};
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+    if (FAILED(DirectX::LoadDDSTextureDataFromMemory12(sourceData,
+                                                       sourceDataSize,
+                                                       textureDescriptor,
+                                                       subresources))) {
+        return false;
+    }
+
+    const std::uint32_t width = static_cast<std::uint32_t>(textureDescriptor.Width);
+    const std::uint32_t height = textureDescriptor.Height;
+    const std::uint32_t mipLevelCount = GetMipLevelCount(width, height);
+    if (textureDescriptor.Dimension != D3D12_RESOURCE_DIMENSION_TEXTURE2D ||
+        textureDescriptor.MipLevels != 1U ||
+        mipLevelCount == 1U) {
+        return false;
+    }
+
+    Settings settings;
+    settings.mFilter = filter;
+    settings.mIsNormalMap = isNormalMap;
+    const std::uint32_t texelSize = GetTexelSize(textureDescriptor.Format, settings.mIsSRGB);
+    if (texelSize == 0U) {
+        return false;
+    }
+
+    // Cube map faces do not tile.
+    const bool isCubeMap = IsCubeMap(sourceData);
+    settings.mIsWrapped = isCubeMap == false;
+
+    WriteDDSHeaders(textureDescriptor, isCubeMap, texelSize, mipLevelCount, ddsData);
+
+    // There is a subresource per array slice, because there is a single mip level.
+    std::vector<std::uint8_t> texels(static_cast<std::size_t>(width) * height * 4U);
+    std::vector<std::uint8_t> mipLevelTexels;
+    for (const D3D12_SUBRESOURCE_DATA& subresource : subresources) {
+        for (std::uint32_t y = 0U; y < height; ++y) {
+            const std::uint8_t* sourceRow = static_cast<const std::uint8_t*>(subresource.pData) + y * subresource.RowPitch;
+            std::uint8_t* destinationRow = texels.data() + static_cast<std::size_t>(y) * width * 4U;
+            if (texelSize == 4U) {
+                std::memcpy(destinationRow, sourceRow, width * 4U);
+            } else {
+                for (std::uint32_t x = 0U; x < width; ++x) {
+                    destinationRow[x * 4U] = sourceRow[x];
+                    destinationRow[x * 4U + 1U] = 0U;
+                    destinationRow[x * 4U + 2U] = 0U;
+                    destinationRow[x * 4U + 3U] = 255U;
+                }
+            }
+        }
+
+        GenerateImageMipLevels(settings, texels.data(), width, height, mipLevelTexels);
+
+        if (texelSize == 4U) {
+            ddsData.insert(ddsData.end(), mipLevelTexels.begin(), mipLevelTexels.end());
+        } else {
+            for (std::size_t i = 0U; i < mipLevelTexels.size(); i += 4U) {
+                ddsData.push_back(mipLevelTexels[i]);
+            }
+        }
+    }
+
+    return true;
+}
+
+void
+MipGenerator::GenerateImageMipLevels(const Settings& settings,
+                                     const std::uint8_t* texels,
+                                     const std::uint32_t width,
+                                     const std::uint32_t height,
+                                     std::vector<std::uint8_t>& mipLevelTexels) noexcept
+{
+    BRE_ASSERT(texels != nullptr);
+    BRE_ASSERT(width > 0U && height > 0U);
+
+    const float* srgbToLinearTable = GetSRGBToLinearTable();
+    const std::uint8_t* linearToSRGBTable = GetLinearToSRGBTable();
+
+    const std::uint32_t mipLevelCount = GetMipLevelCount(width, height);
+    std::size_t dataSize{ 0U };
+    for (std::uint32_t mipLevel = 0U; mipLevel < mipLevelCount; ++mipLevel) {
+        dataSize += static_cast<std::size_t>(std::max(width >> mipLevel, 1U)) * std::max(height >> mipLevel, 1U) * 4U;
+    }
+    mipLevelTexels.resize(dataSize);
+
+    const std::size_t texelCount = static_cast<std::size_t>(width) * height;
+    std::memcpy(mipLevelTexels.data(), texels, texelCount * 4U);
+
+    // Mip levels are filtered from the previous mip level, in floats (4 per texel).
+    // Mip level 0 is decoded row by row while it is filtered, so it is not stored as floats.
+    std::vector<float> sourceTexels;
+    std::vector<float> rowFilteredTexels;
+    std::vector<float> destinationTexels;
+    std::vector<FilterTap> horizontalTaps;
+    std::vector<FilterTap> verticalTaps;
+    std::uint32_t horizontalTapCount{ 0U };
+    std::uint32_t verticalTapCount{ 0U };
+    std::size_t offset = texelCount * 4U;
+    for (std::uint32_t mipLevel = 1U; mipLevel < mipLevelCount; ++mipLevel) {
+        const std::uint32_t sourceWidth = std::max(width >> (mipLevel - 1U), 1U);
+        const std::uint32_t sourceHeight = std::max(height >> (mipLevel - 1U), 1U);
+        const std::uint32_t destinationWidth = std::max(width >> mipLevel, 1U);
+        const std::uint32_t destinationHeight = std::max(height >> mipLevel, 1U);
+        ComputeFilterTaps(settings, sourceWidth, destinationWidth, horizontalTaps, horizontalTapCount);
+        ComputeFilterTaps(settings, sourceHeight, destinationHeight, verticalTaps, verticalTapCount);
+
+        // Filter rows
+        rowFilteredTexels.resize(static_cast<std::size_t>(destinationWidth) * sourceHeight * 4U);
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, sourceHeight, 1U),
+                          [&](const tbb::blocked_range<size_t>& r) {
+            std::vector<float> decodedRow;
+            for (size_t y = r.begin(); y != r.end(); ++y) {
+                const float* sourceRow = sourceTexels.data() + y * sourceWidth * 4U;
+                if (mipLevel == 1U) {
+                    decodedRow.resize(static_cast<std::size_t>(sourceWidth) * 4U);
+                    for (std::size_t x = 0U; x < sourceWidth; ++x) {
+                        const std::uint8_t* texel = texels + (y * sourceWidth + x) * 4U;
+                        _mm_storeu_ps(decodedRow.data() + x * 4U, DecodeTexel(settings, srgbToLinearTable, texel));
+                    }
+                    sourceRow = decodedRow.data();
+                }
+
+                float* destinationRow = rowFilteredTexels.data() + y * destinationWidth * 4U;
+                for (std::size_t x = 0U; x < destinationWidth; ++x) {
+                    const FilterTap* taps = horizontalTaps.data() + x * horizontalTapCount;
+                    __m128 sum = _mm_setzero_ps();
+                    for (std::uint32_t i = 0U; i < horizontalTapCount; ++i) {
+                        const __m128 sourceTexel = _mm_loadu_ps(sourceRow + taps[i].mSourceIndex * 4U);
+                        sum = _mm_add_ps(sum, _mm_mul_ps(sourceTexel, _mm_set1_ps(taps[i].mWeight)));
+                    }
+                    _mm_storeu_ps(destinationRow + x * 4U, sum);
+                }
+            }
+        });
+
+        // Filter columns, and encode the mip level
+        destinationTexels.resize(static_cast<std::size_t>(destinationWidth) * destinationHeight * 4U);
+        std::uint8_t* mipLevelData = mipLevelTexels.data() + offset;
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, destinationHeight, 1U),
+                          [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t y = r.begin(); y != r.end(); ++y) {
+                const FilterTap* taps = verticalTaps.data() + y * verticalTapCount;
+                for (std::size_t x = 0U; x < destinationWidth; ++x) {
+                    __m128 sum = _mm_setzero_ps();
+                    for (std::uint32_t i = 0U; i < verticalTapCount; ++i) {
+                        const std::size_t sourceIndex = static_cast<std::size_t>(taps[i].mSourceIndex) * destinationWidth + x;
+                        const __m128 sourceTexel = _mm_loadu_ps(rowFilteredTexels.data() + sourceIndex * 4U);
+                        sum = _mm_add_ps(sum, _mm_mul_ps(sourceTexel, _mm_set1_ps(taps[i].mWeight)));
+                    }
+
+                    const std::size_t i = y * destinationWidth + x;
+                    _mm_storeu_ps(destinationTexels.data() + i * 4U,
+                                  EncodeTexel(settings, linearToSRGBTable, sum, mipLevelData + i * 4U));
+                }
+            }
+        });
+
+        sourceTexels.swap(destinationTexels);
+        offset += static_cast<std::size_t>(destinationWidth) * destinationHeight * 4U;
+    }
+
+    BRE_ASSERT(offset == mipLevelTexels.size());
+}
+
+std::uint32_t
+MipGenerator::GetMipLevelCount(const std::uint32_t width,
+                               const std::uint32_t height) noexcept
+{
+    std::uint32_t mipLevelCount{ 1U };
+    for (std::uint32_t size = std::max(width, height); size > 1U; size >>= 1U) {
+        ++mipLevelCount;
+    }
+
+    return mipLevelCount;
+}
+}
\ No newline at end of file
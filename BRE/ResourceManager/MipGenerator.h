@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BRE {
+///
+/// @brief Responsible to generate the mip levels of DDS textures that only have mip level 0.
+///
+/// Textures with mip levels are written to a cache directory, named after the content hash of
+/// the source texture and the generation settings, so they are only generated once, and a modified
+/// source texture gets new mip levels.
+///
+/// Each mip level is filtered from the previous one, in linear space:
+/// - sRGB textures are converted to linear space before filtering, and back to sRGB after it.
+/// - Normal maps are decoded to [-1.0, 1.0] and renormalized after filtering.
+/// - Alpha is always linear.
+///
+/// Filters are separable. Rows are filtered in parallel, and each texel is filtered as 4 floats with SSE.
+/// Supported formats: R8, RGBA8, BGRA8 and BGRX8 (and their sRGB variants). 2D textures, arrays and cube maps.
+///
+class MipGenerator {
+public:
+    MipGenerator() = delete;
+    ~MipGenerator() = delete;
+    MipGenerator(const MipGenerator&) = delete;
+    const MipGenerator& operator=(const MipGenerator&) = delete;
+    MipGenerator(MipGenerator&&) = delete;
+    MipGenerator& operator=(MipGenerator&&) = delete;
+
+    static const std::uint32_t sVersion{ 1U };
+
+    ///
+    /// @brief Downsampling filters
+    ///
+    enum class Filter {
+        BOX = 0, // Average of the source texels under the destination texel
+        KAISER, // Kaiser windowed sinc. Sharper than box, with some ringing (it is clamped).
+    };
+
+    ///
+    /// @brief Downsampling settings
+    ///
+    struct Settings {
+        Filter mFilter{ Filter::BOX };
+        bool mIsSRGB{ false };
+        bool mIsNormalMap{ false };
+        bool mIsWrapped{ true }; // Texels outside the image are wrapped, otherwise they are clamped.
+    };
+
+    ///
+    /// @brief Generates the mip levels of a texture file, if it does not have them,
+    /// and they were not generated before.
+    ///
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param sourceFilename Source DDS texture filename. Must not be nullptr.
+    /// @param contentHash Content hash of the source texture (see AssetRegistry::GetContentHash()),
+    /// so it is not read again to identify its generated file. It is replaced by the content hash
+    /// of the returned texture, to identify the files generated from it.
+    /// @param isNormalMap True if the texture is a normal map
+    /// @return Texture filename with mip levels, or the source texture filename
+    /// if it already has mip levels, or its format is not supported.
+    ///
+    static std::string GenerateMipLevelsFile(const char* sourceFilename,
+                                             std::uint64_t& contentHash,
+                                             const bool isNormalMap) noexcept;
+
+    ///
+    /// @brief Generates the mip levels of DDS texture data
+    /// @param sourceData Source DDS texture data. Must not be nullptr.
+    /// @param sourceDataSize Source DDS texture data size in bytes
+    /// @param filter Downsampling filter
+    /// @param isNormalMap True if the texture is a normal map
+    /// @param ddsData Output DDS texture data, with the source format and all the mip levels
+    /// @return True if the mip levels were generated. Otherwise (the texture already has mip levels,
+    /// or its format is not supported), false.
+    ///
+    static bool GenerateMipLevels(const std::uint8_t* sourceData,
+                                  const std::size_t sourceDataSize,
+                                  const Filter filter,
+                                  const bool isNormalMap,
+                                  std::vector<std::uint8_t>& ddsData) noexcept;
+
+    ///
+    /// @brief Generates the mip levels of an image
+    /// @param settings Downsampling settings
+    /// @param texels Tightly packed RGBA8 texels of mip level 0. Must not be nullptr.
+    /// @param width Width of mip level 0
+    /// @param height Height of mip level 0
+    /// @param mipLevelTexels Output tightly packed RGBA8 texels of all the mip levels,
+    /// from mip level 0 to the 1x1 mip level.
+    ///
+    static void GenerateImageMipLevels(const Settings& settings,
+                                       const std::uint8_t* texels,
+                                       const std::uint32_t width,
+                                       const std::uint32_t height,
+                                       std::vector<std::uint8_t>& mipLevelTexels) noexcept;
+
+    ///
+    /// @brief Get the number of mip levels of a full mip chain
+    /// @param width Width of mip level 0
+    /// @param height Height of mip level 0
+    /// @return Mip level count
+    ///
+    static std::uint32_t GetMipLevelCount(const std::uint32_t width,
+                                          const std::uint32_t height) noexcept;
+};
+}
\ No newline at end of file
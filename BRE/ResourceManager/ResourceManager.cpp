@@ -1,56 +1,176 @@
 #include "ResourceManager.h"
 
+#include <memory>
+#include <vector>
+
 #include <DirectXManager/DirectXManager.h>
 #include <DXUtils\D3DFactory.h>
+#include <MemoryTracker\MemoryTracker.h>
 #include <ResourceManager\DDSTextureLoader.h>
+#include <ResourceManager\StagingRingBuffer.h>
 #include <ResourceStateManager\ResourceStateManager.h>
 #include <ApplicationSettings\ApplicationSettings.h>
 #include <Utils/DebugUtils.h>
+#include <Utils\MemoryMappedFile.h>
 #include <Utils\StringUtils.h>
 
 namespace BRE {
-tbb::concurrent_unordered_set<ID3D12Resource*> ResourceManager::mResources;
+SlotMap<ID3D12Resource*> ResourceManager::mResources;
+DeferredReleaseQueue ResourceManager::mDeferredReleaseQueue;
 std::mutex ResourceManager::mMutex;
 
+namespace {
+///
+/// @brief Get the memory category of a resource, based on its heap type and descriptor
+/// @param resource Resource
+/// @return Memory category
+///
+MemoryTracker::Category
+GetMemoryCategory(ID3D12Resource& resource) noexcept
+{
+    D3D12_HEAP_PROPERTIES heapProperties{};
+    BRE_CHECK_HR(resource.GetHeapProperties(&heapProperties, nullptr));
+    if (heapProperties.Type == D3D12_HEAP_TYPE_UPLOAD) {
+        return MemoryTracker::Category::UPLOAD_HEAPS;
+    }
+
+    const D3D12_RESOURCE_DESC resourceDescriptor = resource.GetDesc();
+    if (resourceDescriptor.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+        return MemoryTracker::Category::VERTEX_AND_INDEX_BUFFERS;
+    }
+
+    const D3D12_RESOURCE_FLAGS renderTargetFlags =
+        D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET |
+        D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL |
+        D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+    if ((resourceDescriptor.Flags & renderTargetFlags) != 0) {
+        return MemoryTracker::Category::RENDER_TARGETS;
+    }
+
+    return MemoryTracker::Category::TEXTURES;
+}
+
+///
+/// @brief Get the size the device allocates for a resource
+/// @param resource Resource
+/// @return Allocation size in bytes
+///
+std::uint64_t
+GetAllocationSize(ID3D12Resource& resource) noexcept
+{
+    const D3D12_RESOURCE_DESC resourceDescriptor = resource.GetDesc();
+    const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo =
+        DirectXManager::GetDevice().GetResourceAllocationInfo(0U, 1U, &resourceDescriptor);
+
+    return allocationInfo.SizeInBytes;
+}
+}
+
 void
 ResourceManager::Clear() noexcept
 {
+    // Deferred releases of models or upload buffers can release resources
+    mDeferredReleaseQueue.ReleaseAll();
+
     for (ID3D12Resource* resource : mResources) {
         BRE_ASSERT(resource != nullptr);
+        MemoryTracker::RegisterDeallocation(GetMemoryCategory(*resource),
+                                            GetAllocationSize(*resource));
         resource->Release();
     }
 
-    mResources.clear();
+    mResources.Clear();
+}
+
+void
+ResourceManager::ReleaseResource(const ResourceHandle resourceHandle) noexcept
+{
+    ID3D12Resource* resource{ nullptr };
+    BRE_CHECK_MSG(mResources.Erase(resourceHandle, &resource), L"Resource handle is stale");
+    BRE_ASSERT(resource != nullptr);
+
+    ResourceStateManager::RemoveResourceTracking(*resource);
+    MemoryTracker::RegisterDeallocation(GetMemoryCategory(*resource),
+                                        GetAllocationSize(*resource));
+    resource->Release();
+}
+
+ResourceManager::SharedResource
+ResourceManager::ShareResource(ID3D12Resource& resource,
+                               const ResourceHandle resourceHandle) noexcept
+{
+    BRE_ASSERT(resourceHandle.IsNull() == false);
+
+    return mDeferredReleaseQueue.MakeShared(resource,
+                                            [resourceHandle]() {
+        ReleaseResource(resourceHandle);
+    });
 }
 
 ID3D12Resource&
 ResourceManager::LoadTextureFromFile(const char* textureFilename,
-                                     ID3D12GraphicsCommandList& commandList,
-                                     ID3D12Resource* &uploadBuffer,
-                                     const wchar_t* resourceName) noexcept
+                                     const wchar_t* resourceName,
+                                     ResourceHandle* resourceHandle) noexcept
 {
+    BRE_ASSERT(textureFilename != nullptr);
+
+    // File is mapped and parsed in place, so subresources are copied straight from
+    // the mapping to the staging ring buffer. It does not need the device, so it runs
+    // outside the lock and several textures can be loaded in parallel.
+    MemoryMappedFile textureFile;
+    const std::wstring errorMsg =
+        L"Failed to open texture file: " + StringUtils::AnsiToWideString(textureFilename);
+    BRE_CHECK_MSG(textureFile.Open(textureFilename), errorMsg.c_str());
+
+    D3D12_RESOURCE_DESC resourceDescriptor{};
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+    BRE_CHECK_HR(DirectX::LoadDDSTextureDataFromMemory12(textureFile.GetData(),
+                                                         textureFile.GetSize(),
+                                                         resourceDescriptor,
+                                                         subresources));
+
+    // File can be unmapped as soon as it is copied to the staging ring buffer.
+    return CreateTexture(resourceDescriptor,
+                         subresources.data(),
+                         static_cast<std::uint32_t>(subresources.size()),
+                         resourceName,
+                         resourceHandle);
+}
+
+ID3D12Resource&
+ResourceManager::CreateTexture(const D3D12_RESOURCE_DESC& resourceDescriptor,
+                               const D3D12_SUBRESOURCE_DATA* subresources,
+                               const std::uint32_t subresourceCount,
+                               const wchar_t* resourceName,
+                               ResourceHandle* resourceHandle) noexcept
+{
+    BRE_ASSERT(subresources != nullptr);
+    BRE_ASSERT(subresourceCount > 0U);
+
     ID3D12Resource* resource{ nullptr };
 
-    BRE_ASSERT(textureFilename != nullptr);
-    const std::string filePath(textureFilename);
-    const std::wstring filePathW(StringUtils::AnsiToWideString(filePath));
+    const D3D12_HEAP_PROPERTIES heapProperties = D3DFactory::GetHeapProperties(D3D12_HEAP_TYPE_DEFAULT,
+                                                                               D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
+                                                                               D3D12_MEMORY_POOL_UNKNOWN,
+                                                                               1U,
+                                                                               1U);
 
-    Microsoft::WRL::ComPtr<ID3D12Resource> resourcePtr;
-    Microsoft::WRL::ComPtr<ID3D12Resource> uploadBufferPtr;
     mMutex.lock();
-    BRE_CHECK_HR(DirectX::CreateDDSTextureFromFile12(&DirectXManager::GetDevice(),
-                                                     &commandList,
-                                                     filePathW.c_str(),
-                                                     resourcePtr,
-                                                     uploadBufferPtr));
+    BRE_CHECK_HR(DirectXManager::GetDevice().CreateCommittedResource(&heapProperties,
+                                                                     D3D12_HEAP_FLAG_NONE,
+                                                                     &resourceDescriptor,
+                                                                     D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                     nullptr,
+                                                                     IID_PPV_ARGS(&resource)));
     mMutex.unlock();
 
-    uploadBuffer = uploadBufferPtr.Detach();
-
-    resource = resourcePtr.Detach();
-
     BRE_ASSERT(resource != nullptr);
-    mResources.insert(resource);
+    RegisterResource(*resource, resourceHandle);
+
+    StagingRingBuffer::UploadTextureSubresources(*resource,
+                                                 subresources,
+                                                 subresourceCount,
+                                                 D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
     if (resourceName != nullptr) {
         resource->SetName(resourceName);
@@ -62,9 +182,8 @@ ResourceManager::LoadTextureFromFile(const char* textureFilename,
 ID3D12Resource&
 ResourceManager::CreateDefaultBuffer(const void* sourceData,
                                      const std::size_t sourceDataSize,
-                                     ID3D12GraphicsCommandList& commandList,
-                                     ID3D12Resource* &uploadBuffer,
-                                     const wchar_t* resourceName) noexcept
+                                     const wchar_t* resourceName,
+                                     ResourceHandle* resourceHandle) noexcept
 {
     BRE_ASSERT(sourceData != nullptr);
     BRE_ASSERT(sourceDataSize > 0);
@@ -72,11 +191,11 @@ ResourceManager::CreateDefaultBuffer(const void* sourceData,
     ID3D12Resource* resource{ nullptr };
 
     // Create the actual default buffer resource.
-    D3D12_HEAP_PROPERTIES heapProperties = D3DFactory::GetHeapProperties(D3D12_HEAP_TYPE_DEFAULT,
-                                                                         D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-                                                                         D3D12_MEMORY_POOL_UNKNOWN,
-                                                                         1U,
-                                                                         1U);
+    const D3D12_HEAP_PROPERTIES heapProperties = D3DFactory::GetHeapProperties(D3D12_HEAP_TYPE_DEFAULT,
+                                                                               D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
+                                                                               D3D12_MEMORY_POOL_UNKNOWN,
+                                                                               1U,
+                                                                               1U);
 
     const D3D12_RESOURCE_DESC resourceDescriptor = D3DFactory::GetResourceDescriptor(sourceDataSize,
                                                                                      1,
@@ -92,52 +211,16 @@ ResourceManager::CreateDefaultBuffer(const void* sourceData,
                                                                      D3D12_RESOURCE_STATE_COMMON,
                                                                      nullptr,
                                                                      IID_PPV_ARGS(&resource)));
-
-    // In order to copy CPU memory data into our default buffer, we need to create
-    // an intermediate upload heap. 
-    heapProperties = D3DFactory::GetHeapProperties(D3D12_HEAP_TYPE_UPLOAD,
-                                                   D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
-                                                   D3D12_MEMORY_POOL_UNKNOWN,
-                                                   1U,
-                                                   1U);
-
-    BRE_CHECK_HR(DirectXManager::GetDevice().CreateCommittedResource(&heapProperties,
-                                                                     D3D12_HEAP_FLAG_NONE,
-                                                                     &resourceDescriptor,
-                                                                     D3D12_RESOURCE_STATE_GENERIC_READ,
-                                                                     nullptr,
-                                                                     IID_PPV_ARGS(&uploadBuffer)));
     mMutex.unlock();
 
-    // Describe the data we want to copy into the default buffer.
-    D3D12_SUBRESOURCE_DATA subResourceData = {};
-    subResourceData.pData = sourceData;
-    subResourceData.RowPitch = sourceDataSize;
-    subResourceData.SlicePitch = subResourceData.RowPitch;
-
-    // Schedule to copy the data to the default buffer resource. At a high level, the helper function UpdateSubresources
-    // will copy the CPU memory into the intermediate upload heap.  Then, using ID3D12CommandList::CopySubresourceRegion,
-    // the intermediate upload heap data will be copied to mBuffer.
-    D3D12_RESOURCE_BARRIER resourceBarrier = D3DFactory::GetTransitionResourceBarrier(*resource,
-                                                                                      D3D12_RESOURCE_STATE_COMMON,
-                                                                                      D3D12_RESOURCE_STATE_COPY_DEST); 
-    commandList.ResourceBarrier(1, &resourceBarrier);
-
-    UpdateSubresources<1>(&commandList, 
-                          resource, 
-                          uploadBuffer, 
-                          0, 
-                          0, 
-                          1,
-                          &subResourceData);
-
-    resourceBarrier = D3DFactory::GetTransitionResourceBarrier(*resource,
-                                                               D3D12_RESOURCE_STATE_COPY_DEST,
-                                                               D3D12_RESOURCE_STATE_GENERIC_READ);
-    commandList.ResourceBarrier(1, &resourceBarrier);
+    // The buffer stays in D3D12_RESOURCE_STATE_COMMON. It is implicitly promoted
+    // to the read states vertex and index buffers need.
+    StagingRingBuffer::UploadBufferData(*resource,
+                                        sourceData,
+                                        sourceDataSize);
 
     BRE_ASSERT(resource != nullptr);
-    mResources.insert(resource);
+    RegisterResource(*resource, resourceHandle);
 
     if (resourceName != nullptr) {
         resource->SetName(resourceName);
@@ -153,7 +236,8 @@ ResourceManager::CreateCommittedResource(const D3D12_HEAP_PROPERTIES& heapProper
                                          const D3D12_RESOURCE_STATES& resourceStates,
                                          const D3D12_CLEAR_VALUE* clearValue,
                                          const wchar_t* resourceName,
-                                         const ResourceStateTrackingType resourceStateTrackingType) noexcept
+                                         const ResourceStateTrackingType resourceStateTrackingType,
+                                         ResourceHandle* resourceHandle) noexcept
 {
     ID3D12Resource* resource{ nullptr };
 
@@ -183,7 +267,7 @@ ResourceManager::CreateCommittedResource(const D3D12_HEAP_PROPERTIES& heapProper
     };
 
     BRE_ASSERT(resource != nullptr);
-    mResources.insert(resource);
+    RegisterResource(*resource, resourceHandle);
 
     if (resourceName != nullptr) {
         resource->SetName(resourceName);
@@ -191,4 +275,17 @@ ResourceManager::CreateCommittedResource(const D3D12_HEAP_PROPERTIES& heapProper
 
     return *resource;
 }
+
+void
+ResourceManager::RegisterResource(ID3D12Resource& resource,
+                                  ResourceHandle* resourceHandle) noexcept
+{
+    const ResourceHandle handle = mResources.Insert(&resource);
+    if (resourceHandle != nullptr) {
+        *resourceHandle = handle;
+    }
+
+    MemoryTracker::RegisterAllocation(GetMemoryCategory(resource),
+                                      GetAllocationSize(resource));
+}
 }
\ No newline at end of file
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <d3d12.h>
+#include <memory>
 #include <mutex>
-#include <tbb/concurrent_unordered_set.h>
 
-#include <ResourceManager/UploadBuffer.h>
+#include <ResourceManager\DeferredReleaseQueue.h>
+#include <ResourceManager\UploadBuffer.h>
+#include <Utils\SlotMap.h>
 
 namespace BRE {
 ///
@@ -29,6 +31,12 @@ public:
         SUBRESOURCE_TRACKING,
     };
 
+    using ResourceHandle = SlotMap<ID3D12Resource*>::Handle;
+
+    // Reference counted resource. When its last copy is destroyed, the resource
+    // is released once the GPU finished the frames that could use it.
+    using SharedResource = std::shared_ptr<ID3D12Resource>;
+
     ResourceManager() = delete;
     ~ResourceManager() = delete;
     ResourceManager(const ResourceManager&) = delete;
@@ -39,43 +47,96 @@ public:
     ///
     /// @brief Releases all resources
     ///
+    /// Pending deferred releases are run first, so the GPU must be idle.
+    ///
     static void Clear() noexcept;
 
+    ///
+    /// @brief Get the queue of releases deferred until the GPU finished the frames that
+    /// could use the released objects. It is shared by all the managers.
+    ///
+    /// The master render task updates its frame fence value and runs its completed releases each frame.
+    ///
+    /// @return Deferred release queue
+    ///
+    static DeferredReleaseQueue& GetDeferredReleaseQueue() noexcept
+    {
+        return mDeferredReleaseQueue;
+    }
+
+    ///
+    /// @brief Creates a reference counted handle of a resource
+    ///
+    /// When its last copy is destroyed, the resource is released (see ReleaseResource())
+    /// once the GPU finished the frame that is being recorded. It can be called from several threads at the same time.
+    ///
+    /// @param resource Resource
+    /// @param resourceHandle Resource handle. It must not be stale, and the resource
+    /// must not be released through it anymore.
+    /// @return Reference counted resource
+    ///
+    static SharedResource ShareResource(ID3D12Resource& resource,
+                                        const ResourceHandle resourceHandle) noexcept;
+
+    ///
+    /// @brief Releases a resource
+    ///
+    /// The GPU must not use the resource anymore. Its resource state tracking is removed.
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param resourceHandle Resource handle. It must not be stale.
+    ///
+    static void ReleaseResource(const ResourceHandle resourceHandle) noexcept;
+
     ///
     /// @brief Loads texture from file
+    ///
+    /// Texture content is uploaded through StagingRingBuffer.
+    /// StagingRingBuffer::Flush() must be called before the texture is used.
+    /// It can be called from several threads at the same time.
+    ///
     /// @param textureFilename Texture filename. Must be not nullptr
-    /// @param commandList Command list used to upload texture content to GPU.
-    /// It must be executed after this function call to upload texture content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadBuffer Upload buffer to upload the texture content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadBuffer after it knows the copy has been executed.
     /// @param resourceName Resource name. If it is nullptr, then it will have the default name.
+    /// @param resourceHandle Output resource handle, to release the resource. It can be nullptr.
     ///
     static ID3D12Resource& LoadTextureFromFile(const char* textureFilename,
-                                               ID3D12GraphicsCommandList& commandList,
-                                               ID3D12Resource* &uploadBuffer,
-                                               const wchar_t* resourceName) noexcept;
+                                               const wchar_t* resourceName,
+                                               ResourceHandle* resourceHandle = nullptr) noexcept;
+
+    ///
+    /// @brief Creates a texture with all its subresources
+    ///
+    /// Texture content is uploaded through StagingRingBuffer.
+    /// StagingRingBuffer::Flush() must be called before the texture is used.
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param resourceDescriptor Texture descriptor
+    /// @param subresources Subresources data. Must not be nullptr. They can be freed after this call.
+    /// @param subresourceCount Number of subresources. Must be greater than zero.
+    /// @param resourceName Resource name. If it is nullptr, then it will have the default name.
+    /// @param resourceHandle Output resource handle, to release the resource. It can be nullptr.
+    ///
+    static ID3D12Resource& CreateTexture(const D3D12_RESOURCE_DESC& resourceDescriptor,
+                                         const D3D12_SUBRESOURCE_DATA* subresources,
+                                         const std::uint32_t subresourceCount,
+                                         const wchar_t* resourceName,
+                                         ResourceHandle* resourceHandle = nullptr) noexcept;
 
     ///
     /// @brief Creates default buffer
+    ///
+    /// Buffer content is uploaded through StagingRingBuffer.
+    /// StagingRingBuffer::Flush() must be called before the buffer is used.
+    ///
     /// @param sourceData Source data for the buffer
     /// @param sourceDataSize Source data size for the buffer
-    /// @param commandList Command list used to upload buffer content to GPU.
-    /// It must be executed after this function call to upload buffer content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadBuffer Upload buffer to upload the buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadBuffer after it knows the copy has been executed.
     /// @param resourceName Resource name. If it is nullptr, then it will have the default name.
+    /// @param resourceHandle Output resource handle, to release the resource. It can be nullptr.
     ///
     static ID3D12Resource& CreateDefaultBuffer(const void* sourceData,
                                                const std::size_t sourceDataSize,
-                                               ID3D12GraphicsCommandList& commandList,
-                                               ID3D12Resource* &uploadBuffer,
-                                               const wchar_t* resourceName) noexcept;
+                                               const wchar_t* resourceName,
+                                               ResourceHandle* resourceHandle = nullptr) noexcept;
 
     ///
     /// @brief Creates committed resource
@@ -85,6 +146,8 @@ public:
     /// @param resourceStates Resource states
     /// @param clearValue Clear value
     /// @param resourceName Resource name. If it is nullptr, then it will have the default name.
+    /// @param resourceStateTrackingType Resource state tracking type
+    /// @param resourceHandle Output resource handle, to release the resource. It can be nullptr.
     ///
     static ID3D12Resource& CreateCommittedResource(const D3D12_HEAP_PROPERTIES& heapProperties,
                                                    const D3D12_HEAP_FLAGS& heapFlags,
@@ -92,10 +155,22 @@ public:
                                                    const D3D12_RESOURCE_STATES& resourceStates,
                                                    const D3D12_CLEAR_VALUE* clearValue,
                                                    const wchar_t* resourceName,
-                                                   const ResourceStateTrackingType resourceStateTrackingType) noexcept;
+                                                   const ResourceStateTrackingType resourceStateTrackingType,
+                                                   ResourceHandle* resourceHandle = nullptr) noexcept;
 
 private:
-    static tbb::concurrent_unordered_set<ID3D12Resource*> mResources;
+    ///
+    /// @brief Registers a created resource
+    /// @param resource Resource
+    /// @param resourceHandle Output resource handle. It can be nullptr.
+    ///
+    static void RegisterResource(ID3D12Resource& resource,
+                                 ResourceHandle* resourceHandle) noexcept;
+
+    // Resources are released individually through their handle, or all at once by Clear()
+    static SlotMap<ID3D12Resource*> mResources;
+
+    static DeferredReleaseQueue mDeferredReleaseQueue;
 
     static std::mutex mMutex;
 };
@@ -0,0 +1,498 @@
+#include "StagingRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <CommandListExecutor\CommandListExecutor.h>
+#include <CommandManager\CommandAllocatorManager.h>
+#include <CommandManager\CommandListManager.h>
+#include <CommandManager\FenceManager.h>
+#include <DirectXManager\DirectXManager.h>
+#include <DXUtils\D3DFactory.h>
+#include <ResourceManager\ResourceManager.h>
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+ID3D12Resource* StagingRingBuffer::mUploadBuffer{ nullptr };
+std::uint8_t* StagingRingBuffer::mMappedData{ nullptr };
+ID3D12Fence* StagingRingBuffer::mFence{ nullptr };
+std::uint64_t StagingRingBuffer::mFenceValue{ 0UL };
+ID3D12CommandAllocator* StagingRingBuffer::mCommandAllocator{ nullptr };
+ID3D12GraphicsCommandList* StagingRingBuffer::mCommandList{ nullptr };
+bool StagingRingBuffer::mIsRecording{ false };
+std::size_t StagingRingBuffer::mSizeInBytes{ 0UL };
+std::size_t StagingRingBuffer::mHeadOffset{ 0UL };
+std::size_t StagingRingBuffer::mTailOffset{ 0UL };
+std::size_t StagingRingBuffer::mUsedSizeInBytes{ 0UL };
+std::size_t StagingRingBuffer::mPendingSizeInBytes{ 0UL };
+std::size_t StagingRingBuffer::mPeakUsedSizeInBytes{ 0UL };
+std::uint64_t StagingRingBuffer::mTotalUploadedSizeInBytes{ 0UL };
+std::deque<StagingRingBuffer::Submission> StagingRingBuffer::mSubmissions;
+std::mutex StagingRingBuffer::mMutex;
+
+namespace {
+///
+/// @brief Aligns a value
+/// @param value Value to align
+/// @param alignment Alignment. Must be a power of two.
+/// @return Aligned value
+///
+std::size_t
+AlignUp(const std::size_t value,
+        const std::size_t alignment) noexcept
+{
+    BRE_ASSERT(alignment > 0UL && (alignment & (alignment - 1UL)) == 0UL);
+    return (value + alignment - 1UL) & ~(alignment - 1UL);
+}
+
+///
+/// @brief Waits until a fence reaches a value
+/// @param fence Fence to wait for
+/// @param valueToWaitFor Value that @p fence must reach
+///
+void
+WaitForFenceValue(ID3D12Fence& fence,
+                  const std::uint64_t valueToWaitFor) noexcept
+{
+    if (fence.GetCompletedValue() < valueToWaitFor) {
+        const HANDLE eventHandle{ CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS) };
+        BRE_ASSERT(eventHandle);
+
+        BRE_CHECK_HR(fence.SetEventOnCompletion(valueToWaitFor, eventHandle));
+
+        WaitForSingleObject(eventHandle, INFINITE);
+        CloseHandle(eventHandle);
+    }
+}
+}
+
+void
+StagingRingBuffer::Init(const std::size_t sizeInBytes) noexcept
+{
+    BRE_ASSERT(mUploadBuffer == nullptr);
+    BRE_ASSERT(sizeInBytes > 0UL);
+
+    mSizeInBytes = AlignUp(sizeInBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    const D3D12_HEAP_PROPERTIES heapProperties = D3DFactory::GetHeapProperties(D3D12_HEAP_TYPE_UPLOAD,
+                                                                               D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
+                                                                               D3D12_MEMORY_POOL_UNKNOWN,
+                                                                               1U,
+                                                                               1U);
+
+    const D3D12_RESOURCE_DESC resourceDescriptor = D3DFactory::GetResourceDescriptor(mSizeInBytes,
+                                                                                     1,
+                                                                                     DXGI_FORMAT_UNKNOWN,
+                                                                                     D3D12_RESOURCE_FLAG_NONE,
+                                                                                     D3D12_RESOURCE_DIMENSION_BUFFER,
+                                                                                     D3D12_TEXTURE_LAYOUT_ROW_MAJOR);
+
+    mUploadBuffer = &ResourceManager::CreateCommittedResource(heapProperties,
+                                                              D3D12_HEAP_FLAG_NONE,
+                                                              resourceDescriptor,
+                                                              D3D12_RESOURCE_STATE_GENERIC_READ,
+                                                              nullptr,
+                                                              L"Staging Ring Buffer",
+                                                              ResourceManager::ResourceStateTrackingType::NO_TRACKING);
+
+    // The upload heap is kept mapped until it is released.
+    BRE_CHECK_HR(mUploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mMappedData)));
+
+    mFence = &FenceManager::CreateFence(0U, D3D12_FENCE_FLAG_NONE);
+    mCommandAllocator = &CommandAllocatorManager::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
+    mCommandList = &CommandListManager::CreateCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT, *mCommandAllocator);
+    mCommandList->Close();
+}
+
+void
+StagingRingBuffer::Clear() noexcept
+{
+    Flush();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mUploadBuffer != nullptr) {
+        mUploadBuffer->Unmap(0, nullptr);
+    }
+
+    mUploadBuffer = nullptr;
+    mMappedData = nullptr;
+    mFence = nullptr;
+    mFenceValue = 0UL;
+    mCommandAllocator = nullptr;
+    mCommandList = nullptr;
+    mSizeInBytes = 0UL;
+    mHeadOffset = 0UL;
+    mTailOffset = 0UL;
+    mUsedSizeInBytes = 0UL;
+    mPendingSizeInBytes = 0UL;
+}
+
+void
+StagingRingBuffer::UploadBufferData(ID3D12Resource& destinationBuffer,
+                                    const void* sourceData,
+                                    const std::size_t sourceDataSize) noexcept
+{
+    BRE_ASSERT(sourceData != nullptr);
+    BRE_ASSERT(sourceDataSize > 0UL);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    BRE_ASSERT(mUploadBuffer != nullptr);
+
+    // Buffers are implicitly promoted from D3D12_RESOURCE_STATE_COMMON to
+    // D3D12_RESOURCE_STATE_COPY_DEST, and decay back to it once the copy is completed,
+    // so no barriers are needed.
+    const std::uint8_t* source{ static_cast<const std::uint8_t*>(sourceData) };
+    std::size_t copiedSize{ 0UL };
+    while (copiedSize < sourceDataSize) {
+        const std::size_t chunkSize{ std::min(sourceDataSize - copiedSize, mSizeInBytes) };
+        const std::size_t offset{ Allocate(chunkSize, 16UL) };
+        memcpy(mMappedData + offset, source + copiedSize, chunkSize);
+
+        BeginRecording();
+        mCommandList->CopyBufferRegion(&destinationBuffer,
+                                       copiedSize,
+                                       mUploadBuffer,
+                                       offset,
+                                       chunkSize);
+        copiedSize += chunkSize;
+    }
+
+    mTotalUploadedSizeInBytes += sourceDataSize;
+}
+
+void
+StagingRingBuffer::UploadTextureSubresources(ID3D12Resource& destinationTexture,
+                                             const D3D12_SUBRESOURCE_DATA* subresources,
+                                             const std::uint32_t subresourceCount,
+                                             const D3D12_RESOURCE_STATES stateAfter) noexcept
+{
+    BRE_ASSERT(subresources != nullptr);
+    BRE_ASSERT(subresourceCount > 0U);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    BRE_ASSERT(mUploadBuffer != nullptr);
+
+    RecordTextureSubresourceCopies(destinationTexture,
+                                   0U,
+                                   subresources,
+                                   subresourceCount);
+
+    BeginRecording();
+    const D3D12_RESOURCE_BARRIER barrier = D3DFactory::GetTransitionResourceBarrier(destinationTexture,
+                                                                                    D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                                    stateAfter);
+    mCommandList->ResourceBarrier(1U, &barrier);
+}
+
+void
+StagingRingBuffer::UploadTextureSubresources(ID3D12Resource& destinationTexture,
+                                             const std::uint32_t firstSubresourceIndex,
+                                             const D3D12_SUBRESOURCE_DATA* subresources,
+                                             const std::uint32_t subresourceCount,
+                                             const D3D12_RESOURCE_STATES stateBefore,
+                                             const D3D12_RESOURCE_STATES stateAfter) noexcept
+{
+    BRE_ASSERT(subresources != nullptr);
+    BRE_ASSERT(subresourceCount > 0U);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    BRE_ASSERT(mUploadBuffer != nullptr);
+
+    // Only the uploaded subresources are transitioned, so the others
+    // can be used by the GPU in the meantime.
+    std::vector<D3D12_RESOURCE_BARRIER> barriers;
+    if (stateBefore != D3D12_RESOURCE_STATE_COPY_DEST) {
+        barriers.reserve(subresourceCount);
+        for (std::uint32_t i = 0U; i < subresourceCount; ++i) {
+            barriers.push_back(D3DFactory::GetTransitionResourceBarrier(destinationTexture,
+                                                                        stateBefore,
+                                                                        D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                        firstSubresourceIndex + i));
+        }
+
+        BeginRecording();
+        mCommandList->ResourceBarrier(subresourceCount, barriers.data());
+    }
+
+    RecordTextureSubresourceCopies(destinationTexture,
+                                   firstSubresourceIndex,
+                                   subresources,
+                                   subresourceCount);
+
+    if (stateAfter != D3D12_RESOURCE_STATE_COPY_DEST) {
+        barriers.clear();
+        barriers.reserve(subresourceCount);
+        for (std::uint32_t i = 0U; i < subresourceCount; ++i) {
+            barriers.push_back(D3DFactory::GetTransitionResourceBarrier(destinationTexture,
+                                                                        D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                        stateAfter,
+                                                                        firstSubresourceIndex + i));
+        }
+
+        BeginRecording();
+        mCommandList->ResourceBarrier(subresourceCount, barriers.data());
+    }
+}
+
+std::uint64_t
+StagingRingBuffer::SubmitPendingUploads() noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    BRE_ASSERT(mUploadBuffer != nullptr);
+
+    Submit();
+
+    return mFenceValue;
+}
+
+bool
+StagingRingBuffer::IsUploadCompleted(const std::uint64_t uploadFenceValue) noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    BRE_ASSERT(mFence != nullptr);
+
+    RetireCompletedSubmissions();
+
+    return mFence->GetCompletedValue() >= uploadFenceValue;
+}
+
+void
+StagingRingBuffer::Flush() noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mUploadBuffer == nullptr) {
+        return;
+    }
+
+    Submit();
+    while (mSubmissions.empty() == false) {
+        WaitForOldestSubmission();
+    }
+
+    // Nothing references the allocator memory anymore
+    BRE_ASSERT(mIsRecording == false);
+    BRE_CHECK_HR(mCommandAllocator->Reset());
+}
+
+std::size_t
+StagingRingBuffer::GetSizeInBytes() noexcept
+{
+    return mSizeInBytes;
+}
+
+std::size_t
+StagingRingBuffer::GetPeakUsedSizeInBytes() noexcept
+{
+    return mPeakUsedSizeInBytes;
+}
+
+std::uint64_t
+StagingRingBuffer::GetTotalUploadedSizeInBytes() noexcept
+{
+    return mTotalUploadedSizeInBytes;
+}
+
+std::size_t
+StagingRingBuffer::Allocate(const std::size_t sizeInBytes,
+                            const std::size_t alignment) noexcept
+{
+    BRE_ASSERT(sizeInBytes <= mSizeInBytes);
+
+    std::size_t offset{ 0UL };
+    while (TryAllocate(sizeInBytes, alignment, offset) == false) {
+        // Pending copies must be submitted before their memory can be reclaimed.
+        Submit();
+        BRE_ASSERT(mSubmissions.empty() == false);
+        WaitForOldestSubmission();
+    }
+
+    return offset;
+}
+
+bool
+StagingRingBuffer::TryAllocate(const std::size_t sizeInBytes,
+                               const std::size_t alignment,
+                               std::size_t& offset) noexcept
+{
+    if (mUsedSizeInBytes == 0UL) {
+        mHeadOffset = 0UL;
+        mTailOffset = 0UL;
+    }
+
+    const std::size_t alignedHeadOffset{ AlignUp(mHeadOffset, alignment) };
+    std::size_t consumedSize{ 0UL };
+
+    if (mHeadOffset >= mTailOffset && (mUsedSizeInBytes == 0UL || mHeadOffset != mTailOffset)) {
+        // Free memory is [head, end) and [0, tail)
+        if (alignedHeadOffset + sizeInBytes <= mSizeInBytes) {
+            offset = alignedHeadOffset;
+            consumedSize = alignedHeadOffset + sizeInBytes - mHeadOffset;
+        } else if (sizeInBytes <= mTailOffset) {
+            // Wrap around. Memory at the end of the ring is wasted until the tail reaches it.
+            offset = 0UL;
+            consumedSize = mSizeInBytes - mHeadOffset + sizeInBytes;
+        } else {
+            return false;
+        }
+    } else {
+        // Free memory is [head, tail)
+        if (alignedHeadOffset + sizeInBytes <= mTailOffset) {
+            offset = alignedHeadOffset;
+            consumedSize = alignedHeadOffset + sizeInBytes - mHeadOffset;
+        } else {
+            return false;
+        }
+    }
+
+    mHeadOffset = offset + sizeInBytes;
+    mUsedSizeInBytes += consumedSize;
+    mPendingSizeInBytes += consumedSize;
+    mPeakUsedSizeInBytes = std::max(mPeakUsedSizeInBytes, mUsedSizeInBytes);
+
+    return true;
+}
+
+void
+StagingRingBuffer::RecordTextureSubresourceCopies(ID3D12Resource& destinationTexture,
+                                                  const std::uint32_t firstSubresourceIndex,
+                                                  const D3D12_SUBRESOURCE_DATA* subresources,
+                                                  const std::uint32_t subresourceCount) noexcept
+{
+    const D3D12_RESOURCE_DESC textureDescriptor = destinationTexture.GetDesc();
+
+    for (std::uint32_t i = 0U; i < subresourceCount; ++i) {
+        const D3D12_SUBRESOURCE_DATA& subresource = subresources[i];
+        BRE_ASSERT(subresource.pData != nullptr);
+
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout{};
+        std::uint32_t rowCount{ 0U };
+        std::uint64_t rowSizeInBytes{ 0UL };
+        DirectXManager::GetDevice().GetCopyableFootprints(&textureDescriptor,
+                                                          firstSubresourceIndex + i,
+                                                          1U,
+                                                          0UL,
+                                                          &layout,
+                                                          &rowCount,
+                                                          &rowSizeInBytes,
+                                                          nullptr);
+
+        // Rows of block-compressed formats contain several texel rows.
+        const std::uint32_t rowPitch{ layout.Footprint.RowPitch };
+        const std::uint32_t texelRowsPerRow{ std::max(layout.Footprint.Height / rowCount, 1U) };
+        const std::uint32_t maxRowsPerChunk{ static_cast<std::uint32_t>(mSizeInBytes / rowPitch) };
+        BRE_CHECK_MSG(maxRowsPerChunk > 0U, L"Staging ring buffer is too small to upload a texture row");
+
+        // Subresources are copied per depth slice, and slices are split in chunks of rows
+        // when they do not fit in the ring.
+        for (std::uint32_t slice = 0U; slice < layout.Footprint.Depth; ++slice) {
+            const std::uint8_t* sliceData{
+                static_cast<const std::uint8_t*>(subresource.pData) + slice * subresource.SlicePitch
+            };
+
+            std::uint32_t firstRow{ 0U };
+            while (firstRow < rowCount) {
+                const std::uint32_t chunkRowCount{ std::min(rowCount - firstRow, maxRowsPerChunk) };
+                const std::size_t offset{ Allocate(static_cast<std::size_t>(chunkRowCount) * rowPitch,
+                                                   D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT) };
+
+                for (std::uint32_t row = 0U; row < chunkRowCount; ++row) {
+                    memcpy(mMappedData + offset + row * rowPitch,
+                           sliceData + (firstRow + row) * subresource.RowPitch,
+                           static_cast<std::size_t>(rowSizeInBytes));
+                }
+
+                D3D12_TEXTURE_COPY_LOCATION source{};
+                source.pResource = mUploadBuffer;
+                source.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+                source.PlacedFootprint.Offset = offset;
+                source.PlacedFootprint.Footprint = layout.Footprint;
+                source.PlacedFootprint.Footprint.Height = std::min(chunkRowCount * texelRowsPerRow,
+                                                                   layout.Footprint.Height - firstRow * texelRowsPerRow);
+                source.PlacedFootprint.Footprint.Depth = 1U;
+
+                D3D12_TEXTURE_COPY_LOCATION destination{};
+                destination.pResource = &destinationTexture;
+                destination.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+                destination.SubresourceIndex = firstSubresourceIndex + i;
+
+                BeginRecording();
+                mCommandList->CopyTextureRegion(&destination,
+                                                0U,
+                                                firstRow * texelRowsPerRow,
+                                                slice,
+                                                &source,
+                                                nullptr);
+
+                mTotalUploadedSizeInBytes += chunkRowCount * rowSizeInBytes;
+                firstRow += chunkRowCount;
+            }
+        }
+    }
+}
+
+void
+StagingRingBuffer::BeginRecording() noexcept
+{
+    if (mIsRecording == false) {
+        BRE_CHECK_HR(mCommandList->Reset(mCommandAllocator, nullptr));
+        mIsRecording = true;
+    }
+}
+
+void
+StagingRingBuffer::Submit() noexcept
+{
+    if (mIsRecording == false) {
+        BRE_ASSERT(mPendingSizeInBytes == 0UL);
+        return;
+    }
+
+    BRE_CHECK_HR(mCommandList->Close());
+    mIsRecording = false;
+
+    ID3D12CommandQueue& commandQueue = CommandListExecutor::Get().GetCommandQueue();
+    ID3D12CommandList* commandLists[1U]{ mCommandList };
+    commandQueue.ExecuteCommandLists(_countof(commandLists), commandLists);
+
+    ++mFenceValue;
+    BRE_CHECK_HR(commandQueue.Signal(mFence, mFenceValue));
+
+    Submission submission;
+    submission.mFenceValue = mFenceValue;
+    submission.mEndOffset = mHeadOffset;
+    submission.mSizeInBytes = mPendingSizeInBytes;
+    mSubmissions.push_back(submission);
+
+    mPendingSizeInBytes = 0UL;
+}
+
+void
+StagingRingBuffer::RetireCompletedSubmissions() noexcept
+{
+    const std::uint64_t completedFenceValue{ mFence->GetCompletedValue() };
+    while (mSubmissions.empty() == false && mSubmissions.front().mFenceValue <= completedFenceValue) {
+        WaitForOldestSubmission();
+    }
+
+    // Nothing references the allocator memory anymore
+    if (mSubmissions.empty() && mIsRecording == false) {
+        BRE_CHECK_HR(mCommandAllocator->Reset());
+    }
+}
+
+void
+StagingRingBuffer::WaitForOldestSubmission() noexcept
+{
+    BRE_ASSERT(mSubmissions.empty() == false);
+
+    const Submission& submission = mSubmissions.front();
+    WaitForFenceValue(*mFence, submission.mFenceValue);
+
+    mTailOffset = submission.mEndOffset;
+    BRE_ASSERT(mUsedSizeInBytes >= submission.mSizeInBytes);
+    mUsedSizeInBytes -= submission.mSizeInBytes;
+
+    mSubmissions.pop_front();
+}
+}
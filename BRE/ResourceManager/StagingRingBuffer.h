@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <deque>
+#include <mutex>
+
+namespace BRE {
+///
+/// @brief Responsible to upload buffers and textures content to GPU through a single
+/// persistently mapped upload heap that is recycled using a fence.
+///
+/// Allocations are placed one after another in a ring. Each submission to the GPU
+/// signals the fence, and its ring region is reclaimed once the fence reaches that value.
+/// Uploads that are larger than the ring are split in chunks.
+///
+/// Steps:
+/// - Call StagingRingBuffer::Init() once, after the device is created.
+/// - Call UploadBufferData() and UploadTextureSubresources() as many times as needed.
+/// - Call Flush() to submit pending copies and wait until they are completed.
+/// - Call StagingRingBuffer::Clear() at shutdown.
+///
+class StagingRingBuffer {
+public:
+    StagingRingBuffer() = delete;
+    ~StagingRingBuffer() = delete;
+    StagingRingBuffer(const StagingRingBuffer&) = delete;
+    const StagingRingBuffer& operator=(const StagingRingBuffer&) = delete;
+    StagingRingBuffer(StagingRingBuffer&&) = delete;
+    StagingRingBuffer& operator=(StagingRingBuffer&&) = delete;
+
+    ///
+    /// @brief Initializes the staging ring buffer
+    /// @param sizeInBytes Size in bytes of the ring. Must be greater than zero.
+    ///
+    static void Init(const std::size_t sizeInBytes) noexcept;
+
+    ///
+    /// @brief Waits for all the pending uploads and resets the ring state.
+    ///
+    /// Upload heap, fence and command objects are released by its managers.
+    ///
+    static void Clear() noexcept;
+
+    ///
+    /// @brief Uploads data to a buffer.
+    ///
+    /// The copy is not completed until Flush() is called.
+    /// The buffer must be in D3D12_RESOURCE_STATE_COMMON, it decays back to it after the copy.
+    ///
+    /// @param destinationBuffer Buffer where data is copied to
+    /// @param sourceData Source data. Must not be nullptr. It can be freed after this call.
+    /// @param sourceDataSize Source data size in bytes. Must be greater than zero.
+    ///
+    static void UploadBufferData(ID3D12Resource& destinationBuffer,
+                                 const void* sourceData,
+                                 const std::size_t sourceDataSize) noexcept;
+
+    ///
+    /// @brief Uploads subresources to a texture.
+    ///
+    /// The copy is not completed until Flush() is called.
+    /// The texture must be in D3D12_RESOURCE_STATE_COPY_DEST, and it is transitioned
+    /// to @p stateAfter after the copy.
+    ///
+    /// @param destinationTexture Texture where data is copied to
+    /// @param subresources Subresources data. Must not be nullptr. They can be freed after this call.
+    /// @param subresourceCount Number of subresources. Must be greater than zero.
+    /// @param stateAfter State of the texture after the upload
+    ///
+    static void UploadTextureSubresources(ID3D12Resource& destinationTexture,
+                                          const D3D12_SUBRESOURCE_DATA* subresources,
+                                          const std::uint32_t subresourceCount,
+                                          const D3D12_RESOURCE_STATES stateAfter) noexcept;
+
+    ///
+    /// @brief Uploads a range of subresources to a texture.
+    ///
+    /// The copy is not completed until Flush() is called, or until the fence value
+    /// returned by SubmitPendingUploads() is completed.
+    /// Only the subresources in the range are transitioned, so the GPU can keep
+    /// reading the others while the copy is in flight.
+    ///
+    /// @param destinationTexture Texture where data is copied to
+    /// @param firstSubresourceIndex Index of the first subresource to upload
+    /// @param subresources Subresources data. Must not be nullptr. They can be freed after this call.
+    /// @param subresourceCount Number of subresources. Must be greater than zero.
+    /// @param stateBefore State of the subresources before the upload
+    /// @param stateAfter State of the subresources after the upload
+    ///
+    static void UploadTextureSubresources(ID3D12Resource& destinationTexture,
+                                          const std::uint32_t firstSubresourceIndex,
+                                          const D3D12_SUBRESOURCE_DATA* subresources,
+                                          const std::uint32_t subresourceCount,
+                                          const D3D12_RESOURCE_STATES stateBefore,
+                                          const D3D12_RESOURCE_STATES stateAfter) noexcept;
+
+    ///
+    /// @brief Submits pending copies to the GPU without waiting for them
+    /// @return Fence value that is completed when all the submitted copies are completed.
+    ///
+    static std::uint64_t SubmitPendingUploads() noexcept;
+
+    ///
+    /// @brief Checks if uploads are completed
+    /// @param uploadFenceValue Fence value returned by SubmitPendingUploads()
+    /// @return True if all the uploads submitted up to @p uploadFenceValue are completed.
+    ///
+    static bool IsUploadCompleted(const std::uint64_t uploadFenceValue) noexcept;
+
+    ///
+    /// @brief Submits pending copies and waits until all of them are completed.
+    ///
+    static void Flush() noexcept;
+
+    ///
+    /// @brief Get ring size
+    /// @return Ring size in bytes
+    ///
+    static std::size_t GetSizeInBytes() noexcept;
+
+    ///
+    /// @brief Get the peak of ring memory in use (including alignment and wrap-around padding)
+    /// @return Peak of used staging memory in bytes
+    ///
+    static std::size_t GetPeakUsedSizeInBytes() noexcept;
+
+    ///
+    /// @brief Get the total amount of bytes uploaded through the ring
+    /// @return Total uploaded size in bytes
+    ///
+    static std::uint64_t GetTotalUploadedSizeInBytes() noexcept;
+
+private:
+    ///
+    /// @brief Allocates ring memory. If there is no room, it submits pending copies
+    /// and waits for the oldest submissions until the allocation fits.
+    /// @param sizeInBytes Allocation size. Must be not greater than ring size.
+    /// @param alignment Allocation alignment. Must be a power of two.
+    /// @return Offset of the allocation in the ring
+    ///
+    static std::size_t Allocate(const std::size_t sizeInBytes,
+                                const std::size_t alignment) noexcept;
+
+    ///
+    /// @brief Tries to allocate ring memory without waiting
+    /// @param sizeInBytes Allocation size
+    /// @param alignment Allocation alignment. Must be a power of two.
+    /// @param offset Output offset of the allocation in the ring
+    /// @return True if allocation succeeded. Otherwise, false.
+    ///
+    static bool TryAllocate(const std::size_t sizeInBytes,
+                            const std::size_t alignment,
+                            std::size_t& offset) noexcept;
+
+    ///
+    /// @brief Records the copies of a range of subresources to a texture,
+    /// that must be in D3D12_RESOURCE_STATE_COPY_DEST.
+    /// @param destinationTexture Texture where data is copied to
+    /// @param firstSubresourceIndex Index of the first subresource to upload
+    /// @param subresources Subresources data
+    /// @param subresourceCount Number of subresources
+    ///
+    static void RecordTextureSubresourceCopies(ID3D12Resource& destinationTexture,
+                                               const std::uint32_t firstSubresourceIndex,
+                                               const D3D12_SUBRESOURCE_DATA* subresources,
+                                               const std::uint32_t subresourceCount) noexcept;
+
+    ///
+    /// @brief Resets the command list if it is not in recording state
+    ///
+    static void BeginRecording() noexcept;
+
+    ///
+    /// @brief Closes and executes the command list with the pending copies,
+    /// and signals the fence.
+    ///
+    static void Submit() noexcept;
+
+    ///
+    /// @brief Releases the ring memory of completed submissions without waiting,
+    /// and resets the command allocator if nothing is in flight.
+    ///
+    static void RetireCompletedSubmissions() noexcept;
+
+    ///
+    /// @brief Waits until the oldest submission is completed and releases its ring memory
+    ///
+    static void WaitForOldestSubmission() noexcept;
+
+    ///
+    /// @brief Ring region that is in use by an executed command list
+    ///
+    struct Submission {
+        std::uint64_t mFenceValue{ 0UL };
+        std::size_t mEndOffset{ 0UL };
+        std::size_t mSizeInBytes{ 0UL };
+    };
+
+    static ID3D12Resource* mUploadBuffer;
+    static std::uint8_t* mMappedData;
+
+    static ID3D12Fence* mFence;
+    static std::uint64_t mFenceValue;
+    static ID3D12CommandAllocator* mCommandAllocator;
+    static ID3D12GraphicsCommandList* mCommandList;
+    static bool mIsRecording;
+
+    static std::size_t mSizeInBytes;
+    static std::size_t mHeadOffset;
+    static std::size_t mTailOffset;
+    static std::size_t mUsedSizeInBytes;
+    static std::size_t mPendingSizeInBytes;
+    static std::size_t mPeakUsedSizeInBytes;
+    static std::uint64_t mTotalUploadedSizeInBytes;
+
+    static std::deque<Submission> mSubmissions;
+
+    static std::mutex mMutex;
+};
+}
@@ -0,0 +1,388 @@
+#include "TextureCooker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <d3d12.h>
+#include <fstream>
+#include <Windows.h>
+
+#include <ApplicationSettings\ApplicationSettings.h>
+#include <ResourceManager\DDSTextureLoader.h>
+#include <Utils\DebugUtils.h>
+#include <Utils\HashUtils.h>
+#include <Utils\MemoryMappedFile.h>
+#include <Utils\StringUtils.h>
+
+namespace BRE {
+namespace {
+const char* sCacheDirectory{ "texture_cache" };
+const char* sCacheFileExtension{ ".dds" };
+
+// DDS header fields, as 32 bits words after the magic number
+const std::uint32_t sDDSMagic{ 0x20534444U }; // "DDS "
+const std::uint32_t sDDSHeaderWordCount{ 32U }; // Magic number and DDS_HEADER
+const std::uint32_t sDDSDX10HeaderWordCount{ 5U };
+const std::uint32_t sDDSFourCCWord{ 21U };
+const std::uint32_t sDDSCaps2Word{ 28U };
+const std::uint32_t sDDSDX10MiscFlagWord{ 34U };
+const std::uint32_t sDDSFourCCDX10{ 0x30315844U }; // "DX10"
+const std::uint32_t sDDSCaps2CubeMap{ 0x200U };
+const std::uint32_t sDDSResourceMiscTextureCube{ 0x4U };
+
+///
+/// @brief Checks if the DDS data is a cube map
+/// @param ddsData DDS data. It must be already validated by the DDS loader.
+/// @return True if it is a cube map. Otherwise, false.
+///
+bool
+IsCubeMap(const std::uint8_t* ddsData) noexcept
+{
+    const std::uint32_t* words = reinterpret_cast<const std::uint32_t*>(ddsData);
+    if (words[sDDSFourCCWord] == sDDSFourCCDX10) {
+        return (words[sDDSDX10MiscFlagWord] & sDDSResourceMiscTextureCube) != 0U;
+    }
+
+    return (words[sDDSCaps2Word] & sDDSCaps2CubeMap) != 0U;
+}
+
+///
+/// @brief Converts a subresource to RGBA8 texels
+/// @param subresource Subresource
+/// @param format Subresource format
+/// @param width Subresource width
+/// @param height Subresource height
+/// @param texels Output tightly packed RGBA8 texels
+/// @return True if the format is supported. Otherwise, false.
+///
+bool
+ConvertToRGBA8(const D3D12_SUBRESOURCE_DATA& subresource,
+               const DXGI_FORMAT format,
+               const std::uint32_t width,
+               const std::uint32_t height,
+               std::vector<std::uint8_t>& texels) noexcept
+{
+    texels.resize(static_cast<std::size_t>(width) * height * 4U);
+
+    for (std::uint32_t y = 0U; y < height; ++y) {
+        const std::uint8_t* sourceRow = static_cast<const std::uint8_t*>(subresource.pData) + y * subresource.RowPitch;
+        std::uint8_t* destinationRow = texels.data() + static_cast<std::size_t>(y) * width * 4U;
+
+        switch (format) {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+            std::memcpy(destinationRow, sourceRow, width * 4U);
+            break;
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8X8_UNORM:
+        case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        {
+            const bool hasAlpha = format == DXGI_FORMAT_B8G8R8A8_UNORM || format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+            for (std::uint32_t x = 0U; x < width; ++x) {
+                destinationRow[x * 4U] = sourceRow[x * 4U + 2U];
+                destinationRow[x * 4U + 1U] = sourceRow[x * 4U + 1U];
+                destinationRow[x * 4U + 2U] = sourceRow[x * 4U];
+                destinationRow[x * 4U + 3U] = hasAlpha ? sourceRow[x * 4U + 3U] : 255U;
+            }
+            break;
+        }
+        case DXGI_FORMAT_R8_UNORM:
+            // Luminance textures are loaded as R8, so the value is replicated to color channels.
+            for (std::uint32_t x = 0U; x < width; ++x) {
+                destinationRow[x * 4U] = sourceRow[x];
+                destinationRow[x * 4U + 1U] = sourceRow[x];
+                destinationRow[x * 4U + 2U] = sourceRow[x];
+                destinationRow[x * 4U + 3U] = 255U;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief Get the DXGI format of a block compressed format
+/// @param format Block compressed format
+/// @param isSRGB True if the source texture is sRGB
+/// @return DXGI format
+///
+DXGI_FORMAT
+GetDXGIFormat(const BlockCompressor::Format format,
+              const bool isSRGB) noexcept
+{
+    switch (format) {
+    case BlockCompressor::Format::BC1:
+        return isSRGB ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+    case BlockCompressor::Format::BC3:
+        return isSRGB ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+    case BlockCompressor::Format::BC4:
+        return DXGI_FORMAT_BC4_UNORM;
+    case BlockCompressor::Format::BC5:
+        return DXGI_FORMAT_BC5_UNORM;
+    case BlockCompressor::Format::BC7:
+        return isSRGB ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+    default:
+        BRE_ASSERT(false);
+        return DXGI_FORMAT_UNKNOWN;
+    }
+}
+
+///
+/// @brief Get the name of a block compressed format
+/// @param format Block compressed format
+/// @return Format name
+///
+const wchar_t*
+GetFormatName(const BlockCompressor::Format format) noexcept
+{
+    switch (format) {
+    case BlockCompressor::Format::BC1:
+        return L"BC1";
+    case BlockCompressor::Format::BC3:
+        return L"BC3";
+    case BlockCompressor::Format::BC4:
+        return L"BC4";
+    case BlockCompressor::Format::BC5:
+        return L"BC5";
+    case BlockCompressor::Format::BC7:
+        return L"BC7";
+    default:
+        BRE_ASSERT(false);
+        return L"";
+    }
+}
+
+///
+/// @brief Writes the DDS headers of a block compressed 2D texture
+/// @param textureDescriptor Source texture descriptor
+/// @param isCubeMap True if the texture is a cube map
+/// @param format DXGI format of the cooked texture
+/// @param mipLevel0Size Size in bytes of the mip level 0
+/// @param ddsData Output DDS data
+///
+void
+WriteDDSHeaders(const D3D12_RESOURCE_DESC& textureDescriptor,
+                const bool isCubeMap,
+                const DXGI_FORMAT format,
+                const std::size_t mipLevel0Size,
+                std::vector<std::uint8_t>& ddsData) noexcept
+{
+    std::uint32_t header[sDDSHeaderWordCount + sDDSDX10HeaderWordCount]{};
+    header[0U] = sDDSMagic;
+    header[1U] = 124U; // DDS_HEADER size
+    header[2U] = 0x1007U | 0x20000U | 0x80000U; // DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP | DDS_HEADER_FLAGS_LINEARSIZE
+    header[3U] = textureDescriptor.Height;
+    header[4U] = static_cast<std::uint32_t>(textureDescriptor.Width);
+    header[5U] = static_cast<std::uint32_t>(mipLevel0Size);
+    header[7U] = textureDescriptor.MipLevels;
+    header[19U] = 32U; // DDS_PIXELFORMAT size
+    header[20U] = 0x4U; // DDS_FOURCC
+    header[sDDSFourCCWord] = sDDSFourCCDX10;
+    header[27U] = 0x1000U | (textureDescriptor.MipLevels > 1U ? 0x400008U : 0U) | (isCubeMap ? 0x8U : 0U);
+    header[sDDSCaps2Word] = isCubeMap ? 0xFE00U : 0U; // DDS_CUBEMAP_ALLFACES
+
+    // DDS_HEADER_DXT10
+    header[32U] = static_cast<std::uint32_t>(format);
+    header[33U] = static_cast<std::uint32_t>(D3D12_RESOURCE_DIMENSION_TEXTURE2D);
+    header[sDDSDX10MiscFlagWord] = isCubeMap ? sDDSResourceMiscTextureCube : 0U;
+    header[35U] = isCubeMap ? textureDescriptor.DepthOrArraySize / 6U : textureDescriptor.DepthOrArraySize;
+
+    ddsData.assign(reinterpret_cast<const std::uint8_t*>(header),
+                   reinterpret_cast<const std::uint8_t*>(header) + sizeof(header));
+}
+}
+
+std::string
+TextureCooker::CookTextureFile(const char* sourceFilename,
+                               const std::uint64_t sourceContentHash,
+                               const Usage usage) noexcept
+{
+    BRE_ASSERT(sourceFilename != nullptr);
+
+    // Cook settings are part of the hash, so changing them cooks the texture again.
+    const std::uint32_t cookSettings[]{
+        sVersion,
+        static_cast<std::uint32_t>(usage),
+        ApplicationSettings::sIsBC7TextureCookingEnabled ? 1U : 0U
+    };
+    const std::uint64_t contentHash = HashUtils::ComputeHash(cookSettings, sizeof(cookSettings), sourceContentHash);
+
+    const std::string cookedFilename = GetCookedFilename(contentHash);
+    if (GetFileAttributesA(cookedFilename.c_str()) != INVALID_FILE_ATTRIBUTES) {
+        return cookedFilename;
+    }
+
+    // If it cannot be opened, the texture loader reports it.
+    MemoryMappedFile sourceFile;
+    if (sourceFile.Open(sourceFilename) == false) {
+        return sourceFilename;
+    }
+
+    std::vector<std::uint8_t> cookedData;
+    CookStatistics statistics;
+    if (CookTexture(sourceFile.GetData(), sourceFile.GetSize(), usage, cookedData, statistics) == false) {
+        return sourceFilename;
+    }
+    sourceFile.Close();
+
+    std::ofstream fileStream{ cookedFilename, std::ios::out | std::ios::binary | std::ios::trunc };
+    if (fileStream.is_open() == false) {
+        return sourceFilename;
+    }
+    fileStream.write(reinterpret_cast<const char*>(cookedData.data()), cookedData.size());
+    if (fileStream.good() == false) {
+        fileStream.close();
+        DeleteFileA(cookedFilename.c_str());
+        return sourceFilename;
+    }
+
+    const std::wstring cookMsg =
+        L"Texture cooked " + StringUtils::AnsiToWideString(sourceFilename) + L": " +
+        GetFormatName(statistics.mFormat) + L", " +
+        std::to_wstring(statistics.mMegapixelsPerSecond) + L" MPix/s, PSNR " +
+        std::to_wstring(statistics.mPsnr) + L" dB\n";
+    BRE_LOG_MSG(cookMsg.c_str());
+
+    return cookedFilename;
+}
+
+bool
+TextureCooker::CookTexture(const std::uint8_t* sourceData,
+                           const std::size_t sourceDataSize,
+                           const Usage usage,
+                           std::vector<std::uint8_t>& cookedData,
+                           CookStatistics& statistics) noexcept
+{
+    BRE_ASSERT(sourceData != nullptr);
+
+    D3D12_RESOURCE_DESC textureDescriptor{};
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+    if (FAILED(DirectX::LoadDDSTextureDataFromMemory12(sourceData,
+                                                       sourceDataSize,
+                                                       textureDescriptor,
+                                                       subresources))) {
+        return false;
+    }
+
+    // Block compressed 2D textures must have a size multiple of the block size.
+    if (textureDescriptor.Dimension != D3D12_RESOURCE_DIMENSION_TEXTURE2D ||
+        textureDescriptor.Width % BlockCompressor::sBlockDimension != 0U ||
+        textureDescriptor.Height % BlockCompressor::sBlockDimension != 0U) {
+        return false;
+    }
+
+    const std::uint32_t mipLevelCount = textureDescriptor.MipLevels;
+    const std::uint32_t width = static_cast<std::uint32_t>(textureDescriptor.Width);
+    const std::uint32_t height = textureDescriptor.Height;
+
+    // Convert all the subresources first, so the format is chosen
+    // with the alpha of the whole texture.
+    std::vector<std::vector<std::uint8_t>> subresourceTexels(subresources.size());
+    bool hasAlpha{ false };
+    for (std::size_t i = 0U; i < subresources.size(); ++i) {
+        const std::uint32_t mipLevel = static_cast<std::uint32_t>(i % mipLevelCount);
+        if (ConvertToRGBA8(subresources[i],
+                           textureDescriptor.Format,
+                           std::max(width >> mipLevel, 1U),
+                           std::max(height >> mipLevel, 1U),
+                           subresourceTexels[i]) == false) {
+            return false;
+        }
+
+        const std::vector<std::uint8_t>& texels = subresourceTexels[i];
+        for (std::size_t j = 3U; j < texels.size() && hasAlpha == false; j += 4U) {
+            hasAlpha = texels[j] != 255U;
+        }
+    }
+
+    const BlockCompressor::Format format = GetFormat(usage, hasAlpha);
+    const bool isSRGB = textureDescriptor.Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ||
+                        textureDescriptor.Format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB ||
+                        textureDescriptor.Format == DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
+
+    const std::size_t headersSize = (sDDSHeaderWordCount + sDDSDX10HeaderWordCount) * sizeof(std::uint32_t);
+    WriteDDSHeaders(textureDescriptor,
+                    IsCubeMap(sourceData),
+                    GetDXGIFormat(format, isSRGB),
+                    BlockCompressor::GetCompressedSizeInBytes(format, width, height),
+                    cookedData);
+
+    // Subresources are stored in the same order: array slices, and mip levels of each slice.
+    std::size_t dataSize{ 0U };
+    for (std::size_t i = 0U; i < subresources.size(); ++i) {
+        const std::uint32_t mipLevel = static_cast<std::uint32_t>(i % mipLevelCount);
+        dataSize += BlockCompressor::GetCompressedSizeInBytes(format,
+                                                             std::max(width >> mipLevel, 1U),
+                                                             std::max(height >> mipLevel, 1U));
+    }
+    cookedData.resize(headersSize + dataSize);
+
+    std::uint64_t texelCount{ 0UL };
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    std::size_t offset = headersSize;
+    for (std::size_t i = 0U; i < subresources.size(); ++i) {
+        const std::uint32_t mipLevel = static_cast<std::uint32_t>(i % mipLevelCount);
+        const std::uint32_t mipLevelWidth = std::max(width >> mipLevel, 1U);
+        const std::uint32_t mipLevelHeight = std::max(height >> mipLevel, 1U);
+        BlockCompressor::CompressImage(format,
+                                       subresourceTexels[i].data(),
+                                       mipLevelWidth,
+                                       mipLevelHeight,
+                                       mipLevelWidth * 4U,
+                                       cookedData.data() + offset);
+        offset += BlockCompressor::GetCompressedSizeInBytes(format, mipLevelWidth, mipLevelHeight);
+        texelCount += static_cast<std::uint64_t>(mipLevelWidth) * mipLevelHeight;
+    }
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+    const double timeInSeconds = std::chrono::duration<double>(endTime - startTime).count();
+
+    std::vector<std::uint8_t> decompressedTexels(static_cast<std::size_t>(width) * height * 4U);
+    BlockCompressor::DecompressImage(format,
+                                     cookedData.data() + headersSize,
+                                     width,
+                                     height,
+                                     decompressedTexels.data());
+
+    statistics.mFormat = format;
+    statistics.mMegapixelsPerSecond = timeInSeconds > 0.0 ? texelCount / timeInSeconds / 1000000.0 : 0.0;
+    statistics.mPsnr = BlockCompressor::ComputePsnr(subresourceTexels[0U].data(),
+                                                    decompressedTexels.data(),
+                                                    static_cast<std::size_t>(width) * height,
+                                                    BlockCompressor::GetChannelCount(format));
+
+    return true;
+}
+
+BlockCompressor::Format
+TextureCooker::GetFormat(const Usage usage,
+                         const bool hasAlpha) noexcept
+{
+    switch (usage) {
+    case Usage::NORMAL:
+        return BlockCompressor::Format::BC5;
+    case Usage::SINGLE_CHANNEL:
+        return BlockCompressor::Format::BC4;
+    case Usage::CHANNEL_PACKED:
+        // Channels are not correlated, so BC1 endpoints would lose most of their precision.
+        return BlockCompressor::Format::BC7;
+    default:
+        if (ApplicationSettings::sIsBC7TextureCookingEnabled) {
+            return BlockCompressor::Format::BC7;
+        }
+
+        return hasAlpha ? BlockCompressor::Format::BC3 : BlockCompressor::Format::BC1;
+    }
+}
+
+std::string
+TextureCooker::GetCookedFilename(const std::uint64_t sourceContentHash) noexcept
+{
+    return HashUtils::GetCachedFilePath(sCacheDirectory, sourceContentHash, sCacheFileExtension);
+}
+}
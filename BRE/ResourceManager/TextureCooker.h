@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ResourceManager\BlockCompressor.h>
+
+namespace BRE {
+///
+/// @brief Responsible to cook uncompressed DDS textures to block compressed DDS textures.
+///
+/// Cooked textures are written to a cache directory, named after the content hash of
+/// the source texture and the chosen format, so they are only cooked once, and a modified
+/// source texture gets a new cooked texture.
+///
+/// Formats are chosen by usage:
+/// - Color: BC1 if the texture is opaque, otherwise BC3. BC7 if it is enabled in ApplicationSettings.
+/// - Normal: BC5
+/// - Single channel (height, metalness, roughness): BC4
+/// - Channel packed (metalness, roughness and height in red, green and blue): BC7
+///
+/// Only 8 bits per channel RGBA, BGRA, BGRX and R formats are cooked.
+///
+class TextureCooker {
+public:
+    TextureCooker() = delete;
+    ~TextureCooker() = delete;
+    TextureCooker(const TextureCooker&) = delete;
+    const TextureCooker& operator=(const TextureCooker&) = delete;
+    TextureCooker(TextureCooker&&) = delete;
+    TextureCooker& operator=(TextureCooker&&) = delete;
+
+    static const std::uint32_t sVersion{ 1U };
+
+    ///
+    /// @brief Texture usages
+    ///
+    enum class Usage {
+        COLOR = 0,
+        NORMAL,
+        SINGLE_CHANNEL,
+        CHANNEL_PACKED,
+    };
+
+    ///
+    /// @brief Cook statistics
+    ///
+    struct CookStatistics {
+        BlockCompressor::Format mFormat{ BlockCompressor::Format::BC1 };
+        double mMegapixelsPerSecond{ 0.0 };
+        double mPsnr{ 0.0 }; // Of mip level 0, in the channels the format stores
+    };
+
+    ///
+    /// @brief Cooks a texture file, if it was not cooked before
+    ///
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param sourceFilename Source DDS texture filename. Must not be nullptr.
+    /// @param sourceContentHash Content hash of the source texture (see MipGenerator::GenerateMipLevelsFile()),
+    /// so it is only read if it was not cooked before.
+    /// @param usage Texture usage
+    /// @return Cooked texture filename, or the source texture filename
+    /// if the texture cannot be cooked.
+    ///
+    static std::string CookTextureFile(const char* sourceFilename,
+                                       const std::uint64_t sourceContentHash,
+                                       const Usage usage) noexcept;
+
+    ///
+    /// @brief Cooks DDS texture data
+    /// @param sourceData Source DDS texture data. Must not be nullptr.
+    /// @param sourceDataSize Source DDS texture data size in bytes
+    /// @param usage Texture usage
+    /// @param cookedData Output block compressed DDS texture data
+    /// @param statistics Output cook statistics
+    /// @return True if the texture was cooked. Otherwise, false.
+    ///
+    static bool CookTexture(const std::uint8_t* sourceData,
+                            const std::size_t sourceDataSize,
+                            const Usage usage,
+                            std::vector<std::uint8_t>& cookedData,
+                            CookStatistics& statistics) noexcept;
+
+    ///
+    /// @brief Get the block compressed format of a texture usage
+    /// @param usage Texture usage
+    /// @param hasAlpha True if the texture is not opaque
+    /// @return Block compressed format
+    ///
+    static BlockCompressor::Format GetFormat(const Usage usage,
+                                             const bool hasAlpha) noexcept;
+
+private:
+    ///
+    /// @brief Get cooked texture filename
+    /// @param sourceContentHash Content hash of the source texture and the cook settings
+    /// @return Cooked texture filename
+    ///
+    static std::string GetCookedFilename(const std::uint64_t sourceContentHash) noexcept;
+};
+}
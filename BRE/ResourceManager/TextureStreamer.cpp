@@ -0,0 +1,634 @@
+#include "TextureStreamer.h"
+
+#include <algorithm>
+#include <string>
+
+#include <ApplicationSettings\ApplicationSettings.h>
+#include <CommandListExecutor\CommandListExecutor.h>
+#include <DirectXManager\DirectXManager.h>
+#include <MemoryTracker\MemoryTracker.h>
+#include <ResourceManager\DDSTextureLoader.h>
+#include <ResourceManager\ResourceManager.h>
+#include <ResourceManager\StagingRingBuffer.h>
+#include <Utils\DebugUtils.h>
+
+using namespace DirectX;
+
+namespace BRE {
+namespace {
+// Greatest dimension of the most detailed mip level that is resident at load time
+const std::uint32_t sResidentMipLevelSize{ 256U };
+
+///
+/// @brief Get the most detailed mip level whose greatest dimension is not greater
+/// than sResidentMipLevelSize
+/// @param textureDescriptor Texture descriptor
+/// @return Mip level
+///
+std::uint32_t
+GetInitialResidentMipLevel(const D3D12_RESOURCE_DESC& textureDescriptor) noexcept
+{
+    const std::uint64_t size = std::max(textureDescriptor.Width,
+                                        static_cast<std::uint64_t>(textureDescriptor.Height));
+    std::uint32_t mipLevel = 0U;
+    while (mipLevel + 1U < textureDescriptor.MipLevels && (size >> mipLevel) > sResidentMipLevelSize) {
+        ++mipLevel;
+    }
+
+    return mipLevel;
+}
+
+///
+/// @brief Clamps a shader resource view to a mip level
+/// @param mipLevel Most detailed mip level the view can access
+/// @param descriptor View descriptor
+///
+void
+ClampShaderResourceView(const std::uint32_t mipLevel,
+                        D3D12_SHADER_RESOURCE_VIEW_DESC& descriptor) noexcept
+{
+    const float minLODClamp = static_cast<float>(mipLevel);
+    switch (descriptor.ViewDimension) {
+    case D3D12_SRV_DIMENSION_TEXTURE2D:
+        descriptor.Texture2D.ResourceMinLODClamp = minLODClamp;
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURE2DARRAY:
+        descriptor.Texture2DArray.ResourceMinLODClamp = minLODClamp;
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURECUBE:
+        descriptor.TextureCube.ResourceMinLODClamp = minLODClamp;
+        break;
+    case D3D12_SRV_DIMENSION_TEXTURECUBEARRAY:
+        descriptor.TextureCubeArray.ResourceMinLODClamp = minLODClamp;
+        break;
+    default:
+        BRE_CHECK_MSG(false, L"Unsupported shader resource view dimension for a streamed texture");
+        break;
+    }
+}
+
+///
+/// @brief Get the projected size of a bounding sphere
+/// @param viewMatrix Camera view matrix
+/// @param projectionMatrix Camera projection matrix
+/// @param worldBoundingSphere Bounding sphere in world space
+/// @return Projected diameter in pixels
+///
+float
+GetProjectedSizeInPixels(const XMFLOAT4X4& viewMatrix,
+                         const XMFLOAT4X4& projectionMatrix,
+                         const BoundingSphere& worldBoundingSphere) noexcept
+{
+    const XMVECTOR viewCenter = XMVector3TransformCoord(XMLoadFloat3(&worldBoundingSphere.Center),
+                                                        XMLoadFloat4x4(&viewMatrix));
+    const float viewZ = XMVectorGetZ(viewCenter);
+    const float radius = worldBoundingSphere.Radius;
+    const float screenSize = static_cast<float>(std::max(ApplicationSettings::sWindowWidth,
+                                                         ApplicationSettings::sWindowHeight));
+
+    // Behind the camera
+    if (viewZ + radius <= 0.0f) {
+        return 0.0f;
+    }
+
+    // The camera is inside the sphere
+    if (viewZ <= radius) {
+        return screenSize;
+    }
+
+    const float projectedSize =
+        radius * projectionMatrix._22 * ApplicationSettings::sWindowHeight / viewZ;
+
+    return std::min(projectedSize, screenSize);
+}
+}
+
+bool TextureStreamer::mIsStreamingSupported{ false };
+D3D12_TILED_RESOURCES_TIER TextureStreamer::mTiledResourcesTier{ D3D12_TILED_RESOURCES_TIER_NOT_SUPPORTED };
+TextureStreamingScheduler TextureStreamer::mScheduler;
+std::vector<std::unique_ptr<TextureStreamer::StreamedTexture>> TextureStreamer::mStreamedTextures;
+std::unordered_map<ID3D12Resource*, std::uint32_t> TextureStreamer::mTextureIdByResource;
+std::vector<TextureStreamer::DrawableObjectTextures> TextureStreamer::mDrawableObjects;
+std::vector<std::uint32_t> TextureStreamer::mFullScreenTextureIds;
+std::vector<TextureStreamer::PendingRequest> TextureStreamer::mPendingRequests;
+std::vector<std::uint32_t> TextureStreamer::mUpdatedTextureIds;
+std::mutex TextureStreamer::mMutex;
+
+void
+TextureStreamer::Init() noexcept
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS options{};
+    BRE_CHECK_HR(DirectXManager::GetDevice().CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS,
+                                                                 &options,
+                                                                 sizeof(options)));
+
+    mTiledResourcesTier = options.TiledResourcesTier;
+    mIsStreamingSupported = ApplicationSettings::sIsTextureStreamingEnabled &&
+        mTiledResourcesTier != D3D12_TILED_RESOURCES_TIER_NOT_SUPPORTED;
+
+    if (mIsStreamingSupported == false) {
+        BRE_LOG_MSG(L"Texture streaming is disabled\n");
+    }
+}
+
+void
+TextureStreamer::Clear() noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for (std::unique_ptr<StreamedTexture>& streamedTexture : mStreamedTextures) {
+        if (streamedTexture.get() != nullptr) {
+            ReleaseHeapsAndResource(*streamedTexture);
+        }
+    }
+
+    mScheduler.Clear();
+    mStreamedTextures.clear();
+    mTextureIdByResource.clear();
+    mDrawableObjects.clear();
+    mFullScreenTextureIds.clear();
+    mPendingRequests.clear();
+    mUpdatedTextureIds.clear();
+}
+
+ResourceManager::SharedResource
+TextureStreamer::LoadTextureFromFile(const char* textureFilename,
+                                     const wchar_t* resourceName) noexcept
+{
+    BRE_ASSERT(textureFilename != nullptr);
+
+    // File is parsed in place, and mip levels are copied from the mapping when they are streamed.
+    std::unique_ptr<StreamedTexture> streamedTexture(new StreamedTexture);
+    const std::wstring errorMsg =
+        L"Failed to open texture file: " + StringUtils::AnsiToWideString(textureFilename);
+    BRE_CHECK_MSG(streamedTexture->mTextureFile.Open(textureFilename), errorMsg.c_str());
+
+    D3D12_RESOURCE_DESC resourceDescriptor{};
+    BRE_CHECK_HR(DirectX::LoadDDSTextureDataFromMemory12(streamedTexture->mTextureFile.GetData(),
+                                                         streamedTexture->mTextureFile.GetSize(),
+                                                         resourceDescriptor,
+                                                         streamedTexture->mSubresources));
+
+    const std::uint32_t residentMipLevel = GetInitialResidentMipLevel(resourceDescriptor);
+
+    // Small textures are not streamed. Tier 1 does not support packed mip levels
+    // of texture arrays, so they are not streamed either.
+    if (mIsStreamingSupported == false ||
+        residentMipLevel == 0U ||
+        resourceDescriptor.Dimension != D3D12_RESOURCE_DIMENSION_TEXTURE2D ||
+        (mTiledResourcesTier == D3D12_TILED_RESOURCES_TIER_1 && resourceDescriptor.DepthOrArraySize > 1U)) {
+        ResourceManager::ResourceHandle resourceHandle;
+        ID3D12Resource& texture = ResourceManager::CreateTexture(resourceDescriptor,
+                                                                 streamedTexture->mSubresources.data(),
+                                                                 static_cast<std::uint32_t>(streamedTexture->mSubresources.size()),
+                                                                 resourceName,
+                                                                 &resourceHandle);
+        return ResourceManager::ShareResource(texture, resourceHandle);
+    }
+
+    streamedTexture->mMipLevelCount = resourceDescriptor.MipLevels;
+    streamedTexture->mArraySize = resourceDescriptor.DepthOrArraySize;
+    const std::uint32_t subresourceCount = streamedTexture->mMipLevelCount * streamedTexture->mArraySize;
+    BRE_ASSERT(streamedTexture->mSubresources.size() == subresourceCount);
+
+    resourceDescriptor.Layout = D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE;
+
+    ID3D12Resource* resource{ nullptr };
+    mMutex.lock();
+    BRE_CHECK_HR(DirectXManager::GetDevice().CreateReservedResource(&resourceDescriptor,
+                                                                    D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+                                                                    nullptr,
+                                                                    IID_PPV_ARGS(&resource)));
+    mMutex.unlock();
+    BRE_ASSERT(resource != nullptr);
+    streamedTexture->mResource = resource;
+
+    if (resourceName != nullptr) {
+        resource->SetName(resourceName);
+    }
+
+    std::uint32_t subresourceTilingCount = subresourceCount;
+    streamedTexture->mSubresourceTilings.resize(subresourceCount);
+    DirectXManager::GetDevice().GetResourceTiling(resource,
+                                                  nullptr,
+                                                  &streamedTexture->mPackedMipInfo,
+                                                  nullptr,
+                                                  &subresourceTilingCount,
+                                                  0U,
+                                                  streamedTexture->mSubresourceTilings.data());
+
+    const std::uint32_t standardMipLevelCount = streamedTexture->mPackedMipInfo.NumStandardMips;
+    streamedTexture->mHeaps.resize(standardMipLevelCount + 1U, nullptr);
+
+    // Packed mip levels are mapped at once, so they must be resident from the beginning.
+    const std::uint32_t initialResidentMipLevel = std::min(residentMipLevel, standardMipLevelCount);
+    mMutex.lock();
+    for (std::uint32_t i = initialResidentMipLevel; i <= standardMipLevelCount; ++i) {
+        if (i < standardMipLevelCount || streamedTexture->mPackedMipInfo.NumPackedMips > 0U) {
+            MapMipLevel(*streamedTexture, i);
+        }
+    }
+    mMutex.unlock();
+
+    std::vector<std::uint64_t> mipLevelSizesInBytes(streamedTexture->mMipLevelCount, 0UL);
+    for (std::uint32_t i = 0U; i < streamedTexture->mArraySize; ++i) {
+        const std::uint32_t firstSubresourceIndex = i * streamedTexture->mMipLevelCount;
+        for (std::uint32_t j = 0U; j < streamedTexture->mMipLevelCount; ++j) {
+            mipLevelSizesInBytes[j] += streamedTexture->mSubresources[firstSubresourceIndex + j].SlicePitch;
+        }
+
+        StagingRingBuffer::UploadTextureSubresources(*resource,
+                                                     firstSubresourceIndex + initialResidentMipLevel,
+                                                     streamedTexture->mSubresources.data() + firstSubresourceIndex + initialResidentMipLevel,
+                                                     streamedTexture->mMipLevelCount - initialResidentMipLevel,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    const std::uint32_t textureId = mScheduler.AddTexture(static_cast<std::uint32_t>(std::max(resourceDescriptor.Width,
+                                                                                               static_cast<std::uint64_t>(resourceDescriptor.Height))),
+                                                          mipLevelSizesInBytes,
+                                                          initialResidentMipLevel);
+    // Identifiers of released textures are reused
+    if (textureId == mStreamedTextures.size()) {
+        mStreamedTextures.push_back(std::move(streamedTexture));
+    } else {
+        BRE_ASSERT(mStreamedTextures[textureId].get() == nullptr);
+        mStreamedTextures[textureId] = std::move(streamedTexture);
+    }
+    mTextureIdByResource[resource] = textureId;
+
+    return ResourceManager::GetDeferredReleaseQueue().MakeShared(*resource,
+                                                                 [resource]() {
+        ReleaseTexture(*resource);
+    });
+}
+
+bool
+TextureStreamer::RegisterShaderResourceView(ID3D12Resource& resource,
+                                            const D3D12_SHADER_RESOURCE_VIEW_DESC& descriptor,
+                                            const D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle) noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::uint32_t textureId;
+    if (GetTextureId(resource, textureId) == false) {
+        return false;
+    }
+
+    StreamedTexture& streamedTexture = *mStreamedTextures[textureId];
+    streamedTexture.mShaderResourceViews.emplace_back(cpuDescriptorHandle, descriptor);
+
+    // The descriptor is brand new, so no command list can be reading it
+    D3D12_SHADER_RESOURCE_VIEW_DESC clampedDescriptor = descriptor;
+    ClampShaderResourceView(mScheduler.GetResidentMipLevel(textureId), clampedDescriptor);
+    DirectXManager::GetDevice().CreateShaderResourceView(&resource,
+                                                         &clampedDescriptor,
+                                                         cpuDescriptorHandle);
+
+    return true;
+}
+
+void
+TextureStreamer::RemoveShaderResourceViews(const D3D12_CPU_DESCRIPTOR_HANDLE firstReleasedCpuDescriptorHandle,
+                                           const std::uint32_t releasedDescriptorCount) noexcept
+{
+    const std::size_t endReleasedCpuDescriptorHandlePtr = firstReleasedCpuDescriptorHandle.ptr +
+        releasedDescriptorCount * DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for (std::unique_ptr<StreamedTexture>& streamedTexture : mStreamedTextures) {
+        if (streamedTexture.get() == nullptr) {
+            continue;
+        }
+
+        std::vector<std::pair<D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_SHADER_RESOURCE_VIEW_DESC>>& views =
+            streamedTexture->mShaderResourceViews;
+        std::size_t keptViewCount = 0UL;
+        for (std::size_t i = 0UL; i < views.size(); ++i) {
+            if (views[i].first.ptr < firstReleasedCpuDescriptorHandle.ptr ||
+                views[i].first.ptr >= endReleasedCpuDescriptorHandlePtr) {
+                views[keptViewCount++] = views[i];
+            }
+        }
+        views.resize(keptViewCount);
+    }
+}
+
+void
+TextureStreamer::AddDrawableObject(const std::uint32_t userId,
+                                   const BoundingSphere& worldBoundingSphere,
+                                   const float textureScale,
+                                   ID3D12Resource* const* textures,
+                                   const std::uint32_t textureCount) noexcept
+{
+    BRE_ASSERT(textures != nullptr);
+    BRE_ASSERT(textureScale > 0.0f);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    DrawableObjectTextures drawableObject;
+    drawableObject.mWorldBoundingSphere = worldBoundingSphere;
+    drawableObject.mTextureScale = textureScale;
+    drawableObject.mUserId = userId;
+
+    std::uint32_t textureId;
+    for (std::uint32_t i = 0U; i < textureCount; ++i) {
+        BRE_ASSERT(textures[i] != nullptr);
+        if (GetTextureId(*textures[i], textureId)) {
+            drawableObject.mTextureIds.push_back(textureId);
+        }
+    }
+
+    if (drawableObject.mTextureIds.empty() == false) {
+        mDrawableObjects.push_back(drawableObject);
+    }
+}
+
+void
+TextureStreamer::AddFullScreenTexture(ID3D12Resource& texture) noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::uint32_t textureId;
+    if (GetTextureId(texture, textureId)) {
+        mFullScreenTextureIds.push_back(textureId);
+    }
+}
+
+void
+TextureStreamer::RemoveDrawableObjects(const std::uint32_t userId) noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mDrawableObjects.erase(std::remove_if(mDrawableObjects.begin(),
+                                          mDrawableObjects.end(),
+                                          [userId](const DrawableObjectTextures& drawableObject) {
+        return drawableObject.mUserId == userId;
+    }),
+                           mDrawableObjects.end());
+}
+
+void
+TextureStreamer::RemoveTextureUsers() noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mDrawableObjects.clear();
+    mFullScreenTextureIds.clear();
+}
+
+void
+TextureStreamer::Update(const XMFLOAT4X4& viewMatrix,
+                        const XMFLOAT4X4& projectionMatrix) noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mStreamedTextures.empty()) {
+        return;
+    }
+
+    // Complete finished uploads. Views are clamped to the new mip level
+    // once the GPU has finished the copy (see GetUpdatedShaderResourceViews()).
+    std::size_t pendingRequestCount = 0UL;
+    for (const PendingRequest& pendingRequest : mPendingRequests) {
+        if (StagingRingBuffer::IsUploadCompleted(pendingRequest.mUploadFenceValue) == false) {
+            mPendingRequests[pendingRequestCount++] = pendingRequest;
+            continue;
+        }
+
+        const std::uint32_t textureId = pendingRequest.mRequest.mTextureId;
+        mScheduler.OnRequestCompleted(pendingRequest.mRequest);
+        if (std::find(mUpdatedTextureIds.begin(), mUpdatedTextureIds.end(), textureId) == mUpdatedTextureIds.end()) {
+            mUpdatedTextureIds.push_back(textureId);
+        }
+
+        if (mScheduler.GetResidentMipLevel(textureId) == 0U) {
+            StreamedTexture& streamedTexture = *mStreamedTextures[textureId];
+            streamedTexture.mTextureFile.Close();
+            streamedTexture.mSubresources.clear();
+            streamedTexture.mSubresources.shrink_to_fit();
+        }
+    }
+    mPendingRequests.resize(pendingRequestCount);
+
+    // Update priorities
+    mScheduler.ResetPriorities();
+    for (const DrawableObjectTextures& drawableObject : mDrawableObjects) {
+        const float projectedSize = GetProjectedSizeInPixels(viewMatrix,
+                                                             projectionMatrix,
+                                                             drawableObject.mWorldBoundingSphere);
+
+        // Texture is repeated texture scale times along the drawable object
+        const float projectedTextureSize = projectedSize / drawableObject.mTextureScale;
+        for (const std::uint32_t textureId : drawableObject.mTextureIds) {
+            mScheduler.UpdatePriority(textureId, projectedTextureSize);
+        }
+    }
+
+    const float screenSize = static_cast<float>(std::max(ApplicationSettings::sWindowWidth,
+                                                         ApplicationSettings::sWindowHeight));
+    for (const std::uint32_t textureId : mFullScreenTextureIds) {
+        mScheduler.UpdatePriority(textureId, screenSize);
+    }
+
+    // Schedule and record the uploads of the new mip levels
+    std::vector<TextureStreamingScheduler::MipLevelRequest> requests;
+    mScheduler.ScheduleRequests(ApplicationSettings::sTextureStreamingBytesPerFrame, requests);
+    if (requests.empty()) {
+        return;
+    }
+
+    for (const TextureStreamingScheduler::MipLevelRequest& request : requests) {
+        StreamedTexture& streamedTexture = *mStreamedTextures[request.mTextureId];
+        BRE_ASSERT(request.mMipLevel < streamedTexture.mPackedMipInfo.NumStandardMips);
+        BRE_ASSERT(streamedTexture.mSubresources.empty() == false);
+
+        MapMipLevel(streamedTexture, request.mMipLevel);
+
+        for (std::uint32_t i = 0U; i < streamedTexture.mArraySize; ++i) {
+            const std::uint32_t subresourceIndex = request.mMipLevel + i * streamedTexture.mMipLevelCount;
+            StagingRingBuffer::UploadTextureSubresources(*streamedTexture.mResource,
+                                                         subresourceIndex,
+                                                         &streamedTexture.mSubresources[subresourceIndex],
+                                                         1U,
+                                                         D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+                                                         D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        }
+    }
+
+    const std::uint64_t uploadFenceValue = StagingRingBuffer::SubmitPendingUploads();
+    for (const TextureStreamingScheduler::MipLevelRequest& request : requests) {
+        PendingRequest pendingRequest;
+        pendingRequest.mRequest = request;
+        pendingRequest.mUploadFenceValue = uploadFenceValue;
+        mPendingRequests.push_back(pendingRequest);
+    }
+}
+
+void
+TextureStreamer::GetUpdatedShaderResourceViews(std::vector<ShaderResourceView>& views) noexcept
+{
+    views.clear();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for (const std::uint32_t textureId : mUpdatedTextureIds) {
+        BRE_ASSERT(textureId < mStreamedTextures.size());
+        const StreamedTexture& streamedTexture = *mStreamedTextures[textureId];
+        const std::uint32_t residentMipLevel = mScheduler.GetResidentMipLevel(textureId);
+        for (const std::pair<D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_SHADER_RESOURCE_VIEW_DESC>& registeredView : streamedTexture.mShaderResourceViews) {
+            ShaderResourceView view;
+            view.mResource = streamedTexture.mResource;
+            view.mDescriptor = registeredView.second;
+            view.mCpuDescriptorHandle = registeredView.first;
+            ClampShaderResourceView(residentMipLevel, view.mDescriptor);
+            views.push_back(view);
+        }
+    }
+
+    mUpdatedTextureIds.clear();
+}
+
+void
+TextureStreamer::MapMipLevel(StreamedTexture& streamedTexture,
+                             const std::uint32_t mipLevel) noexcept
+{
+    const std::uint32_t standardMipLevelCount = streamedTexture.mPackedMipInfo.NumStandardMips;
+    BRE_ASSERT(mipLevel <= standardMipLevelCount);
+    BRE_ASSERT(streamedTexture.mHeaps[mipLevel] == nullptr);
+
+    // A region per array slice, placed one after another in the heap
+    std::vector<D3D12_TILED_RESOURCE_COORDINATE> regionCoordinates(streamedTexture.mArraySize);
+    std::vector<D3D12_TILE_REGION_SIZE> regionSizes(streamedTexture.mArraySize);
+    std::vector<std::uint32_t> heapRangeStartOffsets(streamedTexture.mArraySize);
+    std::vector<std::uint32_t> rangeTileCounts(streamedTexture.mArraySize);
+
+    std::uint32_t tileCount = 0U;
+    for (std::uint32_t i = 0U; i < streamedTexture.mArraySize; ++i) {
+        const std::uint32_t subresourceIndex = mipLevel + i * streamedTexture.mMipLevelCount;
+
+        D3D12_TILED_RESOURCE_COORDINATE& regionCoordinate = regionCoordinates[i];
+        regionCoordinate.X = 0U;
+        regionCoordinate.Y = 0U;
+        regionCoordinate.Z = 0U;
+        regionCoordinate.Subresource = subresourceIndex;
+
+        D3D12_TILE_REGION_SIZE& regionSize = regionSizes[i];
+        regionSize.UseBox = FALSE;
+        if (mipLevel < standardMipLevelCount) {
+            const D3D12_SUBRESOURCE_TILING& subresourceTiling = streamedTexture.mSubresourceTilings[subresourceIndex];
+            regionSize.NumTiles = subresourceTiling.WidthInTiles *
+                subresourceTiling.HeightInTiles *
+                subresourceTiling.DepthInTiles;
+        } else {
+            regionSize.NumTiles = streamedTexture.mPackedMipInfo.NumTilesForPackedMips;
+        }
+
+        heapRangeStartOffsets[i] = tileCount;
+        rangeTileCounts[i] = regionSize.NumTiles;
+        tileCount += regionSize.NumTiles;
+    }
+
+    D3D12_HEAP_DESC heapDescriptor{};
+    heapDescriptor.SizeInBytes = static_cast<std::uint64_t>(tileCount) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    heapDescriptor.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+    heapDescriptor.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapDescriptor.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    heapDescriptor.Properties.CreationNodeMask = 1U;
+    heapDescriptor.Properties.VisibleNodeMask = 1U;
+    heapDescriptor.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    heapDescriptor.Flags = D3D12_HEAP_FLAG_DENY_BUFFERS | D3D12_HEAP_FLAG_DENY_RT_DS_TEXTURES;
+
+    ID3D12Heap* heap{ nullptr };
+    BRE_CHECK_HR(DirectXManager::GetDevice().CreateHeap(&heapDescriptor, IID_PPV_ARGS(&heap)));
+    BRE_ASSERT(heap != nullptr);
+    streamedTexture.mHeaps[mipLevel] = heap;
+    MemoryTracker::RegisterAllocation(MemoryTracker::Category::TEXTURES,
+                                      heapDescriptor.SizeInBytes);
+
+    // Tile mappings are updated in the same queue where the uploads are executed.
+    CommandListExecutor::Get().GetCommandQueue().UpdateTileMappings(streamedTexture.mResource,
+                                                                    streamedTexture.mArraySize,
+                                                                    regionCoordinates.data(),
+                                                                    regionSizes.data(),
+                                                                    heap,
+                                                                    streamedTexture.mArraySize,
+                                                                    nullptr,
+                                                                    heapRangeStartOffsets.data(),
+                                                                    rangeTileCounts.data(),
+                                                                    D3D12_TILE_MAPPING_FLAG_NONE);
+}
+
+void
+TextureStreamer::ReleaseTexture(ID3D12Resource& texture) noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::uint32_t textureId;
+    BRE_CHECK_MSG(GetTextureId(texture, textureId), L"Texture is not streamed");
+
+    // Mip levels could be scheduled after the frame that released the texture,
+    // so its uploads in flight are completed first.
+    const std::size_t pendingRequestCount = mPendingRequests.size();
+    mPendingRequests.erase(std::remove_if(mPendingRequests.begin(),
+                                          mPendingRequests.end(),
+                                          [textureId](const PendingRequest& pendingRequest) {
+        return pendingRequest.mRequest.mTextureId == textureId;
+    }),
+                           mPendingRequests.end());
+    if (mPendingRequests.size() != pendingRequestCount) {
+        StagingRingBuffer::Flush();
+    }
+
+    mUpdatedTextureIds.erase(std::remove(mUpdatedTextureIds.begin(), mUpdatedTextureIds.end(), textureId),
+                             mUpdatedTextureIds.end());
+    mFullScreenTextureIds.erase(std::remove(mFullScreenTextureIds.begin(), mFullScreenTextureIds.end(), textureId),
+                                mFullScreenTextureIds.end());
+    for (DrawableObjectTextures& drawableObject : mDrawableObjects) {
+        drawableObject.mTextureIds.erase(std::remove(drawableObject.mTextureIds.begin(),
+                                                     drawableObject.mTextureIds.end(),
+                                                     textureId),
+                                         drawableObject.mTextureIds.end());
+    }
+
+    BRE_ASSERT(mStreamedTextures[textureId].get() != nullptr);
+    ReleaseHeapsAndResource(*mStreamedTextures[textureId]);
+    mStreamedTextures[textureId].reset();
+    mTextureIdByResource.erase(&texture);
+    mScheduler.RemoveTexture(textureId);
+}
+
+void
+TextureStreamer::ReleaseHeapsAndResource(StreamedTexture& streamedTexture) noexcept
+{
+    for (ID3D12Heap* heap : streamedTexture.mHeaps) {
+        if (heap != nullptr) {
+            MemoryTracker::RegisterDeallocation(MemoryTracker::Category::TEXTURES,
+                                                heap->GetDesc().SizeInBytes);
+            heap->Release();
+        }
+    }
+    streamedTexture.mHeaps.clear();
+
+    BRE_ASSERT(streamedTexture.mResource != nullptr);
+    streamedTexture.mResource->Release();
+    streamedTexture.mResource = nullptr;
+}
+
+bool
+TextureStreamer::GetTextureId(ID3D12Resource& resource,
+                              std::uint32_t& textureId) noexcept
+{
+    std::unordered_map<ID3D12Resource*, std::uint32_t>::const_iterator findIt = mTextureIdByResource.find(&resource);
+    if (findIt == mTextureIdByResource.end()) {
+        return false;
+    }
+
+    textureId = findIt->second;
+
+    return true;
+}
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <cstdint>
+#include <d3d12.h>
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <ResourceManager\ResourceManager.h>
+#include <ResourceManager\TextureStreamingScheduler.h>
+#include <Utils\MemoryMappedFile.h>
+
+namespace BRE {
+///
+/// @brief Responsible to stream texture mip levels in the background.
+///
+/// Textures are created as reserved resources where only the coarse mip levels are
+/// mapped and uploaded at load time. Shader resource views are clamped to the
+/// resident mip levels. Every frame, more detailed mip levels are mapped and uploaded
+/// within a byte budget, prioritized by the projected screen size of the drawable
+/// objects that use each texture. Once the upload is completed, the views are
+/// clamped to the new resident mip level. Queued frames could be reading the views,
+/// so they are not written in place: CbvSrvUavDescriptorManager writes them to new descriptors
+/// (see CbvSrvUavDescriptorManager::UpdateStreamedShaderResourceViews()).
+///
+/// If tiled resources are not supported, or streaming is disabled in ApplicationSettings,
+/// textures are created through ResourceManager with all their mip levels.
+///
+/// Textures are reference counted. When the last copy of a texture is destroyed, it is released
+/// (with its heaps, if it is streamed) once the GPU finished the frames that could use it.
+///
+/// Steps:
+/// - Call TextureStreamer::Init() once, after StagingRingBuffer::Init().
+/// - Call LoadTextureFromFile() to load textures.
+/// - Call AddDrawableObject() and AddFullScreenTexture() to register texture users.
+/// - Call Update() once per frame, and then CbvSrvUavDescriptorManager::UpdateStreamedShaderResourceViews().
+/// - Call TextureStreamer::Clear() at shutdown, after StagingRingBuffer::Clear().
+///
+class TextureStreamer {
+public:
+    ///
+    /// @brief Shader resource view of a streamed texture
+    ///
+    struct ShaderResourceView {
+        ID3D12Resource* mResource{ nullptr };
+
+        // Clamped to the resident mip levels
+        D3D12_SHADER_RESOURCE_VIEW_DESC mDescriptor{};
+
+        // Descriptor the view was registered with
+        D3D12_CPU_DESCRIPTOR_HANDLE mCpuDescriptorHandle{ 0UL };
+    };
+
+    TextureStreamer() = delete;
+    ~TextureStreamer() = delete;
+    TextureStreamer(const TextureStreamer&) = delete;
+    const TextureStreamer& operator=(const TextureStreamer&) = delete;
+    TextureStreamer(TextureStreamer&&) = delete;
+    TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+    ///
+    /// @brief Initializes the texture streamer
+    ///
+    static void Init() noexcept;
+
+    ///
+    /// @brief Releases all the streamed textures and their heaps.
+    ///
+    /// Pending uploads must be completed.
+    ///
+    static void Clear() noexcept;
+
+    ///
+    /// @brief Loads texture from file
+    ///
+    /// Texture content is uploaded through StagingRingBuffer.
+    /// StagingRingBuffer::Flush() must be called before the texture is used.
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param textureFilename Texture filename. Must be not nullptr
+    /// @param resourceName Resource name. If it is nullptr, then it will have the default name.
+    /// @return Reference counted texture
+    ///
+    static ResourceManager::SharedResource LoadTextureFromFile(const char* textureFilename,
+                                                               const wchar_t* resourceName) noexcept;
+
+    ///
+    /// @brief Registers a shader resource view, and writes it clamped to the resident mip levels.
+    ///
+    /// It does nothing if the resource is not streamed. The view is written in place, so the descriptor
+    /// must be brand new: no command list can be using it. Later changes are written to new descriptors
+    /// (see GetUpdatedShaderResourceViews()).
+    ///
+    /// @param resource Resource of the view
+    /// @param descriptor View descriptor
+    /// @param cpuDescriptorHandle CPU descriptor handle of the view
+    /// @return True if the resource is streamed. Otherwise, false.
+    ///
+    static bool RegisterShaderResourceView(ID3D12Resource& resource,
+                                           const D3D12_SHADER_RESOURCE_VIEW_DESC& descriptor,
+                                           const D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle) noexcept;
+
+    ///
+    /// @brief Unregisters the shader resource views whose descriptors were released
+    /// (see CbvSrvUavDescriptorManager::ReleaseDescriptors()), so they are not written anymore.
+    /// @param firstReleasedCpuDescriptorHandle CPU descriptor handle of the first released descriptor
+    /// @param releasedDescriptorCount Number of contiguous released descriptors
+    ///
+    static void RemoveShaderResourceViews(const D3D12_CPU_DESCRIPTOR_HANDLE firstReleasedCpuDescriptorHandle,
+                                          const std::uint32_t releasedDescriptorCount) noexcept;
+
+    ///
+    /// @brief Registers a drawable object, so the textures it uses are prioritized
+    /// by its projected screen size.
+    /// @param userId Identifier of the user that registers the drawable object, to unregister
+    /// its drawable objects together (see RemoveDrawableObjects())
+    /// @param worldBoundingSphere Bounding sphere in world space
+    /// @param textureScale Texture coordinates scale of the drawable object
+    /// @param textures Textures of the drawable object. Must not be nullptr.
+    /// Textures that are not streamed are ignored.
+    /// @param textureCount Number of textures
+    ///
+    static void AddDrawableObject(const std::uint32_t userId,
+                                  const DirectX::BoundingSphere& worldBoundingSphere,
+                                  const float textureScale,
+                                  ID3D12Resource* const* textures,
+                                  const std::uint32_t textureCount) noexcept;
+
+    ///
+    /// @brief Registers a texture that covers the whole screen, like environment cube maps.
+    /// It is ignored if it is not streamed.
+    /// @param texture Texture
+    ///
+    static void AddFullScreenTexture(ID3D12Resource& texture) noexcept;
+
+    ///
+    /// @brief Unregisters the drawable objects of a user
+    /// @param userId User identifier (see AddDrawableObject())
+    ///
+    static void RemoveDrawableObjects(const std::uint32_t userId) noexcept;
+
+    ///
+    /// @brief Unregisters every drawable object and full screen texture, so the users
+    /// of a reloaded scene can be registered. Streamed textures and their resident
+    /// mip levels are kept.
+    ///
+    static void RemoveTextureUsers() noexcept;
+
+    ///
+    /// @brief Completes finished uploads, and schedules new ones within the budget
+    /// @param viewMatrix Camera view matrix
+    /// @param projectionMatrix Camera projection matrix
+    ///
+    static void Update(const DirectX::XMFLOAT4X4& viewMatrix,
+                       const DirectX::XMFLOAT4X4& projectionMatrix) noexcept;
+
+    ///
+    /// @brief Get the registered shader resource views whose resident mip levels changed
+    /// since the last call, clamped to their new resident mip levels
+    /// @param views Output shader resource views
+    ///
+    static void GetUpdatedShaderResourceViews(std::vector<ShaderResourceView>& views) noexcept;
+
+private:
+    ///
+    /// @brief Reserved texture and the data needed to upload its mip levels
+    ///
+    struct StreamedTexture {
+        ID3D12Resource* mResource{ nullptr };
+        std::uint32_t mMipLevelCount{ 0U };
+        std::uint32_t mArraySize{ 0U };
+
+        // Subresources point into the mapped file, that is closed once
+        // the mip level 0 is resident.
+        MemoryMappedFile mTextureFile;
+        std::vector<D3D12_SUBRESOURCE_DATA> mSubresources;
+
+        D3D12_PACKED_MIP_INFO mPackedMipInfo{};
+        std::vector<D3D12_SUBRESOURCE_TILING> mSubresourceTilings;
+
+        // One heap per standard mip level (for all array slices), and
+        // the last one for the packed mip levels.
+        std::vector<ID3D12Heap*> mHeaps;
+
+        std::vector<std::pair<D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_SHADER_RESOURCE_VIEW_DESC>> mShaderResourceViews;
+    };
+
+    ///
+    /// @brief Drawable object and the streamed textures it uses
+    ///
+    struct DrawableObjectTextures {
+        DirectX::BoundingSphere mWorldBoundingSphere;
+        float mTextureScale{ 1.0f };
+        std::uint32_t mUserId{ 0U };
+        std::vector<std::uint32_t> mTextureIds;
+    };
+
+    ///
+    /// @brief Scheduled request and the fence value to check its completion
+    ///
+    struct PendingRequest {
+        TextureStreamingScheduler::MipLevelRequest mRequest;
+        std::uint64_t mUploadFenceValue{ 0UL };
+    };
+
+    ///
+    /// @brief Maps tiles of a mip level (or the packed mip levels) of all
+    /// the array slices to a new heap
+    /// @param streamedTexture Streamed texture
+    /// @param mipLevel Standard mip level, or the number of standard mip levels
+    /// for the packed mip levels.
+    ///
+    static void MapMipLevel(StreamedTexture& streamedTexture,
+                            const std::uint32_t mipLevel) noexcept;
+
+    ///
+    /// @brief Releases a streamed texture, once the last copy of its reference counted handle
+    /// is destroyed and the GPU finished the frames that could use it.
+    ///
+    /// Its uploads in flight are completed first, and it is not prioritized anymore.
+    ///
+    /// @param texture Streamed texture
+    ///
+    static void ReleaseTexture(ID3D12Resource& texture) noexcept;
+
+    ///
+    /// @brief Releases the heaps and the resource of a streamed texture
+    /// @param streamedTexture Streamed texture
+    ///
+    static void ReleaseHeapsAndResource(StreamedTexture& streamedTexture) noexcept;
+
+    ///
+    /// @brief Get texture identifier
+    /// @param resource Resource
+    /// @param textureId Output texture identifier
+    /// @return True if the resource is streamed. Otherwise, false.
+    ///
+    static bool GetTextureId(ID3D12Resource& resource,
+                             std::uint32_t& textureId) noexcept;
+
+    static bool mIsStreamingSupported;
+    static D3D12_TILED_RESOURCES_TIER mTiledResourcesTier;
+
+    static TextureStreamingScheduler mScheduler;
+
+    // By texture identifier. It is nullptr if the texture was released.
+    static std::vector<std::unique_ptr<StreamedTexture>> mStreamedTextures;
+    static std::unordered_map<ID3D12Resource*, std::uint32_t> mTextureIdByResource;
+    static std::vector<DrawableObjectTextures> mDrawableObjects;
+    static std::vector<std::uint32_t> mFullScreenTextureIds;
+    static std::vector<PendingRequest> mPendingRequests;
+
+    // Textures whose resident mip level changed, to write their views again
+    static std::vector<std::uint32_t> mUpdatedTextureIds;
+
+    static std::mutex mMutex;
+};
+}
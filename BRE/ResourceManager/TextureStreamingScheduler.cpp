@@ -0,0 +1,189 @@
+#include "TextureStreamingScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+namespace {
+///
+/// @brief Candidate to be scheduled
+///
+struct Candidate {
+    std::uint32_t mTextureId{ 0U };
+    float mPriority{ 0.0f };
+};
+}
+
+std::uint32_t
+TextureStreamingScheduler::AddTexture(const std::uint32_t size,
+                                      const std::vector<std::uint64_t>& mipLevelSizesInBytes,
+                                      const std::uint32_t residentMipLevel) noexcept
+{
+    BRE_ASSERT(size > 0U);
+    BRE_ASSERT(mipLevelSizesInBytes.empty() == false);
+    BRE_ASSERT(residentMipLevel < mipLevelSizesInBytes.size());
+
+    TextureState textureState;
+    textureState.mSize = size;
+    textureState.mMipLevelSizesInBytes = mipLevelSizesInBytes;
+    textureState.mResidentMipLevel = residentMipLevel;
+
+    if (mFreeTextureIds.empty() == false) {
+        const std::uint32_t textureId = mFreeTextureIds.back();
+        mFreeTextureIds.pop_back();
+        mTextures[textureId] = textureState;
+
+        return textureId;
+    }
+
+    mTextures.push_back(textureState);
+
+    return static_cast<std::uint32_t>(mTextures.size() - 1U);
+}
+
+void
+TextureStreamingScheduler::RemoveTexture(const std::uint32_t textureId) noexcept
+{
+    BRE_ASSERT(textureId < mTextures.size());
+    BRE_ASSERT(mTextures[textureId].mMipLevelSizesInBytes.empty() == false);
+
+    mTextures[textureId] = TextureState();
+    mFreeTextureIds.push_back(textureId);
+}
+
+void
+TextureStreamingScheduler::Clear() noexcept
+{
+    mTextures.clear();
+    mFreeTextureIds.clear();
+}
+
+void
+TextureStreamingScheduler::ResetPriorities() noexcept
+{
+    for (TextureState& textureState : mTextures) {
+        textureState.mProjectedSizeInPixels = 0.0f;
+    }
+}
+
+void
+TextureStreamingScheduler::UpdatePriority(const std::uint32_t textureId,
+                                          const float projectedSizeInPixels) noexcept
+{
+    BRE_ASSERT(textureId < mTextures.size());
+
+    TextureState& textureState = mTextures[textureId];
+    textureState.mProjectedSizeInPixels = std::max(textureState.mProjectedSizeInPixels,
+                                                   projectedSizeInPixels);
+}
+
+void
+TextureStreamingScheduler::ScheduleRequests(const std::uint64_t byteBudget,
+                                            std::vector<MipLevelRequest>& requests) noexcept
+{
+    requests.clear();
+
+    // The priority is the number of pixels each texel of the resident mip level covers,
+    // so the most blurry textures go first.
+    std::vector<Candidate> candidates;
+    const std::uint32_t textureCount = static_cast<std::uint32_t>(mTextures.size());
+    for (std::uint32_t i = 0U; i < textureCount; ++i) {
+        const TextureState& textureState = mTextures[i];
+        if (textureState.mMipLevelSizesInBytes.empty() ||
+            textureState.mIsRequestInFlight ||
+            textureState.mResidentMipLevel <= GetRequiredMipLevel(i)) {
+            continue;
+        }
+
+        const std::uint32_t residentMipLevelSize = std::max(textureState.mSize >> textureState.mResidentMipLevel, 1U);
+
+        Candidate candidate;
+        candidate.mTextureId = i;
+        candidate.mPriority = textureState.mProjectedSizeInPixels / residentMipLevelSize;
+        candidates.push_back(candidate);
+    }
+
+    // Stable sort, so textures with the same priority keep the order they were added.
+    std::stable_sort(candidates.begin(),
+                     candidates.end(),
+                     [](const Candidate& a, const Candidate& b) {
+        return a.mPriority > b.mPriority;
+    });
+
+    std::uint64_t scheduledSizeInBytes{ 0UL };
+    for (const Candidate& candidate : candidates) {
+        TextureState& textureState = mTextures[candidate.mTextureId];
+
+        MipLevelRequest request;
+        request.mTextureId = candidate.mTextureId;
+        request.mMipLevel = textureState.mResidentMipLevel - 1U;
+        request.mSizeInBytes = textureState.mMipLevelSizesInBytes[request.mMipLevel];
+
+        if (scheduledSizeInBytes + request.mSizeInBytes > byteBudget && requests.empty() == false) {
+            continue;
+        }
+
+        textureState.mIsRequestInFlight = true;
+        scheduledSizeInBytes += request.mSizeInBytes;
+        requests.push_back(request);
+
+        if (scheduledSizeInBytes >= byteBudget) {
+            break;
+        }
+    }
+}
+
+void
+TextureStreamingScheduler::OnRequestCompleted(const MipLevelRequest& request) noexcept
+{
+    BRE_ASSERT(request.mTextureId < mTextures.size());
+
+    TextureState& textureState = mTextures[request.mTextureId];
+    BRE_ASSERT(textureState.mIsRequestInFlight);
+    BRE_ASSERT(request.mMipLevel + 1U == textureState.mResidentMipLevel);
+
+    textureState.mResidentMipLevel = request.mMipLevel;
+    textureState.mIsRequestInFlight = false;
+}
+
+std::uint32_t
+TextureStreamingScheduler::GetResidentMipLevel(const std::uint32_t textureId) const noexcept
+{
+    BRE_ASSERT(textureId < mTextures.size());
+    return mTextures[textureId].mResidentMipLevel;
+}
+
+std::uint32_t
+TextureStreamingScheduler::GetRequiredMipLevel(const std::uint32_t textureId) const noexcept
+{
+    BRE_ASSERT(textureId < mTextures.size());
+
+    const TextureState& textureState = mTextures[textureId];
+    return ComputeRequiredMipLevel(textureState.mSize,
+                                   static_cast<std::uint32_t>(textureState.mMipLevelSizesInBytes.size()),
+                                   textureState.mProjectedSizeInPixels);
+}
+
+std::uint32_t
+TextureStreamingScheduler::ComputeRequiredMipLevel(const std::uint32_t size,
+                                                   const std::uint32_t mipLevelCount,
+                                                   const float projectedSizeInPixels) noexcept
+{
+    BRE_ASSERT(mipLevelCount > 0U);
+
+    if (projectedSizeInPixels <= 0.0f) {
+        return mipLevelCount - 1U;
+    }
+
+    const float texelsPerPixel = size / projectedSizeInPixels;
+    if (texelsPerPixel <= 1.0f) {
+        return 0U;
+    }
+
+    const std::uint32_t mipLevel = static_cast<std::uint32_t>(std::floor(std::log2(texelsPerPixel)));
+
+    return std::min(mipLevel, mipLevelCount - 1U);
+}
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace BRE {
+///
+/// @brief Decides which texture mip levels must be streamed in, and in which order.
+///
+/// It does not know anything about the GPU, so it can be driven with synthetic requests.
+///
+/// Each frame:
+/// - Call ResetPriorities()
+/// - Call UpdatePriority() with the projected screen size of each drawable that uses a texture.
+/// - Call ScheduleRequests() to get the mip levels to upload within the frame byte budget.
+/// - Call OnRequestCompleted() once a requested mip level is resident.
+///
+/// Mip levels are streamed one at a time, from coarse to fine, so the resident
+/// mip levels of a texture are always contiguous.
+///
+class TextureStreamingScheduler {
+public:
+    ///
+    /// @brief Request to upload a mip level of a texture
+    ///
+    struct MipLevelRequest {
+        std::uint32_t mTextureId{ 0U };
+        std::uint32_t mMipLevel{ 0U };
+        std::uint64_t mSizeInBytes{ 0UL };
+    };
+
+    TextureStreamingScheduler() = default;
+    ~TextureStreamingScheduler() = default;
+    TextureStreamingScheduler(const TextureStreamingScheduler&) = delete;
+    const TextureStreamingScheduler& operator=(const TextureStreamingScheduler&) = delete;
+    TextureStreamingScheduler(TextureStreamingScheduler&&) = delete;
+    TextureStreamingScheduler& operator=(TextureStreamingScheduler&&) = delete;
+
+    ///
+    /// @brief Adds a texture
+    /// @param size Size in texels of the greatest dimension of the mip level 0. Must be greater than zero.
+    /// @param mipLevelSizesInBytes Size in bytes of each mip level. It must not be empty.
+    /// @param residentMipLevel Most detailed mip level that is already resident.
+    /// All the less detailed mip levels must be resident too.
+    /// @return Texture identifier. Identifiers of removed textures are reused.
+    ///
+    std::uint32_t AddTexture(const std::uint32_t size,
+                             const std::vector<std::uint64_t>& mipLevelSizesInBytes,
+                             const std::uint32_t residentMipLevel) noexcept;
+
+    ///
+    /// @brief Removes a texture. It is not scheduled anymore, and its identifier can be reused.
+    /// @param textureId Texture identifier. It must not be removed already.
+    ///
+    void RemoveTexture(const std::uint32_t textureId) noexcept;
+
+    ///
+    /// @brief Removes all the textures
+    ///
+    void Clear() noexcept;
+
+    ///
+    /// @brief Resets the projected screen size of all the textures
+    ///
+    void ResetPriorities() noexcept;
+
+    ///
+    /// @brief Updates the priority of a texture. The greatest projected size is kept.
+    /// @param textureId Texture identifier
+    /// @param projectedSizeInPixels Size in pixels that the texture covers on screen
+    ///
+    void UpdatePriority(const std::uint32_t textureId,
+                        const float projectedSizeInPixels) noexcept;
+
+    ///
+    /// @brief Schedules the mip levels to upload.
+    ///
+    /// Textures whose resident mip level is the most blurry on screen go first.
+    /// A texture with a request in flight is not scheduled again until the request is completed.
+    /// If the first request does not fit in the budget, it is scheduled alone,
+    /// so big mip levels are not starved.
+    ///
+    /// @param byteBudget Maximum number of bytes to schedule
+    /// @param requests Output requests
+    ///
+    void ScheduleRequests(const std::uint64_t byteBudget,
+                          std::vector<MipLevelRequest>& requests) noexcept;
+
+    ///
+    /// @brief Notifies that a scheduled request is completed and its mip level is resident
+    /// @param request Completed request
+    ///
+    void OnRequestCompleted(const MipLevelRequest& request) noexcept;
+
+    ///
+    /// @brief Get the most detailed resident mip level of a texture
+    /// @param textureId Texture identifier
+    /// @return Mip level
+    ///
+    std::uint32_t GetResidentMipLevel(const std::uint32_t textureId) const noexcept;
+
+    ///
+    /// @brief Get the mip level a texture needs, based on its priority
+    /// @param textureId Texture identifier
+    /// @return Mip level
+    ///
+    std::uint32_t GetRequiredMipLevel(const std::uint32_t textureId) const noexcept;
+
+    ///
+    /// @brief Get the number of textures
+    /// @return Number of textures
+    ///
+    __forceinline std::uint32_t GetTextureCount() const noexcept
+    {
+        return static_cast<std::uint32_t>(mTextures.size() - mFreeTextureIds.size());
+    }
+
+    ///
+    /// @brief Computes the mip level needed to draw a texture at a projected size,
+    /// where a texel of the mip level covers at least a pixel.
+    /// @param size Size in texels of the greatest dimension of the mip level 0
+    /// @param mipLevelCount Number of mip levels. Must be greater than zero.
+    /// @param projectedSizeInPixels Size in pixels that the texture covers on screen
+    /// @return Mip level
+    ///
+    static std::uint32_t ComputeRequiredMipLevel(const std::uint32_t size,
+                                                 const std::uint32_t mipLevelCount,
+                                                 const float projectedSizeInPixels) noexcept;
+
+private:
+    struct TextureState {
+        std::uint32_t mSize{ 0U };
+        std::vector<std::uint64_t> mMipLevelSizesInBytes; // Empty if the texture was removed
+        std::uint32_t mResidentMipLevel{ 0U };
+        float mProjectedSizeInPixels{ 0.0f };
+        bool mIsRequestInFlight{ false };
+    };
+
+    std::vector<TextureState> mTextures;
+
+    // Identifiers of the removed textures
+    std::vector<std::uint32_t> mFreeTextureIds;
+};
+}
@@ -1,6 +1,7 @@
 #include "UploadBuffer.h"
 
 #include <DXUtils\D3DFactory.h>
+#include <MemoryTracker\MemoryTracker.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
@@ -28,6 +29,10 @@ UploadBuffer::UploadBuffer(ID3D12Device& device,
                                                 nullptr,
                                                 IID_PPV_ARGS(&mBuffer)));
     BRE_CHECK_HR(mBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mMappedData)));
+
+    mAllocationSizeInBytes = device.GetResourceAllocationInfo(0U, 1U, &resourceDescriptor).SizeInBytes;
+    MemoryTracker::RegisterAllocation(MemoryTracker::Category::UPLOAD_HEAPS,
+                                      mAllocationSizeInBytes);
 }
 
 UploadBuffer::~UploadBuffer()
@@ -36,6 +41,8 @@ UploadBuffer::~UploadBuffer()
     BRE_ASSERT(mElementSize > 0);
     mBuffer->Unmap(0, nullptr);
     mMappedData = nullptr;
+    MemoryTracker::RegisterDeallocation(MemoryTracker::Category::UPLOAD_HEAPS,
+                                        mAllocationSizeInBytes);
 }
 
 void
@@ -64,5 +64,6 @@ private:
     ID3D12Resource* mBuffer{ nullptr };
     std::uint8_t* mMappedData{ nullptr };
     std::size_t mElementSize{ 0U };
+    std::uint64_t mAllocationSizeInBytes{ 0U };
 };
 }
\ No newline at end of file
@@ -1,11 +1,11 @@
 #include "UploadBufferManager.h"
 
 #include <DirectXManager/DirectXManager.h>
+#include <ResourceManager\ResourceManager.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
-tbb::concurrent_unordered_set<UploadBuffer*> UploadBufferManager::mUploadBuffers;
-std::mutex UploadBufferManager::mMutex;
+SlotMap<UploadBuffer*> UploadBufferManager::mUploadBuffers;
 
 void
 UploadBufferManager::Clear() noexcept
@@ -15,12 +15,35 @@ UploadBufferManager::Clear() noexcept
         delete uploadBuffer;
     }
 
-    mUploadBuffers.clear();
+    mUploadBuffers.Clear();
+}
+
+void
+UploadBufferManager::ReleaseUploadBuffer(const UploadBufferHandle uploadBufferHandle) noexcept
+{
+    UploadBuffer* uploadBuffer{ nullptr };
+    BRE_CHECK_MSG(mUploadBuffers.Erase(uploadBufferHandle, &uploadBuffer), L"Upload buffer handle is stale");
+    BRE_ASSERT(uploadBuffer != nullptr);
+
+    delete uploadBuffer;
+}
+
+UploadBufferManager::SharedUploadBuffer
+UploadBufferManager::ShareUploadBuffer(UploadBuffer& uploadBuffer,
+                                       const UploadBufferHandle uploadBufferHandle) noexcept
+{
+    BRE_ASSERT(uploadBufferHandle.IsNull() == false);
+
+    return ResourceManager::GetDeferredReleaseQueue().MakeShared(uploadBuffer,
+                                                                 [uploadBufferHandle]() {
+        ReleaseUploadBuffer(uploadBufferHandle);
+    });
 }
 
 UploadBuffer&
 UploadBufferManager::CreateUploadBuffer(const std::size_t elementSize,
-                                        const std::uint32_t elementCount) noexcept
+                                        const std::uint32_t elementCount,
+                                        UploadBufferHandle* uploadBufferHandle) noexcept
 {
     BRE_ASSERT(elementSize > 0UL);
     BRE_ASSERT(elementCount > 0U);
@@ -28,8 +51,22 @@ UploadBufferManager::CreateUploadBuffer(const std::size_t elementSize,
     UploadBuffer* uploadBuffer = new UploadBuffer(DirectXManager::GetDevice(),
                                                   elementSize,
                                                   elementCount);
-    mUploadBuffers.insert(uploadBuffer);
+    const UploadBufferHandle handle = mUploadBuffers.Insert(uploadBuffer);
+    if (uploadBufferHandle != nullptr) {
+        *uploadBufferHandle = handle;
+    }
 
     return *uploadBuffer;
 }
+UploadBufferManager::SharedUploadBuffer
+UploadBufferManager::CreateSharedUploadBuffer(const std::size_t elementSize,
+                                              const std::uint32_t elementCount) noexcept
+{
+    UploadBufferHandle uploadBufferHandle;
+    UploadBuffer& uploadBuffer = CreateUploadBuffer(elementSize,
+                                                    elementCount,
+                                                    &uploadBufferHandle);
+
+    return ShareUploadBuffer(uploadBuffer, uploadBufferHandle);
+}
 }
\ No newline at end of file
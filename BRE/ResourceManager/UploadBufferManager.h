@@ -1,10 +1,10 @@
 #pragma once
 
 #include <d3d12.h>
-#include <mutex>
-#include <tbb/concurrent_unordered_set.h>
+#include <memory>
 
 #include <ResourceManager/UploadBuffer.h>
+#include <Utils\SlotMap.h>
 
 namespace BRE {
 ///
@@ -12,6 +12,12 @@ namespace BRE {
 ///
 class UploadBufferManager {
 public:
+    using UploadBufferHandle = SlotMap<UploadBuffer*>::Handle;
+
+    // Reference counted upload buffer. When its last copy is destroyed, the upload buffer
+    // is released once the GPU finished the frames that could use it.
+    using SharedUploadBuffer = std::shared_ptr<UploadBuffer>;
+
     UploadBufferManager() = delete;
     ~UploadBufferManager() = delete;
     UploadBufferManager(const UploadBufferManager&) = delete;
@@ -24,18 +30,56 @@ public:
     ///
     static void Clear() noexcept;
 
+    ///
+    /// @brief Releases an upload buffer
+    ///
+    /// The GPU must not use the upload buffer anymore.
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param uploadBufferHandle Upload buffer handle. It must not be stale.
+    ///
+    static void ReleaseUploadBuffer(const UploadBufferHandle uploadBufferHandle) noexcept;
+
+    ///
+    /// @brief Creates a reference counted handle of an upload buffer
+    ///
+    /// When its last copy is destroyed, the upload buffer is released (see ReleaseUploadBuffer()) once the GPU
+    /// finished the frame that is being recorded (see ResourceManager::GetDeferredReleaseQueue()).
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param uploadBuffer Upload buffer
+    /// @param uploadBufferHandle Upload buffer handle. It must not be stale, and the upload buffer
+    /// must not be released through it anymore.
+    /// @return Reference counted upload buffer
+    ///
+    static SharedUploadBuffer ShareUploadBuffer(UploadBuffer& uploadBuffer,
+                                                const UploadBufferHandle uploadBufferHandle) noexcept;
+
     ///
     /// @brief Creates upload buffer
     /// @param elementSize Size of the element in the upload buffer. Must be greater than zero
     /// @param elementCount Number of elements in the upload buffer. Must be greater than zero.
+    /// @param uploadBufferHandle Output upload buffer handle, to release the upload buffer. It can be nullptr.
     /// @return Upload buffer
     ///
     static UploadBuffer& CreateUploadBuffer(const std::size_t elementSize,
-                                            const std::uint32_t elementCount) noexcept;
+                                            const std::uint32_t elementCount,
+                                            UploadBufferHandle* uploadBufferHandle = nullptr) noexcept;
 
-private:
-    static tbb::concurrent_unordered_set<UploadBuffer*> mUploadBuffers;
+    ///
+    /// @brief Creates a reference counted upload buffer (see ShareUploadBuffer())
+    ///
+    /// It is used by objects that are destroyed before exit, like the command list
+    /// recorders of a scene, so their upload buffers are released with them.
+    ///
+    /// @param elementSize Size of the element in the upload buffer. Must be greater than zero
+    /// @param elementCount Number of elements in the upload buffer. Must be greater than zero.
+    /// @return Reference counted upload buffer
+    ///
+    static SharedUploadBuffer CreateSharedUploadBuffer(const std::size_t elementSize,
+                                                       const std::uint32_t elementCount) noexcept;
 
-    static std::mutex mMutex;
+private:
+    static SlotMap<UploadBuffer*> mUploadBuffers;
 };
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ VertexAndIndexBufferCreator::VertexBufferData::operator=(const VertexBufferData&
     }
 
     mBuffer = instance.mBuffer;
+    mBufferHandle = instance.mBufferHandle;
     mBufferView = instance.mBufferView;
     mElementCount = instance.mElementCount;
 
@@ -47,9 +48,7 @@ VertexAndIndexBufferCreator::VertexBufferData::IsDataValid() const noexcept
 
 void
 VertexAndIndexBufferCreator::CreateVertexBuffer(const BufferCreationData& bufferCreationData,
-                                                VertexBufferData& vertexBufferData,
-                                                ID3D12GraphicsCommandList& commandList,
-                                                ID3D12Resource* &uploadBuffer) noexcept
+                                                VertexBufferData& vertexBufferData) noexcept
 {
     BRE_ASSERT(bufferCreationData.IsDataValid());
 
@@ -59,9 +58,8 @@ VertexAndIndexBufferCreator::CreateVertexBuffer(const BufferCreationData& buffer
     };
     vertexBufferData.mBuffer = &ResourceManager::CreateDefaultBuffer(bufferCreationData.mData,
                                                                      bufferSize,
-                                                                     commandList,
-                                                                     uploadBuffer,
-                                                                     nullptr);
+                                                                     nullptr,
+                                                                     &vertexBufferData.mBufferHandle);
     vertexBufferData.mElementCount = bufferCreationData.mElementCount;
 
     // Fill view
@@ -80,6 +78,7 @@ VertexAndIndexBufferCreator::IndexBufferData::operator=(const IndexBufferData& i
     }
 
     mBuffer = instance.mBuffer;
+    mBufferHandle = instance.mBufferHandle;
     mBufferView = instance.mBufferView;
     mElementCount = instance.mElementCount;
 
@@ -101,9 +100,7 @@ VertexAndIndexBufferCreator::IndexBufferData::IsDataValid() const noexcept
 
 void
 VertexAndIndexBufferCreator::CreateIndexBuffer(const BufferCreationData& bufferCreationData,
-                                               IndexBufferData& indexBufferData,
-                                               ID3D12GraphicsCommandList& commandList,
-                                               ID3D12Resource* &uploadBuffer) noexcept
+                                               IndexBufferData& indexBufferData) noexcept
 {
     BRE_ASSERT(bufferCreationData.IsDataValid());
 
@@ -112,9 +109,8 @@ VertexAndIndexBufferCreator::CreateIndexBuffer(const BufferCreationData& bufferC
     const std::uint32_t bufferSize{ bufferCreationData.mElementCount * elementSize };
     indexBufferData.mBuffer = &ResourceManager::CreateDefaultBuffer(bufferCreationData.mData,
                                                                     bufferSize,
-                                                                    commandList,
-                                                                    uploadBuffer,
-                                                                    nullptr);
+                                                                    nullptr,
+                                                                    &indexBufferData.mBufferHandle);
     indexBufferData.mElementCount = bufferCreationData.mElementCount;
 
     // Set index format
@@ -4,10 +4,15 @@
 #include <cstdint>
 #include <d3d12.h>
 
+#include <ResourceManager\ResourceManager.h>
+
 namespace BRE {
 ///
 /// @brief Responsible to create vertex and index buffer
 ///
+/// Buffers content is uploaded through StagingRingBuffer, so StagingRingBuffer::Flush()
+/// must be called before the buffers are used.
+///
 class VertexAndIndexBufferCreator {
 public:
     VertexAndIndexBufferCreator() = delete;
@@ -69,6 +74,7 @@ public:
         bool IsDataValid() const noexcept;
 
         ID3D12Resource* mBuffer{ nullptr };
+        ResourceManager::ResourceHandle mBufferHandle;
         D3D12_VERTEX_BUFFER_VIEW mBufferView{};
         std::uint32_t mElementCount{ 0U };
     };
@@ -93,6 +99,7 @@ public:
         bool IsDataValid() const noexcept;
 
         ID3D12Resource* mBuffer{ nullptr };
+        ResourceManager::ResourceHandle mBufferHandle;
         D3D12_INDEX_BUFFER_VIEW mBufferView{};
         std::uint32_t mElementCount{ 0U };
     };
@@ -101,35 +108,17 @@ public:
     /// @brief Creates vertex buffer
     /// @param bufferCreationData Input data for buffer creation
     /// @param vertexBufferData Output vertex buffer data
-    /// @param commandList Command list used to upload buffer content to GPU.
-    /// It must be executed after this function call to upload buffer content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadBuffer Upload buffer to upload the buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadBuffer after it knows the copy has been executed.
     ///
     static void CreateVertexBuffer(const BufferCreationData& bufferCreationData,
-                                   VertexBufferData& vertexBufferData,
-                                   ID3D12GraphicsCommandList& commandList,
-                                   ID3D12Resource* &uploadBuffer) noexcept;
+                                   VertexBufferData& vertexBufferData) noexcept;
 
     ///
     /// @brief Creates index buffer
     /// @param bufferCreationData Input data for buffer creation
     /// @param indexBufferData Output index buffer data
-    /// @param commandList Command list used to upload buffer content to GPU.
-    /// It must be executed after this function call to upload buffer content to GPU.
-    /// It must be in recording state before calling this method.
-    /// @param uploadBuffer Upload buffer to upload the buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadBuffer after it knows the copy has been executed.
     ///
     static void CreateIndexBuffer(const BufferCreationData& bufferCreationData,
-                                  IndexBufferData& indexBufferData,
-                                  ID3D12GraphicsCommandList& commandList,
-                                  ID3D12Resource* &uploadBuffer) noexcept;
+                                  IndexBufferData& indexBufferData) noexcept;
 };
 }
 
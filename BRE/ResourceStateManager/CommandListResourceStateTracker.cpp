@@ -0,0 +1,81 @@
+#include "CommandListResourceStateTracker.h"
+
+#include <DXUtils\D3DFactory.h>
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+void
+CommandListResourceStateTracker::Reset() noexcept
+{
+    mResourceStateEntries.clear();
+    mPendingBarriers.clear();
+}
+
+void
+CommandListResourceStateTracker::ChangeResourceState(ID3D12Resource& resource,
+                                                     const D3D12_RESOURCE_STATES newState) noexcept
+{
+    ChangeState(resource,
+                D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+                newState);
+}
+
+void
+CommandListResourceStateTracker::ChangeSubresourceState(ID3D12Resource& resource,
+                                                        const std::uint32_t subresourceIndex,
+                                                        const D3D12_RESOURCE_STATES newState) noexcept
+{
+    BRE_ASSERT(subresourceIndex != D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+    ChangeState(resource,
+                subresourceIndex,
+                newState);
+}
+
+void
+CommandListResourceStateTracker::FlushBarriers(ID3D12GraphicsCommandList& commandList) noexcept
+{
+    if (mPendingBarriers.empty() == false) {
+        commandList.ResourceBarrier(static_cast<std::uint32_t>(mPendingBarriers.size()),
+                                    mPendingBarriers.data());
+        mPendingBarriers.clear();
+    }
+}
+
+void
+CommandListResourceStateTracker::ChangeState(ID3D12Resource& resource,
+                                             const std::uint32_t subresourceIndex,
+                                             const D3D12_RESOURCE_STATES newState) noexcept
+{
+    for (ResourceStateEntry& entry : mResourceStateEntries) {
+        if (entry.mResource != &resource) {
+            continue;
+        }
+
+        // Full resource and subresource tracking must not be mixed in the same command list
+        BRE_ASSERT((entry.mSubresourceIndex == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES) ==
+                   (subresourceIndex == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES));
+
+        if (entry.mSubresourceIndex != subresourceIndex) {
+            continue;
+        }
+
+        if (entry.mFinalState != newState) {
+            mPendingBarriers.push_back(D3DFactory::GetTransitionResourceBarrier(resource,
+                                                                                entry.mFinalState,
+                                                                                newState,
+                                                                                subresourceIndex));
+            entry.mFinalState = newState;
+        }
+
+        return;
+    }
+
+    // First use in this command list. Its transition is resolved on submission.
+    ResourceStateEntry entry;
+    entry.mResource = &resource;
+    entry.mSubresourceIndex = subresourceIndex;
+    entry.mFirstState = newState;
+    entry.mFinalState = newState;
+    mResourceStateEntries.push_back(entry);
+}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <d3d12.h>
+#include <vector>
+
+namespace BRE {
+///
+/// @brief Tracks resource states locally to a command list.
+///
+/// It does not access global resource states, so command lists can be recorded in parallel.
+/// For each resource, it records the state the command list expects when it uses the resource
+/// for the first time, and the state it leaves the resource in. Transitions after the first use
+/// are recorded in the command list. Transitions to the first-use states are resolved against global
+/// states when the command list is submitted (see ResourceStateResolver and CommandListExecutor).
+///
+/// Steps:
+/// - Call Reset() before recording the command list.
+/// - Call ChangeResourceState() or ChangeSubresourceState() before using a resource.
+/// - Call FlushBarriers() before recording commands that need the new states.
+/// - Push the command list with this tracker to the CommandListExecutor.
+///
+class CommandListResourceStateTracker {
+public:
+    ///
+    /// @brief States of a resource (or subresource) in a command list
+    ///
+    struct ResourceStateEntry {
+        ID3D12Resource* mResource{ nullptr };
+        // D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES for full resource
+        std::uint32_t mSubresourceIndex{ D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES };
+        D3D12_RESOURCE_STATES mFirstState{ D3D12_RESOURCE_STATE_COMMON };
+        D3D12_RESOURCE_STATES mFinalState{ D3D12_RESOURCE_STATE_COMMON };
+    };
+
+    CommandListResourceStateTracker() = default;
+    ~CommandListResourceStateTracker() = default;
+    CommandListResourceStateTracker(const CommandListResourceStateTracker&) = delete;
+    const CommandListResourceStateTracker& operator=(const CommandListResourceStateTracker&) = delete;
+    CommandListResourceStateTracker(CommandListResourceStateTracker&&) = default;
+    CommandListResourceStateTracker& operator=(CommandListResourceStateTracker&&) = default;
+
+    ///
+    /// @brief Resets tracked states and pending barriers
+    ///
+    void Reset() noexcept;
+
+    ///
+    /// @brief Change resource state.
+    ///
+    /// If it is the first use of the resource in this tracker, then the state is recorded as
+    /// the first-use state. Otherwise, a barrier is added to the pending barriers
+    /// (if the state is different than the current one).
+    ///
+    /// @param resource Resource to change state. It must not be tracked by subresource in this tracker.
+    /// @param newState New resource state
+    ///
+    void ChangeResourceState(ID3D12Resource& resource,
+                             const D3D12_RESOURCE_STATES newState) noexcept;
+
+    ///
+    /// @brief Change subresource state.
+    ///
+    /// Same than ChangeResourceState() but for a single subresource.
+    ///
+    /// @param resource Resource to change state. It must not be tracked as full resource in this tracker.
+    /// @param subresourceIndex Subresource index
+    /// @param newState New subresource state
+    ///
+    void ChangeSubresourceState(ID3D12Resource& resource,
+                                const std::uint32_t subresourceIndex,
+                                const D3D12_RESOURCE_STATES newState) noexcept;
+
+    ///
+    /// @brief Records pending barriers in a command list, all of them in a single call.
+    /// @param commandList Command list in recording state
+    ///
+    void FlushBarriers(ID3D12GraphicsCommandList& commandList) noexcept;
+
+    ///
+    /// @brief Get pending barriers
+    /// @return Barriers that were not recorded yet by FlushBarriers()
+    ///
+    __forceinline const std::vector<D3D12_RESOURCE_BARRIER>& GetPendingBarriers() const noexcept
+    {
+        return mPendingBarriers;
+    }
+
+    ///
+    /// @brief Get resource state entries
+    /// @return Resource state entries in first-use order
+    ///
+    __forceinline const std::vector<ResourceStateEntry>& GetResourceStateEntries() const noexcept
+    {
+        return mResourceStateEntries;
+    }
+
+private:
+    ///
+    /// @brief Change resource or subresource state
+    /// @param resource Resource to change state
+    /// @param subresourceIndex Subresource index, or D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES for full resource
+    /// @param newState New state
+    ///
+    void ChangeState(ID3D12Resource& resource,
+                     const std::uint32_t subresourceIndex,
+                     const D3D12_RESOURCE_STATES newState) noexcept;
+
+    // Command lists use a few resources, so a linear search is faster than a hash map
+    std::vector<ResourceStateEntry> mResourceStateEntries;
+    std::vector<D3D12_RESOURCE_BARRIER> mPendingBarriers;
+};
+}
@@ -1,17 +1,22 @@
 #pragma once
 
 #include <d3d12.h>
-#include <tbb/concurrent_hash_map.h>
-#include <tbb/concurrent_vector.h>
+#include <mutex>
+#include <vector>
+
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
+#include <ResourceStateManager\ResourceStateResolver.h>
 
 namespace BRE {
 ///
-/// @brief Responsible to track resource states.
+/// @brief Responsible to track global resource states.
 ///
 /// Its functionality includes:
 /// - Resource state registration
-/// - Resource state change
-/// - Resource unregistration
+/// - Resolution of command list resource states on submission
+///
+/// Command lists do not change global states while they are recorded. They track their own states
+/// with a CommandListResourceStateTracker, and CommandListExecutor resolves them in submission order.
 ///
 class ResourceStateManager {
 public:
@@ -47,49 +52,42 @@ public:
                                        const D3D12_RESOURCE_STATES initialState) noexcept;
 
     ///
-    /// @brief Change resource state and get barrier
-    ///
-    /// Resource must have been registered. New state must be different than current state.
-    ///
-    /// @param resource Resource to change state
-    /// @param newState New resource state. It must be different than current state.
-    /// @return Transition resource barrier
+    /// @brief Remove resource tracking, before the resource is released
+    /// @param resource Resource to remove. If it is not tracked, then nothing is done.
     ///
-    static D3D12_RESOURCE_BARRIER ChangeResourceStateAndGetBarrier(ID3D12Resource& resource,
-                                                                   const D3D12_RESOURCE_STATES newState) noexcept;
-
-    ///
-    /// @brief Change subresource state and get barrier
-    ///
-    /// Resource must have been registered. New state must be different than current state.
-    ///
-    /// @param resource Resource to change state
-    /// @param subresourceIndex Subresource index to change state
-    /// @param newState New resource state. It must be different than current state.
-    /// @return Transition resource barrier
-    ///
-    static D3D12_RESOURCE_BARRIER ChangeSubresourceStateAndGetBarrier(ID3D12Resource& resource,
-                                                                      const std::uint32_t subresourceIndex,
-                                                                      const D3D12_RESOURCE_STATES newState) noexcept;
+    static void RemoveResourceTracking(ID3D12Resource& resource) noexcept;
 
     ///
     /// @brief Get resource state
-    /// @param resource Resource to get state. It must have been registered. 
-    /// It must have been registered with AddFullResourceTracking.
-    /// @return Resource state
+    /// @param resource Resource to get state. It must have been registered with AddFullResourceTracking.
+    /// @return Resource state after the last resolved command list
     ///
     static D3D12_RESOURCE_STATES GetResourceState(ID3D12Resource& resource) noexcept;
 
     ///
     /// @brief Get subresource state
     /// @param resource Resource to get state. It must have been registered with AddSubresourceTracking.
-    /// @return Subresource state
+    /// @param subresourceIndex Subresource index
+    /// @return Subresource state after the last resolved command list
     ///
     static D3D12_RESOURCE_STATES GetSubresourceState(ID3D12Resource& resource,
                                                      const std::uint32_t subresourceIndex) noexcept;
 
+    ///
+    /// @brief Resolves command list resource states against global states.
+    ///
+    /// It must be called in the same order command lists are submitted.
+    ///
+    /// @param tracker Command list resource state tracker
+    /// @param transitions Transitions to execute before the command list are appended here
+    ///
+    static void ResolveResourceStates(const CommandListResourceStateTracker& tracker,
+                                      std::vector<ResourceStateResolver::ResourceStateTransition>& transitions) noexcept;
+
 private:
-    static tbb::concurrent_hash_map<ID3D12Resource*, D3D12_RESOURCE_STATES> mStateByResource;
-    static tbb::concurrent_hash_map<ID3D12Resource*, tbb::concurrent_vector<D3D12_RESOURCE_STATES>> mStateByResourceIndexByResource;
+    static ResourceStateResolver mResourceStateResolver;
+
+    // Only registration and resolution lock it. Command list recording does not access global states.
+    static std::mutex mMutex;
 };
 }
\ No newline at end of file
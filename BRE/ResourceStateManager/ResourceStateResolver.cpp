@@ -0,0 +1,147 @@
+#include "ResourceStateResolver.h"
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+namespace {
+///
+/// @brief Appends a transition if states are different
+/// @param resource Resource
+/// @param subresourceIndex Subresource index
+/// @param stateBefore State before
+/// @param stateAfter State after
+/// @param transitions Transitions
+///
+void
+AppendTransitionIfNeeded(ID3D12Resource* resource,
+                         const std::uint32_t subresourceIndex,
+                         const D3D12_RESOURCE_STATES stateBefore,
+                         const D3D12_RESOURCE_STATES stateAfter,
+                         std::vector<ResourceStateResolver::ResourceStateTransition>& transitions) noexcept
+{
+    if (stateBefore == stateAfter) {
+        return;
+    }
+
+    ResourceStateResolver::ResourceStateTransition transition;
+    transition.mResource = resource;
+    transition.mSubresourceIndex = subresourceIndex;
+    transition.mStateBefore = stateBefore;
+    transition.mStateAfter = stateAfter;
+    transitions.push_back(transition);
+}
+}
+
+void
+ResourceStateResolver::AddFullResourceTracking(ID3D12Resource& resource,
+                                               const D3D12_RESOURCE_STATES initialState) noexcept
+{
+    BRE_ASSERT(IsResourceTracked(resource) == false);
+
+    ResourceStates& resourceStates = mStatesByResource[&resource];
+    resourceStates.mIsSubresourceTracking = false;
+    resourceStates.mStates.assign(1U, initialState);
+}
+
+void
+ResourceStateResolver::AddSubresourceTracking(ID3D12Resource& resource,
+                                              const std::uint32_t subresourceCount,
+                                              const D3D12_RESOURCE_STATES initialState) noexcept
+{
+    BRE_ASSERT(IsResourceTracked(resource) == false);
+    BRE_ASSERT(subresourceCount > 0U);
+
+    ResourceStates& resourceStates = mStatesByResource[&resource];
+    resourceStates.mIsSubresourceTracking = true;
+    resourceStates.mStates.assign(subresourceCount, initialState);
+}
+
+void
+ResourceStateResolver::RemoveResourceTracking(ID3D12Resource& resource) noexcept
+{
+    BRE_ASSERT(IsResourceTracked(resource));
+    mStatesByResource.erase(&resource);
+}
+
+bool
+ResourceStateResolver::IsResourceTracked(ID3D12Resource& resource) const noexcept
+{
+    return mStatesByResource.find(&resource) != mStatesByResource.end();
+}
+
+D3D12_RESOURCE_STATES
+ResourceStateResolver::GetResourceState(ID3D12Resource& resource) const noexcept
+{
+    const auto findIt = mStatesByResource.find(&resource);
+    BRE_ASSERT(findIt != mStatesByResource.end());
+    BRE_ASSERT(findIt->second.mIsSubresourceTracking == false);
+
+    return findIt->second.mStates[0U];
+}
+
+D3D12_RESOURCE_STATES
+ResourceStateResolver::GetSubresourceState(ID3D12Resource& resource,
+                                           const std::uint32_t subresourceIndex) const noexcept
+{
+    const auto findIt = mStatesByResource.find(&resource);
+    BRE_ASSERT(findIt != mStatesByResource.end());
+    BRE_ASSERT(findIt->second.mIsSubresourceTracking);
+    BRE_ASSERT(subresourceIndex < static_cast<std::uint32_t>(findIt->second.mStates.size()));
+
+    return findIt->second.mStates[subresourceIndex];
+}
+
+void
+ResourceStateResolver::Resolve(const CommandListResourceStateTracker& tracker,
+                               std::vector<ResourceStateTransition>& transitions) noexcept
+{
+    for (const CommandListResourceStateTracker::ResourceStateEntry& entry : tracker.GetResourceStateEntries()) {
+        BRE_ASSERT(entry.mResource != nullptr);
+
+        const auto findIt = mStatesByResource.find(entry.mResource);
+        BRE_ASSERT(findIt != mStatesByResource.end());
+        if (findIt == mStatesByResource.end()) {
+            continue;
+        }
+
+        std::vector<D3D12_RESOURCE_STATES>& states = findIt->second.mStates;
+
+        if (entry.mSubresourceIndex != D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES) {
+            BRE_ASSERT(findIt->second.mIsSubresourceTracking);
+            BRE_ASSERT(entry.mSubresourceIndex < static_cast<std::uint32_t>(states.size()));
+            AppendTransitionIfNeeded(entry.mResource,
+                                     entry.mSubresourceIndex,
+                                     states[entry.mSubresourceIndex],
+                                     entry.mFirstState,
+                                     transitions);
+            states[entry.mSubresourceIndex] = entry.mFinalState;
+            continue;
+        }
+
+        // Full resource transition. If all the subresources are in the same state,
+        // then a single transition for all of them is enough.
+        bool allStatesAreEqual = true;
+        for (const D3D12_RESOURCE_STATES state : states) {
+            allStatesAreEqual = allStatesAreEqual && state == states[0U];
+        }
+
+        if (allStatesAreEqual) {
+            AppendTransitionIfNeeded(entry.mResource,
+                                     D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+                                     states[0U],
+                                     entry.mFirstState,
+                                     transitions);
+        } else {
+            for (std::uint32_t i = 0U; i < static_cast<std::uint32_t>(states.size()); ++i) {
+                AppendTransitionIfNeeded(entry.mResource,
+                                         i,
+                                         states[i],
+                                         entry.mFirstState,
+                                         transitions);
+            }
+        }
+
+        states.assign(states.size(), entry.mFinalState);
+    }
+}
+}
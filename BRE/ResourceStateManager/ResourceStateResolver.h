@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <d3d12.h>
+#include <unordered_map>
+#include <vector>
+
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
+
+namespace BRE {
+///
+/// @brief Keeps global resource states and resolves command list local states against them.
+///
+/// Command lists must be resolved in the same order they are submitted to the GPU.
+/// It is not thread safe.
+///
+class ResourceStateResolver {
+public:
+    ///
+    /// @brief Transition needed before a command list is executed
+    ///
+    struct ResourceStateTransition {
+        ID3D12Resource* mResource{ nullptr };
+        // D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES for full resource
+        std::uint32_t mSubresourceIndex{ D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES };
+        D3D12_RESOURCE_STATES mStateBefore{ D3D12_RESOURCE_STATE_COMMON };
+        D3D12_RESOURCE_STATES mStateAfter{ D3D12_RESOURCE_STATE_COMMON };
+    };
+
+    ResourceStateResolver() = default;
+    ~ResourceStateResolver() = default;
+    ResourceStateResolver(const ResourceStateResolver&) = delete;
+    const ResourceStateResolver& operator=(const ResourceStateResolver&) = delete;
+    ResourceStateResolver(ResourceStateResolver&&) = delete;
+    ResourceStateResolver& operator=(ResourceStateResolver&&) = delete;
+
+    ///
+    /// @brief Add full resource tracking
+    /// @param resource Resource to add. It must not been added before.
+    /// @param initialState Initial state of the resource
+    ///
+    void AddFullResourceTracking(ID3D12Resource& resource,
+                                 const D3D12_RESOURCE_STATES initialState) noexcept;
+
+    ///
+    /// @brief Add subresource tracking
+    /// @param resource Resource to add. It must not been added before.
+    /// @param subresourceCount Number of subresources. It must be greater than zero.
+    /// @param initialState Initial state of all the subresources
+    ///
+    void AddSubresourceTracking(ID3D12Resource& resource,
+                                const std::uint32_t subresourceCount,
+                                const D3D12_RESOURCE_STATES initialState) noexcept;
+
+    ///
+    /// @brief Remove resource tracking
+    /// @param resource Resource to remove. It must have been added.
+    ///
+    void RemoveResourceTracking(ID3D12Resource& resource) noexcept;
+
+    ///
+    /// @brief Checks if a resource is tracked
+    /// @param resource Resource
+    /// @return True if the resource is tracked. Otherwise, false.
+    ///
+    bool IsResourceTracked(ID3D12Resource& resource) const noexcept;
+
+    ///
+    /// @brief Get resource state
+    /// @param resource Resource. It must have been added with AddFullResourceTracking()
+    /// @return Resource state
+    ///
+    D3D12_RESOURCE_STATES GetResourceState(ID3D12Resource& resource) const noexcept;
+
+    ///
+    /// @brief Get subresource state
+    /// @param resource Resource. It must have been added with AddSubresourceTracking()
+    /// @param subresourceIndex Subresource index
+    /// @return Subresource state
+    ///
+    D3D12_RESOURCE_STATES GetSubresourceState(ID3D12Resource& resource,
+                                              const std::uint32_t subresourceIndex) const noexcept;
+
+    ///
+    /// @brief Resolves the states of a command list.
+    ///
+    /// It computes the transitions from global states to the command list first-use states,
+    /// and updates global states to the command list final states.
+    ///
+    /// @param tracker Command list resource state tracker
+    /// @param transitions Transitions are appended here
+    ///
+    void Resolve(const CommandListResourceStateTracker& tracker,
+                 std::vector<ResourceStateTransition>& transitions) noexcept;
+
+private:
+    ///
+    /// @brief Global states of a resource
+    ///
+    struct ResourceStates {
+        bool mIsSubresourceTracking{ false };
+        // A single state for full resource tracking. A state per subresource otherwise.
+        std::vector<D3D12_RESOURCE_STATES> mStates;
+    };
+
+    std::unordered_map<ID3D12Resource*, ResourceStates> mStatesByResource;
+};
+}
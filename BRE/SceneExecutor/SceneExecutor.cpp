@@ -1,12 +1,17 @@
 #include "SceneExecutor.h"
 
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <ApplicationSettings\ApplicationSettings.h>
 #include <CommandListExecutor\CommandListExecutor.h>
 #include <Input/Keyboard.h>
 #include <Input/Mouse.h>
 #include <RenderManager/RenderManager.h>
 #include <Scene/Scene.h>
-#include <SceneLoader\SceneLoader.h>
 #include <Utils\DebugUtils.h>
+#include <Utils\StringUtils.h>
 
 using namespace DirectX;
 
@@ -22,9 +27,21 @@ void UpdateKeyboardAndMouse() noexcept
         PostQuitMessage(0);
     }
 }
+}
+
+using namespace DirectX;
+
+SceneExecutor::~SceneExecutor()
+{
+    BRE_ASSERT(mRenderManager != nullptr);
+    mRenderManager->Terminate();
+
+    delete mScene;
+}
 
 // Runs program until Escape key is pressed.
-std::int32_t RunMessageLoop() noexcept
+void
+SceneExecutor::Execute() noexcept
 {
     MSG message{ nullptr };
     while (message.message != WM_QUIT) {
@@ -33,39 +50,113 @@ std::int32_t RunMessageLoop() noexcept
             DispatchMessage(&message);
         } else {
             UpdateKeyboardAndMouse();
+            if (Keyboard::Get().WasKeyPressedThisFrame(DIK_TAB)) {
+                SwitchToNextScene();
+            }
+            ReloadModifiedScene();
+            UpdateWorldPartition();
         }
     }
-
-    return static_cast<std::int32_t>(message.wParam);
 }
+
+void
+SceneExecutor::ReloadModifiedScene() noexcept
+{
+    if (ApplicationSettings::sIsSceneHotReloadEnabled == false || mSceneFileWatcher.HaveFilesChanged() == false) {
+        return;
+    }
+
+    GeometryCommandListRecorders commandListRecorders;
+    if (mSceneLoader.ReloadScene(commandListRecorders)) {
+        BRE_ASSERT(mRenderManager != nullptr);
+        mRenderManager->ReplaceGeometryCommandListRecorders(commandListRecorders);
+        mScene->GetGeometryCommandListRecorders() = commandListRecorders;
+    }
+
+    // Replaced assets, and the ones of the world partition cells that are not loaded, are not needed anymore
+    mSceneLoader.ReleaseUnusedAssets();
+
+    // "reference" files could be added or removed
+    WatchSceneFiles();
 }
 
-using namespace DirectX;
+void
+SceneExecutor::UpdateWorldPartition() noexcept
+{
+    if (ApplicationSettings::sIsWorldPartitionEnabled == false) {
+        return;
+    }
 
-SceneExecutor::~SceneExecutor()
+    BRE_ASSERT(mRenderManager != nullptr);
+    GeometryCommandListRecorders commandListRecorders;
+    if (mSceneLoader.UpdateWorldPartition(mRenderManager->GetCameraPosition(), commandListRecorders)) {
+        mRenderManager->ReplaceGeometryCommandListRecorders(commandListRecorders);
+        mScene->GetGeometryCommandListRecorders() = commandListRecorders;
+    }
+}
+
+void
+SceneExecutor::SwitchToNextScene() noexcept
 {
+    if (mSceneFilePaths.size() < 2UL) {
+        return;
+    }
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    mSceneIndex = (mSceneIndex + 1U) % static_cast<std::uint32_t>(mSceneFilePaths.size());
+    const std::string& sceneFilePath = mSceneFilePaths[mSceneIndex];
+
+    // Geometry pass recorders of the loaded scene are released once the GPU finished their frames
     BRE_ASSERT(mRenderManager != nullptr);
-    mRenderManager->Terminate();
+    mRenderManager->Suspend();
 
     delete mScene;
+    mScene = mSceneLoader.LoadScene(sceneFilePath.c_str());
+    BRE_ASSERT(mScene != nullptr);
+
+    // Assets shared with the previous scene were reused, and the rest of its assets,
+    // and the ones of the world partition cells that are not loaded, are not needed anymore
+    mSceneLoader.ReleaseUnusedAssets();
+
+    mRenderManager->Resume(*mScene);
+
+    WatchSceneFiles();
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+    const std::wstring switchMsg =
+        L"Scene switch to " + StringUtils::AnsiToWideString(sceneFilePath) + L" in " +
+        std::to_wstring(std::chrono::duration<double, std::milli>(endTime - startTime).count()) + L" ms\n";
+    BRE_LOG_MSG(switchMsg.c_str());
 }
 
 void
-SceneExecutor::Execute() noexcept
+SceneExecutor::WatchSceneFiles() noexcept
 {
-    RunMessageLoop();
+    if (ApplicationSettings::sIsSceneHotReloadEnabled == false) {
+        return;
+    }
+
+    std::vector<std::string> sceneFilePaths;
+    mSceneLoader.GetSceneFilePaths(sceneFilePaths);
+    mSceneFileWatcher.Watch(sceneFilePaths);
 }
 
-SceneExecutor::SceneExecutor(const char* sceneFilePath)
+SceneExecutor::SceneExecutor(const std::vector<std::string>& sceneFilePaths)
+    : mSceneFilePaths(sceneFilePaths)
 {
-    BRE_ASSERT(sceneFilePath != nullptr);
+    BRE_ASSERT(mSceneFilePaths.empty() == false);
 
     CommandListExecutor::Create(MAX_NUM_CMD_LISTS);
 
-    SceneLoader sceneLoader;
-    mScene = sceneLoader.LoadScene(sceneFilePath);
+    mScene = mSceneLoader.LoadScene(mSceneFilePaths[0].c_str());
     BRE_ASSERT(mScene != nullptr);
 
+    // Assets of the world partition cells that are not loaded are not needed yet
+    mSceneLoader.ReleaseUnusedAssets();
+
     mRenderManager = &RenderManager::Create(*mScene);
+
+    WatchSceneFiles();
 }
 }
\ No newline at end of file
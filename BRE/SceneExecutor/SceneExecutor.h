@@ -1,5 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SceneLoader\SceneLoader.h>
+#include <Utils\FileWatcher.h>
+
 namespace BRE {
 class RenderManager;
 class Scene;
@@ -11,9 +18,10 @@ class SceneExecutor {
 public:
     ///
     /// @brief SceneExecutor constructor
-    /// @param sceneFilePath Scene file path. Must be not nullptr.
+    /// @param sceneFilePaths Scene file paths. Must be not empty. The first scene is loaded,
+    /// and the next ones are switched to at runtime (see Execute()).
     ///
-    explicit SceneExecutor(const char* sceneFilePath);
+    explicit SceneExecutor(const std::vector<std::string>& sceneFilePaths);
     ~SceneExecutor();
     SceneExecutor(const SceneExecutor&) = delete;
     const SceneExecutor& operator=(const SceneExecutor&) = delete;
@@ -24,10 +32,43 @@ public:
     /// @brief Executes the scene executor.
     ///
     /// This method is going to load the scene and run the main loop.
+    /// If scene hot reload is enabled, modifications of the scene files are
+    /// applied to the loaded scene while the main loop is idle.
+    /// If world partition is enabled, the cells around the camera are loaded while the main loop is idle.
+    /// Tab key switches to the next scene.
     ///
     void Execute() noexcept;
 
 private:
+    ///
+    /// @brief Replaces the loaded scene by the next one, without restarting the render manager
+    ///
+    /// Rendering is suspended while the scene is switched. Passes and assets shared between
+    /// scenes are reused, and geometry pass recorders of the replaced scene release their descriptors.
+    ///
+    void SwitchToNextScene() noexcept;
+
+    ///
+    /// @brief Watches the files of the loaded scene, if scene hot reload is enabled
+    ///
+    void WatchSceneFiles() noexcept;
+
+    ///
+    /// @brief Reloads the scene if its files were modified, and replaces its geometry pass recorders
+    ///
+    void ReloadModifiedScene() noexcept;
+
+    ///
+    /// @brief Loads and unloads the world partition cells around the camera, if world partition is enabled,
+    /// and replaces the geometry pass recorders if they changed
+    ///
+    void UpdateWorldPartition() noexcept;
+
+    SceneLoader mSceneLoader;
+    FileWatcher mSceneFileWatcher;
+
+    std::vector<std::string> mSceneFilePaths;
+    std::uint32_t mSceneIndex{ 0U };
     Scene* mScene{ nullptr };
 
     RenderManager* mRenderManager{ nullptr };
@@ -0,0 +1,287 @@
+#include "CompiledScene.h"
+
+#include <Utils\HashUtils.h>
+
+namespace BRE {
+namespace {
+///
+/// @brief Checks if a blob is inside the file
+/// @param offset Blob offset
+/// @param size Blob size in bytes
+/// @param fileSize File size in bytes
+/// @return True if it is inside. Otherwise, false.
+///
+bool
+IsBlobInsideFile(const std::uint64_t offset,
+                 const std::uint64_t size,
+                 const std::uint64_t fileSize) noexcept
+{
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+///
+/// @brief Checks if string indices are valid
+/// @param stringIndices String indices
+/// @param stringIndexCount Number of string indices
+/// @param stringCount Number of strings
+/// @return True if every index is less than the number of strings. Otherwise, false.
+///
+bool
+AreStringIndicesValid(const std::uint32_t* stringIndices,
+                      const std::uint32_t stringIndexCount,
+                      const std::uint32_t stringCount) noexcept
+{
+    for (std::uint32_t i = 0U; i < stringIndexCount; ++i) {
+        if (stringIndices[i] >= stringCount) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief Checks if an instance array is valid
+/// @param instanceArray Instance array
+/// @param fileHeader Compiled scene file header
+/// @return True if its indices are valid and its number of instances fits in 32 bits. Otherwise, false.
+///
+bool
+IsInstanceArrayValid(const CompiledScene::InstanceArray& instanceArray,
+                     const CompiledScene::FileHeader& fileHeader) noexcept
+{
+    if (instanceArray.mModelIndex >= fileHeader.mModelCount ||
+        instanceArray.mPlacement >= CompiledScene::NUM_PLACEMENTS ||
+        instanceArray.mFirstMaterialTechnique > fileHeader.mInstanceArrayMaterialTechniqueCount ||
+        instanceArray.mMaterialTechniqueCount > fileHeader.mInstanceArrayMaterialTechniqueCount - instanceArray.mFirstMaterialTechnique ||
+        instanceArray.mFirstPathPoint > fileHeader.mPathPointCount ||
+        instanceArray.mPathPointCount > fileHeader.mPathPointCount - instanceArray.mFirstPathPoint ||
+        (instanceArray.mPlacement == CompiledScene::PATH && instanceArray.mPathPointCount == 0U)) {
+        return false;
+    }
+
+    // Both products fit in 64 bits, because each factor fits in 32 bits.
+    std::uint64_t instanceCount = static_cast<std::uint64_t>(instanceArray.mCounts[0U]) * instanceArray.mCounts[1U];
+    if (instanceCount > 0xFFFFFFFFUL) {
+        return false;
+    }
+
+    instanceCount *= instanceArray.mCounts[2U];
+
+    return instanceCount <= 0xFFFFFFFFUL;
+}
+}
+
+bool
+CompiledScene::Open(const char* filePath) noexcept
+{
+    BRE_ASSERT(filePath != nullptr);
+
+    Close();
+
+    if (mFile.Open(filePath) == false) {
+        return false;
+    }
+
+    return OpenData(mFile.GetData(), mFile.GetSize());
+}
+
+bool
+CompiledScene::Open(std::vector<std::uint8_t>& compiledSceneData) noexcept
+{
+    Close();
+
+    mFileData.swap(compiledSceneData);
+
+    return OpenData(mFileData.data(), mFileData.size());
+}
+
+void
+CompiledScene::Close() noexcept
+{
+    mFile.Close();
+    mFileData.clear();
+    mData = nullptr;
+    mFileHeader = nullptr;
+    mStringEntries = nullptr;
+    mDependencies = nullptr;
+    mModelNames = nullptr;
+    mMaterialTechniqueNames = nullptr;
+    mDrawables = nullptr;
+    mInstanceArrays = nullptr;
+    mInstanceArrayMaterialTechniques = nullptr;
+    mPathPoints = nullptr;
+}
+
+bool
+CompiledScene::OpenData(const std::uint8_t* data,
+                        const std::uint64_t fileSize) noexcept
+{
+    if (data == nullptr || fileSize < sizeof(FileHeader)) {
+        Close();
+        return false;
+    }
+
+    const FileHeader& fileHeader = *reinterpret_cast<const FileHeader*>(data);
+    if (fileHeader.mMagic != sMagic ||
+        fileHeader.mVersion != sVersion ||
+        fileHeader.mFileSize != fileSize ||
+        IsBlobInsideFile(fileHeader.mStringDataOffset, fileHeader.mStringDataSize, fileSize) == false ||
+        IsBlobInsideFile(fileHeader.mStringEntriesOffset, sizeof(StringEntry) * static_cast<std::uint64_t>(fileHeader.mStringCount), fileSize) == false ||
+        IsBlobInsideFile(fileHeader.mDependenciesOffset, sizeof(Dependency) * static_cast<std::uint64_t>(fileHeader.mDependencyCount), fileSize) == false ||
+        IsBlobInsideFile(fileHeader.mModelNamesOffset, sizeof(std::uint32_t) * static_cast<std::uint64_t>(fileHeader.mModelCount), fileSize) == false ||
+        IsBlobInsideFile(fileHeader.mMaterialTechniqueNamesOffset, sizeof(std::uint32_t) * static_cast<std::uint64_t>(fileHeader.mMaterialTechniqueCount), fileSize) == false ||
+        IsBlobInsideFile(fileHeader.mDrawablesOffset, sizeof(Drawable) * static_cast<std::uint64_t>(fileHeader.mDrawableCount), fileSize) == false ||
+        IsBlobInsideFile(fileHeader.mInstanceArraysOffset, sizeof(InstanceArray) * static_cast<std::uint64_t>(fileHeader.mInstanceArrayCount), fileSize) == false ||
+        IsBlobInsideFile(fileHeader.mInstanceArrayMaterialTechniquesOffset, sizeof(std::uint32_t) * static_cast<std::uint64_t>(fileHeader.mInstanceArrayMaterialTechniqueCount), fileSize) == false ||
+        IsBlobInsideFile(fileHeader.mPathPointsOffset, sizeof(DirectX::XMFLOAT3) * static_cast<std::uint64_t>(fileHeader.mPathPointCount), fileSize) == false ||
+        fileHeader.mAssetsDocumentSize >= fileSize ||
+        IsBlobInsideFile(fileHeader.mAssetsDocumentOffset, fileHeader.mAssetsDocumentSize + 1UL, fileSize) == false ||
+        fileHeader.mStringEntriesOffset % sBlobAlignment != 0U ||
+        fileHeader.mDependenciesOffset % sBlobAlignment != 0U ||
+        fileHeader.mModelNamesOffset % sBlobAlignment != 0U ||
+        fileHeader.mMaterialTechniqueNamesOffset % sBlobAlignment != 0U ||
+        fileHeader.mDrawablesOffset % sBlobAlignment != 0U ||
+        fileHeader.mInstanceArraysOffset % sBlobAlignment != 0U ||
+        fileHeader.mInstanceArrayMaterialTechniquesOffset % sBlobAlignment != 0U ||
+        fileHeader.mPathPointsOffset % sBlobAlignment != 0U ||
+        data[fileHeader.mAssetsDocumentOffset + fileHeader.mAssetsDocumentSize] != '\0') {
+        Close();
+        return false;
+    }
+
+    // Every string must be null terminated inside the string data,
+    // so they can be used without copying them.
+    const char* stringData = reinterpret_cast<const char*>(data + fileHeader.mStringDataOffset);
+    const StringEntry* stringEntries = reinterpret_cast<const StringEntry*>(data + fileHeader.mStringEntriesOffset);
+    for (std::uint32_t i = 0U; i < fileHeader.mStringCount; ++i) {
+        const StringEntry& stringEntry = stringEntries[i];
+        if (static_cast<std::uint64_t>(stringEntry.mOffset) + stringEntry.mLength >= fileHeader.mStringDataSize ||
+            stringData[stringEntry.mOffset + stringEntry.mLength] != '\0') {
+            Close();
+            return false;
+        }
+    }
+
+    const Dependency* dependencies = reinterpret_cast<const Dependency*>(data + fileHeader.mDependenciesOffset);
+    for (std::uint32_t i = 0U; i < fileHeader.mDependencyCount; ++i) {
+        if (dependencies[i].mPathStringIndex >= fileHeader.mStringCount) {
+            Close();
+            return false;
+        }
+    }
+
+    const std::uint32_t* modelNames = reinterpret_cast<const std::uint32_t*>(data + fileHeader.mModelNamesOffset);
+    const std::uint32_t* materialTechniqueNames =
+        reinterpret_cast<const std::uint32_t*>(data + fileHeader.mMaterialTechniqueNamesOffset);
+    if (AreStringIndicesValid(modelNames, fileHeader.mModelCount, fileHeader.mStringCount) == false ||
+        AreStringIndicesValid(materialTechniqueNames, fileHeader.mMaterialTechniqueCount, fileHeader.mStringCount) == false) {
+        Close();
+        return false;
+    }
+
+    // Loaders use drawable indices without checking them.
+    const Drawable* drawables = reinterpret_cast<const Drawable*>(data + fileHeader.mDrawablesOffset);
+    for (std::uint32_t i = 0U; i < fileHeader.mDrawableCount; ++i) {
+        const Drawable& drawable = drawables[i];
+        if (drawable.mModelIndex >= fileHeader.mModelCount ||
+            (drawable.mMaterialTechniqueIndex >= fileHeader.mMaterialTechniqueCount &&
+             drawable.mMaterialTechniqueIndex != sDefaultMaterialTechniqueIndex)) {
+            Close();
+            return false;
+        }
+    }
+
+    const std::uint32_t* instanceArrayMaterialTechniques =
+        reinterpret_cast<const std::uint32_t*>(data + fileHeader.mInstanceArrayMaterialTechniquesOffset);
+    for (std::uint32_t i = 0U; i < fileHeader.mInstanceArrayMaterialTechniqueCount; ++i) {
+        if (instanceArrayMaterialTechniques[i] >= fileHeader.mMaterialTechniqueCount) {
+            Close();
+            return false;
+        }
+    }
+
+    const InstanceArray* instanceArrays = reinterpret_cast<const InstanceArray*>(data + fileHeader.mInstanceArraysOffset);
+    for (std::uint32_t i = 0U; i < fileHeader.mInstanceArrayCount; ++i) {
+        if (IsInstanceArrayValid(instanceArrays[i], fileHeader) == false) {
+            Close();
+            return false;
+        }
+    }
+
+    mData = data;
+    mFileHeader = &fileHeader;
+    mStringEntries = stringEntries;
+    mDependencies = dependencies;
+    mModelNames = modelNames;
+    mMaterialTechniqueNames = materialTechniqueNames;
+    mDrawables = drawables;
+    mInstanceArrays = instanceArrays;
+    mInstanceArrayMaterialTechniques = instanceArrayMaterialTechniques;
+    mPathPoints = reinterpret_cast<const DirectX::XMFLOAT3*>(data + fileHeader.mPathPointsOffset);
+
+    return true;
+}
+
+bool
+CompiledScene::AreDependenciesUpToDate() const noexcept
+{
+    BRE_ASSERT(mFileHeader != nullptr);
+
+    MemoryMappedFile dependencyFile;
+    for (std::uint32_t i = 0U; i < mFileHeader->mDependencyCount; ++i) {
+        const Dependency& dependency = mDependencies[i];
+        if (dependencyFile.Open(GetString(dependency.mPathStringIndex)) == false ||
+            HashUtils::ComputeHash(dependencyFile.GetData(), dependencyFile.GetSize()) != dependency.mContentHash) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const char*
+CompiledScene::GetAssetsDocument() const noexcept
+{
+    BRE_ASSERT(mFileHeader != nullptr);
+
+    return reinterpret_cast<const char*>(mData + mFileHeader->mAssetsDocumentOffset);
+}
+
+const char*
+CompiledScene::GetDependencyPath(const std::uint32_t dependencyIndex) const noexcept
+{
+    BRE_ASSERT(mFileHeader != nullptr);
+    BRE_ASSERT(dependencyIndex < mFileHeader->mDependencyCount);
+
+    return GetString(mDependencies[dependencyIndex].mPathStringIndex);
+}
+
+const char*
+CompiledScene::GetModelName(const std::uint32_t modelIndex) const noexcept
+{
+    BRE_ASSERT(mFileHeader != nullptr);
+    BRE_ASSERT(modelIndex < mFileHeader->mModelCount);
+
+    return GetString(mModelNames[modelIndex]);
+}
+
+const char*
+CompiledScene::GetMaterialTechniqueName(const std::uint32_t materialTechniqueIndex) const noexcept
+{
+    BRE_ASSERT(mFileHeader != nullptr);
+    BRE_ASSERT(materialTechniqueIndex < mFileHeader->mMaterialTechniqueCount);
+
+    return GetString(mMaterialTechniqueNames[materialTechniqueIndex]);
+}
+
+const char*
+CompiledScene::GetString(const std::uint32_t stringIndex) const noexcept
+{
+    BRE_ASSERT(mFileHeader != nullptr);
+    BRE_ASSERT(stringIndex < mFileHeader->mStringCount);
+
+    const char* stringData = reinterpret_cast<const char*>(mData + mFileHeader->mStringDataOffset);
+    return stringData + mStringEntries[stringIndex].mOffset;
+}
+}
\ No newline at end of file
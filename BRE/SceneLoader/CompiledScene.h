@@ -0,0 +1,329 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <DirectXMath.h>
+#include <vector>
+
+#include <MathUtils\MathUtils.h>
+#include <Utils\DebugUtils.h>
+#include <Utils\MemoryMappedFile.h>
+
+namespace BRE {
+///
+/// @brief Read-only view of a compiled scene file, generated from a scene YAML file by SceneCooker.
+///
+/// File layout:
+/// - FileHeader
+/// - Blobs aligned to sBlobAlignment: string data, string entries, dependencies,
+/// model names, material technique names, drawables, instance arrays, instance array
+/// material techniques, instance array path points and assets document.
+///
+/// Names are interned: each different string is stored once, and it is referred by its index.
+/// Drawables are flat records that refer to models and material techniques by index, and
+/// their world matrices are already computed, so they are used straight from the mapped file.
+/// Instance arrays are stored as their placement parameters, and their instances are
+/// generated at load time (see InstanceArray).
+/// The assets document is the scene YAML file without drawable objects, and with
+/// "reference" files already included. It is small, so it is still parsed by the asset loaders.
+///
+class CompiledScene {
+public:
+    CompiledScene() = default;
+    ~CompiledScene() = default;
+    CompiledScene(const CompiledScene&) = delete;
+    const CompiledScene& operator=(const CompiledScene&) = delete;
+    CompiledScene(CompiledScene&&) = delete;
+    CompiledScene& operator=(CompiledScene&&) = delete;
+
+    static const std::uint32_t sMagic{ 0x43535242U }; // "BRSC"
+    static const std::uint32_t sVersion{ 2U };
+    static const std::uint32_t sBlobAlignment{ 16U };
+
+    // Material technique index of drawables that use the default material technique
+    static const std::uint32_t sDefaultMaterialTechniqueIndex{ 0xFFFFFFFFU };
+
+    ///
+    /// @brief Compiled scene file header. Offsets are relative to the beginning of the file.
+    ///
+    struct FileHeader {
+        std::uint32_t mMagic{ 0U };
+        std::uint32_t mVersion{ 0U };
+        std::uint64_t mSourceContentHash{ 0UL };
+        std::uint64_t mFileSize{ 0UL };
+        std::uint64_t mStringDataOffset{ 0UL };
+        std::uint64_t mStringDataSize{ 0UL };
+        std::uint64_t mStringEntriesOffset{ 0UL };
+        std::uint64_t mDependenciesOffset{ 0UL };
+        std::uint64_t mModelNamesOffset{ 0UL };
+        std::uint64_t mMaterialTechniqueNamesOffset{ 0UL };
+        std::uint64_t mDrawablesOffset{ 0UL };
+        std::uint64_t mInstanceArraysOffset{ 0UL };
+        std::uint64_t mInstanceArrayMaterialTechniquesOffset{ 0UL };
+        std::uint64_t mPathPointsOffset{ 0UL };
+        std::uint64_t mAssetsDocumentOffset{ 0UL };
+        std::uint64_t mAssetsDocumentSize{ 0UL }; // Without the null character
+        std::uint32_t mStringCount{ 0U };
+        std::uint32_t mDependencyCount{ 0U };
+        std::uint32_t mModelCount{ 0U };
+        std::uint32_t mMaterialTechniqueCount{ 0U };
+        std::uint32_t mDrawableCount{ 0U };
+        std::uint32_t mInstanceArrayCount{ 0U };
+        std::uint32_t mInstanceArrayMaterialTechniqueCount{ 0U };
+        std::uint32_t mPathPointCount{ 0U };
+    };
+
+    ///
+    /// @brief Null terminated string in the string data
+    ///
+    struct StringEntry {
+        std::uint32_t mOffset{ 0U };
+        std::uint32_t mLength{ 0U }; // Without the null character
+    };
+
+    ///
+    /// @brief File the compiled scene was generated from (the scene file, or a "reference" file)
+    ///
+    struct Dependency {
+        std::uint32_t mPathStringIndex{ 0U };
+        std::uint32_t mPadding{ 0U };
+        std::uint64_t mContentHash{ 0UL };
+    };
+
+    ///
+    /// @brief Drawable object
+    ///
+    struct Drawable {
+        DirectX::XMFLOAT4X4 mWorldMatrix{ MathUtils::GetIdentity4x4Matrix() };
+        std::uint32_t mModelIndex{ 0U };
+        std::uint32_t mMaterialTechniqueIndex{ sDefaultMaterialTechniqueIndex };
+        float mTextureScale{ 1.0f };
+        std::uint32_t mPadding{ 0U };
+    };
+
+    ///
+    /// @brief How the instances of an instance array are placed
+    ///
+    enum InstancePlacement : std::uint32_t {
+        GRID = 0U,    // mCounts[0] x mCounts[1] x mCounts[2] instances separated by mSpacing
+        RANDOM,       // mCounts[0] instances at random positions between mVolumeMin and mVolumeMax
+        PATH,         // mCounts[0] instances evenly spaced along the path points
+        NUM_PLACEMENTS,
+    };
+
+    ///
+    /// @brief Instance array. Every instance has the same model, and its translation,
+    /// rotation, scale and material technique are generated from its index and the seed.
+    ///
+    struct InstanceArray {
+        std::uint32_t mModelIndex{ 0U };
+        InstancePlacement mPlacement{ GRID };
+        std::uint32_t mCounts[3U]{ 1U, 1U, 1U };
+        std::uint32_t mSeed{ 0U };
+
+        // Material technique of each instance is chosen at random among these ones.
+        // If there is none, then the default material technique is used.
+        std::uint32_t mFirstMaterialTechnique{ 0U }; // Index in instance array material techniques
+        std::uint32_t mMaterialTechniqueCount{ 0U };
+
+        std::uint32_t mFirstPathPoint{ 0U }; // Index in path points
+        std::uint32_t mPathPointCount{ 0U };
+
+        float mTranslation[3U]{ 0.0f, 0.0f, 0.0f }; // Grid origin, and offset of random and path positions
+        float mSpacing[3U]{ 1.0f, 1.0f, 1.0f };
+        float mVolumeMin[3U]{ 0.0f, 0.0f, 0.0f };
+        float mVolumeMax[3U]{ 0.0f, 0.0f, 0.0f };
+
+        // Rotation is between mRotation and mRotation + mRotationRange.
+        // Scale is mScale multiplied by a factor between mScaleRange[0] and mScaleRange[1].
+        float mRotation[3U]{ 0.0f, 0.0f, 0.0f };
+        float mRotationRange[3U]{ 0.0f, 0.0f, 0.0f };
+        float mScale[3U]{ 1.0f, 1.0f, 1.0f };
+        float mScaleRange[2U]{ 1.0f, 1.0f };
+        float mTextureScale{ 1.0f };
+        std::uint32_t mPadding{ 0U };
+    };
+
+    ///
+    /// @brief Opens a compiled scene file. If a file was already opened, it is closed first.
+    /// @param filePath Compiled scene file path. Must not be nullptr.
+    /// @return True if the file was opened and it is valid. Otherwise, false (for example,
+    /// it does not exist, it has another version, or it is truncated).
+    ///
+    bool Open(const char* filePath) noexcept;
+
+    ///
+    /// @brief Opens compiled scene data in memory, like the one SceneCooker::CookScene() generates.
+    /// If a file was already opened, it is closed first.
+    /// @param compiledSceneData Compiled scene data. It is moved to the compiled scene, so it is empty after this call.
+    /// @return True if the data is valid. Otherwise, false.
+    ///
+    bool Open(std::vector<std::uint8_t>& compiledSceneData) noexcept;
+
+    ///
+    /// @brief Closes the compiled scene file (if any)
+    ///
+    void Close() noexcept;
+
+    ///
+    /// @brief Checks if the files the compiled scene was generated from were not modified
+    /// @return True if every dependency exists and it has the same content hash. Otherwise, false.
+    ///
+    bool AreDependenciesUpToDate() const noexcept;
+
+    ///
+    /// @brief Get source content hash
+    /// @return Content hash of the scene file
+    ///
+    __forceinline std::uint64_t GetSourceContentHash() const noexcept
+    {
+        BRE_ASSERT(mFileHeader != nullptr);
+        return mFileHeader->mSourceContentHash;
+    }
+
+    ///
+    /// @brief Get number of dependencies
+    /// @return Number of files the compiled scene was generated from
+    ///
+    __forceinline std::uint32_t GetDependencyCount() const noexcept
+    {
+        BRE_ASSERT(mFileHeader != nullptr);
+        return mFileHeader->mDependencyCount;
+    }
+
+    ///
+    /// @brief Get dependency path
+    /// @param dependencyIndex Dependency index. It must be less than GetDependencyCount().
+    /// The first dependency is the scene file.
+    /// @return Null terminated dependency file path
+    ///
+    const char* GetDependencyPath(const std::uint32_t dependencyIndex) const noexcept;
+
+    ///
+    /// @brief Get assets document
+    /// @return Null terminated YAML document
+    ///
+    const char* GetAssetsDocument() const noexcept;
+
+    ///
+    /// @brief Get number of models
+    /// @return Number of models that drawables refer to
+    ///
+    __forceinline std::uint32_t GetModelCount() const noexcept
+    {
+        BRE_ASSERT(mFileHeader != nullptr);
+        return mFileHeader->mModelCount;
+    }
+
+    ///
+    /// @brief Get model name
+    /// @param modelIndex Model index. It must be less than GetModelCount()
+    /// @return Null terminated model name
+    ///
+    const char* GetModelName(const std::uint32_t modelIndex) const noexcept;
+
+    ///
+    /// @brief Get number of material techniques
+    /// @return Number of material techniques that drawables refer to
+    ///
+    __forceinline std::uint32_t GetMaterialTechniqueCount() const noexcept
+    {
+        BRE_ASSERT(mFileHeader != nullptr);
+        return mFileHeader->mMaterialTechniqueCount;
+    }
+
+    ///
+    /// @brief Get material technique name
+    /// @param materialTechniqueIndex Material technique index. It must be less than GetMaterialTechniqueCount()
+    /// @return Null terminated material technique name
+    ///
+    const char* GetMaterialTechniqueName(const std::uint32_t materialTechniqueIndex) const noexcept;
+
+    ///
+    /// @brief Get drawables
+    /// @return Drawables. Their model and material technique indices are valid.
+    ///
+    __forceinline const Drawable* GetDrawables() const noexcept
+    {
+        return mDrawables;
+    }
+
+    ///
+    /// @brief Get number of drawables
+    /// @return Number of drawables
+    ///
+    __forceinline std::uint32_t GetDrawableCount() const noexcept
+    {
+        BRE_ASSERT(mFileHeader != nullptr);
+        return mFileHeader->mDrawableCount;
+    }
+
+    ///
+    /// @brief Get instance arrays
+    /// @return Instance arrays. Their indices are valid, and their number of instances fits in 32 bits.
+    ///
+    __forceinline const InstanceArray* GetInstanceArrays() const noexcept
+    {
+        return mInstanceArrays;
+    }
+
+    ///
+    /// @brief Get number of instance arrays
+    /// @return Number of instance arrays
+    ///
+    __forceinline std::uint32_t GetInstanceArrayCount() const noexcept
+    {
+        BRE_ASSERT(mFileHeader != nullptr);
+        return mFileHeader->mInstanceArrayCount;
+    }
+
+    ///
+    /// @brief Get instance array material techniques
+    /// @return Material technique indices that instance arrays refer to
+    ///
+    __forceinline const std::uint32_t* GetInstanceArrayMaterialTechniques() const noexcept
+    {
+        return mInstanceArrayMaterialTechniques;
+    }
+
+    ///
+    /// @brief Get path points
+    /// @return Path points that instance arrays refer to
+    ///
+    __forceinline const DirectX::XMFLOAT3* GetPathPoints() const noexcept
+    {
+        return mPathPoints;
+    }
+
+private:
+    ///
+    /// @brief Validates compiled scene data, and sets the blob pointers to it
+    /// @param data Compiled scene data. It must be alive while the compiled scene is open.
+    /// @param fileSize Compiled scene data size in bytes
+    /// @return True if the data is valid. Otherwise, false, and the compiled scene is closed.
+    ///
+    bool OpenData(const std::uint8_t* data,
+                  const std::uint64_t fileSize) noexcept;
+
+    ///
+    /// @brief Get string
+    /// @param stringIndex String index. It must be less than the number of strings.
+    /// @return Null terminated string
+    ///
+    const char* GetString(const std::uint32_t stringIndex) const noexcept;
+
+    // Compiled scene data is in the mapped file, or in memory
+    MemoryMappedFile mFile;
+    std::vector<std::uint8_t> mFileData;
+    const std::uint8_t* mData{ nullptr };
+    const FileHeader* mFileHeader{ nullptr };
+    const StringEntry* mStringEntries{ nullptr };
+    const Dependency* mDependencies{ nullptr };
+    const std::uint32_t* mModelNames{ nullptr };
+    const std::uint32_t* mMaterialTechniqueNames{ nullptr };
+    const Drawable* mDrawables{ nullptr };
+    const InstanceArray* mInstanceArrays{ nullptr };
+    const std::uint32_t* mInstanceArrayMaterialTechniques{ nullptr };
+    const DirectX::XMFLOAT3* mPathPoints{ nullptr };
+};
+}
\ No newline at end of file
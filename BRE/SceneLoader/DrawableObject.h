@@ -7,33 +7,26 @@
 
 namespace BRE {
 class MaterialTechnique;
-class Model;
 
 ///
 /// @brief Represents the data needed to draw an object
 ///
+/// Its model is the key of its list (see DrawableObjectLoader::DrawableObjectsByModelName),
+/// so drawable objects do not keep their models loaded: only the recorders that draw them do.
+///
 class DrawableObject {
 public:
-    DrawableObject(const Model& model,
-                   const MaterialTechnique& materialTechnique,
+    // Drawable objects are created in place, once their lists are sized.
+    DrawableObject() = default;
+
+    DrawableObject(const MaterialTechnique& materialTechnique,
                    const DirectX::XMFLOAT4X4& worldMatrix,
                    const float textureScale)
-        : mModel(&model)
-        , mMaterialTechnique(&materialTechnique)
+        : mMaterialTechnique(&materialTechnique)
         , mWorldMatrix(worldMatrix)
         , mTextureScale(textureScale)
     {}
 
-    ///
-    /// @brief Get model
-    /// @return Model
-    ///
-    const Model& GetModel() const noexcept
-    {
-        BRE_ASSERT(mModel != nullptr);
-        return *mModel;
-    }
-
     ///
     /// @brief Get material technique
     /// @return Material technique
@@ -63,7 +56,6 @@ public:
     }
 
 private:
-    const Model* mModel{ nullptr };
     const MaterialTechnique* mMaterialTechnique{ nullptr };
     DirectX::XMFLOAT4X4 mWorldMatrix{ MathUtils::GetIdentity4x4Matrix() };
     float mTextureScale{ 1.0f };
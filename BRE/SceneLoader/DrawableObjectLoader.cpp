@@ -1,121 +1,156 @@
 #include "DrawableObjectLoader.h"
 
-#pragma warning( push )
-#pragma warning( disable : 4127)
-#include <yaml-cpp/yaml.h>
-#pragma warning( pop ) 
+#include <algorithm>
+#include <tbb/parallel_for.h>
 
+#include <SceneLoader\CompiledScene.h>
 #include <SceneLoader\MaterialTechniqueLoader.h>
 #include <SceneLoader\ModelLoader.h>
-#include <SceneLoader\YamlUtils.h>
 #include <Utils/DebugUtils.h>
-
-using namespace DirectX;
+#include <Utils\StringId.h>
 
 namespace BRE {
+namespace {
+// Drawable objects are cheap to create, so each task creates several of them.
+const std::size_t sDrawableObjectGrainSize{ 1024UL };
+}
+
 void
-DrawableObjectLoader::LoadDrawableObjects(const YAML::Node& rootNode) noexcept
+DrawableObjectLoader::LoadDrawableObjects(const CompiledScene& compiledScene) noexcept
 {
-    BRE_ASSERT(rootNode.IsDefined());
-
-    // Get the "drawable objects" node. It is a sequence of maps and its sintax is:
-    // drawable objects:
-    //   - model: modelName
-    //     material properties: materialPropertiesName
-    //     material technique: drawableObjectName
-    //     translation: [10.0, 0.0, 12.0]
-    //     rotation: [3.14, 0.0, 0.0]
-    //     scale: [1, 1, 3]
-    //   - model: modelName
-    //     material properties: materialPropertiesName
-    //     material technique: drawableObjectName
-    //     scale: [1, 3, 3]
-    //     texture scale: 8
-    const YAML::Node drawableObjectsNode = rootNode["drawable objects"];
-    BRE_CHECK_MSG(drawableObjectsNode.IsDefined(), L"'drawable objects' node must be defined");
-    BRE_CHECK_MSG(drawableObjectsNode.IsSequence(), L"'drawable objects' node must be a sequence");
-
-    // We need model name to fill mDrawableObjectsByModelName
-    std::string modelName;
-    std::string pairFirstValue;
-    std::string pairSecondValue;
-    for (YAML::const_iterator seqIt = drawableObjectsNode.begin(); seqIt != drawableObjectsNode.end(); ++seqIt) {
-        const YAML::Node drawableObjectMap = *seqIt;
-        BRE_CHECK_MSG(drawableObjectMap.IsMap(), L"Each drawable object must be a map");
-
-        // Get data to build drawable object
-        const Model* model = nullptr;
-        const MaterialTechnique* materialTechnique = nullptr;
-        float translation[3U]{ 0.0f, 0.0f, 0.0f };
-        float rotation[3U]{ 0.0f, 0.0f, 0.0f };
-        float scale[3U]{ 1.0f, 1.0f, 1.0f };
-        float textureScale = 1.0f;
-        YAML::const_iterator mapIt = drawableObjectMap.begin();
-        while (mapIt != drawableObjectMap.end()) {
-            pairFirstValue = mapIt->first.as<std::string>();
-
-            if (pairFirstValue == "model") {
-                BRE_CHECK_MSG(model == nullptr, L"Drawable object model must be set once");
-                pairSecondValue = mapIt->second.as<std::string>();
-                modelName = pairSecondValue;
-                model = &mModelLoader.GetModel(pairSecondValue);
-            } else if (pairFirstValue == "material technique") {
-                BRE_CHECK_MSG(materialTechnique == nullptr, L"Drawable object material technique must be set once");
-                pairSecondValue = mapIt->second.as<std::string>();
-                materialTechnique = &mMaterialTechniqueLoader.GetMaterialTechnique(pairSecondValue);
-            } else if (pairFirstValue == "translation") {
-                YamlUtils::GetSequence(mapIt->second, translation, 3U);
-            } else if (pairFirstValue == "rotation") {
-                YamlUtils::GetSequence(mapIt->second, rotation, 3U);
-            } else if (pairFirstValue == "scale") {
-                YamlUtils::GetSequence(mapIt->second, scale, 3U);
-            } else if (pairFirstValue == "texture scale") {
-                YamlUtils::GetScalar(mapIt->second, textureScale);
-            } else if (pairFirstValue == "reference") {
-                // If the first field is "reference", then the second field must be a yaml file 
-                // that specifies "drawable objects"
-                const YAML::Node referenceRootNode = YAML::LoadFile(pairSecondValue);
-                BRE_CHECK_MSG(referenceRootNode.IsDefined(), L"Failed to open yaml file");
-                BRE_CHECK_MSG(referenceRootNode["drawable objects"].IsDefined(),
-                              L"Reference file must have 'drawable objects' field");
-                LoadDrawableObjects(referenceRootNode);
-            } else {
-                // To avoid warning about 'conditional expression is constant'. This is the same than false
-                const std::wstring errorMsg =
-                    L"Unknown drawable object field: " + StringUtils::AnsiToWideString(pairFirstValue);
-                BRE_CHECK_MSG(&scale == nullptr, errorMsg.c_str());
+    const std::uint32_t modelCount = compiledScene.GetModelCount();
+    const std::uint32_t materialTechniqueCount = compiledScene.GetMaterialTechniqueCount();
+    const CompiledScene::Drawable* drawables = compiledScene.GetDrawables();
+    const std::uint32_t drawableCount = compiledScene.GetDrawableCount();
+
+    // Names are resolved once, and not per drawable object. Drawable objects are
+    // in lists by model name, so only instance arrays get their models.
+    std::vector<const MaterialTechnique*> materialTechniques(materialTechniqueCount, nullptr);
+    for (std::uint32_t i = 0U; i < materialTechniqueCount; ++i) {
+        materialTechniques[i] =
+            &mMaterialTechniqueLoader.GetMaterialTechnique(StringIdTable::GetStringId(compiledScene.GetMaterialTechniqueName(i)));
+    }
+
+    // If "material technique" field is not present, then it defaults to "color mapping" technique
+    const MaterialTechnique& defaultMaterialTechnique = mMaterialTechniqueLoader.GetDefaultMaterialTechnique();
+
+    // Drawable objects are counted by technique type and model first, and their index
+    // in their list is computed, so each list is resized once and filled in parallel.
+    std::vector<std::uint32_t> drawableObjectCounts(MaterialTechnique::NUM_TECHNIQUES * modelCount, 0U);
+    std::vector<std::uint32_t> drawableObjectListIndices(drawableCount);
+    std::vector<std::uint32_t> drawableObjectIndices(drawableCount);
+    for (std::uint32_t i = 0U; i < drawableCount; ++i) {
+        const CompiledScene::Drawable& drawable = drawables[i];
+        const MaterialTechnique& materialTechnique =
+            drawable.mMaterialTechniqueIndex == CompiledScene::sDefaultMaterialTechniqueIndex ?
+            defaultMaterialTechnique :
+            *materialTechniques[drawable.mMaterialTechniqueIndex];
+        const std::uint32_t listIndex = materialTechnique.GetType() * modelCount + drawable.mModelIndex;
+        drawableObjectListIndices[i] = listIndex;
+        drawableObjectIndices[i] = drawableObjectCounts[listIndex]++;
+    }
+
+    // Lists can have drawable objects of previous loads
+    std::vector<std::vector<DrawableObject>*> drawableObjectLists(drawableObjectCounts.size(), nullptr);
+    std::vector<std::size_t> drawableObjectListOffsets(drawableObjectCounts.size(), 0UL);
+    for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+        for (std::uint32_t modelIndex = 0U; modelIndex < modelCount; ++modelIndex) {
+            const std::size_t listIndex = techniqueType * modelCount + modelIndex;
+            if (drawableObjectCounts[listIndex] == 0U) {
+                continue;
             }
 
-            ++mapIt;
+            std::vector<DrawableObject>& drawableObjects =
+                mDrawableObjectsByModelName[techniqueType][StringIdTable::GetStringId(compiledScene.GetModelName(modelIndex))];
+            drawableObjectListOffsets[listIndex] = drawableObjects.size();
+            drawableObjects.resize(drawableObjects.size() + drawableObjectCounts[listIndex]);
+            drawableObjectLists[listIndex] = &drawableObjects;
         }
+    }
 
-        BRE_CHECK_MSG(model != nullptr, L"'model' field was not present in current drawable object");
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, drawableCount, sDrawableObjectGrainSize),
+                      [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+            const CompiledScene::Drawable& drawable = drawables[i];
+            const std::uint32_t listIndex = drawableObjectListIndices[i];
+            const MaterialTechnique& materialTechnique =
+                drawable.mMaterialTechniqueIndex == CompiledScene::sDefaultMaterialTechniqueIndex ?
+                defaultMaterialTechnique :
+                *materialTechniques[drawable.mMaterialTechniqueIndex];
+            (*drawableObjectLists[listIndex])[drawableObjectListOffsets[listIndex] + drawableObjectIndices[i]] =
+                DrawableObject(materialTechnique,
+                               drawable.mWorldMatrix,
+                               drawable.mTextureScale);
+        }
+    }
+    );
+
+    // Instances of instance arrays are counted by technique type and chunk, so they can be
+    // generated in parallel, straight to the geometry pass data.
+    const CompiledScene::InstanceArray* instanceArrays = compiledScene.GetInstanceArrays();
+    const std::uint32_t* instanceArrayMaterialTechniques = compiledScene.GetInstanceArrayMaterialTechniques();
+    for (std::uint32_t i = 0U; i < compiledScene.GetInstanceArrayCount(); ++i) {
+        const CompiledScene::InstanceArray& compiledInstanceArray = instanceArrays[i];
+        const std::shared_ptr<const InstanceArray> instanceArray =
+            std::make_shared<const InstanceArray>(compiledInstanceArray, compiledScene.GetPathPoints());
+        const ModelManager::SharedModel model =
+            mModelLoader.GetModel(StringIdTable::GetStringId(compiledScene.GetModelName(compiledInstanceArray.mModelIndex)));
 
-        // If "material technique" field is not present, then it defaults to "color mapping" technique
-        if (materialTechnique == nullptr) {
-            materialTechnique = &mMaterialTechniqueLoader.GetDefaultMaterialTechnique();
+        std::vector<const MaterialTechnique*> instanceMaterialTechniques;
+        if (compiledInstanceArray.mMaterialTechniqueCount == 0U) {
+            instanceMaterialTechniques.push_back(&defaultMaterialTechnique);
+        } else {
+            for (std::uint32_t j = 0U; j < compiledInstanceArray.mMaterialTechniqueCount; ++j) {
+                instanceMaterialTechniques.push_back(
+                    materialTechniques[instanceArrayMaterialTechniques[compiledInstanceArray.mFirstMaterialTechnique + j]]);
+            }
         }
 
-        // Build worldMatrix
-        XMFLOAT4X4 worldMatrix;
-        MathUtils::ComputeMatrix(worldMatrix,
-                                 translation[0],
-                                 translation[1],
-                                 translation[2],
-                                 scale[0],
-                                 scale[1],
-                                 scale[2],
-                                 rotation[0],
-                                 rotation[1],
-                                 rotation[2]);
-
-        DrawableObject drawableObject(*model,
-                                      *materialTechnique,
-                                      worldMatrix,
-                                      textureScale);
-
-        DrawableObjectsByModelName& drawableObjectsByModelName = mDrawableObjectsByModelName[materialTechnique->GetType()];
-        drawableObjectsByModelName[modelName].emplace_back(drawableObject);
+        const std::uint32_t instanceCount = instanceArray->GetInstanceCount();
+        const std::uint32_t chunkCount = (instanceCount + sInstanceChunkSize - 1U) / sInstanceChunkSize;
+        std::vector<std::uint32_t> chunkInstanceCounts(chunkCount * MaterialTechnique::NUM_TECHNIQUES, 0U);
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, chunkCount, 1U),
+                          [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t j = r.begin(); j != r.end(); ++j) {
+                const std::uint32_t firstInstance = static_cast<std::uint32_t>(j) * sInstanceChunkSize;
+                const std::uint32_t lastInstance = std::min(firstInstance + sInstanceChunkSize, instanceCount);
+                for (std::uint32_t k = firstInstance; k < lastInstance; ++k) {
+                    const MaterialTechnique& materialTechnique =
+                        *instanceMaterialTechniques[instanceArray->GetMaterialTechniqueChoice(k)];
+                    ++chunkInstanceCounts[j * MaterialTechnique::NUM_TECHNIQUES + materialTechnique.GetType()];
+                }
+            }
+        }
+        );
+
+        for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+            InstanceArrayObjects instanceArrayObjects;
+            instanceArrayObjects.mChunkOffsets.resize(chunkCount + 1U);
+            std::uint32_t techniqueInstanceCount = 0U;
+            for (std::uint32_t j = 0U; j < chunkCount; ++j) {
+                instanceArrayObjects.mChunkOffsets[j] = techniqueInstanceCount;
+                techniqueInstanceCount += chunkInstanceCounts[j * MaterialTechnique::NUM_TECHNIQUES + techniqueType];
+            }
+            instanceArrayObjects.mChunkOffsets[chunkCount] = techniqueInstanceCount;
+
+            if (techniqueInstanceCount == 0U) {
+                continue;
+            }
+
+            instanceArrayObjects.mInstanceArray = instanceArray;
+            instanceArrayObjects.mModel = model;
+            instanceArrayObjects.mMaterialTechniques = instanceMaterialTechniques;
+            mInstanceArrayObjects[techniqueType].push_back(std::move(instanceArrayObjects));
+        }
+    }
+}
+
+void
+DrawableObjectLoader::Clear() noexcept
+{
+    for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+        mDrawableObjectsByModelName[techniqueType].clear();
+        mInstanceArrayObjects[techniqueType].clear();
     }
 }
 }
\ No newline at end of file
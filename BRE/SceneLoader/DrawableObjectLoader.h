@@ -1,17 +1,19 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <ModelManager\ModelManager.h>
 #include <SceneLoader\DrawableObject.h>
+#include <SceneLoader\InstanceArray.h>
 #include <SceneLoader\MaterialTechnique.h>
-
-namespace YAML {
-class Node;
-}
+#include <Utils\StringId.h>
 
 namespace BRE {
+class CompiledScene;
 class MaterialTechniqueLoader;
 class ModelLoader;
 
@@ -20,10 +22,34 @@ class ModelLoader;
 ///
 class DrawableObjectLoader {
 public:
-    using DrawableObjectsByModelName = std::unordered_map<std::string, std::vector<DrawableObject>>;
+    // Drawable objects by model name identifier (see StringIdTable)
+    using DrawableObjectsByModelName = StringIdMap<std::vector<DrawableObject>>;
+
+    // Instances of an instance array are split in chunks of this size, to generate them in parallel.
+    static const std::uint32_t sInstanceChunkSize{ 1024U };
+
+    ///
+    /// @brief Instances of an instance array whose material technique has the same technique type.
+    ///
+    /// Instances are not stored as drawable objects. They are generated from the instance array
+    /// when they are needed, and instances of other technique types are skipped.
+    ///
+    struct InstanceArrayObjects {
+        std::shared_ptr<const InstanceArray> mInstanceArray;
+        ModelManager::SharedModel mModel;
+
+        // Material technique of each material technique choice of the instance array
+        std::vector<const MaterialTechnique*> mMaterialTechniques;
+
+        // Number of instances of the technique type before each chunk of sInstanceChunkSize instances.
+        // The last element is the number of instances of the technique type.
+        std::vector<std::uint32_t> mChunkOffsets;
+    };
+
+    using InstanceArrayObjectsVector = std::vector<InstanceArrayObjects>;
 
     DrawableObjectLoader(const MaterialTechniqueLoader& materialTechniqueLoader,
-                         const ModelLoader& modelLoader)
+                         ModelLoader& modelLoader)
         : mMaterialTechniqueLoader(materialTechniqueLoader)
         , mModelLoader(modelLoader)
     {}
@@ -35,9 +61,23 @@ public:
 
     ///
     /// @brief Load drawable objects
-    /// @param rootNode Scene YAML file root node
     ///
-    void LoadDrawableObjects(const YAML::Node& rootNode) noexcept;
+    /// Model and material technique names are resolved once, and drawable objects
+    /// are created from the compiled scene records, so there is no allocation per drawable object.
+    /// Drawable objects are counted first, so each list is sized once, and then they are created in parallel.
+    /// Instance arrays are not expanded: only their instances are counted by technique type.
+    ///
+    /// @param compiledScene Compiled scene
+    ///
+    void LoadDrawableObjects(const CompiledScene& compiledScene) noexcept;
+
+    ///
+    /// @brief Clears drawable objects and instance arrays of previous loads
+    ///
+    /// It must be called before loading the drawable objects of a modified scene file,
+    /// because material techniques and models they refer to could be replaced.
+    ///
+    void Clear() noexcept;
 
     ///
     /// @brief Get drawable objects by model name by technique
@@ -49,10 +89,21 @@ public:
         return mDrawableObjectsByModelName[techniqueType];
     }
 
+    ///
+    /// @brief Get instance array objects by technique
+    /// @return Instance array objects
+    ///
+    const InstanceArrayObjectsVector& GetInstanceArrayObjectsByTechniqueType(
+        const MaterialTechnique::TechniqueType techniqueType) const noexcept
+    {
+        return mInstanceArrayObjects[techniqueType];
+    }
+
 private:
     DrawableObjectsByModelName mDrawableObjectsByModelName[MaterialTechnique::NUM_TECHNIQUES];
+    InstanceArrayObjectsVector mInstanceArrayObjects[MaterialTechnique::NUM_TECHNIQUES];
 
     const MaterialTechniqueLoader& mMaterialTechniqueLoader;
-    const ModelLoader& mModelLoader;
+    ModelLoader& mModelLoader;
 };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #pragma warning( pop ) 
 
 #include <SceneLoader\TextureLoader.h>
+#include <Utils\StringId.h>
 
 namespace BRE {
 void
@@ -13,6 +14,11 @@ EnvironmentLoader::LoadEnvironment(const YAML::Node& rootNode) noexcept
 {
     BRE_ASSERT(rootNode.IsDefined());
 
+    // The environment of a previously loaded scene is replaced
+    mSkyBoxTexture = nullptr;
+    mDiffuseIrradianceTexture = nullptr;
+    mSpecularPreConvolvedEnvironmentTexture = nullptr;
+
     // Get the "environment" node. It is a single sequence of maps and its sintax is:
     // environment:
     //   - environment texture: textureName
@@ -45,22 +51,23 @@ EnvironmentLoader::LoadEnvironment(const YAML::Node& rootNode) noexcept
 void EnvironmentLoader::UpdateEnvironmentTexture(const std::string& environmentPropertyName,
                                                  const std::string& environmentTextureName) noexcept
 {
-    ID3D12Resource& texture = mTextureLoader.GetTexture(environmentTextureName);
+    const ResourceManager::SharedResource& texture =
+        mTextureLoader.GetTexture(StringIdTable::GetStringId(environmentTextureName));
     if (environmentPropertyName == "sky box texture") {
         BRE_CHECK_MSG(mSkyBoxTexture == nullptr, L"Sky box texture must be set once");
-        mSkyBoxTexture = &texture;
+        mSkyBoxTexture = texture;
     } else if (environmentPropertyName == "diffuse irradiance texture") {
         BRE_CHECK_MSG(mDiffuseIrradianceTexture == nullptr, L"Diffuse irradiance texture must be set once");
-        mDiffuseIrradianceTexture = &texture;
+        mDiffuseIrradianceTexture = texture;
     } else if (environmentPropertyName == "specular pre convolved environment texture") {
         BRE_CHECK_MSG(mSpecularPreConvolvedEnvironmentTexture == nullptr,
                        L"Specular pre convolved enviroment texture must be set once");
-        mSpecularPreConvolvedEnvironmentTexture = &texture;
+        mSpecularPreConvolvedEnvironmentTexture = texture;
     } else {
         // To avoid warning about 'conditional expression is constant'. This is the same than false
         const std::wstring errorMsg =
             L"Unknown environment field: " + StringUtils::AnsiToWideString(environmentPropertyName);
-        BRE_CHECK_MSG(&texture == nullptr, errorMsg.c_str());
+        BRE_CHECK_MSG(&environmentPropertyName == nullptr, errorMsg.c_str());
     }
 }
 }
\ No newline at end of file
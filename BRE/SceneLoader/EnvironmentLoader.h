@@ -1,13 +1,12 @@
 #pragma once
 
+#include <ResourceManager\ResourceManager.h>
 #include <Utils\DebugUtils.h>
 
 namespace YAML {
 class Node;
 }
 
-struct ID3D12Resource;
-
 namespace BRE {
 class TextureLoader;
 
@@ -71,8 +70,8 @@ private:
 
     TextureLoader& mTextureLoader;
 
-    ID3D12Resource* mSkyBoxTexture{ nullptr };
-    ID3D12Resource* mDiffuseIrradianceTexture{ nullptr };
-    ID3D12Resource* mSpecularPreConvolvedEnvironmentTexture{ nullptr };
+    ResourceManager::SharedResource mSkyBoxTexture;
+    ResourceManager::SharedResource mDiffuseIrradianceTexture;
+    ResourceManager::SharedResource mSpecularPreConvolvedEnvironmentTexture;
 };
 }
\ No newline at end of file
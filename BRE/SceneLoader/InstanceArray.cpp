@@ -0,0 +1,196 @@
+#include "InstanceArray.h"
+
+#include <algorithm>
+
+#include <MathUtils\MathUtils.h>
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+namespace {
+///
+/// @brief Random values of an instance. Each one has its own random stream.
+///
+enum RandomStream : std::uint32_t {
+    POSITION_X = 0U,
+    POSITION_Y,
+    POSITION_Z,
+    ROTATION_X,
+    ROTATION_Y,
+    ROTATION_Z,
+    SCALE,
+    MATERIAL_TECHNIQUE,
+};
+
+///
+/// @brief Mixes the bits of a value (splitmix64 finalizer)
+/// @param value Value
+/// @return Mixed value
+///
+std::uint64_t
+MixBits(std::uint64_t value) noexcept
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+///
+/// @brief Get a random number of an instance
+///
+/// It is a hash of the seed, the instance and the stream, so it does not depend
+/// on the order instances are generated, and it is the same in every platform.
+///
+/// @param seed Instance array seed
+/// @param instanceIndex Instance index
+/// @param stream Random stream
+/// @return Random number in [0, 1)
+///
+float
+GetRandom01(const std::uint32_t seed,
+            const std::uint32_t instanceIndex,
+            const RandomStream stream) noexcept
+{
+    const std::uint64_t hash = MixBits(((static_cast<std::uint64_t>(seed) << 32U) | instanceIndex) ^
+                                       MixBits(stream));
+
+    // 24 bits, so every value is exactly representable as a float less than 1
+    return static_cast<float>(hash >> 40U) * (1.0f / 16777216.0f);
+}
+}
+
+InstanceArray::InstanceArray(const CompiledScene::InstanceArray& instanceArray,
+                             const DirectX::XMFLOAT3* pathPoints) noexcept
+    : mInstanceArray(instanceArray)
+{
+    BRE_ASSERT(instanceArray.mPlacement < CompiledScene::NUM_PLACEMENTS);
+
+    mInstanceCount = instanceArray.mCounts[0U] * instanceArray.mCounts[1U] * instanceArray.mCounts[2U];
+
+    if (instanceArray.mPlacement == CompiledScene::PATH) {
+        BRE_ASSERT(pathPoints != nullptr);
+        BRE_ASSERT(instanceArray.mPathPointCount > 0U);
+
+        mPathPoints.assign(pathPoints + instanceArray.mFirstPathPoint,
+                           pathPoints + instanceArray.mFirstPathPoint + instanceArray.mPathPointCount);
+        mPathLengths.resize(mPathPoints.size());
+        mPathLengths[0U] = 0.0f;
+        for (std::size_t i = 1UL; i < mPathPoints.size(); ++i) {
+            const DirectX::XMVECTOR segment = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&mPathPoints[i]),
+                                                                        DirectX::XMLoadFloat3(&mPathPoints[i - 1UL]));
+            mPathLengths[i] = mPathLengths[i - 1UL] + DirectX::XMVectorGetX(DirectX::XMVector3Length(segment));
+        }
+    }
+}
+
+std::uint32_t
+InstanceArray::GetMaterialTechniqueChoice(const std::uint32_t instanceIndex) const noexcept
+{
+    BRE_ASSERT(instanceIndex < mInstanceCount);
+
+    if (mInstanceArray.mMaterialTechniqueCount < 2U) {
+        return 0U;
+    }
+
+    const std::uint32_t choice =
+        static_cast<std::uint32_t>(GetRandom01(mInstanceArray.mSeed, instanceIndex, MATERIAL_TECHNIQUE) *
+                                   mInstanceArray.mMaterialTechniqueCount);
+
+    return std::min(choice, mInstanceArray.mMaterialTechniqueCount - 1U);
+}
+
+void
+InstanceArray::ComputePosition(const std::uint32_t instanceIndex,
+                               DirectX::XMFLOAT3& position) const noexcept
+{
+    BRE_ASSERT(instanceIndex < mInstanceCount);
+
+    const float* translation = mInstanceArray.mTranslation;
+    switch (mInstanceArray.mPlacement) {
+    case CompiledScene::GRID:
+    {
+        // X varies first, then Z, and then Y, so each layer of the grid is contiguous.
+        const std::uint32_t countX = mInstanceArray.mCounts[0U];
+        const std::uint32_t countZ = mInstanceArray.mCounts[2U];
+        const std::uint32_t x = instanceIndex % countX;
+        const std::uint32_t z = (instanceIndex / countX) % countZ;
+        const std::uint32_t y = instanceIndex / (countX * countZ);
+        position.x = translation[0U] + x * mInstanceArray.mSpacing[0U];
+        position.y = translation[1U] + y * mInstanceArray.mSpacing[1U];
+        position.z = translation[2U] + z * mInstanceArray.mSpacing[2U];
+        break;
+    }
+    case CompiledScene::RANDOM:
+    {
+        const float* volumeMin = mInstanceArray.mVolumeMin;
+        const float* volumeMax = mInstanceArray.mVolumeMax;
+        const std::uint32_t seed = mInstanceArray.mSeed;
+        position.x = translation[0U] + volumeMin[0U] + (volumeMax[0U] - volumeMin[0U]) * GetRandom01(seed, instanceIndex, POSITION_X);
+        position.y = translation[1U] + volumeMin[1U] + (volumeMax[1U] - volumeMin[1U]) * GetRandom01(seed, instanceIndex, POSITION_Y);
+        position.z = translation[2U] + volumeMin[2U] + (volumeMax[2U] - volumeMin[2U]) * GetRandom01(seed, instanceIndex, POSITION_Z);
+        break;
+    }
+    default:
+    {
+        BRE_ASSERT(mInstanceArray.mPlacement == CompiledScene::PATH);
+
+        // Instances are evenly spaced by path length, and the first and last ones
+        // are at the path ends.
+        const float pathLength = mPathLengths.back();
+        const float length = mInstanceCount > 1U ?
+            pathLength * (static_cast<float>(instanceIndex) / static_cast<float>(mInstanceCount - 1U)) :
+            0.0f;
+
+        // First point whose path length is not less than the instance one
+        const std::size_t pointIndex = std::min(static_cast<std::size_t>(
+            std::lower_bound(mPathLengths.begin(), mPathLengths.end(), length) - mPathLengths.begin()),
+            mPathPoints.size() - 1UL);
+
+        DirectX::XMFLOAT3 pathPosition = mPathPoints[pointIndex];
+        if (pointIndex > 0UL) {
+            const float segmentLength = mPathLengths[pointIndex] - mPathLengths[pointIndex - 1UL];
+            if (segmentLength > 0.0f) {
+                const float t = (length - mPathLengths[pointIndex - 1UL]) / segmentLength;
+                DirectX::XMStoreFloat3(&pathPosition,
+                                       DirectX::XMVectorLerp(DirectX::XMLoadFloat3(&mPathPoints[pointIndex - 1UL]),
+                                                             DirectX::XMLoadFloat3(&mPathPoints[pointIndex]),
+                                                             t));
+            }
+        }
+
+        position.x = translation[0U] + pathPosition.x;
+        position.y = translation[1U] + pathPosition.y;
+        position.z = translation[2U] + pathPosition.z;
+        break;
+    }
+    }
+}
+
+void
+InstanceArray::ComputeWorldMatrix(const std::uint32_t instanceIndex,
+                                  DirectX::XMFLOAT4X4& worldMatrix) const noexcept
+{
+    BRE_ASSERT(instanceIndex < mInstanceCount);
+
+    DirectX::XMFLOAT3 position;
+    ComputePosition(instanceIndex, position);
+
+    const std::uint32_t seed = mInstanceArray.mSeed;
+    const float* rotation = mInstanceArray.mRotation;
+    const float* rotationRange = mInstanceArray.mRotationRange;
+    const float* scale = mInstanceArray.mScale;
+    const float* scaleRange = mInstanceArray.mScaleRange;
+    const float scaleFactor = scaleRange[0U] + (scaleRange[1U] - scaleRange[0U]) * GetRandom01(seed, instanceIndex, SCALE);
+
+    MathUtils::ComputeMatrix(worldMatrix,
+                             position.x,
+                             position.y,
+                             position.z,
+                             scale[0U] * scaleFactor,
+                             scale[1U] * scaleFactor,
+                             scale[2U] * scaleFactor,
+                             rotation[0U] + rotationRange[0U] * GetRandom01(seed, instanceIndex, ROTATION_X),
+                             rotation[1U] + rotationRange[1U] * GetRandom01(seed, instanceIndex, ROTATION_Y),
+                             rotation[2U] + rotationRange[2U] * GetRandom01(seed, instanceIndex, ROTATION_Z));
+}
+}
\ No newline at end of file
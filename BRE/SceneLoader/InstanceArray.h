@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <DirectXMath.h>
+#include <vector>
+
+#include <SceneLoader\CompiledScene.h>
+
+namespace BRE {
+///
+/// @brief Generates the instances of an instance array of a compiled scene.
+///
+/// Instances are not stored: the translation, rotation, scale and material technique choice
+/// of an instance are computed from its index and the instance array seed, so any instance
+/// can be generated in any order, from any thread, and it is always the same one.
+///
+class InstanceArray {
+public:
+    ///
+    /// @brief InstanceArray constructor
+    /// @param instanceArray Compiled scene instance array
+    /// @param pathPoints Compiled scene path points (see CompiledScene::GetPathPoints())
+    ///
+    InstanceArray(const CompiledScene::InstanceArray& instanceArray,
+                  const DirectX::XMFLOAT3* pathPoints) noexcept;
+
+    ///
+    /// @brief Get number of instances
+    /// @return Number of instances
+    ///
+    std::uint32_t GetInstanceCount() const noexcept
+    {
+        return mInstanceCount;
+    }
+
+    ///
+    /// @brief Get texture scale
+    /// @return Texture scale of every instance
+    ///
+    float GetTextureScale() const noexcept
+    {
+        return mInstanceArray.mTextureScale;
+    }
+
+    ///
+    /// @brief Get the material technique choice of an instance
+    /// @param instanceIndex Instance index. It must be less than GetInstanceCount().
+    /// @return Index in the material techniques of the instance array. If it has none, then zero.
+    ///
+    std::uint32_t GetMaterialTechniqueChoice(const std::uint32_t instanceIndex) const noexcept;
+
+    ///
+    /// @brief Computes the position of an instance
+    /// @param instanceIndex Instance index. It must be less than GetInstanceCount().
+    /// @param position Output position
+    ///
+    void ComputePosition(const std::uint32_t instanceIndex,
+                         DirectX::XMFLOAT3& position) const noexcept;
+
+    ///
+    /// @brief Computes the world matrix of an instance
+    /// @param instanceIndex Instance index. It must be less than GetInstanceCount().
+    /// @param worldMatrix Output world matrix
+    ///
+    void ComputeWorldMatrix(const std::uint32_t instanceIndex,
+                            DirectX::XMFLOAT4X4& worldMatrix) const noexcept;
+
+private:
+    CompiledScene::InstanceArray mInstanceArray;
+    std::uint32_t mInstanceCount{ 0U };
+
+    // Path points, and the path length from the first point to each of them.
+    std::vector<DirectX::XMFLOAT3> mPathPoints;
+    std::vector<float> mPathLengths;
+};
+}
\ No newline at end of file
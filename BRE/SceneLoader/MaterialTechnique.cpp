@@ -3,21 +3,38 @@
 #include <Utils\DebugUtils.h>
 
 namespace BRE {
+const DirectX::XMFLOAT3 MaterialTechnique::sDefaultBaseColor{ 1.0f, 1.0f, 1.0f };
+const float MaterialTechnique::sDefaultMetalness{ 0.0f };
+const float MaterialTechnique::sDefaultRoughness{ 0.5f };
+
 MaterialTechnique::TechniqueType
 MaterialTechnique::GetType() const noexcept
 {
-    BRE_CHECK_MSG(mBaseColorTexture != nullptr, L"There is no technique without base color texture");
-    BRE_CHECK_MSG(mMetalnessTexture != nullptr, L"There is no technique without metalness texture");
-    BRE_CHECK_MSG(mRoughnessTexture != nullptr, L"There is no technique without roughness texture");
+    // Base color, metalness and roughness are constants
+    if (mBaseColorTextureNameId == sNoTextureNameId) {
+        if (mNormalTextureNameId == sNoTextureNameId) {
+            BRE_CHECK_MSG(mHasHeight == false, L"There is no technique with height texture but no normal texture");
+            return TechniqueType::COLOR_MAPPING;
+        }
+
+        if (mHasHeight) {
+            BRE_CHECK_MSG(mMetalnessRoughnessHeightTextureNameId != sNoTextureNameId, L"There is no technique with height but without height texture");
+            return TechniqueType::COLOR_HEIGHT_MAPPING;
+        } else {
+            return TechniqueType::COLOR_NORMAL_MAPPING;
+        }
+    }
+
+    BRE_CHECK_MSG(mMetalnessRoughnessHeightTextureNameId != sNoTextureNameId, L"There is no technique with base color texture but without metalness and roughness texture");
 
-    if (mNormalTexture != nullptr) {
-        if (mHeightTexture != nullptr) {
+    if (mNormalTextureNameId != sNoTextureNameId) {
+        if (mHasHeight) {
             return TechniqueType::HEIGHT_MAPPING;
         } else {
             return TechniqueType::NORMAL_MAPPING;
         }
     } else {
-        BRE_CHECK_MSG(mHeightTexture == nullptr, L"There is no technique with base color and height texture but no normal texture");
+        BRE_CHECK_MSG(mHasHeight == false, L"There is no technique with base color and height texture but no normal texture");
         return TechniqueType::TEXTURE_MAPPING;
     }
 
@@ -1,13 +1,21 @@
 #pragma once
 
-#include <Utils\DebugUtils.h>
+#include <DirectXMath.h>
+#include <vector>
 
-struct ID3D12Resource;
+#include <Utils\DebugUtils.h>
+#include <Utils\StringId.h>
 
 namespace BRE {
 ///
 /// @brief Contains material technique data like base color texture, normal texture, height texture, etc.
 ///
+/// Base color, metalness and roughness are constants if there is no base color texture
+/// (color techniques). Otherwise, metalness and roughness are packed in a texture, even
+/// if they are constants, because textured techniques sample them.
+/// Textures are referred by their name identifier (see TextureLoader::GetTexture()), so material
+/// techniques do not keep them loaded: only the recorders that sample them do.
+///
 class MaterialTechnique {
 public:
     enum TechniqueType {
@@ -20,116 +28,169 @@ public:
         NUM_TECHNIQUES,
     };
 
-    MaterialTechnique(ID3D12Resource* baseColorTexture = nullptr,
-                      ID3D12Resource* metalnessTexture = nullptr,
-                      ID3D12Resource* roughnessTexture = nullptr,
-                      ID3D12Resource* normalTexture = nullptr,
-                      ID3D12Resource* heightTexture = nullptr)
-        : mBaseColorTexture(baseColorTexture)
-        , mMetalnessTexture(metalnessTexture)
-        , mRoughnessTexture(roughnessTexture)
-        , mNormalTexture(normalTexture)
-        , mHeightTexture(heightTexture)
+    static const DirectX::XMFLOAT3 sDefaultBaseColor;
+    static const float sDefaultMetalness;
+    static const float sDefaultRoughness;
+
+    // Texture name identifier of the textures the material technique does not have
+    static const StringId sNoTextureNameId{ 0UL };
+
+    MaterialTechnique(const StringId baseColorTextureNameId = sNoTextureNameId,
+                      const StringId metalnessRoughnessHeightTextureNameId = sNoTextureNameId,
+                      const StringId normalTextureNameId = sNoTextureNameId,
+                      const bool hasHeight = false)
+        : mBaseColorTextureNameId(baseColorTextureNameId)
+        , mMetalnessRoughnessHeightTextureNameId(metalnessRoughnessHeightTextureNameId)
+        , mNormalTextureNameId(normalTextureNameId)
+        , mHasHeight(hasHeight)
     {}
 
     ///
-    /// @brief Get base color texture
-    /// @return Base color texture
+    /// @brief Get base color texture name identifier
+    /// @return Base color texture name identifier
     ///
-    ID3D12Resource& GetBaseColorTexture() const noexcept
+    StringId GetBaseColorTextureNameId() const noexcept
     {
-        BRE_ASSERT(mBaseColorTexture != nullptr);
-        return *mBaseColorTexture;
+        BRE_ASSERT(mBaseColorTextureNameId != sNoTextureNameId);
+        return mBaseColorTextureNameId;
     }
 
     ///
-    /// @brief Get metalness texture
-    /// @return Metalness texture
+    /// @brief Get metalness, roughness and height texture name identifier
+    ///
+    /// Metalness is in red channel, roughness in green channel,
+    /// and height (if HasHeight()) in blue channel.
     ///
-    ID3D12Resource& GetMetalnessTexture() const noexcept
+    /// @return Metalness, roughness and height texture name identifier
+    ///
+    StringId GetMetalnessRoughnessHeightTextureNameId() const noexcept
     {
-        BRE_ASSERT(mMetalnessTexture != nullptr);
-        return *mMetalnessTexture;
+        BRE_ASSERT(mMetalnessRoughnessHeightTextureNameId != sNoTextureNameId);
+        return mMetalnessRoughnessHeightTextureNameId;
     }
 
     ///
-    /// @brief Get roughness texture
-    /// @return Roughness texture
+    /// @brief Get normal texture name identifier
+    /// @return Normal texture name identifier
     ///
-    ID3D12Resource& GetRoughnessTexture() const noexcept
+    StringId GetNormalTextureNameId() const noexcept
     {
-        BRE_ASSERT(mRoughnessTexture != nullptr);
-        return *mRoughnessTexture;
+        BRE_ASSERT(mNormalTextureNameId != sNoTextureNameId);
+        return mNormalTextureNameId;
     }
 
     ///
-    /// @brief Get normal texture
-    /// @return Normal texture
+    /// @brief Get the texture name identifiers of the material technique.
+    /// They are the textures its technique type samples.
+    /// @param textureNameIds Output texture name identifiers. They are appended.
     ///
-    ID3D12Resource& GetNormalTexture() const noexcept
+    void GetTextureNameIds(std::vector<StringId>& textureNameIds) const noexcept
     {
-        BRE_ASSERT(mNormalTexture != nullptr);
-        return *mNormalTexture;
+        if (mBaseColorTextureNameId != sNoTextureNameId) {
+            textureNameIds.push_back(mBaseColorTextureNameId);
+        }
+        if (mMetalnessRoughnessHeightTextureNameId != sNoTextureNameId) {
+            textureNameIds.push_back(mMetalnessRoughnessHeightTextureNameId);
+        }
+        if (mNormalTextureNameId != sNoTextureNameId) {
+            textureNameIds.push_back(mNormalTextureNameId);
+        }
     }
 
     ///
-    /// @brief Get height texture
-    /// @return Height texture
+    /// @brief Get base color. It is used if there is no base color texture.
+    /// @return Base color
     ///
-    ID3D12Resource& GetHeightTexture() const noexcept
+    const DirectX::XMFLOAT3& GetBaseColor() const noexcept
     {
-        BRE_ASSERT(mHeightTexture != nullptr);
-        return *mHeightTexture;
+        return mBaseColor;
     }
 
     ///
-    /// @brief Set base color texture
-    /// @param texture New base color texture.
+    /// @brief Get metalness. It is used if there is no base color texture.
+    /// @return Metalness
+    ///
+    float GetMetalness() const noexcept
+    {
+        return mMetalness;
+    }
+
+    ///
+    /// @brief Get roughness. It is used if there is no base color texture.
+    /// @return Roughness
     ///
-    void SetBaseColorTexture(ID3D12Resource* texture) noexcept
+    float GetRoughness() const noexcept
     {
-        BRE_ASSERT(texture != nullptr);
-        mBaseColorTexture = texture;
+        return mRoughness;
     }
 
     ///
-    /// @brief Set metalness texture
-    /// @param texture New metalness texture.
+    /// @brief Checks if the metalness, roughness and height texture has height
+    /// @return True if it has height. Otherwise, false.
     ///
-    void SetMetalnessTexture(ID3D12Resource* texture) noexcept
+    bool HasHeight() const noexcept
     {
-        BRE_ASSERT(texture != nullptr);
-        mMetalnessTexture = texture;
+        return mHasHeight;
     }
 
     ///
-    /// @brief Set roughness texture
-    /// @param texture New roughness texture.
+    /// @brief Set base color texture
+    /// @param textureNameId New base color texture name identifier
     ///
-    void SetRoughnessTexture(ID3D12Resource* texture) noexcept
+    void SetBaseColorTexture(const StringId textureNameId) noexcept
     {
-        BRE_ASSERT(texture != nullptr);
-        mRoughnessTexture = texture;
+        BRE_ASSERT(textureNameId != sNoTextureNameId);
+        mBaseColorTextureNameId = textureNameId;
+    }
+
+    ///
+    /// @brief Set metalness, roughness and height texture
+    /// @param textureNameId New metalness, roughness and height texture name identifier
+    /// @param hasHeight True if the texture has height in blue channel
+    ///
+    void SetMetalnessRoughnessHeightTexture(const StringId textureNameId,
+                                            const bool hasHeight) noexcept
+    {
+        BRE_ASSERT(textureNameId != sNoTextureNameId);
+        mMetalnessRoughnessHeightTextureNameId = textureNameId;
+        mHasHeight = hasHeight;
     }
 
     ///
     /// @brief Set normal texture
-    /// @param texture New normal texture
+    /// @param textureNameId New normal texture name identifier
+    ///
+    void SetNormalTexture(const StringId textureNameId) noexcept
+    {
+        BRE_ASSERT(textureNameId != sNoTextureNameId);
+        mNormalTextureNameId = textureNameId;
+    }
+
+    ///
+    /// @brief Set base color
+    /// @param baseColor New base color
+    ///
+    void SetBaseColor(const DirectX::XMFLOAT3& baseColor) noexcept
+    {
+        mBaseColor = baseColor;
+    }
+
+    ///
+    /// @brief Set metalness
+    /// @param metalness New metalness
     ///
-    void SetNormalTexture(ID3D12Resource* texture) noexcept
+    void SetMetalness(const float metalness) noexcept
     {
-        BRE_ASSERT(texture != nullptr);
-        mNormalTexture = texture;
+        mMetalness = metalness;
     }
 
     ///
-    /// @brief Set height texture
-    /// @param texture New height texture
+    /// @brief Set roughness
+    /// @param roughness New roughness
     ///
-    void SetHeightTexture(ID3D12Resource* texture) noexcept
+    void SetRoughness(const float roughness) noexcept
     {
-        BRE_ASSERT(texture != nullptr);
-        mHeightTexture = texture;
+        mRoughness = roughness;
     }
 
     ///
@@ -139,10 +200,12 @@ public:
     TechniqueType GetType() const noexcept;
 
 private:
-    ID3D12Resource* mBaseColorTexture{ nullptr };
-    ID3D12Resource* mMetalnessTexture{ nullptr };
-    ID3D12Resource* mRoughnessTexture{ nullptr };
-    ID3D12Resource* mNormalTexture{ nullptr };
-    ID3D12Resource* mHeightTexture{ nullptr };
+    StringId mBaseColorTextureNameId;
+    StringId mMetalnessRoughnessHeightTextureNameId;
+    StringId mNormalTextureNameId;
+    bool mHasHeight{ false };
+    DirectX::XMFLOAT3 mBaseColor{ sDefaultBaseColor };
+    float mMetalness{ sDefaultMetalness };
+    float mRoughness{ sDefaultRoughness };
 };
 }
\ No newline at end of file
@@ -8,10 +8,20 @@
 #include <SceneLoader\TextureLoader.h>
 #include <SceneLoader\YamlUtils.h>
 #include <Utils/DebugUtils.h>
+#include <Utils\StringId.h>
 
 namespace BRE {
 void
 MaterialTechniqueLoader::LoadMaterialTechniques(const YAML::Node& rootNode) noexcept
+{
+    // Material techniques of a previous load are replaced
+    mMaterialTechniqueByName.clear();
+
+    AddMaterialTechniques(rootNode);
+}
+
+void
+MaterialTechniqueLoader::AddMaterialTechniques(const YAML::Node& rootNode) noexcept
 {
     BRE_ASSERT(rootNode.IsDefined());
 
@@ -25,9 +35,15 @@ MaterialTechniqueLoader::LoadMaterialTechniques(const YAML::Node& rootNode) noex
     //     height texture: heightTextureName
     //   - name: techniqueName2
     //     base color texture: baseColorTextureName
-    //     metalness texture: metalnessTextureName
-    //     roughness texture: roughnessTextureName
+    //     metalness: 0.0
+    //     roughness: 0.5
     //     normal texture: normalTextureName
+    //   - name: techniqueName3
+    //     base color: [1.0, 0.0, 0.0]
+    //     metalness: 1.0
+    //     roughness: 0.2
+    // Metalness and roughness can be textures or scalars. If there is no base color texture,
+    // then base color, metalness and roughness must be scalars (or their default values).
     const YAML::Node materialTechniquesNode = rootNode["material techniques"];
 
     BRE_CHECK_MSG(materialTechniquesNode.IsDefined(), L"'material techniques' node must be defined");
@@ -36,6 +52,13 @@ MaterialTechniqueLoader::LoadMaterialTechniques(const YAML::Node& rootNode) noex
     std::string pairFirstValue;
     std::string pairSecondValue;
     std::string materialTechniqueName;
+    std::string metalnessTextureName;
+    std::string roughnessTextureName;
+    std::string heightTextureName;
+    bool hasBaseColorTexture{ false };
+    float metalness{ 0.0f };
+    float roughness{ 0.0f };
+    float baseColor[3U];
     for (YAML::const_iterator seqIt = materialTechniquesNode.begin(); seqIt != materialTechniquesNode.end(); ++seqIt) {
         const YAML::Node materialMap = *seqIt;
         BRE_ASSERT(materialMap.IsMap());
@@ -58,37 +81,94 @@ MaterialTechniqueLoader::LoadMaterialTechniques(const YAML::Node& rootNode) noex
             BRE_CHECK_MSG(referenceRootNode.IsDefined(), errorMsg.c_str());
             BRE_CHECK_MSG(referenceRootNode["material techniques"].IsDefined(),
                           L"Reference file must have 'material techniques' field");
-            LoadMaterialTechniques(referenceRootNode);
+            AddMaterialTechniques(referenceRootNode);
 
             continue;
         }
 
         materialTechniqueName = mapIt->second.as<std::string>();
-        const std::wstring errorMsg =
-            L"Material technique name must be unique: " + StringUtils::AnsiToWideString(materialTechniqueName);
-        BRE_CHECK_MSG(mMaterialTechniqueByName.find(materialTechniqueName) == mMaterialTechniqueByName.end(),
-                      errorMsg.c_str());
+        const StringId materialTechniqueNameId = StringIdTable::Intern(materialTechniqueName);
+        BRE_CHECK_MSG(mMaterialTechniqueByName.find(materialTechniqueNameId) == mMaterialTechniqueByName.end(),
+                      (L"Material technique name must be unique: " +
+                       StringUtils::AnsiToWideString(materialTechniqueName)).c_str());
         ++mapIt;
 
         // Get material techniques settings (base color texture, normal texture, etc)
+        // Metalness, roughness and height are packed by TextureLoader in a single texture.
         MaterialTechnique materialTechnique;
+        metalnessTextureName.clear();
+        roughnessTextureName.clear();
+        heightTextureName.clear();
+        hasBaseColorTexture = false;
+        metalness = MaterialTechnique::sDefaultMetalness;
+        roughness = MaterialTechnique::sDefaultRoughness;
+        // Field names are compared by their identifier, computed at compile time
         while (mapIt != materialMap.end()) {
             pairFirstValue = mapIt->first.as<std::string>();
-            pairSecondValue = mapIt->second.as<std::string>();
-            UpdateMaterialTechnique(pairFirstValue, pairSecondValue, materialTechnique);
+            switch (StringIdTable::GetStringId(pairFirstValue)) {
+            case StringIdTable::ComputeStringId("base color"):
+                YamlUtils::GetSequence(mapIt->second, baseColor, 3U);
+                materialTechnique.SetBaseColor(DirectX::XMFLOAT3(baseColor[0U], baseColor[1U], baseColor[2U]));
+                break;
+            case StringIdTable::ComputeStringId("metalness"):
+                YamlUtils::GetScalar(mapIt->second, metalness);
+                break;
+            case StringIdTable::ComputeStringId("roughness"):
+                YamlUtils::GetScalar(mapIt->second, roughness);
+                break;
+            case StringIdTable::ComputeStringId("metalness texture"):
+                metalnessTextureName = mapIt->second.as<std::string>();
+                break;
+            case StringIdTable::ComputeStringId("roughness texture"):
+                roughnessTextureName = mapIt->second.as<std::string>();
+                break;
+            case StringIdTable::ComputeStringId("height texture"):
+                heightTextureName = mapIt->second.as<std::string>();
+                break;
+            default:
+                pairSecondValue = mapIt->second.as<std::string>();
+                if (pairFirstValue == "base color texture") {
+                    hasBaseColorTexture = true;
+                }
+                UpdateMaterialTechnique(pairFirstValue, pairSecondValue, materialTechnique);
+                break;
+            }
             ++mapIt;
         }
 
-        mMaterialTechniqueByName.insert(std::make_pair(materialTechniqueName, materialTechnique));
+        materialTechnique.SetMetalness(metalness);
+        materialTechnique.SetRoughness(roughness);
+
+        // Color techniques (without base color texture) only sample height.
+        if (hasBaseColorTexture == false) {
+            BRE_CHECK_MSG(metalnessTextureName.empty() && roughnessTextureName.empty(),
+                          (L"Material technique without base color texture must not have metalness and roughness textures: " +
+                           StringUtils::AnsiToWideString(materialTechniqueName)).c_str());
+        }
+
+        if (hasBaseColorTexture || heightTextureName.empty() == false) {
+            const std::string packedTextureName =
+                TextureLoader::GetChannelPackedTextureName(
+                    metalnessTextureName.empty() ? TextureLoader::GetConstantChannelTextureName(metalness) : metalnessTextureName,
+                    roughnessTextureName.empty() ? TextureLoader::GetConstantChannelTextureName(roughness) : roughnessTextureName,
+                    heightTextureName.empty() ? TextureLoader::GetConstantChannelTextureName(0.0f) : heightTextureName);
+            const StringId packedTextureNameId = StringIdTable::GetStringId(packedTextureName);
+            BRE_CHECK_MSG(mTextureLoader.HasTexture(packedTextureNameId),
+                          (L"Texture name not found: " + StringUtils::AnsiToWideString(packedTextureName)).c_str());
+            materialTechnique.SetMetalnessRoughnessHeightTexture(packedTextureNameId,
+                                                                 heightTextureName.empty() == false);
+        }
+
+        mMaterialTechniqueByName.insert(std::make_pair(materialTechniqueNameId, materialTechnique));
     }
 }
 
-const MaterialTechnique& MaterialTechniqueLoader::GetMaterialTechnique(const std::string& name) const noexcept
+const MaterialTechnique& MaterialTechniqueLoader::GetMaterialTechnique(const StringId nameId) const noexcept
 {
-    std::unordered_map<std::string, MaterialTechnique>::const_iterator findIt = mMaterialTechniqueByName.find(name);
-    const std::wstring errorMsg =
-        L"Material technique name not found: " + StringUtils::AnsiToWideString(name);
-    BRE_CHECK_MSG(findIt != mMaterialTechniqueByName.end(), errorMsg.c_str());
+    StringIdMap<MaterialTechnique>::const_iterator findIt = mMaterialTechniqueByName.find(nameId);
+    BRE_CHECK_MSG(findIt != mMaterialTechniqueByName.end(),
+                  (L"Material technique name not found: " +
+                   StringUtils::AnsiToWideString(StringIdTable::GetString(nameId))).c_str());
 
     return findIt->second;
 }
@@ -97,17 +177,13 @@ void MaterialTechniqueLoader::UpdateMaterialTechnique(const std::string& materia
                                                       const std::string& materialTechniqueTextureName,
                                                       MaterialTechnique& materialTechnique) const noexcept
 {
-    ID3D12Resource& texture = mTextureLoader.GetTexture(materialTechniqueTextureName);
+    const StringId textureNameId = StringIdTable::GetStringId(materialTechniqueTextureName);
+    BRE_CHECK_MSG(mTextureLoader.HasTexture(textureNameId),
+                  (L"Texture name not found: " + StringUtils::AnsiToWideString(materialTechniqueTextureName)).c_str());
     if (materialTechniquePropertyName == "base color texture") {
-        materialTechnique.SetBaseColorTexture(&texture);
-    } else if (materialTechniquePropertyName == "metalness texture") {
-        materialTechnique.SetMetalnessTexture(&texture);
-    } else if (materialTechniquePropertyName == "roughness texture") {
-        materialTechnique.SetRoughnessTexture(&texture);
+        materialTechnique.SetBaseColorTexture(textureNameId);
     } else if (materialTechniquePropertyName == "normal texture") {
-        materialTechnique.SetNormalTexture(&texture);
-    } else if (materialTechniquePropertyName == "height texture") {
-        materialTechnique.SetHeightTexture(&texture);
+        materialTechnique.SetNormalTexture(textureNameId);
     } else {
         // To avoid warning about 'conditional expression is constant'. This is the same than false
         const std::wstring errorMsg =
@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include <SceneLoader\MaterialTechnique.h>
+#include <Utils\StringId.h>
 
 namespace YAML {
 class Node;
@@ -28,15 +29,20 @@ public:
 
     ///
     /// @brief Load material techniques
+    ///
+    /// It can be called again to reload the material techniques of a modified scene file.
+    /// Material techniques of the previous load are replaced.
+    ///
     /// @param rootNode Scene YAML file root node
     ///
     void LoadMaterialTechniques(const YAML::Node& rootNode) noexcept;
 
     ///
     /// @brief Get material technique
+    /// @param nameId Material technique name identifier (see StringIdTable)
     /// @return Material technique
     ///
-    const MaterialTechnique& GetMaterialTechnique(const std::string& name) const noexcept;
+    const MaterialTechnique& GetMaterialTechnique(const StringId nameId) const noexcept;
 
     ///
     /// @brief Get default material technique
@@ -52,6 +58,12 @@ public:
     }
 
 private:
+    ///
+    /// @brief Add material techniques, following "reference" files
+    /// @param rootNode Scene YAML file root node
+    ///
+    void AddMaterialTechniques(const YAML::Node& rootNode) noexcept;
+
     ///
     /// @brief Update material technique
     /// @param materialTechniquePropertyName Material technique property name
@@ -62,7 +74,7 @@ private:
                                  const std::string& materialTechniqueTextureName,
                                  MaterialTechnique& materialTechnique) const noexcept;
 
-    std::unordered_map<std::string, MaterialTechnique> mMaterialTechniqueByName;
+    StringIdMap<MaterialTechnique> mMaterialTechniqueByName;
 
     // This is the default material technique if no 'material technique' is specified
     // for a drawable object
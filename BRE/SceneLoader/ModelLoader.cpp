@@ -1,22 +1,42 @@
 #include "ModelLoader.h"
 
-#include <d3d12.h>
-#include <vector>
+#include <chrono>
+#include <tbb/parallel_for.h>
+#include <unordered_set>
+
 #pragma warning( push )
 #pragma warning( disable : 4127)
 #include <yaml-cpp/yaml.h>
 #pragma warning( pop ) 
 
-#include <CommandListExecutor\CommandListExecutor.h>
 #include <ModelManager\Model.h>
-#include <ModelManager\ModelManager.h>
+#include <ResourceManager\StagingRingBuffer.h>
+#include <Utils\AssetRegistry.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
+namespace {
+///
+/// @brief Get the size of the buffers and meshlets of a model
+/// @param model Model
+/// @return Size in bytes
+///
+std::uint64_t
+GetModelSize(const Model& model) noexcept
+{
+    std::uint64_t modelSizeInBytes = 0UL;
+    for (const Mesh& mesh : model.GetMeshes()) {
+        modelSizeInBytes += mesh.GetVertexBufferData().mBufferView.SizeInBytes +
+            mesh.GetIndexBufferData().mBufferView.SizeInBytes +
+            mesh.GetMeshlets().size() * sizeof(MeshletBuilder::Meshlet);
+    }
+
+    return modelSizeInBytes;
+}
+}
+
 void
-ModelLoader::LoadModels(const YAML::Node& rootNode,
-                        ID3D12CommandAllocator& commandAllocator,
-                        ID3D12GraphicsCommandList& commandList) noexcept
+ModelLoader::LoadModels(const YAML::Node& rootNode) noexcept
 {
     BRE_ASSERT(rootNode.IsDefined());
 
@@ -29,38 +49,169 @@ ModelLoader::LoadModels(const YAML::Node& rootNode,
     BRE_CHECK_MSG(modelsNode.IsDefined(), L"'models' node not found");
     BRE_CHECK_MSG(modelsNode.IsMap(), L"'models' node must be a map");
 
-    std::vector<ID3D12Resource*> uploadVertexBuffers;
-    std::vector<ID3D12Resource*> uploadIndexBuffers;
-    BRE_CHECK_HR(commandList.Reset(&commandAllocator, nullptr));
+    const auto startTime = std::chrono::high_resolution_clock::now();
 
-    LoadModels(modelsNode,
-               commandAllocator,
-               commandList,
-               uploadVertexBuffers,
-               uploadIndexBuffers);
+    // Names of a previous load are replaced, but its model files are reused.
+    mModelFileByName.clear();
 
-    commandList.Close();
+    std::vector<std::pair<std::string, std::string>> modelNamesAndPaths;
+    GetModelNamesAndPathsFromMap(modelsNode, modelNamesAndPaths);
+
+    // Several names, paths or files with the same content can refer to the same model,
+    // and it must be loaded once. Models are identified by the path of the first file with their content.
+    AssetRegistry assetRegistry;
+    std::vector<std::string> referencedModelPaths;
+    referencedModelPaths.reserve(modelNamesAndPaths.size());
+    for (const std::pair<std::string, std::string>& modelNameAndPath : modelNamesAndPaths) {
+        referencedModelPaths.push_back(modelNameAndPath.second);
+    }
+    assetRegistry.RegisterFiles(referencedModelPaths);
+
+    // Model files of previous loads are not loaded again. If they were released,
+    // then they are loaded again once they are needed (see GetModel()).
+    std::vector<std::string> modelPaths;
+    std::unordered_map<std::string, std::size_t> modelIndexByPath;
+    std::size_t reusedModelCount = 0UL;
+    for (std::pair<std::string, std::string>& modelNameAndPath : modelNamesAndPaths) {
+        modelNameAndPath.second = assetRegistry.GetUniquePath(modelNameAndPath.second);
+        if (mModelFileByPath.find(modelNameAndPath.second) != mModelFileByPath.end()) {
+            reusedModelCount += modelIndexByPath.emplace(modelNameAndPath.second, modelPaths.size()).second ? 1UL : 0UL;
+            continue;
+        }
+
+        if (modelIndexByPath.emplace(modelNameAndPath.second, modelPaths.size()).second) {
+            modelPaths.push_back(modelNameAndPath.second);
+        }
+    }
 
-    CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);
+    // File reading, import and cache file generation run in parallel.
+    // Buffer creation and upload are serialized by ResourceManager and StagingRingBuffer.
+    std::vector<ModelManager::SharedModel> models(modelPaths.size());
+    std::vector<double> loadTimesInMs(modelPaths.size(), 0.0);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, modelPaths.size(), 1U),
+                      [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+            const auto modelStartTime = std::chrono::high_resolution_clock::now();
+            ModelManager::ModelHandle modelHandle;
+            Model& model = ModelManager::LoadModel(modelPaths[i].c_str(), &modelHandle);
+            models[i] = ModelManager::ShareModel(model, modelHandle);
+            const auto modelEndTime = std::chrono::high_resolution_clock::now();
+            loadTimesInMs[i] = std::chrono::duration<double, std::milli>(modelEndTime - modelStartTime).count();
+        }
+    });
+
+    // Loaded models are kept until ReleaseUnusedModels() is called, so their users can get them.
+    for (std::size_t i = 0UL; i < modelPaths.size(); ++i) {
+        LoadedModelFile& loadedModelFile = mModelFileByPath[modelPaths[i]];
+        loadedModelFile.mPath = modelPaths[i];
+        loadedModelFile.mSizeInBytes = GetModelSize(*models[i]);
+        loadedModelFile.mMeshCount = models[i]->GetMeshes().size();
+        loadedModelFile.mModel = models[i];
+        mLoadedModels.push_back(models[i]);
+    }
+
+    for (const std::pair<std::string, std::string>& modelNameAndPath : modelNamesAndPaths) {
+        mModelFileByName[StringIdTable::GetStringId(modelNameAndPath.first)] = &mModelFileByPath[modelNameAndPath.second];
+    }
+
+    StagingRingBuffer::Flush();
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+
+    for (std::size_t i = 0U; i < modelPaths.size(); ++i) {
+        const std::wstring modelTimeMsg =
+            L"Model " + StringUtils::AnsiToWideString(modelPaths[i]) + L": " +
+            std::to_wstring(loadTimesInMs[i]) + L" ms\n";
+        BRE_LOG_MSG(modelTimeMsg.c_str());
+    }
+
+    const std::wstring totalTimeMsg =
+        L"Models: " + std::to_wstring(modelPaths.size()) + L" loaded, " +
+        std::to_wstring(reusedModelCount) + L" reused in " +
+        std::to_wstring(std::chrono::duration<double, std::milli>(endTime - startTime).count()) + L" ms\n";
+    BRE_LOG_MSG(totalTimeMsg.c_str());
+
+    assetRegistry.LogStatistics(L"Model files");
 }
 
-const Model& ModelLoader::GetModel(const std::string& name) const noexcept
+ModelManager::SharedModel
+ModelLoader::GetModel(const StringId nameId) noexcept
 {
-    std::unordered_map<std::string, Model*>::const_iterator findIt = mModelByName.find(name);
-    const std::wstring errorMsg =
-        L"Model name not found: " + StringUtils::AnsiToWideString(name);
-    BRE_CHECK_MSG(findIt != mModelByName.end(), errorMsg.c_str());
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Models are loaded again while the lock is held, so they are loaded once.
+    LoadedModelFile& loadedModelFile = GetLoadedModelFile(nameId);
+    ModelManager::SharedModel model = loadedModelFile.mModel.lock();
+    if (model.get() == nullptr) {
+        ModelManager::ModelHandle modelHandle;
+        Model& loadedModel = ModelManager::LoadModel(loadedModelFile.mPath.c_str(), &modelHandle);
+        model = ModelManager::ShareModel(loadedModel, modelHandle);
+        loadedModelFile.mModel = model;
+        StagingRingBuffer::Flush();
+    }
+
+    return model;
+}
+
+std::uint64_t
+ModelLoader::GetModelSizeInBytes(const StringId nameId) const noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return GetLoadedModelFile(nameId).mSizeInBytes;
+}
+
+std::size_t
+ModelLoader::GetModelMeshCount(const StringId nameId) const noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return GetLoadedModelFile(nameId).mMeshCount;
+}
+
+std::size_t
+ModelLoader::ReleaseUnusedModels() noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Models that only the loader keeps are released now
+    std::size_t releasedModelCount = 0UL;
+    for (const ModelManager::SharedModel& model : mLoadedModels) {
+        releasedModelCount += model.use_count() == 1L ? 1UL : 0UL;
+    }
+    mLoadedModels.clear();
+
+    std::unordered_set<const LoadedModelFile*> usedModelFiles;
+    for (const StringIdMap<LoadedModelFile*>::value_type& pair : mModelFileByName) {
+        usedModelFiles.insert(pair.second);
+    }
+
+    // Models of previous loads are released once their users drop them
+    std::unordered_map<std::string, LoadedModelFile>::iterator it = mModelFileByPath.begin();
+    while (it != mModelFileByPath.end()) {
+        if (usedModelFiles.find(&it->second) == usedModelFiles.end()) {
+            releasedModelCount += it->second.mModel.expired() ? 0UL : 1UL;
+            it = mModelFileByPath.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    return releasedModelCount;
+}
+
+ModelLoader::LoadedModelFile&
+ModelLoader::GetLoadedModelFile(const StringId nameId) const noexcept
+{
+    StringIdMap<LoadedModelFile*>::const_iterator findIt = mModelFileByName.find(nameId);
+    BRE_CHECK_MSG(findIt != mModelFileByName.end(),
+                  (L"Model name not found: " + StringUtils::AnsiToWideString(StringIdTable::GetString(nameId))).c_str());
     BRE_ASSERT(findIt->second != nullptr);
 
     return *findIt->second;
 }
 
 void
-ModelLoader::LoadModels(const YAML::Node& modelsNode,
-                        ID3D12CommandAllocator& commandAllocator,
-                        ID3D12GraphicsCommandList& commandList,
-                        std::vector<ID3D12Resource*>& uploadVertexBuffers,
-                        std::vector<ID3D12Resource*>& uploadIndexBuffers) noexcept
+ModelLoader::GetModelNamesAndPathsFromMap(const YAML::Node& modelsNode,
+                                          std::vector<std::pair<std::string, std::string>>& modelNamesAndPaths) noexcept
 {
     BRE_CHECK_MSG(modelsNode.IsMap(), L"'models' node must be a map");
 
@@ -77,25 +228,13 @@ ModelLoader::LoadModels(const YAML::Node& modelsNode,
                 L"Failed to open yaml file: " + StringUtils::AnsiToWideString(path);
             BRE_CHECK_MSG(referenceRootNode.IsDefined(), errorMsg.c_str());
             const YAML::Node referenceModelsNode = referenceRootNode["models"];
-            LoadModels(referenceModelsNode,
-                       commandAllocator,
-                       commandList,
-                       uploadVertexBuffers,
-                       uploadIndexBuffers);
+            GetModelNamesAndPathsFromMap(referenceModelsNode, modelNamesAndPaths);
         } else {
-            const std::wstring errorMsg =
-                L"Model name must be unique: " + StringUtils::AnsiToWideString(name);
-            BRE_CHECK_MSG(mModelByName.find(name) == mModelByName.end(), errorMsg.c_str());
-
-            uploadVertexBuffers.resize(uploadVertexBuffers.size() + 1);
-            uploadIndexBuffers.resize(uploadIndexBuffers.size() + 1);
-
-            Model& model = ModelManager::LoadModel(path.c_str(),
-                                                   commandList,
-                                                   uploadVertexBuffers.back(),
-                                                   uploadIndexBuffers.back());
+            // The model is set once every model is loaded.
+            BRE_CHECK_MSG(mModelFileByName.emplace(StringIdTable::Intern(name), nullptr).second,
+                          (L"Model name must be unique: " + StringUtils::AnsiToWideString(name)).c_str());
 
-            mModelByName[name] = &model;
+            modelNamesAndPaths.emplace_back(name, path);
         }
     }
 }
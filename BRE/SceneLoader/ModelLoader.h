@@ -1,19 +1,20 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#include <ModelManager\ModelManager.h>
+#include <Utils\StringId.h>
 
 namespace YAML {
 class Node;
 }
 
-struct ID3D12CommandAllocator;
-struct ID3D12GraphicsCommandList;
-struct ID3D12Resource;
-
 namespace BRE {
-class Model;
-
 ///
 /// @brief Responsible to load from scene file the models configurations
 ///
@@ -28,42 +29,92 @@ public:
 
     ///
     /// @brief Load models
+    ///
+    /// Models are loaded in parallel, and each model file is loaded once,
+    /// even if several names, paths or files with the same content refer to it (see AssetRegistry). Load time of each model is logged.
+    /// Models buffers are uploaded through StagingRingBuffer, and it
+    /// is flushed before returning.
+    /// It can be called again to reload the models of a modified scene file. Model names
+    /// are replaced, and model files that were already loaded are reused, even if they were released.
+    /// Models are reference counted. The loader keeps the models it loads until ReleaseUnusedModels()
+    /// is called, and then they are released once every user drops them (see ModelManager::ShareModel()).
+    /// GetModel() must not be called at the same time.
+    ///
     /// @param rootNode Scene YAML file root node
-    /// @param commandAllocator Command allocator for the command list to load models
-    /// @param commandList Command list to load models
     ///
-    void LoadModels(const YAML::Node& rootNode,
-                    ID3D12CommandAllocator& commandAllocator,
-                    ID3D12GraphicsCommandList& commandList) noexcept;
+    void LoadModels(const YAML::Node& rootNode) noexcept;
 
     ///
     /// @brief Get model
-    /// @param name Model name
-    /// @return Model
     ///
-    const Model& GetModel(const std::string& name) const noexcept;
+    /// If the model was released, then it is loaded again from its file, and
+    /// StagingRingBuffer is flushed. Loads are serialized.
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param nameId Model name identifier (see StringIdTable)
+    /// @return Reference counted model
+    ///
+    ModelManager::SharedModel GetModel(const StringId nameId) noexcept;
+
+    ///
+    /// @brief Get model size. It is known even if the model was released.
+    /// @param nameId Model name identifier (see StringIdTable)
+    /// @return Size in bytes of the vertex buffers, index buffers and meshlets of the model
+    ///
+    std::uint64_t GetModelSizeInBytes(const StringId nameId) const noexcept;
+
+    ///
+    /// @brief Get the number of meshes of a model. It is known even if the model was released.
+    /// @param nameId Model name identifier (see StringIdTable)
+    /// @return Number of meshes
+    ///
+    std::size_t GetModelMeshCount(const StringId nameId) const noexcept;
+
+    ///
+    /// @brief Stops keeping the loaded models, and forgets the model files of previous loads
+    /// that the loaded model names do not refer to
+    ///
+    /// Models are released once every user drops them too, and the ones that are
+    /// needed again are loaded again (see GetModel()).
+    ///
+    /// @return Number of released models
+    ///
+    std::size_t ReleaseUnusedModels() noexcept;
 
 private:
     ///
-    /// @brief Load models
+    /// @brief Model file that was loaded, and its model while it is not released
+    ///
+    struct LoadedModelFile {
+        std::string mPath;
+        std::uint64_t mSizeInBytes{ 0UL };
+        std::size_t mMeshCount{ 0UL };
+        std::weak_ptr<Model> mModel;
+    };
+
+    ///
+    /// @brief Get the loaded model file of a model name
+    /// @param nameId Model name identifier (see StringIdTable)
+    /// @return Loaded model file
+    ///
+    LoadedModelFile& GetLoadedModelFile(const StringId nameId) const noexcept;
+
+    ///
+    /// @brief Get model names and paths from the "models" map, following "reference" files.
     /// @param modelsNode YAML Node representing the "models" field. It must be a map.
-    /// @param commandAllocator Command allocator for the command list to load textures
-    /// @param commandList Command list to load the textures
-    /// @param uploadVertexBuffer Upload buffer to upload the buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadVertexBuffer after it knows the copy has been executed.
-    /// @param uploadIndexBuffers Upload buffer to upload the buffer content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadIndexBuffers after it knows the copy has been executed.
-    ///
-    void LoadModels(const YAML::Node& modelsNode,
-                    ID3D12CommandAllocator& commandAllocator,
-                    ID3D12GraphicsCommandList& commandList,
-                    std::vector<ID3D12Resource*>& uploadVertexBuffers,
-                    std::vector<ID3D12Resource*>& uploadIndexBuffers) noexcept;
-
-    std::unordered_map<std::string, Model*> mModelByName;
+    /// @param modelNamesAndPaths Output list of model names and paths
+    ///
+    void GetModelNamesAndPathsFromMap(const YAML::Node& modelsNode,
+                                      std::vector<std::pair<std::string, std::string>>& modelNamesAndPaths) noexcept;
+
+    StringIdMap<LoadedModelFile*> mModelFileByName;
+
+    // Every model file loaded by this loader, by unique path
+    std::unordered_map<std::string, LoadedModelFile> mModelFileByPath;
+
+    // Models of the last load, kept until ReleaseUnusedModels() is called
+    std::vector<ModelManager::SharedModel> mLoadedModels;
+
+    mutable std::mutex mMutex;
 };
 }
\ No newline at end of file
@@ -0,0 +1,1156 @@
+#include "SceneCooker.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <unordered_map>
+#include <unordered_set>
+
+#pragma warning( push )
+#pragma warning( disable : 4127)
+#include <yaml-cpp/emitfromevents.h>
+#include <yaml-cpp/yaml.h>
+#pragma warning( pop )
+
+#include <MathUtils\MathUtils.h>
+#include <SceneLoader\CompiledScene.h>
+#include <SceneLoader\YamlUtils.h>
+#include <Utils\DebugUtils.h>
+#include <Utils\HashUtils.h>
+#include <Utils\MemoryMappedFile.h>
+#include <Utils\StringUtils.h>
+
+namespace BRE {
+namespace {
+const char* sCacheDirectory{ "scene_cache" };
+const char* sCacheFileExtension{ ".brescene" };
+
+///
+/// @brief Parsed YAML file
+///
+struct YamlFile {
+    // Every field but "drawable objects"
+    YAML::Node mRootNode;
+
+    // Drawables of "drawable objects" field, with "reference" files included.
+    std::vector<CompiledScene::Drawable> mDrawables;
+    std::vector<CompiledScene::InstanceArray> mInstanceArrays;
+    bool mHasDrawableObjects{ false };
+};
+
+///
+/// @brief Data that is collected while a scene is cooked
+///
+struct CookContext {
+    // Interned strings
+    std::string mStringData;
+    std::vector<CompiledScene::StringEntry> mStringEntries;
+    std::unordered_map<std::string, std::uint32_t> mStringIndexByString;
+
+    std::vector<CompiledScene::Dependency> mDependencies;
+
+    // Each YAML file is parsed once, even if it is included several times.
+    std::unordered_map<std::string, YamlFile> mYamlFileByFilePath;
+
+    // String indices of model and material technique names, by their index.
+    std::vector<std::uint32_t> mModelNames;
+    std::unordered_map<std::uint32_t, std::uint32_t> mModelIndexByStringIndex;
+    std::vector<std::uint32_t> mMaterialTechniqueNames;
+    std::unordered_map<std::uint32_t, std::uint32_t> mMaterialTechniqueIndexByStringIndex;
+
+    // Tables that instance arrays refer to
+    std::vector<std::uint32_t> mInstanceArrayMaterialTechniques;
+    std::vector<DirectX::XMFLOAT3> mPathPoints;
+};
+
+///
+/// @brief Aligns an offset
+/// @param offset Offset to align
+/// @param alignment Alignment. Must be a power of two.
+/// @return Aligned offset
+///
+std::uint64_t
+AlignOffset(const std::uint64_t offset,
+            const std::uint64_t alignment) noexcept
+{
+    return (offset + alignment - 1UL) & ~(alignment - 1UL);
+}
+
+///
+/// @brief Interns a string
+/// @param string String
+/// @param context Cook context
+/// @return String index
+///
+std::uint32_t
+InternString(const std::string& string,
+             CookContext& context) noexcept
+{
+    const std::pair<std::unordered_map<std::string, std::uint32_t>::iterator, bool> insertResult =
+        context.mStringIndexByString.emplace(string, static_cast<std::uint32_t>(context.mStringEntries.size()));
+    if (insertResult.second) {
+        CompiledScene::StringEntry stringEntry;
+        stringEntry.mOffset = static_cast<std::uint32_t>(context.mStringData.size());
+        stringEntry.mLength = static_cast<std::uint32_t>(string.size());
+        context.mStringEntries.push_back(stringEntry);
+        context.mStringData.append(string.c_str(), string.size() + 1U);
+    }
+
+    return insertResult.first->second;
+}
+
+///
+/// @brief Get the index of a name in a names table, adding it if it is not there
+/// @param name Name
+/// @param context Cook context
+/// @param names Names table (string indices)
+/// @param nameIndexByStringIndex Index in the names table by string index
+/// @return Name index
+///
+std::uint32_t
+GetNameIndex(const std::string& name,
+             CookContext& context,
+             std::vector<std::uint32_t>& names,
+             std::unordered_map<std::uint32_t, std::uint32_t>& nameIndexByStringIndex) noexcept
+{
+    const std::uint32_t stringIndex = InternString(name, context);
+    const std::pair<std::unordered_map<std::uint32_t, std::uint32_t>::iterator, bool> insertResult =
+        nameIndexByStringIndex.emplace(stringIndex, static_cast<std::uint32_t>(names.size()));
+    if (insertResult.second) {
+        names.push_back(stringIndex);
+    }
+
+    return insertResult.first->second;
+}
+
+///
+/// @brief Read only stream buffer over memory, so YAML files are parsed without copying them
+///
+class MemoryStreamBuffer : public std::streambuf {
+public:
+    MemoryStreamBuffer(const std::uint8_t* data,
+                       const std::size_t dataSize) noexcept
+    {
+        char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+        setg(begin, begin, begin + dataSize);
+    }
+};
+
+const YamlFile&
+ParseYamlFile(const std::string& filePath,
+              CookContext& context) noexcept;
+
+///
+/// @brief Handles the events of the YAML parser of a scene file.
+///
+/// Drawable objects are cooked while they are parsed, without building YAML nodes,
+/// so the biggest part of a scene file is never stored as a node tree.
+/// Every other field is sent to an emitter, to build its nodes later.
+///
+class SceneEventHandler : public YAML::EventHandler {
+public:
+    SceneEventHandler(const std::string& filePath,
+                      CookContext& context,
+                      YamlFile& yamlFile,
+                      YAML::Emitter& assetsEmitter) noexcept
+        : mFilePath(filePath)
+        , mContext(context)
+        , mYamlFile(yamlFile)
+        , mAssetsEventHandler(assetsEmitter)
+    {}
+
+    void OnDocumentStart(const YAML::Mark& mark) noexcept final override
+    {
+        mAssetsEventHandler.OnDocumentStart(mark);
+    }
+
+    void OnDocumentEnd() noexcept final override
+    {
+        mAssetsEventHandler.OnDocumentEnd();
+    }
+
+    void OnNull(const YAML::Mark& mark,
+                YAML::anchor_t anchor) noexcept final override
+    {
+        if (mState == State::ASSET_FIELD_VALUE) {
+            mAssetsEventHandler.OnNull(mark, anchor);
+            EndAssetFieldValue();
+        } else if (mState == State::INSTANCE_ARRAY) {
+            mInstanceArrayEventHandler->OnNull(mark, anchor);
+        } else {
+            CheckSyntax(false, L"Unexpected null value in drawable objects", mark);
+        }
+    }
+
+    void OnAlias(const YAML::Mark& mark,
+                 YAML::anchor_t anchor) noexcept final override
+    {
+        if (mState == State::ASSET_FIELD_VALUE) {
+            mAssetsEventHandler.OnAlias(mark, anchor);
+            EndAssetFieldValue();
+        } else if (mState == State::INSTANCE_ARRAY) {
+            mInstanceArrayEventHandler->OnAlias(mark, anchor);
+        } else {
+            CheckSyntax(false, L"Aliases are not supported in drawable objects", mark);
+        }
+    }
+
+    void OnScalar(const YAML::Mark& mark,
+                  const std::string& tag,
+                  YAML::anchor_t anchor,
+                  const std::string& value) noexcept final override;
+
+    void OnSequenceStart(const YAML::Mark& mark,
+                         const std::string& tag,
+                         YAML::anchor_t anchor,
+                         YAML::EmitterStyle::value style) noexcept final override;
+
+    void OnSequenceEnd() noexcept final override;
+
+    void OnMapStart(const YAML::Mark& mark,
+                    const std::string& tag,
+                    YAML::anchor_t anchor,
+                    YAML::EmitterStyle::value style) noexcept final override;
+
+    void OnMapEnd() noexcept final override;
+
+private:
+    enum class State {
+        ROOT,
+        ROOT_FIELD_NAME,
+        ASSET_FIELD_VALUE,
+        DRAWABLE_OBJECTS,
+        DRAWABLE_OBJECTS_SEQUENCE,
+        DRAWABLE_OBJECT_FIELD_NAME,
+        DRAWABLE_OBJECT_FIELD_VALUE,
+        DRAWABLE_OBJECT_VECTOR,
+        INSTANCE_ARRAY,
+        END
+    };
+
+    enum class DrawableObjectField {
+        MODEL,
+        MATERIAL_TECHNIQUE,
+        TRANSLATION,
+        ROTATION,
+        SCALE,
+        TEXTURE_SCALE,
+        REFERENCE,
+        INSTANCE_ARRAY
+    };
+
+    ///
+    /// @brief Checks the scene syntax. The error message is built only if the check fails.
+    /// @param condition Condition
+    /// @param message Error message. Must not be nullptr.
+    /// @param mark Location of the event
+    ///
+    void CheckSyntax(const bool condition,
+                     const wchar_t* message,
+                     const YAML::Mark& mark) const noexcept
+    {
+        BRE_CHECK_MSG(condition,
+                      (message + (L" (" + StringUtils::AnsiToWideString(mFilePath) + L", line " +
+                                  std::to_wstring(mark.line + 1) + L")")).c_str());
+    }
+
+    ///
+    /// @brief Converts a scalar to float
+    /// @param mark Location of the scalar
+    /// @param value Scalar
+    /// @param floatValue Output float
+    ///
+    void GetFloat(const YAML::Mark& mark,
+                  const std::string& value,
+                  float& floatValue) const noexcept
+    {
+        CheckSyntax(StringUtils::StringToFloat(value.data(), value.data() + value.size(), floatValue),
+                    L"Invalid number",
+                    mark);
+    }
+
+    ///
+    /// @brief Goes back to the root map, if the asset field value is complete.
+    ///
+    void EndAssetFieldValue() noexcept
+    {
+        if (mAssetFieldDepth == 0U) {
+            mState = State::ROOT_FIELD_NAME;
+        }
+    }
+
+    void BeginDrawableObject(const YAML::Mark& mark) noexcept;
+    void SetDrawableObjectFieldName(const YAML::Mark& mark,
+                                    const std::string& fieldName) noexcept;
+    void SetDrawableObjectFieldValue(const YAML::Mark& mark,
+                                     const std::string& value) noexcept;
+    void EndDrawableObject() noexcept;
+    void CookInstanceArray(const YAML::Node& instanceArrayNode,
+                           CompiledScene::InstanceArray& instanceArray) noexcept;
+    void GetInstanceArrayVector(const YAML::Node& vectorNode,
+                                const char* fieldName,
+                                float* const vector,
+                                const std::uint32_t vectorSize) const noexcept;
+
+    const std::string& mFilePath;
+    CookContext& mContext;
+    YamlFile& mYamlFile;
+    YAML::EmitFromEvents mAssetsEventHandler;
+
+    State mState{ State::ROOT };
+
+    // Number of collections that are open in the current asset field value
+    std::uint32_t mAssetFieldDepth{ 0U };
+
+    // Current drawable object
+    YAML::Mark mDrawableObjectMark;
+    DrawableObjectField mDrawableObjectField{ DrawableObjectField::MODEL };
+    CompiledScene::Drawable mDrawable;
+    bool mHasModel{ false };
+    bool mIsReference{ false };
+    std::string mReferenceFilePath;
+    float mTranslation[3U];
+    float mRotation[3U];
+    float mScale[3U];
+    float* mVector{ nullptr };
+    std::uint32_t mVectorSize{ 0U };
+
+    // Current instance array. Its events are sent to an emitter, and it is cooked
+    // from its nodes, because it has a few fields.
+    bool mIsInstanceArray{ false };
+    std::unique_ptr<YAML::Emitter> mInstanceArrayEmitter;
+    std::unique_ptr<YAML::EmitFromEvents> mInstanceArrayEventHandler;
+
+    // Number of collections that are open in the current instance array
+    std::uint32_t mInstanceArrayDepth{ 0U };
+};
+
+void
+SceneEventHandler::OnScalar(const YAML::Mark& mark,
+                            const std::string& tag,
+                            YAML::anchor_t anchor,
+                            const std::string& value) noexcept
+{
+    switch (mState) {
+    case State::ROOT_FIELD_NAME:
+        if (value == "drawable objects") {
+            CheckSyntax(mYamlFile.mHasDrawableObjects == false,
+                        L"'drawable objects' field must be defined once",
+                        mark);
+            mState = State::DRAWABLE_OBJECTS;
+        } else {
+            mAssetsEventHandler.OnScalar(mark, tag, anchor, value);
+            mState = State::ASSET_FIELD_VALUE;
+        }
+        break;
+    case State::ASSET_FIELD_VALUE:
+        mAssetsEventHandler.OnScalar(mark, tag, anchor, value);
+        EndAssetFieldValue();
+        break;
+    case State::DRAWABLE_OBJECT_FIELD_NAME:
+        SetDrawableObjectFieldName(mark, value);
+        break;
+    case State::DRAWABLE_OBJECT_FIELD_VALUE:
+        SetDrawableObjectFieldValue(mark, value);
+        break;
+    case State::DRAWABLE_OBJECT_VECTOR:
+        CheckSyntax(mVectorSize < 3U, L"Drawable object vectors must have 3 elements", mark);
+        GetFloat(mark, value, mVector[mVectorSize]);
+        ++mVectorSize;
+        break;
+    case State::INSTANCE_ARRAY:
+        mInstanceArrayEventHandler->OnScalar(mark, tag, anchor, value);
+        break;
+    case State::ROOT:
+        CheckSyntax(false, L"Scene file root node must be a map", mark);
+        break;
+    default:
+        CheckSyntax(false, L"'drawable objects' node must be a sequence of maps", mark);
+        break;
+    }
+}
+
+void
+SceneEventHandler::OnSequenceStart(const YAML::Mark& mark,
+                                   const std::string& tag,
+                                   YAML::anchor_t anchor,
+                                   YAML::EmitterStyle::value style) noexcept
+{
+    switch (mState) {
+    case State::ASSET_FIELD_VALUE:
+        mAssetsEventHandler.OnSequenceStart(mark, tag, anchor, style);
+        ++mAssetFieldDepth;
+        break;
+    case State::DRAWABLE_OBJECTS:
+        mYamlFile.mHasDrawableObjects = true;
+        mState = State::DRAWABLE_OBJECTS_SEQUENCE;
+        break;
+    case State::DRAWABLE_OBJECT_FIELD_VALUE:
+        CheckSyntax(mDrawableObjectField != DrawableObjectField::INSTANCE_ARRAY, L"'instance array' field must be a map", mark);
+        CheckSyntax(mVector != nullptr, L"Drawable object field must be a scalar", mark);
+        mVectorSize = 0U;
+        mState = State::DRAWABLE_OBJECT_VECTOR;
+        break;
+    case State::INSTANCE_ARRAY:
+        mInstanceArrayEventHandler->OnSequenceStart(mark, tag, anchor, style);
+        ++mInstanceArrayDepth;
+        break;
+    case State::ROOT:
+        CheckSyntax(false, L"Scene file root node must be a map", mark);
+        break;
+    case State::ROOT_FIELD_NAME:
+        CheckSyntax(false, L"Scene file field names must be scalars", mark);
+        break;
+    default:
+        CheckSyntax(false, L"'drawable objects' node must be a sequence of maps", mark);
+        break;
+    }
+}
+
+void
+SceneEventHandler::OnSequenceEnd() noexcept
+{
+    switch (mState) {
+    case State::ASSET_FIELD_VALUE:
+        mAssetsEventHandler.OnSequenceEnd();
+        --mAssetFieldDepth;
+        EndAssetFieldValue();
+        break;
+    case State::DRAWABLE_OBJECTS_SEQUENCE:
+        mState = State::ROOT_FIELD_NAME;
+        break;
+    case State::INSTANCE_ARRAY:
+        mInstanceArrayEventHandler->OnSequenceEnd();
+        --mInstanceArrayDepth;
+        break;
+    default:
+        BRE_ASSERT(mState == State::DRAWABLE_OBJECT_VECTOR);
+        CheckSyntax(mVectorSize == 3U, L"Drawable object vectors must have 3 elements", mDrawableObjectMark);
+        mState = State::DRAWABLE_OBJECT_FIELD_NAME;
+        break;
+    }
+}
+
+void
+SceneEventHandler::OnMapStart(const YAML::Mark& mark,
+                              const std::string& tag,
+                              YAML::anchor_t anchor,
+                              YAML::EmitterStyle::value style) noexcept
+{
+    switch (mState) {
+    case State::ROOT:
+        mAssetsEventHandler.OnMapStart(mark, tag, anchor, style);
+        mState = State::ROOT_FIELD_NAME;
+        break;
+    case State::ASSET_FIELD_VALUE:
+        mAssetsEventHandler.OnMapStart(mark, tag, anchor, style);
+        ++mAssetFieldDepth;
+        break;
+    case State::DRAWABLE_OBJECTS_SEQUENCE:
+        BeginDrawableObject(mark);
+        break;
+    case State::DRAWABLE_OBJECT_FIELD_VALUE:
+        CheckSyntax(mDrawableObjectField == DrawableObjectField::INSTANCE_ARRAY,
+                    L"Drawable object field must be a scalar or a sequence",
+                    mark);
+        mInstanceArrayEmitter.reset(new YAML::Emitter());
+        mInstanceArrayEventHandler.reset(new YAML::EmitFromEvents(*mInstanceArrayEmitter));
+        mInstanceArrayEventHandler->OnMapStart(mark, tag, anchor, style);
+        mInstanceArrayDepth = 1U;
+        mState = State::INSTANCE_ARRAY;
+        break;
+    case State::INSTANCE_ARRAY:
+        mInstanceArrayEventHandler->OnMapStart(mark, tag, anchor, style);
+        ++mInstanceArrayDepth;
+        break;
+    case State::ROOT_FIELD_NAME:
+        CheckSyntax(false, L"Scene file field names must be scalars", mark);
+        break;
+    default:
+        CheckSyntax(false, L"'drawable objects' node must be a sequence of maps", mark);
+        break;
+    }
+}
+
+void
+SceneEventHandler::OnMapEnd() noexcept
+{
+    switch (mState) {
+    case State::ROOT_FIELD_NAME:
+        mAssetsEventHandler.OnMapEnd();
+        mState = State::END;
+        break;
+    case State::ASSET_FIELD_VALUE:
+        mAssetsEventHandler.OnMapEnd();
+        --mAssetFieldDepth;
+        EndAssetFieldValue();
+        break;
+    case State::INSTANCE_ARRAY:
+        mInstanceArrayEventHandler->OnMapEnd();
+        --mInstanceArrayDepth;
+        if (mInstanceArrayDepth == 0U) {
+            mIsInstanceArray = true;
+            mState = State::DRAWABLE_OBJECT_FIELD_NAME;
+        }
+        break;
+    default:
+        BRE_ASSERT(mState == State::DRAWABLE_OBJECT_FIELD_NAME);
+        EndDrawableObject();
+        mState = State::DRAWABLE_OBJECTS_SEQUENCE;
+        break;
+    }
+}
+
+void
+SceneEventHandler::BeginDrawableObject(const YAML::Mark& mark) noexcept
+{
+    mDrawableObjectMark = mark;
+    mDrawable = CompiledScene::Drawable();
+    mHasModel = false;
+    mIsReference = false;
+    mIsInstanceArray = false;
+    mTranslation[0] = mTranslation[1] = mTranslation[2] = 0.0f;
+    mRotation[0] = mRotation[1] = mRotation[2] = 0.0f;
+    mScale[0] = mScale[1] = mScale[2] = 1.0f;
+    mState = State::DRAWABLE_OBJECT_FIELD_NAME;
+}
+
+void
+SceneEventHandler::SetDrawableObjectFieldName(const YAML::Mark& mark,
+                                              const std::string& fieldName) noexcept
+{
+    // "reference" and "instance array" drawable objects have no other fields.
+    CheckSyntax(mIsReference == false, L"'reference' must be the only field of its drawable object", mark);
+    CheckSyntax(mIsInstanceArray == false, L"'instance array' must be the only field of its drawable object", mark);
+
+    mVector = nullptr;
+    if (fieldName == "model") {
+        mDrawableObjectField = DrawableObjectField::MODEL;
+    } else if (fieldName == "material technique") {
+        mDrawableObjectField = DrawableObjectField::MATERIAL_TECHNIQUE;
+    } else if (fieldName == "translation") {
+        mDrawableObjectField = DrawableObjectField::TRANSLATION;
+        mVector = mTranslation;
+    } else if (fieldName == "rotation") {
+        mDrawableObjectField = DrawableObjectField::ROTATION;
+        mVector = mRotation;
+    } else if (fieldName == "scale") {
+        mDrawableObjectField = DrawableObjectField::SCALE;
+        mVector = mScale;
+    } else if (fieldName == "texture scale") {
+        mDrawableObjectField = DrawableObjectField::TEXTURE_SCALE;
+    } else if (fieldName == "reference") {
+        CheckSyntax(mHasModel == false &&
+                    mDrawable.mMaterialTechniqueIndex == CompiledScene::sDefaultMaterialTechniqueIndex,
+                    L"'reference' must be the only field of its drawable object",
+                    mark);
+        mDrawableObjectField = DrawableObjectField::REFERENCE;
+    } else if (fieldName == "instance array") {
+        CheckSyntax(mHasModel == false &&
+                    mDrawable.mMaterialTechniqueIndex == CompiledScene::sDefaultMaterialTechniqueIndex,
+                    L"'instance array' must be the only field of its drawable object",
+                    mark);
+        mDrawableObjectField = DrawableObjectField::INSTANCE_ARRAY;
+    } else {
+        CheckSyntax(false,
+                    (L"Unknown drawable object field: " + StringUtils::AnsiToWideString(fieldName)).c_str(),
+                    mark);
+    }
+
+    mState = State::DRAWABLE_OBJECT_FIELD_VALUE;
+}
+
+void
+SceneEventHandler::SetDrawableObjectFieldValue(const YAML::Mark& mark,
+                                               const std::string& value) noexcept
+{
+    switch (mDrawableObjectField) {
+    case DrawableObjectField::MODEL:
+        CheckSyntax(mHasModel == false, L"Drawable object model must be set once", mark);
+        mDrawable.mModelIndex = GetNameIndex(value,
+                                             mContext,
+                                             mContext.mModelNames,
+                                             mContext.mModelIndexByStringIndex);
+        mHasModel = true;
+        break;
+    case DrawableObjectField::MATERIAL_TECHNIQUE:
+        CheckSyntax(mDrawable.mMaterialTechniqueIndex == CompiledScene::sDefaultMaterialTechniqueIndex,
+                    L"Drawable object material technique must be set once",
+                    mark);
+        mDrawable.mMaterialTechniqueIndex = GetNameIndex(value,
+                                                         mContext,
+                                                         mContext.mMaterialTechniqueNames,
+                                                         mContext.mMaterialTechniqueIndexByStringIndex);
+        break;
+    case DrawableObjectField::TEXTURE_SCALE:
+        GetFloat(mark, value, mDrawable.mTextureScale);
+        break;
+    case DrawableObjectField::REFERENCE:
+        mReferenceFilePath = value;
+        mIsReference = true;
+        break;
+    case DrawableObjectField::INSTANCE_ARRAY:
+        CheckSyntax(false, L"'instance array' field must be a map", mark);
+        break;
+    default:
+        CheckSyntax(false, L"Drawable object field must be a sequence", mark);
+        break;
+    }
+
+    mState = State::DRAWABLE_OBJECT_FIELD_NAME;
+}
+
+void
+SceneEventHandler::EndDrawableObject() noexcept
+{
+    if (mIsReference) {
+        const YamlFile& referenceYamlFile = ParseYamlFile(mReferenceFilePath, mContext);
+        BRE_CHECK_MSG(referenceYamlFile.mHasDrawableObjects,
+                      (L"Reference file must have 'drawable objects' field: " +
+                       StringUtils::AnsiToWideString(mReferenceFilePath)).c_str());
+        mYamlFile.mDrawables.insert(mYamlFile.mDrawables.end(),
+                                    referenceYamlFile.mDrawables.begin(),
+                                    referenceYamlFile.mDrawables.end());
+        mYamlFile.mInstanceArrays.insert(mYamlFile.mInstanceArrays.end(),
+                                         referenceYamlFile.mInstanceArrays.begin(),
+                                         referenceYamlFile.mInstanceArrays.end());
+        return;
+    }
+
+    if (mIsInstanceArray) {
+        CheckSyntax(mInstanceArrayEmitter->good(), L"Failed to parse instance array", mDrawableObjectMark);
+        CompiledScene::InstanceArray instanceArray;
+        CookInstanceArray(YAML::Load(mInstanceArrayEmitter->c_str()), instanceArray);
+        mYamlFile.mInstanceArrays.push_back(instanceArray);
+        return;
+    }
+
+    CheckSyntax(mHasModel, L"'model' field was not present in current drawable object", mDrawableObjectMark);
+
+    MathUtils::ComputeMatrix(mDrawable.mWorldMatrix,
+                             mTranslation[0],
+                             mTranslation[1],
+                             mTranslation[2],
+                             mScale[0],
+                             mScale[1],
+                             mScale[2],
+                             mRotation[0],
+                             mRotation[1],
+                             mRotation[2]);
+
+    mYamlFile.mDrawables.push_back(mDrawable);
+}
+
+void
+SceneEventHandler::CookInstanceArray(const YAML::Node& instanceArrayNode,
+                                     CompiledScene::InstanceArray& instanceArray) noexcept
+{
+    BRE_ASSERT(instanceArrayNode.IsMap());
+
+    bool hasModel = false;
+    bool hasPlacement = false;
+    bool hasCount = false;
+    bool hasVolume = false;
+    bool hasPath = false;
+    bool hasSpacing = false;
+    YAML::Node countNode;
+    std::string fieldName;
+    for (YAML::const_iterator it = instanceArrayNode.begin(); it != instanceArrayNode.end(); ++it) {
+        fieldName = it->first.as<std::string>();
+        const YAML::Node valueNode = it->second;
+        if (fieldName == "model") {
+            CheckSyntax(valueNode.IsScalar(), L"Instance array 'model' field must be a scalar", mDrawableObjectMark);
+            instanceArray.mModelIndex = GetNameIndex(valueNode.Scalar(),
+                                                     mContext,
+                                                     mContext.mModelNames,
+                                                     mContext.mModelIndexByStringIndex);
+            hasModel = true;
+        } else if (fieldName == "material techniques") {
+            CheckSyntax(valueNode.IsSequence() && valueNode.size() > 0U,
+                        L"Instance array 'material techniques' field must be a sequence of names",
+                        mDrawableObjectMark);
+            instanceArray.mFirstMaterialTechnique = static_cast<std::uint32_t>(mContext.mInstanceArrayMaterialTechniques.size());
+            instanceArray.mMaterialTechniqueCount = static_cast<std::uint32_t>(valueNode.size());
+            for (const YAML::Node& nameNode : valueNode) {
+                CheckSyntax(nameNode.IsScalar(),
+                            L"Instance array 'material techniques' field must be a sequence of names",
+                            mDrawableObjectMark);
+                mContext.mInstanceArrayMaterialTechniques.push_back(
+                    GetNameIndex(nameNode.Scalar(),
+                                 mContext,
+                                 mContext.mMaterialTechniqueNames,
+                                 mContext.mMaterialTechniqueIndexByStringIndex));
+            }
+        } else if (fieldName == "placement") {
+            const std::string placement = valueNode.IsScalar() ? valueNode.Scalar() : std::string();
+            if (placement == "grid") {
+                instanceArray.mPlacement = CompiledScene::GRID;
+            } else if (placement == "random") {
+                instanceArray.mPlacement = CompiledScene::RANDOM;
+            } else {
+                CheckSyntax(placement == "path",
+                            L"Instance array 'placement' field must be 'grid', 'random' or 'path'",
+                            mDrawableObjectMark);
+                instanceArray.mPlacement = CompiledScene::PATH;
+            }
+            hasPlacement = true;
+        } else if (fieldName == "count") {
+            // It depends on the placement, that can be after it.
+            countNode = valueNode;
+            hasCount = true;
+        } else if (fieldName == "seed") {
+            CheckSyntax(valueNode.IsScalar(), L"Instance array 'seed' field must be a scalar", mDrawableObjectMark);
+            instanceArray.mSeed = valueNode.as<std::uint32_t>();
+        } else if (fieldName == "spacing") {
+            GetInstanceArrayVector(valueNode, "spacing", instanceArray.mSpacing, 3U);
+            hasSpacing = true;
+        } else if (fieldName == "volume min") {
+            GetInstanceArrayVector(valueNode, "volume min", instanceArray.mVolumeMin, 3U);
+            hasVolume = true;
+        } else if (fieldName == "volume max") {
+            GetInstanceArrayVector(valueNode, "volume max", instanceArray.mVolumeMax, 3U);
+            hasVolume = true;
+        } else if (fieldName == "path") {
+            CheckSyntax(valueNode.IsSequence() && valueNode.size() > 0U,
+                        L"Instance array 'path' field must be a sequence of points",
+                        mDrawableObjectMark);
+            instanceArray.mFirstPathPoint = static_cast<std::uint32_t>(mContext.mPathPoints.size());
+            instanceArray.mPathPointCount = static_cast<std::uint32_t>(valueNode.size());
+            for (const YAML::Node& pointNode : valueNode) {
+                DirectX::XMFLOAT3 point;
+                GetInstanceArrayVector(pointNode, "path", &point.x, 3U);
+                mContext.mPathPoints.push_back(point);
+            }
+            hasPath = true;
+        } else if (fieldName == "translation") {
+            GetInstanceArrayVector(valueNode, "translation", instanceArray.mTranslation, 3U);
+        } else if (fieldName == "rotation") {
+            GetInstanceArrayVector(valueNode, "rotation", instanceArray.mRotation, 3U);
+        } else if (fieldName == "rotation range") {
+            GetInstanceArrayVector(valueNode, "rotation range", instanceArray.mRotationRange, 3U);
+        } else if (fieldName == "scale") {
+            GetInstanceArrayVector(valueNode, "scale", instanceArray.mScale, 3U);
+        } else if (fieldName == "scale range") {
+            GetInstanceArrayVector(valueNode, "scale range", instanceArray.mScaleRange, 2U);
+        } else if (fieldName == "texture scale") {
+            CheckSyntax(valueNode.IsScalar(), L"Instance array 'texture scale' field must be a scalar", mDrawableObjectMark);
+            YamlUtils::GetScalar(valueNode, instanceArray.mTextureScale);
+        } else {
+            CheckSyntax(false,
+                        (L"Unknown instance array field: " + StringUtils::AnsiToWideString(fieldName)).c_str(),
+                        mDrawableObjectMark);
+        }
+    }
+
+    CheckSyntax(hasModel, L"'model' field was not present in current instance array", mDrawableObjectMark);
+    CheckSyntax(hasPlacement, L"'placement' field was not present in current instance array", mDrawableObjectMark);
+    CheckSyntax(hasCount, L"'count' field was not present in current instance array", mDrawableObjectMark);
+    CheckSyntax(hasSpacing == false || instanceArray.mPlacement == CompiledScene::GRID,
+                L"'spacing' field is only valid in grid instance arrays",
+                mDrawableObjectMark);
+    CheckSyntax(hasVolume == (instanceArray.mPlacement == CompiledScene::RANDOM),
+                L"Random instance arrays, and only them, must have 'volume min' and 'volume max' fields",
+                mDrawableObjectMark);
+    CheckSyntax(hasPath == (instanceArray.mPlacement == CompiledScene::PATH),
+                L"Path instance arrays, and only them, must have 'path' field",
+                mDrawableObjectMark);
+
+    // Grid count is the number of instances in each axis.
+    if (instanceArray.mPlacement == CompiledScene::GRID) {
+        CheckSyntax(countNode.IsSequence() && countNode.size() == 3U,
+                    L"Grid instance array 'count' field must have 3 elements",
+                    mDrawableObjectMark);
+        YamlUtils::GetSequence<std::uint32_t>(countNode, instanceArray.mCounts, 3U);
+    } else {
+        CheckSyntax(countNode.IsScalar(),
+                    L"Random and path instance arrays 'count' field must be a scalar",
+                    mDrawableObjectMark);
+        YamlUtils::GetScalar(countNode, instanceArray.mCounts[0U]);
+    }
+
+    const std::uint64_t instanceCount =
+        static_cast<std::uint64_t>(instanceArray.mCounts[0U]) * instanceArray.mCounts[1U] * instanceArray.mCounts[2U];
+    CheckSyntax(instanceCount > 0UL && instanceCount <= 0xFFFFFFFFUL,
+                L"Instance array must have between 1 and 4294967295 instances",
+                mDrawableObjectMark);
+}
+
+void
+SceneEventHandler::GetInstanceArrayVector(const YAML::Node& vectorNode,
+                                          const char* fieldName,
+                                          float* const vector,
+                                          const std::uint32_t vectorSize) const noexcept
+{
+    BRE_ASSERT(fieldName != nullptr);
+    BRE_ASSERT(vector != nullptr);
+
+    CheckSyntax(vectorNode.IsSequence() && vectorNode.size() == vectorSize,
+                (L"Instance array '" + StringUtils::AnsiToWideString(fieldName) + L"' field must have " +
+                 std::to_wstring(vectorSize) + L" elements").c_str(),
+                mDrawableObjectMark);
+    YamlUtils::GetSequence(vectorNode, vector, vectorSize);
+}
+
+///
+/// @brief Parses a YAML file and adds it as a dependency. It is parsed once.
+///
+/// Drawable objects are a sequence of maps and its sintax is:
+/// drawable objects:
+///   - model: modelName
+///     material technique: materialTechniqueName
+///     translation: [10.0, 0.0, 12.0]
+///     rotation: [3.14, 0.0, 0.0]
+///     scale: [1, 1, 3]
+///   - model: modelName
+///     scale: [1, 3, 3]
+///     texture scale: 8
+///   - reference: drawableObjectsFilePath
+///   - instance array:
+///       model: modelName
+///       material techniques: [materialTechniqueName1, materialTechniqueName2]
+///       placement: grid
+///       count: [100, 1, 100]
+///       spacing: [2.0, 0.0, 2.0]
+///       rotation range: [0.0, 6.28, 0.0]
+///       scale range: [0.5, 1.5]
+///   - instance array:
+///       model: modelName
+///       placement: random
+///       count: 10000
+///       seed: 7
+///       volume min: [-100.0, 0.0, -100.0]
+///       volume max: [100.0, 0.0, 100.0]
+///   - instance array:
+///       model: modelName
+///       placement: path
+///       count: 50
+///       path: [[0.0, 0.0, 0.0], [10.0, 0.0, 0.0], [10.0, 0.0, 10.0]]
+///
+/// Instance arrays are not expanded: their placement parameters are cooked, and their
+/// instances are generated at load time (see InstanceArray). Besides the fields of the
+/// examples, they have "translation", "rotation", "scale" and "texture scale" fields.
+///
+/// @param filePath YAML file path
+/// @param context Cook context
+/// @return Parsed YAML file
+///
+const YamlFile&
+ParseYamlFile(const std::string& filePath,
+              CookContext& context) noexcept
+{
+    std::unordered_map<std::string, YamlFile>::const_iterator findIt = context.mYamlFileByFilePath.find(filePath);
+    if (findIt != context.mYamlFileByFilePath.end()) {
+        return findIt->second;
+    }
+
+    MemoryMappedFile file;
+    BRE_CHECK_MSG(file.Open(filePath.c_str()),
+                  (L"Failed to open yaml file: " + StringUtils::AnsiToWideString(filePath)).c_str());
+
+    CompiledScene::Dependency dependency;
+    dependency.mPathStringIndex = InternString(filePath, context);
+    dependency.mContentHash = HashUtils::ComputeHash(file.GetData(), file.GetSize());
+    context.mDependencies.push_back(dependency);
+
+    // "reference" files are parsed while this file is parsed,
+    // so this file is added to the cache once it is complete.
+    YamlFile yamlFile;
+    YAML::Emitter assetsEmitter;
+    MemoryStreamBuffer streamBuffer(file.GetData(), file.GetSize());
+    std::istream stream(&streamBuffer);
+    YAML::Parser parser(stream);
+    SceneEventHandler eventHandler(filePath, context, yamlFile, assetsEmitter);
+    BRE_CHECK_MSG(parser.HandleNextDocument(eventHandler) && assetsEmitter.good(),
+                  (L"Failed to parse yaml file: " + StringUtils::AnsiToWideString(filePath)).c_str());
+
+    yamlFile.mRootNode = YAML::Load(assetsEmitter.c_str());
+    BRE_CHECK_MSG(yamlFile.mRootNode.IsMap(),
+                  (L"Yaml file root node must be a map: " + StringUtils::AnsiToWideString(filePath)).c_str());
+
+    return context.mYamlFileByFilePath.emplace(filePath, std::move(yamlFile)).first->second;
+}
+
+///
+/// @brief Get a field of a "reference" file
+/// @param filePath "reference" file path
+/// @param fieldName Field name. Must not be nullptr.
+/// @param context Cook context
+/// @return Field node
+///
+YAML::Node
+GetReferenceField(const std::string& filePath,
+                  const char* fieldName,
+                  CookContext& context) noexcept
+{
+    BRE_ASSERT(fieldName != nullptr);
+
+    const YAML::Node referenceNode = ParseYamlFile(filePath, context).mRootNode[fieldName];
+    BRE_CHECK_MSG(referenceNode.IsDefined(),
+                  (L"Reference file must have '" + StringUtils::AnsiToWideString(fieldName) + L"' field: " +
+                   StringUtils::AnsiToWideString(filePath)).c_str());
+
+    return referenceNode;
+}
+
+///
+/// @brief Appends the pairs of a map to a map, following "reference" files.
+/// @param mapNode Map node. Its "reference" keys are YAML files that have a map in the same field.
+/// @param fieldName Field name. Must not be nullptr.
+/// @param context Cook context
+/// @param names Names already appended. Names must be unique.
+/// @param flattenedMapNode Map to append to. It has no "reference" keys.
+///
+void
+AppendMap(const YAML::Node& mapNode,
+          const char* fieldName,
+          CookContext& context,
+          std::unordered_set<std::string>& names,
+          YAML::Node& flattenedMapNode) noexcept
+{
+    BRE_ASSERT(fieldName != nullptr);
+
+    BRE_CHECK_MSG(mapNode.IsMap(),
+                  (L"'" + StringUtils::AnsiToWideString(fieldName) + L"' node must be a map").c_str());
+
+    std::string name;
+    for (YAML::const_iterator it = mapNode.begin(); it != mapNode.end(); ++it) {
+        name = it->first.as<std::string>();
+        if (name == "reference") {
+            const YAML::Node referenceNode = GetReferenceField(it->second.as<std::string>(), fieldName, context);
+            AppendMap(referenceNode, fieldName, context, names, flattenedMapNode);
+        } else {
+            BRE_CHECK_MSG(names.insert(name).second,
+                          (L"Name must be unique in '" + StringUtils::AnsiToWideString(fieldName) + L"': " +
+                           StringUtils::AnsiToWideString(name)).c_str());
+            flattenedMapNode[name] = it->second;
+        }
+    }
+}
+
+///
+/// @brief Appends the maps of a sequence to a sequence, following "reference" files.
+/// @param sequenceNode Sequence of maps. Maps whose first key is "reference" are YAML files
+/// that have a sequence of maps in the same field.
+/// @param fieldName Field name. Must not be nullptr.
+/// @param context Cook context
+/// @param flattenedSequenceNode Sequence to append to. It has no "reference" maps.
+///
+void
+AppendSequence(const YAML::Node& sequenceNode,
+               const char* fieldName,
+               CookContext& context,
+               YAML::Node& flattenedSequenceNode) noexcept
+{
+    BRE_ASSERT(fieldName != nullptr);
+
+    BRE_CHECK_MSG(sequenceNode.IsSequence(),
+                  (L"'" + StringUtils::AnsiToWideString(fieldName) + L"' node must be a sequence of maps").c_str());
+
+    for (YAML::const_iterator seqIt = sequenceNode.begin(); seqIt != sequenceNode.end(); ++seqIt) {
+        const YAML::Node elementNode = *seqIt;
+        BRE_CHECK_MSG(elementNode.IsMap(),
+                      (L"'" + StringUtils::AnsiToWideString(fieldName) + L"' node must be a sequence of maps").c_str());
+
+        YAML::const_iterator mapIt = elementNode.begin();
+        if (mapIt != elementNode.end() && mapIt->first.as<std::string>() == "reference") {
+            const YAML::Node referenceNode = GetReferenceField(mapIt->second.as<std::string>(), fieldName, context);
+            AppendSequence(referenceNode, fieldName, context, flattenedSequenceNode);
+        } else {
+            flattenedSequenceNode.push_back(elementNode);
+        }
+    }
+}
+
+///
+/// @brief Copies a blob to the file data
+/// @param data Blob data
+/// @param dataSize Blob size in bytes
+/// @param offset Blob offset
+/// @param fileData File data
+///
+void
+CopyBlob(const void* data,
+         const std::size_t dataSize,
+         const std::uint64_t offset,
+         std::vector<std::uint8_t>& fileData) noexcept
+{
+    BRE_ASSERT(offset + dataSize <= fileData.size());
+    if (dataSize > 0UL) {
+        std::memcpy(fileData.data() + offset, data, dataSize);
+    }
+}
+}
+
+std::string
+SceneCooker::CookSceneFile(const char* sceneFilePath) noexcept
+{
+    BRE_ASSERT(sceneFilePath != nullptr);
+
+    MemoryMappedFile sceneFile;
+    BRE_CHECK_MSG(sceneFile.Open(sceneFilePath),
+                  (L"Failed to open yaml file: " + StringUtils::AnsiToWideString(sceneFilePath)).c_str());
+    const std::uint64_t sourceContentHash = HashUtils::ComputeHash(sceneFile.GetData(), sceneFile.GetSize());
+    sceneFile.Close();
+
+    const std::string compiledSceneFilePath = GetCompiledSceneFilePath(sourceContentHash);
+    CompiledScene compiledScene;
+    if (compiledScene.Open(compiledSceneFilePath.c_str()) &&
+        compiledScene.GetSourceContentHash() == sourceContentHash &&
+        compiledScene.AreDependenciesUpToDate()) {
+        return compiledSceneFilePath;
+    }
+    compiledScene.Close();
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::uint8_t> compiledSceneData;
+    CookScene(sceneFilePath, compiledSceneData);
+
+    std::ofstream fileStream{ compiledSceneFilePath, std::ios::out | std::ios::binary | std::ios::trunc };
+    fileStream.write(reinterpret_cast<const char*>(compiledSceneData.data()), compiledSceneData.size());
+    BRE_CHECK_MSG(fileStream.good(),
+                  (L"Failed to write compiled scene file: " + StringUtils::AnsiToWideString(compiledSceneFilePath)).c_str());
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+
+    const std::wstring cookMsg =
+        L"Scene cooked " + StringUtils::AnsiToWideString(sceneFilePath) + L": " +
+        std::to_wstring(compiledSceneData.size()) + L" bytes in " +
+        std::to_wstring(std::chrono::duration<double, std::milli>(endTime - startTime).count()) + L" ms\n";
+    BRE_LOG_MSG(cookMsg.c_str());
+
+    return compiledSceneFilePath;
+}
+
+void
+SceneCooker::CookScene(const char* sceneFilePath,
+                       std::vector<std::uint8_t>& compiledSceneData) noexcept
+{
+    BRE_ASSERT(sceneFilePath != nullptr);
+
+    CookContext context;
+    const YamlFile& sceneYamlFile = ParseYamlFile(sceneFilePath, context);
+    BRE_CHECK_MSG(sceneYamlFile.mHasDrawableObjects, L"'drawable objects' node must be defined");
+    const std::vector<CompiledScene::Drawable>& drawables = sceneYamlFile.mDrawables;
+    const std::vector<CompiledScene::InstanceArray>& instanceArrays = sceneYamlFile.mInstanceArrays;
+
+    // The assets document has every field but "drawable objects", with "reference" files included.
+    YAML::Node assetsNode(YAML::NodeType::Map);
+    std::string fieldName;
+    for (YAML::const_iterator it = sceneYamlFile.mRootNode.begin(); it != sceneYamlFile.mRootNode.end(); ++it) {
+        fieldName = it->first.as<std::string>();
+        if (fieldName == "models" || fieldName == "textures") {
+            YAML::Node flattenedMapNode(YAML::NodeType::Map);
+            std::unordered_set<std::string> names;
+            AppendMap(it->second, fieldName.c_str(), context, names, flattenedMapNode);
+            assetsNode[fieldName] = flattenedMapNode;
+        } else if (fieldName == "material techniques") {
+            YAML::Node flattenedSequenceNode(YAML::NodeType::Sequence);
+            AppendSequence(it->second, fieldName.c_str(), context, flattenedSequenceNode);
+            assetsNode[fieldName] = flattenedSequenceNode;
+        } else {
+            assetsNode[fieldName] = it->second;
+        }
+    }
+
+    YAML::Emitter emitter;
+    emitter << assetsNode;
+    BRE_CHECK_MSG(emitter.good(), L"Failed to write scene assets document");
+
+    // Compute the header and blob offsets
+    CompiledScene::FileHeader fileHeader;
+    fileHeader.mMagic = CompiledScene::sMagic;
+    fileHeader.mVersion = CompiledScene::sVersion;
+    BRE_ASSERT(context.mDependencies.empty() == false);
+    fileHeader.mSourceContentHash = context.mDependencies[0U].mContentHash;
+    fileHeader.mStringCount = static_cast<std::uint32_t>(context.mStringEntries.size());
+    fileHeader.mDependencyCount = static_cast<std::uint32_t>(context.mDependencies.size());
+    fileHeader.mModelCount = static_cast<std::uint32_t>(context.mModelNames.size());
+    fileHeader.mMaterialTechniqueCount = static_cast<std::uint32_t>(context.mMaterialTechniqueNames.size());
+    fileHeader.mDrawableCount = static_cast<std::uint32_t>(drawables.size());
+    fileHeader.mInstanceArrayCount = static_cast<std::uint32_t>(instanceArrays.size());
+    fileHeader.mInstanceArrayMaterialTechniqueCount =
+        static_cast<std::uint32_t>(context.mInstanceArrayMaterialTechniques.size());
+    fileHeader.mPathPointCount = static_cast<std::uint32_t>(context.mPathPoints.size());
+
+    fileHeader.mStringDataOffset = sizeof(CompiledScene::FileHeader);
+    fileHeader.mStringDataSize = context.mStringData.size();
+    fileHeader.mStringEntriesOffset = AlignOffset(fileHeader.mStringDataOffset + fileHeader.mStringDataSize,
+                                                  CompiledScene::sBlobAlignment);
+    fileHeader.mDependenciesOffset =
+        AlignOffset(fileHeader.mStringEntriesOffset + sizeof(CompiledScene::StringEntry) * fileHeader.mStringCount,
+                    CompiledScene::sBlobAlignment);
+    fileHeader.mModelNamesOffset =
+        AlignOffset(fileHeader.mDependenciesOffset + sizeof(CompiledScene::Dependency) * fileHeader.mDependencyCount,
+                    CompiledScene::sBlobAlignment);
+    fileHeader.mMaterialTechniqueNamesOffset =
+        AlignOffset(fileHeader.mModelNamesOffset + sizeof(std::uint32_t) * fileHeader.mModelCount,
+                    CompiledScene::sBlobAlignment);
+    fileHeader.mDrawablesOffset =
+        AlignOffset(fileHeader.mMaterialTechniqueNamesOffset + sizeof(std::uint32_t) * fileHeader.mMaterialTechniqueCount,
+                    CompiledScene::sBlobAlignment);
+    fileHeader.mInstanceArraysOffset =
+        AlignOffset(fileHeader.mDrawablesOffset + sizeof(CompiledScene::Drawable) * fileHeader.mDrawableCount,
+                    CompiledScene::sBlobAlignment);
+    fileHeader.mInstanceArrayMaterialTechniquesOffset =
+        AlignOffset(fileHeader.mInstanceArraysOffset + sizeof(CompiledScene::InstanceArray) * fileHeader.mInstanceArrayCount,
+                    CompiledScene::sBlobAlignment);
+    fileHeader.mPathPointsOffset =
+        AlignOffset(fileHeader.mInstanceArrayMaterialTechniquesOffset +
+                    sizeof(std::uint32_t) * fileHeader.mInstanceArrayMaterialTechniqueCount,
+                    CompiledScene::sBlobAlignment);
+    fileHeader.mAssetsDocumentOffset =
+        AlignOffset(fileHeader.mPathPointsOffset + sizeof(DirectX::XMFLOAT3) * fileHeader.mPathPointCount,
+                    CompiledScene::sBlobAlignment);
+    fileHeader.mAssetsDocumentSize = emitter.size();
+    fileHeader.mFileSize = fileHeader.mAssetsDocumentOffset + fileHeader.mAssetsDocumentSize + 1UL;
+
+    // Fill the whole file in memory, so it is written with a single call.
+    // The assets document is null terminated.
+    compiledSceneData.assign(static_cast<std::size_t>(fileHeader.mFileSize), 0U);
+    CopyBlob(&fileHeader, sizeof(fileHeader), 0UL, compiledSceneData);
+    CopyBlob(context.mStringData.data(), context.mStringData.size(), fileHeader.mStringDataOffset, compiledSceneData);
+    CopyBlob(context.mStringEntries.data(),
+             sizeof(CompiledScene::StringEntry) * context.mStringEntries.size(),
+             fileHeader.mStringEntriesOffset,
+             compiledSceneData);
+    CopyBlob(context.mDependencies.data(),
+             sizeof(CompiledScene::Dependency) * context.mDependencies.size(),
+             fileHeader.mDependenciesOffset,
+             compiledSceneData);
+    CopyBlob(context.mModelNames.data(),
+             sizeof(std::uint32_t) * context.mModelNames.size(),
+             fileHeader.mModelNamesOffset,
+             compiledSceneData);
+    CopyBlob(context.mMaterialTechniqueNames.data(),
+             sizeof(std::uint32_t) * context.mMaterialTechniqueNames.size(),
+             fileHeader.mMaterialTechniqueNamesOffset,
+             compiledSceneData);
+    CopyBlob(drawables.data(),
+             sizeof(CompiledScene::Drawable) * drawables.size(),
+             fileHeader.mDrawablesOffset,
+             compiledSceneData);
+    CopyBlob(instanceArrays.data(),
+             sizeof(CompiledScene::InstanceArray) * instanceArrays.size(),
+             fileHeader.mInstanceArraysOffset,
+             compiledSceneData);
+    CopyBlob(context.mInstanceArrayMaterialTechniques.data(),
+             sizeof(std::uint32_t) * context.mInstanceArrayMaterialTechniques.size(),
+             fileHeader.mInstanceArrayMaterialTechniquesOffset,
+             compiledSceneData);
+    CopyBlob(context.mPathPoints.data(),
+             sizeof(DirectX::XMFLOAT3) * context.mPathPoints.size(),
+             fileHeader.mPathPointsOffset,
+             compiledSceneData);
+    CopyBlob(emitter.c_str(), emitter.size(), fileHeader.mAssetsDocumentOffset, compiledSceneData);
+}
+
+std::string
+SceneCooker::GetCompiledSceneFilePath(const std::uint64_t sourceContentHash) noexcept
+{
+    return HashUtils::GetCachedFilePath(sCacheDirectory, sourceContentHash, sCacheFileExtension);
+}
+}
\ No newline at end of file
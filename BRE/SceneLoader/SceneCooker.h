@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BRE {
+///
+/// @brief Responsible to cook scene YAML files to compiled scene files (see CompiledScene).
+///
+/// Compiled scenes are written to a cache directory, named after the content hash of
+/// the scene file, so scenes are only cooked once. They are cooked again if the scene file,
+/// or any "reference" file it includes, is modified.
+///
+/// "reference" files are parsed once, even if they are included several times.
+/// Drawable object fields are converted once, so loading a compiled scene needs no YAML parsing
+/// and no string comparisons per drawable object.
+///
+/// Drawable objects are cooked from the events of the YAML parser, without building node trees,
+/// so the memory needed to cook a scene does not grow with the size of the YAML files.
+///
+class SceneCooker {
+public:
+    SceneCooker() = delete;
+    ~SceneCooker() = delete;
+    SceneCooker(const SceneCooker&) = delete;
+    const SceneCooker& operator=(const SceneCooker&) = delete;
+    SceneCooker(SceneCooker&&) = delete;
+    SceneCooker& operator=(SceneCooker&&) = delete;
+
+    ///
+    /// @brief Cooks a scene file, if it was not cooked before or if it was modified
+    /// @param sceneFilePath Scene YAML file path. Must not be nullptr.
+    /// @return Compiled scene file path
+    ///
+    static std::string CookSceneFile(const char* sceneFilePath) noexcept;
+
+    ///
+    /// @brief Cooks a scene
+    /// @param sceneFilePath Scene YAML file path. Must not be nullptr.
+    /// @param compiledSceneData Output compiled scene file data
+    ///
+    static void CookScene(const char* sceneFilePath,
+                          std::vector<std::uint8_t>& compiledSceneData) noexcept;
+
+    ///
+    /// @brief Get compiled scene file path
+    ///
+    /// The cache directory is created if it does not exist.
+    ///
+    /// @param sourceContentHash Content hash of the scene file
+    /// @return Compiled scene file path
+    ///
+    static std::string GetCompiledSceneFilePath(const std::uint64_t sourceContentHash) noexcept;
+};
+}
\ No newline at end of file
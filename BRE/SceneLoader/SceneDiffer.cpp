@@ -0,0 +1,462 @@
+#include "SceneDiffer.h"
+
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#pragma warning( push )
+#pragma warning( disable : 4127)
+#include <yaml-cpp/yaml.h>
+#pragma warning( pop )
+
+#include <SceneLoader\CompiledScene.h>
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+namespace {
+///
+/// @brief Material technique of an assets document
+///
+struct MaterialTechniqueFields {
+    std::string mFields; // Every field, as YAML
+    std::vector<std::string> mTextureNames;
+};
+
+///
+/// @brief Get the values of an assets document map by name (like "models" or "textures")
+/// @param mapNode YAML node of the map. If it is not defined, then there is no value.
+/// @param valueByName Output value by name
+///
+void
+GetValuesByName(const YAML::Node& mapNode,
+                std::map<std::string, std::string>& valueByName) noexcept
+{
+    if (mapNode.IsDefined() == false) {
+        return;
+    }
+
+    BRE_CHECK_MSG(mapNode.IsMap(), L"Assets document field must be a map");
+    for (YAML::const_iterator it = mapNode.begin(); it != mapNode.end(); ++it) {
+        valueByName[it->first.as<std::string>()] = it->second.as<std::string>();
+    }
+}
+
+///
+/// @brief Get the material techniques of an assets document by name
+/// @param sequenceNode YAML node of the "material techniques" sequence. If it is not defined,
+/// then there is no material technique.
+/// @param materialTechniqueByName Output material technique fields by name
+///
+void
+GetMaterialTechniquesByName(const YAML::Node& sequenceNode,
+                            std::map<std::string, MaterialTechniqueFields>& materialTechniqueByName) noexcept
+{
+    if (sequenceNode.IsDefined() == false) {
+        return;
+    }
+
+    BRE_CHECK_MSG(sequenceNode.IsSequence(), L"'material techniques' node must be a sequence");
+
+    std::string fieldName;
+    for (YAML::const_iterator seqIt = sequenceNode.begin(); seqIt != sequenceNode.end(); ++seqIt) {
+        const YAML::Node materialMap = *seqIt;
+        BRE_CHECK_MSG(materialMap.IsMap() && materialMap["name"].IsDefined(),
+                      L"Material technique must be a map with 'name' field");
+
+        MaterialTechniqueFields materialTechniqueFields;
+        materialTechniqueFields.mFields = YAML::Dump(materialMap);
+
+        // Texture fields are the only ones whose name ends with "texture"
+        for (YAML::const_iterator mapIt = materialMap.begin(); mapIt != materialMap.end(); ++mapIt) {
+            fieldName = mapIt->first.as<std::string>();
+            const std::size_t suffixLength = sizeof("texture") - 1UL;
+            if (fieldName.size() >= suffixLength &&
+                fieldName.compare(fieldName.size() - suffixLength, suffixLength, "texture") == 0) {
+                materialTechniqueFields.mTextureNames.push_back(mapIt->second.as<std::string>());
+            }
+        }
+
+        materialTechniqueByName[materialMap["name"].as<std::string>()] = materialTechniqueFields;
+    }
+}
+
+///
+/// @brief Computes the changes between old and new values by name
+/// @param oldValueByName Old values by name
+/// @param newValueByName New values by name
+/// @param areValuesEqual Function that checks if an old and a new value are equal
+/// @param assetChanges Output asset changes
+///
+template<typename T, typename EqualityFunction>
+void
+ComputeAssetChanges(const std::map<std::string, T>& oldValueByName,
+                    const std::map<std::string, T>& newValueByName,
+                    const EqualityFunction& areValuesEqual,
+                    SceneDiffer::AssetChanges& assetChanges) noexcept
+{
+    // Maps are sorted by name, so they are merged like sorted lists
+    typename std::map<std::string, T>::const_iterator oldIt = oldValueByName.begin();
+    typename std::map<std::string, T>::const_iterator newIt = newValueByName.begin();
+    while (oldIt != oldValueByName.end() || newIt != newValueByName.end()) {
+        if (newIt == newValueByName.end() || (oldIt != oldValueByName.end() && oldIt->first < newIt->first)) {
+            assetChanges.mRemovedNames.push_back(oldIt->first);
+            ++oldIt;
+        } else if (oldIt == oldValueByName.end() || newIt->first < oldIt->first) {
+            assetChanges.mAddedNames.push_back(newIt->first);
+            ++newIt;
+        } else {
+            if (areValuesEqual(oldIt->second, newIt->second) == false) {
+                assetChanges.mChangedNames.push_back(newIt->first);
+            }
+            ++oldIt;
+            ++newIt;
+        }
+    }
+}
+
+///
+/// @brief Checks if a field of the assets documents changed
+/// @param oldRootNode Old assets document root node
+/// @param newRootNode New assets document root node
+/// @param fieldName Field name
+/// @return True if the field was added, removed or changed. Otherwise, false.
+///
+bool
+HasFieldChanged(const YAML::Node& oldRootNode,
+                const YAML::Node& newRootNode,
+                const char* fieldName) noexcept
+{
+    const YAML::Node oldNode = oldRootNode[fieldName];
+    const YAML::Node newNode = newRootNode[fieldName];
+    if (oldNode.IsDefined() == false || newNode.IsDefined() == false) {
+        return oldNode.IsDefined() != newNode.IsDefined();
+    }
+
+    return YAML::Dump(oldNode) != YAML::Dump(newNode);
+}
+
+///
+/// @brief Get material technique name of a drawable
+/// @param compiledScene Compiled scene
+/// @param materialTechniqueIndex Material technique index
+/// @return Material technique name, or nullptr if it is the default material technique.
+///
+const char*
+GetMaterialTechniqueName(const CompiledScene& compiledScene,
+                         const std::uint32_t materialTechniqueIndex) noexcept
+{
+    return materialTechniqueIndex == CompiledScene::sDefaultMaterialTechniqueIndex ?
+        nullptr :
+        compiledScene.GetMaterialTechniqueName(materialTechniqueIndex);
+}
+
+///
+/// @brief Checks if two material technique names are equal
+/// @param oldName Old material technique name, or nullptr for the default material technique
+/// @param newName New material technique name, or nullptr for the default material technique
+/// @return True if they are equal. Otherwise, false.
+///
+bool
+AreMaterialTechniqueNamesEqual(const char* oldName,
+                               const char* newName) noexcept
+{
+    if (oldName == nullptr || newName == nullptr) {
+        return oldName == newName;
+    }
+
+    return std::strcmp(oldName, newName) == 0;
+}
+
+///
+/// @brief Checks if two drawables of different compiled scenes are equal
+/// @param oldCompiledScene Old compiled scene
+/// @param oldDrawable Old drawable
+/// @param newCompiledScene New compiled scene
+/// @param newDrawable New drawable
+/// @return True if they are equal. Otherwise, false.
+///
+bool
+AreDrawablesEqual(const CompiledScene& oldCompiledScene,
+                  const CompiledScene::Drawable& oldDrawable,
+                  const CompiledScene& newCompiledScene,
+                  const CompiledScene::Drawable& newDrawable) noexcept
+{
+    return std::memcmp(&oldDrawable.mWorldMatrix, &newDrawable.mWorldMatrix, sizeof(DirectX::XMFLOAT4X4)) == 0 &&
+        oldDrawable.mTextureScale == newDrawable.mTextureScale &&
+        std::strcmp(oldCompiledScene.GetModelName(oldDrawable.mModelIndex),
+                    newCompiledScene.GetModelName(newDrawable.mModelIndex)) == 0 &&
+        AreMaterialTechniqueNamesEqual(GetMaterialTechniqueName(oldCompiledScene, oldDrawable.mMaterialTechniqueIndex),
+                                       GetMaterialTechniqueName(newCompiledScene, newDrawable.mMaterialTechniqueIndex));
+}
+
+///
+/// @brief Get the key of a drawable. Drawables are equal if their keys are equal.
+/// @param compiledScene Compiled scene
+/// @param drawable Drawable
+/// @param key Output key
+///
+void
+GetDrawableKey(const CompiledScene& compiledScene,
+               const CompiledScene::Drawable& drawable,
+               std::string& key) noexcept
+{
+    // Names are null terminated, so they cannot be confused.
+    // The default material technique has no name.
+    key.assign(compiledScene.GetModelName(drawable.mModelIndex));
+    key.push_back('\0');
+    const char* materialTechniqueName = GetMaterialTechniqueName(compiledScene, drawable.mMaterialTechniqueIndex);
+    if (materialTechniqueName != nullptr) {
+        key.push_back('\1');
+        key.append(materialTechniqueName);
+    }
+    key.push_back('\0');
+    key.append(reinterpret_cast<const char*>(&drawable.mWorldMatrix), sizeof(DirectX::XMFLOAT4X4));
+    key.append(reinterpret_cast<const char*>(&drawable.mTextureScale), sizeof(float));
+}
+
+///
+/// @brief Indices of drawables with the same key, consumed in order
+///
+struct DrawableIndices {
+    std::vector<std::uint32_t> mIndices;
+    std::size_t mNextIndex{ 0UL };
+};
+
+///
+/// @brief Computes the added, removed and changed drawables
+/// @param oldCompiledScene Old compiled scene
+/// @param newCompiledScene New compiled scene
+/// @param sceneDiff Output scene differences
+///
+void
+ComputeDrawableChanges(const CompiledScene& oldCompiledScene,
+                       const CompiledScene& newCompiledScene,
+                       SceneDiffer::SceneDiff& sceneDiff) noexcept
+{
+    const CompiledScene::Drawable* oldDrawables = oldCompiledScene.GetDrawables();
+    const CompiledScene::Drawable* newDrawables = newCompiledScene.GetDrawables();
+    const std::uint32_t oldDrawableCount = oldCompiledScene.GetDrawableCount();
+    const std::uint32_t newDrawableCount = newCompiledScene.GetDrawableCount();
+
+    // Edits are usually local, so equal drawables at the beginning and at the end
+    // are skipped first, without allocations.
+    std::uint32_t firstDrawable = 0U;
+    while (firstDrawable < oldDrawableCount && firstDrawable < newDrawableCount &&
+           AreDrawablesEqual(oldCompiledScene, oldDrawables[firstDrawable], newCompiledScene, newDrawables[firstDrawable])) {
+        ++firstDrawable;
+    }
+
+    std::uint32_t oldEndDrawable = oldDrawableCount;
+    std::uint32_t newEndDrawable = newDrawableCount;
+    while (oldEndDrawable > firstDrawable && newEndDrawable > firstDrawable &&
+           AreDrawablesEqual(oldCompiledScene, oldDrawables[oldEndDrawable - 1U], newCompiledScene, newDrawables[newEndDrawable - 1U])) {
+        --oldEndDrawable;
+        --newEndDrawable;
+    }
+
+    // New drawables that are equal to an old drawable are unchanged, even if they were moved.
+    std::string key;
+    std::unordered_map<std::string, DrawableIndices> oldDrawableIndicesByKey;
+    for (std::uint32_t i = firstDrawable; i < oldEndDrawable; ++i) {
+        GetDrawableKey(oldCompiledScene, oldDrawables[i], key);
+        oldDrawableIndicesByKey[key].mIndices.push_back(i);
+    }
+
+    std::vector<bool> isOldDrawableMatched(oldEndDrawable - firstDrawable, false);
+    std::vector<std::uint32_t> unmatchedNewDrawables;
+    for (std::uint32_t i = firstDrawable; i < newEndDrawable; ++i) {
+        GetDrawableKey(newCompiledScene, newDrawables[i], key);
+        std::unordered_map<std::string, DrawableIndices>::iterator findIt = oldDrawableIndicesByKey.find(key);
+        if (findIt != oldDrawableIndicesByKey.end() && findIt->second.mNextIndex < findIt->second.mIndices.size()) {
+            isOldDrawableMatched[findIt->second.mIndices[findIt->second.mNextIndex++] - firstDrawable] = true;
+        } else {
+            unmatchedNewDrawables.push_back(i);
+        }
+    }
+
+    // The remaining new drawables are changed old drawables of the same model, in order.
+    std::unordered_map<std::string, DrawableIndices> oldDrawableIndicesByModelName;
+    for (std::uint32_t i = firstDrawable; i < oldEndDrawable; ++i) {
+        if (isOldDrawableMatched[i - firstDrawable] == false) {
+            oldDrawableIndicesByModelName[oldCompiledScene.GetModelName(oldDrawables[i].mModelIndex)].mIndices.push_back(i);
+        }
+    }
+
+    for (const std::uint32_t newDrawableIndex : unmatchedNewDrawables) {
+        std::unordered_map<std::string, DrawableIndices>::iterator findIt =
+            oldDrawableIndicesByModelName.find(newCompiledScene.GetModelName(newDrawables[newDrawableIndex].mModelIndex));
+        if (findIt != oldDrawableIndicesByModelName.end() && findIt->second.mNextIndex < findIt->second.mIndices.size()) {
+            const std::uint32_t oldDrawableIndex = findIt->second.mIndices[findIt->second.mNextIndex++];
+            isOldDrawableMatched[oldDrawableIndex - firstDrawable] = true;
+            sceneDiff.mChangedDrawables.emplace_back(oldDrawableIndex, newDrawableIndex);
+        } else {
+            sceneDiff.mAddedDrawables.push_back(newDrawableIndex);
+        }
+    }
+
+    for (std::uint32_t i = firstDrawable; i < oldEndDrawable; ++i) {
+        if (isOldDrawableMatched[i - firstDrawable] == false) {
+            sceneDiff.mRemovedDrawables.push_back(i);
+        }
+    }
+}
+
+///
+/// @brief Checks if two instance arrays of different compiled scenes are equal
+/// @param oldCompiledScene Old compiled scene
+/// @param oldInstanceArray Old instance array
+/// @param newCompiledScene New compiled scene
+/// @param newInstanceArray New instance array
+/// @return True if they are equal. Otherwise, false.
+///
+bool
+AreInstanceArraysEqual(const CompiledScene& oldCompiledScene,
+                       const CompiledScene::InstanceArray& oldInstanceArray,
+                       const CompiledScene& newCompiledScene,
+                       const CompiledScene::InstanceArray& newInstanceArray) noexcept
+{
+    // Indices are compared by what they refer to
+    CompiledScene::InstanceArray oldParameters = oldInstanceArray;
+    CompiledScene::InstanceArray newParameters = newInstanceArray;
+    oldParameters.mModelIndex = newParameters.mModelIndex;
+    oldParameters.mFirstMaterialTechnique = newParameters.mFirstMaterialTechnique;
+    oldParameters.mFirstPathPoint = newParameters.mFirstPathPoint;
+    if (std::memcmp(&oldParameters, &newParameters, sizeof(CompiledScene::InstanceArray)) != 0 ||
+        std::strcmp(oldCompiledScene.GetModelName(oldInstanceArray.mModelIndex),
+                    newCompiledScene.GetModelName(newInstanceArray.mModelIndex)) != 0) {
+        return false;
+    }
+
+    const std::uint32_t* oldMaterialTechniques =
+        oldCompiledScene.GetInstanceArrayMaterialTechniques() + oldInstanceArray.mFirstMaterialTechnique;
+    const std::uint32_t* newMaterialTechniques =
+        newCompiledScene.GetInstanceArrayMaterialTechniques() + newInstanceArray.mFirstMaterialTechnique;
+    for (std::uint32_t i = 0U; i < newInstanceArray.mMaterialTechniqueCount; ++i) {
+        if (std::strcmp(oldCompiledScene.GetMaterialTechniqueName(oldMaterialTechniques[i]),
+                        newCompiledScene.GetMaterialTechniqueName(newMaterialTechniques[i])) != 0) {
+            return false;
+        }
+    }
+
+    return newInstanceArray.mPathPointCount == 0U ||
+        std::memcmp(oldCompiledScene.GetPathPoints() + oldInstanceArray.mFirstPathPoint,
+                    newCompiledScene.GetPathPoints() + newInstanceArray.mFirstPathPoint,
+                    sizeof(DirectX::XMFLOAT3) * newInstanceArray.mPathPointCount) == 0;
+}
+
+///
+/// @brief Computes the added, removed and changed instance arrays
+/// @param oldCompiledScene Old compiled scene
+/// @param newCompiledScene New compiled scene
+/// @param sceneDiff Output scene differences
+///
+void
+ComputeInstanceArrayChanges(const CompiledScene& oldCompiledScene,
+                            const CompiledScene& newCompiledScene,
+                            SceneDiffer::SceneDiff& sceneDiff) noexcept
+{
+    const std::uint32_t oldInstanceArrayCount = oldCompiledScene.GetInstanceArrayCount();
+    const std::uint32_t newInstanceArrayCount = newCompiledScene.GetInstanceArrayCount();
+    for (std::uint32_t i = 0U; i < newInstanceArrayCount; ++i) {
+        if (i >= oldInstanceArrayCount) {
+            sceneDiff.mAddedInstanceArrays.push_back(i);
+        } else if (AreInstanceArraysEqual(oldCompiledScene,
+                                          oldCompiledScene.GetInstanceArrays()[i],
+                                          newCompiledScene,
+                                          newCompiledScene.GetInstanceArrays()[i]) == false) {
+            sceneDiff.mChangedInstanceArrays.emplace_back(i, i);
+        }
+    }
+
+    for (std::uint32_t i = newInstanceArrayCount; i < oldInstanceArrayCount; ++i) {
+        sceneDiff.mRemovedInstanceArrays.push_back(i);
+    }
+}
+}
+
+bool
+SceneDiffer::SceneDiff::IsEmpty() const noexcept
+{
+    return mModelChanges.IsEmpty() &&
+        mTextureChanges.IsEmpty() &&
+        mMaterialTechniqueChanges.IsEmpty() &&
+        mAddedDrawables.empty() &&
+        mRemovedDrawables.empty() &&
+        mChangedDrawables.empty() &&
+        mAddedInstanceArrays.empty() &&
+        mRemovedInstanceArrays.empty() &&
+        mChangedInstanceArrays.empty() &&
+        mHasEnvironmentChanged == false &&
+        mHasCameraChanged == false &&
+        mHaveSettingsChanged == false;
+}
+
+void
+SceneDiffer::ComputeSceneDiff(const CompiledScene& oldCompiledScene,
+                              const CompiledScene& newCompiledScene,
+                              SceneDiff& sceneDiff) noexcept
+{
+    sceneDiff = SceneDiff();
+
+    // Assets documents have "reference" files already included
+    const YAML::Node oldRootNode = YAML::Load(oldCompiledScene.GetAssetsDocument());
+    const YAML::Node newRootNode = YAML::Load(newCompiledScene.GetAssetsDocument());
+    BRE_CHECK_MSG(oldRootNode.IsDefined() && newRootNode.IsDefined(), L"Failed to parse scene assets document");
+
+    const auto areStringsEqual = [](const std::string& oldValue, const std::string& newValue) {
+        return oldValue == newValue;
+    };
+
+    std::map<std::string, std::string> oldModelPathByName;
+    std::map<std::string, std::string> newModelPathByName;
+    GetValuesByName(oldRootNode["models"], oldModelPathByName);
+    GetValuesByName(newRootNode["models"], newModelPathByName);
+    ComputeAssetChanges(oldModelPathByName, newModelPathByName, areStringsEqual, sceneDiff.mModelChanges);
+
+    std::map<std::string, std::string> oldTexturePathByName;
+    std::map<std::string, std::string> newTexturePathByName;
+    GetValuesByName(oldRootNode["textures"], oldTexturePathByName);
+    GetValuesByName(newRootNode["textures"], newTexturePathByName);
+    ComputeAssetChanges(oldTexturePathByName, newTexturePathByName, areStringsEqual, sceneDiff.mTextureChanges);
+
+    // Material techniques that refer to modified textures are changed too,
+    // because they refer to other texture resources.
+    std::unordered_set<std::string> modifiedTextureNames(sceneDiff.mTextureChanges.mAddedNames.begin(),
+                                                         sceneDiff.mTextureChanges.mAddedNames.end());
+    modifiedTextureNames.insert(sceneDiff.mTextureChanges.mRemovedNames.begin(),
+                                sceneDiff.mTextureChanges.mRemovedNames.end());
+    modifiedTextureNames.insert(sceneDiff.mTextureChanges.mChangedNames.begin(),
+                                sceneDiff.mTextureChanges.mChangedNames.end());
+
+    std::map<std::string, MaterialTechniqueFields> oldMaterialTechniqueByName;
+    std::map<std::string, MaterialTechniqueFields> newMaterialTechniqueByName;
+    GetMaterialTechniquesByName(oldRootNode["material techniques"], oldMaterialTechniqueByName);
+    GetMaterialTechniquesByName(newRootNode["material techniques"], newMaterialTechniqueByName);
+    const auto areMaterialTechniquesEqual = [&modifiedTextureNames](const MaterialTechniqueFields& oldFields,
+                                                                    const MaterialTechniqueFields& newFields) {
+        if (oldFields.mFields != newFields.mFields) {
+            return false;
+        }
+
+        for (const std::string& textureName : newFields.mTextureNames) {
+            if (modifiedTextureNames.find(textureName) != modifiedTextureNames.end()) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+    ComputeAssetChanges(oldMaterialTechniqueByName,
+                        newMaterialTechniqueByName,
+                        areMaterialTechniquesEqual,
+                        sceneDiff.mMaterialTechniqueChanges);
+
+    sceneDiff.mHasEnvironmentChanged = HasFieldChanged(oldRootNode, newRootNode, "environment");
+    sceneDiff.mHasCameraChanged = HasFieldChanged(oldRootNode, newRootNode, "camera");
+    sceneDiff.mHaveSettingsChanged = HasFieldChanged(oldRootNode, newRootNode, "settings");
+
+    ComputeDrawableChanges(oldCompiledScene, newCompiledScene, sceneDiff);
+    ComputeInstanceArrayChanges(oldCompiledScene, newCompiledScene, sceneDiff);
+}
+}
\ No newline at end of file
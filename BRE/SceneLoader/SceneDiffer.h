@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace BRE {
+class CompiledScene;
+
+///
+/// @brief Responsible to compute the differences between two versions of a compiled scene,
+/// so a modified scene file is applied to the loaded scene without loading it again.
+///
+/// Assets (models, textures and material techniques) are compared by name, in the assets documents.
+/// Drawables are compared by their fields and the names they refer to, so they do not depend on
+/// the indices of the names of each compiled scene:
+/// - Drawables that are equal are unchanged, even if they were moved in the scene file.
+/// - A drawable that is not in the old scene is changed if there is an old drawable of the same model
+/// that is not in the new scene (like a modified transform or material technique). Otherwise, it is added.
+/// - The remaining old drawables are removed.
+/// Instance arrays are compared by their position in the scene file.
+///
+class SceneDiffer {
+public:
+    SceneDiffer() = delete;
+    ~SceneDiffer() = delete;
+    SceneDiffer(const SceneDiffer&) = delete;
+    const SceneDiffer& operator=(const SceneDiffer&) = delete;
+    SceneDiffer(SceneDiffer&&) = delete;
+    SceneDiffer& operator=(SceneDiffer&&) = delete;
+
+    ///
+    /// @brief Added, removed and changed names of a kind of asset. Names are sorted.
+    ///
+    struct AssetChanges {
+        ///
+        /// @brief Checks if there is no change
+        /// @return True if there is no change. Otherwise, false.
+        ///
+        bool IsEmpty() const noexcept
+        {
+            return mAddedNames.empty() && mRemovedNames.empty() && mChangedNames.empty();
+        }
+
+        std::vector<std::string> mAddedNames;
+        std::vector<std::string> mRemovedNames;
+        std::vector<std::string> mChangedNames;
+    };
+
+    ///
+    /// @brief Differences between an old and a new compiled scene
+    ///
+    struct SceneDiff {
+        ///
+        /// @brief Checks if there is no difference
+        /// @return True if there is no difference. Otherwise, false.
+        ///
+        bool IsEmpty() const noexcept;
+
+        AssetChanges mModelChanges; // A model is changed if its path changed
+        AssetChanges mTextureChanges; // A texture is changed if its path changed
+
+        // A material technique is changed if its fields changed, or if a texture it refers to
+        // was added, removed or changed.
+        AssetChanges mMaterialTechniqueChanges;
+
+        // Drawable indices. Added ones are in the new scene, removed ones in the old scene,
+        // and changed ones are pairs of old and new drawable indices. They are sorted by
+        // their index in the new scene, or in the old scene if they are removed.
+        std::vector<std::uint32_t> mAddedDrawables;
+        std::vector<std::uint32_t> mRemovedDrawables;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> mChangedDrawables;
+
+        // Instance array indices, like drawable indices.
+        std::vector<std::uint32_t> mAddedInstanceArrays;
+        std::vector<std::uint32_t> mRemovedInstanceArrays;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> mChangedInstanceArrays;
+
+        bool mHasEnvironmentChanged{ false };
+        bool mHasCameraChanged{ false };
+        bool mHaveSettingsChanged{ false };
+    };
+
+    ///
+    /// @brief Computes the differences between two compiled scenes
+    /// @param oldCompiledScene Old compiled scene. It must be open.
+    /// @param newCompiledScene New compiled scene. It must be open.
+    /// @param sceneDiff Output differences
+    ///
+    static void ComputeSceneDiff(const CompiledScene& oldCompiledScene,
+                                 const CompiledScene& newCompiledScene,
+                                 SceneDiff& sceneDiff) noexcept;
+};
+}
\ No newline at end of file
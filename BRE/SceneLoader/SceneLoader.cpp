@@ -1,53 +1,619 @@
 #include "SceneLoader.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <d3d12.h>
+#include <map>
 #include <string>
+#include <tbb/parallel_for.h>
+#include <unordered_map>
+#include <unordered_set>
 #pragma warning( push )
 #pragma warning( disable : 4127)
 #include <yaml-cpp/yaml.h>
 #pragma warning( pop ) 
 
-#include <CommandManager\CommandAllocatorManager.h>
-#include <CommandManager\CommandListManager.h>
+#include <ApplicationSettings\ApplicationSettings.h>
+#include <GeometryPass\Recorders\ColorHeightMappingCommandListRecorder.h>
+#include <GeometryPass\Recorders\ColorMappingCommandListRecorder.h>
+#include <GeometryPass\Recorders\ColorNormalMappingCommandListRecorder.h>
 #include <GeometryPass\Recorders\HeightMappingCommandListRecorder.h>
 #include <GeometryPass\Recorders\NormalMappingCommandListRecorder.h>
 #include <GeometryPass\Recorders\TextureMappingCommandListRecorder.h>
 #include <MathUtils\MathUtils.h>
 #include <ModelManager\Model.h>
+#include <ResourceManager\StagingRingBuffer.h>
+#include <ResourceManager\TextureStreamer.h>
+#include <ResourceManager\UploadBuffer.h>
 #include <Scene\Scene.h>
+#include <SceneLoader\CompiledScene.h>
+#include <SceneLoader\SceneCooker.h>
+#include <SceneLoader\SceneDiffer.h>
+#include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
+#include <Utils\StringId.h>
 
 using namespace DirectX;
 
 namespace BRE {
+namespace {
+// Each task fills the geometry data of several drawable objects
+const std::size_t sDrawableObjectGrainSize{ 256UL };
+
+// Drawable objects are in the geometry pass recorders of their world partition cells,
+// and instance arrays in the ones of their technique types.
+const DrawableObjectLoader::DrawableObjectsByModelName sNoDrawableObjects;
+const DrawableObjectLoader::InstanceArrayObjectsVector sNoInstanceArrayObjects;
+
+// TextureStreamer user identifier of the drawable objects and instance arrays that are not
+// in world partition cells. Cells use their cell identifier plus one.
+const std::uint32_t sSceneTextureStreamingUserId{ 0U };
+
+///
+/// @brief Data to initialize a geometry pass command list recorder
+///
+struct GeometryPassRecorderData {
+    std::vector<GeometryCommandListRecorder::GeometryData> mGeometryDataVector;
+
+    // One texture per mesh and drawable object. They are empty if the technique does not use them.
+    std::vector<ID3D12Resource*> mBaseColorTextures;
+    std::vector<ID3D12Resource*> mMetalnessRoughnessHeightTextures;
+    std::vector<ID3D12Resource*> mNormalTextures;
+
+    // Distinct textures of the material techniques of the instances, kept by the recorder
+    std::vector<ResourceManager::SharedResource> mSampledTextures;
+};
+
+///
+/// @brief Builds the data to initialize a geometry pass command list recorder
+///
+/// A counting pass sizes every output once, and then geometry data, matrices and textures
+/// are filled in place, in parallel. There is a geometry data per model mesh, and its drawable objects
+/// and instance array instances are its instances. Textures are sorted by model, mesh and instance.
+/// Instance arrays are generated straight to the geometry data, without creating drawable objects.
+/// Models and textures are got from their loaders, that load them again if they were released.
+/// Geometry data keep their models, and the recorder keeps the sampled textures.
+///
+/// @param drawableObjectsByModelName Drawable objects by model name of the technique
+/// @param instanceArrayObjectsVector Instance array objects of the technique
+/// @param techniqueType Technique type
+/// @param modelLoader Model loader of the drawable object models
+/// @param textureLoader Texture loader of the material technique textures
+/// @param recorderData Output recorder data
+///
+void
+BuildGeometryPassRecorderData(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                              const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector,
+                              const MaterialTechnique::TechniqueType techniqueType,
+                              ModelLoader& modelLoader,
+                              TextureLoader& textureLoader,
+                              GeometryPassRecorderData& recorderData) noexcept
+{
+    // Color techniques use material constants instead of base color, metalness and roughness textures.
+    const bool hasMaterialConstants = techniqueType == MaterialTechnique::COLOR_MAPPING ||
+        techniqueType == MaterialTechnique::COLOR_NORMAL_MAPPING ||
+        techniqueType == MaterialTechnique::COLOR_HEIGHT_MAPPING;
+    const bool hasBaseColorTextures = hasMaterialConstants == false;
+    const bool hasMetalnessRoughnessHeightTextures = techniqueType != MaterialTechnique::COLOR_MAPPING &&
+        techniqueType != MaterialTechnique::COLOR_NORMAL_MAPPING;
+    const bool hasNormalTextures = techniqueType != MaterialTechnique::COLOR_MAPPING &&
+        techniqueType != MaterialTechnique::TEXTURE_MAPPING;
+
+    const bool hasTextures = techniqueType != MaterialTechnique::COLOR_MAPPING;
+
+    // Meshlets are not culled, because displacement changes their bounds and normal cones.
+    const bool hasMeshlets = techniqueType != MaterialTechnique::COLOR_HEIGHT_MAPPING &&
+        techniqueType != MaterialTechnique::HEIGHT_MAPPING;
+
+    // Counting pass. Drawable objects and instance arrays of the same model are instances
+    // of the same geometry data.
+    struct ModelData {
+        const std::vector<DrawableObject>* mDrawableObjects;
+        std::vector<const DrawableObjectLoader::InstanceArrayObjects*> mInstanceArrayObjects;
+        std::vector<std::size_t> mInstanceArrayOffsets;
+        ModelManager::SharedModel mModel;
+        const std::vector<Mesh>* mMeshes;
+        std::size_t mInstanceCount;
+        std::size_t mGeometryDataOffset;
+        std::size_t mTextureOffset;
+    };
+    std::vector<ModelData> modelDataVector;
+    modelDataVector.reserve(drawableObjectsByModelName.size() + instanceArrayObjectsVector.size());
+    std::unordered_map<const Model*, std::size_t> modelDataIndexByModel;
+    for (const DrawableObjectLoader::DrawableObjectsByModelName::value_type& pair : drawableObjectsByModelName) {
+        const std::vector<DrawableObject>& drawableObjects = pair.second;
+        BRE_ASSERT(drawableObjects.empty() == false);
+
+        const ModelManager::SharedModel model = modelLoader.GetModel(pair.first);
+        modelDataIndexByModel.emplace(model.get(), modelDataVector.size());
+        modelDataVector.push_back(ModelData{ &drawableObjects, {}, {}, model, &model->GetMeshes(), drawableObjects.size(), 0UL, 0UL });
+    }
+
+    for (const DrawableObjectLoader::InstanceArrayObjects& instanceArrayObjects : instanceArrayObjectsVector) {
+        BRE_ASSERT(instanceArrayObjects.mModel != nullptr);
+        const std::pair<std::unordered_map<const Model*, std::size_t>::iterator, bool> insertResult =
+            modelDataIndexByModel.emplace(instanceArrayObjects.mModel.get(), modelDataVector.size());
+        if (insertResult.second) {
+            modelDataVector.push_back(ModelData{ nullptr,
+                                                 {},
+                                                 {},
+                                                 instanceArrayObjects.mModel,
+                                                 &instanceArrayObjects.mModel->GetMeshes(),
+                                                 0UL,
+                                                 0UL,
+                                                 0UL });
+        }
+
+        ModelData& modelData = modelDataVector[insertResult.first->second];
+        modelData.mInstanceArrayObjects.push_back(&instanceArrayObjects);
+        modelData.mInstanceArrayOffsets.push_back(modelData.mInstanceCount);
+        modelData.mInstanceCount += instanceArrayObjects.mChunkOffsets.back();
+    }
+
+    std::size_t geometryDataCount = 0UL;
+    std::size_t textureCount = 0UL;
+    for (ModelData& modelData : modelDataVector) {
+        modelData.mGeometryDataOffset = geometryDataCount;
+        modelData.mTextureOffset = textureCount;
+        geometryDataCount += modelData.mMeshes->size();
+        textureCount += modelData.mMeshes->size() * modelData.mInstanceCount;
+    }
+
+    recorderData.mGeometryDataVector.resize(geometryDataCount);
+    recorderData.mBaseColorTextures.resize(hasBaseColorTextures ? textureCount : 0UL);
+    recorderData.mMetalnessRoughnessHeightTextures.resize(hasMetalnessRoughnessHeightTextures ? textureCount : 0UL);
+    recorderData.mNormalTextures.resize(hasNormalTextures ? textureCount : 0UL);
+
+    // Sampled textures are got once for each distinct material technique. Consecutive drawable objects
+    // usually share their material technique, so it is checked before the map.
+    struct MaterialTechniqueTextures {
+        ID3D12Resource* mBaseColorTexture{ nullptr };
+        ID3D12Resource* mMetalnessRoughnessHeightTexture{ nullptr };
+        ID3D12Resource* mNormalTexture{ nullptr };
+    };
+    std::unordered_map<const MaterialTechnique*, MaterialTechniqueTextures> texturesByMaterialTechnique;
+    if (hasTextures) {
+        const auto getTexture = [&](const StringId textureNameId) {
+            recorderData.mSampledTextures.push_back(textureLoader.GetTexture(textureNameId));
+            return recorderData.mSampledTextures.back().get();
+        };
+
+        const auto addMaterialTechnique = [&](const MaterialTechnique& materialTechnique) {
+            const std::pair<std::unordered_map<const MaterialTechnique*, MaterialTechniqueTextures>::iterator, bool> insertResult =
+                texturesByMaterialTechnique.emplace(&materialTechnique, MaterialTechniqueTextures());
+            if (insertResult.second == false) {
+                return;
+            }
+
+            MaterialTechniqueTextures& textures = insertResult.first->second;
+            if (hasBaseColorTextures) {
+                textures.mBaseColorTexture = getTexture(materialTechnique.GetBaseColorTextureNameId());
+            }
+            if (hasMetalnessRoughnessHeightTextures) {
+                textures.mMetalnessRoughnessHeightTexture = getTexture(materialTechnique.GetMetalnessRoughnessHeightTextureNameId());
+            }
+            if (hasNormalTextures) {
+                textures.mNormalTexture = getTexture(materialTechnique.GetNormalTextureNameId());
+            }
+        };
+
+        for (const ModelData& modelData : modelDataVector) {
+            if (modelData.mDrawableObjects != nullptr) {
+                const MaterialTechnique* lastMaterialTechnique = nullptr;
+                for (const DrawableObject& drawableObject : *modelData.mDrawableObjects) {
+                    if (&drawableObject.GetMaterialTechnique() != lastMaterialTechnique) {
+                        lastMaterialTechnique = &drawableObject.GetMaterialTechnique();
+                        addMaterialTechnique(*lastMaterialTechnique);
+                    }
+                }
+            }
+
+            for (const DrawableObjectLoader::InstanceArrayObjects* instanceArrayObjects : modelData.mInstanceArrayObjects) {
+                for (const MaterialTechnique* materialTechnique : instanceArrayObjects->mMaterialTechniques) {
+                    if (materialTechnique->GetType() == techniqueType) {
+                        addMaterialTechnique(*materialTechnique);
+                    }
+                }
+            }
+        }
+
+        std::sort(recorderData.mSampledTextures.begin(), recorderData.mSampledTextures.end());
+        recorderData.mSampledTextures.erase(std::unique(recorderData.mSampledTextures.begin(),
+                                                        recorderData.mSampledTextures.end()),
+                                            recorderData.mSampledTextures.end());
+    }
+
+    // Filling pass. Models are filled in parallel, and the instances of each model too,
+    // so scenes with few models and a lot of instances use every core.
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, modelDataVector.size(), 1U),
+                      [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+            const ModelData& modelData = modelDataVector[i];
+            const std::vector<Mesh>& meshes = *modelData.mMeshes;
+            const std::size_t instanceCount = modelData.mInstanceCount;
+
+            for (std::size_t j = 0UL; j < meshes.size(); ++j) {
+                const Mesh& mesh = meshes[j];
+                GeometryCommandListRecorder::GeometryData& geometryData =
+                    recorderData.mGeometryDataVector[modelData.mGeometryDataOffset + j];
+                geometryData.mModel = modelData.mModel;
+                geometryData.mVertexBufferData = mesh.GetVertexBufferData();
+                geometryData.mIndexBufferData = mesh.GetIndexBufferData();
+                if (hasMeshlets) {
+                    geometryData.mMeshlets = &mesh.GetMeshlets();
+                }
+                geometryData.mWorldMatrices.resize(instanceCount);
+                geometryData.mInverseTransposeWorldMatrices.resize(instanceCount);
+                geometryData.mTextureScales.resize(instanceCount);
+                if (hasMaterialConstants) {
+                    geometryData.mBaseColorsAndMetalnesses.resize(instanceCount);
+                    geometryData.mRoughnesses.resize(instanceCount);
+                }
+            }
+
+            // Stores the data of the instance k of every mesh of the model
+            const auto storeInstance = [&](const std::size_t k,
+                                           const XMFLOAT4X4& worldMatrix,
+                                           const float textureScale,
+                                           const MaterialTechnique& materialTechnique) {
+                // Every mesh of the model shares the matrices and textures of the instance
+                XMFLOAT4X4 inverseTransposeWorldMatrix;
+                MathUtils::StoreInverseTransposeMatrix(worldMatrix, inverseTransposeWorldMatrix);
+
+                const MaterialTechniqueTextures* textures = nullptr;
+                if (hasTextures) {
+                    const std::unordered_map<const MaterialTechnique*, MaterialTechniqueTextures>::const_iterator findIt =
+                        texturesByMaterialTechnique.find(&materialTechnique);
+                    BRE_ASSERT(findIt != texturesByMaterialTechnique.end());
+                    textures = &findIt->second;
+                }
+
+                for (std::size_t j = 0UL; j < meshes.size(); ++j) {
+                    GeometryCommandListRecorder::GeometryData& geometryData =
+                        recorderData.mGeometryDataVector[modelData.mGeometryDataOffset + j];
+                    geometryData.mWorldMatrices[k] = worldMatrix;
+                    geometryData.mInverseTransposeWorldMatrices[k] = inverseTransposeWorldMatrix;
+                    geometryData.mTextureScales[k] = textureScale;
+
+                    if (hasMaterialConstants) {
+                        const XMFLOAT3& baseColor = materialTechnique.GetBaseColor();
+                        geometryData.mBaseColorsAndMetalnesses[k] = XMFLOAT4(baseColor.x,
+                                                                             baseColor.y,
+                                                                             baseColor.z,
+                                                                             materialTechnique.GetMetalness());
+                        geometryData.mRoughnesses[k] = materialTechnique.GetRoughness();
+                    }
+
+                    const std::size_t textureIndex = modelData.mTextureOffset + j * instanceCount + k;
+                    if (hasBaseColorTextures) {
+                        recorderData.mBaseColorTextures[textureIndex] = textures->mBaseColorTexture;
+                    }
+                    if (hasMetalnessRoughnessHeightTextures) {
+                        recorderData.mMetalnessRoughnessHeightTextures[textureIndex] = textures->mMetalnessRoughnessHeightTexture;
+                    }
+                    if (hasNormalTextures) {
+                        recorderData.mNormalTextures[textureIndex] = textures->mNormalTexture;
+                    }
+                }
+            };
+
+            if (modelData.mDrawableObjects != nullptr) {
+                const std::vector<DrawableObject>& drawableObjects = *modelData.mDrawableObjects;
+                tbb::parallel_for(tbb::blocked_range<std::size_t>(0, drawableObjects.size(), sDrawableObjectGrainSize),
+                                  [&](const tbb::blocked_range<size_t>& drawableObjectRange) {
+                    for (size_t k = drawableObjectRange.begin(); k != drawableObjectRange.end(); ++k) {
+                        const DrawableObject& drawableObject = drawableObjects[k];
+                        storeInstance(k,
+                                      drawableObject.GetWorldMatrix(),
+                                      drawableObject.GetTextureScale(),
+                                      drawableObject.GetMaterialTechnique());
+                    }
+                }
+                );
+            }
+
+            // Each chunk of instances knows where its instances of this technique type go.
+            for (std::size_t j = 0UL; j < modelData.mInstanceArrayObjects.size(); ++j) {
+                const DrawableObjectLoader::InstanceArrayObjects& instanceArrayObjects = *modelData.mInstanceArrayObjects[j];
+                const InstanceArray& instanceArray = *instanceArrayObjects.mInstanceArray;
+                const std::size_t instanceArrayOffset = modelData.mInstanceArrayOffsets[j];
+                const std::size_t chunkCount = instanceArrayObjects.mChunkOffsets.size() - 1UL;
+                tbb::parallel_for(tbb::blocked_range<std::size_t>(0, chunkCount, 1U),
+                                  [&](const tbb::blocked_range<size_t>& chunkRange) {
+                    for (size_t chunk = chunkRange.begin(); chunk != chunkRange.end(); ++chunk) {
+                        std::size_t k = instanceArrayOffset + instanceArrayObjects.mChunkOffsets[chunk];
+                        const std::uint32_t firstInstance =
+                            static_cast<std::uint32_t>(chunk) * DrawableObjectLoader::sInstanceChunkSize;
+                        const std::uint32_t lastInstance =
+                            std::min(firstInstance + DrawableObjectLoader::sInstanceChunkSize, instanceArray.GetInstanceCount());
+                        for (std::uint32_t instance = firstInstance; instance < lastInstance; ++instance) {
+                            const MaterialTechnique& materialTechnique =
+                                *instanceArrayObjects.mMaterialTechniques[instanceArray.GetMaterialTechniqueChoice(instance)];
+                            if (materialTechnique.GetType() != techniqueType) {
+                                continue;
+                            }
+
+                            XMFLOAT4X4 worldMatrix;
+                            instanceArray.ComputeWorldMatrix(instance, worldMatrix);
+                            storeInstance(k, worldMatrix, instanceArray.GetTextureScale(), materialTechnique);
+                            ++k;
+                        }
+                    }
+                }
+                );
+            }
+        }
+    }
+    );
+}
+
+///
+/// @brief Get the textures of a material technique. They are the ones its technique type samples.
+/// @param materialTechnique Material technique
+/// @param textureLoader Texture loader of the material technique textures
+/// @param sharedTextures Output reference counted textures, to keep them while they are used
+/// @param textures Output textures
+///
+void
+GetMaterialTechniqueTextures(const MaterialTechnique& materialTechnique,
+                             TextureLoader& textureLoader,
+                             std::vector<ResourceManager::SharedResource>& sharedTextures,
+                             std::vector<ID3D12Resource*>& textures) noexcept
+{
+    std::vector<StringId> textureNameIds;
+    materialTechnique.GetTextureNameIds(textureNameIds);
+
+    sharedTextures.clear();
+    textures.clear();
+    for (const StringId textureNameId : textureNameIds) {
+        sharedTextures.push_back(textureLoader.GetTexture(textureNameId));
+        textures.push_back(sharedTextures.back().get());
+    }
+}
+
+///
+/// @brief Computes the bounding sphere of a model in model space
+/// @param model Model
+/// @param modelBoundingSphere Output bounding sphere
+///
+void
+ComputeModelBoundingSphere(const Model& model,
+                           BoundingSphere& modelBoundingSphere) noexcept
+{
+    const std::vector<Mesh>& meshes = model.GetMeshes();
+    BRE_ASSERT(meshes.empty() == false);
+    BoundingBox modelBoundingBox = meshes[0].GetBoundingBox();
+    for (std::size_t i = 1U; i < meshes.size(); ++i) {
+        BoundingBox::CreateMerged(modelBoundingBox, modelBoundingBox, meshes[i].GetBoundingBox());
+    }
+    BoundingSphere::CreateFromBoundingBox(modelBoundingSphere, modelBoundingBox);
+}
+
+///
+/// @brief Computes the size of a world partition cell, once its geometry pass recorders are created
+///
+/// It is the per object data of its drawable objects (constant buffers, geometry data, textures),
+/// plus the models (with their meshlets) and the textures (with all their mip levels) they use.
+/// Models and textures shared with other loaded cells are loaded once, but they are counted
+/// in every cell, so it is an upper bound.
+///
+/// @param drawableObjectsByModelName Drawable objects by model name of the cell, by technique type
+/// @param modelNameIds Distinct model name identifiers of the cell
+/// @param textureNameIds Distinct texture name identifiers of the cell
+/// @param modelLoader Model loader of the drawable object models
+/// @param textureLoader Texture loader of the textures
+/// @return Size in bytes
+///
+std::uint64_t
+ComputeWorldPartitionCellSize(const DrawableObjectLoader::DrawableObjectsByModelName drawableObjectsByModelName[MaterialTechnique::NUM_TECHNIQUES],
+                              const std::vector<StringId>& modelNameIds,
+                              const std::vector<StringId>& textureNameIds,
+                              const ModelLoader& modelLoader,
+                              const TextureLoader& textureLoader) noexcept
+{
+    const std::uint64_t objectSizeInBytes =
+        UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(ObjectCBuffer)) +
+        sizeof(XMFLOAT4X4) * 2UL +
+        sizeof(XMFLOAT4) +
+        sizeof(float) * 2UL +
+        sizeof(ID3D12Resource*) * 3UL;
+
+    std::uint64_t cellSizeInBytes = 0UL;
+    for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+        for (const DrawableObjectLoader::DrawableObjectsByModelName::value_type& pair : drawableObjectsByModelName[techniqueType]) {
+            const std::vector<DrawableObject>& drawableObjects = pair.second;
+            BRE_ASSERT(drawableObjects.empty() == false);
+
+            const std::size_t meshCount = modelLoader.GetModelMeshCount(pair.first);
+            cellSizeInBytes += objectSizeInBytes * drawableObjects.size() * meshCount;
+        }
+    }
+
+    for (const StringId modelNameId : modelNameIds) {
+        cellSizeInBytes += modelLoader.GetModelSizeInBytes(modelNameId);
+    }
+
+    for (const StringId textureNameId : textureNameIds) {
+        cellSizeInBytes += textureLoader.GetTextureSizeInBytes(textureNameId);
+    }
+
+    return cellSizeInBytes;
+}
+
+///
+/// @brief Get the technique type of each material technique of a compiled scene
+/// @param compiledScene Compiled scene
+/// @param materialTechniqueLoader Material technique loader, with the material techniques of the compiled scene
+/// @param techniqueTypes Output technique types, by material technique index
+///
+void
+GetTechniqueTypes(const CompiledScene& compiledScene,
+                  const MaterialTechniqueLoader& materialTechniqueLoader,
+                  std::vector<MaterialTechnique::TechniqueType>& techniqueTypes) noexcept
+{
+    techniqueTypes.resize(compiledScene.GetMaterialTechniqueCount());
+    for (std::uint32_t i = 0U; i < compiledScene.GetMaterialTechniqueCount(); ++i) {
+        techniqueTypes[i] =
+            materialTechniqueLoader.GetMaterialTechnique(StringIdTable::GetStringId(compiledScene.GetMaterialTechniqueName(i))).GetType();
+    }
+}
+
+///
+/// @brief Technique types of the material techniques of a compiled scene, to mark the technique
+/// types whose geometry pass recorders must be generated again.
+///
+struct SceneTechniqueTypes {
+    const CompiledScene* mCompiledScene;
+    std::vector<MaterialTechnique::TechniqueType> mTechniqueTypes; // By material technique index
+    MaterialTechnique::TechniqueType mDefaultTechniqueType;
+
+    ///
+    /// @brief Marks the technique type of a drawable
+    /// @param drawableIndex Drawable index
+    /// @param isTechniqueTypeChanged Output technique type flags
+    ///
+    void MarkDrawable(const std::uint32_t drawableIndex,
+                      bool isTechniqueTypeChanged[MaterialTechnique::NUM_TECHNIQUES]) const noexcept
+    {
+        const std::uint32_t materialTechniqueIndex =
+            mCompiledScene->GetDrawables()[drawableIndex].mMaterialTechniqueIndex;
+        isTechniqueTypeChanged[materialTechniqueIndex == CompiledScene::sDefaultMaterialTechniqueIndex ?
+            mDefaultTechniqueType :
+            mTechniqueTypes[materialTechniqueIndex]] = true;
+    }
+
+    ///
+    /// @brief Marks the technique types of every material technique of an instance array
+    /// @param instanceArrayIndex Instance array index
+    /// @param isTechniqueTypeChanged Output technique type flags
+    ///
+    void MarkInstanceArray(const std::uint32_t instanceArrayIndex,
+                           bool isTechniqueTypeChanged[MaterialTechnique::NUM_TECHNIQUES]) const noexcept
+    {
+        const CompiledScene::InstanceArray& instanceArray = mCompiledScene->GetInstanceArrays()[instanceArrayIndex];
+        if (instanceArray.mMaterialTechniqueCount == 0U) {
+            isTechniqueTypeChanged[mDefaultTechniqueType] = true;
+        }
+
+        const std::uint32_t* materialTechniqueIndices =
+            mCompiledScene->GetInstanceArrayMaterialTechniques() + instanceArray.mFirstMaterialTechnique;
+        for (std::uint32_t i = 0U; i < instanceArray.mMaterialTechniqueCount; ++i) {
+            isTechniqueTypeChanged[mTechniqueTypes[materialTechniqueIndices[i]]] = true;
+        }
+    }
+
+    ///
+    /// @brief Marks the technique types of the drawables and instance arrays that refer
+    /// to a changed model or material technique
+    /// @param sceneDiff Scene differences
+    /// @param isTechniqueTypeChanged Output technique type flags
+    ///
+    void MarkChangedAssetUsers(const SceneDiffer::SceneDiff& sceneDiff,
+                               bool isTechniqueTypeChanged[MaterialTechnique::NUM_TECHNIQUES]) const noexcept
+    {
+        if (sceneDiff.mModelChanges.mChangedNames.empty() &&
+            sceneDiff.mMaterialTechniqueChanges.mChangedNames.empty()) {
+            return;
+        }
+
+        // Names are checked once, and not per drawable
+        const std::unordered_set<std::string> changedModelNames(sceneDiff.mModelChanges.mChangedNames.begin(),
+                                                                sceneDiff.mModelChanges.mChangedNames.end());
+        std::vector<bool> isModelChanged(mCompiledScene->GetModelCount(), false);
+        for (std::uint32_t i = 0U; i < mCompiledScene->GetModelCount(); ++i) {
+            isModelChanged[i] = changedModelNames.find(mCompiledScene->GetModelName(i)) != changedModelNames.end();
+        }
+
+        const std::unordered_set<std::string> changedMaterialTechniqueNames(
+            sceneDiff.mMaterialTechniqueChanges.mChangedNames.begin(),
+            sceneDiff.mMaterialTechniqueChanges.mChangedNames.end());
+        std::vector<bool> isMaterialTechniqueChanged(mCompiledScene->GetMaterialTechniqueCount(), false);
+        for (std::uint32_t i = 0U; i < mCompiledScene->GetMaterialTechniqueCount(); ++i) {
+            isMaterialTechniqueChanged[i] =
+                changedMaterialTechniqueNames.find(mCompiledScene->GetMaterialTechniqueName(i)) != changedMaterialTechniqueNames.end();
+            if (isMaterialTechniqueChanged[i]) {
+                isTechniqueTypeChanged[mTechniqueTypes[i]] = true;
+            }
+        }
+
+        const CompiledScene::Drawable* drawables = mCompiledScene->GetDrawables();
+        for (std::uint32_t i = 0U; i < mCompiledScene->GetDrawableCount(); ++i) {
+            if (isModelChanged[drawables[i].mModelIndex]) {
+                MarkDrawable(i, isTechniqueTypeChanged);
+            }
+        }
+
+        const CompiledScene::InstanceArray* instanceArrays = mCompiledScene->GetInstanceArrays();
+        for (std::uint32_t i = 0U; i < mCompiledScene->GetInstanceArrayCount(); ++i) {
+            if (isModelChanged[instanceArrays[i].mModelIndex]) {
+                MarkInstanceArray(i, isTechniqueTypeChanged);
+            }
+        }
+    }
+};
+}
+
 SceneLoader::SceneLoader()
     : mMaterialTechniqueLoader(mTextureLoader)
     , mDrawableObjectLoader(mMaterialTechniqueLoader, mModelLoader)
     , mEnvironmentLoader(mTextureLoader)
 {
-
-    mCommandAllocator = &CommandAllocatorManager::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
-    mCommandList = &CommandListManager::CreateCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT, *mCommandAllocator);
-    mCommandList->Close();
 };
 
+SceneLoader::~SceneLoader()
+{
+    // Cell load tasks use the loaders
+    mWorldPartitionCellLoadTasks.wait();
+}
+
 Scene*
 SceneLoader::LoadScene(const char* sceneFilePath) noexcept
 {
     BRE_ASSERT(sceneFilePath != nullptr);
 
-    const YAML::Node rootNode = YAML::LoadFile(sceneFilePath);
+    // Cell load tasks use the loaders and the drawable objects
+    WaitForWorldPartitionCellLoads();
+
+    // If another scene was loaded, then its drawable objects and recorders are replaced,
+    // and its assets are kept, so the ones this scene shares with it are not loaded again.
+    if (mCompiledScene.get() != nullptr) {
+        mDrawableObjectLoader.Clear();
+        TextureStreamer::RemoveTextureUsers();
+    }
+
+    // Drawable objects are loaded from the compiled scene, and the rest
+    // from its assets document, that is much smaller than the scene file.
+    // The compiled scene is kept open, to compare it with the modified scene file.
+    const std::string compiledSceneFilePath = SceneCooker::CookSceneFile(sceneFilePath);
+    mSceneFilePath = sceneFilePath;
+    mCompiledScene.reset(new CompiledScene);
+    CompiledScene& compiledScene = *mCompiledScene;
     const std::wstring errorMsg =
-        L"Failed to open yaml file: " + StringUtils::AnsiToWideString(sceneFilePath);
+        L"Failed to open compiled scene file: " + StringUtils::AnsiToWideString(compiledSceneFilePath);
+    BRE_CHECK_MSG(compiledScene.Open(compiledSceneFilePath.c_str()), errorMsg.c_str());
+    const YAML::Node rootNode = YAML::Load(compiledScene.GetAssetsDocument());
     BRE_CHECK_MSG(rootNode.IsDefined(), errorMsg.c_str());
 
-    mModelLoader.LoadModels(rootNode, *mCommandAllocator, *mCommandList);
-    mTextureLoader.LoadTextures(rootNode, *mCommandAllocator, *mCommandList);
+    mModelLoader.LoadModels(rootNode);
+    mTextureLoader.LoadTextures(rootNode);
+
+    const std::wstring stagingMemoryMsg =
+        L"Staging ring buffer: peak " + std::to_wstring(StagingRingBuffer::GetPeakUsedSizeInBytes()) +
+        L" of " + std::to_wstring(StagingRingBuffer::GetSizeInBytes()) + L" bytes, " +
+        std::to_wstring(StagingRingBuffer::GetTotalUploadedSizeInBytes()) + L" bytes uploaded\n";
+    BRE_LOG_MSG(stagingMemoryMsg.c_str());
     mMaterialTechniqueLoader.LoadMaterialTechniques(rootNode);
-    mDrawableObjectLoader.LoadDrawableObjects(rootNode);
+    mDrawableObjectLoader.LoadDrawableObjects(compiledScene);
     mEnvironmentLoader.LoadEnvironment(rootNode);
     mCameraLoader.LoadCamera(rootNode);
+    RegisterTextureStreamingUsers();
+
+    // The world partition cells around the camera are loaded before the first frame
+    const XMFLOAT4 cameraPosition = mCameraLoader.GetCamera().GetPosition4f();
+    mWorldPartitionCameraPosition = XMFLOAT3(cameraPosition.x, cameraPosition.y, cameraPosition.z);
+    BuildWorldPartition();
+    LoadWorldPartitionCellsAroundCamera();
 
     Scene* scene = new Scene;
     GenerateGeometryPassRecorders(*scene);
@@ -56,12 +622,181 @@ SceneLoader::LoadScene(const char* sceneFilePath) noexcept
     return scene;
 }
 
+bool
+SceneLoader::ReloadScene(GeometryCommandListRecorders& commandListRecorders) noexcept
+{
+    BRE_ASSERT(mCompiledScene.get() != nullptr);
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    // The modified scene is cooked in memory, so the compiled scene file cache is not filled
+    // with the files of every edit.
+    std::vector<std::uint8_t> compiledSceneData;
+    SceneCooker::CookScene(mSceneFilePath.c_str(), compiledSceneData);
+    std::unique_ptr<CompiledScene> compiledScene(new CompiledScene);
+    const std::wstring errorMsg =
+        L"Failed to open compiled scene: " + StringUtils::AnsiToWideString(mSceneFilePath);
+    BRE_CHECK_MSG(compiledScene->Open(compiledSceneData), errorMsg.c_str());
+
+    SceneDiffer::SceneDiff sceneDiff;
+    SceneDiffer::ComputeSceneDiff(*mCompiledScene, *compiledScene, sceneDiff);
+    if (sceneDiff.IsEmpty()) {
+        BRE_LOG_MSG(L"Scene reload: no changes\n");
+        return false;
+    }
+
+    if (compiledScene->GetDrawableCount() == 0U && compiledScene->GetInstanceArrayCount() == 0U) {
+        BRE_LOG_MSG(L"Scene reload: the scene has no drawable objects, so it is not reloaded\n");
+        return false;
+    }
+
+    // Technique types of the loaded scene are taken before its material techniques are replaced.
+    SceneTechniqueTypes oldSceneTechniqueTypes;
+    oldSceneTechniqueTypes.mCompiledScene = mCompiledScene.get();
+    oldSceneTechniqueTypes.mDefaultTechniqueType = mMaterialTechniqueLoader.GetDefaultMaterialTechnique().GetType();
+    GetTechniqueTypes(*mCompiledScene, mMaterialTechniqueLoader, oldSceneTechniqueTypes.mTechniqueTypes);
+
+    const YAML::Node rootNode = YAML::Load(compiledScene->GetAssetsDocument());
+    BRE_CHECK_MSG(rootNode.IsDefined(), errorMsg.c_str());
+
+    // Cell load tasks use the loaders and the drawable objects
+    WaitForWorldPartitionCellLoads();
+
+    // Loaders reuse the files they already loaded. Material techniques refer to textures,
+    // and channel packed textures depend on material techniques, so they are loaded together.
+    if (sceneDiff.mModelChanges.IsEmpty() == false) {
+        mModelLoader.LoadModels(rootNode);
+    }
+
+    if (sceneDiff.mTextureChanges.IsEmpty() == false || sceneDiff.mMaterialTechniqueChanges.IsEmpty() == false) {
+        mTextureLoader.LoadTextures(rootNode);
+        mMaterialTechniqueLoader.LoadMaterialTechniques(rootNode);
+    }
+
+    // Drawable objects refer to models and material techniques that could be replaced,
+    // and they are cheap to load, so they are loaded again.
+    mDrawableObjectLoader.Clear();
+    mDrawableObjectLoader.LoadDrawableObjects(*compiledScene);
+
+    if (sceneDiff.mHasEnvironmentChanged || sceneDiff.mHasCameraChanged || sceneDiff.mHaveSettingsChanged) {
+        BRE_LOG_MSG(L"Scene reload: environment, camera and settings changes are applied on restart\n");
+    }
+
+    SceneTechniqueTypes newSceneTechniqueTypes;
+    newSceneTechniqueTypes.mCompiledScene = compiledScene.get();
+    newSceneTechniqueTypes.mDefaultTechniqueType = oldSceneTechniqueTypes.mDefaultTechniqueType;
+    GetTechniqueTypes(*compiledScene, mMaterialTechniqueLoader, newSceneTechniqueTypes.mTechniqueTypes);
+
+    // Only the recorders of the technique types with differences are generated again.
+    // Changed material techniques can change their technique type, so both scenes are checked.
+    bool isTechniqueTypeChanged[MaterialTechnique::NUM_TECHNIQUES]{ false };
+    for (const std::uint32_t drawableIndex : sceneDiff.mAddedDrawables) {
+        newSceneTechniqueTypes.MarkDrawable(drawableIndex, isTechniqueTypeChanged);
+    }
+    for (const std::uint32_t drawableIndex : sceneDiff.mRemovedDrawables) {
+        oldSceneTechniqueTypes.MarkDrawable(drawableIndex, isTechniqueTypeChanged);
+    }
+    for (const std::pair<std::uint32_t, std::uint32_t>& drawableIndices : sceneDiff.mChangedDrawables) {
+        oldSceneTechniqueTypes.MarkDrawable(drawableIndices.first, isTechniqueTypeChanged);
+        newSceneTechniqueTypes.MarkDrawable(drawableIndices.second, isTechniqueTypeChanged);
+    }
+    for (const std::uint32_t instanceArrayIndex : sceneDiff.mAddedInstanceArrays) {
+        newSceneTechniqueTypes.MarkInstanceArray(instanceArrayIndex, isTechniqueTypeChanged);
+    }
+    for (const std::uint32_t instanceArrayIndex : sceneDiff.mRemovedInstanceArrays) {
+        oldSceneTechniqueTypes.MarkInstanceArray(instanceArrayIndex, isTechniqueTypeChanged);
+    }
+    for (const std::pair<std::uint32_t, std::uint32_t>& instanceArrayIndices : sceneDiff.mChangedInstanceArrays) {
+        oldSceneTechniqueTypes.MarkInstanceArray(instanceArrayIndices.first, isTechniqueTypeChanged);
+        newSceneTechniqueTypes.MarkInstanceArray(instanceArrayIndices.second, isTechniqueTypeChanged);
+    }
+    oldSceneTechniqueTypes.MarkChangedAssetUsers(sceneDiff, isTechniqueTypeChanged);
+    newSceneTechniqueTypes.MarkChangedAssetUsers(sceneDiff, isTechniqueTypeChanged);
+
+    std::uint32_t generatedRecorderCount = 0U;
+    for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+        if (isTechniqueTypeChanged[techniqueType]) {
+            GenerateGeometryPassRecorder(static_cast<MaterialTechnique::TechniqueType>(techniqueType));
+            ++generatedRecorderCount;
+        }
+    }
+
+    // Texture streaming users are not tracked by drawable object, so every one is registered again.
+    TextureStreamer::RemoveTextureUsers();
+    RegisterTextureStreamingUsers();
+
+    // World partition cells are split again, and the ones around the last camera position are loaded again.
+    BuildWorldPartition();
+    LoadWorldPartitionCellsAroundCamera();
+    GetGeometryPassRecorders(commandListRecorders);
+
+    // Instance arrays copy what they need, so the loaded compiled scene is not used anymore.
+    mCompiledScene.swap(compiledScene);
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+    const std::wstring reloadMsg =
+        L"Scene reload: " + std::to_wstring(sceneDiff.mAddedDrawables.size()) + L" drawable objects added, " +
+        std::to_wstring(sceneDiff.mRemovedDrawables.size()) + L" removed, " +
+        std::to_wstring(sceneDiff.mChangedDrawables.size()) + L" changed, " +
+        std::to_wstring(generatedRecorderCount) + L" geometry pass recorders generated in " +
+        std::to_wstring(std::chrono::duration<double, std::milli>(endTime - startTime).count()) + L" ms\n";
+    BRE_LOG_MSG(reloadMsg.c_str());
+
+    // The geometry pass needs recorders, so they are not replaced if the camera is far from every cell,
+    // and there are no instance arrays.
+    return (generatedRecorderCount != 0U || ApplicationSettings::sIsWorldPartitionEnabled) &&
+        commandListRecorders.empty() == false;
+}
+
+void
+SceneLoader::ReleaseUnusedAssets() noexcept
+{
+    BRE_ASSERT(mCompiledScene.get() != nullptr);
+
+    const std::size_t releasedModelCount = mModelLoader.ReleaseUnusedModels();
+    const std::size_t releasedTextureCount = mTextureLoader.ReleaseUnusedTextures();
+
+    const std::wstring releaseMsg =
+        L"Scene assets: " + std::to_wstring(releasedModelCount) + L" models and " +
+        std::to_wstring(releasedTextureCount) + L" textures released\n";
+    BRE_LOG_MSG(releaseMsg.c_str());
+}
+
+void
+SceneLoader::GetSceneFilePaths(std::vector<std::string>& filePaths) const noexcept
+{
+    BRE_ASSERT(mCompiledScene.get() != nullptr);
+
+    filePaths.clear();
+    for (std::uint32_t i = 0U; i < mCompiledScene->GetDependencyCount(); ++i) {
+        filePaths.push_back(mCompiledScene->GetDependencyPath(i));
+    }
+}
+
+bool
+SceneLoader::UpdateWorldPartition(const XMFLOAT3& cameraPosition,
+                                  GeometryCommandListRecorders& commandListRecorders) noexcept
+{
+    BRE_ASSERT(mCompiledScene.get() != nullptr);
+
+    if (UpdateWorldPartitionCells(cameraPosition) == false) {
+        return false;
+    }
+
+    GetGeometryPassRecorders(commandListRecorders);
+
+    // The geometry pass needs recorders, so if the camera is far from every cell and there are
+    // no instance arrays, then the recorders of the unloaded cells are kept until a cell is loaded.
+    return commandListRecorders.empty() == false;
+}
+
 void
 SceneLoader::GenerateGeometryPassRecorders(Scene& scene) noexcept
 {
-    GenerateGeometryPassRecordersForTextureMapping(scene.GetGeometryCommandListRecorders());
-    GenerateGeometryPassRecordersForNormalMapping(scene.GetGeometryCommandListRecorders());
-    GenerateGeometryPassRecordersForHeightMapping(scene.GetGeometryCommandListRecorders());
+    for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+        GenerateGeometryPassRecorder(static_cast<MaterialTechnique::TechniqueType>(techniqueType));
+    }
+    GetGeometryPassRecorders(scene.GetGeometryCommandListRecorders());
 
     scene.GetSkyBoxCubeMap() = &mEnvironmentLoader.GetSkyBoxTexture();
     scene.GetDiffuseIrradianceCubeMap() = &mEnvironmentLoader.GetDiffuseIrradianceTexture();
@@ -69,227 +804,528 @@ SceneLoader::GenerateGeometryPassRecorders(Scene& scene) noexcept
 }
 
 void
-SceneLoader::GenerateGeometryPassRecordersForTextureMapping(GeometryCommandListRecorders& commandListRecorders) noexcept
+SceneLoader::GenerateGeometryPassRecorder(const MaterialTechnique::TechniqueType techniqueType) noexcept
 {
+    BRE_ASSERT(techniqueType < MaterialTechnique::NUM_TECHNIQUES);
+
+    mGeometryCommandListRecorders[techniqueType].reset();
+
+    // Drawable objects of the world partition cells are in the recorders of the cells
     const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName =
-        mDrawableObjectLoader.GetDrawableObjectsByModelNameByTechniqueType(MaterialTechnique::TEXTURE_MAPPING);
+        ApplicationSettings::sIsWorldPartitionEnabled ?
+        sNoDrawableObjects :
+        mDrawableObjectLoader.GetDrawableObjectsByModelNameByTechniqueType(techniqueType);
 
-    if (drawableObjectsByModelName.empty()) {
-        return;
+    mGeometryCommandListRecorders[techniqueType] =
+        CreateGeometryPassRecorder(techniqueType,
+                                   drawableObjectsByModelName,
+                                   mDrawableObjectLoader.GetInstanceArrayObjectsByTechniqueType(techniqueType));
+}
+
+void
+SceneLoader::GetGeometryPassRecorders(GeometryCommandListRecorders& commandListRecorders) const noexcept
+{
+    commandListRecorders.clear();
+    for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+        if (mGeometryCommandListRecorders[techniqueType].get() != nullptr) {
+            commandListRecorders.push_back(mGeometryCommandListRecorders[techniqueType]);
+        }
+
+        for (const std::uint32_t cellId : mLoadedWorldPartitionCellIds) {
+            const GeometryCommandListRecorders::value_type& commandListRecorder =
+                mWorldPartitionCells[cellId].mGeometryCommandListRecorders[techniqueType];
+            if (commandListRecorder.get() != nullptr) {
+                commandListRecorders.push_back(commandListRecorder);
+            }
+        }
     }
+}
 
-    // Iterate over Drawable objects and fill containers needed
-    // to initialize the command list recorder.
-    TextureMappingCommandListRecorder* commandListRecorder = new TextureMappingCommandListRecorder;
-    std::vector<GeometryCommandListRecorder::GeometryData> geometryDataVector;
-    std::vector<ID3D12Resource*> baseColorTextures;
-    std::vector<ID3D12Resource*> metalnessTextures;
-    std::vector<ID3D12Resource*> roughnessTextures;
+void
+SceneLoader::RegisterTextureStreamingUsers() noexcept
+{
+    // Color mapping samples no texture
+    const MaterialTechnique::TechniqueType textureTechniqueTypes[]{
+        MaterialTechnique::COLOR_NORMAL_MAPPING,
+        MaterialTechnique::COLOR_HEIGHT_MAPPING,
+        MaterialTechnique::TEXTURE_MAPPING,
+        MaterialTechnique::NORMAL_MAPPING,
+        MaterialTechnique::HEIGHT_MAPPING,
+    };
+
+    std::vector<ResourceManager::SharedResource> sharedTextures;
+    std::vector<ID3D12Resource*> textures;
+    BoundingSphere modelBoundingSphere;
+    BoundingSphere worldBoundingSphere;
+    for (const MaterialTechnique::TechniqueType techniqueType : textureTechniqueTypes) {
+        // Drawable objects of world partition cells are registered by their cells
+        if (ApplicationSettings::sIsWorldPartitionEnabled == false) {
+            AddTextureStreamingUsers(sSceneTextureStreamingUserId,
+                                     mDrawableObjectLoader.GetDrawableObjectsByModelNameByTechniqueType(techniqueType));
+        }
+
+        // Instances are generated again, because they are not stored.
+        const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector =
+            mDrawableObjectLoader.GetInstanceArrayObjectsByTechniqueType(techniqueType);
+        for (const DrawableObjectLoader::InstanceArrayObjects& instanceArrayObjects : instanceArrayObjectsVector) {
+            const InstanceArray& instanceArray = *instanceArrayObjects.mInstanceArray;
+            ComputeModelBoundingSphere(*instanceArrayObjects.mModel, modelBoundingSphere);
+
+            for (std::uint32_t i = 0U; i < instanceArray.GetInstanceCount(); ++i) {
+                const MaterialTechnique& materialTechnique =
+                    *instanceArrayObjects.mMaterialTechniques[instanceArray.GetMaterialTechniqueChoice(i)];
+                if (materialTechnique.GetType() != techniqueType) {
+                    continue;
+                }
+
+                GetMaterialTechniqueTextures(materialTechnique, mTextureLoader, sharedTextures, textures);
+                XMFLOAT4X4 worldMatrix;
+                instanceArray.ComputeWorldMatrix(i, worldMatrix);
+                modelBoundingSphere.Transform(worldBoundingSphere, XMLoadFloat4x4(&worldMatrix));
+
+                TextureStreamer::AddDrawableObject(sSceneTextureStreamingUserId,
+                                                   worldBoundingSphere,
+                                                   instanceArray.GetTextureScale(),
+                                                   textures.data(),
+                                                   static_cast<std::uint32_t>(textures.size()));
+            }
+        }
+    }
+
+    // Environment cube maps are sampled all over the screen
+    TextureStreamer::AddFullScreenTexture(mEnvironmentLoader.GetSkyBoxTexture());
+    TextureStreamer::AddFullScreenTexture(mEnvironmentLoader.GetDiffuseIrradianceTexture());
+    TextureStreamer::AddFullScreenTexture(mEnvironmentLoader.GetSpecularPreConvolvedEnvironmentTexture());
+}
 
-    std::size_t geometryDataVectorOffset = 0;
+void
+SceneLoader::AddTextureStreamingUsers(const std::uint32_t userId,
+                                      const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName) noexcept
+{
+    // Consecutive drawable objects usually share their material technique,
+    // so its textures are got again only when it changes.
+    std::vector<ResourceManager::SharedResource> sharedTextures;
+    std::vector<ID3D12Resource*> textures;
+    const MaterialTechnique* lastMaterialTechnique = nullptr;
+    BoundingSphere modelBoundingSphere;
+    BoundingSphere worldBoundingSphere;
     for (const DrawableObjectLoader::DrawableObjectsByModelName::value_type& pair : drawableObjectsByModelName) {
         const std::vector<DrawableObject>& drawableObjects = pair.second;
         BRE_ASSERT(drawableObjects.empty() == false);
 
-        // Build geometry data vertex and index buffers for all meshes
-        const Model& model = drawableObjects[0].GetModel();
-        const std::vector<Mesh>& meshes = model.GetMeshes();
-        const std::size_t totalDataCount = meshes.size() * drawableObjects.size();
-        geometryDataVector.reserve(geometryDataVector.size() + totalDataCount);
-        for (std::uint32_t i = 0U; i < meshes.size(); ++i) {
-            const Mesh& mesh = meshes[i];
-            GeometryCommandListRecorder::GeometryData geometryData;
-            geometryData.mVertexBufferData = mesh.GetVertexBufferData();
-            geometryData.mIndexBufferData = mesh.GetIndexBufferData();
-            geometryData.mWorldMatrices.reserve(drawableObjects.size());
-            geometryData.mInverseTransposeWorldMatrices.reserve(drawableObjects.size());
-            geometryData.mTextureScales.reserve(drawableObjects.size());
-            geometryDataVector.emplace_back(geometryData);
+        // All the drawable objects of a model share its bounding sphere in model space
+        ComputeModelBoundingSphere(*mModelLoader.GetModel(pair.first), modelBoundingSphere);
+
+        for (const DrawableObject& drawableObject : drawableObjects) {
+            if (&drawableObject.GetMaterialTechnique() != lastMaterialTechnique) {
+                lastMaterialTechnique = &drawableObject.GetMaterialTechnique();
+                GetMaterialTechniqueTextures(*lastMaterialTechnique, mTextureLoader, sharedTextures, textures);
+            }
+            modelBoundingSphere.Transform(worldBoundingSphere, XMLoadFloat4x4(&drawableObject.GetWorldMatrix()));
+
+            TextureStreamer::AddDrawableObject(userId,
+                                               worldBoundingSphere,
+                                               drawableObject.GetTextureScale(),
+                                               textures.data(),
+                                               static_cast<std::uint32_t>(textures.size()));
         }
+    }
+}
+
+void
+SceneLoader::BuildWorldPartition() noexcept
+{
+    WaitForWorldPartitionCellLoads();
+    for (const std::uint32_t cellId : mLoadedWorldPartitionCellIds) {
+        TextureStreamer::RemoveDrawableObjects(cellId + 1U);
+    }
+    mWorldPartitionCells.clear();
+    mLoadedWorldPartitionCellIds.clear();
+    mWorldPartitionScheduler.Clear();
+
+    if (ApplicationSettings::sIsWorldPartitionEnabled == false) {
+        return;
+    }
+
+    BRE_CHECK_MSG(ApplicationSettings::sWorldPartitionCellSize > 0.0f,
+                  L"World partition cell size must be greater than zero");
+    BRE_CHECK_MSG(ApplicationSettings::sWorldPartitionLoadRadius >= 0.0f &&
+                  ApplicationSettings::sWorldPartitionUnloadRadius >= ApplicationSettings::sWorldPartitionLoadRadius,
+                  L"World partition unload radius must be greater or equal than its load radius");
+    BRE_CHECK_MSG(ApplicationSettings::sWorldPartitionCellLoadsPerUpdate > 0U,
+                  L"World partition cell loads per update must be greater than zero");
 
-        // Iterate all the meses and store data for all the drawable objects.
-        for (std::uint32_t i = 0U; i < meshes.size(); ++i) {
-            GeometryCommandListRecorder::GeometryData& geometryData =
-                geometryDataVector[geometryDataVectorOffset + i];
+    mWorldPartitionScheduler.Init(ApplicationSettings::sWorldPartitionCellSize,
+                                  ApplicationSettings::sWorldPartitionLoadRadius,
+                                  ApplicationSettings::sWorldPartitionUnloadRadius,
+                                  ApplicationSettings::sWorldPartitionMemoryBudgetInBytes,
+                                  ApplicationSettings::sWorldPartitionCellLoadsPerUpdate);
 
-            for (const DrawableObject& drawableObject : drawableObjects) {
-                // Store textures
-                const MaterialTechnique& materialTechnique = drawableObject.GetMaterialTechnique();
-                baseColorTextures.push_back(&materialTechnique.GetBaseColorTexture());
-                metalnessTextures.push_back(&materialTechnique.GetMetalnessTexture());
-                roughnessTextures.push_back(&materialTechnique.GetRoughnessTexture());
+    // Drawable objects go to the cell that contains their position
+    std::map<std::pair<std::int32_t, std::int32_t>, std::size_t> cellIndexByCoordinates;
+    std::vector<std::pair<std::int32_t, std::int32_t>> cellCoordinates;
+    for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+        const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName =
+            mDrawableObjectLoader.GetDrawableObjectsByModelNameByTechniqueType(static_cast<MaterialTechnique::TechniqueType>(techniqueType));
 
-                // Store matrices and texture scale
+        for (const DrawableObjectLoader::DrawableObjectsByModelName::value_type& pair : drawableObjectsByModelName) {
+            for (const DrawableObject& drawableObject : pair.second) {
                 const XMFLOAT4X4& worldMatrix = drawableObject.GetWorldMatrix();
-                XMFLOAT4X4 inverseTransposeWorldMatrix;
-                MathUtils::StoreInverseTransposeMatrix(worldMatrix, inverseTransposeWorldMatrix);
-                geometryData.mWorldMatrices.push_back(worldMatrix);
-                geometryData.mInverseTransposeWorldMatrices.push_back(inverseTransposeWorldMatrix);
-                geometryData.mTextureScales.push_back(drawableObject.GetTextureScale());
+                const std::pair<std::int32_t, std::int32_t> coordinates(mWorldPartitionScheduler.ComputeCellCoordinate(worldMatrix._41),
+                                                                        mWorldPartitionScheduler.ComputeCellCoordinate(worldMatrix._43));
+                const std::pair<std::map<std::pair<std::int32_t, std::int32_t>, std::size_t>::iterator, bool> insertResult =
+                    cellIndexByCoordinates.emplace(coordinates, cellCoordinates.size());
+                if (insertResult.second) {
+                    cellCoordinates.push_back(coordinates);
+                    mWorldPartitionCells.emplace_back();
+                }
+
+                WorldPartitionCell& cell = mWorldPartitionCells[insertResult.first->second];
+                cell.mDrawableObjectsByModelName[techniqueType][pair.first].push_back(drawableObject);
             }
         }
-
-        geometryDataVectorOffset += meshes.size();
     }
 
-    commandListRecorder->Init(geometryDataVector,
-                              baseColorTextures,
-                              metalnessTextures,
-                              roughnessTextures);
+    // Cells record the distinct models and textures of their drawable objects, to count them in their size.
+    // Cell identifiers are the cell indices.
+    for (std::size_t i = 0UL; i < cellCoordinates.size(); ++i) {
+        WorldPartitionCell& cell = mWorldPartitionCells[i];
+        std::unordered_set<const MaterialTechnique*> materialTechniques;
+        for (const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName : cell.mDrawableObjectsByModelName) {
+            for (const DrawableObjectLoader::DrawableObjectsByModelName::value_type& pair : drawableObjectsByModelName) {
+                cell.mModelNameIds.push_back(pair.first);
+                for (const DrawableObject& drawableObject : pair.second) {
+                    materialTechniques.insert(&drawableObject.GetMaterialTechnique());
+                }
+            }
+        }
+
+        for (const MaterialTechnique* materialTechnique : materialTechniques) {
+            materialTechnique->GetTextureNameIds(cell.mTextureNameIds);
+        }
+
+        std::sort(cell.mModelNameIds.begin(), cell.mModelNameIds.end());
+        cell.mModelNameIds.erase(std::unique(cell.mModelNameIds.begin(), cell.mModelNameIds.end()),
+                                 cell.mModelNameIds.end());
+        std::sort(cell.mTextureNameIds.begin(), cell.mTextureNameIds.end());
+        cell.mTextureNameIds.erase(std::unique(cell.mTextureNameIds.begin(), cell.mTextureNameIds.end()),
+                                   cell.mTextureNameIds.end());
+
+        mWorldPartitionScheduler.AddCell(cellCoordinates[i].first,
+                                         cellCoordinates[i].second,
+                                         ComputeWorldPartitionCellSize(cell.mDrawableObjectsByModelName,
+                                                                       cell.mModelNameIds,
+                                                                       cell.mTextureNameIds,
+                                                                       mModelLoader,
+                                                                       mTextureLoader));
+    }
 
-    commandListRecorders.push_back(std::unique_ptr<GeometryCommandListRecorder>(commandListRecorder));
+    const std::wstring worldPartitionMsg =
+        L"World partition: " + std::to_wstring(mWorldPartitionCells.size()) + L" cells\n";
+    BRE_LOG_MSG(worldPartitionMsg.c_str());
 }
 
-void
-SceneLoader::GenerateGeometryPassRecordersForNormalMapping(GeometryCommandListRecorders& commandListRecorders) noexcept
+bool
+SceneLoader::UpdateWorldPartitionCells(const XMFLOAT3& cameraPosition) noexcept
 {
-    const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName =
-        mDrawableObjectLoader.GetDrawableObjectsByModelNameByTechniqueType(MaterialTechnique::NORMAL_MAPPING);
+    mWorldPartitionCameraPosition = cameraPosition;
+    if (mWorldPartitionCells.empty()) {
+        return false;
+    }
 
-    if (drawableObjectsByModelName.empty()) {
-        return;
+    // Finished cells are loaded before the update, so the scheduler can unload them or load more cells
+    const bool haveCellLoadsFinished = FinishWorldPartitionCellLoads();
+
+    std::vector<std::uint32_t> cellsToLoad;
+    std::vector<std::uint32_t> cellsToUnload;
+    mWorldPartitionScheduler.Update(cameraPosition.x, cameraPosition.z, cellsToLoad, cellsToUnload);
+
+    for (const std::uint32_t cellId : cellsToUnload) {
+        UnloadWorldPartitionCell(cellId);
+
+        const std::vector<std::uint32_t>::iterator findIt =
+            std::find(mLoadedWorldPartitionCellIds.begin(), mLoadedWorldPartitionCellIds.end(), cellId);
+        BRE_ASSERT(findIt != mLoadedWorldPartitionCellIds.end());
+        *findIt = mLoadedWorldPartitionCellIds.back();
+        mLoadedWorldPartitionCellIds.pop_back();
     }
 
-    // Iterate over Drawable objects and fill containers needed
-    // to initialize the command list recorder.
-    NormalMappingCommandListRecorder* commandListRecorder = new NormalMappingCommandListRecorder;
-    std::vector<GeometryCommandListRecorder::GeometryData> geometryDataVector;
-    std::vector<ID3D12Resource*> baseColorTextures;
-    std::vector<ID3D12Resource*> metalnessTextures;
-    std::vector<ID3D12Resource*> roughnessTextures;
-    std::vector<ID3D12Resource*> normalTextures;
+    // Cells are loaded by tasks while the previous recorders are rendered, and the scheduler
+    // limits the number of loading cells. Loading cells are not unloaded until they are loaded.
+    for (const std::uint32_t cellId : cellsToLoad) {
+        mWorldPartitionCellLoads.emplace_back(new WorldPartitionCellLoad);
+        WorldPartitionCellLoad* cellLoad = mWorldPartitionCellLoads.back().get();
+        cellLoad->mCellId = cellId;
+        mWorldPartitionCellLoadTasks.run([this, cellLoad]() {
+            LoadWorldPartitionCell(*cellLoad);
+        });
+    }
 
-    std::size_t geometryDataVectorOffset = 0;
-    for (const DrawableObjectLoader::DrawableObjectsByModelName::value_type& pair : drawableObjectsByModelName) {
-        const std::vector<DrawableObject>& drawableObjects = pair.second;
-        BRE_ASSERT(drawableObjects.empty() == false);
+    return haveCellLoadsFinished || cellsToUnload.empty() == false;
+}
+
+void
+SceneLoader::LoadWorldPartitionCellsAroundCamera() noexcept
+{
+    UpdateWorldPartitionCells(mWorldPartitionCameraPosition);
+    while (mWorldPartitionCellLoads.empty() == false) {
+        WaitForWorldPartitionCellLoads();
+        UpdateWorldPartitionCells(mWorldPartitionCameraPosition);
+    }
+}
 
-        // Build geometry data vertex and index buffers for all meshes
-        const Model& model = drawableObjects[0].GetModel();
-        const std::vector<Mesh>& meshes = model.GetMeshes();
-        const std::size_t totalDataCount = meshes.size() * drawableObjects.size();
-        geometryDataVector.reserve(geometryDataVector.size() + totalDataCount);
-        for (std::uint32_t i = 0U; i < meshes.size(); ++i) {
-            const Mesh& mesh = meshes[i];
-            GeometryCommandListRecorder::GeometryData geometryData;
-            geometryData.mVertexBufferData = mesh.GetVertexBufferData();
-            geometryData.mIndexBufferData = mesh.GetIndexBufferData();
-            geometryData.mWorldMatrices.reserve(drawableObjects.size());
-            geometryData.mInverseTransposeWorldMatrices.reserve(drawableObjects.size());
-            geometryData.mTextureScales.reserve(drawableObjects.size());
-            geometryDataVector.emplace_back(geometryData);
+bool
+SceneLoader::FinishWorldPartitionCellLoads() noexcept
+{
+    bool haveCellLoadsFinished = false;
+    std::size_t i = 0UL;
+    while (i < mWorldPartitionCellLoads.size()) {
+        WorldPartitionCellLoad& cellLoad = *mWorldPartitionCellLoads[i];
+        if (cellLoad.mIsFinished.load(std::memory_order_acquire) == false) {
+            ++i;
+            continue;
         }
 
-        // Iterate all the meses and store data for all the drawable objects.
-        for (std::uint32_t i = 0U; i < meshes.size(); ++i) {
-            GeometryCommandListRecorder::GeometryData& geometryData =
-                geometryDataVector[geometryDataVectorOffset + i];
+        WorldPartitionCell& cell = mWorldPartitionCells[cellLoad.mCellId];
+        for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+            cell.mGeometryCommandListRecorders[techniqueType] = std::move(cellLoad.mGeometryCommandListRecorders[techniqueType]);
+        }
 
-            for (const DrawableObject& drawableObject : drawableObjects) {
-                // Store textures
-                const MaterialTechnique& materialTechnique = drawableObject.GetMaterialTechnique();
-                baseColorTextures.push_back(&materialTechnique.GetBaseColorTexture());
-                metalnessTextures.push_back(&materialTechnique.GetMetalnessTexture());
-                roughnessTextures.push_back(&materialTechnique.GetRoughnessTexture());
-                normalTextures.push_back(&materialTechnique.GetNormalTexture());
+        mWorldPartitionScheduler.OnCellLoaded(cellLoad.mCellId);
+        mLoadedWorldPartitionCellIds.push_back(cellLoad.mCellId);
+        haveCellLoadsFinished = true;
 
-                // Store matrices and texture scale
-                const XMFLOAT4X4& worldMatrix = drawableObject.GetWorldMatrix();
-                XMFLOAT4X4 inverseTransposeWorldMatrix;
-                MathUtils::StoreInverseTransposeMatrix(worldMatrix, inverseTransposeWorldMatrix);
-                geometryData.mWorldMatrices.push_back(worldMatrix);
-                geometryData.mInverseTransposeWorldMatrices.push_back(inverseTransposeWorldMatrix);
-                geometryData.mTextureScales.push_back(drawableObject.GetTextureScale());
-            }
-        }
+        mWorldPartitionCellLoads[i] = std::move(mWorldPartitionCellLoads.back());
+        mWorldPartitionCellLoads.pop_back();
+    }
+
+    return haveCellLoadsFinished;
+}
+
+void
+SceneLoader::WaitForWorldPartitionCellLoads() noexcept
+{
+    mWorldPartitionCellLoadTasks.wait();
+    FinishWorldPartitionCellLoads();
+    BRE_ASSERT(mWorldPartitionCellLoads.empty());
+}
+
+void
+SceneLoader::LoadWorldPartitionCell(WorldPartitionCellLoad& cellLoad) noexcept
+{
+    BRE_ASSERT(cellLoad.mCellId < mWorldPartitionCells.size());
+    const WorldPartitionCell& cell = mWorldPartitionCells[cellLoad.mCellId];
 
-        geometryDataVectorOffset += meshes.size();
+    // Released models and textures are loaded again once, before the recorders get them,
+    // and the recorders keep them while the cell is loaded.
+    std::vector<ModelManager::SharedModel> models;
+    for (const StringId modelNameId : cell.mModelNameIds) {
+        models.push_back(mModelLoader.GetModel(modelNameId));
+    }
+    std::vector<ResourceManager::SharedResource> textures;
+    for (const StringId textureNameId : cell.mTextureNameIds) {
+        textures.push_back(mTextureLoader.GetTexture(textureNameId));
     }
 
-    commandListRecorder->Init(geometryDataVector,
-                              baseColorTextures,
-                              metalnessTextures,
-                              roughnessTextures,
-                              normalTextures);
+    for (std::uint32_t techniqueType = 0U; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+        cellLoad.mGeometryCommandListRecorders[techniqueType] =
+            CreateGeometryPassRecorder(static_cast<MaterialTechnique::TechniqueType>(techniqueType),
+                                       cell.mDrawableObjectsByModelName[techniqueType],
+                                       sNoInstanceArrayObjects);
+    }
+
+    // Color mapping samples no texture
+    for (std::uint32_t techniqueType = MaterialTechnique::COLOR_NORMAL_MAPPING; techniqueType < MaterialTechnique::NUM_TECHNIQUES; ++techniqueType) {
+        AddTextureStreamingUsers(cellLoad.mCellId + 1U, cell.mDrawableObjectsByModelName[techniqueType]);
+    }
 
-    commandListRecorders.push_back(std::unique_ptr<GeometryCommandListRecorder>(commandListRecorder));
+    cellLoad.mIsFinished.store(true, std::memory_order_release);
 }
 
 void
-SceneLoader::GenerateGeometryPassRecordersForHeightMapping(GeometryCommandListRecorders& commandListRecorders) noexcept
+SceneLoader::UnloadWorldPartitionCell(const std::uint32_t cellId) noexcept
 {
-    const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName =
-        mDrawableObjectLoader.GetDrawableObjectsByModelNameByTechniqueType(MaterialTechnique::HEIGHT_MAPPING);
+    BRE_ASSERT(cellId < mWorldPartitionCells.size());
+    WorldPartitionCell& cell = mWorldPartitionCells[cellId];
 
-    if (drawableObjectsByModelName.empty()) {
-        return;
+    TextureStreamer::RemoveDrawableObjects(cellId + 1U);
+
+    // Recorders release their descriptors, command lists, models and textures once the GPU finished
+    // the frames that use them (see GeometryCommandListRecorder).
+    for (GeometryCommandListRecorders::value_type& commandListRecorder : cell.mGeometryCommandListRecorders) {
+        commandListRecorder.reset();
     }
+}
 
-    // Iterate over Drawable objects and fill containers needed
-    // to initialize the command list recorder.
-    HeightMappingCommandListRecorder* commandListRecorder = new HeightMappingCommandListRecorder;
-    std::vector<GeometryCommandListRecorder::GeometryData> geometryDataVector;
-    std::vector<ID3D12Resource*> baseColorTextures;
-    std::vector<ID3D12Resource*> metalnessTextures;
-    std::vector<ID3D12Resource*> roughnessTextures;
-    std::vector<ID3D12Resource*> normalTextures;
-    std::vector<ID3D12Resource*> heightTextures;
-
-    std::size_t geometryDataVectorOffset = 0;
-    for (const DrawableObjectLoader::DrawableObjectsByModelName::value_type& pair : drawableObjectsByModelName) {
-        const std::vector<DrawableObject>& drawableObjects = pair.second;
-        BRE_ASSERT(drawableObjects.empty() == false);
+GeometryCommandListRecorders::value_type
+SceneLoader::CreateGeometryPassRecorder(const MaterialTechnique::TechniqueType techniqueType,
+                                        const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                        const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept
+{
+    switch (techniqueType) {
+    case MaterialTechnique::COLOR_MAPPING:
+        return CreateGeometryPassRecorderForColorMapping(drawableObjectsByModelName, instanceArrayObjectsVector);
+    case MaterialTechnique::COLOR_NORMAL_MAPPING:
+        return CreateGeometryPassRecorderForColorNormalMapping(drawableObjectsByModelName, instanceArrayObjectsVector);
+    case MaterialTechnique::COLOR_HEIGHT_MAPPING:
+        return CreateGeometryPassRecorderForColorHeightMapping(drawableObjectsByModelName, instanceArrayObjectsVector);
+    case MaterialTechnique::TEXTURE_MAPPING:
+        return CreateGeometryPassRecorderForTextureMapping(drawableObjectsByModelName, instanceArrayObjectsVector);
+    case MaterialTechnique::NORMAL_MAPPING:
+        return CreateGeometryPassRecorderForNormalMapping(drawableObjectsByModelName, instanceArrayObjectsVector);
+    case MaterialTechnique::HEIGHT_MAPPING:
+        return CreateGeometryPassRecorderForHeightMapping(drawableObjectsByModelName, instanceArrayObjectsVector);
+    default:
+        BRE_ASSERT(false);
+        return nullptr;
+    }
+}
 
-        // Build geometry data vertex and index buffers for all meshes
-        const Model& model = drawableObjects[0].GetModel();
-        const std::vector<Mesh>& meshes = model.GetMeshes();
-        const std::size_t totalDataCount = meshes.size() * drawableObjects.size();
-        geometryDataVector.reserve(geometryDataVector.size() + totalDataCount);
-        for (std::uint32_t i = 0U; i < meshes.size(); ++i) {
-            const Mesh& mesh = meshes[i];
-            GeometryCommandListRecorder::GeometryData geometryData;
-            geometryData.mVertexBufferData = mesh.GetVertexBufferData();
-            geometryData.mIndexBufferData = mesh.GetIndexBufferData();
-            geometryData.mWorldMatrices.reserve(drawableObjects.size());
-            geometryData.mInverseTransposeWorldMatrices.reserve(drawableObjects.size());
-            geometryData.mTextureScales.reserve(drawableObjects.size());
-            geometryDataVector.emplace_back(geometryData);
-        }
+GeometryCommandListRecorders::value_type
+SceneLoader::CreateGeometryPassRecorderForColorMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                       const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept
+{
+    if (drawableObjectsByModelName.empty() && instanceArrayObjectsVector.empty()) {
+        return nullptr;
+    }
 
-        // Iterate all the meses and store data for all the drawable objects.
-        for (std::uint32_t i = 0U; i < meshes.size(); ++i) {
-            GeometryCommandListRecorder::GeometryData& geometryData =
-                geometryDataVector[geometryDataVectorOffset + i];
-
-            for (const DrawableObject& drawableObject : drawableObjects) {
-                // Store textures
-                const MaterialTechnique& materialTechnique = drawableObject.GetMaterialTechnique();
-                baseColorTextures.push_back(&materialTechnique.GetBaseColorTexture());
-                metalnessTextures.push_back(&materialTechnique.GetMetalnessTexture());
-                roughnessTextures.push_back(&materialTechnique.GetRoughnessTexture());
-                normalTextures.push_back(&materialTechnique.GetNormalTexture());
-                heightTextures.push_back(&materialTechnique.GetHeightTexture());
-
-                // Store matrices and texture scale
-                const XMFLOAT4X4& worldMatrix = drawableObject.GetWorldMatrix();
-                XMFLOAT4X4 inverseTransposeWorldMatrix;
-                MathUtils::StoreInverseTransposeMatrix(worldMatrix, inverseTransposeWorldMatrix);
-                geometryData.mWorldMatrices.push_back(worldMatrix);
-                geometryData.mInverseTransposeWorldMatrices.push_back(inverseTransposeWorldMatrix);
-                geometryData.mTextureScales.push_back(drawableObject.GetTextureScale());
-            }
-        }
+    GeometryPassRecorderData recorderData;
+    BuildGeometryPassRecorderData(drawableObjectsByModelName,
+                                  instanceArrayObjectsVector,
+                                  MaterialTechnique::COLOR_MAPPING,
+                                  mModelLoader,
+                                  mTextureLoader,
+                                  recorderData);
+
+    ColorMappingCommandListRecorder* commandListRecorder = new ColorMappingCommandListRecorder;
+    commandListRecorder->Init(recorderData.mGeometryDataVector);
+
+    return GeometryCommandListRecorders::value_type(commandListRecorder);
+}
+
+GeometryCommandListRecorders::value_type
+SceneLoader::CreateGeometryPassRecorderForColorNormalMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                             const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept
+{
+    if (drawableObjectsByModelName.empty() && instanceArrayObjectsVector.empty()) {
+        return nullptr;
+    }
+
+    GeometryPassRecorderData recorderData;
+    BuildGeometryPassRecorderData(drawableObjectsByModelName,
+                                  instanceArrayObjectsVector,
+                                  MaterialTechnique::COLOR_NORMAL_MAPPING,
+                                  mModelLoader,
+                                  mTextureLoader,
+                                  recorderData);
+
+    ColorNormalMappingCommandListRecorder* commandListRecorder = new ColorNormalMappingCommandListRecorder;
+    commandListRecorder->Init(recorderData.mGeometryDataVector,
+                              recorderData.mNormalTextures);
+    commandListRecorder->SetSampledTextures(std::move(recorderData.mSampledTextures));
+
+    return GeometryCommandListRecorders::value_type(commandListRecorder);
+}
+
+GeometryCommandListRecorders::value_type
+SceneLoader::CreateGeometryPassRecorderForColorHeightMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                             const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept
+{
+    if (drawableObjectsByModelName.empty() && instanceArrayObjectsVector.empty()) {
+        return nullptr;
+    }
+
+    GeometryPassRecorderData recorderData;
+    BuildGeometryPassRecorderData(drawableObjectsByModelName,
+                                  instanceArrayObjectsVector,
+                                  MaterialTechnique::COLOR_HEIGHT_MAPPING,
+                                  mModelLoader,
+                                  mTextureLoader,
+                                  recorderData);
+
+    ColorHeightMappingCommandListRecorder* commandListRecorder = new ColorHeightMappingCommandListRecorder;
+    commandListRecorder->Init(recorderData.mGeometryDataVector,
+                              recorderData.mMetalnessRoughnessHeightTextures,
+                              recorderData.mNormalTextures);
+    commandListRecorder->SetSampledTextures(std::move(recorderData.mSampledTextures));
+
+    return GeometryCommandListRecorders::value_type(commandListRecorder);
+}
+
+GeometryCommandListRecorders::value_type
+SceneLoader::CreateGeometryPassRecorderForTextureMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                         const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept
+{
+    if (drawableObjectsByModelName.empty() && instanceArrayObjectsVector.empty()) {
+        return nullptr;
+    }
+
+    GeometryPassRecorderData recorderData;
+    BuildGeometryPassRecorderData(drawableObjectsByModelName,
+                                  instanceArrayObjectsVector,
+                                  MaterialTechnique::TEXTURE_MAPPING,
+                                  mModelLoader,
+                                  mTextureLoader,
+                                  recorderData);
+
+    TextureMappingCommandListRecorder* commandListRecorder = new TextureMappingCommandListRecorder;
+    commandListRecorder->Init(recorderData.mGeometryDataVector,
+                              recorderData.mBaseColorTextures,
+                              recorderData.mMetalnessRoughnessHeightTextures);
+    commandListRecorder->SetSampledTextures(std::move(recorderData.mSampledTextures));
+
+    return GeometryCommandListRecorders::value_type(commandListRecorder);
+}
+
+GeometryCommandListRecorders::value_type
+SceneLoader::CreateGeometryPassRecorderForNormalMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                        const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept
+{
+    if (drawableObjectsByModelName.empty() && instanceArrayObjectsVector.empty()) {
+        return nullptr;
+    }
+
+    GeometryPassRecorderData recorderData;
+    BuildGeometryPassRecorderData(drawableObjectsByModelName,
+                                  instanceArrayObjectsVector,
+                                  MaterialTechnique::NORMAL_MAPPING,
+                                  mModelLoader,
+                                  mTextureLoader,
+                                  recorderData);
+
+    NormalMappingCommandListRecorder* commandListRecorder = new NormalMappingCommandListRecorder;
+    commandListRecorder->Init(recorderData.mGeometryDataVector,
+                              recorderData.mBaseColorTextures,
+                              recorderData.mMetalnessRoughnessHeightTextures,
+                              recorderData.mNormalTextures);
+    commandListRecorder->SetSampledTextures(std::move(recorderData.mSampledTextures));
 
-        geometryDataVectorOffset += meshes.size();
+    return GeometryCommandListRecorders::value_type(commandListRecorder);
+}
+
+GeometryCommandListRecorders::value_type
+SceneLoader::CreateGeometryPassRecorderForHeightMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                        const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept
+{
+    if (drawableObjectsByModelName.empty() && instanceArrayObjectsVector.empty()) {
+        return nullptr;
     }
 
-    commandListRecorder->Init(geometryDataVector,
-                              baseColorTextures,
-                              metalnessTextures,
-                              roughnessTextures,
-                              normalTextures,
-                              heightTextures);
+    GeometryPassRecorderData recorderData;
+    BuildGeometryPassRecorderData(drawableObjectsByModelName,
+                                  instanceArrayObjectsVector,
+                                  MaterialTechnique::HEIGHT_MAPPING,
+                                  mModelLoader,
+                                  mTextureLoader,
+                                  recorderData);
+
+    HeightMappingCommandListRecorder* commandListRecorder = new HeightMappingCommandListRecorder;
+    commandListRecorder->Init(recorderData.mGeometryDataVector,
+                              recorderData.mBaseColorTextures,
+                              recorderData.mMetalnessRoughnessHeightTextures,
+                              recorderData.mNormalTextures);
+    commandListRecorder->SetSampledTextures(std::move(recorderData.mSampledTextures));
 
-    commandListRecorders.push_back(std::unique_ptr<GeometryCommandListRecorder>(commandListRecorder));
+    return GeometryCommandListRecorders::value_type(commandListRecorder);
 }
 }
\ No newline at end of file
@@ -1,14 +1,23 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <DirectXMath.h>
 #include <memory>
+#include <string>
+#include <tbb/task_group.h>
+#include <vector>
 
 #include <GeometryPass\GeometryCommandListRecorder.h>
 #include <SceneLoader\CameraLoader.h>
+#include <SceneLoader\CompiledScene.h>
 #include <SceneLoader\DrawableObjectLoader.h>
 #include <SceneLoader\EnvironmentLoader.h>
 #include <SceneLoader\MaterialTechniqueLoader.h>
 #include <SceneLoader\ModelLoader.h>
 #include <SceneLoader\TextureLoader.h>
+#include <SceneLoader\WorldPartitionScheduler.h>
+#include <Utils\StringId.h>
 
 namespace BRE {
 class Scene;
@@ -19,6 +28,7 @@ class Scene;
 class SceneLoader {
 public:
     SceneLoader();
+    ~SceneLoader();
     SceneLoader(const SceneLoader&) = delete;
     const SceneLoader& operator=(const SceneLoader&) = delete;
     SceneLoader(SceneLoader&&) = delete;
@@ -26,11 +36,99 @@ public:
 
     ///
     /// @brief Load scene
-    /// @param rootNode Scene YAML file root node
+    ///
+    /// The scene file is cooked by SceneCooker if it was not cooked before,
+    /// and it is loaded from the compiled scene file.
+    ///
+    /// It can be called again to replace the loaded scene by another one (the GPU must not
+    /// be using the loaded scene). Models, textures and material techniques of the loaded scenes
+    /// are kept, so the ones shared between scenes are loaded once. Then, the ones the new scene
+    /// does not use can be released (see ReleaseUnusedAssets()). Every model and texture of the scene
+    /// is loaded, to know the size of the world partition cells that use them.
+    ///
+    /// @param sceneFilePath Scene YAML file path
+    /// @return Scene
     ///
     Scene* LoadScene(const char* sceneFilePath) noexcept;
 
+    ///
+    /// @brief Reload the modified scene file
+    ///
+    /// The scene file is cooked again, and it is compared with the loaded scene (see SceneDiffer).
+    /// Only the differences are applied: models, textures and material techniques are loaded again
+    /// if they changed, reusing the files that were already loaded, and geometry pass recorders
+    /// are generated again only for the technique types whose drawable objects, instance arrays
+    /// or assets changed. Environment, camera and settings changes are applied on restart.
+    /// LoadScene() must be called first.
+    ///
+    /// @param commandListRecorders Output geometry pass command list recorders of the reloaded scene.
+    /// Recorders of unchanged technique types are the loaded ones.
+    /// @return True if geometry pass recorders changed, and there are geometry pass recorders. Otherwise, false.
+    ///
+    bool ReloadScene(GeometryCommandListRecorders& commandListRecorders) noexcept;
+
+    ///
+    /// @brief Releases the models and textures that no geometry pass recorder uses
+    ///
+    /// Loaders stop keeping the assets they loaded, so the ones of previously loaded scenes and
+    /// of unloaded world partition cells are released through the deferred release queue, once every
+    /// user dropped them (see ModelLoader::ReleaseUnusedModels() and TextureLoader::ReleaseUnusedTextures()).
+    /// Loaders load them again when a cell that uses them is loaded.
+    /// LoadScene() and ReloadScene() must call it after they return.
+    ///
+    void ReleaseUnusedAssets() noexcept;
+
+    ///
+    /// @brief Get the files the loaded scene was generated from
+    ///
+    /// LoadScene() must be called first.
+    ///
+    /// @param filePaths Output file paths. The first one is the scene file,
+    /// and the rest are "reference" files.
+    ///
+    void GetSceneFilePaths(std::vector<std::string>& filePaths) const noexcept;
+
+    ///
+    /// @brief Loads and unloads the world partition cells around the camera
+    ///
+    /// If world partition is enabled (see ApplicationSettings), drawable objects are split in cells
+    /// by their position, and only the loaded cells have geometry pass recorders (see WorldPartitionScheduler).
+    /// Cells are loaded by TBB tasks, and their recorders are got by the first update after their task
+    /// finished, so updates never wait for them. Instance arrays are always loaded. Cells load the models
+    /// and textures their drawable objects use, and they are released once the last loaded cell that
+    /// uses them is unloaded (see ReleaseUnusedAssets()).
+    /// Textures of loaded cells still stream their mip levels by their screen size (see TextureStreamer).
+    /// LoadScene() must be called first.
+    ///
+    /// @param cameraPosition Camera position
+    /// @param commandListRecorders Output geometry pass command list recorders, including the ones of the loaded cells
+    /// @return True if cells finished loading or were unloaded, and there are geometry pass recorders. Otherwise, false.
+    ///
+    bool UpdateWorldPartition(const DirectX::XMFLOAT3& cameraPosition,
+                              GeometryCommandListRecorders& commandListRecorders) noexcept;
+
 private:
+    ///
+    /// @brief Drawable objects of a world partition cell, the models and textures they use,
+    /// and their geometry pass recorders while it is loaded. Recorders keep the models and textures.
+    ///
+    struct WorldPartitionCell {
+        DrawableObjectLoader::DrawableObjectsByModelName mDrawableObjectsByModelName[MaterialTechnique::NUM_TECHNIQUES];
+        std::vector<StringId> mModelNameIds;
+        std::vector<StringId> mTextureNameIds;
+        GeometryCommandListRecorders::value_type mGeometryCommandListRecorders[MaterialTechnique::NUM_TECHNIQUES];
+    };
+
+    ///
+    /// @brief World partition cell whose geometry pass recorders are being created by a TBB task.
+    /// Recorders are handed over to the cell once the task finished.
+    ///
+    struct WorldPartitionCellLoad {
+        std::uint32_t mCellId{ 0U };
+        GeometryCommandListRecorders::value_type mGeometryCommandListRecorders[MaterialTechnique::NUM_TECHNIQUES];
+        std::atomic<bool> mIsFinished{ false };
+    };
+
     ///
     /// @brief Generate geometry pass recorders
     /// @param scene Scene to initialize
@@ -38,30 +136,162 @@ private:
     void GenerateGeometryPassRecorders(Scene& scene) noexcept;
 
     ///
-    /// @brief Generate geometry pass command list recorders for texture mapping
-    /// @param commandListRecorders Geometry pass command list recorders
+    /// @brief Generate the geometry pass command list recorder of a technique type
+    /// @param techniqueType Technique type
     ///
-    void GenerateGeometryPassRecordersForTextureMapping(GeometryCommandListRecorders& commandListRecorders) noexcept;
+    void GenerateGeometryPassRecorder(const MaterialTechnique::TechniqueType techniqueType) noexcept;
 
     ///
-    /// @brief Generate geometry pass command list recorders for normal mapping
-    /// @param commandListRecorders Geometry pass command list recorders
+    /// @brief Get geometry pass command list recorders, including the ones of the loaded
+    /// world partition cells, sorted by technique type
+    /// @param commandListRecorders Output geometry pass command list recorders
     ///
-    void GenerateGeometryPassRecordersForNormalMapping(GeometryCommandListRecorders& commandListRecorders) noexcept;
+    void GetGeometryPassRecorders(GeometryCommandListRecorders& commandListRecorders) const noexcept;
 
     ///
-    /// @brief Generate geometry pass command list recorders for height mapping
-    /// @param commandListRecorders Geometry pass command list recorders
+    /// @brief Registers drawable objects, instance array instances and environment textures in TextureStreamer,
+    /// so streamed textures are prioritized by their projected screen size.
+    /// Drawable objects of world partition cells are registered when their cell is loaded.
     ///
-    void GenerateGeometryPassRecordersForHeightMapping(GeometryCommandListRecorders& commandListRecorders) noexcept;
+    void RegisterTextureStreamingUsers() noexcept;
+
+    ///
+    /// @brief Registers drawable objects in TextureStreamer
+    /// @param userId TextureStreamer user identifier
+    /// @param drawableObjectsByModelName Drawable objects by model name of a technique type that samples textures
+    ///
+    void AddTextureStreamingUsers(const std::uint32_t userId,
+                                  const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName) noexcept;
+
+    ///
+    /// @brief Splits the drawable objects in world partition cells, if world partition is enabled.
+    /// Every cell is unloaded.
+    ///
+    void BuildWorldPartition() noexcept;
+
+    ///
+    /// @brief Loads and unloads world partition cells for a camera position.
+    /// Cells to load are loaded by TBB tasks, and it does not wait for them.
+    /// @param cameraPosition Camera position
+    /// @return True if cells finished loading or were unloaded. Otherwise, false.
+    ///
+    bool UpdateWorldPartitionCells(const DirectX::XMFLOAT3& cameraPosition) noexcept;
+
+    ///
+    /// @brief Loads every world partition cell within the load radius of the last camera position,
+    /// and waits for them
+    ///
+    void LoadWorldPartitionCellsAroundCamera() noexcept;
+
+    ///
+    /// @brief Hands the geometry pass recorders of the finished world partition cell loads over to their cells
+    /// @return True if cell loads were finished. Otherwise, false.
+    ///
+    bool FinishWorldPartitionCellLoads() noexcept;
+
+    ///
+    /// @brief Waits for the world partition cell load tasks, and finishes their loads
+    ///
+    void WaitForWorldPartitionCellLoads() noexcept;
+
+    ///
+    /// @brief Loads a world partition cell. Its models and textures are loaded again if they were released,
+    /// its geometry pass recorders are created, and its drawable objects are registered in TextureStreamer.
+    /// It is called by TBB tasks, so it only writes the cell load.
+    /// @param cellLoad Cell load
+    ///
+    void LoadWorldPartitionCell(WorldPartitionCellLoad& cellLoad) noexcept;
+
+    ///
+    /// @brief Unloads a world partition cell. Its geometry pass recorders are destroyed,
+    /// and they release the models and textures no other user keeps.
+    /// @param cellId Cell identifier
+    ///
+    void UnloadWorldPartitionCell(const std::uint32_t cellId) noexcept;
+
+    ///
+    /// @brief Create the geometry pass command list recorder of a technique type.
+    /// Models and textures are got from their loaders, that load them again if they were released.
+    /// @param techniqueType Technique type
+    /// @param drawableObjectsByModelName Drawable objects by model name of the technique
+    /// @param instanceArrayObjectsVector Instance array objects of the technique
+    /// @return Geometry pass command list recorder.
+    /// It is nullptr if there are no drawable objects or instance arrays.
+    ///
+    GeometryCommandListRecorders::value_type
+        CreateGeometryPassRecorder(const MaterialTechnique::TechniqueType techniqueType,
+                                   const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                   const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept;
+
+    ///
+    /// @brief Create geometry pass command list recorder for color mapping.
+    /// It is nullptr if there are no drawable objects or instance arrays.
+    ///
+    GeometryCommandListRecorders::value_type
+        CreateGeometryPassRecorderForColorMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                  const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept;
+
+    ///
+    /// @brief Create geometry pass command list recorder for color normal mapping.
+    /// It is nullptr if there are no drawable objects or instance arrays.
+    ///
+    GeometryCommandListRecorders::value_type
+        CreateGeometryPassRecorderForColorNormalMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                        const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept;
+
+    ///
+    /// @brief Create geometry pass command list recorder for color height mapping.
+    /// It is nullptr if there are no drawable objects or instance arrays.
+    ///
+    GeometryCommandListRecorders::value_type
+        CreateGeometryPassRecorderForColorHeightMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                        const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept;
+
+    ///
+    /// @brief Create geometry pass command list recorder for texture mapping.
+    /// It is nullptr if there are no drawable objects or instance arrays.
+    ///
+    GeometryCommandListRecorders::value_type
+        CreateGeometryPassRecorderForTextureMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                    const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept;
+
+    ///
+    /// @brief Create geometry pass command list recorder for normal mapping.
+    /// It is nullptr if there are no drawable objects or instance arrays.
+    ///
+    GeometryCommandListRecorders::value_type
+        CreateGeometryPassRecorderForNormalMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                   const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept;
+
+    ///
+    /// @brief Create geometry pass command list recorder for height mapping.
+    /// It is nullptr if there are no drawable objects or instance arrays.
+    ///
+    GeometryCommandListRecorders::value_type
+        CreateGeometryPassRecorderForHeightMapping(const DrawableObjectLoader::DrawableObjectsByModelName& drawableObjectsByModelName,
+                                                   const DrawableObjectLoader::InstanceArrayObjectsVector& instanceArrayObjectsVector) noexcept;
 
-    ID3D12CommandAllocator* mCommandAllocator{ nullptr };
-    ID3D12GraphicsCommandList* mCommandList{ nullptr };
     ModelLoader mModelLoader;
     TextureLoader mTextureLoader;
     MaterialTechniqueLoader mMaterialTechniqueLoader;
     DrawableObjectLoader mDrawableObjectLoader;
     EnvironmentLoader mEnvironmentLoader;
     CameraLoader mCameraLoader;
+
+    // Loaded scene, to compare it with the modified scene file
+    std::string mSceneFilePath;
+    std::unique_ptr<CompiledScene> mCompiledScene;
+
+    GeometryCommandListRecorders::value_type mGeometryCommandListRecorders[MaterialTechnique::NUM_TECHNIQUES];
+
+    // World partition cells by cell identifier, and the identifiers of the loaded ones
+    std::vector<WorldPartitionCell> mWorldPartitionCells;
+    std::vector<std::uint32_t> mLoadedWorldPartitionCellIds;
+    WorldPartitionScheduler mWorldPartitionScheduler;
+    DirectX::XMFLOAT3 mWorldPartitionCameraPosition{ 0.0f, 0.0f, 0.0f };
+
+    // Loads of the loading world partition cells, and their tasks
+    std::vector<std::unique_ptr<WorldPartitionCellLoad>> mWorldPartitionCellLoads;
+    tbb::task_group mWorldPartitionCellLoadTasks;
 };
 }
\ No newline at end of file
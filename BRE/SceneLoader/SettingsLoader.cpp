@@ -8,10 +8,35 @@
 #include <AmbientOcclusionPass\AmbientOcclusionSettings.h>
 #include <ApplicationSettings\ApplicationSettings.h>
 #include <GeometryPass\GeometrySettings.h>
+#include <MemoryTracker\MemoryTracker.h>
 #include <SceneLoader\YamlUtils.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
+namespace {
+///
+/// @brief Checks if a property is a memory budget ("<category name> memory budget")
+/// @param propertyName Property name
+/// @param category Output memory category of the budget
+/// @return True if the property is a memory budget. Otherwise, false.
+///
+bool
+IsMemoryBudgetProperty(const std::string& propertyName,
+                       MemoryTracker::Category& category) noexcept
+{
+    const std::string memoryBudgetSuffix{ " memory budget" };
+    if (propertyName.size() <= memoryBudgetSuffix.size() ||
+        propertyName.compare(propertyName.size() - memoryBudgetSuffix.size(),
+                             memoryBudgetSuffix.size(),
+                             memoryBudgetSuffix) != 0) {
+        return false;
+    }
+
+    const std::string categoryName = propertyName.substr(0, propertyName.size() - memoryBudgetSuffix.size());
+    return MemoryTracker::GetCategoryByName(categoryName, category);
+}
+}
+
 void
 SettingsLoader::LoadSettings(const YAML::Node& rootNode) noexcept
 {
@@ -34,6 +59,7 @@ SettingsLoader::LoadSettings(const YAML::Node& rootNode) noexcept
     BRE_CHECK_MSG(settingsMap.IsMap(), L"'settings' node first sequence is not a map");
 
     std::string propertyName;
+    MemoryTracker::Category memoryCategory;
     YAML::const_iterator mapIt = settingsMap.begin();
     while (mapIt != settingsMap.end()) {
         propertyName = mapIt->first.as<std::string>();
@@ -96,6 +122,69 @@ SettingsLoader::LoadSettings(const YAML::Node& rootNode) noexcept
         } else if (propertyName == "height mapping height scale") {
             YamlUtils::GetScalar(mapIt->second,
                                  GeometrySettings::sHeightScale);
+        } else if (propertyName == "texture streaming") {
+            std::uint32_t isTextureStreamingEnabled;
+            YamlUtils::GetScalar(mapIt->second,
+                                 isTextureStreamingEnabled);
+            ApplicationSettings::sIsTextureStreamingEnabled = isTextureStreamingEnabled > 0U;
+        } else if (propertyName == "texture streaming budget per frame") {
+            // Texture streaming budget is in kilobytes
+            std::uint32_t textureStreamingBudget;
+            YamlUtils::GetScalar(mapIt->second,
+                                 textureStreamingBudget);
+            ApplicationSettings::sTextureStreamingBytesPerFrame =
+                static_cast<std::uint64_t>(textureStreamingBudget) * 1024UL;
+        } else if (propertyName == "texture cooking") {
+            std::uint32_t isTextureCookingEnabled;
+            YamlUtils::GetScalar(mapIt->second,
+                                 isTextureCookingEnabled);
+            ApplicationSettings::sIsTextureCookingEnabled = isTextureCookingEnabled > 0U;
+        } else if (propertyName == "texture cooking bc7") {
+            std::uint32_t isBC7TextureCookingEnabled;
+            YamlUtils::GetScalar(mapIt->second,
+                                 isBC7TextureCookingEnabled);
+            ApplicationSettings::sIsBC7TextureCookingEnabled = isBC7TextureCookingEnabled > 0U;
+        } else if (propertyName == "mip generation kaiser filter") {
+            std::uint32_t isKaiserMipFilterEnabled;
+            YamlUtils::GetScalar(mapIt->second,
+                                 isKaiserMipFilterEnabled);
+            ApplicationSettings::sIsKaiserMipFilterEnabled = isKaiserMipFilterEnabled > 0U;
+        } else if (propertyName == "scene hot reload") {
+            std::uint32_t isSceneHotReloadEnabled;
+            YamlUtils::GetScalar(mapIt->second,
+                                 isSceneHotReloadEnabled);
+            ApplicationSettings::sIsSceneHotReloadEnabled = isSceneHotReloadEnabled > 0U;
+        } else if (propertyName == "world partition") {
+            std::uint32_t isWorldPartitionEnabled;
+            YamlUtils::GetScalar(mapIt->second,
+                                 isWorldPartitionEnabled);
+            ApplicationSettings::sIsWorldPartitionEnabled = isWorldPartitionEnabled > 0U;
+        } else if (propertyName == "world partition cell size") {
+            YamlUtils::GetScalar(mapIt->second,
+                                 ApplicationSettings::sWorldPartitionCellSize);
+        } else if (propertyName == "world partition load radius") {
+            YamlUtils::GetScalar(mapIt->second,
+                                 ApplicationSettings::sWorldPartitionLoadRadius);
+        } else if (propertyName == "world partition unload radius") {
+            YamlUtils::GetScalar(mapIt->second,
+                                 ApplicationSettings::sWorldPartitionUnloadRadius);
+        } else if (propertyName == "world partition memory budget") {
+            // World partition memory budget is in megabytes
+            std::uint32_t worldPartitionMemoryBudget;
+            YamlUtils::GetScalar(mapIt->second,
+                                 worldPartitionMemoryBudget);
+            ApplicationSettings::sWorldPartitionMemoryBudgetInBytes =
+                static_cast<std::uint64_t>(worldPartitionMemoryBudget) * 1024UL * 1024UL;
+        } else if (propertyName == "world partition cell loads per update") {
+            YamlUtils::GetScalar(mapIt->second,
+                                 ApplicationSettings::sWorldPartitionCellLoadsPerUpdate);
+        } else if (IsMemoryBudgetProperty(propertyName, memoryCategory)) {
+            // Memory budgets are in megabytes
+            std::uint32_t memoryBudget;
+            YamlUtils::GetScalar(mapIt->second,
+                                 memoryBudget);
+            MemoryTracker::SetBudget(memoryCategory,
+                                     static_cast<std::uint64_t>(memoryBudget) * 1024UL * 1024UL);
         } else {
             // To avoid warning about 'conditional expression is constant'. This is the same than false
             const std::wstring errorMsg =
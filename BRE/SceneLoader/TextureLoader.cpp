@@ -1,21 +1,146 @@
 #include "TextureLoader.h"
 
-#include <d3d12.h>
-#include <vector>
+#include <chrono>
+#include <tbb/parallel_for.h>
+#include <unordered_set>
+
 #pragma warning( push )
 #pragma warning( disable : 4127)
 #include <yaml-cpp/yaml.h>
 #pragma warning( pop ) 
 
-#include <CommandListExecutor\CommandListExecutor.h>
-#include <ResourceManager\ResourceManager.h>
+#include <ApplicationSettings\ApplicationSettings.h>
+#include <DirectXManager\DirectXManager.h>
+#include <ResourceManager\ChannelPacker.h>
+#include <ResourceManager\MipGenerator.h>
+#include <ResourceManager\StagingRingBuffer.h>
+#include <ResourceManager\TextureCooker.h>
+#include <ResourceManager\TextureStreamer.h>
+#include <SceneLoader\MaterialTechnique.h>
+#include <Utils\AssetRegistry.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
+namespace {
+///
+/// @brief Texture file to load
+///
+struct TextureFile {
+    // Only the first path is used if the texture is not channel packed.
+    // A path of a channel packed texture is empty if its channel is constant.
+    std::string mPaths[ChannelPacker::sChannelCount];
+    std::uint64_t mContentHashes[ChannelPacker::sChannelCount]{}; // Of the files of the paths (see AssetRegistry)
+    std::uint8_t mChannelValues[ChannelPacker::sChannelCount]{};
+    bool mIsChannelPacked{ false };
+};
+
+///
+/// @brief Metalness, roughness and height of a material technique, to pack in a single texture
+///
+struct ChannelPackedTexture {
+    // A texture name is empty if its channel is constant.
+    std::string mTextureNames[ChannelPacker::sChannelCount];
+    float mChannelValues[ChannelPacker::sChannelCount]{
+        MaterialTechnique::sDefaultMetalness,
+        MaterialTechnique::sDefaultRoughness,
+        0.0f
+    };
+};
+
+///
+/// @brief Get the textures that material techniques refer to, following "reference" files.
+///
+/// If a texture has several usages, then it is used as a color texture.
+/// Metalness, roughness and height textures have no usage, because they are channel packed.
+///
+/// @param rootNode Scene YAML file root node
+/// @param usageByTextureName Output usage by texture name
+/// @param channelPackedTextures Output metalness, roughness and height of each material technique
+/// that samples them.
+///
+void
+GetTexturesFromMaterialTechniques(const YAML::Node& rootNode,
+                                  std::unordered_map<std::string, TextureCooker::Usage>& usageByTextureName,
+                                  std::vector<ChannelPackedTexture>& channelPackedTextures) noexcept
+{
+    const YAML::Node materialTechniquesNode = rootNode["material techniques"];
+    if (materialTechniquesNode.IsDefined() == false || materialTechniquesNode.IsSequence() == false) {
+        return;
+    }
+
+    std::string propertyName;
+    for (YAML::const_iterator seqIt = materialTechniquesNode.begin(); seqIt != materialTechniquesNode.end(); ++seqIt) {
+        const YAML::Node materialMap = *seqIt;
+        if (materialMap.IsMap() == false) {
+            continue;
+        }
+
+        ChannelPackedTexture channelPackedTexture;
+        bool hasBaseColorTexture{ false };
+        for (YAML::const_iterator mapIt = materialMap.begin(); mapIt != materialMap.end(); ++mapIt) {
+            propertyName = mapIt->first.as<std::string>();
+
+            if (propertyName == "reference") {
+                const YAML::Node referenceRootNode = YAML::LoadFile(mapIt->second.as<std::string>());
+                GetTexturesFromMaterialTechniques(referenceRootNode, usageByTextureName, channelPackedTextures);
+                break;
+            }
+
+            TextureCooker::Usage usage;
+            if (propertyName == "base color texture") {
+                usage = TextureCooker::Usage::COLOR;
+                hasBaseColorTexture = true;
+            } else if (propertyName == "normal texture") {
+                usage = TextureCooker::Usage::NORMAL;
+            } else if (propertyName == "metalness texture") {
+                channelPackedTexture.mTextureNames[0U] = mapIt->second.as<std::string>();
+                continue;
+            } else if (propertyName == "roughness texture") {
+                channelPackedTexture.mTextureNames[1U] = mapIt->second.as<std::string>();
+                continue;
+            } else if (propertyName == "height texture") {
+                channelPackedTexture.mTextureNames[2U] = mapIt->second.as<std::string>();
+                continue;
+            } else if (propertyName == "metalness") {
+                channelPackedTexture.mChannelValues[0U] = mapIt->second.as<float>();
+                continue;
+            } else if (propertyName == "roughness") {
+                channelPackedTexture.mChannelValues[1U] = mapIt->second.as<float>();
+                continue;
+            } else {
+                continue;
+            }
+
+            const std::pair<std::unordered_map<std::string, TextureCooker::Usage>::iterator, bool> insertResult =
+                usageByTextureName.emplace(mapIt->second.as<std::string>(), usage);
+            if (insertResult.second == false && insertResult.first->second != usage) {
+                insertResult.first->second = TextureCooker::Usage::COLOR;
+            }
+        }
+
+        // Color techniques only sample height. MaterialTechniqueLoader reports
+        // color techniques with metalness or roughness textures.
+        if (hasBaseColorTexture || channelPackedTexture.mTextureNames[2U].empty() == false) {
+            channelPackedTextures.push_back(channelPackedTexture);
+        }
+    }
+}
+
+///
+/// @brief Get the size the device allocates for a texture with all its mip levels
+/// @param texture Texture
+/// @return Size in bytes
+///
+std::uint64_t
+GetTextureSize(ID3D12Resource& texture) noexcept
+{
+    const D3D12_RESOURCE_DESC resourceDescriptor = texture.GetDesc();
+    return DirectXManager::GetDevice().GetResourceAllocationInfo(0U, 1U, &resourceDescriptor).SizeInBytes;
+}
+}
+
 void
-TextureLoader::LoadTextures(const YAML::Node& rootNode,
-                            ID3D12CommandAllocator& commandAllocator,
-                            ID3D12GraphicsCommandList& commandList) noexcept
+TextureLoader::LoadTextures(const YAML::Node& rootNode) noexcept
 {
     BRE_ASSERT(rootNode.IsDefined());
 
@@ -26,6 +151,9 @@ TextureLoader::LoadTextures(const YAML::Node& rootNode,
     //   name3: path3
     const YAML::Node texturesNode = rootNode["textures"];
 
+    // Names of a previous load are replaced, but its texture files are reused.
+    mTextureFileByName.clear();
+
     // 'textures' node can be undefined
     if (texturesNode.IsDefined() == false) {
         return;
@@ -33,35 +161,323 @@ TextureLoader::LoadTextures(const YAML::Node& rootNode,
 
     BRE_CHECK_MSG(texturesNode.IsMap(), L"'textures' node must be a map");
 
-    std::vector<ID3D12Resource*> uploadBuffers;
-    BRE_CHECK_HR(commandList.Reset(&commandAllocator, nullptr));
-    
-    LoadTextures(texturesNode,
-                 commandAllocator,
-                 commandList,
-                 uploadBuffers);
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::pair<std::string, std::string>> textureNamesAndPaths;
+    GetTextureNamesAndPathsFromMap(texturesNode, textureNamesAndPaths);
+
+    // Paths are replaced by the path of the first file with the same content,
+    // so texture files below are identified by content.
+    AssetRegistry assetRegistry;
+    std::vector<std::string> texturePaths;
+    texturePaths.reserve(textureNamesAndPaths.size());
+    for (const std::pair<std::string, std::string>& textureNameAndPath : textureNamesAndPaths) {
+        texturePaths.push_back(textureNameAndPath.second);
+    }
+    assetRegistry.RegisterFiles(texturePaths);
+    for (std::pair<std::string, std::string>& textureNameAndPath : textureNamesAndPaths) {
+        textureNameAndPath.second = assetRegistry.GetUniquePath(textureNameAndPath.second);
+    }
+
+    std::unordered_map<std::string, TextureCooker::Usage> usageByTextureName;
+    std::vector<ChannelPackedTexture> channelPackedTextures;
+    GetTexturesFromMaterialTechniques(rootNode, usageByTextureName, channelPackedTextures);
+
+    // Textures that are only channel packed are not loaded.
+    std::unordered_set<std::string> channelPackedOnlyTextureNames;
+    for (const ChannelPackedTexture& channelPackedTexture : channelPackedTextures) {
+        for (const std::string& textureName : channelPackedTexture.mTextureNames) {
+            if (textureName.empty() == false && usageByTextureName.find(textureName) == usageByTextureName.end()) {
+                channelPackedOnlyTextureNames.insert(textureName);
+            }
+        }
+    }
+
+    // Several names can refer to the same texture file, and it must be loaded once.
+    // Texture files are identified by their path, or by the paths (or values) of their
+    // channels if they are channel packed.
+    std::vector<TextureFile> textureFiles;
+    std::vector<std::string> textureFileKeys;
+    std::unordered_map<std::string, std::size_t> textureFileIndexByKey;
+    std::unordered_map<std::string, std::size_t> textureFileIndexByName;
+    std::unordered_map<std::string, std::string> texturePathByName;
+    for (const std::pair<std::string, std::string>& textureNameAndPath : textureNamesAndPaths) {
+        texturePathByName.emplace(textureNameAndPath.first, textureNameAndPath.second);
+        if (channelPackedOnlyTextureNames.find(textureNameAndPath.first) != channelPackedOnlyTextureNames.end()) {
+            continue;
+        }
+
+        const std::pair<std::unordered_map<std::string, std::size_t>::iterator, bool> insertResult =
+            textureFileIndexByKey.emplace(textureNameAndPath.second, textureFiles.size());
+        if (insertResult.second) {
+            TextureFile textureFile;
+            textureFile.mPaths[0U] = textureNameAndPath.second;
+            textureFile.mContentHashes[0U] = assetRegistry.GetContentHash(textureNameAndPath.second);
+            textureFiles.push_back(textureFile);
+            textureFileKeys.push_back(textureNameAndPath.second);
+        }
+        textureFileIndexByName[textureNameAndPath.first] = insertResult.first->second;
+    }
+
+    std::string channelPackedTextureNames[ChannelPacker::sChannelCount];
+    for (const ChannelPackedTexture& channelPackedTexture : channelPackedTextures) {
+        TextureFile textureFile;
+        textureFile.mIsChannelPacked = true;
+        std::string textureFileKey;
+        for (std::uint32_t i = 0U; i < ChannelPacker::sChannelCount; ++i) {
+            const std::string& textureName = channelPackedTexture.mTextureNames[i];
+            if (textureName.empty()) {
+                channelPackedTextureNames[i] = GetConstantChannelTextureName(channelPackedTexture.mChannelValues[i]);
+                textureFile.mChannelValues[i] = ChannelPacker::GetChannelValue(channelPackedTexture.mChannelValues[i]);
+            } else {
+                std::unordered_map<std::string, std::string>::const_iterator findIt =
+                    texturePathByName.find(textureName);
+                BRE_CHECK_MSG(findIt != texturePathByName.end(),
+                              (L"Texture name not found: " + StringUtils::AnsiToWideString(textureName)).c_str());
+                channelPackedTextureNames[i] = textureName;
+                textureFile.mPaths[i] = findIt->second;
+                textureFile.mContentHashes[i] = assetRegistry.GetContentHash(findIt->second);
+            }
+
+            // Paths and constant channel names cannot be confused, see GetConstantChannelTextureName()
+            const std::string& channelKey = textureName.empty() ? channelPackedTextureNames[i] : textureFile.mPaths[i];
+            textureFileKey += i == 0U ? channelKey : "|" + channelKey;
+        }
+
+        const std::pair<std::unordered_map<std::string, std::size_t>::iterator, bool> insertResult =
+            textureFileIndexByKey.emplace(textureFileKey, textureFiles.size());
+        if (insertResult.second) {
+            textureFiles.push_back(textureFile);
+            textureFileKeys.push_back(textureFileKey);
+        }
+
+        const std::string packedTextureName =
+            GetChannelPackedTextureName(channelPackedTextureNames[0U], channelPackedTextureNames[1U], channelPackedTextureNames[2U]);
+        textureFileIndexByName[packedTextureName] = insertResult.first->second;
+    }
+
+    // Textures that material techniques use are cooked to block compressed formats,
+    // chosen by their usage. Textures with no usage (environment textures) are loaded as they are.
+    // Usage also tells which textures are normal maps, to generate their mip levels.
+    std::unordered_map<std::string, TextureCooker::Usage> usageByTexturePath;
+    for (const std::pair<std::string, std::string>& textureNameAndPath : textureNamesAndPaths) {
+        std::unordered_map<std::string, TextureCooker::Usage>::const_iterator findIt =
+            usageByTextureName.find(textureNameAndPath.first);
+        if (findIt == usageByTextureName.end()) {
+            continue;
+        }
+
+        const std::pair<std::unordered_map<std::string, TextureCooker::Usage>::iterator, bool> insertResult =
+            usageByTexturePath.emplace(textureNameAndPath.second, findIt->second);
+        if (insertResult.second == false && insertResult.first->second != findIt->second) {
+            insertResult.first->second = TextureCooker::Usage::COLOR;
+        }
+    }
+
+    // Packing, mip generation, cooking, file reading and parsing run in parallel.
+    // Mip levels are generated before cooking, because cooking keeps the mip levels of the source.
+    // Source files were hashed once by the asset registry, and each step passes the content hash
+    // of its output to the next one, so cache files are found without reading the files again.
+    // Texture creation and upload are serialized by TextureStreamer and StagingRingBuffer.
+    // Only the coarse mip levels of big textures are uploaded here, the rest are streamed.
+    // Texture files of previous loads are not loaded again. If they were released,
+    // then they are loaded again once they are needed (see GetTexture()).
+    std::vector<ResourceManager::SharedResource> textures(textureFiles.size());
+    std::vector<std::string> textureFilenames(textureFiles.size());
+    std::vector<bool> isTextureReused(textureFiles.size(), false);
+    std::size_t reusedTextureCount = 0UL;
+    for (std::size_t i = 0UL; i < textureFiles.size(); ++i) {
+        if (mTextureFileByKey.find(textureFileKeys[i]) != mTextureFileByKey.end()) {
+            isTextureReused[i] = true;
+            ++reusedTextureCount;
+        }
+    }
 
-    commandList.Close();
-    CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);    
+    std::vector<double> loadTimesInMs(textureFiles.size(), 0.0);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, textureFiles.size(), 1U),
+                      [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+            if (isTextureReused[i]) {
+                continue;
+            }
+
+            const auto textureStartTime = std::chrono::high_resolution_clock::now();
+            const TextureFile& textureFile = textureFiles[i];
+            std::string& textureFilename = textureFilenames[i];
+            std::uint64_t contentHash{ 0UL };
+            if (textureFile.mIsChannelPacked) {
+                const char* sourceFilenames[ChannelPacker::sChannelCount]{
+                    textureFile.mPaths[0U].empty() ? nullptr : textureFile.mPaths[0U].c_str(),
+                    textureFile.mPaths[1U].empty() ? nullptr : textureFile.mPaths[1U].c_str(),
+                    textureFile.mPaths[2U].empty() ? nullptr : textureFile.mPaths[2U].c_str()
+                };
+                textureFilename = ChannelPacker::PackTextureFiles(sourceFilenames,
+                                                                  textureFile.mContentHashes,
+                                                                  textureFile.mChannelValues,
+                                                                  contentHash);
+                textureFilename = MipGenerator::GenerateMipLevelsFile(textureFilename.c_str(), contentHash, false);
+                if (ApplicationSettings::sIsTextureCookingEnabled) {
+                    textureFilename = TextureCooker::CookTextureFile(textureFilename.c_str(),
+                                                                     contentHash,
+                                                                     TextureCooker::Usage::CHANNEL_PACKED);
+                }
+            } else {
+                std::unordered_map<std::string, TextureCooker::Usage>::const_iterator findIt =
+                    usageByTexturePath.find(textureFile.mPaths[0U]);
+                const bool isNormalMap = findIt != usageByTexturePath.end() && findIt->second == TextureCooker::Usage::NORMAL;
+                contentHash = textureFile.mContentHashes[0U];
+                textureFilename = MipGenerator::GenerateMipLevelsFile(textureFile.mPaths[0U].c_str(), contentHash, isNormalMap);
+                if (ApplicationSettings::sIsTextureCookingEnabled && findIt != usageByTexturePath.end()) {
+                    textureFilename = TextureCooker::CookTextureFile(textureFilename.c_str(), contentHash, findIt->second);
+                }
+            }
+            textures[i] = TextureStreamer::LoadTextureFromFile(textureFilename.c_str(),
+                                                               nullptr);
+            const auto textureEndTime = std::chrono::high_resolution_clock::now();
+            loadTimesInMs[i] = std::chrono::duration<double, std::milli>(textureEndTime - textureStartTime).count();
+        }
+    });
+
+    for (const std::string& textureName : channelPackedOnlyTextureNames) {
+        mTextureFileByName.erase(StringIdTable::GetStringId(textureName));
+    }
+
+    // Loaded textures are kept until ReleaseUnusedTextures() is called, so their users can get them.
+    std::vector<LoadedTextureFile*> loadedTextureFiles(textureFiles.size(), nullptr);
+    for (std::size_t i = 0UL; i < textureFiles.size(); ++i) {
+        LoadedTextureFile& loadedTextureFile = mTextureFileByKey[textureFileKeys[i]];
+        loadedTextureFiles[i] = &loadedTextureFile;
+        if (isTextureReused[i]) {
+            continue;
+        }
+
+        loadedTextureFile.mFilename = textureFilenames[i];
+        loadedTextureFile.mSizeInBytes = GetTextureSize(*textures[i]);
+        loadedTextureFile.mTexture = textures[i];
+        mLoadedTextures.push_back(textures[i]);
+    }
+
+    for (const std::pair<std::string, std::size_t>& nameAndTextureFileIndex : textureFileIndexByName) {
+        mTextureFileByName[StringIdTable::Intern(nameAndTextureFileIndex.first)] =
+            loadedTextureFiles[nameAndTextureFileIndex.second];
+    }
+
+    StagingRingBuffer::Flush();
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+
+    for (std::size_t i = 0U; i < textureFiles.size(); ++i) {
+        if (isTextureReused[i]) {
+            continue;
+        }
+
+        const std::wstring textureTimeMsg =
+            L"Texture " + StringUtils::AnsiToWideString(textureFileKeys[i]) + L": " +
+            std::to_wstring(loadTimesInMs[i]) + L" ms\n";
+        BRE_LOG_MSG(textureTimeMsg.c_str());
+    }
+
+    const std::wstring totalTimeMsg =
+        L"Textures: " + std::to_wstring(textureFiles.size() - reusedTextureCount) + L" loaded, " +
+        std::to_wstring(reusedTextureCount) + L" reused in " +
+        std::to_wstring(std::chrono::duration<double, std::milli>(endTime - startTime).count()) + L" ms\n";
+    BRE_LOG_MSG(totalTimeMsg.c_str());
+
+    assetRegistry.LogStatistics(L"Texture files");
 }
 
-ID3D12Resource&
-TextureLoader::GetTexture(const std::string& name) noexcept
+bool
+TextureLoader::HasTexture(const StringId nameId) const noexcept
 {
-    std::unordered_map<std::string, ID3D12Resource*>::iterator findIt = mTextureByName.find(name);
-    const std::wstring errorMsg =
-        L"Texture name not found: " + StringUtils::AnsiToWideString(name);
-    BRE_CHECK_MSG(findIt != mTextureByName.end(), errorMsg.c_str());
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTextureFileByName.find(nameId) != mTextureFileByName.end();
+}
+
+ResourceManager::SharedResource
+TextureLoader::GetTexture(const StringId nameId) noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Textures are loaded again while the lock is held, so they are loaded once.
+    LoadedTextureFile& loadedTextureFile = GetLoadedTextureFile(nameId);
+    ResourceManager::SharedResource texture = loadedTextureFile.mTexture.lock();
+    if (texture.get() == nullptr) {
+        texture = TextureStreamer::LoadTextureFromFile(loadedTextureFile.mFilename.c_str(), nullptr);
+        loadedTextureFile.mTexture = texture;
+        StagingRingBuffer::Flush();
+    }
+
+    return texture;
+}
+
+std::uint64_t
+TextureLoader::GetTextureSizeInBytes(const StringId nameId) const noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return GetLoadedTextureFile(nameId).mSizeInBytes;
+}
+
+std::size_t
+TextureLoader::ReleaseUnusedTextures() noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Textures that only the loader keeps are released now
+    std::size_t releasedTextureCount = 0UL;
+    for (const ResourceManager::SharedResource& texture : mLoadedTextures) {
+        releasedTextureCount += texture.use_count() == 1L ? 1UL : 0UL;
+    }
+    mLoadedTextures.clear();
+
+    std::unordered_set<const LoadedTextureFile*> usedTextureFiles;
+    for (const StringIdMap<LoadedTextureFile*>::value_type& pair : mTextureFileByName) {
+        usedTextureFiles.insert(pair.second);
+    }
+
+    // Textures of previous loads are released once their users drop them
+    std::unordered_map<std::string, LoadedTextureFile>::iterator it = mTextureFileByKey.begin();
+    while (it != mTextureFileByKey.end()) {
+        if (usedTextureFiles.find(&it->second) == usedTextureFiles.end()) {
+            releasedTextureCount += it->second.mTexture.expired() ? 0UL : 1UL;
+            it = mTextureFileByKey.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    return releasedTextureCount;
+}
+
+TextureLoader::LoadedTextureFile&
+TextureLoader::GetLoadedTextureFile(const StringId nameId) const noexcept
+{
+    StringIdMap<LoadedTextureFile*>::const_iterator findIt = mTextureFileByName.find(nameId);
+    BRE_CHECK_MSG(findIt != mTextureFileByName.end(),
+                  (L"Texture name not found: " + StringUtils::AnsiToWideString(StringIdTable::GetString(nameId))).c_str());
     BRE_ASSERT(findIt->second != nullptr);
 
     return *findIt->second;
 }
 
+std::string
+TextureLoader::GetConstantChannelTextureName(const float value) noexcept
+{
+    // Scene texture names and paths are not expected to start with '=', so it cannot match them.
+    return "=" + std::to_string(ChannelPacker::GetChannelValue(value));
+}
+
+std::string
+TextureLoader::GetChannelPackedTextureName(const std::string& metalnessTextureName,
+                                           const std::string& roughnessTextureName,
+                                           const std::string& heightTextureName) noexcept
+{
+    // Scene texture names are not expected to have '|', so it cannot match a scene texture name.
+    return metalnessTextureName + "|" + roughnessTextureName + "|" + heightTextureName;
+}
+
 void
-TextureLoader::LoadTextures(const YAML::Node& texturesNode,
-                            ID3D12CommandAllocator& commandAllocator,
-                            ID3D12GraphicsCommandList& commandList,
-                            std::vector<ID3D12Resource*>& uploadBuffers) noexcept
+TextureLoader::GetTextureNamesAndPathsFromMap(const YAML::Node& texturesNode,
+                                              std::vector<std::pair<std::string, std::string>>& textureNamesAndPaths) noexcept
 {
     BRE_CHECK_MSG(texturesNode.IsMap(), L"'textures' node must be a map");
 
@@ -80,23 +496,13 @@ TextureLoader::LoadTextures(const YAML::Node& texturesNode,
             BRE_CHECK_MSG(referenceRootNode["textures"].IsDefined(),
                            L"Reference file must have 'textures' field");
             const YAML::Node referenceTexturesNode = referenceRootNode["textures"];
-            LoadTextures(referenceTexturesNode,
-                         commandAllocator,
-                         commandList,
-                         uploadBuffers);
+            GetTextureNamesAndPathsFromMap(referenceTexturesNode, textureNamesAndPaths);
         } else {
-            const std::wstring errorMsg =
-                L"Texture name must be unique: " + StringUtils::AnsiToWideString(name);
-            BRE_CHECK_MSG(mTextureByName.find(name) == mTextureByName.end(), errorMsg.c_str());
-
-            uploadBuffers.resize(uploadBuffers.size() + 1);
-
-            ID3D12Resource& texture = ResourceManager::LoadTextureFromFile(path.c_str(),
-                                                                           commandList,
-                                                                           uploadBuffers.back(),
-                                                                           nullptr);
+            // The texture is set once every texture is loaded.
+            BRE_CHECK_MSG(mTextureFileByName.emplace(StringIdTable::Intern(name), nullptr).second,
+                          (L"Texture name must be unique: " + StringUtils::AnsiToWideString(name)).c_str());
 
-            mTextureByName[name] = &texture;
+            textureNamesAndPaths.emplace_back(name, path);
         }
     }
 }
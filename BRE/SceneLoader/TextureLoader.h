@@ -1,16 +1,19 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#include <ResourceManager\ResourceManager.h>
+#include <Utils\StringId.h>
 
 namespace YAML {
 class Node;
 }
 
-struct ID3D12CommandAllocator;
-struct ID3D12GraphicsCommandList;
-struct ID3D12Resource;
-
 namespace BRE {
 ///
 /// @brief Responsible to load from scene file the textures 
@@ -26,38 +29,119 @@ public:
 
     ///
     /// @brief Load textures
+    ///
+    /// Textures are loaded in parallel, and each texture file is loaded once,
+    /// even if several names, paths or files with the same content refer to it (see AssetRegistry). Load time of each texture is logged.
+    /// Metalness, roughness and height textures of each material technique are packed
+    /// by ChannelPacker in a single texture (see GetChannelPackedTextureName()), once for
+    /// each different combination of texture files. Metalness and roughness given as scalars
+    /// are packed as constant channels, so they need no texture file. Textures that are only
+    /// packed are not loaded. Material techniques without base color texture only pack height.
+    /// Textures without mip levels get them generated by MipGenerator, normal maps renormalized.
+    /// If texture cooking is enabled, textures that material techniques use are
+    /// cooked by TextureCooker first, with the usage of the material technique fields.
+    /// Textures are uploaded through StagingRingBuffer, and it
+    /// is flushed before returning.
+    /// It can be called again to reload the textures of a modified scene file. Texture names
+    /// are replaced, and texture files that were already loaded are reused, even if they were released.
+    /// Textures are reference counted. The loader keeps the textures it loads until ReleaseUnusedTextures()
+    /// is called, and then they are released once every user drops them (see TextureStreamer::LoadTextureFromFile()).
+    /// GetTexture() must not be called at the same time.
+    ///
     /// @param rootNode Scene YAML file root node
-    /// @param commandAllocator Command allocator for the command list to load textures
-    /// @param commandList Command list to load the textures
     ///
-    void LoadTextures(const YAML::Node& rootNode,
-                      ID3D12CommandAllocator& commandAllocator,
-                      ID3D12GraphicsCommandList& commandList) noexcept;
+    void LoadTextures(const YAML::Node& rootNode) noexcept;
+
+    ///
+    /// @brief Checks if a texture name was loaded
+    /// @param nameId Texture name identifier (see StringIdTable)
+    /// @return True if the texture name was loaded. Otherwise, false.
+    ///
+    bool HasTexture(const StringId nameId) const noexcept;
 
     ///
     /// @brief Get texture
-    /// @param name Texture name
-    /// @return Texture
     ///
-    ID3D12Resource& GetTexture(const std::string& name) noexcept;
+    /// If the texture was released, then it is loaded again from its texture file, and
+    /// StagingRingBuffer is flushed. Loads are serialized.
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param nameId Texture name identifier (see StringIdTable)
+    /// @return Reference counted texture
+    ///
+    ResourceManager::SharedResource GetTexture(const StringId nameId) noexcept;
+
+    ///
+    /// @brief Get texture size. It is known even if the texture was released.
+    /// @param nameId Texture name identifier (see StringIdTable)
+    /// @return Size in bytes the device allocates for the texture with all its mip levels
+    ///
+    std::uint64_t GetTextureSizeInBytes(const StringId nameId) const noexcept;
+
+    ///
+    /// @brief Stops keeping the loaded textures, and forgets the texture files of previous loads
+    /// that the loaded texture names do not refer to
+    ///
+    /// Textures are released once every user drops them too, and the ones that are
+    /// needed again are loaded again (see GetTexture()).
+    ///
+    /// @return Number of released textures
+    ///
+    std::size_t ReleaseUnusedTextures() noexcept;
+
+    ///
+    /// @brief Get the texture name of a constant channel of a channel packed texture
+    /// @param value Channel value in [0.0, 1.0]
+    /// @return Constant channel texture name
+    ///
+    static std::string GetConstantChannelTextureName(const float value) noexcept;
+
+    ///
+    /// @brief Get the name of a channel packed texture
+    /// @param metalnessTextureName Metalness texture name, or constant channel texture name
+    /// @param roughnessTextureName Roughness texture name, or constant channel texture name
+    /// @param heightTextureName Height texture name, or constant channel texture name
+    /// if there is no height texture.
+    /// @return Channel packed texture name
+    ///
+    static std::string GetChannelPackedTextureName(const std::string& metalnessTextureName,
+                                                   const std::string& roughnessTextureName,
+                                                   const std::string& heightTextureName) noexcept;
 
 private:
     ///
-    /// @brief Load textures
+    /// @brief Texture file that was loaded, and its texture while it is not released
+    ///
+    struct LoadedTextureFile {
+        // Packed, mip generated and cooked file, to load it again
+        std::string mFilename;
+        std::uint64_t mSizeInBytes{ 0UL };
+        std::weak_ptr<ID3D12Resource> mTexture;
+    };
+
+    ///
+    /// @brief Get the loaded texture file of a texture name
+    /// @param nameId Texture name identifier (see StringIdTable)
+    /// @return Loaded texture file
+    ///
+    LoadedTextureFile& GetLoadedTextureFile(const StringId nameId) const noexcept;
+
+    ///
+    /// @brief Get texture names and paths from the "textures" map, following "reference" files.
     /// @param texturesNode YAML Node representing the "textures" field. It must be a map.
-    /// @param commandAllocator Command allocator for the command list to load textures
-    /// @param commandList Command list to load the textures
-    /// @param uploadBuffer Upload buffer to upload the texture content.
-    /// It has to be kept alive after the function call because
-    /// the command list has not been executed yet that performs the actual copy.
-    /// The caller can Release the uploadBuffer after it knows the copy has been executed.
+    /// @param textureNamesAndPaths Output list of texture names and paths
     ///
-    void LoadTextures(const YAML::Node& texturesNode,
-                      ID3D12CommandAllocator& commandAllocator,
-                      ID3D12GraphicsCommandList& commandList,
-                      std::vector<ID3D12Resource*>& uploadBuffers) noexcept;
+    void GetTextureNamesAndPathsFromMap(const YAML::Node& texturesNode,
+                                        std::vector<std::pair<std::string, std::string>>& textureNamesAndPaths) noexcept;
+
+    StringIdMap<LoadedTextureFile*> mTextureFileByName;
+
+    // Every texture file loaded by this loader, by texture file key (path, or channel paths and values)
+    std::unordered_map<std::string, LoadedTextureFile> mTextureFileByKey;
 
+    // Textures of the last load, kept until ReleaseUnusedTextures() is called
+    std::vector<ResourceManager::SharedResource> mLoadedTextures;
 
-    std::unordered_map<std::string, ID3D12Resource*> mTextureByName;
+    mutable std::mutex mMutex;
 };
 }
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "WorldPartitionScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+namespace {
+///
+/// @brief Cell and its distance to the camera
+///
+struct CellDistance {
+    std::uint32_t mCellId{ 0U };
+    float mDistance{ 0.0f };
+};
+}
+
+void
+WorldPartitionScheduler::Init(const float cellSize,
+                              const float loadRadius,
+                              const float unloadRadius,
+                              const std::uint64_t memoryBudgetInBytes,
+                              const std::uint32_t maxLoadingCellCount) noexcept
+{
+    BRE_ASSERT(cellSize > 0.0f);
+    BRE_ASSERT(loadRadius >= 0.0f);
+    BRE_ASSERT(unloadRadius >= loadRadius);
+    BRE_ASSERT(maxLoadingCellCount > 0U);
+
+    mCellSize = cellSize;
+    mLoadRadius = loadRadius;
+    mUnloadRadius = unloadRadius;
+    mMemoryBudgetInBytes = memoryBudgetInBytes;
+    mMaxLoadingCellCount = maxLoadingCellCount;
+
+    Clear();
+}
+
+void
+WorldPartitionScheduler::Clear() noexcept
+{
+    mCells.clear();
+    mCellIdByKey.clear();
+    mCommittedCellIds.clear();
+    mCommittedSizeInBytes = 0UL;
+    mLoadingCellCount = 0U;
+}
+
+std::int32_t
+WorldPartitionScheduler::ComputeCellCoordinate(const float coordinate) const noexcept
+{
+    return static_cast<std::int32_t>(std::floor(coordinate / mCellSize));
+}
+
+std::uint32_t
+WorldPartitionScheduler::AddCell(const std::int32_t column,
+                                 const std::int32_t row,
+                                 const std::uint64_t sizeInBytes) noexcept
+{
+    const std::uint32_t cellId = static_cast<std::uint32_t>(mCells.size());
+    const bool isNewCell = mCellIdByKey.emplace(GetCellKey(column, row), cellId).second;
+    BRE_ASSERT(isNewCell);
+
+    Cell cell;
+    cell.mColumn = column;
+    cell.mRow = row;
+    cell.mSizeInBytes = sizeInBytes;
+    mCells.push_back(cell);
+
+    return cellId;
+}
+
+void
+WorldPartitionScheduler::Update(const float cameraX,
+                                const float cameraZ,
+                                std::vector<std::uint32_t>& cellsToLoad,
+                                std::vector<std::uint32_t>& cellsToUnload) noexcept
+{
+    cellsToLoad.clear();
+    cellsToUnload.clear();
+
+    // Loading cells are unloaded once they are loaded
+    std::size_t committedCellIndex = 0UL;
+    while (committedCellIndex < mCommittedCellIds.size()) {
+        const std::uint32_t cellId = mCommittedCellIds[committedCellIndex];
+        if (mCells[cellId].mState == LOADED && ComputeCellDistance(cellId, cameraX, cameraZ) > mUnloadRadius) {
+            UnloadCell(cellId, cellsToUnload);
+        } else {
+            ++committedCellIndex;
+        }
+    }
+
+    // Only the cells in the square around the load radius can be within it
+    std::vector<CellDistance> candidates;
+    const std::int32_t firstColumn = ComputeCellCoordinate(cameraX - mLoadRadius);
+    const std::int32_t lastColumn = ComputeCellCoordinate(cameraX + mLoadRadius);
+    const std::int32_t firstRow = ComputeCellCoordinate(cameraZ - mLoadRadius);
+    const std::int32_t lastRow = ComputeCellCoordinate(cameraZ + mLoadRadius);
+    for (std::int32_t column = firstColumn; column <= lastColumn; ++column) {
+        for (std::int32_t row = firstRow; row <= lastRow; ++row) {
+            const std::unordered_map<std::uint64_t, std::uint32_t>::const_iterator findIt =
+                mCellIdByKey.find(GetCellKey(column, row));
+            if (findIt == mCellIdByKey.end() || mCells[findIt->second].mState != UNLOADED) {
+                continue;
+            }
+
+            CellDistance candidate;
+            candidate.mCellId = findIt->second;
+            candidate.mDistance = ComputeCellDistance(candidate.mCellId, cameraX, cameraZ);
+            if (candidate.mDistance <= mLoadRadius) {
+                candidates.push_back(candidate);
+            }
+        }
+    }
+
+    std::sort(candidates.begin(),
+              candidates.end(),
+              [](const CellDistance& a, const CellDistance& b) {
+        return a.mDistance < b.mDistance || (a.mDistance == b.mDistance && a.mCellId < b.mCellId);
+    });
+
+    std::vector<CellDistance> evictableCells;
+    for (const CellDistance& candidate : candidates) {
+        if (mLoadingCellCount >= mMaxLoadingCellCount) {
+            break;
+        }
+
+        Cell& cell = mCells[candidate.mCellId];
+        if (cell.mSizeInBytes > mMemoryBudgetInBytes) {
+            continue;
+        }
+
+        // Cells unloaded to make room for a nearer cell are not loaded again
+        if (std::find(cellsToUnload.begin(), cellsToUnload.end(), candidate.mCellId) != cellsToUnload.end()) {
+            continue;
+        }
+
+        if (mCommittedSizeInBytes + cell.mSizeInBytes > mMemoryBudgetInBytes) {
+            // Loaded cells farther than the candidate are unloaded, farthest first.
+            // Loading cells cannot be unloaded until they are loaded.
+            evictableCells.clear();
+            for (const std::uint32_t cellId : mCommittedCellIds) {
+                if (mCells[cellId].mState != LOADED) {
+                    continue;
+                }
+
+                CellDistance evictableCell;
+                evictableCell.mCellId = cellId;
+                evictableCell.mDistance = ComputeCellDistance(cellId, cameraX, cameraZ);
+                if (evictableCell.mDistance > candidate.mDistance) {
+                    evictableCells.push_back(evictableCell);
+                }
+            }
+
+            std::sort(evictableCells.begin(),
+                      evictableCells.end(),
+                      [](const CellDistance& a, const CellDistance& b) {
+                return a.mDistance > b.mDistance || (a.mDistance == b.mDistance && a.mCellId > b.mCellId);
+            });
+
+            std::uint64_t evictedSizeInBytes = 0UL;
+            std::size_t evictedCellCount = 0UL;
+            while (evictedCellCount < evictableCells.size() &&
+                   mCommittedSizeInBytes + cell.mSizeInBytes > mMemoryBudgetInBytes + evictedSizeInBytes) {
+                evictedSizeInBytes += mCells[evictableCells[evictedCellCount].mCellId].mSizeInBytes;
+                ++evictedCellCount;
+            }
+
+            if (mCommittedSizeInBytes + cell.mSizeInBytes > mMemoryBudgetInBytes + evictedSizeInBytes) {
+                continue;
+            }
+
+            for (std::size_t i = 0UL; i < evictedCellCount; ++i) {
+                UnloadCell(evictableCells[i].mCellId, cellsToUnload);
+            }
+        }
+
+        cell.mState = LOADING;
+        ++mLoadingCellCount;
+        mCommittedSizeInBytes += cell.mSizeInBytes;
+        mCommittedCellIds.push_back(candidate.mCellId);
+        cellsToLoad.push_back(candidate.mCellId);
+    }
+}
+
+void
+WorldPartitionScheduler::OnCellLoaded(const std::uint32_t cellId) noexcept
+{
+    BRE_ASSERT(cellId < mCells.size());
+    BRE_ASSERT(mCells[cellId].mState == LOADING);
+    BRE_ASSERT(mLoadingCellCount > 0U);
+
+    mCells[cellId].mState = LOADED;
+    --mLoadingCellCount;
+}
+
+WorldPartitionScheduler::CellState
+WorldPartitionScheduler::GetCellState(const std::uint32_t cellId) const noexcept
+{
+    BRE_ASSERT(cellId < mCells.size());
+
+    return mCells[cellId].mState;
+}
+
+float
+WorldPartitionScheduler::ComputeCellDistance(const std::uint32_t cellId,
+                                             const float x,
+                                             const float z) const noexcept
+{
+    BRE_ASSERT(cellId < mCells.size());
+
+    const Cell& cell = mCells[cellId];
+    const float minX = cell.mColumn * mCellSize;
+    const float minZ = cell.mRow * mCellSize;
+    const float distanceX = std::max(std::max(minX - x, x - (minX + mCellSize)), 0.0f);
+    const float distanceZ = std::max(std::max(minZ - z, z - (minZ + mCellSize)), 0.0f);
+
+    return std::sqrt(distanceX * distanceX + distanceZ * distanceZ);
+}
+
+std::uint64_t
+WorldPartitionScheduler::GetCellKey(const std::int32_t column,
+                                    const std::int32_t row) noexcept
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(column)) << 32UL) |
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(row));
+}
+
+void
+WorldPartitionScheduler::UnloadCell(const std::uint32_t cellId,
+                                    std::vector<std::uint32_t>& cellsToUnload) noexcept
+{
+    Cell& cell = mCells[cellId];
+    BRE_ASSERT(cell.mState == LOADED);
+    BRE_ASSERT(mCommittedSizeInBytes >= cell.mSizeInBytes);
+
+    cell.mState = UNLOADED;
+    mCommittedSizeInBytes -= cell.mSizeInBytes;
+
+    const std::vector<std::uint32_t>::iterator findIt =
+        std::find(mCommittedCellIds.begin(), mCommittedCellIds.end(), cellId);
+    BRE_ASSERT(findIt != mCommittedCellIds.end());
+    *findIt = mCommittedCellIds.back();
+    mCommittedCellIds.pop_back();
+
+    cellsToUnload.push_back(cellId);
+}
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace BRE {
+///
+/// @brief Decides which cells of a world partition must be loaded or unloaded, and in which order.
+///
+/// The world is split in square cells in the XZ plane. It does not know anything about
+/// the cell contents, so it can be driven with simulated camera paths.
+///
+/// - Cells within the load radius of the camera are loaded, nearest first.
+/// - Loaded cells are unloaded once they are farther than the unload radius. The unload radius
+/// is greater than the load radius (hysteresis), so cells are not loaded and unloaded again
+/// while the camera moves around a cell border.
+/// - Loading and loaded cells never exceed the memory budget. If a cell does not fit,
+/// then loaded cells that are farther from the camera are unloaded to make room for it.
+///
+/// Each update:
+/// - Call Update() with the camera position, and load and unload the returned cells.
+/// - Call OnCellLoaded() once a cell is loaded. Loads can take several updates.
+///
+class WorldPartitionScheduler {
+public:
+    enum CellState {
+        UNLOADED = 0U,
+        LOADING,
+        LOADED,
+    };
+
+    WorldPartitionScheduler() = default;
+    ~WorldPartitionScheduler() = default;
+    WorldPartitionScheduler(const WorldPartitionScheduler&) = delete;
+    const WorldPartitionScheduler& operator=(const WorldPartitionScheduler&) = delete;
+    WorldPartitionScheduler(WorldPartitionScheduler&&) = delete;
+    WorldPartitionScheduler& operator=(WorldPartitionScheduler&&) = delete;
+
+    ///
+    /// @brief Initializes the scheduler, and removes all the cells
+    /// @param cellSize Size of the cells. Must be greater than zero.
+    /// @param loadRadius Cells closer than it to the camera are loaded
+    /// @param unloadRadius Cells farther than it from the camera are unloaded.
+    /// Must be greater or equal than the load radius.
+    /// @param memoryBudgetInBytes Maximum size of the loading and loaded cells
+    /// @param maxLoadingCellCount Maximum number of cells that are loading at the same time.
+    /// Must be greater than zero.
+    ///
+    void Init(const float cellSize,
+              const float loadRadius,
+              const float unloadRadius,
+              const std::uint64_t memoryBudgetInBytes,
+              const std::uint32_t maxLoadingCellCount) noexcept;
+
+    ///
+    /// @brief Removes all the cells
+    ///
+    void Clear() noexcept;
+
+    ///
+    /// @brief Computes the column or row of the cell that contains a coordinate
+    /// @param coordinate X coordinate for the column, or Z coordinate for the row
+    /// @return Column or row
+    ///
+    std::int32_t ComputeCellCoordinate(const float coordinate) const noexcept;
+
+    ///
+    /// @brief Adds an unloaded cell
+    /// @param column Column of the cell. There must not be another cell with the same column and row.
+    /// @param row Row of the cell
+    /// @param sizeInBytes Size of the cell contents, once loaded.
+    /// If it is greater than the memory budget, then the cell is never loaded.
+    /// @return Cell identifier
+    ///
+    std::uint32_t AddCell(const std::int32_t column,
+                          const std::int32_t row,
+                          const std::uint64_t sizeInBytes) noexcept;
+
+    ///
+    /// @brief Schedules the cells to load and to unload for a camera position
+    ///
+    /// Only the cells around the camera and the loading and loaded cells are visited,
+    /// so its cost does not grow with the world size.
+    ///
+    /// @param cameraX X coordinate of the camera
+    /// @param cameraZ Z coordinate of the camera
+    /// @param cellsToLoad Output cells to load, nearest first. They are loading until OnCellLoaded() is called.
+    /// @param cellsToUnload Output cells to unload. They are unloaded once this method returns.
+    ///
+    void Update(const float cameraX,
+                const float cameraZ,
+                std::vector<std::uint32_t>& cellsToLoad,
+                std::vector<std::uint32_t>& cellsToUnload) noexcept;
+
+    ///
+    /// @brief Notifies that a loading cell is loaded
+    /// @param cellId Cell identifier
+    ///
+    void OnCellLoaded(const std::uint32_t cellId) noexcept;
+
+    ///
+    /// @brief Get cell state
+    /// @param cellId Cell identifier
+    /// @return Cell state
+    ///
+    CellState GetCellState(const std::uint32_t cellId) const noexcept;
+
+    ///
+    /// @brief Computes the distance in the XZ plane from a position to a cell
+    /// @param cellId Cell identifier
+    /// @param x X coordinate of the position
+    /// @param z Z coordinate of the position
+    /// @return Distance. It is zero if the cell contains the position.
+    ///
+    float ComputeCellDistance(const std::uint32_t cellId,
+                              const float x,
+                              const float z) const noexcept;
+
+    ///
+    /// @brief Get the size of the loading and loaded cells
+    /// @return Size in bytes
+    ///
+    std::uint64_t GetCommittedSizeInBytes() const noexcept
+    {
+        return mCommittedSizeInBytes;
+    }
+
+    ///
+    /// @brief Get the number of cells
+    /// @return Number of cells
+    ///
+    std::uint32_t GetCellCount() const noexcept
+    {
+        return static_cast<std::uint32_t>(mCells.size());
+    }
+
+    ///
+    /// @brief Get the number of loading and loaded cells
+    /// @return Number of cells
+    ///
+    std::uint32_t GetCommittedCellCount() const noexcept
+    {
+        return static_cast<std::uint32_t>(mCommittedCellIds.size());
+    }
+
+private:
+    struct Cell {
+        std::int32_t mColumn{ 0 };
+        std::int32_t mRow{ 0 };
+        std::uint64_t mSizeInBytes{ 0UL };
+        CellState mState{ UNLOADED };
+    };
+
+    ///
+    /// @brief Get the key of a cell, by its column and row
+    /// @param column Column
+    /// @param row Row
+    /// @return Cell key
+    ///
+    static std::uint64_t GetCellKey(const std::int32_t column,
+                                    const std::int32_t row) noexcept;
+
+    ///
+    /// @brief Unloads a loaded cell
+    /// @param cellId Cell identifier
+    /// @param cellsToUnload Output cells to unload
+    ///
+    void UnloadCell(const std::uint32_t cellId,
+                    std::vector<std::uint32_t>& cellsToUnload) noexcept;
+
+    float mCellSize{ 1.0f };
+    float mLoadRadius{ 0.0f };
+    float mUnloadRadius{ 0.0f };
+    std::uint64_t mMemoryBudgetInBytes{ 0UL };
+    std::uint32_t mMaxLoadingCellCount{ 1U };
+
+    std::vector<Cell> mCells;
+    std::unordered_map<std::uint64_t, std::uint32_t> mCellIdByKey;
+
+    // Loading and loaded cells
+    std::vector<std::uint32_t> mCommittedCellIds;
+    std::uint64_t mCommittedSizeInBytes{ 0UL };
+    std::uint32_t mLoadingCellCount{ 0U };
+};
+}
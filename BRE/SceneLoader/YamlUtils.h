@@ -7,6 +7,7 @@
 #pragma warning( pop ) 
 
 #include <Utils\DebugUtils.h>
+#include <Utils\StringUtils.h>
 
 namespace BRE {
 ///
@@ -61,5 +62,62 @@ public:
         }
         BRE_ASSERT(currentNumElems == numElems);
     }
+
+    ///
+    /// @brief Get float scalar
+    ///
+    /// It is converted without streams (see StringUtils::StringToFloat)
+    ///
+    /// @param node YAML node
+    /// @param scalar Output scalar
+    ///
+    static void GetScalar(const YAML::Node& node, float& scalar) noexcept
+    {
+        BRE_ASSERT(node.IsDefined());
+        BRE_ASSERT(node.IsScalar());
+        GetFloat(node.Scalar(), scalar);
+    }
+
+    ///
+    /// @brief Get float sequence
+    ///
+    /// It is converted without streams (see StringUtils::StringToFloat)
+    ///
+    /// @param node YAML node
+    /// @param sequenceOutput Output sequence
+    /// @param numElems Number of elements in the sequence
+    ///
+    static void GetSequence(const YAML::Node& node,
+                            float* const sequenceOutput,
+#ifdef _DEBUG
+                            const size_t numElems) noexcept
+#else
+                            const size_t) noexcept
+#endif
+    {
+        BRE_ASSERT(sequenceOutput != nullptr);
+        BRE_ASSERT(node.IsDefined());
+        BRE_ASSERT(node.IsSequence());
+        size_t currentNumElems = 0UL;
+        for (const YAML::Node& seqNode : node) {
+            BRE_ASSERT(seqNode.IsScalar());
+            BRE_ASSERT(currentNumElems < numElems);
+            GetFloat(seqNode.Scalar(), sequenceOutput[currentNumElems]);
+            ++currentNumElems;
+        }
+        BRE_ASSERT(currentNumElems == numElems);
+    }
+
+private:
+    ///
+    /// @brief Converts a scalar to float. The error message is built only if it fails.
+    /// @param string Scalar
+    /// @param value Output float
+    ///
+    static void GetFloat(const std::string& string, float& value) noexcept
+    {
+        BRE_CHECK_MSG(StringUtils::StringToFloat(string.data(), string.data() + string.size(), value),
+                      (L"Invalid float: " + StringUtils::AnsiToWideString(string)).c_str());
+    }
 };
 }
\ No newline at end of file
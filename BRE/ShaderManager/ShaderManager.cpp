@@ -4,6 +4,7 @@
 #include <D3Dcompiler.h>
 #include <fstream>
 
+#include <MemoryTracker\MemoryTracker.h>
 #include <Utils/DebugUtils.h>
 
 namespace BRE {
@@ -33,7 +34,7 @@ LoadBlob(const std::string& filename) noexcept
 }
 }
 
-tbb::concurrent_unordered_set<ID3DBlob*> ShaderManager::mShaderBlobs;
+SlotMap<ID3DBlob*> ShaderManager::mShaderBlobs;
 std::mutex ShaderManager::mMutex;
 
 void
@@ -41,14 +42,29 @@ ShaderManager::Clear() noexcept
 {
     for (ID3DBlob* blob : mShaderBlobs) {
         BRE_ASSERT(blob != nullptr);
+        MemoryTracker::RegisterDeallocation(MemoryTracker::Category::SHADER_BLOBS,
+                                            blob->GetBufferSize());
         blob->Release();
     }
 
-    mShaderBlobs.clear();
+    mShaderBlobs.Clear();
+}
+
+void
+ShaderManager::ReleaseShaderBlob(const ShaderBlobHandle shaderBlobHandle) noexcept
+{
+    ID3DBlob* blob{ nullptr };
+    BRE_CHECK_MSG(mShaderBlobs.Erase(shaderBlobHandle, &blob), L"Shader blob handle is stale");
+    BRE_ASSERT(blob != nullptr);
+
+    MemoryTracker::RegisterDeallocation(MemoryTracker::Category::SHADER_BLOBS,
+                                        blob->GetBufferSize());
+    blob->Release();
 }
 
 ID3DBlob&
-ShaderManager::LoadShaderFileAndGetBlob(const char* filename) noexcept
+ShaderManager::LoadShaderFileAndGetBlob(const char* filename,
+                                        ShaderBlobHandle* shaderBlobHandle) noexcept
 {
     BRE_ASSERT(filename != nullptr);
 
@@ -59,13 +75,14 @@ ShaderManager::LoadShaderFileAndGetBlob(const char* filename) noexcept
     mMutex.unlock();
 
     BRE_ASSERT(blob != nullptr);
-    mShaderBlobs.insert(blob);
+    RegisterShaderBlob(*blob, shaderBlobHandle);
 
     return *blob;
 }
 
 D3D12_SHADER_BYTECODE
-ShaderManager::LoadShaderFileAndGetBytecode(const char* filename) noexcept
+ShaderManager::LoadShaderFileAndGetBytecode(const char* filename,
+                                            ShaderBlobHandle* shaderBlobHandle) noexcept
 {
     BRE_ASSERT(filename != nullptr);
 
@@ -76,7 +93,7 @@ ShaderManager::LoadShaderFileAndGetBytecode(const char* filename) noexcept
     mMutex.unlock();
 
     BRE_ASSERT(blob != nullptr);
-    mShaderBlobs.insert(blob);
+    RegisterShaderBlob(*blob, shaderBlobHandle);
 
     D3D12_SHADER_BYTECODE shaderByteCode
     {
@@ -86,4 +103,17 @@ ShaderManager::LoadShaderFileAndGetBytecode(const char* filename) noexcept
 
     return shaderByteCode;
 }
+
+void
+ShaderManager::RegisterShaderBlob(ID3DBlob& blob,
+                                  ShaderBlobHandle* shaderBlobHandle) noexcept
+{
+    const ShaderBlobHandle handle = mShaderBlobs.Insert(&blob);
+    if (shaderBlobHandle != nullptr) {
+        *shaderBlobHandle = handle;
+    }
+
+    MemoryTracker::RegisterAllocation(MemoryTracker::Category::SHADER_BLOBS,
+                                      blob.GetBufferSize());
+}
 }
\ No newline at end of file
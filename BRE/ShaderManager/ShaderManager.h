@@ -3,7 +3,8 @@
 #include <d3d12.h>
 #include <D3Dcommon.h>
 #include <mutex>
-#include <tbb\concurrent_unordered_set.h>
+
+#include <Utils\SlotMap.h>
 
 namespace BRE {
 ///
@@ -11,6 +12,8 @@ namespace BRE {
 ///
 class ShaderManager {
 public:
+    using ShaderBlobHandle = SlotMap<ID3DBlob*>::Handle;
+
     ShaderManager() = delete;
     ~ShaderManager() = delete;
     ShaderManager(const ShaderManager&) = delete;
@@ -23,22 +26,44 @@ public:
     ///
     static void Clear() noexcept;
 
+    ///
+    /// @brief Releases a shader blob
+    ///
+    /// Pipeline state objects created with its byte code do not need it anymore.
+    /// It can be called from several threads at the same time.
+    ///
+    /// @param shaderBlobHandle Shader blob handle. It must not be stale.
+    ///
+    static void ReleaseShaderBlob(const ShaderBlobHandle shaderBlobHandle) noexcept;
+
     ///
     /// @brief Load shader file and get blob
     /// @param filename Filename. Must not be nullptr
+    /// @param shaderBlobHandle Output shader blob handle, to release the blob. It can be nullptr.
     /// @return Loaded blob
     ///
-    static ID3DBlob& LoadShaderFileAndGetBlob(const char* filename) noexcept;
+    static ID3DBlob& LoadShaderFileAndGetBlob(const char* filename,
+                                              ShaderBlobHandle* shaderBlobHandle = nullptr) noexcept;
 
     ///
     /// @brief Load shader file and get byte code
     /// @param filename Filename. Must not be nullptr
+    /// @param shaderBlobHandle Output shader blob handle, to release the blob. It can be nullptr.
     /// @return Loaded byte code
     ///
-    static D3D12_SHADER_BYTECODE LoadShaderFileAndGetBytecode(const char* filename) noexcept;
+    static D3D12_SHADER_BYTECODE LoadShaderFileAndGetBytecode(const char* filename,
+                                                              ShaderBlobHandle* shaderBlobHandle = nullptr) noexcept;
 
 private:
-    static tbb::concurrent_unordered_set<ID3DBlob*> mShaderBlobs;
+    ///
+    /// @brief Registers a loaded shader blob
+    /// @param blob Shader blob
+    /// @param shaderBlobHandle Output shader blob handle. It can be nullptr.
+    ///
+    static void RegisterShaderBlob(ID3DBlob& blob,
+                                   ShaderBlobHandle* shaderBlobHandle) noexcept;
+
+    static SlotMap<ID3DBlob*> mShaderBlobs;
 
     static std::mutex mMutex;
 };
@@ -18,6 +18,12 @@ struct ObjectCBuffer {
 
     DirectX::XMFLOAT4X4 mWorldMatrix{ MathUtils::GetIdentity4x4Matrix() };
     DirectX::XMFLOAT4X4 mInverseTransposeWorldMatrix{ MathUtils::GetIdentity4x4Matrix() };
+
+    // Material constants of the techniques without base color,
+    // metalness and roughness textures.
+    DirectX::XMFLOAT4 mBaseColor_Metalness{ 1.0f, 1.0f, 1.0f, 0.0f };
+    float mRoughness{ 0.5f };
+
     float mTextureScale{ 5.0f };
 };
 
@@ -5,6 +5,8 @@
 struct ObjectCBuffer {
 	float4x4 mWorldMatrix;
 	float4x4 mInverseTransposeWorldMatrix;
+	float4 mBaseColor_Metalness;
+	float mRoughness;
 	float mTextureScale;
 };
 
@@ -69,11 +69,11 @@ Encode(float3 n)
     return n.xy;
 }
 
+// Decodes a vector encoded in [-1, 1], like the compressed
+// vertex normals and tangents (see VertexCompressor).
 float3
-Decode(float2 encN)
+DecodeSignedOctahedron(const float2 encN)
 {
-    encN = encN * 2.0 - 1.0;
-
     float3 n;
     n.z = 1.0 - abs(encN.x) - abs(encN.y);
     n.xy = n.z >= 0.0 ? encN.xy : OctWrap(encN.xy);
@@ -81,4 +81,29 @@ Decode(float2 encN)
     return n;
 }
 
+float3
+Decode(float2 encN)
+{
+    return DecodeSignedOctahedron(encN * 2.0 - 1.0);
+}
+
+//
+// Normal textures
+//
+
+// Normal textures can be block compressed to 2 channels (BC5),
+// so Z is reconstructed from X and Y.
+float3
+SampleNormalTexture(Texture2D normalTexture,
+                    SamplerState textureSampler,
+                    const float2 uv)
+{
+    float3 n;
+    n.xy = normalTexture.Sample(textureSampler,
+                                uv).xy * 2.0f - 1.0f;
+    n.z = sqrt(saturate(1.0f - dot(n.xy, n.xy)));
+
+    return n;
+}
+
 #endif
\ No newline at end of file
@@ -4,8 +4,8 @@
 
 struct Input {
     float3 mPositionObjectSpace : POSITION;
-    float3 mNormalObjectSpace : NORMAL;
-    float3 mTangentObjectSpace : TANGENT;
+    float2 mEncodedNormalObjectSpace : NORMAL;
+    float2 mEncodedTangentObjectSpace : TANGENT;
     float2 mUV : TEXCOORD;
 };
 
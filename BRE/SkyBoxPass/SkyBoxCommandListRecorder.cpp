@@ -40,7 +40,7 @@ SkyBoxCommandListRecorder::InitSharedPSOAndRootSignature() noexcept
     // Otherwise, the normalized depth values at z = 1 (NDC) will 
     // fail the depth test if the depth buffer was cleared to 1.
     psoData.mDepthStencilDescriptor.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
-    psoData.mInputLayoutDescriptors = D3DFactory::GetPositionNormalTangentTexCoordInputLayout();
+    psoData.mInputLayoutDescriptors = D3DFactory::GetCompressedPositionNormalTangentTexCoordInputLayout();
 
     psoData.mPixelShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("SkyBoxPass/Shaders/PS.cso");
     psoData.mVertexShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("SkyBoxPass/Shaders/VS.cso");
@@ -110,7 +110,7 @@ SkyBoxCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCB
     D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.GetResource().GetGPUVirtualAddress());
     commandList.SetGraphicsRootDescriptorTable(0U, mObjectCBufferView);
     commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
-    commandList.SetGraphicsRootDescriptorTable(2U, mPixelShaderResourceViewsBegin);
+    commandList.SetGraphicsRootDescriptorTable(2U, CbvSrvUavDescriptorManager::GetCurrentDescriptors(mPixelShaderResourceViewsBegin));
 
     commandList.IASetVertexBuffers(0U, 1U, &mVertexBufferData.mBufferView);
     commandList.IASetIndexBuffer(&mIndexBufferData.mBufferView);
@@ -123,6 +123,16 @@ SkyBoxCommandListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCB
     return 1U;
 }
 
+void
+SkyBoxCommandListRecorder::ReplaceSkyBoxCubeMap(ID3D12Resource& skyBoxCubeMap) noexcept
+{
+    BRE_ASSERT(IsDataValid());
+
+    // The new view reuses the descriptor of the previous one
+    CbvSrvUavDescriptorManager::ReleaseDescriptors(mPixelShaderResourceViewsBegin, 1U);
+    InitShaderResourceViews(skyBoxCubeMap);
+}
+
 bool
 SkyBoxCommandListRecorder::IsDataValid() const noexcept
 {
@@ -58,6 +58,15 @@ public:
     ///
     std::uint32_t RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept;
 
+    ///
+    /// @brief Replaces the sky box cube map
+    ///
+    /// Init() must be called first. The GPU must not be using the previous cube map.
+    ///
+    /// @param skyBoxCubeMap Sky box cube map
+    ///
+    void ReplaceSkyBoxCubeMap(ID3D12Resource& skyBoxCubeMap) noexcept;
+
     ///
     /// @brief Checks if internal data is valid. Typically, used for assertions
     /// @return True if valid. Otherwise, false
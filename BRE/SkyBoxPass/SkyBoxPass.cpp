@@ -3,13 +3,11 @@
 #include <d3d12.h>
 
 #include <CommandListExecutor/CommandListExecutor.h>
-#include <CommandManager\CommandAllocatorManager.h>
-#include <CommandManager\CommandListManager.h>
 #include <DXUtils/d3dx12.h>
 #include <ModelManager\Mesh.h>
 #include <ModelManager\Model.h>
 #include <ModelManager\ModelManager.h>
-#include <ResourceStateManager\ResourceStateManager.h>
+#include <ResourceManager\StagingRingBuffer.h>
 #include <SkyBoxPass\SkyBoxCommandListRecorder.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
@@ -18,44 +16,18 @@ using namespace DirectX;
 
 namespace BRE {
 namespace {
-///
-/// @brief Create command objects
-/// @param commandAllocator Output command allocator
-/// @param commandList Output command list
-///
-void
-CreateCommandObjects(ID3D12CommandAllocator* &commandAllocator,
-                     ID3D12GraphicsCommandList* &commandList) noexcept
-{
-    // Create command allocators and command list
-    commandAllocator = &CommandAllocatorManager::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
-    commandList = &CommandListManager::CreateCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT, *commandAllocator);
-    commandList->Close();
-}
-
 ///
 /// @brief Creates and gets sky box sphere model
-/// @param commandAllocator Command allocator to use with the command list
-/// @param commandList Command list to execute the sphere model creation
 /// @return Sphere model
 ///
 Model&
-CreateAndGetSkyBoxSphereModel(ID3D12CommandAllocator& commandAllocator,
-                              ID3D12GraphicsCommandList& commandList)
+CreateAndGetSkyBoxSphereModel()
 {
-    BRE_CHECK_HR(commandList.Reset(&commandAllocator, nullptr));
+    Model* model = &ModelManager::CreateSphere(3000U,
+                                               50U,
+                                               50U);
 
-    ID3D12Resource* uploadVertexBuffer;
-    ID3D12Resource* uploadIndexBuffer;
-    Model* model = &ModelManager::CreateSphere(3000U, 
-                                               50U, 
-                                               50U, 
-                                               commandList, 
-                                               uploadVertexBuffer, 
-                                               uploadIndexBuffer);
-
-    commandList.Close();
-    CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);
+    StagingRingBuffer::Flush();
 
     return *model;
 }
@@ -71,12 +43,7 @@ SkyBoxPass::Init(ID3D12Resource& skyBoxCubeMap,
 
     mDepthBuffer = &depthBuffer;
 
-    ID3D12CommandAllocator* commandAllocator;
-    ID3D12GraphicsCommandList* commandList;
-    CreateCommandObjects(commandAllocator, commandList);
-
-    Model& model = CreateAndGetSkyBoxSphereModel(*commandAllocator, 
-                                                 *commandList);
+    Model& model = CreateAndGetSkyBoxSphereModel();
     const std::vector<Mesh>& meshes(model.GetMeshes());
     BRE_ASSERT(meshes.size() == 1UL);
 
@@ -119,6 +86,14 @@ SkyBoxPass::Execute(const FrameCBuffer& frameCBuffer) noexcept
     return commandListCount;
 }
 
+void
+SkyBoxPass::ReplaceSkyBoxCubeMap(ID3D12Resource& skyBoxCubeMap) noexcept
+{
+    BRE_ASSERT(IsDataValid());
+
+    mCommandListRecorder.ReplaceSkyBoxCubeMap(skyBoxCubeMap);
+}
+
 bool
 SkyBoxPass::IsDataValid() const noexcept
 {
@@ -133,23 +108,12 @@ SkyBoxPass::RecordAndPushPrePassCommandLists() noexcept
 {
     BRE_ASSERT(IsDataValid());
 
-    D3D12_RESOURCE_BARRIER barriers[1U];
-    std::uint32_t barrierCount = 0UL;
-    if (ResourceStateManager::GetResourceState(*mDepthBuffer) != D3D12_RESOURCE_STATE_DEPTH_WRITE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mDepthBuffer,
-                                                                                        D3D12_RESOURCE_STATE_DEPTH_WRITE);
-        ++barrierCount;
-    }
-
-    if (barrierCount > 0UL) {
-        ID3D12GraphicsCommandList& commandList = mPrePassCommandListPerFrame.ResetCommandListWithNextCommandAllocator(nullptr);
-        commandList.ResourceBarrier(barrierCount, barriers);
-        BRE_CHECK_HR(commandList.Close());
-        CommandListExecutor::Get().PushCommandList(commandList);
+    mPrePassResourceStateTracker.Reset();
+    mPrePassResourceStateTracker.ChangeResourceState(*mDepthBuffer,
+                                                     D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
-        return 1U;
-    }
+    CommandListExecutor::Get().PushResourceStateTransitions(mPrePassResourceStateTracker);
 
-    return 0U;
+    return 1U;
 }
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <CommandManager\CommandListPerFrame.h>
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
 #include <SkyBoxPass\SkyBoxCommandListRecorder.h>
 
 namespace BRE {
@@ -41,6 +41,15 @@ public:
     ///
     std::uint32_t Execute(const FrameCBuffer& frameCBuffer) noexcept;
 
+    ///
+    /// @brief Replaces the sky box cube map (for example, when the scene is switched)
+    ///
+    /// Init() must be called first. The GPU must not be using the previous cube map.
+    ///
+    /// @param skyBoxCubeMap Sky box cube map resource
+    ///
+    void ReplaceSkyBoxCubeMap(ID3D12Resource& skyBoxCubeMap) noexcept;
+
 private:
     ///
     /// @brief Checks if internal data is valid. Typically, used for assertions
@@ -49,9 +58,9 @@ private:
     bool IsDataValid() const noexcept;
 
     ///
-    /// @brief Records pre pass command lists and pushes them to 
+    /// @brief Pushes pre pass resource state transitions to
     /// the CommandListExecutor.
-    /// @return The number of recorded command lists
+    /// @return The number of pushed command lists
     ///
     std::uint32_t RecordAndPushPrePassCommandLists() noexcept;
 
@@ -59,6 +68,6 @@ private:
 
     ID3D12Resource* mDepthBuffer{ nullptr };
 
-    CommandListPerFrame mPrePassCommandListPerFrame;
+    CommandListResourceStateTracker mPrePassResourceStateTracker;
 };
 }
\ No newline at end of file
@@ -6,7 +6,6 @@
 #include <CommandListExecutor/CommandListExecutor.h>
 #include <DXUtils/d3dx12.h>
 #include <ResourceManager\ResourceManager.h>
-#include <ResourceStateManager\ResourceStateManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
 
@@ -58,29 +57,14 @@ ToneMappingPass::RecordAndPushPrePassCommandLists() noexcept
 {
     BRE_ASSERT(IsDataValid());
 
-    D3D12_RESOURCE_BARRIER barriers[2U];
-    std::uint32_t barrierCount = 0UL;
-    if (ResourceStateManager::GetResourceState(*mInputColorBuffer) != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mInputColorBuffer,
-                                                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        ++barrierCount;
-    }
-
-    if (ResourceStateManager::GetResourceState(*mOutputColorBuffer) != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-        barriers[barrierCount] = ResourceStateManager::ChangeResourceStateAndGetBarrier(*mOutputColorBuffer,
-                                                                                        D3D12_RESOURCE_STATE_RENDER_TARGET);
-        ++barrierCount;
-    }
-
-    if (barrierCount > 0UL) {
-        ID3D12GraphicsCommandList& commandList = mPrePassCommandListPerFrame.ResetCommandListWithNextCommandAllocator(nullptr);
-        commandList.ResourceBarrier(barrierCount, barriers);
-        BRE_CHECK_HR(commandList.Close());
-        CommandListExecutor::Get().PushCommandList(commandList);
-
-        return 1U;
-    }
-
-    return 0U;
+    mPrePassResourceStateTracker.Reset();
+    mPrePassResourceStateTracker.ChangeResourceState(*mInputColorBuffer,
+                                                     D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    mPrePassResourceStateTracker.ChangeResourceState(*mOutputColorBuffer,
+                                                     D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    CommandListExecutor::Get().PushResourceStateTransitions(mPrePassResourceStateTracker);
+
+    return 1U;
 }
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <CommandManager\CommandListPerFrame.h>
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
 #include <ToneMappingPass\ToneMappingCommandListRecorder.h>
 
 namespace BRE {
@@ -46,13 +46,13 @@ private:
     bool IsDataValid() const noexcept;
 
     ///
-    /// @brief Records pre pass command lists and pushes them to 
+    /// @brief Pushes pre pass resource state transitions to
     /// the CommandListExecutor.
-    /// @return The number of recorded command lists
+    /// @return The number of pushed command lists
     ///
     std::uint32_t RecordAndPushPrePassCommandLists() noexcept;
 
-    CommandListPerFrame mPrePassCommandListPerFrame;
+    CommandListResourceStateTracker mPrePassResourceStateTracker;
 
     ID3D12Resource* mInputColorBuffer{ nullptr };
     ID3D12Resource* mOutputColorBuffer{ nullptr };
@@ -0,0 +1,108 @@
+#include <UnitTests\Catch.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Utils\AssetRegistry.h>
+#include <Utils\HashUtils.h>
+
+using BRE::AssetRegistry;
+
+namespace {
+const char* sFirstFilePath{ "test_asset_registry_first.bin" };
+const char* sCopyFilePath{ "test_asset_registry_copy.bin" };
+const char* sSameSizeFilePath{ "test_asset_registry_same_size.bin" };
+const char* sOtherSizeFilePath{ "test_asset_registry_other_size.bin" };
+
+///
+/// @brief Writes a file
+/// @param filePath File path
+/// @param content File content
+///
+void
+WriteFile(const char* filePath,
+          const std::string& content)
+{
+    std::ofstream fileStream{ filePath, std::ios::out | std::ios::binary | std::ios::trunc };
+    fileStream.write(content.data(), content.size());
+}
+}
+
+TEST_CASE("Asset registry")
+{
+    WriteFile(sFirstFilePath, "0123456789");
+    WriteFile(sCopyFilePath, "0123456789");
+    WriteFile(sSameSizeFilePath, "9876543210");
+    WriteFile(sOtherSizeFilePath, "01234");
+
+    AssetRegistry assetRegistry;
+
+    SECTION("Canonical paths")
+    {
+        REQUIRE(AssetRegistry::GetCanonicalPath("a/B.dds") == AssetRegistry::GetCanonicalPath("A\\b.dds"));
+        REQUIRE(AssetRegistry::GetCanonicalPath("a/./b.dds") == AssetRegistry::GetCanonicalPath("a/c/../b.dds"));
+        REQUIRE(AssetRegistry::GetCanonicalPath("a/b.dds") != AssetRegistry::GetCanonicalPath("a/c.dds"));
+    }
+
+    SECTION("Files with the same path or content are unique once")
+    {
+        const std::string dotFirstFilePath = std::string("./") + sFirstFilePath;
+        const std::vector<std::string> paths{
+            sFirstFilePath,
+            sFirstFilePath,
+            dotFirstFilePath,
+            sCopyFilePath,
+            sSameSizeFilePath,
+            sOtherSizeFilePath,
+        };
+        assetRegistry.RegisterFiles(paths);
+
+        REQUIRE(assetRegistry.GetUniquePath(sFirstFilePath) == sFirstFilePath);
+        REQUIRE(assetRegistry.GetUniquePath(dotFirstFilePath) == sFirstFilePath);
+        REQUIRE(assetRegistry.GetUniquePath(sCopyFilePath) == sFirstFilePath);
+        REQUIRE(assetRegistry.GetUniquePath(sSameSizeFilePath) == sSameSizeFilePath);
+        REQUIRE(assetRegistry.GetUniquePath(sOtherSizeFilePath) == sOtherSizeFilePath);
+
+        const AssetRegistry::Statistics& statistics = assetRegistry.GetStatistics();
+        REQUIRE(statistics.mReferenceCount == 6U);
+        REQUIRE(statistics.mUniqueFileCount == 3U);
+        REQUIRE(statistics.mPathHitCount == 2U);
+        REQUIRE(statistics.mContentHitCount == 1U);
+        REQUIRE(statistics.mSavedBytes == 30U);
+    }
+
+    SECTION("Files registered later are compared with the registered files")
+    {
+        assetRegistry.RegisterFiles(std::vector<std::string>{ sFirstFilePath });
+        assetRegistry.RegisterFiles(std::vector<std::string>{ sOtherSizeFilePath, sCopyFilePath });
+
+        REQUIRE(assetRegistry.GetUniquePath(sCopyFilePath) == sFirstFilePath);
+        REQUIRE(assetRegistry.GetStatistics().mUniqueFileCount == 2U);
+        REQUIRE(assetRegistry.GetStatistics().mContentHitCount == 1U);
+    }
+
+    SECTION("Content hashes are computed once for loaders")
+    {
+        assetRegistry.RegisterFiles(std::vector<std::string>{ sFirstFilePath, sCopyFilePath, sOtherSizeFilePath });
+
+        const std::uint64_t firstFileContentHash = BRE::HashUtils::ComputeHash("0123456789", 10U);
+        REQUIRE(assetRegistry.GetContentHash(sFirstFilePath) == firstFileContentHash);
+        REQUIRE(assetRegistry.GetContentHash(sCopyFilePath) == firstFileContentHash);
+        REQUIRE(assetRegistry.GetContentHash(sOtherSizeFilePath) == BRE::HashUtils::ComputeHash("01234", 5U));
+    }
+
+    SECTION("Files that cannot be opened are unique")
+    {
+        assetRegistry.RegisterFiles(std::vector<std::string>{ "test_asset_registry_missing.bin", "test_asset_registry_missing2.bin" });
+
+        REQUIRE(assetRegistry.GetUniquePath("test_asset_registry_missing2.bin") == "test_asset_registry_missing2.bin");
+        REQUIRE(assetRegistry.GetStatistics().mUniqueFileCount == 2U);
+    }
+
+    std::remove(sFirstFilePath);
+    std::remove(sCopyFilePath);
+    std::remove(sSameSizeFilePath);
+    std::remove(sOtherSizeFilePath);
+}
\ No newline at end of file
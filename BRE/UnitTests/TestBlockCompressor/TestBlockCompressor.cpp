@@ -0,0 +1,361 @@
+#include <UnitTests\Catch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <ResourceManager\BlockCompressor.h>
+#include <ResourceManager\DDSTextureLoader.h>
+#include <ResourceManager\TextureCooker.h>
+#include <Utils\MemoryMappedFile.h>
+
+using BRE::BlockCompressor::Format;
+using BRE::MemoryMappedFile;
+using BRE::TextureCooker;
+
+namespace {
+///
+/// @brief Creates a smooth RGBA8 image
+/// @param size Image width and height
+/// @param texels Output tightly packed texels
+///
+void
+CreateGradientImage(const std::uint32_t size,
+                    std::vector<std::uint8_t>& texels)
+{
+    const std::uint32_t maxCoordinate = std::max(size - 1U, 1U);
+    texels.resize(size * size * 4U);
+    for (std::uint32_t y = 0U; y < size; ++y) {
+        for (std::uint32_t x = 0U; x < size; ++x) {
+            std::uint8_t* texel = texels.data() + (y * size + x) * 4U;
+            texel[0U] = static_cast<std::uint8_t>(x * 255U / maxCoordinate);
+            texel[1U] = static_cast<std::uint8_t>(y * 255U / maxCoordinate);
+            texel[2U] = static_cast<std::uint8_t>((x + y) * 255U / (2U * maxCoordinate));
+            texel[3U] = static_cast<std::uint8_t>(255U - x * 255U / maxCoordinate);
+        }
+    }
+}
+
+///
+/// @brief Compresses and decompresses an image
+/// @param format Block compressed format
+/// @param texels Tightly packed RGBA8 texels
+/// @param width Image width
+/// @param height Image height
+/// @param decompressedTexels Output decompressed texels
+///
+void
+CompressAndDecompressImage(const Format format,
+                           const std::vector<std::uint8_t>& texels,
+                           const std::uint32_t width,
+                           const std::uint32_t height,
+                           std::vector<std::uint8_t>& decompressedTexels)
+{
+    std::vector<std::uint8_t> blocks(BRE::BlockCompressor::GetCompressedSizeInBytes(format, width, height));
+    BRE::BlockCompressor::CompressImage(format, texels.data(), width, height, width * 4U, blocks.data());
+    decompressedTexels.resize(texels.size());
+    BRE::BlockCompressor::DecompressImage(format, blocks.data(), width, height, decompressedTexels.data());
+}
+
+///
+/// @brief Creates DDS data of a RGBA8 square texture with all its mip levels
+/// @param size Size of mip level 0
+/// @param mipLevelCount Number of mip levels
+/// @param alpha Alpha of all the texels
+/// @param ddsData Output DDS data
+///
+void
+CreateRGBA8DDSData(const std::uint32_t size,
+                   const std::uint32_t mipLevelCount,
+                   const std::uint8_t alpha,
+                   std::vector<std::uint8_t>& ddsData)
+{
+    // Magic number and DDS_HEADER as 32 bits words
+    std::uint32_t header[32U]{};
+    header[0U] = 0x20534444U; // "DDS "
+    header[1U] = 124U; // size
+    header[2U] = 0x1007U | 0x20000U; // DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP
+    header[3U] = size; // height
+    header[4U] = size; // width
+    header[5U] = size * 4U; // pitch
+    header[7U] = mipLevelCount;
+    header[19U] = 32U; // pixel format size
+    header[20U] = 0x41U; // DDS_RGBA
+    header[22U] = 32U; // bits per pixel
+    header[23U] = 0x000000FFU; // red mask
+    header[24U] = 0x0000FF00U; // green mask
+    header[25U] = 0x00FF0000U; // blue mask
+    header[26U] = 0xFF000000U; // alpha mask
+    header[27U] = 0x1000U | 0x400008U; // DDS_SURFACE_FLAGS_TEXTURE | DDS_SURFACE_FLAGS_MIPMAP
+
+    ddsData.assign(reinterpret_cast<const std::uint8_t*>(header),
+                   reinterpret_cast<const std::uint8_t*>(header) + sizeof(header));
+
+    std::vector<std::uint8_t> texels;
+    for (std::uint32_t i = 0U; i < mipLevelCount; ++i) {
+        const std::uint32_t mipLevelSize = size >> i;
+        CreateGradientImage(mipLevelSize, texels);
+        for (std::size_t j = 3U; j < texels.size(); j += 4U) {
+            texels[j] = alpha;
+        }
+        ddsData.insert(ddsData.end(), texels.begin(), texels.end());
+    }
+}
+}
+
+TEST_CASE("Compressed sizes")
+{
+    REQUIRE(BRE::BlockCompressor::GetCompressedSizeInBytes(Format::BC1, 4U, 4U) == 8U);
+    REQUIRE(BRE::BlockCompressor::GetCompressedSizeInBytes(Format::BC4, 8U, 4U) == 16U);
+    REQUIRE(BRE::BlockCompressor::GetCompressedSizeInBytes(Format::BC3, 5U, 5U) == 64U);
+    REQUIRE(BRE::BlockCompressor::GetCompressedSizeInBytes(Format::BC5, 1U, 1U) == 16U);
+    REQUIRE(BRE::BlockCompressor::GetCompressedSizeInBytes(Format::BC7, 16U, 16U) == 256U);
+}
+
+TEST_CASE("Constant blocks are lossless")
+{
+    // Channels are representable in RGB565, and they are odd, so BC7 p-bits are 1.
+    const std::uint8_t color[4U]{ 255U, 255U, 33U, 129U };
+    std::uint8_t texels[64U];
+    for (std::uint32_t i = 0U; i < 16U; ++i) {
+        std::memcpy(texels + i * 4U, color, 4U);
+    }
+
+    const Format formats[]{ Format::BC1, Format::BC3, Format::BC4, Format::BC5, Format::BC7 };
+    for (const Format format : formats) {
+        std::uint8_t block[16U];
+        std::uint8_t decompressedTexels[64U];
+        BRE::BlockCompressor::CompressBlock(format, texels, block);
+        BRE::BlockCompressor::DecompressBlock(format, block, decompressedTexels);
+
+        const std::uint32_t channelCount = BRE::BlockCompressor::GetChannelCount(format);
+        REQUIRE(BRE::BlockCompressor::ComputePsnr(texels, decompressedTexels, 16U, channelCount) ==
+                std::numeric_limits<double>::infinity());
+    }
+}
+
+TEST_CASE("Single channel blocks keep their endpoints")
+{
+    std::uint8_t texels[64U]{};
+    for (std::uint32_t i = 0U; i < 16U; ++i) {
+        texels[i * 4U] = i % 2U == 0U ? 10U : 200U;
+        texels[i * 4U + 1U] = i < 8U ? 50U : 100U;
+    }
+
+    std::uint8_t block[16U];
+    std::uint8_t decompressedTexels[64U];
+
+    SECTION("BC4")
+    {
+        BRE::BlockCompressor::CompressBlock(Format::BC4, texels, block);
+        BRE::BlockCompressor::DecompressBlock(Format::BC4, block, decompressedTexels);
+        REQUIRE(BRE::BlockCompressor::ComputePsnr(texels, decompressedTexels, 16U, 1U) ==
+                std::numeric_limits<double>::infinity());
+        REQUIRE(decompressedTexels[1U] == 0U);
+        REQUIRE(decompressedTexels[3U] == 255U);
+    }
+
+    SECTION("BC5")
+    {
+        BRE::BlockCompressor::CompressBlock(Format::BC5, texels, block);
+        BRE::BlockCompressor::DecompressBlock(Format::BC5, block, decompressedTexels);
+        REQUIRE(decompressedTexels[0U] == 10U);
+        REQUIRE(decompressedTexels[4U] == 200U);
+        REQUIRE(decompressedTexels[1U] == 50U);
+        REQUIRE(decompressedTexels[61U] == 100U);
+        REQUIRE(decompressedTexels[62U] == 0U);
+        REQUIRE(BRE::BlockCompressor::ComputePsnr(texels, decompressedTexels, 16U, 2U) ==
+                std::numeric_limits<double>::infinity());
+    }
+}
+
+TEST_CASE("BC7 mode 6 block")
+{
+    // The anchor texel is the brightest one, so endpoints must be swapped.
+    std::uint8_t texels[64U]{};
+    for (std::uint32_t i = 0U; i < 16U; ++i) {
+        const std::uint8_t value = static_cast<std::uint8_t>(255U - i * 16U);
+        texels[i * 4U] = value;
+        texels[i * 4U + 1U] = value;
+        texels[i * 4U + 2U] = value;
+        texels[i * 4U + 3U] = 255U;
+    }
+
+    std::uint8_t block[16U];
+    std::uint8_t decompressedTexels[64U];
+    BRE::BlockCompressor::CompressBlock(Format::BC7, texels, block);
+    BRE::BlockCompressor::DecompressBlock(Format::BC7, block, decompressedTexels);
+
+    REQUIRE((block[0U] & 0x7FU) == 0x40U);
+    REQUIRE(decompressedTexels[0U] >= 250U);
+    REQUIRE(decompressedTexels[60U] <= 20U);
+    REQUIRE(BRE::BlockCompressor::ComputePsnr(texels, decompressedTexels, 16U, 4U) > 35.0);
+}
+
+TEST_CASE("Compressed images")
+{
+    std::vector<std::uint8_t> texels;
+    std::vector<std::uint8_t> decompressedTexels;
+
+    SECTION("Smooth images")
+    {
+        CreateGradientImage(64U, texels);
+
+        CompressAndDecompressImage(Format::BC1, texels, 64U, 64U, decompressedTexels);
+        REQUIRE(BRE::BlockCompressor::ComputePsnr(texels.data(), decompressedTexels.data(), 64U * 64U, 3U) > 35.0);
+
+        CompressAndDecompressImage(Format::BC3, texels, 64U, 64U, decompressedTexels);
+        REQUIRE(BRE::BlockCompressor::ComputePsnr(texels.data(), decompressedTexels.data(), 64U * 64U, 4U) > 35.0);
+
+        CompressAndDecompressImage(Format::BC4, texels, 64U, 64U, decompressedTexels);
+        REQUIRE(BRE::BlockCompressor::ComputePsnr(texels.data(), decompressedTexels.data(), 64U * 64U, 1U) > 45.0);
+
+        CompressAndDecompressImage(Format::BC5, texels, 64U, 64U, decompressedTexels);
+        REQUIRE(BRE::BlockCompressor::ComputePsnr(texels.data(), decompressedTexels.data(), 64U * 64U, 2U) > 45.0);
+
+        CompressAndDecompressImage(Format::BC7, texels, 64U, 64U, decompressedTexels);
+        REQUIRE(BRE::BlockCompressor::ComputePsnr(texels.data(), decompressedTexels.data(), 64U * 64U, 4U) > 38.0);
+    }
+
+    SECTION("Sizes that are not multiple of the block size")
+    {
+        texels.assign(5U * 3U * 4U, 0U);
+        for (std::size_t i = 0U; i < texels.size(); i += 4U) {
+            texels[i] = (i / 4U) % 2U == 0U ? 10U : 200U;
+            texels[i + 3U] = 255U;
+        }
+
+        CompressAndDecompressImage(Format::BC4, texels, 5U, 3U, decompressedTexels);
+        REQUIRE(BRE::BlockCompressor::ComputePsnr(texels.data(), decompressedTexels.data(), 5U * 3U, 1U) ==
+                std::numeric_limits<double>::infinity());
+    }
+}
+
+TEST_CASE("Cook textures")
+{
+    std::vector<std::uint8_t> sourceData;
+    std::vector<std::uint8_t> cookedData;
+    TextureCooker::CookStatistics statistics;
+
+    D3D12_RESOURCE_DESC textureDescriptor{};
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+
+    SECTION("Formats are chosen by usage")
+    {
+        CreateRGBA8DDSData(16U, 5U, 255U, sourceData);
+
+        REQUIRE(TextureCooker::CookTexture(sourceData.data(), sourceData.size(), TextureCooker::Usage::COLOR, cookedData, statistics));
+        REQUIRE(statistics.mFormat == Format::BC1);
+        REQUIRE(statistics.mPsnr > 30.0);
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(cookedData.data(), cookedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Format == DXGI_FORMAT_BC1_UNORM);
+        REQUIRE(textureDescriptor.Width == 16U);
+        REQUIRE(textureDescriptor.MipLevels == 5U);
+        REQUIRE(subresources.size() == 5U);
+        REQUIRE(subresources[0U].SlicePitch == 128);
+        REQUIRE(subresources[4U].SlicePitch == 8);
+
+        REQUIRE(TextureCooker::CookTexture(sourceData.data(), sourceData.size(), TextureCooker::Usage::NORMAL, cookedData, statistics));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(cookedData.data(), cookedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Format == DXGI_FORMAT_BC5_UNORM);
+
+        REQUIRE(TextureCooker::CookTexture(sourceData.data(), sourceData.size(), TextureCooker::Usage::SINGLE_CHANNEL, cookedData, statistics));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(cookedData.data(), cookedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Format == DXGI_FORMAT_BC4_UNORM);
+
+        REQUIRE(TextureCooker::CookTexture(sourceData.data(), sourceData.size(), TextureCooker::Usage::CHANNEL_PACKED, cookedData, statistics));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(cookedData.data(), cookedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Format == DXGI_FORMAT_BC7_UNORM);
+    }
+
+    SECTION("Textures with alpha are cooked to BC3")
+    {
+        CreateRGBA8DDSData(16U, 1U, 128U, sourceData);
+
+        REQUIRE(TextureCooker::CookTexture(sourceData.data(), sourceData.size(), TextureCooker::Usage::COLOR, cookedData, statistics));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(cookedData.data(), cookedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Format == DXGI_FORMAT_BC3_UNORM);
+    }
+
+    SECTION("Sizes that are not multiple of the block size are not cooked")
+    {
+        CreateRGBA8DDSData(2U, 1U, 255U, sourceData);
+
+        REQUIRE(TextureCooker::CookTexture(sourceData.data(), sourceData.size(), TextureCooker::Usage::COLOR, cookedData, statistics) == false);
+    }
+}
+
+// Reports compression throughput and error of the bundled textures.
+// Block compressed textures are decompressed first, and compressed again to each format.
+// It must be run explicitly, from the Executable directory: UnitTests.exe [benchmark]
+TEST_CASE("Block compression throughput", "[.][benchmark]")
+{
+    struct BundledTexture {
+        const char* mFilename;
+        DXGI_FORMAT mFormat;
+        Format mSourceFormat;
+    };
+
+    const BundledTexture bundledTextures[]{
+        { "resources/textures/brick/brick3.dds", DXGI_FORMAT_BC3_UNORM, Format::BC3 },
+        { "resources/textures/metalness0.dds", DXGI_FORMAT_R8_UNORM, Format::BC4 },
+        { "resources/textures/roughness0.5.dds", DXGI_FORMAT_R8_UNORM, Format::BC4 },
+    };
+
+    for (const BundledTexture& bundledTexture : bundledTextures) {
+        MemoryMappedFile textureFile;
+        REQUIRE(textureFile.Open(bundledTexture.mFilename));
+
+        D3D12_RESOURCE_DESC textureDescriptor{};
+        std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(textureFile.GetData(),
+                                                                  textureFile.GetSize(),
+                                                                  textureDescriptor,
+                                                                  subresources)));
+        REQUIRE(textureDescriptor.Format == bundledTexture.mFormat);
+
+        // Mip level 0 as tightly packed RGBA8 texels
+        const std::uint32_t width = static_cast<std::uint32_t>(textureDescriptor.Width);
+        const std::uint32_t height = textureDescriptor.Height;
+        std::vector<std::uint8_t> texels(width * height * 4U);
+        if (bundledTexture.mFormat == DXGI_FORMAT_R8_UNORM) {
+            for (std::uint32_t y = 0U; y < height; ++y) {
+                const std::uint8_t* row = static_cast<const std::uint8_t*>(subresources[0U].pData) + y * subresources[0U].RowPitch;
+                for (std::uint32_t x = 0U; x < width; ++x) {
+                    std::uint8_t* texel = texels.data() + (y * width + x) * 4U;
+                    texel[0U] = row[x];
+                    texel[1U] = row[x];
+                    texel[2U] = row[x];
+                    texel[3U] = 255U;
+                }
+            }
+        } else {
+            BRE::BlockCompressor::DecompressImage(bundledTexture.mSourceFormat,
+                                                  static_cast<const std::uint8_t*>(subresources[0U].pData),
+                                                  width,
+                                                  height,
+                                                  texels.data());
+        }
+
+        const Format formats[]{ Format::BC1, Format::BC3, Format::BC4, Format::BC5, Format::BC7 };
+        for (const Format format : formats) {
+            std::vector<std::uint8_t> blocks(BRE::BlockCompressor::GetCompressedSizeInBytes(format, width, height));
+
+            const auto startTime = std::chrono::high_resolution_clock::now();
+            BRE::BlockCompressor::CompressImage(format, texels.data(), width, height, width * 4U, blocks.data());
+            const auto endTime = std::chrono::high_resolution_clock::now();
+
+            std::vector<std::uint8_t> decompressedTexels(texels.size());
+            BRE::BlockCompressor::DecompressImage(format, blocks.data(), width, height, decompressedTexels.data());
+
+            const double timeInSeconds = std::chrono::duration<double>(endTime - startTime).count();
+            const std::uint32_t channelCount = BRE::BlockCompressor::GetChannelCount(format);
+            WARN(bundledTexture.mFilename << ": BC" << (format == Format::BC1 ? 1 : format == Format::BC3 ? 3 : format == Format::BC4 ? 4 : format == Format::BC5 ? 5 : 7) <<
+                 " " << width * height / timeInSeconds / 1000000.0 << " MPix/s, PSNR " <<
+                 BRE::BlockCompressor::ComputePsnr(texels.data(), decompressedTexels.data(), width * height, channelCount) << " dB");
+        }
+    }
+}
@@ -0,0 +1,317 @@
+#include <UnitTests\Catch.h>
+
+#include <cstring>
+#include <vector>
+
+#include <ResourceManager\BlockCompressor.h>
+#include <ResourceManager\ChannelPacker.h>
+#include <ResourceManager\DDSTextureLoader.h>
+
+using BRE::ChannelPacker;
+
+namespace {
+///
+/// @brief Get the texel of a single channel test image
+/// @param x Texel x coordinate
+/// @param y Texel y coordinate
+/// @param seed Seed that makes different images
+/// @return Texel
+///
+std::uint8_t
+GetTestTexel(const std::uint32_t x,
+             const std::uint32_t y,
+             const std::uint32_t seed)
+{
+    return static_cast<std::uint8_t>((x * 7U + y * 13U + seed) & 0xFFU);
+}
+
+///
+/// @brief Creates DDS data of a R8 square texture with all its mip levels
+/// @param size Size of mip level 0
+/// @param mipLevelCount Number of mip levels
+/// @param seed Seed of the test image of each mip level
+/// @param ddsData Output DDS data
+///
+void
+CreateR8DDSData(const std::uint32_t size,
+                const std::uint32_t mipLevelCount,
+                const std::uint32_t seed,
+                std::vector<std::uint8_t>& ddsData)
+{
+    // Magic number and DDS_HEADER as 32 bits words
+    std::uint32_t header[32U]{};
+    header[0U] = 0x20534444U; // "DDS "
+    header[1U] = 124U; // size
+    header[2U] = 0x1007U | 0x20000U; // DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP
+    header[3U] = size; // height
+    header[4U] = size; // width
+    header[5U] = size; // pitch
+    header[7U] = mipLevelCount;
+    header[19U] = 32U; // pixel format size
+    header[20U] = 0x20000U; // DDS_LUMINANCE
+    header[22U] = 8U; // bits per pixel
+    header[23U] = 0x000000FFU; // red mask
+    header[27U] = 0x1000U | 0x400008U; // DDS_SURFACE_FLAGS_TEXTURE | DDS_SURFACE_FLAGS_MIPMAP
+
+    ddsData.assign(reinterpret_cast<const std::uint8_t*>(header),
+                   reinterpret_cast<const std::uint8_t*>(header) + sizeof(header));
+
+    for (std::uint32_t i = 0U; i < mipLevelCount; ++i) {
+        const std::uint32_t mipLevelSize = size >> i;
+        for (std::uint32_t y = 0U; y < mipLevelSize; ++y) {
+            for (std::uint32_t x = 0U; x < mipLevelSize; ++x) {
+                ddsData.push_back(GetTestTexel(x, y, seed + i));
+            }
+        }
+    }
+}
+
+///
+/// @brief Creates DDS data of a block compressed square texture with one mip level
+/// @param size Texture size. It must be multiple of the block size.
+/// @param fourCC FourCC of the format
+/// @param blocks Blocks of the texture
+/// @param ddsData Output DDS data
+///
+void
+CreateBlockCompressedDDSData(const std::uint32_t size,
+                             const std::uint32_t fourCC,
+                             const std::vector<std::uint8_t>& blocks,
+                             std::vector<std::uint8_t>& ddsData)
+{
+    // Magic number and DDS_HEADER as 32 bits words
+    std::uint32_t header[32U]{};
+    header[0U] = 0x20534444U; // "DDS "
+    header[1U] = 124U; // size
+    header[2U] = 0x1007U | 0x80000U; // DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_LINEARSIZE
+    header[3U] = size; // height
+    header[4U] = size; // width
+    header[5U] = static_cast<std::uint32_t>(blocks.size()); // linear size
+    header[7U] = 1U;
+    header[19U] = 32U; // pixel format size
+    header[20U] = 0x4U; // DDS_FOURCC
+    header[21U] = fourCC;
+    header[27U] = 0x1000U; // DDS_SURFACE_FLAGS_TEXTURE
+
+    ddsData.assign(reinterpret_cast<const std::uint8_t*>(header),
+                   reinterpret_cast<const std::uint8_t*>(header) + sizeof(header));
+    ddsData.insert(ddsData.end(), blocks.begin(), blocks.end());
+}
+
+///
+/// @brief Get a texel of a RGBA8 subresource
+/// @param subresource Subresource
+/// @param x Texel x coordinate
+/// @param y Texel y coordinate
+/// @return Texel
+///
+const std::uint8_t*
+GetTexel(const D3D12_SUBRESOURCE_DATA& subresource,
+         const std::uint32_t x,
+         const std::uint32_t y)
+{
+    return static_cast<const std::uint8_t*>(subresource.pData) + y * subresource.RowPitch + x * 4U;
+}
+}
+
+TEST_CASE("Pack channels")
+{
+    // Two SIMD iterations and a scalar tail
+    const std::size_t texelCount{ 37U };
+    std::vector<std::uint8_t> redChannel(texelCount);
+    std::vector<std::uint8_t> greenChannel(texelCount);
+    std::vector<std::uint8_t> blueChannel(texelCount);
+    for (std::size_t i = 0U; i < texelCount; ++i) {
+        redChannel[i] = static_cast<std::uint8_t>(i);
+        greenChannel[i] = static_cast<std::uint8_t>(100U + i);
+        blueChannel[i] = static_cast<std::uint8_t>(255U - i);
+    }
+
+    std::vector<std::uint8_t> texels(texelCount * 4U);
+    const std::uint8_t channelValues[]{ 10U, 20U, 30U };
+
+    SECTION("Red, green and blue channels")
+    {
+        ChannelPacker::PackChannels(redChannel.data(), greenChannel.data(), blueChannel.data(), channelValues, texelCount, texels.data());
+        for (std::size_t i = 0U; i < texelCount; ++i) {
+            REQUIRE(texels[i * 4U] == redChannel[i]);
+            REQUIRE(texels[i * 4U + 1U] == greenChannel[i]);
+            REQUIRE(texels[i * 4U + 2U] == blueChannel[i]);
+            REQUIRE(texels[i * 4U + 3U] == 255U);
+        }
+    }
+
+    SECTION("Missing channels are constant")
+    {
+        ChannelPacker::PackChannels(nullptr, greenChannel.data(), nullptr, channelValues, texelCount, texels.data());
+        for (std::size_t i = 0U; i < texelCount; ++i) {
+            REQUIRE(texels[i * 4U] == 10U);
+            REQUIRE(texels[i * 4U + 1U] == greenChannel[i]);
+            REQUIRE(texels[i * 4U + 2U] == 30U);
+            REQUIRE(texels[i * 4U + 3U] == 255U);
+        }
+    }
+
+    SECTION("Channel values are clamped and rounded")
+    {
+        REQUIRE(ChannelPacker::GetChannelValue(-1.0f) == 0U);
+        REQUIRE(ChannelPacker::GetChannelValue(0.0f) == 0U);
+        REQUIRE(ChannelPacker::GetChannelValue(0.5f) == 128U);
+        REQUIRE(ChannelPacker::GetChannelValue(1.0f) == 255U);
+        REQUIRE(ChannelPacker::GetChannelValue(2.0f) == 255U);
+    }
+}
+
+TEST_CASE("Pack textures")
+{
+    std::vector<std::uint8_t> redData;
+    std::vector<std::uint8_t> greenData;
+    std::vector<std::uint8_t> blueData;
+    std::vector<std::uint8_t> packedData;
+    const std::uint8_t channelValues[]{ 0U, 0U, 0U };
+
+    D3D12_RESOURCE_DESC textureDescriptor{};
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+
+    SECTION("Textures of the same size")
+    {
+        CreateR8DDSData(16U, 5U, 0U, redData);
+        CreateR8DDSData(16U, 5U, 50U, greenData);
+        CreateR8DDSData(16U, 5U, 100U, blueData);
+
+        const std::uint8_t* sourceData[]{ redData.data(), greenData.data(), blueData.data() };
+        const std::size_t sourceDataSizes[]{ redData.size(), greenData.size(), blueData.size() };
+        REQUIRE(ChannelPacker::PackTextures(sourceData, sourceDataSizes, channelValues, packedData));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(packedData.data(), packedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Format == DXGI_FORMAT_R8G8B8A8_UNORM);
+        REQUIRE(textureDescriptor.Width == 16U);
+        REQUIRE(textureDescriptor.Height == 16U);
+        REQUIRE(textureDescriptor.MipLevels == 5U);
+        REQUIRE(subresources.size() == 5U);
+
+        for (std::uint32_t i = 0U; i < 5U; ++i) {
+            const std::uint32_t mipLevelSize = 16U >> i;
+            for (std::uint32_t y = 0U; y < mipLevelSize; ++y) {
+                for (std::uint32_t x = 0U; x < mipLevelSize; ++x) {
+                    const std::uint8_t* texel = GetTexel(subresources[i], x, y);
+                    REQUIRE(texel[0U] == GetTestTexel(x, y, i));
+                    REQUIRE(texel[1U] == GetTestTexel(x, y, 50U + i));
+                    REQUIRE(texel[2U] == GetTestTexel(x, y, 100U + i));
+                    REQUIRE(texel[3U] == 255U);
+                }
+            }
+        }
+    }
+
+    SECTION("Smaller textures are resampled, and the lowest mip level count is used")
+    {
+        CreateR8DDSData(16U, 5U, 0U, redData);
+        CreateR8DDSData(8U, 3U, 50U, greenData);
+
+        const std::uint8_t* sourceData[]{ redData.data(), greenData.data(), nullptr };
+        const std::size_t sourceDataSizes[]{ redData.size(), greenData.size(), 0U };
+        REQUIRE(ChannelPacker::PackTextures(sourceData, sourceDataSizes, channelValues, packedData));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(packedData.data(), packedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Width == 16U);
+        REQUIRE(textureDescriptor.Height == 16U);
+        REQUIRE(textureDescriptor.MipLevels == 3U);
+
+        for (std::uint32_t i = 0U; i < 3U; ++i) {
+            const std::uint32_t mipLevelSize = 16U >> i;
+            for (std::uint32_t y = 0U; y < mipLevelSize; ++y) {
+                for (std::uint32_t x = 0U; x < mipLevelSize; ++x) {
+                    const std::uint8_t* texel = GetTexel(subresources[i], x, y);
+                    REQUIRE(texel[0U] == GetTestTexel(x, y, i));
+                    REQUIRE(texel[1U] == GetTestTexel(x / 2U, y / 2U, 50U + i));
+                    REQUIRE(texel[2U] == 0U);
+                }
+            }
+        }
+    }
+
+    SECTION("Block compressed textures are decompressed")
+    {
+        std::vector<std::uint8_t> texels(16U * 16U * 4U);
+        for (std::uint32_t y = 0U; y < 16U; ++y) {
+            for (std::uint32_t x = 0U; x < 16U; ++x) {
+                std::memset(texels.data() + (y * 16U + x) * 4U, GetTestTexel(x, y, 50U), 4U);
+            }
+        }
+
+        const BRE::BlockCompressor::Format format{ BRE::BlockCompressor::Format::BC4 };
+        std::vector<std::uint8_t> blocks(BRE::BlockCompressor::GetCompressedSizeInBytes(format, 16U, 16U));
+        BRE::BlockCompressor::CompressImage(format, texels.data(), 16U, 16U, 16U * 4U, blocks.data());
+        BRE::BlockCompressor::DecompressImage(format, blocks.data(), 16U, 16U, texels.data());
+
+        CreateR8DDSData(16U, 1U, 0U, redData);
+        CreateBlockCompressedDDSData(16U, 0x55344342U, blocks, greenData); // "BC4U"
+
+        const std::uint8_t* sourceData[]{ redData.data(), greenData.data(), nullptr };
+        const std::size_t sourceDataSizes[]{ redData.size(), greenData.size(), 0U };
+        REQUIRE(ChannelPacker::PackTextures(sourceData, sourceDataSizes, channelValues, packedData));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(packedData.data(), packedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.MipLevels == 1U);
+
+        for (std::uint32_t y = 0U; y < 16U; ++y) {
+            for (std::uint32_t x = 0U; x < 16U; ++x) {
+                REQUIRE(GetTexel(subresources[0U], x, y)[1U] == texels[(y * 16U + x) * 4U]);
+            }
+        }
+    }
+
+    SECTION("Unsupported formats are not packed")
+    {
+        const BRE::BlockCompressor::Format format{ BRE::BlockCompressor::Format::BC5 };
+        std::vector<std::uint8_t> blocks(BRE::BlockCompressor::GetCompressedSizeInBytes(format, 16U, 16U), 0U);
+
+        CreateR8DDSData(16U, 1U, 0U, redData);
+        CreateBlockCompressedDDSData(16U, 0x55354342U, blocks, greenData); // "BC5U"
+
+        const std::uint8_t* sourceData[]{ redData.data(), greenData.data(), nullptr };
+        const std::size_t sourceDataSizes[]{ redData.size(), greenData.size(), 0U };
+        REQUIRE(ChannelPacker::PackTextures(sourceData, sourceDataSizes, channelValues, packedData) == false);
+    }
+
+    SECTION("Constant channels are filled with their values")
+    {
+        CreateR8DDSData(8U, 4U, 50U, greenData);
+
+        const std::uint8_t constantChannelValues[]{ 64U, 0U, 192U };
+        const std::uint8_t* sourceData[]{ nullptr, greenData.data(), nullptr };
+        const std::size_t sourceDataSizes[]{ 0U, greenData.size(), 0U };
+        REQUIRE(ChannelPacker::PackTextures(sourceData, sourceDataSizes, constantChannelValues, packedData));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(packedData.data(), packedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Width == 8U);
+        REQUIRE(textureDescriptor.MipLevels == 4U);
+
+        for (std::uint32_t i = 0U; i < 4U; ++i) {
+            const std::uint32_t mipLevelSize = 8U >> i;
+            for (std::uint32_t y = 0U; y < mipLevelSize; ++y) {
+                for (std::uint32_t x = 0U; x < mipLevelSize; ++x) {
+                    const std::uint8_t* texel = GetTexel(subresources[i], x, y);
+                    REQUIRE(texel[0U] == 64U);
+                    REQUIRE(texel[1U] == GetTestTexel(x, y, 50U + i));
+                    REQUIRE(texel[2U] == 192U);
+                }
+            }
+        }
+    }
+
+    SECTION("Constant channels only are packed to a 1x1 texture")
+    {
+        const std::uint8_t constantChannelValues[]{ 64U, 128U, 192U };
+        const std::uint8_t* sourceData[]{ nullptr, nullptr, nullptr };
+        const std::size_t sourceDataSizes[]{ 0U, 0U, 0U };
+        REQUIRE(ChannelPacker::PackTextures(sourceData, sourceDataSizes, constantChannelValues, packedData));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(packedData.data(), packedData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Width == 1U);
+        REQUIRE(textureDescriptor.Height == 1U);
+        REQUIRE(textureDescriptor.MipLevels == 1U);
+
+        const std::uint8_t* texel = GetTexel(subresources[0U], 0U, 0U);
+        REQUIRE(texel[0U] == 64U);
+        REQUIRE(texel[1U] == 128U);
+        REQUIRE(texel[2U] == 192U);
+        REQUIRE(texel[3U] == 255U);
+    }
+}
@@ -0,0 +1,196 @@
+#include <UnitTests\Catch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <ResourceManager\DDSTextureLoader.h>
+#include <Utils\MemoryMappedFile.h>
+#include <Utils\StringUtils.h>
+
+using BRE::MemoryMappedFile;
+
+namespace {
+///
+/// @brief Creates DDS data of a RGBA8 square texture with all its mip levels
+/// @param size Size of mip level 0
+/// @param mipLevelCount Number of mip levels
+/// @param ddsData Output DDS data
+///
+void
+CreateRGBA8DDSData(const std::uint32_t size,
+                   const std::uint32_t mipLevelCount,
+                   std::vector<std::uint8_t>& ddsData)
+{
+    // Magic number and DDS_HEADER as 32 bits words
+    std::uint32_t header[32U]{};
+    header[0U] = 0x20534444U; // "DDS "
+    header[1U] = 124U; // size
+    header[2U] = 0x1007U | 0x20000U; // DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP
+    header[3U] = size; // height
+    header[4U] = size; // width
+    header[5U] = size * 4U; // pitch
+    header[7U] = mipLevelCount;
+    header[19U] = 32U; // pixel format size
+    header[20U] = 0x41U; // DDS_RGBA
+    header[22U] = 32U; // bits per pixel
+    header[23U] = 0x000000FFU; // red mask
+    header[24U] = 0x0000FF00U; // green mask
+    header[25U] = 0x00FF0000U; // blue mask
+    header[26U] = 0xFF000000U; // alpha mask
+    header[27U] = 0x1000U | 0x400008U; // DDS_SURFACE_FLAGS_TEXTURE | DDS_SURFACE_FLAGS_MIPMAP
+
+    ddsData.assign(reinterpret_cast<const std::uint8_t*>(header),
+                   reinterpret_cast<const std::uint8_t*>(header) + sizeof(header));
+
+    for (std::uint32_t i = 0U; i < mipLevelCount; ++i) {
+        const std::uint32_t mipLevelSize = std::max(size >> i, 1U);
+        ddsData.resize(ddsData.size() + mipLevelSize * mipLevelSize * 4U, static_cast<std::uint8_t>(i));
+    }
+}
+
+///
+/// @brief Copies subresources to a scratch buffer with the row pitch alignment
+/// of an upload heap, like the upload to the staging ring does.
+/// @param subresources Subresources
+/// @param scratchBuffer Scratch buffer
+///
+void
+CopySubresources(const std::vector<D3D12_SUBRESOURCE_DATA>& subresources,
+                 std::vector<std::uint8_t>& scratchBuffer)
+{
+    for (const D3D12_SUBRESOURCE_DATA& subresource : subresources) {
+        const std::size_t rowPitch = static_cast<std::size_t>(subresource.RowPitch);
+        const std::size_t alignedRowPitch =
+            (rowPitch + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1U) & ~static_cast<std::size_t>(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1U);
+        const std::size_t rowCount = static_cast<std::size_t>(subresource.SlicePitch) / rowPitch;
+        scratchBuffer.resize(std::max(scratchBuffer.size(), alignedRowPitch * rowCount));
+
+        const std::uint8_t* sourceData = static_cast<const std::uint8_t*>(subresource.pData);
+        for (std::size_t i = 0U; i < rowCount; ++i) {
+            std::memcpy(scratchBuffer.data() + i * alignedRowPitch, sourceData + i * rowPitch, rowPitch);
+        }
+    }
+}
+}
+
+TEST_CASE("LoadDDSTextureDataFromMemory12")
+{
+    std::vector<std::uint8_t> ddsData;
+    CreateRGBA8DDSData(4U, 3U, ddsData);
+
+    D3D12_RESOURCE_DESC textureDescriptor{};
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+
+    SECTION("Subresources point into DDS data")
+    {
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(ddsData.data(),
+                                                                  ddsData.size(),
+                                                                  textureDescriptor,
+                                                                  subresources)));
+        REQUIRE(textureDescriptor.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE2D);
+        REQUIRE(textureDescriptor.Width == 4U);
+        REQUIRE(textureDescriptor.Height == 4U);
+        REQUIRE(textureDescriptor.MipLevels == 3U);
+        REQUIRE(textureDescriptor.DepthOrArraySize == 1U);
+        REQUIRE(textureDescriptor.Format == DXGI_FORMAT_R8G8B8A8_UNORM);
+        REQUIRE(subresources.size() == 3U);
+
+        const std::uint8_t* bitData = ddsData.data() + 128U;
+        REQUIRE(subresources[0U].pData == bitData);
+        REQUIRE(subresources[0U].RowPitch == 16);
+        REQUIRE(subresources[0U].SlicePitch == 64);
+        REQUIRE(subresources[1U].pData == bitData + 64U);
+        REQUIRE(subresources[1U].RowPitch == 8);
+        REQUIRE(subresources[1U].SlicePitch == 16);
+        REQUIRE(subresources[2U].pData == bitData + 80U);
+        REQUIRE(subresources[2U].RowPitch == 4);
+        REQUIRE(subresources[2U].SlicePitch == 4);
+    }
+
+    SECTION("Invalid magic number")
+    {
+        ddsData[0U] = 'X';
+        REQUIRE(FAILED(DirectX::LoadDDSTextureDataFromMemory12(ddsData.data(),
+                                                               ddsData.size(),
+                                                               textureDescriptor,
+                                                               subresources)));
+        REQUIRE(subresources.empty());
+    }
+
+    SECTION("Truncated data")
+    {
+        REQUIRE(FAILED(DirectX::LoadDDSTextureDataFromMemory12(ddsData.data(),
+                                                               100U,
+                                                               textureDescriptor,
+                                                               subresources)));
+        REQUIRE(FAILED(DirectX::LoadDDSTextureDataFromMemory12(ddsData.data(),
+                                                               ddsData.size() - 1U,
+                                                               textureDescriptor,
+                                                               subresources)));
+        REQUIRE(subresources.empty());
+    }
+}
+
+// Compares reading the bundled textures to a heap buffer against mapping them,
+// including the copy to upload memory. GPU upload is the same for both paths, so it is not measured.
+// It must be run explicitly, from the Executable directory: UnitTests.exe [benchmark]
+TEST_CASE("DDS texture load times", "[.][benchmark]")
+{
+    const char* textureFilenames[]{
+        "resources/textures/brick/brick3.dds",
+        "resources/textures/cubeMaps/factory_diffuse_cube_map.dds",
+        "resources/textures/cubeMaps/milkmill_diffuse_cube_map.dds",
+        "resources/textures/metalness0.dds",
+        "resources/textures/roughness0.5.dds",
+    };
+
+    std::vector<std::uint8_t> scratchBuffer;
+    for (const char* textureFilename : textureFilenames) {
+        D3D12_RESOURCE_DESC textureDescriptor{};
+        std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+
+        // Warm up the file cache, so both paths read the file from memory
+        std::unique_ptr<std::uint8_t[]> ddsData;
+        const std::wstring textureFilenameW = BRE::StringUtils::AnsiToWideString(textureFilename);
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromFile12(textureFilenameW.c_str(),
+                                                                ddsData,
+                                                                textureDescriptor,
+                                                                subresources)));
+        ddsData.reset();
+
+        // Heap path: read the whole file to a heap buffer, then copy it to upload memory
+        const auto heapStartTime = std::chrono::high_resolution_clock::now();
+
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromFile12(textureFilenameW.c_str(),
+                                                                ddsData,
+                                                                textureDescriptor,
+                                                                subresources)));
+        CopySubresources(subresources, scratchBuffer);
+        ddsData.reset();
+
+        const auto heapEndTime = std::chrono::high_resolution_clock::now();
+
+        // Mapped path: parse the mapping in place, and copy it to upload memory
+        const auto mappedStartTime = std::chrono::high_resolution_clock::now();
+
+        MemoryMappedFile textureFile;
+        REQUIRE(textureFile.Open(textureFilename));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(textureFile.GetData(),
+                                                                  textureFile.GetSize(),
+                                                                  textureDescriptor,
+                                                                  subresources)));
+        CopySubresources(subresources, scratchBuffer);
+        const std::size_t fileSize = textureFile.GetSize();
+        textureFile.Close();
+
+        const auto mappedEndTime = std::chrono::high_resolution_clock::now();
+
+        const double heapTimeInMs = std::chrono::duration<double, std::milli>(heapEndTime - heapStartTime).count();
+        const double mappedTimeInMs = std::chrono::duration<double, std::milli>(mappedEndTime - mappedStartTime).count();
+        WARN(textureFilename << ": heap " << heapTimeInMs << " ms (" << fileSize << " bytes allocated), mapped " <<
+             mappedTimeInMs << " ms (0 bytes allocated)");
+    }
+}
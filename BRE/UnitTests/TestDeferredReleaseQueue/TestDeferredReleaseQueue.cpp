@@ -0,0 +1,328 @@
+#include <UnitTests\Catch.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <tbb/parallel_for.h>
+#include <vector>
+
+#include <ResourceManager\DeferredReleaseQueue.h>
+#include <Utils\SlotMap.h>
+
+using BRE::DeferredReleaseQueue;
+using BRE::SlotMap;
+
+namespace {
+const std::uint32_t sQueuedFrameCount{ 3U };
+
+///
+/// @brief Fence of a command queue whose GPU finishes frames later than the CPU submits them
+///
+/// Like RenderManager, the CPU signals a fence value after each frame, and it waits
+/// only if it is sQueuedFrameCount frames ahead of the GPU.
+///
+class MockFence {
+public:
+    ///
+    /// @brief Signals the fence after the current frame, and begins the next frame
+    ///
+    /// The GPU finishes a random number of frames. It finishes enough
+    /// frames so the CPU is not more than sQueuedFrameCount frames ahead.
+    ///
+    /// @param queue Deferred release queue to update, like the master render task.
+    ///
+    void SignalAndBeginNextFrame(DeferredReleaseQueue& queue) noexcept
+    {
+        ++mSignaledValue;
+        std::uniform_int_distribution<std::uint64_t> distribution(0UL, mSignaledValue - mCompletedValue);
+        mCompletedValue += distribution(mRandomGenerator);
+        if (mSignaledValue - mCompletedValue >= sQueuedFrameCount) {
+            mCompletedValue = mSignaledValue - sQueuedFrameCount + 1UL;
+        }
+
+        queue.SetFrameFenceValue(mSignaledValue + 1UL);
+        queue.ReleaseCompleted(mCompletedValue);
+    }
+
+    ///
+    /// @brief Waits until the GPU finishes all the frames
+    /// @param queue Deferred release queue to update, like the master render task.
+    ///
+    void Flush(DeferredReleaseQueue& queue) noexcept
+    {
+        ++mSignaledValue;
+        mCompletedValue = mSignaledValue;
+
+        queue.SetFrameFenceValue(mSignaledValue + 1UL);
+        queue.ReleaseCompleted(mCompletedValue);
+    }
+
+    std::uint64_t GetFrameFenceValue() const noexcept
+    {
+        return mSignaledValue + 1UL;
+    }
+
+    std::uint64_t GetCompletedValue() const noexcept
+    {
+        return mCompletedValue;
+    }
+
+private:
+    std::uint64_t mSignaledValue{ 0UL };
+    std::uint64_t mCompletedValue{ 0UL };
+    std::mt19937 mRandomGenerator{ 7U };
+};
+
+///
+/// @brief Resource of a mocked resource manager
+///
+struct MockResource {
+    // Fence value of the last frame that used the resource
+    std::uint64_t mLastUsedFenceValue{ 0UL };
+};
+
+using MockResourceHandle = SlotMap<MockResource>::Handle;
+
+///
+/// @brief Counts the releases of mocked resources, and the ones that were wrong.
+///
+struct ReleaseCounters {
+    std::atomic<std::uint32_t> mReleaseCount{ 0U };
+    // Released while the GPU could use them
+    std::atomic<std::uint32_t> mEarlyReleaseCount{ 0U };
+    // Released twice, or never created
+    std::atomic<std::uint32_t> mStaleReleaseCount{ 0U };
+};
+
+///
+/// @brief Creates a mocked resource and a reference counted handle of it
+/// @param resources Mocked resource manager
+/// @param fence Fence
+/// @param counters Release counters
+/// @param queue Deferred release queue
+/// @return Reference counted handle
+///
+std::shared_ptr<MockResourceHandle>
+CreateSharedResource(SlotMap<MockResource>& resources,
+                     const MockFence& fence,
+                     ReleaseCounters& counters,
+                     DeferredReleaseQueue& queue) noexcept
+{
+    // Handles are released by the release function, like the objects of the managers
+    MockResourceHandle* handle = new MockResourceHandle(resources.Insert(MockResource()));
+
+    return queue.MakeShared(*handle,
+                            [handle, &resources, &fence, &counters]() {
+        MockResource resource;
+        if (resources.Erase(*handle, &resource) == false) {
+            ++counters.mStaleReleaseCount;
+        } else if (resource.mLastUsedFenceValue > fence.GetCompletedValue()) {
+            ++counters.mEarlyReleaseCount;
+        }
+        ++counters.mReleaseCount;
+        delete handle;
+    });
+}
+}
+
+TEST_CASE("DeferredReleaseQueue")
+{
+    SECTION("Releases run once their fence value is completed")
+    {
+        DeferredReleaseQueue queue;
+        std::vector<std::uint32_t> releasedIds;
+        queue.Enqueue(2UL, [&releasedIds]() { releasedIds.push_back(0U); });
+        queue.Enqueue(2UL, [&releasedIds]() { releasedIds.push_back(1U); });
+        queue.Enqueue(4UL, [&releasedIds]() { releasedIds.push_back(2U); });
+        REQUIRE(queue.GetSize() == 3U);
+
+        REQUIRE(queue.ReleaseCompleted(1UL) == 0U);
+        REQUIRE(releasedIds.empty());
+
+        REQUIRE(queue.ReleaseCompleted(3UL) == 2U);
+        REQUIRE((releasedIds == std::vector<std::uint32_t>{ 0U, 1U }));
+        REQUIRE(queue.GetSize() == 1U);
+
+        REQUIRE(queue.ReleaseCompleted(4UL) == 1U);
+        REQUIRE((releasedIds == std::vector<std::uint32_t>{ 0U, 1U, 2U }));
+        REQUIRE(queue.GetSize() == 0U);
+    }
+
+    SECTION("Releases are keyed by the frame fence value by default")
+    {
+        DeferredReleaseQueue queue;
+        REQUIRE(queue.GetFrameFenceValue() == 1UL);
+
+        std::uint32_t releaseCount = 0U;
+        queue.Enqueue([&releaseCount]() { ++releaseCount; });
+        REQUIRE(queue.ReleaseCompleted(0UL) == 0U);
+
+        queue.SetFrameFenceValue(5UL);
+        queue.Enqueue([&releaseCount]() { ++releaseCount; });
+        REQUIRE(queue.ReleaseCompleted(4UL) == 1U);
+        REQUIRE(releaseCount == 1U);
+        REQUIRE(queue.ReleaseCompleted(5UL) == 1U);
+        REQUIRE(releaseCount == 2U);
+    }
+
+    SECTION("Releases are never run earlier than previous releases")
+    {
+        DeferredReleaseQueue queue;
+        std::uint32_t releaseCount = 0U;
+        queue.Enqueue(6UL, [&releaseCount]() { ++releaseCount; });
+        queue.Enqueue(2UL, [&releaseCount]() { ++releaseCount; });
+
+        REQUIRE(queue.ReleaseCompleted(5UL) == 0U);
+        REQUIRE(queue.ReleaseCompleted(6UL) == 2U);
+        REQUIRE(releaseCount == 2U);
+    }
+
+    SECTION("Release functions can enqueue other releases")
+    {
+        DeferredReleaseQueue queue;
+        std::uint32_t releaseCount = 0U;
+        queue.Enqueue(1UL, [&queue, &releaseCount]() {
+            ++releaseCount;
+            queue.Enqueue(1UL, [&queue, &releaseCount]() {
+                ++releaseCount;
+                queue.Enqueue(1UL, [&releaseCount]() { ++releaseCount; });
+            });
+        });
+
+        REQUIRE(queue.ReleaseCompleted(1UL) == 1U);
+        REQUIRE(queue.GetSize() == 1U);
+        REQUIRE(queue.ReleaseAll() == 2U);
+        REQUIRE(releaseCount == 3U);
+        REQUIRE(queue.GetSize() == 0U);
+    }
+
+    SECTION("Shared handles enqueue their release when their last copy is destroyed")
+    {
+        DeferredReleaseQueue queue;
+        queue.SetFrameFenceValue(3UL);
+
+        std::uint32_t object = 42U;
+        std::uint32_t releaseCount = 0U;
+        std::shared_ptr<std::uint32_t> handle = queue.MakeShared(object, [&releaseCount]() { ++releaseCount; });
+        std::shared_ptr<std::uint32_t> handleCopy = handle;
+        REQUIRE(*handleCopy == 42U);
+
+        handle.reset();
+        REQUIRE(queue.GetSize() == 0U);
+
+        // The copy is destroyed while the frame with fence value 4 is recorded
+        queue.SetFrameFenceValue(4UL);
+        handleCopy.reset();
+        REQUIRE(queue.GetSize() == 1U);
+        REQUIRE(queue.ReleaseCompleted(3UL) == 0U);
+        REQUIRE(queue.ReleaseCompleted(4UL) == 1U);
+        REQUIRE(releaseCount == 1U);
+    }
+
+    SECTION("Thousands of churned resources are released exactly when the mocked GPU finished them")
+    {
+        const std::uint32_t frameCount = 2000U;
+        const std::uint32_t maxCreatedResourceCountPerFrame = 16U;
+        const std::uint32_t maxLiveResourceCount = 500U;
+
+        DeferredReleaseQueue queue;
+        SlotMap<MockResource> resources;
+        MockFence fence;
+        ReleaseCounters counters;
+        std::uint32_t createdResourceCount = 0U;
+        std::uint32_t delayedReleaseCount = 0U;
+
+        std::mt19937 randomGenerator(11U);
+        std::vector<std::shared_ptr<MockResourceHandle>> liveResources;
+        for (std::uint32_t frame = 0U; frame < frameCount; ++frame) {
+            // Loading
+            const std::uint32_t createdCount = randomGenerator() % (maxCreatedResourceCountPerFrame + 1U);
+            for (std::uint32_t i = 0U; i < createdCount && liveResources.size() < maxLiveResourceCount; ++i) {
+                liveResources.push_back(CreateSharedResource(resources, fence, counters, queue));
+                ++createdResourceCount;
+            }
+
+            // Recording
+            for (const std::shared_ptr<MockResourceHandle>& liveResource : liveResources) {
+                if (randomGenerator() % 2U == 0U) {
+                    resources.Get(*liveResource)->mLastUsedFenceValue = fence.GetFrameFenceValue();
+                }
+            }
+
+            // Unloading, including resources used by this frame
+            for (std::uint32_t i = 0U; i < liveResources.size();) {
+                if (randomGenerator() % 8U == 0U) {
+                    liveResources[i] = liveResources.back();
+                    liveResources.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+
+            fence.SignalAndBeginNextFrame(queue);
+
+            // Releases are not delayed after their fence value is completed
+            for (const std::shared_ptr<MockResourceHandle>& liveResource : liveResources) {
+                REQUIRE(resources.Get(*liveResource) != nullptr);
+            }
+            if (queue.ReleaseCompleted(fence.GetCompletedValue()) > 0U) {
+                ++delayedReleaseCount;
+            }
+        }
+
+        REQUIRE(createdResourceCount > 5000U);
+        REQUIRE(counters.mEarlyReleaseCount.load() == 0U);
+        REQUIRE(counters.mStaleReleaseCount.load() == 0U);
+        REQUIRE(delayedReleaseCount == 0U);
+        REQUIRE(counters.mReleaseCount.load() + liveResources.size() + queue.GetSize() == createdResourceCount);
+
+        liveResources.clear();
+        fence.Flush(queue);
+        REQUIRE(queue.GetSize() == 0U);
+        REQUIRE(counters.mReleaseCount.load() == createdResourceCount);
+        REQUIRE(resources.GetSize() == 0U);
+        REQUIRE(counters.mEarlyReleaseCount.load() == 0U);
+    }
+
+    SECTION("Handles destroyed from several threads while frames are rendered are released once")
+    {
+        const std::uint32_t frameCount = 200U;
+        const std::uint32_t resourceCountPerFrame = 100U;
+
+        DeferredReleaseQueue queue;
+        SlotMap<MockResource> resources;
+        MockFence fence;
+        ReleaseCounters counters;
+
+        for (std::uint32_t frame = 0U; frame < frameCount; ++frame) {
+            std::vector<std::shared_ptr<MockResourceHandle>> frameResources;
+            for (std::uint32_t i = 0U; i < resourceCountPerFrame; ++i) {
+                frameResources.push_back(CreateSharedResource(resources, fence, counters, queue));
+                resources.Get(*frameResources.back())->mLastUsedFenceValue = fence.GetFrameFenceValue();
+            }
+
+            // Worker threads drop the references of the frame, each from several copies
+            std::vector<std::shared_ptr<MockResourceHandle>> frameResourceCopies(frameResources);
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, resourceCountPerFrame * 2U, 8U),
+                              [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i != r.end(); ++i) {
+                    if (i < resourceCountPerFrame) {
+                        frameResources[i].reset();
+                    } else {
+                        frameResourceCopies[i - resourceCountPerFrame].reset();
+                    }
+                }
+            }
+            );
+
+            fence.SignalAndBeginNextFrame(queue);
+        }
+
+        fence.Flush(queue);
+        REQUIRE(counters.mReleaseCount.load() == frameCount * resourceCountPerFrame);
+        REQUIRE(counters.mEarlyReleaseCount.load() == 0U);
+        REQUIRE(counters.mStaleReleaseCount.load() == 0U);
+        REQUIRE(resources.GetSize() == 0U);
+    }
+}
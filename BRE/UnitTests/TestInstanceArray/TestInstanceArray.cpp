@@ -0,0 +1,214 @@
+#include <UnitTests\Catch.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <SceneLoader\CompiledScene.h>
+#include <SceneLoader\InstanceArray.h>
+
+using BRE::CompiledScene;
+using BRE::InstanceArray;
+using DirectX::XMFLOAT3;
+using DirectX::XMFLOAT4X4;
+
+namespace {
+///
+/// @brief Checks if two floats are almost equal
+/// @param a First float
+/// @param b Second float
+/// @return True if they are almost equal. Otherwise, false.
+///
+bool
+AreAlmostEqual(const float a,
+               const float b)
+{
+    return std::abs(a - b) < 1.0e-4f;
+}
+}
+
+TEST_CASE("Instance array")
+{
+    CompiledScene::InstanceArray compiledInstanceArray;
+    compiledInstanceArray.mTranslation[0U] = 100.0f;
+    compiledInstanceArray.mTranslation[1U] = 200.0f;
+    compiledInstanceArray.mTranslation[2U] = 300.0f;
+
+    SECTION("Grid instances fill every grid cell")
+    {
+        compiledInstanceArray.mPlacement = CompiledScene::GRID;
+        compiledInstanceArray.mCounts[0U] = 4U;
+        compiledInstanceArray.mCounts[1U] = 2U;
+        compiledInstanceArray.mCounts[2U] = 3U;
+        compiledInstanceArray.mSpacing[0U] = 1.0f;
+        compiledInstanceArray.mSpacing[1U] = 2.0f;
+        compiledInstanceArray.mSpacing[2U] = 3.0f;
+        const InstanceArray instanceArray(compiledInstanceArray, nullptr);
+        REQUIRE(instanceArray.GetInstanceCount() == 24U);
+
+        std::vector<bool> isCellUsed(24U, false);
+        XMFLOAT3 position;
+        for (std::uint32_t i = 0U; i < instanceArray.GetInstanceCount(); ++i) {
+            instanceArray.ComputePosition(i, position);
+            const std::uint32_t x = static_cast<std::uint32_t>(position.x - 100.0f);
+            const std::uint32_t y = static_cast<std::uint32_t>((position.y - 200.0f) / 2.0f);
+            const std::uint32_t z = static_cast<std::uint32_t>((position.z - 300.0f) / 3.0f);
+            REQUIRE(position.x == 100.0f + x);
+            REQUIRE(position.y == 200.0f + y * 2.0f);
+            REQUIRE(position.z == 300.0f + z * 3.0f);
+            REQUIRE(x < 4U);
+            REQUIRE(y < 2U);
+            REQUIRE(z < 3U);
+
+            const std::uint32_t cell = (y * 3U + z) * 4U + x;
+            REQUIRE(isCellUsed[cell] == false);
+            isCellUsed[cell] = true;
+        }
+    }
+
+    SECTION("Random instances are inside the volume and depend on the seed")
+    {
+        compiledInstanceArray.mPlacement = CompiledScene::RANDOM;
+        compiledInstanceArray.mCounts[0U] = 10000U;
+        compiledInstanceArray.mSeed = 7U;
+        compiledInstanceArray.mVolumeMin[0U] = -10.0f;
+        compiledInstanceArray.mVolumeMin[1U] = 0.0f;
+        compiledInstanceArray.mVolumeMin[2U] = 5.0f;
+        compiledInstanceArray.mVolumeMax[0U] = 10.0f;
+        compiledInstanceArray.mVolumeMax[1U] = 0.0f;
+        compiledInstanceArray.mVolumeMax[2U] = 6.0f;
+        const InstanceArray instanceArray(compiledInstanceArray, nullptr);
+        const InstanceArray sameInstanceArray(compiledInstanceArray, nullptr);
+        compiledInstanceArray.mSeed = 8U;
+        const InstanceArray otherInstanceArray(compiledInstanceArray, nullptr);
+        REQUIRE(instanceArray.GetInstanceCount() == 10000U);
+
+        XMFLOAT3 position;
+        XMFLOAT3 samePosition;
+        XMFLOAT3 otherPosition;
+        std::uint32_t negativeXCount = 0U;
+        std::uint32_t differentCount = 0U;
+        for (std::uint32_t i = 0U; i < instanceArray.GetInstanceCount(); ++i) {
+            instanceArray.ComputePosition(i, position);
+            REQUIRE(position.x >= 90.0f);
+            REQUIRE(position.x < 110.0f);
+            REQUIRE(position.y == 200.0f);
+            REQUIRE(position.z >= 305.0f);
+            REQUIRE(position.z <= 306.0f);
+            negativeXCount += position.x < 100.0f ? 1U : 0U;
+
+            sameInstanceArray.ComputePosition(i, samePosition);
+            REQUIRE(std::memcmp(&position, &samePosition, sizeof(XMFLOAT3)) == 0);
+
+            otherInstanceArray.ComputePosition(i, otherPosition);
+            differentCount += position.x != otherPosition.x ? 1U : 0U;
+        }
+
+        // Instances are spread over the volume
+        REQUIRE(negativeXCount > 4500U);
+        REQUIRE(negativeXCount < 5500U);
+        REQUIRE(differentCount > 9900U);
+    }
+
+    SECTION("Path instances are evenly spaced along the path")
+    {
+        const XMFLOAT3 pathPoints[]{
+            XMFLOAT3(0.0f, 0.0f, 0.0f), // Not in the path
+            XMFLOAT3(0.0f, 0.0f, 0.0f),
+            XMFLOAT3(3.0f, 0.0f, 0.0f),
+            XMFLOAT3(3.0f, 0.0f, 0.0f), // Segment without length
+            XMFLOAT3(3.0f, 0.0f, 6.0f),
+        };
+        compiledInstanceArray.mPlacement = CompiledScene::PATH;
+        compiledInstanceArray.mCounts[0U] = 10U;
+        compiledInstanceArray.mFirstPathPoint = 1U;
+        compiledInstanceArray.mPathPointCount = 4U;
+        const InstanceArray instanceArray(compiledInstanceArray, pathPoints);
+        REQUIRE(instanceArray.GetInstanceCount() == 10U);
+
+        // Path length is 9, so instances are separated by 1
+        XMFLOAT3 position;
+        for (std::uint32_t i = 0U; i < instanceArray.GetInstanceCount(); ++i) {
+            instanceArray.ComputePosition(i, position);
+            REQUIRE(AreAlmostEqual(position.x, 100.0f + (i < 3U ? static_cast<float>(i) : 3.0f)));
+            REQUIRE(position.y == 200.0f);
+            REQUIRE(AreAlmostEqual(position.z, 300.0f + (i < 3U ? 0.0f : static_cast<float>(i - 3U))));
+        }
+
+        // A single instance is at the beginning of the path
+        compiledInstanceArray.mCounts[0U] = 1U;
+        const InstanceArray singleInstanceArray(compiledInstanceArray, pathPoints);
+        singleInstanceArray.ComputePosition(0U, position);
+        REQUIRE(position.x == 100.0f);
+        REQUIRE(position.z == 300.0f);
+    }
+
+    SECTION("Material technique choices are uniform")
+    {
+        compiledInstanceArray.mPlacement = CompiledScene::RANDOM;
+        compiledInstanceArray.mCounts[0U] = 30000U;
+        const InstanceArray defaultInstanceArray(compiledInstanceArray, nullptr);
+        REQUIRE(defaultInstanceArray.GetMaterialTechniqueChoice(0U) == 0U);
+
+        compiledInstanceArray.mMaterialTechniqueCount = 3U;
+        const InstanceArray instanceArray(compiledInstanceArray, nullptr);
+        std::uint32_t choiceCounts[3U]{ 0U, 0U, 0U };
+        for (std::uint32_t i = 0U; i < instanceArray.GetInstanceCount(); ++i) {
+            const std::uint32_t choice = instanceArray.GetMaterialTechniqueChoice(i);
+            REQUIRE(choice < 3U);
+            ++choiceCounts[choice];
+        }
+
+        for (const std::uint32_t choiceCount : choiceCounts) {
+            REQUIRE(choiceCount > 9500U);
+            REQUIRE(choiceCount < 10500U);
+        }
+    }
+
+    SECTION("Rotations and scales are inside their ranges")
+    {
+        compiledInstanceArray.mPlacement = CompiledScene::GRID;
+        compiledInstanceArray.mCounts[0U] = 1000U;
+        compiledInstanceArray.mRotation[1U] = 1.0f;
+        compiledInstanceArray.mRotationRange[1U] = 2.0f;
+        compiledInstanceArray.mScale[0U] = 2.0f;
+        compiledInstanceArray.mScaleRange[0U] = 0.5f;
+        compiledInstanceArray.mScaleRange[1U] = 1.5f;
+        const InstanceArray instanceArray(compiledInstanceArray, nullptr);
+
+        XMFLOAT3 position;
+        XMFLOAT4X4 worldMatrix;
+        float minScale = 10.0f;
+        float maxScale = 0.0f;
+        for (std::uint32_t i = 0U; i < instanceArray.GetInstanceCount(); ++i) {
+            instanceArray.ComputePosition(i, position);
+            instanceArray.ComputeWorldMatrix(i, worldMatrix);
+            REQUIRE(worldMatrix._41 == position.x);
+            REQUIRE(worldMatrix._42 == position.y);
+            REQUIRE(worldMatrix._43 == position.z);
+
+            // Rotation is only around Y axis, so Y axis is not rotated, and X axis
+            // is scaled twice than Y axis.
+            const float scaleY = std::sqrt(worldMatrix._21 * worldMatrix._21 +
+                                           worldMatrix._22 * worldMatrix._22 +
+                                           worldMatrix._23 * worldMatrix._23);
+            const float scaleX = std::sqrt(worldMatrix._11 * worldMatrix._11 +
+                                           worldMatrix._12 * worldMatrix._12 +
+                                           worldMatrix._13 * worldMatrix._13);
+            REQUIRE(AreAlmostEqual(worldMatrix._22, scaleY));
+            REQUIRE(AreAlmostEqual(scaleX, 2.0f * scaleY));
+            REQUIRE(scaleY >= 0.5f - 1.0e-4f);
+            REQUIRE(scaleY <= 1.5f + 1.0e-4f);
+            minScale = scaleY < minScale ? scaleY : minScale;
+            maxScale = scaleY > maxScale ? scaleY : maxScale;
+
+            // Rotation angle around Y axis is between 1 and 3 radians
+            const float angle = std::atan2(-worldMatrix._13, worldMatrix._11);
+            REQUIRE(angle >= 1.0f - 1.0e-3f);
+            REQUIRE(angle <= 3.0f + 1.0e-3f);
+        }
+
+        REQUIRE(minScale < 0.6f);
+        REQUIRE(maxScale > 1.4f);
+    }
+}
\ No newline at end of file
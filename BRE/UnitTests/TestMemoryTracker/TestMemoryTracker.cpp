@@ -0,0 +1,87 @@
+#include <UnitTests\Catch.h>
+
+#include <MemoryTracker\MemoryTracker.h>
+
+using BRE::MemoryTracker;
+
+TEST_CASE("MemoryTracker")
+{
+    MemoryTracker::Reset();
+
+    SECTION("RegisterAllocation")
+    {
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::TEXTURES, 100UL);
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::TEXTURES, 50UL);
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::SHADER_BLOBS, 10UL);
+
+        const MemoryTracker::CategoryStats stats = MemoryTracker::GetCategoryStats(MemoryTracker::Category::TEXTURES);
+        REQUIRE(stats.mCurrentSizeInBytes == 150UL);
+        REQUIRE(stats.mPeakSizeInBytes == 150UL);
+        REQUIRE(stats.mAllocationCount == 2U);
+        REQUIRE(MemoryTracker::GetTotalSizeInBytes() == 160UL);
+        REQUIRE(MemoryTracker::GetCategoryStats(MemoryTracker::Category::RENDER_TARGETS).mCurrentSizeInBytes == 0UL);
+    }
+
+    SECTION("RegisterDeallocation")
+    {
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::UPLOAD_HEAPS, 100UL);
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::UPLOAD_HEAPS, 200UL);
+        MemoryTracker::RegisterDeallocation(MemoryTracker::Category::UPLOAD_HEAPS, 200UL);
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::UPLOAD_HEAPS, 50UL);
+
+        const MemoryTracker::CategoryStats stats = MemoryTracker::GetCategoryStats(MemoryTracker::Category::UPLOAD_HEAPS);
+        REQUIRE(stats.mCurrentSizeInBytes == 150UL);
+        REQUIRE(stats.mPeakSizeInBytes == 300UL);
+        REQUIRE(stats.mAllocationCount == 2U);
+        REQUIRE(MemoryTracker::GetTotalSizeInBytes() == 150UL);
+        REQUIRE(MemoryTracker::GetTotalPeakSizeInBytes() == 300UL);
+    }
+
+    SECTION("Budget")
+    {
+        MemoryTracker::SetBudget(MemoryTracker::Category::RENDER_TARGETS, 100UL);
+
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::RENDER_TARGETS, 100UL);
+        REQUIRE(MemoryTracker::IsOverBudget(MemoryTracker::Category::RENDER_TARGETS) == false);
+
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::RENDER_TARGETS, 1UL);
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::RENDER_TARGETS, 1UL);
+        REQUIRE(MemoryTracker::IsOverBudget(MemoryTracker::Category::RENDER_TARGETS));
+        REQUIRE(MemoryTracker::GetCategoryStats(MemoryTracker::Category::RENDER_TARGETS).mBudgetExceededCount == 1U);
+
+        MemoryTracker::RegisterDeallocation(MemoryTracker::Category::RENDER_TARGETS, 100UL);
+        REQUIRE(MemoryTracker::IsOverBudget(MemoryTracker::Category::RENDER_TARGETS) == false);
+
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::RENDER_TARGETS, 100UL);
+        REQUIRE(MemoryTracker::GetCategoryStats(MemoryTracker::Category::RENDER_TARGETS).mBudgetExceededCount == 2U);
+
+        // Categories without budget are never over budget
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::TEXTURES, 1000UL);
+        REQUIRE(MemoryTracker::IsOverBudget(MemoryTracker::Category::TEXTURES) == false);
+    }
+
+    SECTION("GetCategoryByName")
+    {
+        for (std::uint32_t i = 0U; i < static_cast<std::uint32_t>(MemoryTracker::Category::NUM_CATEGORIES); ++i) {
+            const MemoryTracker::Category category = static_cast<MemoryTracker::Category>(i);
+            MemoryTracker::Category foundCategory;
+            REQUIRE(MemoryTracker::GetCategoryByName(MemoryTracker::GetCategoryName(category), foundCategory));
+            REQUIRE(foundCategory == category);
+        }
+
+        MemoryTracker::Category foundCategory;
+        REQUIRE(MemoryTracker::GetCategoryByName("unknown", foundCategory) == false);
+    }
+
+    SECTION("GetJsonReport")
+    {
+        MemoryTracker::RegisterAllocation(MemoryTracker::Category::VERTEX_AND_INDEX_BUFFERS, 1234UL);
+
+        const std::string report = MemoryTracker::GetJsonReport("scenes\\scene.yml");
+        REQUIRE(report.find("\"name\": \"scenes\\\\scene.yml\"") != std::string::npos);
+        REQUIRE(report.find("\"name\": \"vertex and index buffers\",\n      \"bytes\": 1234,") != std::string::npos);
+        REQUIRE(report.find("\"total_bytes\": 1234,") != std::string::npos);
+    }
+
+    MemoryTracker::Reset();
+}
@@ -0,0 +1,233 @@
+#include <UnitTests\Catch.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <ModelManager\MeshCache.h>
+#include <ModelManager\MeshletBuilder.h>
+#include <ModelManager\ModelImporter.h>
+#include <ModelManager\VertexCompressor.h>
+#include <Utils\HashUtils.h>
+#include <Utils\MemoryMappedFile.h>
+
+using BRE::GeometryGenerator::MeshData;
+using BRE::GeometryGenerator::Vertex;
+using BRE::MemoryMappedFile;
+using BRE::MeshCache;
+using BRE::MeshletBuilder;
+using BRE::VertexCompressor;
+using DirectX::XMFLOAT2;
+using DirectX::XMFLOAT3;
+
+namespace {
+const char* sTestCacheFilePath{ "test_mesh_cache.bremesh" };
+const char* sLargeTestCacheFilePath{ "test_mesh_cache_large.bremesh" };
+
+///
+/// @brief Creates a mesh data with a single triangle
+/// @param offset Offset added to vertex positions
+/// @param meshData Output mesh data
+///
+void
+CreateTriangleMeshData(const float offset,
+                       MeshData& meshData)
+{
+    meshData.mVertices.push_back(Vertex(XMFLOAT3(offset, 0.0f, 0.0f),
+                                        XMFLOAT3(0.0f, 0.0f, -1.0f),
+                                        XMFLOAT3(1.0f, 0.0f, 0.0f),
+                                        XMFLOAT2(0.0f, 0.0f)));
+    meshData.mVertices.push_back(Vertex(XMFLOAT3(offset + 1.0f, 2.0f, 0.0f),
+                                        XMFLOAT3(0.0f, 0.0f, -1.0f),
+                                        XMFLOAT3(1.0f, 0.0f, 0.0f),
+                                        XMFLOAT2(1.0f, 0.0f)));
+    meshData.mVertices.push_back(Vertex(XMFLOAT3(offset, -1.0f, 3.0f),
+                                        XMFLOAT3(0.0f, 0.0f, -1.0f),
+                                        XMFLOAT3(1.0f, 0.0f, 0.0f),
+                                        XMFLOAT2(0.0f, 1.0f)));
+    meshData.mIndices32 = { 0U, 1U, 2U };
+}
+
+///
+/// @brief Copies mesh views data to a scratch buffer, like the upload to the staging ring does.
+/// @param meshViews Mesh views
+/// @param scratchBuffer Scratch buffer
+///
+void
+CopyMeshViews(const std::vector<MeshCache::MeshView>& meshViews,
+              std::vector<std::uint8_t>& scratchBuffer)
+{
+    for (const MeshCache::MeshView& meshView : meshViews) {
+        const std::size_t vertexDataSize = sizeof(VertexCompressor::CompressedVertex) * meshView.mVertexCount;
+        const std::size_t indexDataSize = meshView.mIndexSize * meshView.mIndexCount;
+        scratchBuffer.resize(vertexDataSize + indexDataSize);
+        std::memcpy(scratchBuffer.data(), meshView.mVertices, vertexDataSize);
+        std::memcpy(scratchBuffer.data() + vertexDataSize, meshView.mIndices, indexDataSize);
+    }
+}
+}
+
+TEST_CASE("MeshCache")
+{
+    std::vector<MeshData> meshDataList(2U);
+    CreateTriangleMeshData(0.0f, meshDataList[0U]);
+    CreateTriangleMeshData(10.0f, meshDataList[1U]);
+
+    const std::uint64_t sourceContentHash = 0x0123456789ABCDEFULL;
+    REQUIRE(MeshCache::WriteCacheFile(sTestCacheFilePath, sourceContentHash, meshDataList));
+
+    MemoryMappedFile cacheFile;
+    REQUIRE(cacheFile.Open(sTestCacheFilePath));
+
+    std::vector<MeshCache::MeshView> meshViews;
+
+    SECTION("Content hash")
+    {
+        const char dataA[] = "v 0.0 0.0 0.0";
+        const char dataB[] = "v 0.0 0.0 1.0";
+        REQUIRE(BRE::HashUtils::ComputeHash(dataA, sizeof(dataA)) ==
+                BRE::HashUtils::ComputeHash(dataA, sizeof(dataA)));
+        REQUIRE(BRE::HashUtils::ComputeHash(dataA, sizeof(dataA)) !=
+                BRE::HashUtils::ComputeHash(dataB, sizeof(dataB)));
+    }
+
+    SECTION("Read")
+    {
+        REQUIRE(MeshCache::ReadCacheFile(cacheFile.GetData(), cacheFile.GetSize(), sourceContentHash, meshViews));
+        REQUIRE(meshViews.size() == 2U);
+
+        for (std::uint32_t i = 0U; i < 2U; ++i) {
+            const MeshCache::MeshView& meshView = meshViews[i];
+            REQUIRE(meshView.mVertexCount == 3U);
+            REQUIRE(meshView.mIndexCount == 3U);
+            REQUIRE(meshView.mIndexSize == sizeof(std::uint16_t));
+            VertexCompressor::CompressedVertex compressedVertices[3U];
+            VertexCompressor::CompressVertices(meshDataList[i].mVertices.data(), 3U, compressedVertices);
+            REQUIRE(std::memcmp(meshView.mVertices, compressedVertices, sizeof(compressedVertices)) == 0);
+            const std::uint16_t* indices16 = static_cast<const std::uint16_t*>(meshView.mIndices);
+            REQUIRE(indices16[0U] == meshDataList[i].mIndices32[0U]);
+            REQUIRE(indices16[1U] == meshDataList[i].mIndices32[1U]);
+            REQUIRE(indices16[2U] == meshDataList[i].mIndices32[2U]);
+            REQUIRE(meshView.mMeshletCount == 1U);
+            REQUIRE(meshView.mMeshlets[0U].mFirstIndex == 0U);
+            REQUIRE(meshView.mMeshlets[0U].mIndexCount == 3U);
+
+            // Blobs are aligned
+            REQUIRE((reinterpret_cast<const std::uint8_t*>(meshView.mVertices) - cacheFile.GetData()) % MeshCache::sBlobAlignment == 0U);
+            REQUIRE((reinterpret_cast<const std::uint8_t*>(meshView.mIndices) - cacheFile.GetData()) % MeshCache::sBlobAlignment == 0U);
+            REQUIRE((reinterpret_cast<const std::uint8_t*>(meshView.mMeshlets) - cacheFile.GetData()) % MeshCache::sBlobAlignment == 0U);
+        }
+
+        REQUIRE(meshViews[1U].mBoundsMin.x == 10.0f);
+        REQUIRE(meshViews[1U].mBoundsMin.y == -1.0f);
+        REQUIRE(meshViews[1U].mBoundsMin.z == 0.0f);
+        REQUIRE(meshViews[1U].mBoundsMax.x == 11.0f);
+        REQUIRE(meshViews[1U].mBoundsMax.y == 2.0f);
+        REQUIRE(meshViews[1U].mBoundsMax.z == 3.0f);
+    }
+
+    SECTION("32 bits indices")
+    {
+        // 16 bits indices cannot address the last vertex
+        std::vector<MeshData> largeMeshDataList(1U);
+        for (std::uint32_t i = 0U; i < 65537U; ++i) {
+            largeMeshDataList[0U].mVertices.push_back(meshDataList[0U].mVertices[0U]);
+        }
+        largeMeshDataList[0U].mIndices32 = { 0U, 1U, 65536U };
+        REQUIRE(MeshCache::WriteCacheFile(sLargeTestCacheFilePath, sourceContentHash, largeMeshDataList));
+
+        MemoryMappedFile largeCacheFile;
+        REQUIRE(largeCacheFile.Open(sLargeTestCacheFilePath));
+        REQUIRE(MeshCache::ReadCacheFile(largeCacheFile.GetData(), largeCacheFile.GetSize(), sourceContentHash, meshViews));
+        REQUIRE(meshViews.size() == 1U);
+        REQUIRE(meshViews[0U].mIndexSize == sizeof(std::uint32_t));
+        REQUIRE(std::memcmp(meshViews[0U].mIndices, largeMeshDataList[0U].mIndices32.data(), sizeof(std::uint32_t) * 3U) == 0);
+
+        largeCacheFile.Close();
+        std::remove(sLargeTestCacheFilePath);
+    }
+
+    SECTION("Source content hash mismatch")
+    {
+        REQUIRE(MeshCache::ReadCacheFile(cacheFile.GetData(), cacheFile.GetSize(), sourceContentHash + 1UL, meshViews) == false);
+        REQUIRE(meshViews.empty());
+    }
+
+    SECTION("Truncated file")
+    {
+        REQUIRE(MeshCache::ReadCacheFile(cacheFile.GetData(), cacheFile.GetSize() - 1UL, sourceContentHash, meshViews) == false);
+        REQUIRE(MeshCache::ReadCacheFile(cacheFile.GetData(), sizeof(MeshCache::FileHeader) - 1UL, sourceContentHash, meshViews) == false);
+    }
+
+    SECTION("Version mismatch")
+    {
+        std::vector<std::uint8_t> fileData(cacheFile.GetData(), cacheFile.GetData() + cacheFile.GetSize());
+        reinterpret_cast<MeshCache::FileHeader*>(fileData.data())->mVersion = MeshCache::sVersion + 1U;
+        REQUIRE(MeshCache::ReadCacheFile(fileData.data(), fileData.size(), sourceContentHash, meshViews) == false);
+    }
+
+    SECTION("Meshlets out of the index range")
+    {
+        std::vector<std::uint8_t> fileData(cacheFile.GetData(), cacheFile.GetData() + cacheFile.GetSize());
+        const MeshCache::MeshHeader& meshHeader = *reinterpret_cast<const MeshCache::MeshHeader*>(fileData.data() + sizeof(MeshCache::FileHeader));
+        MeshletBuilder::Meshlet& meshlet = *reinterpret_cast<MeshletBuilder::Meshlet*>(fileData.data() + meshHeader.mMeshletDataOffset);
+        meshlet.mFirstIndex = 3U;
+        REQUIRE(MeshCache::ReadCacheFile(fileData.data(), fileData.size(), sourceContentHash, meshViews) == false);
+        REQUIRE(meshViews.empty());
+    }
+
+    cacheFile.Close();
+    std::remove(sTestCacheFilePath);
+}
+
+// Compares cold (import and cache file generation) and cached load times of the bundled models.
+// GPU upload is the same for both paths, so it is not measured.
+// It must be run explicitly, from the Executable directory: UnitTests.exe [benchmark]
+TEST_CASE("MeshCache load times", "[.][benchmark]")
+{
+    const char* modelFilenames[]{
+        "resources/models/floor.obj",
+        "resources/models/mitsubaFloor.obj",
+        "resources/models/torusKnot.obj",
+        "resources/models/unreal.obj",
+    };
+
+    std::vector<std::uint8_t> scratchBuffer;
+    for (const char* modelFilename : modelFilenames) {
+        // Cold load: hash the source model, import it and generate its cache file
+        const auto coldStartTime = std::chrono::high_resolution_clock::now();
+
+        MemoryMappedFile sourceFile;
+        REQUIRE(sourceFile.Open(modelFilename));
+        const std::uint64_t sourceContentHash = BRE::HashUtils::ComputeHash(sourceFile.GetData(),
+                                                                            sourceFile.GetSize());
+        sourceFile.Close();
+
+        std::vector<MeshData> meshDataList;
+        BRE::ModelImporter::ImportModel(modelFilename, meshDataList);
+        const std::string cacheFilePath = MeshCache::GetCacheFilePath(sourceContentHash);
+        REQUIRE(MeshCache::WriteCacheFile(cacheFilePath.c_str(), sourceContentHash, meshDataList));
+
+        const auto coldEndTime = std::chrono::high_resolution_clock::now();
+
+        // Cached load: hash the source model and map its cache file
+        const auto cachedStartTime = std::chrono::high_resolution_clock::now();
+
+        REQUIRE(sourceFile.Open(modelFilename));
+        REQUIRE(BRE::HashUtils::ComputeHash(sourceFile.GetData(), sourceFile.GetSize()) == sourceContentHash);
+        sourceFile.Close();
+
+        MemoryMappedFile cacheFile;
+        REQUIRE(cacheFile.Open(cacheFilePath.c_str()));
+        std::vector<MeshCache::MeshView> meshViews;
+        REQUIRE(MeshCache::ReadCacheFile(cacheFile.GetData(), cacheFile.GetSize(), sourceContentHash, meshViews));
+        CopyMeshViews(meshViews, scratchBuffer);
+
+        const auto cachedEndTime = std::chrono::high_resolution_clock::now();
+
+        const double coldTimeInMs = std::chrono::duration<double, std::milli>(coldEndTime - coldStartTime).count();
+        const double cachedTimeInMs = std::chrono::duration<double, std::milli>(cachedEndTime - cachedStartTime).count();
+        WARN(modelFilename << ": cold " << coldTimeInMs << " ms, cached " << cachedTimeInMs << " ms");
+    }
+}
@@ -0,0 +1,218 @@
+#include <UnitTests\Catch.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <ModelManager\MeshOptimizer.h>
+#include <ModelManager\ModelImporter.h>
+
+using BRE::GeometryGenerator::MeshData;
+using BRE::GeometryGenerator::Vertex;
+using BRE::MeshOptimizer;
+using DirectX::XMFLOAT2;
+using DirectX::XMFLOAT3;
+
+namespace {
+typedef std::array<float, 9U> Triangle;
+
+///
+/// @brief Creates a mesh data with a grid of quads in the XY plane, with triangles in random order.
+/// @param quadCount Number of quads per row and column
+/// @param meshData Output mesh data
+///
+void
+CreateShuffledGridMeshData(const std::uint32_t quadCount,
+                           MeshData& meshData)
+{
+    const std::uint32_t rowVertexCount = quadCount + 1U;
+    for (std::uint32_t y = 0U; y < rowVertexCount; ++y) {
+        for (std::uint32_t x = 0U; x < rowVertexCount; ++x) {
+            meshData.mVertices.push_back(Vertex(XMFLOAT3(static_cast<float>(x), static_cast<float>(y), 0.0f),
+                                                XMFLOAT3(0.0f, 0.0f, -1.0f),
+                                                XMFLOAT3(1.0f, 0.0f, 0.0f),
+                                                XMFLOAT2(static_cast<float>(x), static_cast<float>(y))));
+        }
+    }
+
+    std::vector<std::array<std::uint32_t, 3U>> triangles;
+    for (std::uint32_t y = 0U; y < quadCount; ++y) {
+        for (std::uint32_t x = 0U; x < quadCount; ++x) {
+            const std::uint32_t vertex = y * rowVertexCount + x;
+            triangles.push_back({ vertex, vertex + rowVertexCount, vertex + 1U });
+            triangles.push_back({ vertex + 1U, vertex + rowVertexCount, vertex + rowVertexCount + 1U });
+        }
+    }
+
+    std::mt19937 randomGenerator(1234U);
+    std::shuffle(triangles.begin(), triangles.end(), randomGenerator);
+    for (const std::array<std::uint32_t, 3U>& triangle : triangles) {
+        meshData.mIndices32.insert(meshData.mIndices32.end(), triangle.begin(), triangle.end());
+    }
+}
+
+///
+/// @brief Get the triangles of a mesh data by their vertex positions.
+///
+/// Triangles are rotated to start with their smallest vertex, so winding is kept,
+/// and they are sorted, so triangle order and vertex indices do not matter.
+///
+/// @param meshData Mesh data
+/// @return Triangles
+///
+std::vector<Triangle>
+GetTriangles(const MeshData& meshData)
+{
+    std::vector<Triangle> triangles;
+    for (std::size_t i = 0U; i < meshData.mIndices32.size(); i += 3U) {
+        std::array<std::array<float, 3U>, 3U> positions;
+        for (std::size_t j = 0U; j < 3U; ++j) {
+            const XMFLOAT3& position = meshData.mVertices[meshData.mIndices32[i + j]].mPosition;
+            positions[j] = { position.x, position.y, position.z };
+        }
+
+        std::rotate(positions.begin(), std::min_element(positions.begin(), positions.end()), positions.end());
+
+        Triangle triangle;
+        for (std::size_t j = 0U; j < 9U; ++j) {
+            triangle[j] = positions[j / 3U][j % 3U];
+        }
+        triangles.push_back(triangle);
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+
+    return triangles;
+}
+
+///
+/// @brief Computes the ACMR of a mesh data
+/// @param meshData Mesh data
+/// @return ACMR
+///
+float
+ComputeACMR(const MeshData& meshData)
+{
+    return MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32,
+                                             static_cast<std::uint32_t>(meshData.mVertices.size())).mACMR;
+}
+}
+
+TEST_CASE("Mesh optimizer")
+{
+    MeshData meshData;
+    CreateShuffledGridMeshData(32U, meshData);
+    const std::vector<Triangle> triangles = GetTriangles(meshData);
+    const float acmr = ComputeACMR(meshData);
+
+    SECTION("Vertex cache statistics")
+    {
+        const std::vector<std::uint32_t> indices{ 0U, 1U, 2U, 2U, 1U, 3U };
+        MeshOptimizer::Statistics statistics = MeshOptimizer::AnalyzeVertexCache(indices, 4U);
+        REQUIRE(statistics.mTransformedVertexCount == 4U);
+        REQUIRE(statistics.mACMR == 2.0f);
+        REQUIRE(statistics.mATVR == 1.0f);
+
+        // The first vertex is evicted from a cache of 3 vertices when the last vertex is inserted.
+        const std::vector<std::uint32_t> evictionIndices{ 0U, 1U, 2U, 1U, 2U, 3U, 3U, 2U, 0U };
+        statistics = MeshOptimizer::AnalyzeVertexCache(evictionIndices, 4U, 3U);
+        REQUIRE(statistics.mTransformedVertexCount == 5U);
+        REQUIRE(statistics.mATVR == 1.25f);
+    }
+
+    SECTION("Vertex cache optimization")
+    {
+        MeshOptimizer::OptimizeVertexCache(meshData.mIndices32, static_cast<std::uint32_t>(meshData.mVertices.size()));
+        REQUIRE(GetTriangles(meshData) == triangles);
+        REQUIRE(ComputeACMR(meshData) < 0.8f);
+        REQUIRE(ComputeACMR(meshData) < acmr);
+    }
+
+    SECTION("Overdraw optimization")
+    {
+        MeshOptimizer::OptimizeVertexCache(meshData.mIndices32, static_cast<std::uint32_t>(meshData.mVertices.size()));
+        const float vertexCacheOptimizedACMR = ComputeACMR(meshData);
+
+        MeshOptimizer::OptimizeOverdraw(meshData.mVertices, meshData.mIndices32, 1.05f);
+        REQUIRE(GetTriangles(meshData) == triangles);
+        REQUIRE(ComputeACMR(meshData) <= vertexCacheOptimizedACMR * 1.1f);
+
+        // A threshold of 1.0 only splits the mesh where the cache is restarted
+        MeshOptimizer::OptimizeVertexCache(meshData.mIndices32, static_cast<std::uint32_t>(meshData.mVertices.size()));
+        MeshOptimizer::OptimizeOverdraw(meshData.mVertices, meshData.mIndices32, 1.0f);
+        REQUIRE(GetTriangles(meshData) == triangles);
+    }
+
+    SECTION("Vertex fetch optimization")
+    {
+        // Add a vertex that no triangle uses
+        meshData.mVertices.push_back(meshData.mVertices[0U]);
+
+        MeshOptimizer::OptimizeVertexFetch(meshData);
+        REQUIRE(GetTriangles(meshData) == triangles);
+        REQUIRE(meshData.mVertices.size() == 33U * 33U);
+
+        // Vertices are in first use order
+        std::uint32_t nextVertex{ 0U };
+        for (const std::uint32_t index : meshData.mIndices32) {
+            REQUIRE(index <= nextVertex);
+            nextVertex = index == nextVertex ? nextVertex + 1U : nextVertex;
+        }
+    }
+
+    SECTION("Mesh optimization")
+    {
+        MeshOptimizer::OptimizeMesh(meshData);
+        REQUIRE(GetTriangles(meshData) == triangles);
+        REQUIRE(meshData.mVertices.size() == 33U * 33U);
+        REQUIRE(ComputeACMR(meshData) < acmr);
+    }
+
+    SECTION("Disjoint and degenerate triangles")
+    {
+        MeshData triangleSoupData;
+        for (const Vertex& vertex : meshData.mVertices) {
+            triangleSoupData.mVertices.push_back(vertex);
+        }
+        triangleSoupData.mIndices32 = { 5U, 6U, 7U, 100U, 100U, 101U, 7U, 6U, 40U, 200U, 201U, 234U };
+        const std::vector<Triangle> soupTriangles = GetTriangles(triangleSoupData);
+
+        MeshOptimizer::OptimizeMesh(triangleSoupData);
+        REQUIRE(GetTriangles(triangleSoupData) == soupTriangles);
+        REQUIRE(triangleSoupData.mVertices.size() == 9U);
+    }
+}
+
+// Reports vertex cache statistics of the bundled models, before and after optimization.
+// It must be run explicitly, from the Executable directory: UnitTests.exe [report]
+TEST_CASE("Mesh optimizer vertex cache report", "[.][report]")
+{
+    const char* modelFilenames[]{
+        "resources/models/floor.obj",
+        "resources/models/mitsubaFloor.obj",
+        "resources/models/torusKnot.obj",
+        "resources/models/unreal.obj",
+    };
+
+    for (const char* modelFilename : modelFilenames) {
+        std::vector<MeshData> meshDataList;
+        BRE::ModelImporter::ImportModel(modelFilename, meshDataList);
+        REQUIRE(meshDataList.empty() == false);
+
+        for (std::size_t i = 0U; i < meshDataList.size(); ++i) {
+            MeshData& meshData = meshDataList[i];
+            const std::vector<Triangle> triangles = GetTriangles(meshData);
+            const MeshOptimizer::Statistics statistics =
+                MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32, static_cast<std::uint32_t>(meshData.mVertices.size()));
+
+            MeshOptimizer::OptimizeMesh(meshData);
+            REQUIRE(GetTriangles(meshData) == triangles);
+            const MeshOptimizer::Statistics optimizedStatistics =
+                MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32, static_cast<std::uint32_t>(meshData.mVertices.size()));
+
+            WARN(modelFilename << " mesh " << i << ": ACMR " << statistics.mACMR << " -> " << optimizedStatistics.mACMR
+                 << ", ATVR " << statistics.mATVR << " -> " << optimizedStatistics.mATVR);
+        }
+    }
+}
\ No newline at end of file
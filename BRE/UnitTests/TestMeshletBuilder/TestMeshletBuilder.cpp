@@ -0,0 +1,300 @@
+#include <UnitTests\Catch.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <ModelManager\MeshletBuilder.h>
+#include <ModelManager\MeshOptimizer.h>
+#include <ModelManager\ModelImporter.h>
+
+using BRE::GeometryGenerator::MeshData;
+using BRE::GeometryGenerator::Vertex;
+using BRE::MeshletBuilder;
+using BRE::MeshOptimizer;
+using DirectX::XMFLOAT2;
+using DirectX::XMFLOAT3;
+
+namespace {
+///
+/// @brief Creates a mesh data with a grid of quads in the XY plane, with normals to -Z
+/// @param quadCount Number of quads per row and column
+/// @param meshData Output mesh data
+///
+void
+CreateGridMeshData(const std::uint32_t quadCount,
+                   MeshData& meshData)
+{
+    const std::uint32_t rowVertexCount = quadCount + 1U;
+    for (std::uint32_t y = 0U; y < rowVertexCount; ++y) {
+        for (std::uint32_t x = 0U; x < rowVertexCount; ++x) {
+            meshData.mVertices.push_back(Vertex(XMFLOAT3(static_cast<float>(x), static_cast<float>(y), 0.0f),
+                                                XMFLOAT3(0.0f, 0.0f, -1.0f),
+                                                XMFLOAT3(1.0f, 0.0f, 0.0f),
+                                                XMFLOAT2(static_cast<float>(x), static_cast<float>(y))));
+        }
+    }
+
+    for (std::uint32_t y = 0U; y < quadCount; ++y) {
+        for (std::uint32_t x = 0U; x < quadCount; ++x) {
+            const std::uint32_t vertex = y * rowVertexCount + x;
+            meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex, vertex + rowVertexCount, vertex + 1U });
+            meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex + 1U, vertex + rowVertexCount, vertex + rowVertexCount + 1U });
+        }
+    }
+}
+
+///
+/// @brief Creates a mesh data with a unit sphere, centered at the origin, with outward front faces
+/// @param sliceCount Number of slices
+/// @param stackCount Number of stacks
+/// @param meshData Output mesh data
+///
+void
+CreateSphereMeshData(const std::uint32_t sliceCount,
+                     const std::uint32_t stackCount,
+                     MeshData& meshData)
+{
+    const float pi = 3.14159265f;
+    for (std::uint32_t stack = 0U; stack <= stackCount; ++stack) {
+        const float phi = pi * stack / stackCount;
+        for (std::uint32_t slice = 0U; slice <= sliceCount; ++slice) {
+            const float theta = 2.0f * pi * slice / sliceCount;
+            const XMFLOAT3 position(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+            meshData.mVertices.push_back(Vertex(position,
+                                                position,
+                                                XMFLOAT3(-std::sin(theta), 0.0f, std::cos(theta)),
+                                                XMFLOAT2(static_cast<float>(slice) / sliceCount, static_cast<float>(stack) / stackCount)));
+        }
+    }
+
+    const std::uint32_t rowVertexCount = sliceCount + 1U;
+    for (std::uint32_t stack = 0U; stack < stackCount; ++stack) {
+        for (std::uint32_t slice = 0U; slice < sliceCount; ++slice) {
+            const std::uint32_t vertex = stack * rowVertexCount + slice;
+            meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex, vertex + 1U, vertex + rowVertexCount });
+            meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex + 1U, vertex + rowVertexCount + 1U, vertex + rowVertexCount });
+        }
+    }
+}
+
+///
+/// @brief Get the triangles of a mesh data, sorted, so triangle order does not matter
+/// @param meshData Mesh data
+/// @return Triangles
+///
+std::vector<std::array<std::uint32_t, 3U>>
+GetSortedTriangles(const MeshData& meshData)
+{
+    std::vector<std::array<std::uint32_t, 3U>> triangles;
+    for (std::size_t i = 0U; i < meshData.mIndices32.size(); i += 3U) {
+        triangles.push_back({ meshData.mIndices32[i], meshData.mIndices32[i + 1U], meshData.mIndices32[i + 2U] });
+    }
+    std::sort(triangles.begin(), triangles.end());
+
+    return triangles;
+}
+
+///
+/// @brief Computes a triangle normal with clockwise front faces
+/// @param meshData Mesh data
+/// @param firstIndex First index of the triangle
+/// @param normal Output unit normal
+/// @return True if the triangle is not degenerate. Otherwise, false.
+///
+bool
+ComputeTriangleNormal(const MeshData& meshData,
+                      const std::size_t firstIndex,
+                      XMFLOAT3& normal)
+{
+    const XMFLOAT3& p0 = meshData.mVertices[meshData.mIndices32[firstIndex]].mPosition;
+    const XMFLOAT3& p1 = meshData.mVertices[meshData.mIndices32[firstIndex + 1U]].mPosition;
+    const XMFLOAT3& p2 = meshData.mVertices[meshData.mIndices32[firstIndex + 2U]].mPosition;
+    const XMFLOAT3 edge1(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z);
+    const XMFLOAT3 edge2(p2.x - p0.x, p2.y - p0.y, p2.z - p0.z);
+    normal = XMFLOAT3(edge1.y * edge2.z - edge1.z * edge2.y,
+                      edge1.z * edge2.x - edge1.x * edge2.z,
+                      edge1.x * edge2.y - edge1.y * edge2.x);
+    const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+    if (length <= 0.0f) {
+        return false;
+    }
+
+    normal = XMFLOAT3(normal.x / length, normal.y / length, normal.z / length);
+
+    return true;
+}
+
+///
+/// @brief Checks meshlets of a mesh data: limits, index coverage, bounding spheres and normal cones
+/// @param meshData Mesh data
+/// @param meshlets Meshlets of the mesh data
+///
+void
+CheckMeshlets(const MeshData& meshData,
+              const std::vector<MeshletBuilder::Meshlet>& meshlets)
+{
+    std::uint32_t nextIndex{ 0U };
+    for (const MeshletBuilder::Meshlet& meshlet : meshlets) {
+        // Meshlets are contiguous and they cover all the indices
+        REQUIRE(meshlet.mFirstIndex == nextIndex);
+        REQUIRE(meshlet.mIndexCount > 0U);
+        REQUIRE(meshlet.mIndexCount % 3U == 0U);
+        REQUIRE(meshlet.mIndexCount / 3U <= static_cast<std::uint32_t>(MeshletBuilder::sMaxTriangleCount));
+        nextIndex += meshlet.mIndexCount;
+
+        std::vector<std::uint32_t> vertices(meshData.mIndices32.begin() + meshlet.mFirstIndex,
+                                            meshData.mIndices32.begin() + meshlet.mFirstIndex + meshlet.mIndexCount);
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        REQUIRE(vertices.size() <= static_cast<std::size_t>(MeshletBuilder::sMaxVertexCount));
+
+        // Bounding sphere contains the vertices
+        for (const std::uint32_t vertex : vertices) {
+            const XMFLOAT3& position = meshData.mVertices[vertex].mPosition;
+            const float x = position.x - meshlet.mCenter.x;
+            const float y = position.y - meshlet.mCenter.y;
+            const float z = position.z - meshlet.mCenter.z;
+            REQUIRE(std::sqrt(x * x + y * y + z * z) <= meshlet.mRadius * 1.0001f + 1.0e-6f);
+        }
+
+        // Normal cone contains the triangle normals
+        if (meshlet.mConeCutoff < 1.0f) {
+            const float minDot = std::sqrt(1.0f - meshlet.mConeCutoff * meshlet.mConeCutoff);
+            for (std::uint32_t i = meshlet.mFirstIndex; i < meshlet.mFirstIndex + meshlet.mIndexCount; i += 3U) {
+                XMFLOAT3 normal;
+                if (ComputeTriangleNormal(meshData, i, normal)) {
+                    const float dot = normal.x * meshlet.mConeAxis.x + normal.y * meshlet.mConeAxis.y + normal.z * meshlet.mConeAxis.z;
+                    REQUIRE(dot >= minDot - 1.0e-4f);
+                }
+            }
+        }
+    }
+
+    REQUIRE(nextIndex == meshData.mIndices32.size());
+}
+}
+
+TEST_CASE("Meshlet builder")
+{
+    std::vector<MeshletBuilder::Meshlet> meshlets;
+
+    SECTION("Flat grid")
+    {
+        MeshData meshData;
+        CreateGridMeshData(32U, meshData);
+        MeshOptimizer::OptimizeMesh(meshData);
+        const std::vector<std::array<std::uint32_t, 3U>> triangles = GetSortedTriangles(meshData);
+        MeshletBuilder::BuildMeshlets(meshData.mVertices, meshData.mIndices32, meshlets);
+        REQUIRE(GetSortedTriangles(meshData) == triangles);
+        CheckMeshlets(meshData, meshlets);
+
+        // 2048 triangles need at least 17 meshlets
+        REQUIRE(meshlets.size() >= 17U);
+
+        // Every triangle has the same normal, so the cone is a line.
+        for (const MeshletBuilder::Meshlet& meshlet : meshlets) {
+            REQUIRE(meshlet.mConeAxis.z == Approx(-1.0f));
+            REQUIRE(meshlet.mConeCutoff == Approx(0.0f).epsilon(0.001f));
+        }
+    }
+
+    SECTION("Sphere")
+    {
+        MeshData meshData;
+        CreateSphereMeshData(64U, 32U, meshData);
+        MeshOptimizer::OptimizeMesh(meshData);
+        const std::vector<std::array<std::uint32_t, 3U>> triangles = GetSortedTriangles(meshData);
+        MeshletBuilder::BuildMeshlets(meshData.mVertices, meshData.mIndices32, meshlets);
+        REQUIRE(GetSortedTriangles(meshData) == triangles);
+        CheckMeshlets(meshData, meshlets);
+
+        // Meshlets of optimized meshes are compact, so most of them can be backface culled.
+        std::size_t coneCount{ 0U };
+        for (const MeshletBuilder::Meshlet& meshlet : meshlets) {
+            REQUIRE(meshlet.mRadius < 1.0f);
+            coneCount += meshlet.mConeCutoff < 1.0f ? 1U : 0U;
+        }
+        REQUIRE(coneCount * 10U >= meshlets.size() * 9U);
+    }
+
+    SECTION("Degenerate triangles")
+    {
+        MeshData meshData;
+        CreateGridMeshData(1U, meshData);
+        meshData.mIndices32 = { 0U, 0U, 1U, 1U, 2U, 2U };
+        MeshletBuilder::BuildMeshlets(meshData.mVertices, meshData.mIndices32, meshlets);
+        CheckMeshlets(meshData, meshlets);
+        REQUIRE(meshlets.size() == 1U);
+        REQUIRE(meshlets[0U].mConeCutoff == 1.0f);
+    }
+
+    SECTION("Triangle soup")
+    {
+        // 30 triangles without shared vertices fill meshlets up to the vertex limit
+        MeshData gridMeshData;
+        CreateGridMeshData(16U, gridMeshData);
+        MeshData meshData;
+        for (std::uint32_t i = 0U; i < 90U; ++i) {
+            meshData.mVertices.push_back(gridMeshData.mVertices[gridMeshData.mIndices32[i]]);
+            meshData.mIndices32.push_back(i);
+        }
+
+        const std::vector<std::array<std::uint32_t, 3U>> triangles = GetSortedTriangles(meshData);
+        MeshletBuilder::BuildMeshlets(meshData.mVertices, meshData.mIndices32, meshlets);
+        REQUIRE(GetSortedTriangles(meshData) == triangles);
+        CheckMeshlets(meshData, meshlets);
+        REQUIRE(meshlets.size() == 2U);
+        REQUIRE(meshlets[0U].mIndexCount == 63U);
+    }
+
+    SECTION("Empty mesh")
+    {
+        MeshData meshData;
+        CreateGridMeshData(1U, meshData);
+        meshData.mIndices32.clear();
+        MeshletBuilder::BuildMeshlets(meshData.mVertices, meshData.mIndices32, meshlets);
+        REQUIRE(meshlets.empty());
+    }
+}
+
+// Reports meshlet build times and meshlet statistics of the bundled models.
+// It must be run explicitly, from the Executable directory: UnitTests.exe [benchmark]
+TEST_CASE("Meshlet build times", "[.][benchmark]")
+{
+    const char* modelFilenames[]{
+        "resources/models/floor.obj",
+        "resources/models/mitsubaFloor.obj",
+        "resources/models/torusKnot.obj",
+        "resources/models/unreal.obj",
+    };
+
+    for (const char* modelFilename : modelFilenames) {
+        std::vector<MeshData> meshDataList;
+        BRE::ModelImporter::ImportModel(modelFilename, meshDataList);
+        REQUIRE(meshDataList.empty() == false);
+
+        for (std::size_t i = 0U; i < meshDataList.size(); ++i) {
+            MeshData& meshData = meshDataList[i];
+            MeshOptimizer::OptimizeMesh(meshData);
+
+            std::vector<MeshletBuilder::Meshlet> meshlets;
+            const auto startTime = std::chrono::high_resolution_clock::now();
+            MeshletBuilder::BuildMeshlets(meshData.mVertices, meshData.mIndices32, meshlets);
+            const auto endTime = std::chrono::high_resolution_clock::now();
+            CheckMeshlets(meshData, meshlets);
+
+            std::size_t coneCount{ 0U };
+            for (const MeshletBuilder::Meshlet& meshlet : meshlets) {
+                coneCount += meshlet.mConeCutoff < 1.0f ? 1U : 0U;
+            }
+
+            const double timeInMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+            WARN(modelFilename << " mesh " << i << ": " << meshlets.size() << " meshlets, " <<
+                 meshData.mIndices32.size() / 3U / static_cast<double>(meshlets.size()) << " triangles per meshlet, " <<
+                 coneCount << " with normal cone, " << timeInMs << " ms");
+        }
+    }
+}
\ No newline at end of file
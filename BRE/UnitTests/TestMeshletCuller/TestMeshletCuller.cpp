@@ -0,0 +1,366 @@
+#include <UnitTests\Catch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <ModelManager\MeshletBuilder.h>
+#include <ModelManager\MeshletCuller.h>
+#include <ModelManager\MeshOptimizer.h>
+#include <ModelManager\ModelImporter.h>
+
+using BRE::GeometryGenerator::MeshData;
+using BRE::GeometryGenerator::Vertex;
+using BRE::MeshletBuilder;
+using BRE::MeshletCuller;
+using BRE::MeshOptimizer;
+using namespace DirectX;
+
+namespace {
+///
+/// @brief Creates a mesh data with a unit sphere, centered at the origin, with outward front faces
+/// @param sliceCount Number of slices
+/// @param stackCount Number of stacks
+/// @param meshData Output mesh data
+///
+void
+CreateSphereMeshData(const std::uint32_t sliceCount,
+                     const std::uint32_t stackCount,
+                     MeshData& meshData)
+{
+    const float pi = 3.14159265f;
+    for (std::uint32_t stack = 0U; stack <= stackCount; ++stack) {
+        const float phi = pi * stack / stackCount;
+        for (std::uint32_t slice = 0U; slice <= sliceCount; ++slice) {
+            const float theta = 2.0f * pi * slice / sliceCount;
+            const XMFLOAT3 position(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+            meshData.mVertices.push_back(Vertex(position,
+                                                position,
+                                                XMFLOAT3(-std::sin(theta), 0.0f, std::cos(theta)),
+                                                XMFLOAT2(static_cast<float>(slice) / sliceCount, static_cast<float>(stack) / stackCount)));
+        }
+    }
+
+    const std::uint32_t rowVertexCount = sliceCount + 1U;
+    for (std::uint32_t stack = 0U; stack < stackCount; ++stack) {
+        for (std::uint32_t slice = 0U; slice < sliceCount; ++slice) {
+            const std::uint32_t vertex = stack * rowVertexCount + slice;
+            meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex, vertex + 1U, vertex + rowVertexCount });
+            meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex + 1U, vertex + rowVertexCount + 1U, vertex + rowVertexCount });
+        }
+    }
+}
+
+///
+/// @brief Computes a view projection matrix
+/// @param eyePosition Eye position
+/// @param targetPosition Target position
+/// @param fieldOfView Vertical field of view in radians
+/// @return View projection matrix
+///
+XMFLOAT4X4
+ComputeViewProjectionMatrix(const XMFLOAT3& eyePosition,
+                            const XMFLOAT3& targetPosition,
+                            const float fieldOfView)
+{
+    const XMMATRIX viewMatrix = XMMatrixLookAtLH(XMVectorSet(eyePosition.x, eyePosition.y, eyePosition.z, 1.0f),
+                                                 XMVectorSet(targetPosition.x, targetPosition.y, targetPosition.z, 1.0f),
+                                                 XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    const XMMATRIX projectionMatrix = XMMatrixPerspectiveFovLH(fieldOfView, 1.0f, 0.1f, 1000.0f);
+    XMFLOAT4X4 viewProjectionMatrix;
+    XMStoreFloat4x4(&viewProjectionMatrix, XMMatrixMultiply(viewMatrix, projectionMatrix));
+
+    return viewProjectionMatrix;
+}
+
+///
+/// @brief Transforms a point to clip space
+/// @param point Point
+/// @param matrix Transformation matrix
+/// @return Clip space point
+///
+XMFLOAT4
+TransformPoint(const XMFLOAT3& point,
+               const XMFLOAT4X4& matrix)
+{
+    float result[4U];
+    for (std::uint32_t i = 0U; i < 4U; ++i) {
+        result[i] = point.x * matrix.m[0U][i] + point.y * matrix.m[1U][i] + point.z * matrix.m[2U][i] + matrix.m[3U][i];
+    }
+
+    return XMFLOAT4(result[0U], result[1U], result[2U], result[3U]);
+}
+
+///
+/// @brief Checks if a triangle can be rasterized: it is a front face, and it is not outside a frustum plane.
+///
+/// Triangles that cross the eye plane are considered visible.
+///
+/// @param meshData Mesh data
+/// @param firstIndex First index of the triangle
+/// @param worldViewProjectionMatrix World view projection matrix
+/// @return True if the triangle can be rasterized. Otherwise, false.
+///
+bool
+IsTriangleVisible(const MeshData& meshData,
+                  const std::size_t firstIndex,
+                  const XMFLOAT4X4& worldViewProjectionMatrix)
+{
+    XMFLOAT4 positions[3U];
+    for (std::size_t i = 0U; i < 3U; ++i) {
+        positions[i] = TransformPoint(meshData.mVertices[meshData.mIndices32[firstIndex + i]].mPosition,
+                                      worldViewProjectionMatrix);
+    }
+
+    // Outside a frustum plane: -w <= x <= w, -w <= y <= w and 0 <= z <= w
+    const float planeSigns[2U]{ 1.0f, -1.0f };
+    for (std::uint32_t component = 0U; component < 3U; ++component) {
+        for (const float sign : planeSigns) {
+            bool isOutside = true;
+            for (const XMFLOAT4& position : positions) {
+                const float value = component == 0U ? position.x : component == 1U ? position.y : position.z;
+                const float w = component == 2U && sign > 0.0f ? 0.0f : position.w;
+                isOutside = isOutside && w + sign * value < 0.0f;
+            }
+
+            if (isOutside) {
+                return false;
+            }
+        }
+    }
+
+    if (positions[0U].w <= 0.0f || positions[1U].w <= 0.0f || positions[2U].w <= 0.0f) {
+        return true;
+    }
+
+    // Clockwise front faces in normalized device coordinates
+    const float x0 = positions[0U].x / positions[0U].w;
+    const float y0 = positions[0U].y / positions[0U].w;
+    const float x1 = positions[1U].x / positions[1U].w;
+    const float y1 = positions[1U].y / positions[1U].w;
+    const float x2 = positions[2U].x / positions[2U].w;
+    const float y2 = positions[2U].y / positions[2U].w;
+
+    return (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0) < 0.0f;
+}
+
+///
+/// @brief Checks culling is conservative: every visible triangle is in a visible index range
+/// @param meshData Mesh data
+/// @param worldMatrix World matrix
+/// @param viewProjectionMatrix View projection matrix
+/// @param visibleIndexRanges Visible index ranges
+/// @return Number of visible indices
+///
+std::uint32_t
+CheckVisibleIndexRanges(const MeshData& meshData,
+                        const XMFLOAT4X4& worldMatrix,
+                        const XMFLOAT4X4& viewProjectionMatrix,
+                        const std::vector<MeshletCuller::IndexRange>& visibleIndexRanges)
+{
+    XMFLOAT4X4 worldViewProjectionMatrix;
+    XMStoreFloat4x4(&worldViewProjectionMatrix,
+                    XMMatrixMultiply(XMLoadFloat4x4(&worldMatrix), XMLoadFloat4x4(&viewProjectionMatrix)));
+
+    std::vector<bool> isIndexVisible(meshData.mIndices32.size(), false);
+    std::uint32_t visibleIndexCount{ 0U };
+    for (std::size_t i = 0U; i < visibleIndexRanges.size(); ++i) {
+        const MeshletCuller::IndexRange& indexRange = visibleIndexRanges[i];
+        REQUIRE(indexRange.mIndexCount > 0U);
+        REQUIRE(indexRange.mFirstIndex + indexRange.mIndexCount <= meshData.mIndices32.size());
+
+        // Adjacent ranges are merged
+        if (i > 0U) {
+            REQUIRE(visibleIndexRanges[i - 1U].mFirstIndex + visibleIndexRanges[i - 1U].mIndexCount < indexRange.mFirstIndex);
+        }
+
+        std::fill(isIndexVisible.begin() + indexRange.mFirstIndex,
+                  isIndexVisible.begin() + indexRange.mFirstIndex + indexRange.mIndexCount,
+                  true);
+        visibleIndexCount += indexRange.mIndexCount;
+    }
+
+    for (std::size_t i = 0U; i < meshData.mIndices32.size(); i += 3U) {
+        if (isIndexVisible[i] == false) {
+            REQUIRE(IsTriangleVisible(meshData, i, worldViewProjectionMatrix) == false);
+        }
+    }
+
+    return visibleIndexCount;
+}
+
+///
+/// @brief Get identity matrix
+/// @return Identity matrix
+///
+XMFLOAT4X4
+GetIdentityMatrix()
+{
+    XMFLOAT4X4 identityMatrix;
+    XMStoreFloat4x4(&identityMatrix, XMMatrixIdentity());
+
+    return identityMatrix;
+}
+}
+
+TEST_CASE("Meshlet culler")
+{
+    MeshData meshData;
+    CreateSphereMeshData(64U, 32U, meshData);
+    MeshOptimizer::OptimizeMesh(meshData);
+    std::vector<MeshletBuilder::Meshlet> meshlets;
+    MeshletBuilder::BuildMeshlets(meshData.mVertices, meshData.mIndices32, meshlets);
+
+    const std::uint32_t indexCount = static_cast<std::uint32_t>(meshData.mIndices32.size());
+    const XMFLOAT4X4 identityMatrix = GetIdentityMatrix();
+    std::vector<MeshletCuller::IndexRange> visibleIndexRanges;
+
+    SECTION("Backface culling")
+    {
+        const XMFLOAT3 eyePosition(0.0f, 0.0f, -5.0f);
+        const XMFLOAT4X4 viewProjectionMatrix = ComputeViewProjectionMatrix(eyePosition, XMFLOAT3(0.0f, 0.0f, 0.0f), XM_PIDIV2);
+        MeshletCuller::CullMeshlets(meshlets, identityMatrix, viewProjectionMatrix, eyePosition, visibleIndexRanges);
+        const std::uint32_t visibleIndexCount = CheckVisibleIndexRanges(meshData, identityMatrix, viewProjectionMatrix, visibleIndexRanges);
+
+        // The back hemisphere is culled
+        REQUIRE(visibleIndexCount > 0U);
+        REQUIRE(visibleIndexCount < indexCount * 3U / 4U);
+    }
+
+    SECTION("Frustum culling")
+    {
+        // Looking away from the sphere
+        const XMFLOAT3 eyePosition(0.0f, 0.0f, -5.0f);
+        XMFLOAT4X4 viewProjectionMatrix = ComputeViewProjectionMatrix(eyePosition, XMFLOAT3(0.0f, 0.0f, -10.0f), XM_PIDIV2);
+        MeshletCuller::CullMeshlets(meshlets, identityMatrix, viewProjectionMatrix, eyePosition, visibleIndexRanges);
+        REQUIRE(visibleIndexRanges.empty());
+
+        // Looking at the sphere border with a narrow field of view
+        viewProjectionMatrix = ComputeViewProjectionMatrix(eyePosition, XMFLOAT3(0.9f, 0.0f, 0.0f), XM_PIDIV4 * 0.25f);
+        MeshletCuller::CullMeshlets(meshlets, identityMatrix, viewProjectionMatrix, eyePosition, visibleIndexRanges);
+        const std::uint32_t visibleIndexCount = CheckVisibleIndexRanges(meshData, identityMatrix, viewProjectionMatrix, visibleIndexRanges);
+        REQUIRE(visibleIndexCount > 0U);
+        REQUIRE(visibleIndexCount < indexCount / 3U);
+    }
+
+    SECTION("Eye inside the sphere")
+    {
+        // Every triangle is a back face
+        const XMFLOAT3 eyePosition(0.0f, 0.0f, 0.0f);
+        const XMFLOAT4X4 viewProjectionMatrix = ComputeViewProjectionMatrix(eyePosition, XMFLOAT3(0.0f, 0.0f, 1.0f), XM_PIDIV2);
+        MeshletCuller::CullMeshlets(meshlets, identityMatrix, viewProjectionMatrix, eyePosition, visibleIndexRanges);
+        CheckVisibleIndexRanges(meshData, identityMatrix, viewProjectionMatrix, visibleIndexRanges);
+    }
+
+    SECTION("World matrices")
+    {
+        XMFLOAT4X4 worldMatrix;
+        XMStoreFloat4x4(&worldMatrix,
+                        XMMatrixMultiply(XMMatrixMultiply(XMMatrixScaling(4.0f, 1.0f, 2.0f), XMMatrixRotationY(0.5f)),
+                                         XMMatrixTranslation(100.0f, 0.0f, 0.0f)));
+
+        // The sphere is not where the model space sphere is
+        XMFLOAT3 eyePosition(0.0f, 0.0f, -5.0f);
+        XMFLOAT4X4 viewProjectionMatrix = ComputeViewProjectionMatrix(eyePosition, XMFLOAT3(0.0f, 0.0f, 0.0f), XM_PIDIV2);
+        MeshletCuller::CullMeshlets(meshlets, worldMatrix, viewProjectionMatrix, eyePosition, visibleIndexRanges);
+        REQUIRE(visibleIndexRanges.empty());
+
+        // Random views of the transformed sphere
+        const float pi = 3.14159265f;
+        for (std::uint32_t i = 0U; i < 32U; ++i) {
+            const float angle = 2.0f * pi * i / 32U;
+            eyePosition = XMFLOAT3(100.0f + 8.0f * std::cos(angle), 3.0f * std::sin(angle * 3.0f), 8.0f * std::sin(angle));
+            viewProjectionMatrix = ComputeViewProjectionMatrix(eyePosition,
+                                                               XMFLOAT3(100.0f + std::sin(angle * 5.0f), 0.0f, 0.0f),
+                                                               XM_PIDIV4);
+            MeshletCuller::CullMeshlets(meshlets, worldMatrix, viewProjectionMatrix, eyePosition, visibleIndexRanges);
+            const std::uint32_t visibleIndexCount = CheckVisibleIndexRanges(meshData, worldMatrix, viewProjectionMatrix, visibleIndexRanges);
+            REQUIRE(visibleIndexCount > 0U);
+            REQUIRE(visibleIndexCount < indexCount);
+        }
+    }
+
+    SECTION("Mirrored world matrix")
+    {
+        // Winding is reversed, so back faces are not culled
+        XMFLOAT4X4 worldMatrix;
+        XMStoreFloat4x4(&worldMatrix, XMMatrixScaling(-1.0f, 1.0f, 1.0f));
+
+        const XMFLOAT3 eyePosition(0.0f, 0.0f, -5.0f);
+        const XMFLOAT4X4 viewProjectionMatrix = ComputeViewProjectionMatrix(eyePosition, XMFLOAT3(0.0f, 0.0f, 0.0f), XM_PIDIV2);
+        MeshletCuller::CullMeshlets(meshlets, worldMatrix, viewProjectionMatrix, eyePosition, visibleIndexRanges);
+        REQUIRE(visibleIndexRanges.size() == 1U);
+        REQUIRE(visibleIndexRanges[0U].mFirstIndex == 0U);
+        REQUIRE(visibleIndexRanges[0U].mIndexCount == indexCount);
+    }
+}
+
+// Reports meshlet culling times and visible triangles of the bundled models, with views around each model.
+// It must be run explicitly, from the Executable directory: UnitTests.exe [benchmark]
+TEST_CASE("Meshlet culling times", "[.][benchmark]")
+{
+    const char* modelFilenames[]{
+        "resources/models/floor.obj",
+        "resources/models/mitsubaFloor.obj",
+        "resources/models/torusKnot.obj",
+        "resources/models/unreal.obj",
+    };
+
+    const XMFLOAT4X4 identityMatrix = GetIdentityMatrix();
+    for (const char* modelFilename : modelFilenames) {
+        std::vector<MeshData> meshDataList;
+        BRE::ModelImporter::ImportModel(modelFilename, meshDataList);
+        REQUIRE(meshDataList.empty() == false);
+
+        for (std::size_t i = 0U; i < meshDataList.size(); ++i) {
+            MeshData& meshData = meshDataList[i];
+            MeshOptimizer::OptimizeMesh(meshData);
+            std::vector<MeshletBuilder::Meshlet> meshlets;
+            MeshletBuilder::BuildMeshlets(meshData.mVertices, meshData.mIndices32, meshlets);
+
+            // Views around the bounding sphere of the mesh, looking at its center
+            XMFLOAT3 center(0.0f, 0.0f, 0.0f);
+            float radius{ 0.0f };
+            for (const MeshletBuilder::Meshlet& meshlet : meshlets) {
+                center.x += meshlet.mCenter.x / meshlets.size();
+                center.y += meshlet.mCenter.y / meshlets.size();
+                center.z += meshlet.mCenter.z / meshlets.size();
+            }
+            for (const MeshletBuilder::Meshlet& meshlet : meshlets) {
+                const float x = meshlet.mCenter.x - center.x;
+                const float y = meshlet.mCenter.y - center.y;
+                const float z = meshlet.mCenter.z - center.z;
+                radius = std::max(radius, std::sqrt(x * x + y * y + z * z) + meshlet.mRadius);
+            }
+
+            const std::uint32_t viewCount{ 64U };
+            std::vector<MeshletCuller::IndexRange> visibleIndexRanges;
+            std::uint64_t visibleIndexCount{ 0UL };
+            std::uint64_t drawCallCount{ 0UL };
+            double timeInMs{ 0.0 };
+            for (std::uint32_t j = 0U; j < viewCount; ++j) {
+                const float angle = 2.0f * 3.14159265f * j / viewCount;
+                const XMFLOAT3 eyePosition(center.x + 1.5f * radius * std::cos(angle),
+                                           center.y + 0.5f * radius,
+                                           center.z + 1.5f * radius * std::sin(angle));
+                const XMFLOAT4X4 viewProjectionMatrix = ComputeViewProjectionMatrix(eyePosition, center, XM_PIDIV4);
+
+                const auto startTime = std::chrono::high_resolution_clock::now();
+                MeshletCuller::CullMeshlets(meshlets, identityMatrix, viewProjectionMatrix, eyePosition, visibleIndexRanges);
+                const auto endTime = std::chrono::high_resolution_clock::now();
+                timeInMs += std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+                for (const MeshletCuller::IndexRange& indexRange : visibleIndexRanges) {
+                    visibleIndexCount += indexRange.mIndexCount;
+                }
+                drawCallCount += visibleIndexRanges.size();
+            }
+
+            WARN(modelFilename << " mesh " << i << ": " << meshlets.size() << " meshlets, " <<
+                 100.0 * visibleIndexCount / (static_cast<double>(meshData.mIndices32.size()) * viewCount) << "% visible triangles, " <<
+                 static_cast<double>(drawCallCount) / viewCount << " draw calls, " <<
+                 timeInMs / viewCount << " ms per cull");
+        }
+    }
+}
\ No newline at end of file
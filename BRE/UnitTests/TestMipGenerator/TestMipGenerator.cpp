@@ -0,0 +1,311 @@
+#include <UnitTests\Catch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <ResourceManager\DDSTextureLoader.h>
+#include <ResourceManager\MipGenerator.h>
+
+using BRE::MipGenerator;
+
+namespace {
+///
+/// @brief Creates DDS data of a square texture
+/// @param size Size of mip level 0
+/// @param mipLevelCount Number of mip levels
+/// @param isR8 True if the format is R8. Otherwise, it is RGBA8.
+/// @param ddsData Output DDS data
+///
+void
+CreateDDSData(const std::uint32_t size,
+              const std::uint32_t mipLevelCount,
+              const bool isR8,
+              std::vector<std::uint8_t>& ddsData)
+{
+    const std::uint32_t texelSize = isR8 ? 1U : 4U;
+
+    // Magic number and DDS_HEADER as 32 bits words
+    std::uint32_t header[32U]{};
+    header[0U] = 0x20534444U; // "DDS "
+    header[1U] = 124U; // size
+    header[2U] = 0x1007U | (mipLevelCount > 1U ? 0x20000U : 0U); // DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP
+    header[3U] = size; // height
+    header[4U] = size; // width
+    header[5U] = size * texelSize; // pitch
+    header[7U] = mipLevelCount;
+    header[19U] = 32U; // pixel format size
+    header[20U] = isR8 ? 0x20000U : 0x41U; // DDS_LUMINANCE or DDS_RGBA
+    header[22U] = texelSize * 8U; // bits per pixel
+    header[23U] = 0x000000FFU; // red mask
+    header[24U] = isR8 ? 0U : 0x0000FF00U; // green mask
+    header[25U] = isR8 ? 0U : 0x00FF0000U; // blue mask
+    header[26U] = isR8 ? 0U : 0xFF000000U; // alpha mask
+    header[27U] = 0x1000U | (mipLevelCount > 1U ? 0x400008U : 0U); // DDS_SURFACE_FLAGS_TEXTURE | DDS_SURFACE_FLAGS_MIPMAP
+
+    ddsData.assign(reinterpret_cast<const std::uint8_t*>(header),
+                   reinterpret_cast<const std::uint8_t*>(header) + sizeof(header));
+
+    for (std::uint32_t i = 0U; i < mipLevelCount; ++i) {
+        const std::uint32_t mipLevelSize = std::max(size >> i, 1U);
+        for (std::uint32_t j = 0U; j < mipLevelSize * mipLevelSize * texelSize; ++j) {
+            ddsData.push_back(static_cast<std::uint8_t>(j * 7U));
+        }
+    }
+}
+
+///
+/// @brief Fills an RGBA8 image with one texel
+/// @param texel RGBA8 texel
+/// @param texelCount Number of texels
+/// @param texels Output tightly packed texels
+///
+void
+CreateConstantImage(const std::uint8_t texel[4U],
+                    const std::uint32_t texelCount,
+                    std::vector<std::uint8_t>& texels)
+{
+    texels.resize(texelCount * 4U);
+    for (std::uint32_t i = 0U; i < texelCount; ++i) {
+        for (std::uint32_t j = 0U; j < 4U; ++j) {
+            texels[i * 4U + j] = texel[j];
+        }
+    }
+}
+}
+
+TEST_CASE("Mip level count")
+{
+    REQUIRE(MipGenerator::GetMipLevelCount(1U, 1U) == 1U);
+    REQUIRE(MipGenerator::GetMipLevelCount(2U, 1U) == 2U);
+    REQUIRE(MipGenerator::GetMipLevelCount(256U, 256U) == 9U);
+    REQUIRE(MipGenerator::GetMipLevelCount(256U, 16U) == 9U);
+    REQUIRE(MipGenerator::GetMipLevelCount(5U, 3U) == 3U);
+}
+
+TEST_CASE("Generate image mip levels")
+{
+    MipGenerator::Settings settings;
+    std::vector<std::uint8_t> texels;
+    std::vector<std::uint8_t> mipLevelTexels;
+
+    SECTION("Mip levels are stored after mip level 0")
+    {
+        const std::uint8_t texel[4U]{ 10U, 20U, 30U, 40U };
+        CreateConstantImage(texel, 8U * 2U, texels);
+        MipGenerator::GenerateImageMipLevels(settings, texels.data(), 8U, 2U, mipLevelTexels);
+
+        // 8x2, 4x1, 2x1 and 1x1
+        REQUIRE(mipLevelTexels.size() == (16U + 4U + 2U + 1U) * 4U);
+        REQUIRE(std::equal(texels.begin(), texels.end(), mipLevelTexels.begin()));
+    }
+
+    SECTION("Constant images are kept by every filter")
+    {
+        const std::uint8_t texel[4U]{ 100U, 37U, 250U, 128U };
+        CreateConstantImage(texel, 16U * 16U, texels);
+
+        const MipGenerator::Filter filters[]{ MipGenerator::Filter::BOX, MipGenerator::Filter::KAISER };
+        for (const MipGenerator::Filter filter : filters) {
+            for (std::uint32_t i = 0U; i < 2U; ++i) {
+                settings.mFilter = filter;
+                settings.mIsSRGB = i == 1U;
+                MipGenerator::GenerateImageMipLevels(settings, texels.data(), 16U, 16U, mipLevelTexels);
+                for (std::size_t j = 0U; j < mipLevelTexels.size(); ++j) {
+                    REQUIRE(mipLevelTexels[j] == texel[j % 4U]);
+                }
+            }
+        }
+    }
+
+    SECTION("Box filter averages texels")
+    {
+        // Checkerboard of black and white texels
+        texels.resize(4U * 4U * 4U);
+        for (std::uint32_t i = 0U; i < 16U; ++i) {
+            const std::uint8_t value = ((i % 4U) + (i / 4U)) % 2U == 0U ? 0U : 255U;
+            texels[i * 4U] = value;
+            texels[i * 4U + 1U] = value;
+            texels[i * 4U + 2U] = value;
+            texels[i * 4U + 3U] = 255U - value;
+        }
+        MipGenerator::GenerateImageMipLevels(settings, texels.data(), 4U, 4U, mipLevelTexels);
+
+        REQUIRE(mipLevelTexels.size() == (16U + 4U + 1U) * 4U);
+        for (std::size_t i = 16U * 4U; i < mipLevelTexels.size(); ++i) {
+            REQUIRE(mipLevelTexels[i] == 128U);
+        }
+    }
+
+    SECTION("Odd sizes are filtered with the whole source texels")
+    {
+        const std::uint8_t sourceTexels[]{
+            0U, 0U, 0U, 255U,
+            255U, 255U, 255U, 255U,
+            0U, 0U, 0U, 255U,
+        };
+        MipGenerator::GenerateImageMipLevels(settings, sourceTexels, 3U, 1U, mipLevelTexels);
+
+        REQUIRE(mipLevelTexels.size() == (3U + 1U) * 4U);
+        REQUIRE(mipLevelTexels[12U] == 85U);
+        REQUIRE(mipLevelTexels[15U] == 255U);
+    }
+
+    SECTION("sRGB images are filtered in linear space")
+    {
+        const std::uint8_t sourceTexels[]{
+            0U, 0U, 0U, 0U,
+            255U, 255U, 255U, 255U,
+        };
+        MipGenerator::GenerateImageMipLevels(settings, sourceTexels, 2U, 1U, mipLevelTexels);
+        REQUIRE(mipLevelTexels[8U] == 128U);
+        REQUIRE(mipLevelTexels[11U] == 128U);
+
+        // Linear 0.5 is sRGB 0.735. Alpha is linear.
+        settings.mIsSRGB = true;
+        MipGenerator::GenerateImageMipLevels(settings, sourceTexels, 2U, 1U, mipLevelTexels);
+        REQUIRE(mipLevelTexels[8U] == 188U);
+        REQUIRE(mipLevelTexels[9U] == 188U);
+        REQUIRE(mipLevelTexels[10U] == 188U);
+        REQUIRE(mipLevelTexels[11U] == 128U);
+    }
+
+    SECTION("Normal maps are renormalized")
+    {
+        // (1, 0, 0) and (0, 0, 1)
+        const std::uint8_t sourceTexels[]{
+            255U, 128U, 128U, 255U,
+            128U, 128U, 255U, 255U,
+        };
+        settings.mIsNormalMap = true;
+        MipGenerator::GenerateImageMipLevels(settings, sourceTexels, 2U, 1U, mipLevelTexels);
+        REQUIRE(mipLevelTexels[8U] == 218U);
+        REQUIRE(mipLevelTexels[9U] == 128U);
+        REQUIRE(mipLevelTexels[10U] == 218U);
+        REQUIRE(mipLevelTexels[11U] == 255U);
+
+        // Random normals
+        std::srand(1U);
+        texels.resize(32U * 32U * 4U);
+        for (std::uint32_t i = 0U; i < 32U * 32U; ++i) {
+            texels[i * 4U] = static_cast<std::uint8_t>(std::rand() % 256);
+            texels[i * 4U + 1U] = static_cast<std::uint8_t>(std::rand() % 256);
+            texels[i * 4U + 2U] = static_cast<std::uint8_t>(128 + std::rand() % 128);
+            texels[i * 4U + 3U] = 255U;
+        }
+
+        const MipGenerator::Filter filters[]{ MipGenerator::Filter::BOX, MipGenerator::Filter::KAISER };
+        for (const MipGenerator::Filter filter : filters) {
+            settings.mFilter = filter;
+            MipGenerator::GenerateImageMipLevels(settings, texels.data(), 32U, 32U, mipLevelTexels);
+            for (std::size_t i = texels.size(); i < mipLevelTexels.size(); i += 4U) {
+                const float x = mipLevelTexels[i] * (2.0f / 255.0f) - 1.0f;
+                const float y = mipLevelTexels[i + 1U] * (2.0f / 255.0f) - 1.0f;
+                const float z = mipLevelTexels[i + 2U] * (2.0f / 255.0f) - 1.0f;
+                REQUIRE(std::abs(std::sqrt(x * x + y * y + z * z) - 1.0f) < 0.02f);
+            }
+        }
+    }
+
+    SECTION("Wrapped and clamped edges")
+    {
+        // A white column on the left edge. Wrapping brings it to the right edge too.
+        texels.assign(16U * 4U, 0U);
+        texels[0U] = 255U;
+        settings.mFilter = MipGenerator::Filter::KAISER;
+
+        settings.mIsWrapped = true;
+        MipGenerator::GenerateImageMipLevels(settings, texels.data(), 16U, 1U, mipLevelTexels);
+        const std::uint8_t wrappedRightEdge = mipLevelTexels[(16U + 7U) * 4U];
+
+        settings.mIsWrapped = false;
+        MipGenerator::GenerateImageMipLevels(settings, texels.data(), 16U, 1U, mipLevelTexels);
+        const std::uint8_t clampedRightEdge = mipLevelTexels[(16U + 7U) * 4U];
+
+        REQUIRE(wrappedRightEdge > clampedRightEdge);
+    }
+}
+
+TEST_CASE("Generate DDS mip levels")
+{
+    std::vector<std::uint8_t> sourceData;
+    std::vector<std::uint8_t> ddsData;
+
+    D3D12_RESOURCE_DESC textureDescriptor{};
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+
+    SECTION("Textures without mip levels get all of them")
+    {
+        CreateDDSData(16U, 1U, false, sourceData);
+
+        REQUIRE(MipGenerator::GenerateMipLevels(sourceData.data(), sourceData.size(), MipGenerator::Filter::BOX, false, ddsData));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(ddsData.data(), ddsData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Format == DXGI_FORMAT_R8G8B8A8_UNORM);
+        REQUIRE(textureDescriptor.Width == 16U);
+        REQUIRE(textureDescriptor.MipLevels == 5U);
+        REQUIRE(subresources.size() == 5U);
+        REQUIRE(subresources[0U].SlicePitch == 16 * 16 * 4);
+        REQUIRE(subresources[4U].SlicePitch == 4);
+        REQUIRE(std::memcmp(subresources[0U].pData, sourceData.data() + 128U, 16U * 16U * 4U) == 0);
+    }
+
+    SECTION("R8 textures stay R8")
+    {
+        CreateDDSData(8U, 1U, true, sourceData);
+
+        REQUIRE(MipGenerator::GenerateMipLevels(sourceData.data(), sourceData.size(), MipGenerator::Filter::KAISER, false, ddsData));
+        REQUIRE(SUCCEEDED(DirectX::LoadDDSTextureDataFromMemory12(ddsData.data(), ddsData.size(), textureDescriptor, subresources)));
+        REQUIRE(textureDescriptor.Format == DXGI_FORMAT_R8_UNORM);
+        REQUIRE(textureDescriptor.MipLevels == 4U);
+        REQUIRE(subresources[1U].SlicePitch == 4 * 4);
+    }
+
+    SECTION("Textures with mip levels are not changed")
+    {
+        CreateDDSData(16U, 5U, false, sourceData);
+
+        REQUIRE(MipGenerator::GenerateMipLevels(sourceData.data(), sourceData.size(), MipGenerator::Filter::BOX, false, ddsData) == false);
+    }
+
+    SECTION("1x1 textures are not changed")
+    {
+        CreateDDSData(1U, 1U, false, sourceData);
+
+        REQUIRE(MipGenerator::GenerateMipLevels(sourceData.data(), sourceData.size(), MipGenerator::Filter::BOX, false, ddsData) == false);
+    }
+}
+
+// Reports mip generation throughput of a synthetic 2048x2048 image, with every filter.
+// It must be run explicitly: UnitTests.exe [benchmark]
+TEST_CASE("Mip generation throughput", "[.][benchmark]")
+{
+    const std::uint32_t size{ 2048U };
+    std::vector<std::uint8_t> texels(size * size * 4U);
+    std::srand(1U);
+    for (std::size_t i = 0U; i < texels.size(); ++i) {
+        texels[i] = static_cast<std::uint8_t>(std::rand() % 256);
+    }
+
+    const MipGenerator::Filter filters[]{ MipGenerator::Filter::BOX, MipGenerator::Filter::KAISER };
+    for (const MipGenerator::Filter filter : filters) {
+        for (std::uint32_t i = 0U; i < 3U; ++i) {
+            MipGenerator::Settings settings;
+            settings.mFilter = filter;
+            settings.mIsSRGB = i == 1U;
+            settings.mIsNormalMap = i == 2U;
+
+            std::vector<std::uint8_t> mipLevelTexels;
+            const auto startTime = std::chrono::high_resolution_clock::now();
+            MipGenerator::GenerateImageMipLevels(settings, texels.data(), size, size, mipLevelTexels);
+            const auto endTime = std::chrono::high_resolution_clock::now();
+
+            const double timeInSeconds = std::chrono::duration<double>(endTime - startTime).count();
+            WARN((filter == MipGenerator::Filter::BOX ? "Box" : "Kaiser") <<
+                 (i == 0U ? " linear" : i == 1U ? " sRGB" : " normal map") << ": " <<
+                 size * size / timeInSeconds / 1000000.0 << " MPix/s");
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include <UnitTests\Catch.h>
+
+#include <vector>
+
+#include <ResourceStateManager\CommandListResourceStateTracker.h>
+#include <ResourceStateManager\ResourceStateResolver.h>
+
+using BRE::CommandListResourceStateTracker;
+using BRE::ResourceStateResolver;
+
+namespace {
+// Resources are never dereferenced by the tracker and the resolver,
+// so any address works as a resource identity.
+std::uint32_t sResourceStorage[4U]{ 0U };
+
+ID3D12Resource&
+GetFakeResource(const std::uint32_t index) noexcept
+{
+    return *reinterpret_cast<ID3D12Resource*>(&sResourceStorage[index]);
+}
+}
+
+TEST_CASE("CommandListResourceStateTracker")
+{
+    ID3D12Resource& resourceA = GetFakeResource(0U);
+    ID3D12Resource& resourceB = GetFakeResource(1U);
+
+    CommandListResourceStateTracker tracker;
+
+    SECTION("FirstUseDoesNotRecordBarriers")
+    {
+        tracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        tracker.ChangeResourceState(resourceB, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+
+        REQUIRE(tracker.GetPendingBarriers().empty());
+        REQUIRE(tracker.GetResourceStateEntries().size() == 2U);
+        REQUIRE(tracker.GetResourceStateEntries()[0U].mResource == &resourceA);
+        REQUIRE(tracker.GetResourceStateEntries()[0U].mFirstState == D3D12_RESOURCE_STATE_RENDER_TARGET);
+        REQUIRE(tracker.GetResourceStateEntries()[1U].mResource == &resourceB);
+        REQUIRE(tracker.GetResourceStateEntries()[1U].mFirstState == D3D12_RESOURCE_STATE_DEPTH_WRITE);
+    }
+
+    SECTION("LaterUseRecordsBarriers")
+    {
+        tracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        tracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        REQUIRE(tracker.GetPendingBarriers().empty());
+
+        tracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        REQUIRE(tracker.GetPendingBarriers().size() == 1U);
+        REQUIRE(tracker.GetPendingBarriers()[0U].Transition.StateBefore == D3D12_RESOURCE_STATE_RENDER_TARGET);
+        REQUIRE(tracker.GetPendingBarriers()[0U].Transition.StateAfter == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+        REQUIRE(tracker.GetResourceStateEntries().size() == 1U);
+        REQUIRE(tracker.GetResourceStateEntries()[0U].mFirstState == D3D12_RESOURCE_STATE_RENDER_TARGET);
+        REQUIRE(tracker.GetResourceStateEntries()[0U].mFinalState == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    }
+
+    SECTION("Reset")
+    {
+        tracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        tracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_COPY_SOURCE);
+        tracker.Reset();
+
+        REQUIRE(tracker.GetPendingBarriers().empty());
+        REQUIRE(tracker.GetResourceStateEntries().empty());
+    }
+}
+
+TEST_CASE("ResourceStateResolver")
+{
+    ID3D12Resource& resourceA = GetFakeResource(0U);
+    ID3D12Resource& resourceB = GetFakeResource(1U);
+    ID3D12Resource& mipmappedResource = GetFakeResource(2U);
+
+    ResourceStateResolver resolver;
+    resolver.AddFullResourceTracking(resourceA, D3D12_RESOURCE_STATE_COMMON);
+    resolver.AddFullResourceTracking(resourceB, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    resolver.AddSubresourceTracking(mipmappedResource, 3U, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    std::vector<ResourceStateResolver::ResourceStateTransition> transitions;
+
+    SECTION("NoTransitionIfStatesMatch")
+    {
+        CommandListResourceStateTracker tracker;
+        tracker.ChangeResourceState(resourceB, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        resolver.Resolve(tracker, transitions);
+
+        REQUIRE(transitions.empty());
+        REQUIRE(resolver.GetResourceState(resourceB) == D3D12_RESOURCE_STATE_RENDER_TARGET);
+    }
+
+    SECTION("TransitionToFirstUseState")
+    {
+        CommandListResourceStateTracker tracker;
+        tracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        tracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        resolver.Resolve(tracker, transitions);
+
+        REQUIRE(transitions.size() == 1U);
+        REQUIRE(transitions[0U].mResource == &resourceA);
+        REQUIRE(transitions[0U].mSubresourceIndex == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+        REQUIRE(transitions[0U].mStateBefore == D3D12_RESOURCE_STATE_COMMON);
+        REQUIRE(transitions[0U].mStateAfter == D3D12_RESOURCE_STATE_RENDER_TARGET);
+        REQUIRE(resolver.GetResourceState(resourceA) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    }
+
+    SECTION("FinalStatesArePropagated")
+    {
+        CommandListResourceStateTracker firstTracker;
+        firstTracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+        CommandListResourceStateTracker secondTracker;
+        secondTracker.ChangeResourceState(resourceA, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+        resolver.Resolve(firstTracker, transitions);
+        REQUIRE(transitions.size() == 1U);
+
+        transitions.clear();
+        resolver.Resolve(secondTracker, transitions);
+        REQUIRE(transitions.empty());
+    }
+
+    SECTION("ResolvedInSubmissionOrder")
+    {
+        // The second tracker is recorded first, but it is submitted last
+        CommandListResourceStateTracker secondTracker;
+        secondTracker.ChangeResourceState(resourceB, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+        CommandListResourceStateTracker firstTracker;
+        firstTracker.ChangeResourceState(resourceB, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        firstTracker.ChangeResourceState(resourceB, D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+        resolver.Resolve(firstTracker, transitions);
+        REQUIRE(transitions.empty());
+
+        resolver.Resolve(secondTracker, transitions);
+        REQUIRE(transitions.size() == 1U);
+        REQUIRE(transitions[0U].mStateBefore == D3D12_RESOURCE_STATE_COPY_SOURCE);
+        REQUIRE(transitions[0U].mStateAfter == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    }
+
+    SECTION("SubresourceTransitions")
+    {
+        CommandListResourceStateTracker tracker;
+        tracker.ChangeSubresourceState(mipmappedResource, 1U, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        tracker.ChangeSubresourceState(mipmappedResource, 2U, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        resolver.Resolve(tracker, transitions);
+
+        REQUIRE(transitions.size() == 1U);
+        REQUIRE(transitions[0U].mSubresourceIndex == 1U);
+        REQUIRE(resolver.GetSubresourceState(mipmappedResource, 0U) == D3D12_RESOURCE_STATE_RENDER_TARGET);
+        REQUIRE(resolver.GetSubresourceState(mipmappedResource, 1U) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        REQUIRE(resolver.GetSubresourceState(mipmappedResource, 2U) == D3D12_RESOURCE_STATE_RENDER_TARGET);
+    }
+
+    SECTION("FullResourceUseOfSubresourceTrackedResource")
+    {
+        // All subresources in the same state need a single transition
+        CommandListResourceStateTracker tracker;
+        tracker.ChangeResourceState(mipmappedResource, D3D12_RESOURCE_STATE_COPY_DEST);
+        resolver.Resolve(tracker, transitions);
+
+        REQUIRE(transitions.size() == 1U);
+        REQUIRE(transitions[0U].mSubresourceIndex == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+        // Subresources in different states need a transition per subresource
+        transitions.clear();
+        tracker.Reset();
+        tracker.ChangeSubresourceState(mipmappedResource, 0U, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        resolver.Resolve(tracker, transitions);
+        REQUIRE(transitions.size() == 1U);
+
+        transitions.clear();
+        tracker.Reset();
+        tracker.ChangeResourceState(mipmappedResource, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        resolver.Resolve(tracker, transitions);
+
+        REQUIRE(transitions.size() == 2U);
+        REQUIRE(transitions[0U].mSubresourceIndex == 1U);
+        REQUIRE(transitions[1U].mSubresourceIndex == 2U);
+        for (std::uint32_t i = 0U; i < 3U; ++i) {
+            REQUIRE(resolver.GetSubresourceState(mipmappedResource, i) == D3D12_RESOURCE_STATE_RENDER_TARGET);
+        }
+    }
+
+    SECTION("RemoveResourceTracking")
+    {
+        REQUIRE(resolver.IsResourceTracked(resourceA));
+        resolver.RemoveResourceTracking(resourceA);
+        REQUIRE(resolver.IsResourceTracked(resourceA) == false);
+    }
+}
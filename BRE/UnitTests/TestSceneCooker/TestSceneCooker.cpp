@@ -0,0 +1,614 @@
+#include <UnitTests\Catch.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#pragma warning( push )
+#pragma warning( disable : 4127)
+#include <yaml-cpp/yaml.h>
+#pragma warning( pop )
+
+#include <MathUtils\MathUtils.h>
+#include <SceneLoader\CompiledScene.h>
+#include <SceneLoader\SceneCooker.h>
+#include <Utils\MemoryMappedFile.h>
+
+using BRE::CompiledScene;
+using BRE::MathUtils;
+using BRE::SceneCooker;
+using DirectX::XMFLOAT4X4;
+
+namespace {
+const char* sSceneFilePath{ "test_scene.yml" };
+const char* sModelsFilePath{ "test_scene_models.yml" };
+const char* sMaterialTechniquesFilePath{ "test_scene_material_techniques.yml" };
+const char* sDrawableObjectsFilePath{ "test_scene_drawable_objects.yml" };
+const char* sCompiledSceneFilePath{ "test_scene.brescene" };
+
+///
+/// @brief Writes a file
+/// @param filePath File path
+/// @param content File content
+///
+void
+WriteFile(const char* filePath,
+          const std::string& content)
+{
+    std::ofstream fileStream{ filePath, std::ios::out | std::ios::binary | std::ios::trunc };
+    fileStream.write(content.data(), content.size());
+}
+
+///
+/// @brief Writes a compiled scene file
+/// @param compiledSceneData Compiled scene data
+///
+void
+WriteCompiledSceneFile(const std::vector<std::uint8_t>& compiledSceneData)
+{
+    WriteFile(sCompiledSceneFilePath,
+              std::string(reinterpret_cast<const char*>(compiledSceneData.data()), compiledSceneData.size()));
+}
+
+///
+/// @brief Checks if two matrices are equal
+/// @param a First matrix
+/// @param b Second matrix
+/// @return True if they are equal. Otherwise, false.
+///
+bool
+AreEqual(const XMFLOAT4X4& a,
+         const XMFLOAT4X4& b)
+{
+    return std::memcmp(&a, &b, sizeof(XMFLOAT4X4)) == 0;
+}
+
+///
+/// @brief Writes a large scene, with half of its drawable objects in a "reference" file
+/// @param drawableObjectCount Number of drawable objects
+///
+void
+WriteLargeScene(const std::uint32_t drawableObjectCount)
+{
+    const std::uint32_t modelCount{ 16U };
+    const std::uint32_t materialTechniqueCount{ 8U };
+
+    std::ostringstream sceneStream;
+    sceneStream << "models:\n";
+    for (std::uint32_t i = 0U; i < modelCount; ++i) {
+        sceneStream << "  model" << i << ": resources/models/model" << i << ".obj\n";
+    }
+    sceneStream << "material techniques:\n";
+    for (std::uint32_t i = 0U; i < materialTechniqueCount; ++i) {
+        sceneStream << "  - name: technique" << i << "\n    base color: [0.5, 0.5, 0.5]\n";
+    }
+    sceneStream << "drawable objects:\n  - reference: " << sDrawableObjectsFilePath << "\n";
+
+    std::ostringstream drawableObjectsStream;
+    drawableObjectsStream << "drawable objects:\n";
+    for (std::uint32_t i = 0U; i < drawableObjectCount; ++i) {
+        std::ostringstream& stream = i % 2U == 0U ? sceneStream : drawableObjectsStream;
+        stream << "  - model: model" << i % modelCount << "\n"
+            << "    material technique: technique" << i % materialTechniqueCount << "\n"
+            << "    translation: [" << i % 100U << ".5, 0.0, " << i / 100U << ".25]\n"
+            << "    rotation: [0.0, " << (i % 628U) / 100.0f << ", 0.0]\n"
+            << "    scale: [1.5, 1.5, 1.5]\n"
+            << "    texture scale: 2\n";
+    }
+
+    WriteFile(sSceneFilePath, sceneStream.str());
+    WriteFile(sDrawableObjectsFilePath, drawableObjectsStream.str());
+}
+}
+
+TEST_CASE("Scene cooker")
+{
+    WriteFile(sModelsFilePath,
+              "models:\n"
+              "  sphere: resources/models/sphere.obj\n"
+              "  floor: resources/models/floor.obj\n");
+    WriteFile(sMaterialTechniquesFilePath,
+              "material techniques:\n"
+              "  - name: red\n"
+              "    base color: [1.0, 0.0, 0.0]\n");
+    WriteFile(sDrawableObjectsFilePath,
+              "drawable objects:\n"
+              "  - model: sphere\n"
+              "    material technique: red\n"
+              "    translation: [1.0, 2.0, 3.0]\n");
+    WriteFile(sSceneFilePath,
+              "models:\n"
+              "  reference: test_scene_models.yml\n"
+              "  torus: resources/models/torus.obj\n"
+              "material techniques:\n"
+              "  - reference: test_scene_material_techniques.yml\n"
+              "  - name: green\n"
+              "    base color: [0.0, 1.0, 0.0]\n"
+              "drawable objects:\n"
+              "  - model: torus\n"
+              "    material technique: green\n"
+              "    translation: [10.0, 0.0, 12.0]\n"
+              "    rotation: [3.14, 0.0, 0.0]\n"
+              "    scale: [1, 1, 3]\n"
+              "  - reference: test_scene_drawable_objects.yml\n"
+              "  - model: torus\n"
+              "    texture scale: 8\n"
+              "  - reference: test_scene_drawable_objects.yml\n"
+              "camera:\n"
+              "  - position: [0.0, 1.0, -5.0]\n");
+
+    std::vector<std::uint8_t> compiledSceneData;
+    SceneCooker::CookScene(sSceneFilePath, compiledSceneData);
+    WriteCompiledSceneFile(compiledSceneData);
+
+    CompiledScene compiledScene;
+
+    SECTION("Drawable objects are flat records with interned names")
+    {
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath));
+
+        // "reference" files are included each time
+        REQUIRE(compiledScene.GetDrawableCount() == 4U);
+        REQUIRE(compiledScene.GetModelCount() == 2U);
+        REQUIRE(std::string(compiledScene.GetModelName(0U)) == "torus");
+        REQUIRE(std::string(compiledScene.GetModelName(1U)) == "sphere");
+        REQUIRE(compiledScene.GetMaterialTechniqueCount() == 2U);
+        REQUIRE(std::string(compiledScene.GetMaterialTechniqueName(0U)) == "green");
+        REQUIRE(std::string(compiledScene.GetMaterialTechniqueName(1U)) == "red");
+
+        const CompiledScene::Drawable* drawables = compiledScene.GetDrawables();
+        XMFLOAT4X4 worldMatrix;
+        MathUtils::ComputeMatrix(worldMatrix, 10.0f, 0.0f, 12.0f, 1.0f, 1.0f, 3.0f, 3.14f, 0.0f, 0.0f);
+        REQUIRE(drawables[0U].mModelIndex == 0U);
+        REQUIRE(drawables[0U].mMaterialTechniqueIndex == 0U);
+        REQUIRE(drawables[0U].mTextureScale == 1.0f);
+        REQUIRE(AreEqual(drawables[0U].mWorldMatrix, worldMatrix));
+
+        MathUtils::ComputeMatrix(worldMatrix, 1.0f, 2.0f, 3.0f);
+        for (std::uint32_t i = 1U; i < 4U; i += 2U) {
+            REQUIRE(drawables[i].mModelIndex == 1U);
+            REQUIRE(drawables[i].mMaterialTechniqueIndex == 1U);
+            REQUIRE(AreEqual(drawables[i].mWorldMatrix, worldMatrix));
+        }
+
+        REQUIRE(drawables[2U].mModelIndex == 0U);
+        REQUIRE(drawables[2U].mMaterialTechniqueIndex == static_cast<std::uint32_t>(CompiledScene::sDefaultMaterialTechniqueIndex));
+        REQUIRE(drawables[2U].mTextureScale == 8.0f);
+        MathUtils::ComputeMatrix(worldMatrix, 0.0f, 0.0f, 0.0f);
+        REQUIRE(AreEqual(drawables[2U].mWorldMatrix, worldMatrix));
+    }
+
+    SECTION("Assets document includes reference files and has no drawable objects")
+    {
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath));
+
+        const YAML::Node rootNode = YAML::Load(compiledScene.GetAssetsDocument());
+        REQUIRE(rootNode["drawable objects"].IsDefined() == false);
+
+        const YAML::Node modelsNode = rootNode["models"];
+        REQUIRE(modelsNode.size() == 3U);
+        REQUIRE(modelsNode["reference"].IsDefined() == false);
+        REQUIRE(modelsNode["sphere"].as<std::string>() == "resources/models/sphere.obj");
+        REQUIRE(modelsNode["torus"].as<std::string>() == "resources/models/torus.obj");
+
+        const YAML::Node materialTechniquesNode = rootNode["material techniques"];
+        REQUIRE(materialTechniquesNode.size() == 2U);
+        REQUIRE(materialTechniquesNode[0U]["name"].as<std::string>() == "red");
+        REQUIRE(materialTechniquesNode[1U]["name"].as<std::string>() == "green");
+
+        REQUIRE(rootNode["camera"][0U]["position"][1U].as<float>() == 1.0f);
+    }
+
+    SECTION("Drawable objects and other fields in flow style are cooked")
+    {
+        WriteFile(sSceneFilePath,
+                  "drawable objects: [{model: torus, translation: [10.0, 0.0, 12.0], rotation: [3.14, 0, 0], scale: [1, 1, 3]},\n"
+                  "                   {reference: test_scene_drawable_objects.yml}]\n"
+                  "camera: [{position: [0.0, 1.0, -5.0], look vector: [0, 0, 1]}]\n"
+                  "settings: {fullscreen: false, shadows: {resolution: 1024}}\n");
+        SceneCooker::CookScene(sSceneFilePath, compiledSceneData);
+        WriteCompiledSceneFile(compiledSceneData);
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath));
+
+        REQUIRE(compiledScene.GetDrawableCount() == 2U);
+        REQUIRE(std::string(compiledScene.GetModelName(0U)) == "torus");
+        REQUIRE(std::string(compiledScene.GetModelName(1U)) == "sphere");
+
+        const CompiledScene::Drawable* drawables = compiledScene.GetDrawables();
+        XMFLOAT4X4 worldMatrix;
+        MathUtils::ComputeMatrix(worldMatrix, 10.0f, 0.0f, 12.0f, 1.0f, 1.0f, 3.0f, 3.14f, 0.0f, 0.0f);
+        REQUIRE(AreEqual(drawables[0U].mWorldMatrix, worldMatrix));
+        MathUtils::ComputeMatrix(worldMatrix, 1.0f, 2.0f, 3.0f);
+        REQUIRE(AreEqual(drawables[1U].mWorldMatrix, worldMatrix));
+
+        const YAML::Node rootNode = YAML::Load(compiledScene.GetAssetsDocument());
+        REQUIRE(rootNode["drawable objects"].IsDefined() == false);
+        REQUIRE(rootNode["camera"][0U]["look vector"][2U].as<float>() == 1.0f);
+        REQUIRE(rootNode["settings"]["fullscreen"].as<bool>() == false);
+        REQUIRE(rootNode["settings"]["shadows"]["resolution"].as<std::uint32_t>() == 1024U);
+    }
+
+    SECTION("Instance arrays are cooked as placement parameters")
+    {
+        WriteFile(sDrawableObjectsFilePath,
+                  "drawable objects:\n"
+                  "  - instance array: {model: sphere, placement: path, count: 8, path: [[0, 0, 0], [0, 0, 7]]}\n");
+        WriteFile(sSceneFilePath,
+                  "drawable objects:\n"
+                  "  - model: torus\n"
+                  "  - instance array:\n"
+                  "      model: sphere\n"
+                  "      material techniques: [red, green]\n"
+                  "      placement: grid\n"
+                  "      count: [100, 2, 50]\n"
+                  "      spacing: [2.0, 3.0, 4.0]\n"
+                  "      rotation range: [0.0, 6.28, 0.0]\n"
+                  "      scale range: [0.5, 1.5]\n"
+                  "      texture scale: 2\n"
+                  "  - instance array:\n"
+                  "      model: torus\n"
+                  "      placement: random\n"
+                  "      count: 1000\n"
+                  "      seed: 7\n"
+                  "      volume min: [-10.0, 0.0, -10.0]\n"
+                  "      volume max: [10.0, 1.0, 10.0]\n"
+                  "  - reference: test_scene_drawable_objects.yml\n");
+        SceneCooker::CookScene(sSceneFilePath, compiledSceneData);
+        WriteCompiledSceneFile(compiledSceneData);
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath));
+
+        // Instances are not expanded
+        REQUIRE(compiledScene.GetDrawableCount() == 1U);
+        REQUIRE(compiledScene.GetInstanceArrayCount() == 3U);
+        REQUIRE(compiledSceneData.size() < 4096U);
+
+        const CompiledScene::InstanceArray* instanceArrays = compiledScene.GetInstanceArrays();
+        const CompiledScene::InstanceArray& gridInstanceArray = instanceArrays[0U];
+        REQUIRE(std::string(compiledScene.GetModelName(gridInstanceArray.mModelIndex)) == "sphere");
+        REQUIRE(gridInstanceArray.mPlacement == CompiledScene::GRID);
+        REQUIRE(gridInstanceArray.mCounts[0U] == 100U);
+        REQUIRE(gridInstanceArray.mCounts[1U] == 2U);
+        REQUIRE(gridInstanceArray.mCounts[2U] == 50U);
+        REQUIRE(gridInstanceArray.mSpacing[2U] == 4.0f);
+        REQUIRE(gridInstanceArray.mRotationRange[1U] == 6.28f);
+        REQUIRE(gridInstanceArray.mScaleRange[0U] == 0.5f);
+        REQUIRE(gridInstanceArray.mScaleRange[1U] == 1.5f);
+        REQUIRE(gridInstanceArray.mTextureScale == 2.0f);
+        REQUIRE(gridInstanceArray.mMaterialTechniqueCount == 2U);
+        const std::uint32_t* materialTechniques = compiledScene.GetInstanceArrayMaterialTechniques();
+        REQUIRE(std::string(compiledScene.GetMaterialTechniqueName(materialTechniques[gridInstanceArray.mFirstMaterialTechnique])) == "red");
+        REQUIRE(std::string(compiledScene.GetMaterialTechniqueName(materialTechniques[gridInstanceArray.mFirstMaterialTechnique + 1U])) == "green");
+
+        const CompiledScene::InstanceArray& randomInstanceArray = instanceArrays[1U];
+        REQUIRE(std::string(compiledScene.GetModelName(randomInstanceArray.mModelIndex)) == "torus");
+        REQUIRE(randomInstanceArray.mPlacement == CompiledScene::RANDOM);
+        REQUIRE(randomInstanceArray.mCounts[0U] == 1000U);
+        REQUIRE(randomInstanceArray.mSeed == 7U);
+        REQUIRE(randomInstanceArray.mVolumeMin[0U] == -10.0f);
+        REQUIRE(randomInstanceArray.mVolumeMax[1U] == 1.0f);
+        REQUIRE(randomInstanceArray.mMaterialTechniqueCount == 0U);
+
+        // Instance arrays of "reference" files are included too
+        const CompiledScene::InstanceArray& pathInstanceArray = instanceArrays[2U];
+        REQUIRE(pathInstanceArray.mPlacement == CompiledScene::PATH);
+        REQUIRE(pathInstanceArray.mCounts[0U] == 8U);
+        REQUIRE(pathInstanceArray.mPathPointCount == 2U);
+        REQUIRE(compiledScene.GetPathPoints()[pathInstanceArray.mFirstPathPoint + 1U].z == 7.0f);
+
+        // Model index out of range
+        const CompiledScene::FileHeader* fileHeader = reinterpret_cast<const CompiledScene::FileHeader*>(compiledSceneData.data());
+        std::vector<std::uint8_t> invalidData = compiledSceneData;
+        CompiledScene::InstanceArray* invalidInstanceArrays =
+            reinterpret_cast<CompiledScene::InstanceArray*>(invalidData.data() + fileHeader->mInstanceArraysOffset);
+        invalidInstanceArrays[0U].mModelIndex = fileHeader->mModelCount;
+        WriteCompiledSceneFile(invalidData);
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath) == false);
+
+        // Number of instances does not fit in 32 bits
+        invalidData = compiledSceneData;
+        invalidInstanceArrays = reinterpret_cast<CompiledScene::InstanceArray*>(invalidData.data() + fileHeader->mInstanceArraysOffset);
+        invalidInstanceArrays[0U].mCounts[1U] = 0x1000000U;
+        WriteCompiledSceneFile(invalidData);
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath) == false);
+    }
+
+    SECTION("Modified reference files are detected")
+    {
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath));
+        REQUIRE(compiledScene.AreDependenciesUpToDate());
+
+        WriteFile(sDrawableObjectsFilePath,
+                  "drawable objects:\n"
+                  "  - model: sphere\n");
+        REQUIRE(compiledScene.AreDependenciesUpToDate() == false);
+    }
+
+    SECTION("Compiled scene files are cooked once")
+    {
+        const std::string compiledSceneFilePath = SceneCooker::CookSceneFile(sSceneFilePath);
+        REQUIRE(SceneCooker::CookSceneFile(sSceneFilePath) == compiledSceneFilePath);
+        REQUIRE(compiledScene.Open(compiledSceneFilePath.c_str()));
+        REQUIRE(compiledScene.GetDrawableCount() == 4U);
+        compiledScene.Close();
+
+        // The scene file is not modified, but a reference file is.
+        WriteFile(sDrawableObjectsFilePath,
+                  "drawable objects:\n"
+                  "  - model: floor\n"
+                  "  - model: floor\n");
+        REQUIRE(SceneCooker::CookSceneFile(sSceneFilePath) == compiledSceneFilePath);
+        REQUIRE(compiledScene.Open(compiledSceneFilePath.c_str()));
+        REQUIRE(compiledScene.GetDrawableCount() == 6U);
+        REQUIRE(std::string(compiledScene.GetModelName(1U)) == "floor");
+        compiledScene.Close();
+
+        std::remove(compiledSceneFilePath.c_str());
+    }
+
+    SECTION("Invalid compiled scene files are not opened")
+    {
+        // Truncated
+        std::vector<std::uint8_t> invalidData(compiledSceneData.begin(), compiledSceneData.end() - 1);
+        WriteCompiledSceneFile(invalidData);
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath) == false);
+
+        // Other version
+        invalidData = compiledSceneData;
+        CompiledScene::FileHeader* fileHeader = reinterpret_cast<CompiledScene::FileHeader*>(invalidData.data());
+        ++fileHeader->mVersion;
+        WriteCompiledSceneFile(invalidData);
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath) == false);
+
+        // Model index out of range
+        invalidData = compiledSceneData;
+        fileHeader = reinterpret_cast<CompiledScene::FileHeader*>(invalidData.data());
+        CompiledScene::Drawable* drawables = reinterpret_cast<CompiledScene::Drawable*>(invalidData.data() + fileHeader->mDrawablesOffset);
+        drawables[1U].mModelIndex = fileHeader->mModelCount;
+        WriteCompiledSceneFile(invalidData);
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath) == false);
+
+        // String out of the string data
+        invalidData = compiledSceneData;
+        fileHeader = reinterpret_cast<CompiledScene::FileHeader*>(invalidData.data());
+        CompiledScene::StringEntry* stringEntries = reinterpret_cast<CompiledScene::StringEntry*>(invalidData.data() + fileHeader->mStringEntriesOffset);
+        stringEntries[0U].mLength = static_cast<std::uint32_t>(fileHeader->mStringDataSize);
+        WriteCompiledSceneFile(invalidData);
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath) == false);
+
+        WriteCompiledSceneFile(compiledSceneData);
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath));
+    }
+
+    compiledScene.Close();
+    std::remove(sSceneFilePath);
+    std::remove(sModelsFilePath);
+    std::remove(sMaterialTechniquesFilePath);
+    std::remove(sDrawableObjectsFilePath);
+    std::remove(sCompiledSceneFilePath);
+}
+
+// It must be run explicitly: UnitTests.exe [benchmark]
+TEST_CASE("Scene load times", "[.][benchmark]")
+{
+    const std::uint32_t drawableObjectCounts[]{ 1000U, 10000U, 50000U };
+    for (const std::uint32_t drawableObjectCount : drawableObjectCounts) {
+        WriteLargeScene(drawableObjectCount);
+
+        // YAML scenes are parsed, and every drawable object field is converted.
+        // Cooking adds the compiled scene serialization, that is a small part of it.
+        auto startTime = std::chrono::high_resolution_clock::now();
+        std::vector<std::uint8_t> compiledSceneData;
+        SceneCooker::CookScene(sSceneFilePath, compiledSceneData);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        const double yamlTimeInMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        WriteCompiledSceneFile(compiledSceneData);
+
+        // Compiled scenes are mapped and validated, the assets document is parsed,
+        // and every drawable object is read.
+        startTime = std::chrono::high_resolution_clock::now();
+        CompiledScene compiledScene;
+        REQUIRE(compiledScene.Open(sCompiledSceneFilePath));
+        const YAML::Node rootNode = YAML::Load(compiledScene.GetAssetsDocument());
+        REQUIRE(rootNode["models"].size() == 16U);
+        float translationSum{ 0.0f };
+        for (std::uint32_t i = 0U; i < compiledScene.GetDrawableCount(); ++i) {
+            translationSum += compiledScene.GetDrawables()[i].mWorldMatrix._41;
+        }
+        endTime = std::chrono::high_resolution_clock::now();
+        const double compiledTimeInMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        REQUIRE(compiledScene.GetDrawableCount() == drawableObjectCount);
+        REQUIRE(translationSum > 0.0f);
+
+        BRE::MemoryMappedFile sceneFile;
+        REQUIRE(sceneFile.Open(sSceneFilePath));
+        std::size_t sceneFilesSize = sceneFile.GetSize();
+        REQUIRE(sceneFile.Open(sDrawableObjectsFilePath));
+        sceneFilesSize += sceneFile.GetSize();
+        sceneFile.Close();
+        compiledScene.Close();
+
+        WARN(drawableObjectCount << " drawable objects: YAML " << yamlTimeInMs << " ms (" <<
+             sceneFilesSize << " bytes), compiled " << compiledTimeInMs << " ms (" <<
+             compiledSceneData.size() << " bytes), " << yamlTimeInMs / compiledTimeInMs << "x faster");
+    }
+
+    std::remove(sSceneFilePath);
+    std::remove(sDrawableObjectsFilePath);
+    std::remove(sCompiledSceneFilePath);
+}
+
+namespace {
+///
+/// @brief Counts drawable objects of a node tree, converting their fields like the node based loaders.
+/// @param drawableObjectsNode Drawable objects node
+/// @param translationSum Sum of the translations, so the conversions are not optimized out.
+/// @return Number of drawable objects
+///
+std::uint32_t
+CountDrawableObjectNodes(const YAML::Node& drawableObjectsNode,
+                         float& translationSum)
+{
+    std::uint32_t drawableObjectCount{ 0U };
+    std::string fieldName;
+    std::string name;
+    float vector[3U];
+    for (YAML::const_iterator seqIt = drawableObjectsNode.begin(); seqIt != drawableObjectsNode.end(); ++seqIt) {
+        const YAML::Node drawableObjectMap = *seqIt;
+        YAML::const_iterator mapIt = drawableObjectMap.begin();
+        if (mapIt->first.as<std::string>() == "reference") {
+            const YAML::Node referenceRootNode = YAML::LoadFile(mapIt->second.as<std::string>());
+            drawableObjectCount += CountDrawableObjectNodes(referenceRootNode["drawable objects"], translationSum);
+            continue;
+        }
+
+        for (; mapIt != drawableObjectMap.end(); ++mapIt) {
+            fieldName = mapIt->first.as<std::string>();
+            if (fieldName == "model" || fieldName == "material technique") {
+                name = mapIt->second.as<std::string>();
+            } else if (fieldName == "texture scale") {
+                vector[0U] = mapIt->second.as<float>();
+            } else {
+                for (std::size_t i = 0UL; i < 3UL; ++i) {
+                    vector[i] = mapIt->second[i].as<float>();
+                }
+                translationSum += fieldName == "translation" ? vector[0U] : 0.0f;
+            }
+        }
+        ++drawableObjectCount;
+    }
+
+    return drawableObjectCount;
+}
+}
+
+// It must be run explicitly: UnitTests.exe [benchmark]
+// Each section can be run alone to measure its peak memory: UnitTests.exe "Scene parse times" -c "Node tree"
+TEST_CASE("Scene parse times", "[.][benchmark]")
+{
+    const std::uint32_t drawableObjectCount{ 100000U };
+    WriteLargeScene(drawableObjectCount);
+
+    SECTION("Node tree")
+    {
+        // Node trees of the whole files are built, and every drawable object field is converted by streams.
+        const auto startTime = std::chrono::high_resolution_clock::now();
+        const YAML::Node rootNode = YAML::LoadFile(sSceneFilePath);
+        float translationSum{ 0.0f };
+        REQUIRE(CountDrawableObjectNodes(rootNode["drawable objects"], translationSum) == drawableObjectCount);
+        const auto endTime = std::chrono::high_resolution_clock::now();
+        REQUIRE(translationSum > 0.0f);
+
+        const double timeInMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        WARN(drawableObjectCount << " drawable objects: node tree " << timeInMs << " ms");
+    }
+
+    SECTION("Event parser")
+    {
+        // Drawable objects are cooked while they are parsed.
+        const auto startTime = std::chrono::high_resolution_clock::now();
+        std::vector<std::uint8_t> compiledSceneData;
+        SceneCooker::CookScene(sSceneFilePath, compiledSceneData);
+        const auto endTime = std::chrono::high_resolution_clock::now();
+        REQUIRE(reinterpret_cast<const CompiledScene::FileHeader*>(compiledSceneData.data())->mDrawableCount == drawableObjectCount);
+
+        const double timeInMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        WARN(drawableObjectCount << " drawable objects: event parser " << timeInMs << " ms");
+    }
+
+    std::remove(sSceneFilePath);
+    std::remove(sDrawableObjectsFilePath);
+}
+
+namespace {
+///
+/// @brief Get the file paths of a "models" or "textures" map, following "reference" files.
+/// @param fieldName Field name of the map
+/// @param mapNode Map node
+/// @param filePaths Output file paths
+///
+void
+GetAssetFilePaths(const char* fieldName,
+                  const YAML::Node& mapNode,
+                  std::set<std::string>& filePaths)
+{
+    for (YAML::const_iterator it = mapNode.begin(); it != mapNode.end(); ++it) {
+        const std::string path = it->second.as<std::string>();
+        if (it->first.as<std::string>() == "reference") {
+            const YAML::Node referenceRootNode = YAML::LoadFile(path);
+            GetAssetFilePaths(fieldName, referenceRootNode[fieldName], filePaths);
+        } else {
+            filePaths.insert(path);
+        }
+    }
+}
+}
+
+// Reports each switch between the bundled material scenes: the time to cook the scene the first time
+// it is visited, the time to open the compiled scene, and the model and texture files that are resident,
+// because the previous scene uses them, or that must be loaded. The assets of the previous scene
+// that the next one does not use are released on switch, so only the previous scene is resident.
+// Asset loads and GPU uploads are not timed, because they need a device.
+// It must be run explicitly, from the Executable directory: UnitTests.exe [benchmark]
+TEST_CASE("Scene switch times", "[.][benchmark]")
+{
+    const char* sceneFilePaths[]{
+        "resources/scenes/brick.yml",
+        "resources/scenes/wood.yml",
+        "resources/scenes/metal.yml",
+        "resources/scenes/brick.yml",
+    };
+
+    std::set<std::string> residentFilePaths;
+    for (const char* sceneFilePath : sceneFilePaths) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        std::vector<std::uint8_t> compiledSceneData;
+        SceneCooker::CookScene(sceneFilePath, compiledSceneData);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        const double cookTimeInMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        startTime = std::chrono::high_resolution_clock::now();
+        CompiledScene compiledScene;
+        REQUIRE(compiledScene.Open(compiledSceneData));
+        const YAML::Node rootNode = YAML::Load(compiledScene.GetAssetsDocument());
+        endTime = std::chrono::high_resolution_clock::now();
+        const double openTimeInMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        std::set<std::string> filePaths;
+        GetAssetFilePaths("models", rootNode["models"], filePaths);
+        GetAssetFilePaths("textures", rootNode["textures"], filePaths);
+        REQUIRE(filePaths.empty() == false);
+
+        std::size_t residentFileCount{ 0UL };
+        std::size_t loadedFileCount{ 0UL };
+        std::size_t loadedFilesSize{ 0UL };
+        std::size_t missingFileCount{ 0UL };
+        BRE::MemoryMappedFile file;
+        for (const std::string& filePath : filePaths) {
+            if (residentFilePaths.find(filePath) != residentFilePaths.end()) {
+                ++residentFileCount;
+            } else if (file.Open(filePath.c_str())) {
+                ++loadedFileCount;
+                loadedFilesSize += file.GetSize();
+            } else {
+                ++loadedFileCount;
+                ++missingFileCount;
+            }
+        }
+        file.Close();
+        residentFilePaths.swap(filePaths);
+
+        WARN(sceneFilePath << ": cook " << cookTimeInMs << " ms, open " << openTimeInMs << " ms, " <<
+             compiledScene.GetDrawableCount() << " drawable objects, " <<
+             residentFileCount << " asset files resident, " << loadedFileCount << " loaded (" <<
+             loadedFilesSize << " bytes, " << missingFileCount << " files not found)");
+        compiledScene.Close();
+    }
+}
@@ -0,0 +1,294 @@
+#include <UnitTests\Catch.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SceneLoader\CompiledScene.h>
+#include <SceneLoader\SceneCooker.h>
+#include <SceneLoader\SceneDiffer.h>
+
+using BRE::CompiledScene;
+using BRE::SceneCooker;
+using BRE::SceneDiffer;
+
+namespace {
+const char* sSceneFilePath{ "test_scene_differ.yml" };
+
+const std::string sAssets{
+    "models:\n"
+    "  sphere: resources/models/sphere.obj\n"
+    "  floor: resources/models/floor.obj\n"
+    "textures:\n"
+    "  bricks: resources/textures/bricks.dds\n"
+    "  bricks normal: resources/textures/bricks_normal.dds\n"
+    "material techniques:\n"
+    "  - name: red\n"
+    "    base color: [1.0, 0.0, 0.0]\n"
+    "  - name: bricks\n"
+    "    base color texture: bricks\n"
+    "    normal texture: bricks normal\n"
+    "environment:\n"
+    "  - sky box texture: bricks\n"
+    "camera:\n"
+    "  - position: [0.0, 1.0, -5.0]\n"
+};
+
+const std::string sDrawableObjects{
+    "drawable objects:\n"
+    "  - model: sphere\n"
+    "    material technique: red\n"
+    "    translation: [1.0, 0.0, 0.0]\n"
+    "  - model: floor\n"
+    "    material technique: bricks\n"
+    "  - model: sphere\n"
+    "    translation: [2.0, 0.0, 0.0]\n"
+    "  - model: sphere\n"
+    "    material technique: bricks\n"
+    "    translation: [3.0, 0.0, 0.0]\n"
+};
+
+///
+/// @brief Cooks a scene YAML document
+/// @param sceneDocument Scene YAML document
+/// @param compiledScene Output compiled scene
+///
+void
+CookScene(const std::string& sceneDocument,
+          CompiledScene& compiledScene)
+{
+    {
+        std::ofstream fileStream{ sSceneFilePath, std::ios::out | std::ios::binary | std::ios::trunc };
+        fileStream.write(sceneDocument.data(), sceneDocument.size());
+    }
+
+    std::vector<std::uint8_t> compiledSceneData;
+    SceneCooker::CookScene(sSceneFilePath, compiledSceneData);
+    REQUIRE(compiledScene.Open(compiledSceneData));
+    REQUIRE(compiledSceneData.empty());
+}
+
+///
+/// @brief Computes the differences between two scene YAML documents
+/// @param oldSceneDocument Old scene YAML document
+/// @param newSceneDocument New scene YAML document
+/// @param sceneDiff Output differences
+///
+void
+ComputeSceneDiff(const std::string& oldSceneDocument,
+                 const std::string& newSceneDocument,
+                 SceneDiffer::SceneDiff& sceneDiff)
+{
+    CompiledScene oldCompiledScene;
+    CompiledScene newCompiledScene;
+    CookScene(oldSceneDocument, oldCompiledScene);
+    CookScene(newSceneDocument, newCompiledScene);
+    SceneDiffer::ComputeSceneDiff(oldCompiledScene, newCompiledScene, sceneDiff);
+}
+
+///
+/// @brief Replaces the first occurrence of a string
+/// @param string String
+/// @param oldSubstring Substring to replace. It must be in the string.
+/// @param newSubstring New substring
+/// @return String with the substring replaced
+///
+std::string
+Replace(std::string string,
+        const std::string& oldSubstring,
+        const std::string& newSubstring)
+{
+    const std::size_t position = string.find(oldSubstring);
+    REQUIRE(position != std::string::npos);
+    return string.replace(position, oldSubstring.size(), newSubstring);
+}
+}
+
+TEST_CASE("Scene differ")
+{
+    SceneDiffer::SceneDiff sceneDiff;
+
+    SECTION("Equal scenes have no differences")
+    {
+        ComputeSceneDiff(sAssets + sDrawableObjects, sAssets + sDrawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.IsEmpty());
+
+        // Equal drawables are unchanged, even if they were moved, and names are compared
+        // instead of their indices.
+        const std::string reorderedDrawableObjects{
+            "drawable objects:\n"
+            "  - model: floor\n"
+            "    material technique: bricks\n"
+            "  - model: sphere\n"
+            "    material technique: bricks\n"
+            "    translation: [3.0, 0.0, 0.0]\n"
+            "  - model: sphere\n"
+            "    material technique: red\n"
+            "    translation: [1.0, 0.0, 0.0]\n"
+            "  - model: sphere\n"
+            "    translation: [2.0, 0.0, 0.0]\n"
+        };
+        ComputeSceneDiff(sAssets + sDrawableObjects, sAssets + reorderedDrawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.IsEmpty());
+    }
+
+    SECTION("Drawables with a new transform or material technique are changed")
+    {
+        std::string drawableObjects = Replace(sDrawableObjects, "[2.0, 0.0, 0.0]", "[2.0, 5.0, 0.0]");
+        drawableObjects = Replace(drawableObjects,
+                                  "    material technique: bricks\n    translation",
+                                  "    material technique: red\n    translation");
+        ComputeSceneDiff(sAssets + sDrawableObjects, sAssets + drawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.mAddedDrawables.empty());
+        REQUIRE(sceneDiff.mRemovedDrawables.empty());
+        REQUIRE(sceneDiff.mChangedDrawables.size() == 2U);
+        REQUIRE(sceneDiff.mChangedDrawables[0U] == std::make_pair(2U, 2U));
+        REQUIRE(sceneDiff.mChangedDrawables[1U] == std::make_pair(3U, 3U));
+        REQUIRE(sceneDiff.mModelChanges.IsEmpty());
+        REQUIRE(sceneDiff.mMaterialTechniqueChanges.IsEmpty());
+        REQUIRE(sceneDiff.mHasCameraChanged == false);
+
+        // Texture scale is a drawable field too
+        drawableObjects = Replace(sDrawableObjects,
+                                  "    material technique: bricks\n  - model: sphere",
+                                  "    material technique: bricks\n    texture scale: 4\n  - model: sphere");
+        ComputeSceneDiff(sAssets + sDrawableObjects, sAssets + drawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.mChangedDrawables.size() == 1U);
+        REQUIRE(sceneDiff.mChangedDrawables[0U] == std::make_pair(1U, 1U));
+    }
+
+    SECTION("Drawables are added and removed")
+    {
+        // A drawable is inserted at the beginning, and the floor is removed,
+        // so the indices of the remaining drawables are different.
+        std::string drawableObjects = Replace(sDrawableObjects,
+                                              "  - model: floor\n    material technique: bricks\n",
+                                              "");
+        drawableObjects = Replace(drawableObjects,
+                                  "drawable objects:\n",
+                                  "drawable objects:\n  - model: floor\n    translation: [0.0, -1.0, 0.0]\n");
+        ComputeSceneDiff(sAssets + sDrawableObjects, sAssets + drawableObjects, sceneDiff);
+
+        // The new floor has the same model than the removed one, so it is changed.
+        REQUIRE(sceneDiff.mAddedDrawables.empty());
+        REQUIRE(sceneDiff.mRemovedDrawables.empty());
+        REQUIRE(sceneDiff.mChangedDrawables.size() == 1U);
+        REQUIRE(sceneDiff.mChangedDrawables[0U] == std::make_pair(1U, 0U));
+
+        // A drawable of another model is added, and not changed
+        drawableObjects = Replace(sDrawableObjects,
+                                  "  - model: floor\n    material technique: bricks\n",
+                                  "  - model: floor\n    material technique: bricks\n  - model: floor\n");
+        ComputeSceneDiff(sAssets + sDrawableObjects, sAssets + drawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.mAddedDrawables == std::vector<std::uint32_t>{ 2U });
+        REQUIRE(sceneDiff.mRemovedDrawables.empty());
+        REQUIRE(sceneDiff.mChangedDrawables.empty());
+
+        // Drawables are removed from the end
+        drawableObjects = Replace(sDrawableObjects,
+                                  "  - model: sphere\n    material technique: bricks\n    translation: [3.0, 0.0, 0.0]\n",
+                                  "");
+        ComputeSceneDiff(sAssets + sDrawableObjects, sAssets + drawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.mAddedDrawables.empty());
+        REQUIRE(sceneDiff.mRemovedDrawables == std::vector<std::uint32_t>{ 3U });
+        REQUIRE(sceneDiff.mChangedDrawables.empty());
+
+        // A drawable whose model changed is removed, and a drawable of the new model is added.
+        drawableObjects = Replace(sDrawableObjects, "  - model: sphere\n    translation", "  - model: floor\n    translation");
+        ComputeSceneDiff(sAssets + sDrawableObjects, sAssets + drawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.mAddedDrawables == std::vector<std::uint32_t>{ 2U });
+        REQUIRE(sceneDiff.mRemovedDrawables == std::vector<std::uint32_t>{ 2U });
+        REQUIRE(sceneDiff.mChangedDrawables.empty());
+    }
+
+    SECTION("Assets are added, removed and changed by name")
+    {
+        std::string assets = Replace(sAssets, "  floor: resources/models/floor.obj\n", "  torus: resources/models/torus.obj\n");
+        assets = Replace(assets, "models/sphere.obj", "models/sphere2.obj");
+        const std::string drawableObjects = Replace(sDrawableObjects, "model: floor", "model: torus");
+        ComputeSceneDiff(sAssets + sDrawableObjects, assets + drawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.mModelChanges.mAddedNames == std::vector<std::string>{ "torus" });
+        REQUIRE(sceneDiff.mModelChanges.mRemovedNames == std::vector<std::string>{ "floor" });
+        REQUIRE(sceneDiff.mModelChanges.mChangedNames == std::vector<std::string>{ "sphere" });
+        REQUIRE(sceneDiff.mTextureChanges.IsEmpty());
+        REQUIRE(sceneDiff.mMaterialTechniqueChanges.IsEmpty());
+        REQUIRE(sceneDiff.mAddedDrawables == std::vector<std::uint32_t>{ 1U });
+        REQUIRE(sceneDiff.mRemovedDrawables == std::vector<std::uint32_t>{ 1U });
+
+        // Material techniques that refer to a changed texture are changed
+        assets = Replace(sAssets, "textures/bricks_normal.dds", "textures/bricks2_normal.dds");
+        assets = Replace(assets, "base color: [1.0, 0.0, 0.0]", "base color: [1.0, 0.5, 0.0]");
+        assets = Replace(assets, "material techniques:\n", "material techniques:\n  - name: blue\n    base color: [0.0, 0.0, 1.0]\n");
+        ComputeSceneDiff(sAssets + sDrawableObjects, assets + sDrawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.mModelChanges.IsEmpty());
+        REQUIRE(sceneDiff.mTextureChanges.mChangedNames == std::vector<std::string>{ "bricks normal" });
+        REQUIRE(sceneDiff.mMaterialTechniqueChanges.mAddedNames == std::vector<std::string>{ "blue" });
+        REQUIRE(sceneDiff.mMaterialTechniqueChanges.mRemovedNames.empty());
+        REQUIRE((sceneDiff.mMaterialTechniqueChanges.mChangedNames == std::vector<std::string>{ "bricks", "red" }));
+        REQUIRE(sceneDiff.mAddedDrawables.empty());
+        REQUIRE(sceneDiff.mRemovedDrawables.empty());
+        REQUIRE(sceneDiff.mChangedDrawables.empty());
+        REQUIRE(sceneDiff.mHasEnvironmentChanged == false);
+    }
+
+    SECTION("Environment, camera and settings changes are detected")
+    {
+        std::string assets = Replace(sAssets, "sky box texture: bricks", "sky box texture: bricks normal");
+        ComputeSceneDiff(sAssets + sDrawableObjects, assets + sDrawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.mHasEnvironmentChanged);
+        REQUIRE(sceneDiff.mHasCameraChanged == false);
+        REQUIRE(sceneDiff.mHaveSettingsChanged == false);
+
+        assets = Replace(sAssets, "[0.0, 1.0, -5.0]", "[0.0, 2.0, -5.0]");
+        ComputeSceneDiff(sAssets + sDrawableObjects, assets + "settings:\n  fullscreen: false\n" + sDrawableObjects, sceneDiff);
+        REQUIRE(sceneDiff.mHasEnvironmentChanged == false);
+        REQUIRE(sceneDiff.mHasCameraChanged);
+        REQUIRE(sceneDiff.mHaveSettingsChanged);
+        REQUIRE(sceneDiff.mAddedDrawables.empty());
+        REQUIRE(sceneDiff.mChangedDrawables.empty());
+    }
+
+    SECTION("Instance arrays are compared by position")
+    {
+        const std::string instanceArrays{
+            "  - instance array:\n"
+            "      model: sphere\n"
+            "      material techniques: [red, bricks]\n"
+            "      placement: grid\n"
+            "      count: [10, 1, 10]\n"
+            "  - instance array:\n"
+            "      model: floor\n"
+            "      placement: path\n"
+            "      count: 20\n"
+            "      path: [[0.0, 0.0, 0.0], [10.0, 0.0, 0.0]]\n"
+        };
+        ComputeSceneDiff(sAssets + sDrawableObjects + instanceArrays, sAssets + sDrawableObjects + instanceArrays, sceneDiff);
+        REQUIRE(sceneDiff.IsEmpty());
+
+        // Path points and material techniques are compared by their values
+        std::string newInstanceArrays = Replace(instanceArrays, "[10.0, 0.0, 0.0]", "[10.0, 0.0, 1.0]");
+        ComputeSceneDiff(sAssets + sDrawableObjects + instanceArrays, sAssets + sDrawableObjects + newInstanceArrays, sceneDiff);
+        REQUIRE(sceneDiff.mChangedInstanceArrays.size() == 1U);
+        REQUIRE(sceneDiff.mChangedInstanceArrays[0U] == std::make_pair(1U, 1U));
+
+        newInstanceArrays = Replace(instanceArrays, "[red, bricks]", "[bricks, red]");
+        ComputeSceneDiff(sAssets + sDrawableObjects + instanceArrays, sAssets + sDrawableObjects + newInstanceArrays, sceneDiff);
+        REQUIRE(sceneDiff.mChangedInstanceArrays.size() == 1U);
+        REQUIRE(sceneDiff.mChangedInstanceArrays[0U] == std::make_pair(0U, 0U));
+        REQUIRE(sceneDiff.mChangedDrawables.empty());
+
+        ComputeSceneDiff(sAssets + sDrawableObjects + instanceArrays, sAssets + sDrawableObjects, sceneDiff);
+        REQUIRE((sceneDiff.mRemovedInstanceArrays == std::vector<std::uint32_t>{ 0U, 1U }));
+        REQUIRE(sceneDiff.mAddedInstanceArrays.empty());
+
+        ComputeSceneDiff(sAssets + sDrawableObjects, sAssets + sDrawableObjects + instanceArrays, sceneDiff);
+        REQUIRE((sceneDiff.mAddedInstanceArrays == std::vector<std::uint32_t>{ 0U, 1U }));
+        REQUIRE(sceneDiff.mRemovedInstanceArrays.empty());
+        REQUIRE(sceneDiff.mChangedInstanceArrays.empty());
+    }
+
+    std::remove(sSceneFilePath);
+}
\ No newline at end of file
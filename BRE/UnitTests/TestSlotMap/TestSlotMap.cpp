@@ -0,0 +1,267 @@
+#include <UnitTests\Catch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <tbb/concurrent_unordered_set.h>
+#include <tbb/parallel_for.h>
+#include <unordered_map>
+#include <vector>
+
+#include <Utils\SlotMap.h>
+
+using BRE::SlotMap;
+
+namespace {
+using IntSlotMap = SlotMap<std::uint32_t>;
+
+///
+/// @brief Get the values of a slot map, sorted, by iterating it
+/// @param slotMap Slot map
+/// @return Sorted values
+///
+std::vector<std::uint32_t>
+GetSortedValues(const IntSlotMap& slotMap) noexcept
+{
+    std::vector<std::uint32_t> values(slotMap.begin(), slotMap.end());
+    std::sort(values.begin(), values.end());
+
+    return values;
+}
+}
+
+TEST_CASE("SlotMap")
+{
+    SECTION("Inserted values are found by their handle")
+    {
+        IntSlotMap slotMap;
+        REQUIRE(slotMap.GetSize() == 0U);
+        REQUIRE(slotMap.begin() == slotMap.end());
+
+        const IntSlotMap::Handle firstHandle = slotMap.Insert(10U);
+        const IntSlotMap::Handle secondHandle = slotMap.Insert(20U);
+        REQUIRE(firstHandle.IsNull() == false);
+        REQUIRE(firstHandle != secondHandle);
+        REQUIRE(slotMap.GetSize() == 2U);
+        REQUIRE(*slotMap.Get(firstHandle) == 10U);
+        REQUIRE(*slotMap.Get(secondHandle) == 20U);
+
+        *slotMap.Get(secondHandle) = 25U;
+        REQUIRE(*slotMap.Get(secondHandle) == 25U);
+
+        const IntSlotMap::Handle nullHandle;
+        REQUIRE(nullHandle.IsNull());
+        REQUIRE(slotMap.Contains(nullHandle) == false);
+        REQUIRE(slotMap.Get(nullHandle) == nullptr);
+    }
+
+    SECTION("Handles of erased values are stale, even if their slot is reused")
+    {
+        IntSlotMap slotMap;
+        const IntSlotMap::Handle firstHandle = slotMap.Insert(10U);
+        const IntSlotMap::Handle secondHandle = slotMap.Insert(20U);
+
+        std::uint32_t erasedValue = 0U;
+        REQUIRE(slotMap.Erase(firstHandle, &erasedValue));
+        REQUIRE(erasedValue == 10U);
+        REQUIRE(slotMap.Contains(firstHandle) == false);
+        REQUIRE(slotMap.Get(firstHandle) == nullptr);
+        REQUIRE(slotMap.Erase(firstHandle) == false);
+        REQUIRE(*slotMap.Get(secondHandle) == 20U);
+
+        const IntSlotMap::Handle thirdHandle = slotMap.Insert(30U);
+        REQUIRE(thirdHandle.mIndex == firstHandle.mIndex);
+        REQUIRE(thirdHandle.mGeneration != firstHandle.mGeneration);
+        REQUIRE(slotMap.Get(firstHandle) == nullptr);
+        REQUIRE(*slotMap.Get(thirdHandle) == 30U);
+        REQUIRE(slotMap.GetSize() == 2U);
+    }
+
+    SECTION("Iteration visits every value that was not erased")
+    {
+        IntSlotMap slotMap;
+        std::vector<IntSlotMap::Handle> handles;
+        for (std::uint32_t i = 0U; i < 100U; ++i) {
+            handles.push_back(slotMap.Insert(i));
+        }
+
+        std::vector<std::uint32_t> expectedValues;
+        for (std::uint32_t i = 0U; i < 100U; ++i) {
+            if (i % 3U == 0U) {
+                REQUIRE(slotMap.Erase(handles[i]));
+            } else {
+                expectedValues.push_back(i);
+            }
+        }
+
+        REQUIRE(slotMap.GetSize() == expectedValues.size());
+        REQUIRE(GetSortedValues(slotMap) == expectedValues);
+
+        // Handles of moved values are still valid
+        for (std::uint32_t i = 0U; i < 100U; ++i) {
+            if (i % 3U != 0U) {
+                REQUIRE(*slotMap.Get(handles[i]) == i);
+            }
+        }
+
+        // Handles by position refer to the iterated values
+        std::uint32_t position = 0U;
+        for (const std::uint32_t value : slotMap) {
+            REQUIRE(*slotMap.Get(slotMap.GetHandle(position)) == value);
+            ++position;
+        }
+    }
+
+    SECTION("Clear makes every handle stale")
+    {
+        IntSlotMap slotMap;
+        std::vector<IntSlotMap::Handle> handles;
+        for (std::uint32_t i = 0U; i < 10U; ++i) {
+            handles.push_back(slotMap.Insert(i));
+        }
+
+        slotMap.Clear();
+        REQUIRE(slotMap.GetSize() == 0U);
+        REQUIRE(slotMap.begin() == slotMap.end());
+        for (const IntSlotMap::Handle& handle : handles) {
+            REQUIRE(slotMap.Contains(handle) == false);
+        }
+
+        const IntSlotMap::Handle handle = slotMap.Insert(42U);
+        REQUIRE(*slotMap.Get(handle) == 42U);
+        REQUIRE(slotMap.GetSize() == 1U);
+    }
+
+    SECTION("Erased values are released")
+    {
+        SlotMap<std::shared_ptr<std::uint32_t>> slotMap;
+        const std::shared_ptr<std::uint32_t> value = std::make_shared<std::uint32_t>(1U);
+        const SlotMap<std::shared_ptr<std::uint32_t>>::Handle firstHandle = slotMap.Insert(value);
+        const SlotMap<std::shared_ptr<std::uint32_t>>::Handle secondHandle = slotMap.Insert(value);
+        REQUIRE(value.use_count() == 3L);
+
+        REQUIRE(slotMap.Erase(firstHandle));
+        REQUIRE(value.use_count() == 2L);
+        REQUIRE(slotMap.Erase(secondHandle));
+        REQUIRE(value.use_count() == 1L);
+    }
+
+    SECTION("Values can be inserted from several threads at the same time")
+    {
+        const std::uint32_t valueCount = 100000U;
+        IntSlotMap slotMap;
+        std::vector<IntSlotMap::Handle> handles(valueCount);
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, valueCount, 64U),
+                          [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i != r.end(); ++i) {
+                handles[i] = slotMap.Insert(static_cast<std::uint32_t>(i));
+            }
+        }
+        );
+
+        REQUIRE(slotMap.GetSize() == valueCount);
+        std::vector<bool> isSlotUsed(valueCount, false);
+        for (std::uint32_t i = 0U; i < valueCount; ++i) {
+            REQUIRE(*slotMap.Get(handles[i]) == i);
+            REQUIRE(handles[i].mIndex < valueCount);
+            REQUIRE(isSlotUsed[handles[i].mIndex] == false);
+            isSlotUsed[handles[i].mIndex] = true;
+        }
+    }
+}
+
+// Slot map operations are benchmarked against the previous registries
+TEST_CASE("SlotMap operation times", "[.][benchmark]")
+{
+    const std::uint32_t valueCount = 100000U;
+    std::vector<std::uint32_t> lookupOrder(valueCount);
+    for (std::uint32_t i = 0U; i < valueCount; ++i) {
+        lookupOrder[i] = i;
+    }
+    std::shuffle(lookupOrder.begin(), lookupOrder.end(), std::mt19937(7U));
+
+    // Slot map
+    IntSlotMap slotMap;
+    std::vector<IntSlotMap::Handle> handles(valueCount);
+    const auto slotMapInsertStartTime = std::chrono::high_resolution_clock::now();
+    for (std::uint32_t i = 0U; i < valueCount; ++i) {
+        handles[i] = slotMap.Insert(i);
+    }
+    const auto slotMapInsertEndTime = std::chrono::high_resolution_clock::now();
+
+    std::uint64_t slotMapLookupSum = 0UL;
+    for (const std::uint32_t i : lookupOrder) {
+        slotMapLookupSum += *slotMap.Get(handles[i]);
+    }
+    const auto slotMapLookupEndTime = std::chrono::high_resolution_clock::now();
+
+    std::uint64_t slotMapIterationSum = 0UL;
+    for (std::uint32_t round = 0U; round < 10U; ++round) {
+        for (const std::uint32_t value : slotMap) {
+            slotMapIterationSum += value;
+        }
+    }
+    const auto slotMapIterationEndTime = std::chrono::high_resolution_clock::now();
+
+    for (const std::uint32_t i : lookupOrder) {
+        slotMap.Erase(handles[i]);
+    }
+    const auto slotMapEraseEndTime = std::chrono::high_resolution_clock::now();
+
+    // Registries used tbb::concurrent_unordered_set, which can only be iterated,
+    // and its erasure is not thread safe. Lookups are compared against std::unordered_map.
+    tbb::concurrent_unordered_set<std::uint32_t> concurrentSet;
+    const auto setInsertStartTime = std::chrono::high_resolution_clock::now();
+    for (std::uint32_t i = 0U; i < valueCount; ++i) {
+        concurrentSet.insert(i);
+    }
+    const auto setInsertEndTime = std::chrono::high_resolution_clock::now();
+
+    std::uint64_t setIterationSum = 0UL;
+    for (std::uint32_t round = 0U; round < 10U; ++round) {
+        for (const std::uint32_t value : concurrentSet) {
+            setIterationSum += value;
+        }
+    }
+    const auto setIterationEndTime = std::chrono::high_resolution_clock::now();
+
+    for (const std::uint32_t i : lookupOrder) {
+        concurrentSet.unsafe_erase(i);
+    }
+    const auto setEraseEndTime = std::chrono::high_resolution_clock::now();
+
+    // Keys are random, like the identifiers a map would be keyed by
+    std::mt19937_64 randomGenerator(7U);
+    std::vector<std::uint64_t> keys(valueCount);
+    std::unordered_map<std::uint64_t, std::uint32_t> map;
+    for (std::uint32_t i = 0U; i < valueCount; ++i) {
+        keys[i] = randomGenerator();
+        map.emplace(keys[i], i);
+    }
+    const auto mapLookupStartTime = std::chrono::high_resolution_clock::now();
+    std::uint64_t mapLookupSum = 0UL;
+    for (const std::uint32_t i : lookupOrder) {
+        mapLookupSum += map.find(keys[i])->second;
+    }
+    const auto mapLookupEndTime = std::chrono::high_resolution_clock::now();
+
+    REQUIRE(slotMap.GetSize() == 0U);
+    REQUIRE(concurrentSet.empty());
+    REQUIRE(slotMapLookupSum == mapLookupSum);
+    REQUIRE(slotMapIterationSum == setIterationSum);
+
+    const auto toMs = [](const std::chrono::high_resolution_clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    WARN(valueCount << " values, slot map: insert " << toMs(slotMapInsertEndTime - slotMapInsertStartTime) <<
+         " ms, lookup " << toMs(slotMapLookupEndTime - slotMapInsertEndTime) <<
+         " ms, 10 iterations " << toMs(slotMapIterationEndTime - slotMapLookupEndTime) <<
+         " ms, erase " << toMs(slotMapEraseEndTime - slotMapIterationEndTime) << " ms");
+    WARN(valueCount << " values, tbb::concurrent_unordered_set: insert " <<
+         toMs(setInsertEndTime - setInsertStartTime) <<
+         " ms, 10 iterations " << toMs(setIterationEndTime - setInsertEndTime) <<
+         " ms, erase " << toMs(setEraseEndTime - setIterationEndTime) << " ms");
+    WARN(valueCount << " values, std::unordered_map: lookup " << toMs(mapLookupEndTime - mapLookupStartTime) << " ms");
+}
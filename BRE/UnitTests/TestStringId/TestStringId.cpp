@@ -0,0 +1,146 @@
+#include <UnitTests\Catch.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Utils\StringId.h>
+
+using BRE::StringId;
+using BRE::StringIdMap;
+using BRE::StringIdTable;
+
+namespace {
+// Identifiers must be usable as constant expressions
+static_assert(StringIdTable::ComputeStringId("") == 0xcbf29ce484222325ULL,
+              "Empty string identifier must be the offset basis");
+static_assert(StringIdTable::ComputeStringId("a") == 0xaf63dc4c8601ec8cULL,
+              "String identifier must be the 64-bit FNV-1a hash");
+
+///
+/// @brief Creates names like the asset names of a big scene. They are longer than
+/// the small string buffer of std::string, so building a std::string from them allocates.
+/// @param nameCount Number of names
+/// @param names Output names
+///
+void
+CreateNames(const std::uint32_t nameCount,
+            std::vector<std::string>& names) noexcept
+{
+    names.clear();
+    names.reserve(nameCount);
+    for (std::uint32_t i = 0U; i < nameCount; ++i) {
+        names.push_back("scene_asset_name_" + std::to_string(i));
+    }
+}
+}
+
+TEST_CASE("StringId")
+{
+    SECTION("Run time identifiers are the same than compile time identifiers")
+    {
+        REQUIRE(StringIdTable::GetStringId("") == StringIdTable::ComputeStringId(""));
+        REQUIRE(StringIdTable::GetStringId("foobar") == 0x85944171f73967e8ULL);
+        REQUIRE(StringIdTable::GetStringId("foobar") == StringIdTable::ComputeStringId("foobar"));
+        REQUIRE(StringIdTable::GetStringId(std::string("base color texture")) ==
+                StringIdTable::ComputeStringId("base color texture"));
+        REQUIRE(StringIdTable::GetStringId("metalness") != StringIdTable::GetStringId("metalness texture"));
+
+        // Characters are hashed as unsigned
+        REQUIRE(StringIdTable::GetStringId("\xe9t\xe9") == StringIdTable::ComputeStringId("\xe9t\xe9"));
+        REQUIRE(StringIdTable::GetStringId(std::string("\xe9t\xe9")) == StringIdTable::ComputeStringId("\xe9t\xe9"));
+    }
+
+    SECTION("Interned strings are found by their identifier")
+    {
+        const StringId stringId = StringIdTable::Intern("interned model name");
+        REQUIRE(stringId == StringIdTable::GetStringId("interned model name"));
+        REQUIRE(StringIdTable::Intern("interned model name") == stringId);
+        REQUIRE(StringIdTable::GetString(stringId) == "interned model name");
+
+        const StringId emptyStringId = StringIdTable::Intern("");
+        REQUIRE(StringIdTable::GetString(emptyStringId).empty());
+
+        const StringId notInternedStringId = StringIdTable::GetStringId("not interned model name");
+        REQUIRE(StringIdTable::GetString(notInternedStringId) == std::to_string(notInternedStringId));
+    }
+
+    SECTION("Identifiers of many names are unique")
+    {
+        std::vector<std::string> names;
+        CreateNames(100000U, names);
+
+        StringIdMap<std::uint32_t> indexById;
+        for (std::uint32_t i = 0U; i < names.size(); ++i) {
+            REQUIRE(indexById.emplace(StringIdTable::Intern(names[i]), i).second);
+        }
+    }
+}
+
+// Lookups by identifier are benchmarked against lookups by name
+TEST_CASE("StringId lookup times", "[.][benchmark]")
+{
+    const std::uint32_t nameCount = 10000U;
+    const std::uint32_t lookupRoundCount = 100U;
+    std::vector<std::string> names;
+    CreateNames(nameCount, names);
+
+    std::unordered_map<std::string, std::uint32_t> indexByName;
+    StringIdMap<std::uint32_t> indexById;
+    for (std::uint32_t i = 0U; i < nameCount; ++i) {
+        indexByName.emplace(names[i], i);
+        indexById.emplace(StringIdTable::Intern(names[i]), i);
+    }
+
+    // Names come from the compiled scene as null terminated strings,
+    // so lookups by name build a std::string (an allocation) for each lookup.
+    std::uint64_t nameIndexSum = 0UL;
+    const auto nameStartTime = std::chrono::high_resolution_clock::now();
+    for (std::uint32_t round = 0U; round < lookupRoundCount; ++round) {
+        for (const std::string& name : names) {
+            nameIndexSum += indexByName.find(name.c_str())->second;
+        }
+    }
+    const auto nameEndTime = std::chrono::high_resolution_clock::now();
+
+    std::uint64_t idIndexSum = 0UL;
+    const auto idStartTime = std::chrono::high_resolution_clock::now();
+    for (std::uint32_t round = 0U; round < lookupRoundCount; ++round) {
+        for (const std::string& name : names) {
+            idIndexSum += indexById.find(StringIdTable::GetStringId(name.c_str()))->second;
+        }
+    }
+    const auto idEndTime = std::chrono::high_resolution_clock::now();
+
+    // Identifiers of names known in code are not even hashed at run time
+    std::uint64_t constantIdIndexSum = 0UL;
+    indexById.emplace(StringIdTable::ComputeStringId("constant asset name"), 1U);
+    indexByName.emplace("constant asset name", 1U);
+    const auto constantNameStartTime = std::chrono::high_resolution_clock::now();
+    for (std::uint32_t i = 0U; i < nameCount * lookupRoundCount; ++i) {
+        constantIdIndexSum += indexByName.find("constant asset name")->second;
+    }
+    const auto constantNameEndTime = std::chrono::high_resolution_clock::now();
+    const auto constantIdStartTime = std::chrono::high_resolution_clock::now();
+    for (std::uint32_t i = 0U; i < nameCount * lookupRoundCount; ++i) {
+        constantIdIndexSum += indexById.find(StringIdTable::ComputeStringId("constant asset name"))->second;
+    }
+    const auto constantIdEndTime = std::chrono::high_resolution_clock::now();
+
+    REQUIRE(nameIndexSum == idIndexSum);
+    REQUIRE(constantIdIndexSum == 2UL * nameCount * lookupRoundCount);
+
+    const std::uint32_t lookupCount = nameCount * lookupRoundCount;
+    const double nameTimeInMs = std::chrono::duration<double, std::milli>(nameEndTime - nameStartTime).count();
+    const double idTimeInMs = std::chrono::duration<double, std::milli>(idEndTime - idStartTime).count();
+    const double constantNameTimeInMs =
+        std::chrono::duration<double, std::milli>(constantNameEndTime - constantNameStartTime).count();
+    const double constantIdTimeInMs =
+        std::chrono::duration<double, std::milli>(constantIdEndTime - constantIdStartTime).count();
+    WARN(lookupCount << " lookups: by name " << nameTimeInMs << " ms (" << lookupCount << " string allocations), " <<
+         "by identifier " << idTimeInMs << " ms (0 string allocations)");
+    WARN(lookupCount << " lookups of a name known in code: by name " << constantNameTimeInMs << " ms, " <<
+         "by compile time identifier " << constantIdTimeInMs << " ms");
+}
@@ -0,0 +1,179 @@
+#include <UnitTests\Catch.h>
+
+#include <vector>
+
+#include <ResourceManager\TextureStreamingScheduler.h>
+
+using BRE::TextureStreamingScheduler;
+
+namespace {
+///
+/// @brief Get mip level sizes of a square RGBA8 texture
+/// @param size Size of mip level 0
+/// @param mipLevelCount Number of mip levels
+/// @return Size in bytes of each mip level
+///
+std::vector<std::uint64_t>
+GetMipLevelSizes(const std::uint32_t size,
+                 const std::uint32_t mipLevelCount)
+{
+    std::vector<std::uint64_t> mipLevelSizes;
+    for (std::uint32_t i = 0U; i < mipLevelCount; ++i) {
+        const std::uint64_t mipLevelSize = size >> i;
+        mipLevelSizes.push_back(mipLevelSize * mipLevelSize * 4UL);
+    }
+
+    return mipLevelSizes;
+}
+}
+
+TEST_CASE("ComputeRequiredMipLevel")
+{
+    // 1024 texels and 11 mip levels
+    REQUIRE(TextureStreamingScheduler::ComputeRequiredMipLevel(1024U, 11U, 0.0f) == 10U);
+    REQUIRE(TextureStreamingScheduler::ComputeRequiredMipLevel(1024U, 11U, 2048.0f) == 0U);
+    REQUIRE(TextureStreamingScheduler::ComputeRequiredMipLevel(1024U, 11U, 1024.0f) == 0U);
+    REQUIRE(TextureStreamingScheduler::ComputeRequiredMipLevel(1024U, 11U, 512.0f) == 1U);
+    REQUIRE(TextureStreamingScheduler::ComputeRequiredMipLevel(1024U, 11U, 300.0f) == 1U);
+    REQUIRE(TextureStreamingScheduler::ComputeRequiredMipLevel(1024U, 11U, 1.0f) == 10U);
+    REQUIRE(TextureStreamingScheduler::ComputeRequiredMipLevel(1024U, 11U, 0.01f) == 10U);
+}
+
+TEST_CASE("TextureStreamingScheduler")
+{
+    TextureStreamingScheduler scheduler;
+
+    // Mip level 6 is 16x16
+    const std::uint32_t textureA = scheduler.AddTexture(1024U, GetMipLevelSizes(1024U, 11U), 6U);
+    const std::uint32_t textureB = scheduler.AddTexture(1024U, GetMipLevelSizes(1024U, 11U), 6U);
+    REQUIRE(scheduler.GetTextureCount() == 2U);
+
+    std::vector<TextureStreamingScheduler::MipLevelRequest> requests;
+
+    SECTION("Textures not on screen are not streamed")
+    {
+        scheduler.ScheduleRequests(1024UL * 1024UL, requests);
+        REQUIRE(requests.empty());
+        REQUIRE(scheduler.GetRequiredMipLevel(textureA) == 10U);
+    }
+
+    SECTION("Mip levels are streamed from coarse to fine")
+    {
+        scheduler.UpdatePriority(textureA, 1024.0f);
+
+        for (std::uint32_t mipLevel = 5U; mipLevel != ~0U; --mipLevel) {
+            scheduler.ScheduleRequests(64UL * 1024UL * 1024UL, requests);
+            REQUIRE(requests.size() == 1U);
+            REQUIRE(requests[0U].mTextureId == textureA);
+            REQUIRE(requests[0U].mMipLevel == mipLevel);
+            REQUIRE(requests[0U].mSizeInBytes == (1024UL >> mipLevel) * (1024UL >> mipLevel) * 4UL);
+            scheduler.OnRequestCompleted(requests[0U]);
+        }
+
+        REQUIRE(scheduler.GetResidentMipLevel(textureA) == 0U);
+        scheduler.ScheduleRequests(64UL * 1024UL * 1024UL, requests);
+        REQUIRE(requests.empty());
+    }
+
+    SECTION("Streaming stops at the required mip level")
+    {
+        scheduler.UpdatePriority(textureA, 256.0f);
+        REQUIRE(scheduler.GetRequiredMipLevel(textureA) == 2U);
+
+        for (std::uint32_t i = 0U; i < 10U; ++i) {
+            scheduler.ScheduleRequests(64UL * 1024UL * 1024UL, requests);
+            for (const TextureStreamingScheduler::MipLevelRequest& request : requests) {
+                scheduler.OnRequestCompleted(request);
+            }
+        }
+
+        REQUIRE(scheduler.GetResidentMipLevel(textureA) == 2U);
+        REQUIRE(scheduler.GetResidentMipLevel(textureB) == 6U);
+    }
+
+    SECTION("Textures in flight are not scheduled again")
+    {
+        scheduler.UpdatePriority(textureA, 1024.0f);
+        scheduler.ScheduleRequests(64UL * 1024UL * 1024UL, requests);
+        REQUIRE(requests.size() == 1U);
+
+        std::vector<TextureStreamingScheduler::MipLevelRequest> nextRequests;
+        scheduler.ScheduleRequests(64UL * 1024UL * 1024UL, nextRequests);
+        REQUIRE(nextRequests.empty());
+
+        scheduler.OnRequestCompleted(requests[0U]);
+        scheduler.ScheduleRequests(64UL * 1024UL * 1024UL, nextRequests);
+        REQUIRE(nextRequests.size() == 1U);
+        REQUIRE(nextRequests[0U].mMipLevel == 4U);
+    }
+
+    SECTION("The most blurry texture goes first")
+    {
+        scheduler.UpdatePriority(textureA, 128.0f);
+        scheduler.UpdatePriority(textureB, 1024.0f);
+
+        scheduler.ScheduleRequests(64UL * 1024UL * 1024UL, requests);
+        REQUIRE(requests.size() == 2U);
+        REQUIRE(requests[0U].mTextureId == textureB);
+        REQUIRE(requests[1U].mTextureId == textureA);
+    }
+
+    SECTION("The greatest projected size is kept")
+    {
+        scheduler.UpdatePriority(textureA, 1024.0f);
+        scheduler.UpdatePriority(textureA, 16.0f);
+        REQUIRE(scheduler.GetRequiredMipLevel(textureA) == 0U);
+
+        scheduler.ResetPriorities();
+        REQUIRE(scheduler.GetRequiredMipLevel(textureA) == 10U);
+    }
+
+    SECTION("Requests fit in the budget")
+    {
+        scheduler.UpdatePriority(textureA, 1024.0f);
+        scheduler.UpdatePriority(textureB, 512.0f);
+
+        // Mip level 5 is 32x32x4 bytes, so only one fits.
+        const std::uint64_t mipLevel5Size = 32UL * 32UL * 4UL;
+        scheduler.ScheduleRequests(mipLevel5Size + mipLevel5Size / 2UL, requests);
+        REQUIRE(requests.size() == 1U);
+        REQUIRE(requests[0U].mTextureId == textureA);
+
+        // The other texture is scheduled in the next frame
+        scheduler.ScheduleRequests(mipLevel5Size + mipLevel5Size / 2UL, requests);
+        REQUIRE(requests.size() == 1U);
+        REQUIRE(requests[0U].mTextureId == textureB);
+    }
+
+    SECTION("Mip levels bigger than the budget are not starved")
+    {
+        scheduler.UpdatePriority(textureA, 1024.0f);
+        scheduler.ScheduleRequests(16UL, requests);
+        REQUIRE(requests.size() == 1U);
+        REQUIRE(requests[0U].mSizeInBytes > 16UL);
+    }
+
+    SECTION("Removed textures are not scheduled, and their identifiers are reused")
+    {
+        scheduler.UpdatePriority(textureA, 1024.0f);
+        scheduler.UpdatePriority(textureB, 1024.0f);
+        scheduler.RemoveTexture(textureA);
+        REQUIRE(scheduler.GetTextureCount() == 1U);
+
+        scheduler.ScheduleRequests(64UL * 1024UL * 1024UL, requests);
+        REQUIRE(requests.size() == 1U);
+        REQUIRE(requests[0U].mTextureId == textureB);
+
+        const std::uint32_t textureC = scheduler.AddTexture(512U, GetMipLevelSizes(512U, 10U), 5U);
+        REQUIRE(textureC == textureA);
+        REQUIRE(scheduler.GetTextureCount() == 2U);
+        REQUIRE(scheduler.GetResidentMipLevel(textureC) == 5U);
+        REQUIRE(scheduler.GetRequiredMipLevel(textureC) == 9U);
+    }
+
+    SECTION("Clear")
+    {
+        scheduler.Clear();
+        REQUIRE(scheduler.GetTextureCount() == 0U);
+    }
+}
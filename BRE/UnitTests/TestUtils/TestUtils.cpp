@@ -1,5 +1,9 @@
 #include <UnitTests\Catch.h>
 
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
 #include <string>
 
 #include <Utils\StringUtils.h>
@@ -28,4 +32,57 @@ TEST_CASE("StringUtils")
 
         REQUIRE(destinationWString == outputString);
     }
+
+    SECTION("StringToFloat converts like strtof")
+    {
+        const char* strings[]{
+            "0", "-0", "+0", "0.0", "1", "-1", "10.0", "3.14", "-2.5", "0.1", "0.001", "1e3", "1E-3", "-4.5e+2",
+            "16777216", "16777217", "123456789", "0.30000000000000004", "1.17549435e-38", "3.40282347e+38",
+            "1e-45", "1.5e10", "1.5e11", "0.000000000001", "00012.500", "1.", ".5", "-.25",
+            "100000000000000000000000000000" };
+        for (const char* string : strings) {
+            float value = 0.0f;
+            REQUIRE(BRE::StringUtils::StringToFloat(string, string + std::strlen(string), value));
+            const float expectedValue = std::strtof(string, nullptr);
+            REQUIRE(std::memcmp(&value, &expectedValue, sizeof(float)) == 0);
+        }
+
+        // Random decimal numbers, like the ones written by tools
+        std::mt19937 generator(17U);
+        std::uniform_int_distribution<std::int32_t> integerDistribution(-100000, 100000);
+        std::uniform_int_distribution<std::int32_t> digitDistribution(0, 9);
+        std::string string;
+        for (std::uint32_t i = 0U; i < 100000U; ++i) {
+            string = std::to_string(integerDistribution(generator));
+            const std::int32_t decimalCount = digitDistribution(generator);
+            if (decimalCount > 0) {
+                string += '.';
+                for (std::int32_t j = 0; j < decimalCount; ++j) {
+                    string += static_cast<char>('0' + digitDistribution(generator));
+                }
+            }
+
+            float value = 0.0f;
+            REQUIRE(BRE::StringUtils::StringToFloat(string.data(), string.data() + string.size(), value));
+            REQUIRE(value == std::strtof(string.c_str(), nullptr));
+        }
+    }
+
+    SECTION("StringToFloat rejects strings that are not numbers")
+    {
+        const char* strings[]{ "", "-", "+", ".", "e5", "1e", "1e+", "1.0f", "abc", "1,5", " 1", "1 ", "--1", "0x" };
+        for (const char* string : strings) {
+            float value = 5.0f;
+            REQUIRE(BRE::StringUtils::StringToFloat(string, string + std::strlen(string), value) == false);
+            REQUIRE(value == 5.0f);
+        }
+    }
+
+    SECTION("StringToFloat converts a part of a string")
+    {
+        const char* string = "1.25, 2.5";
+        float value = 0.0f;
+        REQUIRE(BRE::StringUtils::StringToFloat(string, string + 4U, value));
+        REQUIRE(value == 1.25f);
+    }
 }
@@ -0,0 +1,178 @@
+#include <UnitTests\Catch.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <ModelManager\VertexCompressor.h>
+
+using BRE::GeometryGenerator::Vertex;
+using BRE::VertexCompressor;
+using DirectX::XMFLOAT2;
+using DirectX::XMFLOAT3;
+
+namespace {
+///
+/// @brief Normalizes a vector
+/// @param vector Vector. It must not be zero.
+/// @return Unit vector
+///
+XMFLOAT3
+Normalize(const XMFLOAT3& vector)
+{
+    const float length = std::sqrt(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+    return XMFLOAT3(vector.x / length, vector.y / length, vector.z / length);
+}
+
+///
+/// @brief Computes the angle between two unit vectors
+/// @param a First vector
+/// @param b Second vector
+/// @return Angle in radians
+///
+float
+ComputeAngle(const XMFLOAT3& a,
+             const XMFLOAT3& b)
+{
+    // acos is not precise for small angles, so the cross product is used too.
+    const XMFLOAT3 cross(a.y * b.z - a.z * b.y,
+                         a.z * b.x - a.x * b.z,
+                         a.x * b.y - a.y * b.x);
+    const float sine = std::sqrt(cross.x * cross.x + cross.y * cross.y + cross.z * cross.z);
+    const float cosine = a.x * b.x + a.y * b.y + a.z * b.z;
+    return std::atan2(sine, cosine);
+}
+
+///
+/// @brief Creates vertices with the given normals, reversed normals as tangents, and UVs
+/// @param normals Normals
+/// @param uvs UVs. There must be one per normal.
+/// @param vertices Output vertices
+///
+void
+CreateVertices(const std::vector<XMFLOAT3>& normals,
+               const std::vector<XMFLOAT2>& uvs,
+               std::vector<Vertex>& vertices)
+{
+    for (std::size_t i = 0U; i < normals.size(); ++i) {
+        const XMFLOAT3& normal = normals[i];
+        vertices.push_back(Vertex(XMFLOAT3(static_cast<float>(i), 1.0f, -2.0f),
+                                  normal,
+                                  XMFLOAT3(-normal.x, -normal.y, -normal.z),
+                                  uvs[i]));
+    }
+}
+}
+
+TEST_CASE("Vertex compressor")
+{
+    // Random vectors, plus vectors on the octahedron edges and on the hemispheres boundary.
+    std::vector<XMFLOAT3> normals{
+        XMFLOAT3(1.0f, 0.0f, 0.0f),
+        XMFLOAT3(-1.0f, 0.0f, 0.0f),
+        XMFLOAT3(0.0f, 1.0f, 0.0f),
+        XMFLOAT3(0.0f, -1.0f, 0.0f),
+        XMFLOAT3(0.0f, 0.0f, 1.0f),
+        XMFLOAT3(0.0f, 0.0f, -1.0f),
+        Normalize(XMFLOAT3(1.0f, -1.0f, 0.0f)),
+        Normalize(XMFLOAT3(-1.0f, -1.0f, -1.0f)),
+        Normalize(XMFLOAT3(0.0f, 1.0f, -1.0f)),
+    };
+    std::vector<XMFLOAT2> uvs{
+        XMFLOAT2(0.0f, 1.0f),
+        XMFLOAT2(0.5f, 0.25f),
+        XMFLOAT2(-1.0f, 2.0f),
+        XMFLOAT2(1.0e-6f, -1.0e-6f),
+        XMFLOAT2(65504.0f, -65504.0f),
+        XMFLOAT2(0.1f, 0.9f),
+        XMFLOAT2(0.333f, 0.666f),
+        XMFLOAT2(3.75f, -7.5f),
+        XMFLOAT2(1.0f, 0.0f),
+    };
+
+    std::mt19937 randomGenerator(1234U);
+    std::normal_distribution<float> normalDistribution;
+    std::uniform_real_distribution<float> uvDistribution(-8.0f, 8.0f);
+    while (normals.size() < 10003U) {
+        const XMFLOAT3 normal(normalDistribution(randomGenerator),
+                              normalDistribution(randomGenerator),
+                              normalDistribution(randomGenerator));
+        if (normal.x * normal.x + normal.y * normal.y + normal.z * normal.z > 1.0e-6f) {
+            normals.push_back(Normalize(normal));
+            uvs.push_back(XMFLOAT2(uvDistribution(randomGenerator), uvDistribution(randomGenerator)));
+        }
+    }
+
+    std::vector<Vertex> vertices;
+    CreateVertices(normals, uvs, vertices);
+    std::vector<VertexCompressor::CompressedVertex> compressedVertices(vertices.size());
+    VertexCompressor::CompressVertices(vertices.data(), vertices.size(), compressedVertices.data());
+
+    SECTION("Compressed vertices are less than 60% of vertices")
+    {
+        REQUIRE(sizeof(VertexCompressor::CompressedVertex) == 24U);
+        REQUIRE(sizeof(VertexCompressor::CompressedVertex) * 10U < sizeof(Vertex) * 6U);
+    }
+
+    SECTION("Positions are not modified")
+    {
+        for (std::size_t i = 0U; i < vertices.size(); ++i) {
+            REQUIRE(std::memcmp(&compressedVertices[i].mPosition, &vertices[i].mPosition, sizeof(XMFLOAT3)) == 0);
+        }
+    }
+
+    SECTION("Normals and tangents error is less than 0.01 degrees")
+    {
+        const float maxAngle = 0.01f * 3.14159265f / 180.0f;
+        for (std::size_t i = 0U; i < vertices.size(); ++i) {
+            REQUIRE(ComputeAngle(VertexCompressor::DecodeUnitVector(compressedVertices[i].mNormal), vertices[i].mNormal) < maxAngle);
+            REQUIRE(ComputeAngle(VertexCompressor::DecodeUnitVector(compressedVertices[i].mTangent), vertices[i].mTangent) < maxAngle);
+        }
+    }
+
+    SECTION("UV relative error is less than half float precision")
+    {
+        for (std::size_t i = 0U; i < vertices.size(); ++i) {
+            const XMFLOAT2 uv = VertexCompressor::DecodeUV(compressedVertices[i].mUV);
+            // Half the distance between half floats, plus half the smallest subnormal half float.
+            REQUIRE(std::abs(uv.x - vertices[i].mUV.x) <= std::abs(vertices[i].mUV.x) * std::ldexp(1.0f, -11) + std::ldexp(1.0f, -25));
+            REQUIRE(std::abs(uv.y - vertices[i].mUV.y) <= std::abs(vertices[i].mUV.y) * std::ldexp(1.0f, -11) + std::ldexp(1.0f, -25));
+        }
+
+        // Values that half floats represent exactly
+        REQUIRE(VertexCompressor::DecodeUV(compressedVertices[0U].mUV).x == 0.0f);
+        REQUIRE(VertexCompressor::DecodeUV(compressedVertices[0U].mUV).y == 1.0f);
+        REQUIRE(VertexCompressor::DecodeUV(compressedVertices[2U].mUV).x == -1.0f);
+        REQUIRE(VertexCompressor::DecodeUV(compressedVertices[4U].mUV).x == 65504.0f);
+        REQUIRE(VertexCompressor::DecodeUV(compressedVertices[4U].mUV).y == -65504.0f);
+        REQUIRE(VertexCompressor::DecodeUV(compressedVertices[7U].mUV).y == -7.5f);
+    }
+
+    SECTION("Vertex counts that are not multiple of 4")
+    {
+        for (std::size_t vertexCount = 1U; vertexCount < 10U; ++vertexCount) {
+            std::vector<VertexCompressor::CompressedVertex> partialCompressedVertices(vertexCount + 1U);
+            partialCompressedVertices[vertexCount].mNormal = 0x12345678U;
+            VertexCompressor::CompressVertices(vertices.data(), vertexCount, partialCompressedVertices.data());
+
+            REQUIRE(std::memcmp(partialCompressedVertices.data(),
+                                compressedVertices.data(),
+                                sizeof(VertexCompressor::CompressedVertex) * vertexCount) == 0);
+            REQUIRE(partialCompressedVertices[vertexCount].mNormal == 0x12345678U);
+        }
+    }
+
+    SECTION("Zero vectors are decoded as +Z")
+    {
+        std::vector<Vertex> zeroVertices;
+        CreateVertices(std::vector<XMFLOAT3>{ XMFLOAT3(0.0f, 0.0f, 0.0f) }, std::vector<XMFLOAT2>{ XMFLOAT2(0.0f, 0.0f) }, zeroVertices);
+        VertexCompressor::CompressedVertex compressedVertex;
+        VertexCompressor::CompressVertices(zeroVertices.data(), 1U, &compressedVertex);
+
+        const XMFLOAT3 normal = VertexCompressor::DecodeUnitVector(compressedVertex.mNormal);
+        REQUIRE(normal.x == 0.0f);
+        REQUIRE(normal.y == 0.0f);
+        REQUIRE(normal.z == 1.0f);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,337 @@
+#include <UnitTests\Catch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <SceneLoader\WorldPartitionScheduler.h>
+
+using BRE::WorldPartitionScheduler;
+
+namespace {
+///
+/// @brief Adds a square grid of cells centered at the origin
+/// @param scheduler Scheduler
+/// @param gridSize Number of columns and rows
+/// @param cellSizeInBytes Size of each cell
+///
+void
+AddCellGrid(WorldPartitionScheduler& scheduler,
+            const std::int32_t gridSize,
+            const std::uint64_t cellSizeInBytes)
+{
+    for (std::int32_t column = -gridSize / 2; column < gridSize - gridSize / 2; ++column) {
+        for (std::int32_t row = -gridSize / 2; row < gridSize - gridSize / 2; ++row) {
+            scheduler.AddCell(column, row, cellSizeInBytes);
+        }
+    }
+}
+
+///
+/// @brief Loads all the loading cells
+/// @param scheduler Scheduler
+/// @param cellsToLoad Cells returned by the last update
+///
+void
+LoadCells(WorldPartitionScheduler& scheduler,
+          const std::vector<std::uint32_t>& cellsToLoad)
+{
+    for (const std::uint32_t cellId : cellsToLoad) {
+        scheduler.OnCellLoaded(cellId);
+    }
+}
+
+///
+/// @brief Camera path simulation over a world partition
+///
+/// Cells have random sizes and their loads take a random number of updates.
+///
+struct CameraPathSimulation {
+    ///
+    /// @brief Simulates a camera path
+    /// @param gridSize Number of columns and rows of the world
+    /// @param isRandomWalk True if the camera walks randomly, false if it moves in a straight line
+    /// @param updateCount Number of updates
+    ///
+    void Run(const std::int32_t gridSize,
+             const bool isRandomWalk,
+             const std::uint32_t updateCount)
+    {
+        std::mt19937 randomGenerator(static_cast<std::uint32_t>(gridSize));
+        mScheduler.Init(mCellSize, 3.0f * mCellSize, 4.0f * mCellSize, mMemoryBudgetInBytes, 4U);
+        for (std::int32_t column = -gridSize / 2; column < gridSize - gridSize / 2; ++column) {
+            for (std::int32_t row = -gridSize / 2; row < gridSize - gridSize / 2; ++row) {
+                mScheduler.AddCell(column, row, 64UL * 1024UL + randomGenerator() % (1024UL * 1024UL));
+            }
+        }
+
+        struct PendingLoad {
+            std::uint32_t mCellId;
+            std::uint32_t mRemainingUpdateCount;
+        };
+        std::vector<PendingLoad> pendingLoads;
+        std::vector<std::uint32_t> cellsToLoad;
+        std::vector<std::uint32_t> cellsToUnload;
+
+        const float worldHalfSize = gridSize * mCellSize * 0.5f;
+        float cameraX = 0.0f;
+        float cameraZ = 0.0f;
+        float directionX = 1.0f;
+        float directionZ = 0.0f;
+
+        const auto startTime = std::chrono::high_resolution_clock::now();
+        for (std::uint32_t update = 0U; update < updateCount; ++update) {
+            if (isRandomWalk && randomGenerator() % 32U == 0U) {
+                const float angle = static_cast<float>(randomGenerator() % 360U) * 3.14159265f / 180.0f;
+                directionX = std::cos(angle);
+                directionZ = std::sin(angle);
+            }
+
+            // Half a cell per update, bouncing at the world borders
+            cameraX += directionX * mCellSize * 0.5f;
+            cameraZ += directionZ * mCellSize * 0.5f;
+            if (std::abs(cameraX) > worldHalfSize) {
+                directionX = -directionX;
+                cameraX = std::max(std::min(cameraX, worldHalfSize), -worldHalfSize);
+            }
+            if (std::abs(cameraZ) > worldHalfSize) {
+                directionZ = -directionZ;
+                cameraZ = std::max(std::min(cameraZ, worldHalfSize), -worldHalfSize);
+            }
+
+            mScheduler.Update(cameraX, cameraZ, cellsToLoad, cellsToUnload);
+            for (const std::uint32_t cellId : cellsToLoad) {
+                pendingLoads.push_back(PendingLoad{ cellId, static_cast<std::uint32_t>(randomGenerator() % 4U) });
+            }
+
+            for (std::size_t i = 0UL; i < pendingLoads.size();) {
+                if (pendingLoads[i].mRemainingUpdateCount == 0U) {
+                    mScheduler.OnCellLoaded(pendingLoads[i].mCellId);
+                    pendingLoads[i] = pendingLoads.back();
+                    pendingLoads.pop_back();
+                } else {
+                    --pendingLoads[i].mRemainingUpdateCount;
+                    ++i;
+                }
+            }
+
+            mMaxCommittedSizeInBytes = std::max(mMaxCommittedSizeInBytes, mScheduler.GetCommittedSizeInBytes());
+            mMaxCommittedCellCount = std::max(mMaxCommittedCellCount, mScheduler.GetCommittedCellCount());
+            mLoadCount += static_cast<std::uint32_t>(cellsToLoad.size());
+        }
+        const auto endTime = std::chrono::high_resolution_clock::now();
+        mUpdateTimeInMs = std::chrono::duration<double, std::milli>(endTime - startTime).count() / updateCount;
+    }
+
+    WorldPartitionScheduler mScheduler;
+    const float mCellSize{ 16.0f };
+    const std::uint64_t mMemoryBudgetInBytes{ 24UL * 1024UL * 1024UL };
+    std::uint64_t mMaxCommittedSizeInBytes{ 0UL };
+    std::uint32_t mMaxCommittedCellCount{ 0U };
+    std::uint32_t mLoadCount{ 0U };
+    double mUpdateTimeInMs{ 0.0 };
+};
+}
+
+TEST_CASE("ComputeCellCoordinate")
+{
+    WorldPartitionScheduler scheduler;
+    scheduler.Init(10.0f, 10.0f, 20.0f, 1024UL, 1U);
+
+    REQUIRE(scheduler.ComputeCellCoordinate(0.0f) == 0);
+    REQUIRE(scheduler.ComputeCellCoordinate(9.9f) == 0);
+    REQUIRE(scheduler.ComputeCellCoordinate(10.0f) == 1);
+    REQUIRE(scheduler.ComputeCellCoordinate(-0.1f) == -1);
+    REQUIRE(scheduler.ComputeCellCoordinate(-10.0f) == -1);
+    REQUIRE(scheduler.ComputeCellCoordinate(-10.1f) == -2);
+}
+
+TEST_CASE("ComputeCellDistance")
+{
+    WorldPartitionScheduler scheduler;
+    scheduler.Init(10.0f, 10.0f, 20.0f, 1024UL, 1U);
+    const std::uint32_t cellId = scheduler.AddCell(1, -1, 1UL);
+
+    REQUIRE(scheduler.ComputeCellDistance(cellId, 15.0f, -5.0f) == 0.0f);
+    REQUIRE(scheduler.ComputeCellDistance(cellId, 0.0f, -5.0f) == 10.0f);
+    REQUIRE(scheduler.ComputeCellDistance(cellId, 25.0f, -5.0f) == 5.0f);
+    REQUIRE(scheduler.ComputeCellDistance(cellId, 15.0f, 3.0f) == 3.0f);
+    REQUIRE(scheduler.ComputeCellDistance(cellId, 23.0f, 4.0f) == 5.0f);
+}
+
+TEST_CASE("WorldPartitionScheduler")
+{
+    WorldPartitionScheduler scheduler;
+    std::vector<std::uint32_t> cellsToLoad;
+    std::vector<std::uint32_t> cellsToUnload;
+
+    SECTION("Cells within the load radius are loaded, nearest first")
+    {
+        scheduler.Init(10.0f, 12.0f, 25.0f, 1024UL, 16U);
+        AddCellGrid(scheduler, 9, 1UL);
+        REQUIRE(scheduler.GetCellCount() == 81U);
+
+        scheduler.Update(5.0f, 5.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToUnload.empty());
+        REQUIRE(cellsToLoad.size() == 9U);
+        REQUIRE(scheduler.ComputeCellDistance(cellsToLoad[0U], 5.0f, 5.0f) == 0.0f);
+        for (std::size_t i = 1UL; i < cellsToLoad.size(); ++i) {
+            REQUIRE(scheduler.ComputeCellDistance(cellsToLoad[i - 1UL], 5.0f, 5.0f) <=
+                    scheduler.ComputeCellDistance(cellsToLoad[i], 5.0f, 5.0f));
+            REQUIRE(scheduler.ComputeCellDistance(cellsToLoad[i], 5.0f, 5.0f) <= 12.0f);
+            REQUIRE(scheduler.GetCellState(cellsToLoad[i]) == WorldPartitionScheduler::LOADING);
+        }
+        REQUIRE(scheduler.GetCommittedCellCount() == 9U);
+        REQUIRE(scheduler.GetCommittedSizeInBytes() == 9UL);
+
+        LoadCells(scheduler, cellsToLoad);
+        REQUIRE(scheduler.GetCellState(cellsToLoad[0U]) == WorldPartitionScheduler::LOADED);
+
+        scheduler.Update(5.0f, 5.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToLoad.empty());
+        REQUIRE(cellsToUnload.empty());
+    }
+
+    SECTION("Loading cells per update are limited")
+    {
+        scheduler.Init(10.0f, 15.0f, 25.0f, 1024UL, 4U);
+        AddCellGrid(scheduler, 9, 1UL);
+
+        scheduler.Update(5.0f, 5.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToLoad.size() == 4U);
+        REQUIRE(scheduler.ComputeCellDistance(cellsToLoad[0U], 5.0f, 5.0f) == 0.0f);
+        const std::uint32_t firstCellId = cellsToLoad[0U];
+
+        // Nothing else is loaded until a loading cell is loaded
+        scheduler.Update(5.0f, 5.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToLoad.empty());
+        scheduler.OnCellLoaded(firstCellId);
+        scheduler.Update(5.0f, 5.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToLoad.size() == 1U);
+    }
+
+    SECTION("Cells are unloaded farther than the unload radius")
+    {
+        scheduler.Init(10.0f, 10.0f, 30.0f, 1024UL, 64U);
+        AddCellGrid(scheduler, 32, 1UL);
+
+        scheduler.Update(5.0f, 5.0f, cellsToLoad, cellsToUnload);
+        LoadCells(scheduler, cellsToLoad);
+        const std::vector<std::uint32_t> loadedCells = cellsToLoad;
+
+        // The camera oscillates across a cell border: nothing is loaded or unloaded again
+        std::uint32_t loadCount = 0U;
+        for (std::uint32_t i = 0U; i < 16U; ++i) {
+            scheduler.Update(i % 2U == 0U ? 11.0f : 9.0f, 5.0f, cellsToLoad, cellsToUnload);
+            LoadCells(scheduler, cellsToLoad);
+            loadCount += static_cast<std::uint32_t>(cellsToLoad.size());
+            REQUIRE(cellsToUnload.empty());
+            // Only the new cells on the other side of the border are loaded, once
+            if (i > 0U) {
+                REQUIRE(cellsToLoad.empty());
+            }
+        }
+        REQUIRE(loadCount > 0U);
+
+        // The camera goes far away: all the previous cells are unloaded
+        scheduler.Update(105.0f, 105.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToUnload.size() == loadedCells.size() + loadCount);
+        for (const std::uint32_t cellId : loadedCells) {
+            REQUIRE(scheduler.GetCellState(cellId) != WorldPartitionScheduler::LOADED);
+        }
+        REQUIRE(scheduler.GetCommittedCellCount() == cellsToLoad.size());
+    }
+
+    SECTION("Loading cells are unloaded once they are loaded")
+    {
+        scheduler.Init(10.0f, 5.0f, 10.0f, 1024UL, 1U);
+        AddCellGrid(scheduler, 32, 1UL);
+
+        scheduler.Update(5.0f, 5.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToLoad.size() == 1U);
+        const std::uint32_t cellId = cellsToLoad[0U];
+
+        scheduler.Update(105.0f, 105.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToUnload.empty());
+        REQUIRE(scheduler.GetCellState(cellId) == WorldPartitionScheduler::LOADING);
+
+        scheduler.OnCellLoaded(cellId);
+        scheduler.Update(105.0f, 105.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToUnload.size() == 1U);
+        REQUIRE(cellsToUnload[0U] == cellId);
+        REQUIRE(scheduler.GetCellState(cellId) == WorldPartitionScheduler::UNLOADED);
+    }
+
+    SECTION("Cells never exceed the memory budget")
+    {
+        scheduler.Init(10.0f, 100.0f, 200.0f, 10UL, 64U);
+        AddCellGrid(scheduler, 32, 1UL);
+
+        scheduler.Update(5.0f, 5.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToLoad.size() == 10U);
+        REQUIRE(scheduler.GetCommittedSizeInBytes() == 10UL);
+        LoadCells(scheduler, cellsToLoad);
+
+        // Nearer cells replace farther cells
+        scheduler.Update(55.0f, 5.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToLoad.empty() == false);
+        REQUIRE(cellsToLoad.size() == cellsToUnload.size());
+        REQUIRE(scheduler.GetCommittedSizeInBytes() == 10UL);
+        REQUIRE(scheduler.ComputeCellDistance(cellsToLoad[0U], 55.0f, 5.0f) == 0.0f);
+        for (const std::uint32_t loadedCellId : cellsToLoad) {
+            for (const std::uint32_t unloadedCellId : cellsToUnload) {
+                REQUIRE(scheduler.ComputeCellDistance(loadedCellId, 55.0f, 5.0f) <
+                        scheduler.ComputeCellDistance(unloadedCellId, 55.0f, 5.0f));
+            }
+        }
+    }
+
+    SECTION("Cells greater than the memory budget are never loaded")
+    {
+        scheduler.Init(10.0f, 10.0f, 20.0f, 100UL, 4U);
+        const std::uint32_t bigCellId = scheduler.AddCell(0, 0, 101UL);
+        const std::uint32_t smallCellId = scheduler.AddCell(1, 0, 100UL);
+
+        scheduler.Update(5.0f, 5.0f, cellsToLoad, cellsToUnload);
+        REQUIRE(cellsToLoad.size() == 1U);
+        REQUIRE(cellsToLoad[0U] == smallCellId);
+        REQUIRE(scheduler.GetCellState(bigCellId) == WorldPartitionScheduler::UNLOADED);
+    }
+}
+
+TEST_CASE("WorldPartitionScheduler camera paths")
+{
+    // Peak committed size (the sum of the sizes of the loading and loaded cells) is bounded
+    // by the cells around the camera and by the memory budget, so it does not grow with the world size.
+    for (const std::int32_t gridSize : { 32, 128, 512 }) {
+        for (const bool isRandomWalk : { true, false }) {
+            CameraPathSimulation simulation;
+            simulation.Run(gridSize, isRandomWalk, 4096U);
+
+            REQUIRE(simulation.mMaxCommittedSizeInBytes <= simulation.mMemoryBudgetInBytes);
+            // 10x10 cells around the camera (the unload radius is 4 cells)
+            REQUIRE(simulation.mMaxCommittedCellCount <= 100U);
+            REQUIRE(simulation.mLoadCount > 0U);
+        }
+    }
+}
+
+// Measures the update time of the scheduler for growing worlds. Committed sizes are the cell sizes
+// given to the scheduler, not process or GPU memory.
+// It must be run explicitly: UnitTests.exe [benchmark]
+TEST_CASE("WorldPartitionScheduler update times", "[.][benchmark]")
+{
+    for (const std::int32_t gridSize : { 32, 128, 512 }) {
+        for (const bool isRandomWalk : { true, false }) {
+            CameraPathSimulation simulation;
+            simulation.Run(gridSize, isRandomWalk, 4096U);
+
+            WARN((isRandomWalk ? "Random walk" : "Straight line") << " over " << gridSize << "x" << gridSize <<
+                 " cells: peak committed size " << simulation.mMaxCommittedSizeInBytes / 1024UL << " KB in " <<
+                 simulation.mMaxCommittedCellCount << " cells, " << simulation.mLoadCount << " cell loads, " <<
+                 simulation.mUpdateTimeInMs << " ms per update");
+        }
+    }
+}
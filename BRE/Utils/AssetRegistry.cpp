@@ -0,0 +1,180 @@
+#include "AssetRegistry.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <tbb/parallel_for.h>
+#include <Windows.h>
+
+#include <Utils\DebugUtils.h>
+#include <Utils\HashUtils.h>
+#include <Utils\MemoryMappedFile.h>
+
+namespace BRE {
+namespace {
+///
+/// @brief Checks if two files have the same content
+/// @param firstPath First file path
+/// @param secondPath Second file path
+/// @return True if both files could be opened, and they have the same content. Otherwise, false.
+///
+bool
+AreFileContentsEqual(const std::string& firstPath,
+                     const std::string& secondPath) noexcept
+{
+    MemoryMappedFile firstFile;
+    MemoryMappedFile secondFile;
+    if (firstFile.Open(firstPath.c_str()) == false ||
+        secondFile.Open(secondPath.c_str()) == false ||
+        firstFile.GetSize() != secondFile.GetSize()) {
+        return false;
+    }
+
+    return std::memcmp(firstFile.GetData(), secondFile.GetData(), firstFile.GetSize()) == 0;
+}
+}
+
+void
+AssetRegistry::RegisterFiles(const std::vector<std::string>& paths) noexcept
+{
+    // Paths are resolved to files. Files are new if their canonical path was not registered before.
+    std::vector<std::size_t> referenceFileIndices(paths.size());
+    std::vector<std::size_t> newFileIndices;
+    for (std::size_t i = 0U; i < paths.size(); ++i) {
+        std::unordered_map<std::string, std::size_t>::const_iterator findIt = mFileIndexByPath.find(paths[i]);
+        if (findIt != mFileIndexByPath.end()) {
+            referenceFileIndices[i] = findIt->second;
+            continue;
+        }
+
+        const std::pair<std::unordered_map<std::string, std::size_t>::iterator, bool> insertResult =
+            mFileIndexByCanonicalPath.emplace(GetCanonicalPath(paths[i]), mFiles.size());
+        if (insertResult.second) {
+            File file;
+            file.mPath = paths[i];
+            file.mUniqueFileIndex = mFiles.size();
+            newFileIndices.push_back(mFiles.size());
+            mFiles.push_back(file);
+        }
+
+        mFileIndexByPath.emplace(paths[i], insertResult.first->second);
+        referenceFileIndices[i] = insertResult.first->second;
+    }
+
+    // Get the size and the content hash of the new files. Loaders need the content hash of
+    // every file to identify their cache files, so it is computed once here (see GetContentHash()).
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, newFileIndices.size(), 1U),
+                      [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+            File& file = mFiles[newFileIndices[i]];
+            MemoryMappedFile memoryMappedFile;
+            file.mIsOpen = memoryMappedFile.Open(file.mPath.c_str());
+            file.mSize = memoryMappedFile.GetSize();
+            if (file.mIsOpen && file.mSize > 0UL) {
+                file.mContentHash = HashUtils::ComputeHash(memoryMappedFile.GetData(), memoryMappedFile.GetSize());
+            }
+        }
+    });
+
+    // Only files with the same size can have the same content.
+    // File indices of each size are in registration order.
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> fileIndicesBySize;
+    for (std::size_t i = 0U; i < mFiles.size(); ++i) {
+        if (mFiles[i].mIsOpen) {
+            fileIndicesBySize[mFiles[i].mSize].push_back(i);
+        }
+    }
+
+    // A new file is a duplicate of the first unique file registered before it with the same content.
+    // Contents are compared too, so hash collisions cannot merge different files.
+    for (const std::size_t newFileIndex : newFileIndices) {
+        File& newFile = mFiles[newFileIndex];
+        if (newFile.mIsOpen == false) {
+            continue;
+        }
+
+        for (const std::size_t fileIndex : fileIndicesBySize[newFile.mSize]) {
+            if (fileIndex == newFileIndex) {
+                break;
+            }
+
+            const File& file = mFiles[fileIndex];
+            if (file.mUniqueFileIndex == fileIndex &&
+                file.mContentHash == newFile.mContentHash &&
+                AreFileContentsEqual(file.mPath, newFile.mPath)) {
+                newFile.mUniqueFileIndex = fileIndex;
+                break;
+            }
+        }
+    }
+
+    // References to files (or contents) that were already referenced are hits.
+    for (const std::size_t fileIndex : referenceFileIndices) {
+        File& file = mFiles[fileIndex];
+        File& uniqueFile = mFiles[file.mUniqueFileIndex];
+        ++mStatistics.mReferenceCount;
+        if (file.mIsReferenced) {
+            ++mStatistics.mPathHitCount;
+            mStatistics.mSavedBytes += file.mSize;
+        } else if (uniqueFile.mIsReferenced) {
+            ++mStatistics.mContentHitCount;
+            mStatistics.mSavedBytes += file.mSize;
+        } else {
+            ++mStatistics.mUniqueFileCount;
+        }
+
+        file.mIsReferenced = true;
+        uniqueFile.mIsReferenced = true;
+    }
+}
+
+const std::string&
+AssetRegistry::GetUniquePath(const std::string& path) const noexcept
+{
+    std::unordered_map<std::string, std::size_t>::const_iterator findIt = mFileIndexByPath.find(path);
+    BRE_ASSERT(findIt != mFileIndexByPath.end());
+
+    return mFiles[mFiles[findIt->second].mUniqueFileIndex].mPath;
+}
+
+std::uint64_t
+AssetRegistry::GetContentHash(const std::string& path) const noexcept
+{
+    std::unordered_map<std::string, std::size_t>::const_iterator findIt = mFileIndexByPath.find(path);
+    BRE_ASSERT(findIt != mFileIndexByPath.end());
+
+    return mFiles[findIt->second].mContentHash;
+}
+
+void
+AssetRegistry::LogStatistics(const wchar_t* assetType) const noexcept
+{
+    BRE_ASSERT(assetType != nullptr);
+
+    const std::wstring statisticsMsg =
+        std::wstring(assetType) + L": " +
+        std::to_wstring(mStatistics.mReferenceCount) + L" references, " +
+        std::to_wstring(mStatistics.mUniqueFileCount) + L" unique files, " +
+        std::to_wstring(mStatistics.mPathHitCount) + L" path hits, " +
+        std::to_wstring(mStatistics.mContentHitCount) + L" content hits, " +
+        std::to_wstring(mStatistics.mSavedBytes) + L" bytes saved\n";
+    BRE_LOG_MSG(statisticsMsg.c_str());
+}
+
+std::string
+AssetRegistry::GetCanonicalPath(const std::string& path) noexcept
+{
+    char fullPath[MAX_PATH];
+    const DWORD fullPathLength = GetFullPathNameA(path.c_str(), MAX_PATH, fullPath, nullptr);
+    std::string canonicalPath = fullPathLength == 0U || fullPathLength >= MAX_PATH ?
+        path :
+        std::string(fullPath, fullPathLength);
+
+    // File names are not case sensitive, and both separators are valid.
+    std::replace(canonicalPath.begin(), canonicalPath.end(), '/', '\\');
+    std::transform(canonicalPath.begin(), canonicalPath.end(), canonicalPath.begin(),
+                   [](const char character) { return static_cast<char>(std::tolower(static_cast<unsigned char>(character))); });
+
+    return canonicalPath;
+}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Utils\HashUtils.h>
+
+namespace BRE {
+///
+/// @brief Content addressed registry of asset files.
+///
+/// It finds the files that have the same content, so loaders load each
+/// different content once, even if it is referenced by several names, paths or files:
+/// - Paths are compared after they are made canonical (absolute, with the same separators and case).
+/// - Files with different canonical paths are compared by size and content hash, and then by content.
+/// The content hash of every file is computed once, so loaders can reuse it (see GetContentHash()).
+///
+/// Every reference to a file whose content was already registered is a hit,
+/// and the size of its file is counted as saved bytes.
+///
+class AssetRegistry {
+public:
+    AssetRegistry() = default;
+    ~AssetRegistry() = default;
+    AssetRegistry(const AssetRegistry&) = delete;
+    const AssetRegistry& operator=(const AssetRegistry&) = delete;
+    AssetRegistry(AssetRegistry&&) = delete;
+    AssetRegistry& operator=(AssetRegistry&&) = delete;
+
+    ///
+    /// @brief Registry statistics
+    ///
+    struct Statistics {
+        std::uint32_t mReferenceCount{ 0U };
+        std::uint32_t mUniqueFileCount{ 0U };
+        std::uint32_t mPathHitCount{ 0U }; // References to an already registered canonical path
+        std::uint32_t mContentHitCount{ 0U }; // References to another path with the same content
+        std::uint64_t mSavedBytes{ 0UL };
+    };
+
+    ///
+    /// @brief Registers file references
+    ///
+    /// Files are opened and hashed in parallel.
+    /// Files that cannot be opened are unique, so loaders report them.
+    ///
+    /// @param paths File paths. A path can be repeated, and every occurrence is a reference.
+    ///
+    void RegisterFiles(const std::vector<std::string>& paths) noexcept;
+
+    ///
+    /// @brief Get the path of the unique file with the same content than a registered file
+    /// @param path Registered file path
+    /// @return Path (as it was registered) of the first registered file with the same content
+    ///
+    const std::string& GetUniquePath(const std::string& path) const noexcept;
+
+    ///
+    /// @brief Get the content hash of a registered file (see HashUtils::ComputeHash())
+    /// @param path Registered file path
+    /// @return Content hash. It is the hash of no data if the file could not be opened or it is empty.
+    ///
+    std::uint64_t GetContentHash(const std::string& path) const noexcept;
+
+    ///
+    /// @brief Get statistics
+    /// @return Statistics
+    ///
+    __forceinline const Statistics& GetStatistics() const noexcept
+    {
+        return mStatistics;
+    }
+
+    ///
+    /// @brief Logs statistics
+    /// @param assetType Asset type name (for example, "Textures"). Must not be nullptr.
+    ///
+    void LogStatistics(const wchar_t* assetType) const noexcept;
+
+    ///
+    /// @brief Get the canonical path of a file
+    /// @param path File path
+    /// @return Canonical path
+    ///
+    static std::string GetCanonicalPath(const std::string& path) noexcept;
+
+private:
+    struct File {
+        std::string mPath;
+        std::uint64_t mSize{ 0UL };
+        std::uint64_t mContentHash{ HashUtils::sOffsetBasis };
+        bool mIsOpen{ false };
+        bool mIsReferenced{ false };
+        std::size_t mUniqueFileIndex{ 0U };
+    };
+
+    std::vector<File> mFiles;
+    std::unordered_map<std::string, std::size_t> mFileIndexByCanonicalPath;
+    std::unordered_map<std::string, std::size_t> mFileIndexByPath;
+    Statistics mStatistics;
+};
+}
\ No newline at end of file
@@ -12,6 +12,11 @@
 #define BRE_ASSERT(condition) {}
 #endif
 
+#define BRE_LOG_MSG(msg) \
+{ \
+	OutputDebugStringW(msg); \
+}
+
 #define BRE_CHECK_MSG(condition, msg) \
 { \
 	if ((condition) == false) { \
@@ -0,0 +1,125 @@
+#include "FileWatcher.h"
+
+#include <unordered_set>
+#include <Windows.h>
+
+#include <Utils\DebugUtils.h>
+#include <Utils\StringUtils.h>
+
+namespace BRE {
+namespace {
+///
+/// @brief Get the last write time of a file
+/// @param filePath File path
+/// @return Last write time. It is 0 if the file does not exist.
+///
+std::uint64_t
+GetLastWriteTime(const std::string& filePath) noexcept
+{
+    WIN32_FILE_ATTRIBUTE_DATA fileAttributeData;
+    if (GetFileAttributesExA(filePath.c_str(), GetFileExInfoStandard, &fileAttributeData) == FALSE) {
+        return 0UL;
+    }
+
+    return (static_cast<std::uint64_t>(fileAttributeData.ftLastWriteTime.dwHighDateTime) << 32UL) |
+        fileAttributeData.ftLastWriteTime.dwLowDateTime;
+}
+
+///
+/// @brief Get the directory of a file
+/// @param filePath File path
+/// @return Directory path. It is the current directory if the file path has no directory.
+///
+std::string
+GetDirectoryPath(const std::string& filePath) noexcept
+{
+    const std::size_t separatorPosition = filePath.find_last_of("/\\");
+    if (separatorPosition == std::string::npos) {
+        return ".";
+    }
+
+    return separatorPosition == 0UL ? filePath.substr(0UL, 1UL) : filePath.substr(0UL, separatorPosition);
+}
+}
+
+FileWatcher::~FileWatcher()
+{
+    Clear();
+}
+
+void
+FileWatcher::Watch(const std::vector<std::string>& filePaths) noexcept
+{
+    Clear();
+
+    std::unordered_set<std::string> directoryPaths;
+    for (const std::string& filePath : filePaths) {
+        WatchedFile watchedFile;
+        watchedFile.mPath = filePath;
+        watchedFile.mLastWriteTime = GetLastWriteTime(filePath);
+        mWatchedFiles.push_back(watchedFile);
+
+        directoryPaths.insert(GetDirectoryPath(filePath));
+    }
+
+    // Files can be saved by renaming a temporary file, so file names are watched too.
+    for (const std::string& directoryPath : directoryPaths) {
+        const HANDLE notificationHandle =
+            FindFirstChangeNotificationA(directoryPath.c_str(),
+                                         FALSE,
+                                         FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+        if (notificationHandle == INVALID_HANDLE_VALUE) {
+            const std::wstring errorMsg =
+                L"Failed to watch directory: " + StringUtils::AnsiToWideString(directoryPath) + L"\n";
+            BRE_LOG_MSG(errorMsg.c_str());
+            continue;
+        }
+
+        mNotificationHandles.push_back(notificationHandle);
+    }
+}
+
+void
+FileWatcher::Clear() noexcept
+{
+    for (void* notificationHandle : mNotificationHandles) {
+        FindCloseChangeNotification(notificationHandle);
+    }
+
+    mNotificationHandles.clear();
+    mWatchedFiles.clear();
+    mHasPendingChange = false;
+}
+
+bool
+FileWatcher::HaveFilesChanged() noexcept
+{
+    // Notifications are not waited for
+    bool hasDirectoryChanged = false;
+    for (void* notificationHandle : mNotificationHandles) {
+        if (WaitForSingleObject(notificationHandle, 0U) == WAIT_OBJECT_0) {
+            hasDirectoryChanged = true;
+            FindNextChangeNotification(notificationHandle);
+        }
+    }
+
+    if (hasDirectoryChanged) {
+        for (WatchedFile& watchedFile : mWatchedFiles) {
+            const std::uint64_t lastWriteTime = GetLastWriteTime(watchedFile.mPath);
+            if (lastWriteTime != watchedFile.mLastWriteTime) {
+                watchedFile.mLastWriteTime = lastWriteTime;
+                mPendingChangeTime = GetTickCount64();
+                mHasPendingChange = true;
+            }
+        }
+    }
+
+    if (mHasPendingChange == false || GetTickCount64() - mPendingChangeTime < sSettleTimeInMs) {
+        return false;
+    }
+
+    mHasPendingChange = false;
+
+    return true;
+}
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BRE {
+///
+/// @brief Watches files for modifications, without blocking.
+///
+/// The directories of the files are watched with change notifications, and
+/// the files are checked by their last write time when their directory changes.
+/// Editors can write a file in several steps, so modifications are reported
+/// once the files did not change for sSettleTimeInMs.
+///
+class FileWatcher {
+public:
+    FileWatcher() = default;
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    const FileWatcher& operator=(const FileWatcher&) = delete;
+    FileWatcher(FileWatcher&&) = delete;
+    FileWatcher& operator=(FileWatcher&&) = delete;
+
+    static const std::uint64_t sSettleTimeInMs{ 200UL };
+
+    ///
+    /// @brief Watches files. Files that were watched before are not watched anymore.
+    /// @param filePaths File paths
+    ///
+    void Watch(const std::vector<std::string>& filePaths) noexcept;
+
+    ///
+    /// @brief Stops watching files
+    ///
+    void Clear() noexcept;
+
+    ///
+    /// @brief Checks if watched files were modified since the last time they were reported
+    /// @return True if watched files were modified, and they did not change for sSettleTimeInMs.
+    /// Otherwise, false.
+    ///
+    bool HaveFilesChanged() noexcept;
+
+private:
+    ///
+    /// @brief Watched file
+    ///
+    struct WatchedFile {
+        std::string mPath;
+        std::uint64_t mLastWriteTime{ 0UL }; // It is 0 if the file does not exist
+    };
+
+    std::vector<WatchedFile> mWatchedFiles;
+
+    // Change notification handle of each directory of the watched files
+    std::vector<void*> mNotificationHandles;
+
+    // Time (in milliseconds) of the last modification that was not reported yet
+    std::uint64_t mPendingChangeTime{ 0UL };
+    bool mHasPendingChange{ false };
+};
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "HashUtils.h"
+
+#include <cstdio>
+#include <Windows.h>
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+namespace HashUtils {
+std::uint64_t
+ComputeHash(const void* data,
+            const std::size_t dataSize,
+            const std::uint64_t hash) noexcept
+{
+    BRE_ASSERT(data != nullptr);
+
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    std::uint64_t currentHash = hash;
+    for (std::size_t i = 0UL; i < dataSize; ++i) {
+        currentHash ^= bytes[i];
+        currentHash *= sPrime;
+    }
+
+    return currentHash;
+}
+
+std::string
+GetCachedFilePath(const char* cacheDirectory,
+                  const std::uint64_t hash,
+                  const char* extension) noexcept
+{
+    BRE_ASSERT(cacheDirectory != nullptr);
+    BRE_ASSERT(extension != nullptr);
+
+    // It fails if the directory already exists, and that is fine.
+    CreateDirectoryA(cacheDirectory, nullptr);
+
+    char hashString[17U];
+    sprintf_s(hashString, "%016llx", static_cast<unsigned long long>(hash));
+
+    return std::string(cacheDirectory) + "/" + hashString + extension;
+}
+}
+}
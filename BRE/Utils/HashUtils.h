@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace BRE {
+namespace HashUtils {
+// 64-bit FNV-1a parameters
+const std::uint64_t sOffsetBasis{ 14695981039346656037ULL };
+const std::uint64_t sPrime{ 1099511628211ULL };
+
+///
+/// @brief Computes the 64-bit FNV-1a hash of data. It is stable between runs,
+/// so it identifies file contents in cache file names.
+/// @param data Data. Must not be nullptr.
+/// @param dataSize Data size in bytes
+/// @param hash Hash of the previous data, to hash several blocks of data. Use the default value.
+/// @return Hash
+///
+std::uint64_t ComputeHash(const void* data,
+                          const std::size_t dataSize,
+                          const std::uint64_t hash = sOffsetBasis) noexcept;
+
+///
+/// @brief Get the path of a cache file. It creates the cache directory if it does not exist.
+/// @param cacheDirectory Cache directory. Must not be nullptr.
+/// @param hash Content hash that identifies the cache file
+/// @param extension File extension, including the dot. Must not be nullptr.
+/// @return Cache file path
+///
+std::string GetCachedFilePath(const char* cacheDirectory,
+                              const std::uint64_t hash,
+                              const char* extension) noexcept;
+}
+}
@@ -0,0 +1,88 @@
+#include "MemoryMappedFile.h"
+
+#include <Windows.h>
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+bool
+MemoryMappedFile::Open(const char* filePath) noexcept
+{
+    BRE_ASSERT(filePath != nullptr);
+
+    Close();
+
+    const HANDLE fileHandle = CreateFileA(filePath,
+                                          GENERIC_READ,
+                                          FILE_SHARE_READ,
+                                          nullptr,
+                                          OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                          nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    // Empty files cannot be mapped
+    if (GetFileSizeEx(fileHandle, &fileSize) == FALSE || fileSize.QuadPart == 0) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    const HANDLE mappingHandle = CreateFileMappingA(fileHandle,
+                                                    nullptr,
+                                                    PAGE_READONLY,
+                                                    0U,
+                                                    0U,
+                                                    nullptr);
+    if (mappingHandle == nullptr) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    const void* data = MapViewOfFile(mappingHandle,
+                                     FILE_MAP_READ,
+                                     0U,
+                                     0U,
+                                     0U);
+    if (data == nullptr) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    mFileHandle = fileHandle;
+    mMappingHandle = mappingHandle;
+    mData = static_cast<const std::uint8_t*>(data);
+    mSize = static_cast<std::size_t>(fileSize.QuadPart);
+
+    return true;
+}
+
+void
+MemoryMappedFile::Close() noexcept
+{
+    if (mData != nullptr) {
+        UnmapViewOfFile(mData);
+        mData = nullptr;
+    }
+
+    if (mMappingHandle != nullptr) {
+        CloseHandle(mMappingHandle);
+        mMappingHandle = nullptr;
+    }
+
+    if (mFileHandle != nullptr) {
+        CloseHandle(mFileHandle);
+        mFileHandle = nullptr;
+    }
+
+    mSize = 0UL;
+}
+}
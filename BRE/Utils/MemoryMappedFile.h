@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace BRE {
+///
+/// @brief Read-only view of a whole file mapped in memory.
+///
+/// Pages are loaded by the operating system when they are accessed, so
+/// the file content can be used without copying it to an intermediate buffer.
+///
+class MemoryMappedFile {
+public:
+    MemoryMappedFile() = default;
+    ~MemoryMappedFile();
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    const MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    MemoryMappedFile(MemoryMappedFile&&) = delete;
+    MemoryMappedFile& operator=(MemoryMappedFile&&) = delete;
+
+    ///
+    /// @brief Opens and maps a file. If a file was already opened, it is closed first.
+    /// @param filePath File path. Must not be nullptr.
+    /// @return True if the file was mapped. Otherwise, false (for example, the file
+    /// does not exist or it is empty).
+    ///
+    bool Open(const char* filePath) noexcept;
+
+    ///
+    /// @brief Unmaps and closes the file (if any)
+    ///
+    void Close() noexcept;
+
+    ///
+    /// @brief Checks if a file is mapped
+    /// @return True if a file is mapped. Otherwise, false.
+    ///
+    __forceinline bool IsOpen() const noexcept
+    {
+        return mData != nullptr;
+    }
+
+    ///
+    /// @brief Get mapped data
+    /// @return Mapped data. It is nullptr if there is no file mapped.
+    ///
+    __forceinline const std::uint8_t* GetData() const noexcept
+    {
+        return mData;
+    }
+
+    ///
+    /// @brief Get mapped data size
+    /// @return Mapped data size in bytes
+    ///
+    __forceinline std::size_t GetSize() const noexcept
+    {
+        return mSize;
+    }
+
+private:
+    void* mFileHandle{ nullptr };
+    void* mMappingHandle{ nullptr };
+    const std::uint8_t* mData{ nullptr };
+    std::size_t mSize{ 0UL };
+};
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <Utils\DebugUtils.h>
+
+namespace BRE {
+///
+/// @brief Container of values identified by generational handles
+///
+/// Insertion, erasure and lookup are O(1). Values are stored densely, so iteration
+/// does not visit erased values. Each slot has a generation that is incremented when its value is erased,
+/// so handles of erased values are detected (stale handles), even if their slot is reused.
+///
+/// Insert() and Erase() can be called from several threads at the same time. Other methods
+/// must not run while other threads insert or erase (storage moves when it grows).
+/// Erased values are replaced by the last value, so T must be default constructible and movable.
+///
+template<typename T>
+class SlotMap {
+public:
+    ///
+    /// @brief Handle of a value. A default constructed handle is null.
+    ///
+    struct Handle {
+        static const std::uint32_t sInvalidIndex{ 0xFFFFFFFFU };
+
+        ///
+        /// @brief Checks if the handle is not null. It does not check if its value was erased.
+        /// @return True if the handle is not null. Otherwise, false.
+        ///
+        bool IsNull() const noexcept
+        {
+            return mIndex == sInvalidIndex;
+        }
+
+        bool operator==(const Handle& handle) const noexcept
+        {
+            return mIndex == handle.mIndex && mGeneration == handle.mGeneration;
+        }
+
+        bool operator!=(const Handle& handle) const noexcept
+        {
+            return (*this == handle) == false;
+        }
+
+        std::uint32_t mIndex{ sInvalidIndex };
+        std::uint32_t mGeneration{ 0U };
+    };
+
+    using Iterator = typename std::vector<T>::iterator;
+    using ConstIterator = typename std::vector<T>::const_iterator;
+
+    SlotMap() = default;
+    ~SlotMap() = default;
+    SlotMap(const SlotMap&) = delete;
+    const SlotMap& operator=(const SlotMap&) = delete;
+    SlotMap(SlotMap&&) = delete;
+    SlotMap& operator=(SlotMap&&) = delete;
+
+    ///
+    /// @brief Inserts a value. It can be called from several threads at the same time.
+    /// @param value Value
+    /// @return Value handle
+    ///
+    Handle Insert(T value) noexcept
+    {
+        mMutex.lock();
+
+        Handle handle;
+        if (mFirstFreeSlotIndex == Handle::sInvalidIndex) {
+            handle.mIndex = static_cast<std::uint32_t>(mSlots.size());
+            BRE_ASSERT(handle.mIndex != Handle::sInvalidIndex);
+            mSlots.push_back(Slot());
+        } else {
+            handle.mIndex = mFirstFreeSlotIndex;
+            mFirstFreeSlotIndex = mSlots[handle.mIndex].mDenseIndex;
+        }
+
+        Slot& slot = mSlots[handle.mIndex];
+        slot.mDenseIndex = mSize;
+        handle.mGeneration = slot.mGeneration;
+
+        // Storage of erased values is reused
+        if (mSize < mValues.size()) {
+            mValues[mSize] = std::move(value);
+            mSlotIndices[mSize] = handle.mIndex;
+        } else {
+            mValues.push_back(std::move(value));
+            mSlotIndices.push_back(handle.mIndex);
+        }
+        ++mSize;
+
+        mMutex.unlock();
+
+        return handle;
+    }
+
+    ///
+    /// @brief Erases a value. It can be called from several threads at the same time.
+    /// @param handle Value handle
+    /// @param erasedValue Output erased value. If it is nullptr, then the value is discarded.
+    /// @return True if the value was erased. False if the handle is null or stale.
+    ///
+    bool Erase(const Handle handle,
+               T* erasedValue = nullptr) noexcept
+    {
+        mMutex.lock();
+
+        if (Contains(handle) == false) {
+            mMutex.unlock();
+            return false;
+        }
+
+        Slot& slot = mSlots[handle.mIndex];
+        const std::uint32_t denseIndex = slot.mDenseIndex;
+        const std::uint32_t lastDenseIndex = mSize - 1U;
+        if (erasedValue != nullptr) {
+            *erasedValue = std::move(mValues[denseIndex]);
+        }
+
+        // The last value fills the hole
+        if (denseIndex != lastDenseIndex) {
+            mValues[denseIndex] = std::move(mValues[lastDenseIndex]);
+            mSlotIndices[denseIndex] = mSlotIndices[lastDenseIndex];
+            mSlots[mSlotIndices[denseIndex]].mDenseIndex = denseIndex;
+        }
+        mValues[lastDenseIndex] = T();
+        --mSize;
+
+        ++slot.mGeneration;
+        slot.mDenseIndex = mFirstFreeSlotIndex;
+        mFirstFreeSlotIndex = handle.mIndex;
+
+        mMutex.unlock();
+
+        return true;
+    }
+
+    ///
+    /// @brief Erases all values
+    ///
+    /// Handles of erased values are stale, even if their slot is reused.
+    ///
+    void Clear() noexcept
+    {
+        // Last values are erased first, so no value is moved
+        while (mSize > 0U) {
+            Erase(GetHandle(mSize - 1U));
+        }
+    }
+
+    ///
+    /// @brief Checks if a handle refers to a value that was not erased
+    /// @param handle Value handle
+    /// @return True if the value was not erased. Otherwise, false.
+    ///
+    bool Contains(const Handle handle) const noexcept
+    {
+        return handle.mIndex < mSlots.size() && mSlots[handle.mIndex].mGeneration == handle.mGeneration;
+    }
+
+    ///
+    /// @brief Get a value
+    /// @param handle Value handle
+    /// @return Value. It is nullptr if the handle is null or stale.
+    ///
+    T* Get(const Handle handle) noexcept
+    {
+        return Contains(handle) ? &mValues[mSlots[handle.mIndex].mDenseIndex] : nullptr;
+    }
+
+    const T* Get(const Handle handle) const noexcept
+    {
+        return Contains(handle) ? &mValues[mSlots[handle.mIndex].mDenseIndex] : nullptr;
+    }
+
+    ///
+    /// @brief Get the handle of a value by its position in iteration order
+    /// @param denseIndex Value position. It must be lower than GetSize().
+    /// @return Value handle
+    ///
+    Handle GetHandle(const std::uint32_t denseIndex) const noexcept
+    {
+        BRE_ASSERT(denseIndex < mSize);
+
+        Handle handle;
+        handle.mIndex = mSlotIndices[denseIndex];
+        handle.mGeneration = mSlots[handle.mIndex].mGeneration;
+
+        return handle;
+    }
+
+    std::uint32_t GetSize() const noexcept
+    {
+        return mSize;
+    }
+
+    Iterator begin() noexcept
+    {
+        return mValues.begin();
+    }
+
+    Iterator end() noexcept
+    {
+        return mValues.begin() + mSize;
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return mValues.begin();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return mValues.begin() + mSize;
+    }
+
+private:
+    ///
+    /// @brief Slot of a handle index
+    ///
+    struct Slot {
+        // Position of the value. If the slot is free, then it is the index of the next free slot.
+        std::uint32_t mDenseIndex{ Handle::sInvalidIndex };
+        std::uint32_t mGeneration{ 0U };
+    };
+
+    std::vector<Slot> mSlots;
+
+    // Values and the slot index of each value, in iteration order.
+    // They are not shrunk when values are erased, so their storage is reused.
+    // Only the first mSize elements are values.
+    std::vector<T> mValues;
+    std::vector<std::uint32_t> mSlotIndices;
+    std::uint32_t mSize{ 0U };
+
+    std::uint32_t mFirstFreeSlotIndex{ Handle::sInvalidIndex };
+
+    std::mutex mMutex;
+};
+}
@@ -0,0 +1,57 @@
+#include "StringId.h"
+
+#include <cstring>
+
+#include <Utils\DebugUtils.h>
+#include <Utils\StringUtils.h>
+
+namespace BRE {
+StringIdMap<std::string> StringIdTable::mStringById;
+std::mutex StringIdTable::mMutex;
+
+StringId
+StringIdTable::GetStringId(const char* string) noexcept
+{
+    BRE_ASSERT(string != nullptr);
+
+    return HashUtils::ComputeHash(string, std::strlen(string));
+}
+
+StringId
+StringIdTable::GetStringId(const std::string& string) noexcept
+{
+    return HashUtils::ComputeHash(string.data(), string.size());
+}
+
+StringId
+StringIdTable::Intern(const std::string& string) noexcept
+{
+    const StringId stringId = GetStringId(string);
+
+    mMutex.lock();
+    const std::pair<StringIdMap<std::string>::iterator, bool> insertResult = mStringById.emplace(stringId, string);
+    const bool isCollision = insertResult.second == false && insertResult.first->second != string;
+    mMutex.unlock();
+
+    BRE_CHECK_MSG(isCollision == false,
+                  (L"String identifier collision: " + StringUtils::AnsiToWideString(string)).c_str());
+
+    return stringId;
+}
+
+std::string
+StringIdTable::GetString(const StringId stringId) noexcept
+{
+    std::string string;
+
+    mMutex.lock();
+    StringIdMap<std::string>::const_iterator findIt = mStringById.find(stringId);
+    const bool isInterned = findIt != mStringById.end();
+    if (isInterned) {
+        string = findIt->second;
+    }
+    mMutex.unlock();
+
+    return isInterned ? string : std::to_string(stringId);
+}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <Utils\HashUtils.h>
+
+namespace BRE {
+///
+/// @brief Identifier of a string. It is the 64-bit FNV-1a hash of the string characters
+/// (see HashUtils::ComputeHash()), so it is stable between runs and it can be computed at compile time.
+///
+using StringId = std::uint64_t;
+
+///
+/// @brief Hasher of unordered containers keyed by StringId. Identifiers are already hashes.
+///
+struct StringIdHasher {
+    std::size_t operator()(const StringId stringId) const noexcept
+    {
+        return static_cast<std::size_t>(stringId);
+    }
+};
+
+template<typename T>
+using StringIdMap = std::unordered_map<StringId, T, StringIdHasher>;
+
+///
+/// @brief Global table of interned strings, to key assets by identifier instead of by name.
+///
+/// Names are interned once when they are registered (for example, the asset names
+/// of a scene file), and lookups only hash the name, without allocating a string.
+/// Identifiers of names known in code are computed at compile time (see ComputeStringId()).
+/// Interned strings are only used to build messages (see GetString()).
+///
+class StringIdTable {
+public:
+    StringIdTable() = delete;
+    ~StringIdTable() = delete;
+    StringIdTable(const StringIdTable&) = delete;
+    const StringIdTable& operator=(const StringIdTable&) = delete;
+    StringIdTable(StringIdTable&&) = delete;
+    StringIdTable& operator=(StringIdTable&&) = delete;
+
+    ///
+    /// @brief Computes the identifier of a string at compile time
+    /// @param string Null terminated string
+    /// @param stringId Identifier of the previous characters. Use the default value.
+    /// @return String identifier
+    ///
+    static constexpr StringId ComputeStringId(const char* string,
+                                              const StringId stringId = HashUtils::sOffsetBasis) noexcept
+    {
+        return *string == '\0' ?
+            stringId :
+            ComputeStringId(string + 1, (stringId ^ static_cast<std::uint8_t>(*string)) * HashUtils::sPrime);
+    }
+
+    ///
+    /// @brief Computes the identifier of a string at run time. It is the same than ComputeStringId().
+    /// @param string Null terminated string
+    /// @return String identifier
+    ///
+    static StringId GetStringId(const char* string) noexcept;
+
+    ///
+    /// @brief Computes the identifier of a string at run time. It is the same than ComputeStringId().
+    /// @param string String
+    /// @return String identifier
+    ///
+    static StringId GetStringId(const std::string& string) noexcept;
+
+    ///
+    /// @brief Interns a string. It is thread safe.
+    ///
+    /// A different string with the same identifier is reported as an error.
+    ///
+    /// @param string String
+    /// @return String identifier
+    ///
+    static StringId Intern(const std::string& string) noexcept;
+
+    ///
+    /// @brief Get an interned string. It is thread safe.
+    /// @param stringId String identifier
+    /// @return Interned string. If the string was not interned, then it is the identifier in decimal.
+    ///
+    static std::string GetString(const StringId stringId) noexcept;
+
+private:
+    static StringIdMap<std::string> mStringById;
+
+    static std::mutex mMutex;
+};
+}
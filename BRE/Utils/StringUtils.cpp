@@ -1,10 +1,32 @@
 #include "StringUtils.h"
 
+#include <cctype>
 #include <codecvt>
+#include <cstdint>
+#include <cstdlib>
 #include <Windows.h>
 
 namespace BRE {
 namespace StringUtils {
+namespace {
+// Powers of 10 that are exact in float
+const float sExactPowersOf10[]{ 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+const std::int32_t sMaxExactExponent{ 10 };
+const std::uint64_t sMaxExactMantissa{ 1ULL << 24U };
+const std::uint64_t sMaxMantissa{ 1000000000000000000ULL };
+
+///
+/// @brief Checks if a character is a decimal digit
+/// @param character Character
+/// @return True if it is a decimal digit. Otherwise, false.
+///
+bool
+IsDigit(const char character) noexcept
+{
+    return character >= '0' && character <= '9';
+}
+}
+
 void
 AnsiToWideString(const std::string& source,
                  std::wstring& destination) noexcept
@@ -20,5 +42,111 @@ AnsiToWideString(const std::string& str) noexcept
     MultiByteToWideChar(CP_ACP, 0U, str.c_str(), -1, buffer, bufferMaxSize);
     return std::wstring(buffer);
 }
+
+bool
+StringToFloat(const char* first,
+              const char* last,
+              float& value) noexcept
+{
+    const char* current = first;
+    const bool isNegative = current != last && *current == '-';
+    if (current != last && (*current == '-' || *current == '+')) {
+        ++current;
+    }
+
+    // Digits that do not fit in the mantissa make the conversion inexact.
+    std::uint64_t mantissa{ 0UL };
+    std::int32_t exponent{ 0 };
+    bool hasDigits{ false };
+    bool isExact{ true };
+    for (; current != last && IsDigit(*current); ++current) {
+        hasDigits = true;
+        if (mantissa < sMaxMantissa) {
+            mantissa = mantissa * 10UL + static_cast<std::uint64_t>(*current - '0');
+        } else {
+            ++exponent;
+            isExact = isExact && *current == '0';
+        }
+    }
+
+    if (current != last && *current == '.') {
+        ++current;
+        for (; current != last && IsDigit(*current); ++current) {
+            hasDigits = true;
+            if (mantissa < sMaxMantissa) {
+                mantissa = mantissa * 10UL + static_cast<std::uint64_t>(*current - '0');
+                --exponent;
+            } else {
+                isExact = isExact && *current == '0';
+            }
+        }
+    }
+
+    if (hasDigits && current != last && (*current == 'e' || *current == 'E')) {
+        ++current;
+        const bool isExponentNegative = current != last && *current == '-';
+        if (current != last && (*current == '-' || *current == '+')) {
+            ++current;
+        }
+
+        std::int32_t explicitExponent{ 0 };
+        bool hasExponentDigits{ false };
+        for (; current != last && IsDigit(*current); ++current) {
+            hasExponentDigits = true;
+            if (explicitExponent < 100000) {
+                explicitExponent = explicitExponent * 10 + (*current - '0');
+            }
+        }
+
+        if (hasExponentDigits == false) {
+            return false;
+        }
+        exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+    }
+
+    if (hasDigits == false || current != last) {
+        // Other formats (infinity, not a number, hexadecimal) are left to strtof.
+        if (hasDigits) {
+            return false;
+        }
+        isExact = false;
+    }
+
+    // Trailing zeros do not change the value
+    while (isExact && mantissa != 0UL && mantissa % 10UL == 0UL && exponent < 0) {
+        mantissa /= 10UL;
+        ++exponent;
+    }
+
+    if (isExact && mantissa <= sMaxExactMantissa) {
+        if (mantissa == 0UL) {
+            value = isNegative ? -0.0f : 0.0f;
+            return true;
+        }
+
+        if (exponent >= -sMaxExactExponent && exponent <= sMaxExactExponent) {
+            const float absoluteValue = exponent < 0 ?
+                static_cast<float>(mantissa) / sExactPowersOf10[-exponent] :
+                static_cast<float>(mantissa) * sExactPowersOf10[exponent];
+            value = isNegative ? -absoluteValue : absoluteValue;
+            return true;
+        }
+    }
+
+    // strtof needs a null terminated string, and it skips leading white spaces.
+    const std::string string(first, last);
+    if (string.empty() || std::isspace(static_cast<unsigned char>(string[0])) != 0) {
+        return false;
+    }
+
+    char* end{ nullptr };
+    const float convertedValue = std::strtof(string.c_str(), &end);
+    if (end != string.c_str() + string.size()) {
+        return false;
+    }
+
+    value = convertedValue;
+    return true;
+}
 }
 }
\ No newline at end of file
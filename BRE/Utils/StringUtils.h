@@ -18,6 +18,22 @@ void AnsiToWideString(const std::string& source,
 /// @return Wide string
 ///
 std::wstring AnsiToWideString(const std::string& str) noexcept;
+
+///
+/// @brief Converts a decimal string to float, like std::from_chars.
+///
+/// Strings whose digits and power of 10 are exact in float are converted without
+/// the C library (they are correctly rounded by a single multiplication or division).
+/// Other strings are converted by strtof.
+///
+/// @param first First character of the string
+/// @param last Character past the last one of the string
+/// @param value Output value. It is not modified if the string is not a number.
+/// @return True if the whole string is a number. Otherwise, false.
+///
+bool StringToFloat(const char* first,
+                   const char* last,
+                   float& value) noexcept;
 }
 }
 